@@ -194,6 +194,7 @@ option(USE_AUTODIFF "Use Autodiff" OFF)
 option(USE_PYBIND11 "Use PYBIND11" OFF)
 option(USE_JSON "Use JSON" OFF)
 option(USE_XEUS "Use XEUS" OFF)
+option(BENCHMARKS "Builds the ugbench executable and the benchmark target. Valid options are ON, OFF" OFF)
 
 ################################################################################
 # set default values for pseudo-options
@@ -275,6 +276,7 @@ message(STATUS "Info: EMBEDDED_PLUGINS   ${EMBEDDED_PLUGINS} (options are: ON, O
 message(STATUS "Info: COMPILE_INFO       ${COMPILE_INFO} (options are: ON, OFF)")
 message(STATUS "Info: USE_LUA2C          ${USE_LUA2C} (options are: ON, OFF)")
 message(STATUS "Info: USE_LUAJIT         ${USE_LUAJIT} (options are: ON, OFF)")
+message(STATUS "Info: BENCHMARKS         ${BENCHMARKS} (options are: ON, OFF)")
 message(STATUS "")
 message(STATUS "Info: External libraries (path which contains the library or ON if you used uginstall):")
 message(STATUS "Info: HLIBPRO:           ${HLIBPRO}")
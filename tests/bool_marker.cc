@@ -0,0 +1,152 @@
+// marks, unmarks and collects elements with BoolMarker and checks the results
+// against a per-element reference, also after elements were erased and
+// reordered.
+
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "lib_grid/lib_grid.h"
+#include "lib_grid/tools/bool_marker.h"
+
+using namespace ug;
+
+struct CountVertices{
+	CountVertices(size_t& n) : num(n)	{}
+	void operator()(Vertex*)			{++num;}
+	size_t& num;
+};
+
+//	checks num_marked, is_marked and for_each_marked for vertices against vMarked
+static bool CheckVertices(Grid& g, BoolMarker& marker, const std::vector<Vertex*>& vrts,
+						  const std::vector<bool>& vMarked)
+{
+	size_t numMarked = 0;
+	for(size_t i = 0; i < vrts.size(); ++i){
+		if(marker.is_marked(vrts[i]) != vMarked[i])
+			return false;
+		if(vMarked[i])
+			++numMarked;
+	}
+
+	size_t numVisited = 0;
+	marker.for_each_marked<Vertex>(CountVertices(numVisited));
+
+//	the collected vertices have to be valid and marked
+	std::set<Vertex*> vrtSet(vrts.begin(), vrts.end());
+	std::vector<Vertex*> vCollected;
+	marker.collect_marked(vCollected);
+	for(size_t i = 0; i < vCollected.size(); ++i){
+		if(!vrtSet.count(vCollected[i]) || !marker.is_marked(vCollected[i]))
+			return false;
+	}
+
+	return marker.num_marked<Vertex>() == numMarked
+		&& numVisited == numMarked
+		&& vCollected.size() == numMarked;
+}
+
+int main()
+{
+	const size_t n = 200;
+
+	Grid g(GRIDOPT_STANDARD_INTERCONNECTION);
+	BoolMarker marker(g);
+
+	std::vector<Vertex*> vrts;
+	for(size_t i = 0; i < n; ++i)
+		vrts.push_back(*g.create<RegularVertex>());
+	for(size_t i = 0; i + 2 < n; i += 3)
+		g.create<Triangle>(TriangleDescriptor(vrts[i], vrts[i+1], vrts[i+2]));
+
+	std::vector<bool> vMarked(n, false);
+	for(size_t i = 0; i < n; i += 3){
+		marker.mark(vrts[i]);
+		vMarked[i] = true;
+	}
+	bool markOk = CheckVertices(g, marker, vrts, vMarked);
+
+	for(size_t i = 0; i < n; i += 6){
+		marker.unmark(vrts[i]);
+		vMarked[i] = false;
+	}
+	bool unmarkOk = CheckVertices(g, marker, vrts, vMarked);
+
+//	every second triangle
+	size_t numTris = 0;
+	for(TriangleIterator iter = g.begin<Triangle>(); iter != g.end<Triangle>(); ++iter, ++numTris)
+		marker.mark(*iter, numTris % 2 == 0);
+	std::vector<Triangle*> vTris;
+	marker.collect_marked(vTris);
+	bool facesOk = (vTris.size() == (numTris + 1) / 2)
+				&& (marker.num_marked<Face>() == vTris.size())
+				&& (marker.num_marked() == marker.num_marked<Vertex>() + vTris.size());
+
+//	unite, intersect and subtract with a second marker
+	BoolMarker marker2(g);
+	std::vector<bool> vMarked2(n, false);
+	for(size_t i = 0; i < n; i += 2){
+		marker2.mark(vrts[i]);
+		vMarked2[i] = true;
+	}
+	std::vector<bool> vUnion(n), vIntersection(n), vDifference(n);
+	for(size_t i = 0; i < n; ++i){
+		vUnion[i] = vMarked[i] || vMarked2[i];
+		vIntersection[i] = vMarked[i] && vMarked2[i];
+		vDifference[i] = vMarked[i] && !vMarked2[i];
+	}
+	BoolMarker tmp(g);
+	tmp.unite(marker);
+	tmp.unite(marker2);
+	bool setOpsOk = CheckVertices(g, tmp, vrts, vUnion);
+	tmp.clear();
+	tmp.unite(marker);
+	tmp.intersect(marker2);
+	setOpsOk = setOpsOk && CheckVertices(g, tmp, vrts, vIntersection);
+	tmp.clear();
+	tmp.unite(marker);
+	tmp.subtract(marker2);
+	setOpsOk = setOpsOk && CheckVertices(g, tmp, vrts, vDifference);
+
+//	erase the first half of the vertices and create new, unmarked ones
+	std::vector<Vertex*> vrtsNew;
+	std::vector<bool> vMarkedNew;
+	for(size_t i = 0; i < n; ++i){
+		if(i < n / 2)
+			g.erase(vrts[i]);
+		else{
+			vrtsNew.push_back(vrts[i]);
+			vMarkedNew.push_back(vMarked[i]);
+		}
+	}
+	for(size_t i = 0; i < n / 4; ++i){
+		vrtsNew.push_back(*g.create<RegularVertex>());
+		vMarkedNew.push_back(false);
+	}
+	bool eraseOk = CheckVertices(g, marker, vrtsNew, vMarkedNew);
+
+//	reverse the storage order of the vertices, which changes their data indices
+	std::vector<Vertex*> vrtsReversed(vrtsNew.rbegin(), vrtsNew.rend());
+	g.reorder_elements<Vertex>(vrtsReversed.begin(), vrtsReversed.end());
+	bool reorderOk = CheckVertices(g, marker, vrtsNew, vMarkedNew);
+	marker.release_element_maps();
+	reorderOk = reorderOk && CheckVertices(g, marker, vrtsNew, vMarkedNew);
+
+	marker.clear();
+	bool clearOk = (marker.num_marked() == 0);
+	std::vector<Vertex*> vCollected;
+	marker.collect_marked(vCollected);
+	clearOk = clearOk && vCollected.empty();
+
+	std::cout << "mark " << (markOk ? "ok" : "FAILED") << "\n"
+			  << "unmark " << (unmarkOk ? "ok" : "FAILED") << "\n"
+			  << "faces " << (facesOk ? "ok" : "FAILED") << "\n"
+			  << "unite intersect subtract " << (setOpsOk ? "ok" : "FAILED") << "\n"
+			  << "erase " << (eraseOk ? "ok" : "FAILED") << "\n"
+			  << "reorder " << (reorderOk ? "ok" : "FAILED") << "\n"
+			  << "clear " << (clearOk ? "ok" : "FAILED") << "\n";
+
+	assert(markOk && unmarkOk && facesOk && setOpsOk && eraseOk && reorderOk
+		   && clearOk);
+}
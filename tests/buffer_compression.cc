@@ -0,0 +1,139 @@
+// compresses and decompresses buffers with CompressBinaryBuffer and
+// DecompressBinaryBuffer and checks that corrupt data is rejected.
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "common/error.h"
+#include "common/util/binary_buffer.h"
+#include "common/util/buffer_compression.h"
+
+using namespace ug;
+
+static void RandomBytes(std::vector<char>& data, size_t n, unsigned int seed)
+{
+	data.resize(n);
+	unsigned int x = seed;
+	for(size_t i = 0; i < n; ++i){
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		data[i] = (char)(x & 0xFF);
+	}
+}
+
+//	compresses data, decompresses the result and compares it with data.
+//	The size of the compressed block (without header) is written to compSizeOut.
+static bool RoundTrip(const std::vector<char>& data, size_t& compSizeOut)
+{
+	BinaryBuffer in, comp, out;
+	if(!data.empty())
+		in.write(&data.front(), data.size());
+	CompressBinaryBuffer(comp, in);
+	compSizeOut = comp.write_pos() - 2 * sizeof(uint64);
+
+	DecompressBinaryBuffer(out, comp);
+	return comp.eof()
+		&& out.write_pos() == data.size()
+		&& (data.empty() || memcmp(out.buffer(), &data.front(), data.size()) == 0);
+}
+
+//	returns true if DecompressBinaryBuffer throws for the given block
+static bool Rejects(const std::vector<char>& block)
+{
+	BinaryBuffer in, out;
+	in.write(&block.front(), block.size());
+	try{
+		DecompressBinaryBuffer(out, in);
+	}
+	catch(UGError&){
+		return true;
+	}
+	return false;
+}
+
+static std::vector<char> CreateBlock(uint64 size, uint64 compSize,
+									 const char* data, size_t dataSize)
+{
+	std::vector<char> block(2 * sizeof(uint64) + dataSize);
+	memcpy(&block[0], &size, sizeof(uint64));
+	memcpy(&block[sizeof(uint64)], &compSize, sizeof(uint64));
+	if(dataSize > 0)
+		memcpy(&block[2 * sizeof(uint64)], data, dataSize);
+	return block;
+}
+
+int main()
+{
+	size_t compSize;
+
+	std::vector<char> empty;
+	bool emptyOk = RoundTrip(empty, compSize);
+
+//	random bytes may at most grow by the tokens and the literal length bytes
+	std::vector<char> random;
+	RandomBytes(random, 100000, 2463534242u);
+	bool incompressibleOk = RoundTrip(random, compSize)
+							&& compSize <= random.size() + random.size() / 255 + 16;
+
+	std::vector<char> repetitive(1 << 20);
+	for(size_t i = 0; i < repetitive.size(); ++i)
+		repetitive[i] = "0123456789abcdef"[(i / 3) % 16];
+	bool repetitiveOk = RoundTrip(repetitive, compSize)
+						&& compSize < repetitive.size() / 100;
+
+//	a random block repeated within and beyond the maximal match offset of 64 KiB
+	std::vector<char> farRepeat;
+	std::vector<char> near, far;
+	RandomBytes(near, 60000, 88172645u);
+	RandomBytes(far, 70000, 521288629u);
+	farRepeat.insert(farRepeat.end(), near.begin(), near.end());
+	farRepeat.insert(farRepeat.end(), near.begin(), near.end());
+	farRepeat.insert(farRepeat.end(), far.begin(), far.end());
+	farRepeat.insert(farRepeat.end(), far.begin(), far.end());
+	bool offsetOk = RoundTrip(farRepeat, compSize)
+					&& compSize < farRepeat.size() - near.size() / 2;
+
+//	two blocks appended to the same buffer
+	bool appendOk = true;
+	{
+		BinaryBuffer in, comp, out;
+		in.write(&repetitive.front(), repetitive.size());
+		CompressBinaryBuffer(comp, in);
+		in.write(&random.front(), random.size());
+		CompressBinaryBuffer(comp, in);
+		DecompressBinaryBuffer(out, comp);
+		DecompressBinaryBuffer(out, comp);
+		appendOk = comp.eof()
+				&& out.write_pos() == repetitive.size() + random.size()
+				&& memcmp(out.buffer(), &repetitive.front(), repetitive.size()) == 0
+				&& memcmp(out.buffer() + repetitive.size(), &random.front(),
+						  random.size()) == 0;
+	}
+
+//	corrupt blocks: the compressed size exceeds the buffer, a match refers to
+//	data before the start of the output, the uncompressed size does not match
+//	and a literal run exceeds the uncompressed size.
+	bool corruptOk = true;
+	{
+		const char literals[] = {(char)0x40, 'a', 'b', 'c', 'd'};
+		const char badOffset[] = {(char)0x00, (char)0x01, (char)0x00};
+		corruptOk = corruptOk && Rejects(CreateBlock(4, 100, literals, 5));
+		corruptOk = corruptOk && Rejects(CreateBlock(4, 3, badOffset, 3));
+		corruptOk = corruptOk && Rejects(CreateBlock(5, 5, literals, 5));
+		corruptOk = corruptOk && Rejects(CreateBlock(3, 5, literals, 5));
+		corruptOk = corruptOk && !Rejects(CreateBlock(4, 5, literals, 5));
+	}
+
+	std::cout << "empty " << (emptyOk ? "ok" : "FAILED") << "\n"
+			  << "incompressible " << (incompressibleOk ? "ok" : "FAILED") << "\n"
+			  << "repetitive " << (repetitiveOk ? "ok" : "FAILED") << "\n"
+			  << "offsets beyond 64 KiB " << (offsetOk ? "ok" : "FAILED") << "\n"
+			  << "append " << (appendOk ? "ok" : "FAILED") << "\n"
+			  << "corrupt " << (corruptOk ? "ok" : "FAILED") << "\n";
+
+	assert(emptyOk && incompressibleOk && repetitiveOk && offsetOk && appendOk
+		   && corruptOk);
+}
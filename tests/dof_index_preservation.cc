@@ -0,0 +1,164 @@
+// refines and coarsens a grid with index preservation enabled and checks that
+// the dof indices keep their order. Vertex dofs (Lagrange 1) must keep their
+// indices under refinement, for Lagrange 2 the relative order of all dofs
+// which survive an adaption step must be preserved. Dofs are identified by the
+// type and the center of their element.
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/dof_position_util.h"
+#include "lib_grid/refinement/hanging_node_refiner_multi_grid.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+#endif
+
+using namespace ug;
+
+typedef Domain2d TDomain;
+typedef MathVector<2> TPos;
+typedef std::pair<int, TPos> TDoFKey;
+typedef std::map<TDoFKey, size_t> TIndexMap;
+
+//	index preservation can be enabled before or after the dofs are distributed
+struct TestSpace{
+	TestSpace(SmartPtr<TDomain> dom, int order, bool enableAfterInit) :
+		approx(new ApproximationSpace<TDomain>(dom)), order(order)
+	{
+		approx->add("u", "Lagrange", order);
+		if(!enableAfterInit)
+			approx->enable_index_preservation(true);
+		approx->init_top_surface();
+		if(enableAfterInit)
+			approx->enable_index_preservation(true);
+	}
+
+	SmartPtr<DoFDistribution> dd()	{return approx->dof_distribution(GridLevel());}
+
+	SmartPtr<ApproximationSpace<TDomain> >	approx;
+	int					order;
+	TIndexMap			indices;
+	bool				ok;
+};
+
+//	returns the index of the dof of each element, identified by its base
+//	object type and its center. Checks that all indices are used.
+template <class TElem>
+static void CollectIndices(TIndexMap& indices, std::vector<bool>& vUsed,
+						   TestSpace& space)
+{
+	SmartPtr<DoFDistribution> dd = space.dd();
+	TDomain& dom = *space.approx->domain();
+	std::vector<size_t> ind;
+	typedef typename DoFDistribution::traits<TElem>::const_iterator TIter;
+	for(TIter iter = dd->begin<TElem>(SurfaceView::ALL);
+		iter != dd->end<TElem>(SurfaceView::ALL); ++iter)
+	{
+		dd->inner_algebra_indices(*iter, ind);
+		for(size_t i = 0; i < ind.size(); ++i){
+			TDoFKey key(TElem::BASE_OBJECT_ID, CalculateCenter(*iter, dom.position_accessor()));
+			indices[key] = ind[i];
+			vUsed[ind[i]] = true;
+		}
+	}
+}
+
+static bool GetIndices(TIndexMap& indicesOut, TestSpace& space)
+{
+	std::vector<bool> vUsed(space.dd()->num_indices(), false);
+	indicesOut.clear();
+	CollectIndices<Vertex>(indicesOut, vUsed, space);
+	CollectIndices<Edge>(indicesOut, vUsed, space);
+	CollectIndices<Face>(indicesOut, vUsed, space);
+	return std::find(vUsed.begin(), vUsed.end(), false) == vUsed.end();
+}
+
+//	compares the indices with those before the last adaption step
+static void Check(TestSpace& space, bool sameIndices)
+{
+	TIndexMap oldIndices = space.indices;
+	space.ok = GetIndices(space.indices, space);
+
+//	surviving dofs sorted by their old index
+	std::vector<std::pair<size_t, size_t> > vOldNew;
+	for(TIndexMap::iterator iter = space.indices.begin(); iter != space.indices.end(); ++iter){
+		TIndexMap::iterator oldIter = oldIndices.find(iter->first);
+		if(oldIter != oldIndices.end())
+			vOldNew.push_back(std::make_pair(oldIter->second, iter->second));
+	}
+	std::sort(vOldNew.begin(), vOldNew.end());
+
+	space.ok = space.ok && !vOldNew.empty();
+	for(size_t i = 0; i < vOldNew.size(); ++i){
+		if(sameIndices && vOldNew[i].first != vOldNew[i].second)
+			space.ok = false;
+		if(i > 0 && vOldNew[i-1].second >= vOldNew[i].second)
+			space.ok = false;
+	}
+}
+
+static bool InRegion(TDomain& dom, Face* f, number size)
+{
+	TPos c = CalculateCenter(f, dom.position_accessor());
+	return c[0] < size && c[1] < size;
+}
+
+int main(int argc, char** argv)
+{
+#ifdef UG_PARALLEL
+	pcl::Init(&argc, &argv);
+#endif
+	SmartPtr<TDomain> dom(new TDomain(true));
+	LoadDomain(*dom, "lua/unit_square_quads.ugx");
+	MultiGrid& mg = *dom->grid();
+
+	TestSpace p1(dom, 1, false), p2(dom, 2, true);
+	TestSpace* spaces[] = {&p1, &p2};
+
+//	reverse the initial order, so that it differs from the order of the grid
+	for(size_t i = 0; i < 2; ++i){
+		const size_t numInd = spaces[i]->dd()->num_indices();
+		std::vector<size_t> vNewInd(numInd);
+		for(size_t j = 0; j < numInd; ++j)
+			vNewInd[j] = numInd - 1 - j;
+		spaces[i]->dd()->permute_indices(vNewInd);
+		GetIndices(spaces[i]->indices, *spaces[i]);
+	}
+
+	HangingNodeRefiner_MultiGrid refiner(mg, dom->refinement_projector());
+
+	const char* stepNames[] = {"refine", "refine", "coarsen", "coarsen"};
+	const number regions[] = {0.5, 0.3, 0.3, 0.5};
+	for(size_t step = 0; step < 4; ++step){
+		const bool coarsen = (step >= 2);
+		const size_t topLvl = mg.top_level();
+		for(FaceIterator iter = mg.begin<Face>(topLvl); iter != mg.end<Face>(topLvl); ++iter){
+			if(InRegion(*dom, *iter, regions[step]))
+				refiner.mark(*iter, coarsen ? RM_COARSEN : RM_REFINE);
+		}
+
+		if(coarsen)
+			refiner.coarsen();
+		else
+			refiner.refine();
+
+		std::cout << stepNames[step];
+		for(size_t i = 0; i < 2; ++i){
+			Check(*spaces[i], !coarsen && spaces[i]->order == 1);
+			std::cout << " p" << spaces[i]->order << " "
+					  << (spaces[i]->ok ? "ok" : "FAILED");
+			assert(spaces[i]->ok);
+		}
+		std::cout << "\n";
+	}
+
+#ifdef UG_PARALLEL
+	pcl::Finalize();
+#endif
+}
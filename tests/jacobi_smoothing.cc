@@ -0,0 +1,142 @@
+// compares the Jacobi smoothers with the serial (Gauss-Seidel like) smoothers
+// in manifold_smoothing.h on a perturbed triangulation of the unit square.
+//  - on a set of pairwise non-adjacent vertices one iteration of both has to
+//    give the same positions,
+//  - the Jacobi result must not depend on the number of threads,
+//  - LaplacianSmooth and LaplacianSmoothJacobi have to converge to the same
+//    positions.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lib_grid/lib_grid.h"
+#include "lib_grid/algorithms/smoothing/manifold_smoothing.h"
+#include "lib_grid/algorithms/smoothing/jacobi_smoothing.h"
+
+using namespace ug;
+
+static const int n = 8;
+
+enum Smoother{LAPLACIAN, TANGENTIAL, WEIGHTED_EDGE};
+
+//	a square of n x n quads, each split into two triangles. The inner vertices
+//	are moved by some deterministic offsets.
+static void CreateGrid(Grid& g, std::vector<Vertex*>& vrts)
+{
+	g.attach_to_vertices(aPosition);
+	Grid::VertexAttachmentAccessor<APosition> aaPos(g, aPosition);
+	vrts.clear();
+	for(int j = 0; j <= n; ++j){
+		for(int i = 0; i <= n; ++i){
+			Vertex* vrt = *g.create<RegularVertex>();
+			aaPos[vrt] = vector3((number)i / n, (number)j / n, 0);
+			if(i > 0 && i < n && j > 0 && j < n){
+				aaPos[vrt].x() += 0.3 / n * std::sin(1.0 + 7.0 * i + 3.0 * j);
+				aaPos[vrt].y() += 0.3 / n * std::cos(2.0 + 5.0 * i - 3.0 * j);
+			}
+			vrts.push_back(vrt);
+		}
+	}
+
+	for(int j = 0; j < n; ++j){
+		for(int i = 0; i < n; ++i){
+			Vertex* v0 = vrts[j*(n+1) + i];
+			Vertex* v1 = vrts[j*(n+1) + i + 1];
+			Vertex* v2 = vrts[(j+1)*(n+1) + i + 1];
+			Vertex* v3 = vrts[(j+1)*(n+1) + i];
+			g.create<Triangle>(TriangleDescriptor(v0, v1, v2));
+			g.create<Triangle>(TriangleDescriptor(v0, v2, v3));
+		}
+	}
+}
+
+//	smoothes the inner vertices (i, j) for which i % step == 0 and j % step == 0
+//	and returns the resulting positions of all vertices
+static std::vector<vector3>
+Smooth(Smoother smoother, bool jacobi, int step, number alpha,
+	   int numIterations, size_t numThreads)
+{
+	Grid g(GRIDOPT_STANDARD_INTERCONNECTION);
+	std::vector<Vertex*> vrts;
+	CreateGrid(g, vrts);
+	Grid::VertexAttachmentAccessor<APosition> aaPos(g, aPosition);
+
+	Selector sel(g);
+	for(int j = 1; j < n; ++j)
+		for(int i = 1; i < n; ++i)
+			if(i % step == 0 && j % step == 0)
+				sel.select(vrts[j*(n+1) + i]);
+
+	VertexIterator begin = sel.begin<Vertex>(), end = sel.end<Vertex>();
+	switch(smoother){
+		case LAPLACIAN:
+			if(jacobi)
+				LaplacianSmoothJacobi(g, begin, end, aaPos, alpha, numIterations, numThreads);
+			else
+				LaplacianSmooth(g, begin, end, aaPos, alpha, numIterations);
+			break;
+		case TANGENTIAL:
+			if(jacobi)
+				TangentialSmoothSimpleJacobi(g, begin, end, aaPos, alpha, numIterations, numThreads);
+			else
+				TangentialSmoothSimple(g, begin, end, aaPos, alpha, numIterations);
+			break;
+		case WEIGHTED_EDGE:
+			if(jacobi)
+				WeightedEdgeSmoothJacobi(g, begin, end, aaPos, alpha, numIterations,
+										 IsSelected(sel), numThreads);
+			else
+				WeightedEdgeSmooth(g, begin, end, aaPos, alpha, numIterations,
+								   IsSelected(sel));
+			break;
+	}
+
+	std::vector<vector3> vPos;
+	for(size_t i = 0; i < vrts.size(); ++i)
+		vPos.push_back(aaPos[vrts[i]]);
+	return vPos;
+}
+
+static number MaxDistance(const std::vector<vector3>& v1,
+						  const std::vector<vector3>& v2)
+{
+	number maxDist = 0;
+	for(size_t i = 0; i < v1.size(); ++i)
+		maxDist = std::max(maxDist, VecDistance(v1[i], v2[i]));
+	return maxDist;
+}
+
+static void Test(Smoother smoother, const char* name)
+{
+//	vertices with even indices are pairwise non-adjacent
+	number distIndep = MaxDistance(Smooth(smoother, false, 2, 0.5, 1, 1),
+								   Smooth(smoother, true, 2, 0.5, 1, 1));
+
+	std::vector<vector3> vPos1 = Smooth(smoother, true, 1, 0.5, 5, 1);
+	number distThreads = std::max(MaxDistance(vPos1, Smooth(smoother, true, 1, 0.5, 5, 2)),
+								  MaxDistance(vPos1, Smooth(smoother, true, 1, 0.5, 5, 4)));
+
+	std::cout << name << ": independent set " << (distIndep < 1e-12 ? "ok" : "FAILED")
+			  << " threads " << (distThreads == 0 ? "ok" : "FAILED");
+	assert(distIndep < 1e-12);
+	assert(distThreads == 0);
+
+	if(smoother == LAPLACIAN){
+		number distConv = MaxDistance(Smooth(smoother, false, 1, 0.5, 2000, 1),
+									  Smooth(smoother, true, 1, 0.5, 2000, 4));
+		std::cout << " fixed point " << (distConv < 1e-10 ? "ok" : "FAILED");
+		assert(distConv < 1e-10);
+	}
+	std::cout << "\n";
+}
+
+int main()
+{
+	Test(LAPLACIAN, "LaplacianSmooth");
+	Test(TANGENTIAL, "TangentialSmoothSimple");
+	Test(WEIGHTED_EDGE, "WeightedEdgeSmooth");
+}
@@ -0,0 +1,183 @@
+// compares LagrangeSumFactorization with LagrangeLSFS and the Gauss tensor
+// product quadratures on a distorted element
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "lib_disc/local_finite_element/lagrange/lagrange.h"
+#include "lib_disc/local_finite_element/lagrange/lagrange_sum_factorization.h"
+#include "lib_disc/quadrature/gauss_legendre/gauss_legendre.h"
+#include "lib_disc/quadrature/gauss_tensor_prod/gauss_tensor_prod.h"
+#include "lib_disc/reference_element/reference_mapping.h"
+
+using namespace ug;
+
+template <typename TRefElem> struct TestTraits;
+
+template <> struct TestTraits<ReferenceEdge>
+{
+	typedef GaussLegendre quad_type;
+	static const char* name() {return "edge";}
+};
+
+template <> struct TestTraits<ReferenceQuadrilateral>
+{
+	typedef GaussQuadratureQuadrilateral quad_type;
+	static const char* name() {return "quadrilateral";}
+};
+
+template <> struct TestTraits<ReferenceHexahedron>
+{
+	typedef GaussQuadratureHexahedron quad_type;
+	static const char* name() {return "hexahedron";}
+};
+
+//	corners of the reference element, moved to give a non-affine element
+template <int dim>
+void distorted_corners(std::vector<MathVector<dim> >& vCorner)
+{
+	const size_t numCo = 1 << dim;
+	vCorner.resize(numCo);
+	for(size_t co = 0; co < numCo; ++co)
+	{
+	//	reference corners in ug order (counterclockwise in the xy-plane)
+		MathVector<dim> x;
+		const size_t xy = co % 4;
+		x[0] = (xy == 1 || xy == 2) ? 1.0 : 0.0;
+		if(dim > 1) x[1] = (xy >= 2) ? 1.0 : 0.0;
+		if(dim > 2) x[2] = (co >= 4) ? 1.0 : 0.0;
+
+		for(int d = 0; d < dim; ++d)
+			vCorner[co][d] = 1.5 * x[d] + 0.1 * std::sin(3.0 * co + d);
+	}
+}
+
+template <typename TRefElem, int p>
+void test()
+{
+	static const int dim = TRefElem::dim;
+	typedef LagrangeLSFS<TRefElem, p> lsfs_type;
+	typedef typename TestTraits<TRefElem>::quad_type quad_type;
+
+	const lsfs_type lsfs;
+	const size_t quadOrder = 2*p + 1;
+	const quad_type quad(quadOrder);
+	const LagrangeSumFactorization<TRefElem> sf(p, quadOrder);
+	typename LagrangeSumFactorization<TRefElem>::Work work;
+
+	const size_t numSh = lsfs.num_sh();
+	assert(sf.num_sh() == numSh);
+	assert(sf.num_ip() == quad.size());
+
+	std::vector<MathVector<dim> > vCorner;
+	distorted_corners<dim>(vCorner);
+	ReferenceMapping<TRefElem, dim> mapping(&vCorner[0]);
+
+	std::vector<number> vCoeff(numSh), vRes(numSh), vRef(numSh);
+	for(size_t i = 0; i < numSh; ++i)
+		vCoeff[i] = std::cos(1.0 + 0.7 * i);
+
+	number errValue = 0.0, errGrad = 0.0, errInt = 0.0, errDiff = 0.0;
+
+//	values and gradients at the integration points
+	std::vector<number> vValue(sf.num_ip());
+	std::vector<MathVector<dim> > vGrad(sf.num_ip());
+	sf.values(&vValue[0], &vCoeff[0], work);
+	sf.gradients(&vGrad[0], &vCoeff[0], work);
+	for(size_t q = 0; q < sf.num_ip(); ++q)
+	{
+		number value = 0.0;
+		MathVector<dim> grad, g; VecSet(grad, 0.0);
+		for(size_t i = 0; i < numSh; ++i){
+			value += vCoeff[i] * lsfs.shape(i, sf.ip(q));
+			lsfs.grad(g, i, sf.ip(q));
+			VecScaleAppend(grad, vCoeff[i], g);
+		}
+		errValue = std::max(errValue, std::fabs(value - vValue[q]));
+		errGrad = std::max(errGrad, VecDistance(grad, vGrad[q]));
+	}
+
+//	integration of a linear function against the shape functions
+	for(size_t q = 0; q < sf.num_ip(); ++q)
+		vValue[q] = 1.0 + sf.ip(q)[0] + 2.0 * sf.ip(q)[dim-1];
+	sf.integrate(&vRes[0], &vValue[0], work);
+	for(size_t i = 0; i < numSh; ++i)
+	{
+		vRef[i] = 0.0;
+		for(size_t q = 0; q < quad.size(); ++q){
+			const MathVector<dim>& x = quad.point(q);
+			vRef[i] += quad.weight(q) * (1.0 + x[0] + 2.0 * x[dim-1]) * lsfs.shape(i, x);
+		}
+		errInt = std::max(errInt, std::fabs(vRef[i] - vRes[i]));
+	}
+
+//	anisotropic diffusion on the distorted element
+	MathMatrix<dim,dim> D; MatSet(D, 0.0);
+	for(int d = 0; d < dim; ++d) D(d, d) = 1.0 + d;
+
+	std::vector<MathMatrix<dim,dim> > vTensor(sf.num_ip());
+	MathMatrix<dim,dim> JTInv;
+	for(size_t q = 0; q < sf.num_ip(); ++q)
+	{
+		const number detJ = std::fabs(mapping.jacobian_transposed_inverse(JTInv, sf.ip(q)));
+		for(int i = 0; i < dim; ++i)
+			for(int j = 0; j < dim; ++j){
+				vTensor[q](i, j) = 0.0;
+				for(int k = 0; k < dim; ++k)
+					vTensor[q](i, j) += detJ * JTInv(k, i) * D(k, k) * JTInv(k, j);
+			}
+	}
+	sf.apply_diffusion(&vRes[0], &vCoeff[0], &vTensor[0], work);
+
+//	reference: element stiffness matrix assembled from the shape functions
+	for(size_t i = 0; i < numSh; ++i) vRef[i] = 0.0;
+	for(size_t q = 0; q < quad.size(); ++q)
+	{
+		const MathVector<dim>& x = quad.point(q);
+		const number detJ = std::fabs(mapping.jacobian_transposed_inverse(JTInv, x));
+
+		std::vector<MathVector<dim> > vGlobGrad(numSh);
+		MathVector<dim> g;
+		for(size_t i = 0; i < numSh; ++i){
+			lsfs.grad(g, i, x);
+			MatVecMult(vGlobGrad[i], JTInv, g);
+		}
+
+		for(size_t i = 0; i < numSh; ++i)
+			for(size_t j = 0; j < numSh; ++j)
+			{
+				number a = 0.0;
+				for(int d = 0; d < dim; ++d)
+					a += vGlobGrad[i][d] * D(d, d) * vGlobGrad[j][d];
+				vRef[i] += quad.weight(q) * detJ * a * vCoeff[j];
+			}
+	}
+	for(size_t i = 0; i < numSh; ++i)
+		errDiff = std::max(errDiff, std::fabs(vRef[i] - vRes[i]));
+
+	const number tol = 1e-12;
+	std::cout << TestTraits<TRefElem>::name() << " p=" << p
+			  << " values " << (errValue < tol ? "ok" : "FAILED")
+			  << " gradients " << (errGrad < tol ? "ok" : "FAILED")
+			  << " integrate " << (errInt < tol ? "ok" : "FAILED")
+			  << " diffusion " << (errDiff < tol ? "ok" : "FAILED") << "\n";
+
+	assert(errValue < tol);
+	assert(errGrad < tol);
+	assert(errInt < tol);
+	assert(errDiff < tol);
+}
+
+int main()
+{
+	test<ReferenceEdge, 1>();
+	test<ReferenceEdge, 2>();
+	test<ReferenceEdge, 3>();
+	test<ReferenceQuadrilateral, 1>();
+	test<ReferenceQuadrilateral, 2>();
+	test<ReferenceQuadrilateral, 3>();
+	test<ReferenceHexahedron, 1>();
+	test<ReferenceHexahedron, 2>();
+}
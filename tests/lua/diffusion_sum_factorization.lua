@@ -0,0 +1,63 @@
+--------------------------------------------------------------------------------
+--  Solves -laplace(u) = -4 with u = x^2 + y^2 on the boundary using
+--  DiffusionSumFactorizationFE. For order >= 2 the discrete solution must
+--  coincide with the exact one on the (affine) quadrilaterals.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_quads.ugx"
+numRefs = util.GetParamNumber("-numRefs", 2, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, 0)
+util.refinement.CreateRegularHierarchy(dom, numRefs, true)
+
+function exact(x, y, t)
+	return x*x + y*y
+end
+
+function exactBnd(x, y, t)
+	return true, x*x + y*y
+end
+
+for order = 1, 3 do
+	approxSpace = ApproximationSpace(dom)
+	approxSpace:add_fct("u", "Lagrange", order)
+	approxSpace:init_levels()
+	approxSpace:init_top_surface()
+
+	elemDisc = DiffusionSumFactorizationFE("u", "Inner")
+	elemDisc:set_diffusion(1.0)
+	elemDisc:set_source(-4.0)
+
+	dirichletBnd = DirichletBoundary()
+	dirichletBnd:add("exactBnd", "u", "Boundary")
+
+	domainDisc = DomainDiscretization(approxSpace)
+	domainDisc:add(elemDisc)
+	domainDisc:add(dirichletBnd)
+
+	A = AssembledLinearOperator(domainDisc)
+	u = GridFunction(approxSpace)
+	b = GridFunction(approxSpace)
+	u:set(0.0)
+	domainDisc:adjust_solution(u)
+	domainDisc:assemble_linear(A, b)
+
+	solver = LinearSolver()
+	solver:set_preconditioner(ILU())
+	solver:set_convergence_check(ConvCheck(1000, 1e-14, 1e-14, false))
+	solver:init(A, u)
+	solver:apply(u, b)
+
+	err = MaxError("exact", u, "u")
+	if order == 1 then
+		ok = err < 1e-2
+	else
+		ok = err < 1e-10
+	end
+	print("order " .. order .. ": " .. (ok and "ok" or "FAILED (error " .. err .. ")"))
+	assert(ok, "DiffusionSumFactorizationFE: wrong solution")
+end
@@ -0,0 +1,98 @@
+--------------------------------------------------------------------------------
+--  Refines and redistributes a domain with a load balancer, once without and
+--  once with compression of the migrated grid data. Checks that both runs
+--  create the same local grids and that a Poisson problem is solved on the
+--  compressed one. Meant to be run in parallel (e.g. mpirun -np 2 or -np 4).
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_quads.ugx"
+numRefs = util.GetParamNumber("-numRefs", 5, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+function CreateDistributedDomain(compressData)
+	local dom = util.CreateDomain(gridName, 0)
+	local bal = util.balancer.CreateLoadBalancer(dom)
+	if bal.balancer ~= nil then
+		bal.balancer:enable_data_compression(compressData)
+	end
+
+	local refiner = GlobalDomainRefiner(dom)
+	bal.rebalance()
+	for i = 1, numRefs do
+		refiner:refine()
+		bal.rebalance()
+	end
+	return dom
+end
+
+-- number of local vertices, edges and faces on each level
+function LocalGridSizes(dom)
+	local mg = dom:grid()
+	local sizes = {}
+	for lvl = 0, mg:num_levels() - 1 do
+		table.insert(sizes, mg:num_vertices(lvl))
+		table.insert(sizes, mg:num_edges(lvl))
+		table.insert(sizes, mg:num_faces(lvl))
+	end
+	return sizes
+end
+
+function SameSizes(a, b)
+	if #a ~= #b then return false end
+	for i = 1, #a do
+		if a[i] ~= b[i] then return false end
+	end
+	return true
+end
+
+plainDom = CreateDistributedDomain(false)
+compDom = CreateDistributedDomain(true)
+
+sameGrids = SameSizes(LocalGridSizes(plainDom), LocalGridSizes(compDom))
+			and TestDomainInterfaces(compDom)
+sameGrids = ParallelMax(sameGrids and 0 or 1) == 0
+print("DistributeGrid with compression, grids: " .. (sameGrids and "ok" or "FAILED"))
+
+approxSpace = ApproximationSpace(compDom)
+approxSpace:add_fct("u", "Lagrange", 2)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+function exact(x, y, t)
+	return x*x + y*y
+end
+
+function exactBnd(x, y, t)
+	return true, x*x + y*y
+end
+
+elemDisc = DiffusionSumFactorizationFE("u", "Inner")
+elemDisc:set_source(-4.0)
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add("exactBnd", "u", "Boundary")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+A = AssembledLinearOperator(domainDisc)
+u = GridFunction(approxSpace)
+b = GridFunction(approxSpace)
+u:set(0.0)
+domainDisc:adjust_solution(u)
+domainDisc:assemble_linear(A, b)
+
+solver = CG()
+solver:set_preconditioner(Jacobi(0.66))
+solver:set_convergence_check(ConvCheck(10000, 1e-14, 1e-14, false))
+solver:init(A, u)
+solver:apply(u, b)
+
+err = MaxError("exact", u, "u")
+solveOk = err < 1e-8
+print("DistributeGrid with compression, solution: "
+	  .. (solveOk and "ok" or "FAILED (error " .. err .. ")"))
+assert(sameGrids and solveOk, "DistributeGrid with compression failed on process " .. ProcRank())
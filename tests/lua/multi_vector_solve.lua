@@ -0,0 +1,97 @@
+--------------------------------------------------------------------------------
+--  Solves a Poisson problem for three right-hand sides with apply_multi of CG
+--  and GMRES and compares the results with three separate solves.
+--  Run in serial and in parallel (e.g. mpirun -np 2).
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_quads.ugx"
+numRefs = util.GetParamNumber("-numRefs", 4, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+dom = util.CreateDomain(gridName, 0)
+util.refinement.CreateRegularHierarchy(dom, numRefs, true)
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 1)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+elemDisc = DiffusionSumFactorizationFE("u", "Inner")
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add(0.0, "u", "Boundary")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+A = AssembledLinearOperator(domainDisc)
+tmp = GridFunction(approxSpace)
+rhs = GridFunction(approxSpace)
+domainDisc:assemble_linear(A, rhs)
+
+-- right-hand sides f = A*w for some functions w vanishing on the boundary
+function w1(x, y, t) return x*(1-x)*y*(1-y) end
+function w2(x, y, t) return math.sin(math.pi*x)*math.sin(2*math.pi*y) end
+function w3(x, y, t) return x*y*(1-x)*(1-y)*(x-0.3) end
+wNames = {"w1", "w2", "w3"}
+
+numRHS = #wNames
+vF = {}
+for i = 1, numRHS do
+	w = GridFunction(approxSpace)
+	Interpolate(wNames[i], w, "u")
+	vF[i] = GridFunction(approxSpace)
+	A:apply(vF[i], w)
+end
+
+function CreateSolvers()
+	local cg = CG()
+	cg:set_preconditioner(SymmetricGaussSeidel())
+	cg:set_convergence_check(ConvCheck(1000, 1e-16, 1e-12, false))
+
+	local gmres = GMRES(20)
+	gmres:set_preconditioner(ILU())
+	gmres:set_convergence_check(ConvCheck(1000, 1e-16, 1e-12, false))
+
+	return {CG = cg, GMRES = gmres}
+end
+
+for _, solverName in ipairs({"CG", "GMRES"}) do
+--	separate solves
+	local vSingle = {}
+	local single = CreateSolvers()[solverName]
+	single:init(A)
+	for i = 1, numRHS do
+		vSingle[i] = GridFunction(approxSpace)
+		vSingle[i]:set(0.0)
+		single:apply(vSingle[i], vF[i])
+	end
+
+--	one solve for all right-hand sides
+	local multi = CreateSolvers()[solverName]
+	multi:init(A)
+	local X = MultiVector()
+	local F = MultiVector()
+	local vMulti = {}
+	for i = 1, numRHS do
+		vMulti[i] = GridFunction(approxSpace)
+		vMulti[i]:set(0.0)
+		X:push_back(vMulti[i])
+		F:push_back(vF[i]:clone())
+	end
+	assert(multi:apply_multi(X, F), solverName .. ": apply_multi failed")
+
+	local maxDiff = 0
+	for i = 1, numRHS do
+		VecScaleAdd2(tmp, 1.0, vMulti[i], -1.0, vSingle[i])
+		maxDiff = math.max(maxDiff, VecMaxNorm(tmp) / VecMaxNorm(vSingle[i]))
+	end
+
+	local ok = maxDiff < 1e-8
+	print(solverName .. " apply_multi with " .. numRHS .. " right-hand sides: "
+		  .. (ok and "ok" or "FAILED (difference " .. maxDiff .. ")"))
+	assert(ok, solverName .. ": apply_multi differs from single solves")
+end
@@ -0,0 +1,75 @@
+--------------------------------------------------------------------------------
+--  Writes a partitioned domain on the first process, loads it with
+--  LoadPartitionedDomain on all processes and solves a Poisson problem on it.
+--  Meant to be run in parallel (e.g. mpirun -np 2 or -np 4). With 4 processes
+--  two of them do not receive any elements of the coarse grid.
+--------------------------------------------------------------------------------
+
+ug_load_script("ug_util.lua")
+
+gridName = "unit_square_quads.ugx"
+partFile = "partitioned_domain_test.ugb"
+numRefs = util.GetParamNumber("-numRefs", 3, "Number of refinements")
+
+InitUG(2, AlgebraType("CPU", 1))
+
+-- the serial grid only exists on the first process
+serialDom = Domain()
+LoadDomain(serialDom, gridName, 0)
+if ProcRank() == 0 then
+	partitionMap = PartitionMap()
+	partitionMap:add_target_procs(0, NumProcs())
+	PartitionDomain_RegularGrid(serialDom, partitionMap, NumProcs(), 1, 1, false)
+	SavePartitionedDomain(serialDom, partitionMap, partFile)
+end
+SynchronizeProcesses()
+
+dom = Domain()
+LoadPartitionedDomain(dom, partFile)
+assert(TestDomainInterfaces(dom), "LoadPartitionedDomain: inconsistent interfaces")
+
+refiner = GlobalDomainRefiner(dom)
+for i = 1, numRefs do
+	refiner:refine()
+end
+assert(TestDomainInterfaces(dom), "LoadPartitionedDomain: inconsistent interfaces after refinement")
+
+approxSpace = ApproximationSpace(dom)
+approxSpace:add_fct("u", "Lagrange", 2)
+approxSpace:init_levels()
+approxSpace:init_top_surface()
+
+function exact(x, y, t)
+	return x*x + y*y
+end
+
+function exactBnd(x, y, t)
+	return true, x*x + y*y
+end
+
+elemDisc = DiffusionSumFactorizationFE("u", "Inner")
+elemDisc:set_source(-4.0)
+dirichletBnd = DirichletBoundary()
+dirichletBnd:add("exactBnd", "u", "Boundary")
+
+domainDisc = DomainDiscretization(approxSpace)
+domainDisc:add(elemDisc)
+domainDisc:add(dirichletBnd)
+
+A = AssembledLinearOperator(domainDisc)
+u = GridFunction(approxSpace)
+b = GridFunction(approxSpace)
+u:set(0.0)
+domainDisc:adjust_solution(u)
+domainDisc:assemble_linear(A, b)
+
+solver = CG()
+solver:set_preconditioner(Jacobi(0.66))
+solver:set_convergence_check(ConvCheck(10000, 1e-14, 1e-14, false))
+solver:init(A, u)
+solver:apply(u, b)
+
+err = MaxError("exact", u, "u")
+ok = err < 1e-8
+print("LoadPartitionedDomain: " .. (ok and "ok" or "FAILED (error " .. err .. ")"))
+assert(ok, "LoadPartitionedDomain: wrong solution on process " .. ProcRank())
@@ -0,0 +1,95 @@
+// resolves the intersections of three triangulated squares with different
+// numbers of threads. The output does not depend on the number of threads and
+// the reference output was created with the ntree based serial implementation.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lib_grid/lib_grid.h"
+#include "lib_grid/algorithms/remeshing/resolve_intersections.h"
+
+using namespace ug;
+
+//	a square of n x n quads, each split into two triangles. The square is
+//	spanned by o + s*u + t*v, s, t in [0, 1].
+static void CreateSquare(Grid& g, Grid::VertexAttachmentAccessor<APosition>& aaPos,
+						 const vector3& o, const vector3& u, const vector3& v, int n)
+{
+	std::vector<Vertex*> vrts;
+	for(int j = 0; j <= n; ++j){
+		for(int i = 0; i <= n; ++i){
+			Vertex* vrt = *g.create<RegularVertex>();
+			vector3 p;
+			VecScaleAdd(p, 1.0, o, (number)i / n, u, (number)j / n, v);
+			aaPos[vrt] = p;
+			vrts.push_back(vrt);
+		}
+	}
+
+	for(int j = 0; j < n; ++j){
+		for(int i = 0; i < n; ++i){
+			Vertex* v0 = vrts[j*(n+1) + i];
+			Vertex* v1 = vrts[j*(n+1) + i + 1];
+			Vertex* v2 = vrts[(j+1)*(n+1) + i + 1];
+			Vertex* v3 = vrts[(j+1)*(n+1) + i];
+			g.create<Triangle>(TriangleDescriptor(v0, v1, v2));
+			g.create<Triangle>(TriangleDescriptor(v0, v2, v3));
+		}
+	}
+}
+
+static std::string PosString(const vector3& p)
+{
+	char buf[128];
+	sprintf(buf, "%.6f %.6f %.6f",
+			std::fabs(p.x()) < 5e-7 ? 0.0 : p.x(),
+			std::fabs(p.y()) < 5e-7 ? 0.0 : p.y(),
+			std::fabs(p.z()) < 5e-7 ? 0.0 : p.z());
+	return buf;
+}
+
+static void Test(size_t numThreads)
+{
+	Grid g(GRIDOPT_STANDARD_INTERCONNECTION);
+	g.attach_to_vertices(aPosition);
+	Grid::VertexAttachmentAccessor<APosition> aaPos(g, aPosition);
+
+//	a horizontal square, a vertical square crossing it and a tilted one
+	CreateSquare(g, aaPos, vector3(0, 0, 0.5), vector3(1, 0, 0), vector3(0, 1, 0), 6);
+	CreateSquare(g, aaPos, vector3(0.37, -0.1, 0), vector3(0, 1.2, 0), vector3(0, 0, 1), 5);
+	CreateSquare(g, aaPos, vector3(-0.1, 0.21, 0.1), vector3(1.2, 0, 0), vector3(0, 0.3, 0.8), 7);
+
+	bool success = ResolveTriangleIntersections(g, g.begin<Triangle>(), g.end<Triangle>(),
+												1e-6, aPosition, numThreads);
+	assert(success);
+
+//	the element order may differ between implementations, hence the
+//	vertices are compared by their sorted positions
+	std::vector<std::string> vPos;
+	for(VertexIterator iter = g.vertices_begin(); iter != g.vertices_end(); ++iter)
+		vPos.push_back(PosString(aaPos[*iter]));
+	std::sort(vPos.begin(), vPos.end());
+
+	std::cout << "vertices " << g.num_vertices() << " edges " << g.num_edges()
+			  << " triangles " << g.num<Triangle>() << "\n";
+
+	unsigned int hash = 0;
+	for(size_t i = 0; i < vPos.size(); ++i)
+		for(size_t j = 0; j < vPos[i].size(); ++j)
+			hash = hash * 31 + (unsigned char)vPos[i][j];
+	std::cout << "vertex positions hash " << hash << "\n";
+}
+
+int main()
+{
+	const size_t vNumThreads[] = {1, 2, 4};
+	for(size_t i = 0; i < 3; ++i){
+		std::cout << "== " << vNumThreads[i] << " threads\n";
+		Test(vNumThreads[i]);
+	}
+}
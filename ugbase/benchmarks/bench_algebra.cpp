@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include "benchmark.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_impl.h"
+#include "lib_algebra/cpu_algebra/vector.h"
+#include "lib_algebra/algebra_common/core_smoothers.h"
+
+namespace ug{
+namespace bench{
+
+typedef SparseMatrix<double>	matrix_type;
+typedef Vector<double>			vector_type;
+
+///	creates the 5-point (2d) or 7-point (3d) finite difference laplacian
+/**	The process local grid has size cells in each direction. For strong scaling
+ * the last direction is split between the processes.*/
+static void CreateLaplaceMatrix(matrix_type& A, const Context& ctx)
+{
+	const Options& opt = ctx.options();
+	const int dim = std::max(1, opt.dim);
+	size_t n[3] = {opt.size, dim > 1 ? opt.size : 1, dim > 2 ? opt.size : 1};
+	if(!opt.weak)
+		n[dim - 1] = std::max<size_t>(1, n[dim - 1] / ctx.num_procs());
+
+	const size_t numRows = n[0] * n[1] * n[2];
+	const size_t stride[3] = {1, n[0], n[0] * n[1]};
+
+	A.resize_and_clear(numRows, numRows);
+	for(size_t k = 0; k < n[2]; ++k)
+	for(size_t j = 0; j < n[1]; ++j)
+	for(size_t i = 0; i < n[0]; ++i){
+		const size_t ind[3] = {i, j, k};
+		const size_t row = i + j * stride[1] + k * stride[2];
+		A(row, row) = 2 * dim;
+		for(int d = 0; d < dim; ++d){
+			if(ind[d] > 0)			A(row, row - stride[d]) = -1;
+			if(ind[d] + 1 < n[d])	A(row, row + stride[d]) = -1;
+		}
+	}
+	A.defragment();
+}
+
+void RunAlgebraBenchmarks(Context& ctx)
+{
+	const bool runVec = ctx.enabled("vec_scale_add");
+	const bool runSpMV = ctx.enabled("spmv");
+	const bool runGS = ctx.enabled("gs_sweep");
+	if(!(runVec || runSpMV || runGS))
+		return;
+
+	matrix_type A;
+	CreateLaplaceMatrix(A, ctx);
+
+	const size_t numRows = A.num_rows();
+	const double nnz = A.total_num_connections();
+
+	vector_type x(numRows), y(numRows);
+	x.set_random(0, 1);
+	y.set(0.0);
+
+//	stream-like reference for the memory bandwidth
+	if(runVec){
+		ctx.measure("vec_scale_add", numRows, 3. * numRows * sizeof(double), 2. * numRows,
+					[&](){VecScaleAdd(y, 1.0, y, 0.5, x);});
+	}
+
+//	values and column indices of A, row pointers, source and destination vector
+	const double matBytes = nnz * (sizeof(double) + sizeof(int))
+							+ numRows * (sizeof(int) + 2 * sizeof(double));
+	if(runSpMV){
+		ctx.measure("spmv", numRows, matBytes, 2. * nnz,
+					[&](){A.apply(y, x);});
+	}
+
+	if(runGS){
+		ctx.measure("gs_sweep", numRows, matBytes, 2. * nnz,
+					[&](){gs_step_LL(A, y, x, 1.0);});
+	}
+}
+
+}//	end of namespace bench
+}//	end of namespace ug
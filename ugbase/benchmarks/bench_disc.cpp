@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "benchmark.h"
+#include "bench_domain.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/spatial_disc/domain_disc.h"
+#include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
+#include "lib_disc/spatial_disc/disc_util/fe_geom.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
+
+namespace ug{
+namespace bench{
+
+///	Lagrange finite element discretization of the Laplace operator
+/**	Only used to measure the element loop and the matrix assembly. The
+ * domain has no boundary conditions.*/
+template <typename TDomain>
+class BenchLaplaceFE : public IElemDisc<TDomain>
+{
+	private:
+		typedef IElemDisc<TDomain> base_type;
+		static const int dim = TDomain::dim;
+
+	public:
+		BenchLaplaceFE(const char* functions, const char* subsets) :
+			base_type(functions, subsets)	{}
+
+		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid)
+		{
+			UG_COND_THROW(vLfeID.size() != 1 || bNonRegularGrid,
+						  "BenchLaplaceFE: one function on regular grids required.");
+			m_lfeID = vLfeID[0];
+			m_quadOrder = 2 * m_lfeID.order();
+		}
+
+		virtual void prep_elem_loop(const ReferenceObjectID roid, const int si) {}
+		virtual void fsh_elem_loop() {}
+
+		virtual void prep_elem(const LocalVector& u, GridObject* elem,
+							   const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
+		{
+			m_geo.update(elem, vCornerCoords, m_lfeID, m_quadOrder);
+		}
+
+		virtual void add_jac_A_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem,
+									const MathVector<dim> vCornerCoords[])
+		{
+			for(size_t ip = 0; ip < m_geo.num_ip(); ++ip)
+				for(size_t i = 0; i < m_geo.num_sh(); ++i)
+					for(size_t j = 0; j < m_geo.num_sh(); ++j)
+						J(0, i, 0, j) += m_geo.weight(ip)
+							* VecDot(m_geo.global_grad(ip, i), m_geo.global_grad(ip, j));
+		}
+
+		virtual void add_def_A_elem(LocalVector& d, const LocalVector& u, GridObject* elem,
+									const MathVector<dim> vCornerCoords[])
+		{
+			for(size_t ip = 0; ip < m_geo.num_ip(); ++ip){
+				MathVector<dim> grad(0.0);
+				for(size_t j = 0; j < m_geo.num_sh(); ++j)
+					VecScaleAppend(grad, u(0, j), m_geo.global_grad(ip, j));
+				for(size_t i = 0; i < m_geo.num_sh(); ++i)
+					d(0, i) += m_geo.weight(ip) * VecDot(grad, m_geo.global_grad(ip, i));
+			}
+		}
+
+		virtual void add_jac_M_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem,
+									const MathVector<dim> vCornerCoords[]) {}
+		virtual void add_def_M_elem(LocalVector& d, const LocalVector& u, GridObject* elem,
+									const MathVector<dim> vCornerCoords[]) {}
+		virtual void add_rhs_elem(LocalVector& rhs, GridObject* elem,
+								  const MathVector<dim> vCornerCoords[]) {}
+
+	private:
+		DimFEGeometry<dim>	m_geo;
+		LFEID				m_lfeID;
+		int					m_quadOrder;
+};
+
+
+template <typename TDomain, typename TAlgebra>
+static void RunDiscBenchmarks(Context& ctx)
+{
+	typedef GridFunction<TDomain, TAlgebra> function_type;
+	typedef typename TAlgebra::matrix_type matrix_type;
+
+	const bool runAssemble = ctx.enabled("assemble_jacobian");
+	const bool runExchange = ctx.enabled("interface_exchange");
+	if(!(runAssemble || runExchange))
+		return;
+
+	SmartPtr<TDomain> spDom = make_sp(new TDomain());
+	CreateStructuredDomain(*spDom, ctx);
+	DistributeStructuredDomain(*spDom, ctx);
+
+	SmartPtr<ApproximationSpace<TDomain> > spApprox =
+			make_sp(new ApproximationSpace<TDomain>(spDom));
+	spApprox->add("c", "Lagrange", 1);
+	spApprox->init_levels();
+	spApprox->init_top_surface();
+
+	function_type u(spApprox);
+	u.set(1.0);
+
+	const size_t numCells = StructuredDomainSize(TDomain::dim, ctx);
+
+	if(runAssemble){
+		SmartPtr<DomainDiscretization<TDomain, TAlgebra> > spDomDisc =
+				make_sp(new DomainDiscretization<TDomain, TAlgebra>(spApprox));
+		SmartPtr<IElemDisc<TDomain> > spElemDisc =
+				make_sp(new BenchLaplaceFE<TDomain>("c", "Inner"));
+		spDomDisc->add(spElemDisc);
+
+		matrix_type J;
+		ctx.measure("assemble_jacobian", numCells, 0, 0,
+					[&](){spDomDisc->assemble_jacobian(J, u);});
+	}
+
+#ifdef UG_PARALLEL
+//	values on slaves are sent to masters, summed up and sent back
+	if(runExchange){
+		double numInterfaceEntries = 0;
+		const AlgebraLayouts& layouts = *u.layouts();
+		for(IndexLayout::const_iterator iter = layouts.master().begin();
+			iter != layouts.master().end(); ++iter)
+			numInterfaceEntries += layouts.master().interface(iter).size();
+		for(IndexLayout::const_iterator iter = layouts.slave().begin();
+			iter != layouts.slave().end(); ++iter)
+			numInterfaceEntries += layouts.slave().interface(iter).size();
+
+		ctx.measure("interface_exchange", numCells,
+					2 * numInterfaceEntries * sizeof(double), 0,
+					[&](){u.set_storage_type(PST_ADDITIVE);},
+					[&](){u.change_storage_type(PST_CONSISTENT);});
+	}
+#endif
+}
+
+void RunDiscBenchmarks(Context& ctx)
+{
+#ifdef UG_CPU_1
+	switch(ctx.options().dim){
+	#ifdef UG_DIM_1
+		case 1: RunDiscBenchmarks<Domain1d, CPUAlgebra>(ctx); break;
+	#endif
+	#ifdef UG_DIM_2
+		case 2: RunDiscBenchmarks<Domain2d, CPUAlgebra>(ctx); break;
+	#endif
+	#ifdef UG_DIM_3
+		case 3: RunDiscBenchmarks<Domain3d, CPUAlgebra>(ctx); break;
+	#endif
+		default: UG_THROW("RunDiscBenchmarks: dimension " << ctx.options().dim
+						  << " is not compiled.");
+	}
+#else
+	UG_LOG("  Discretization benchmarks require CPU=1.\n");
+#endif
+}
+
+}//	end of namespace bench
+}//	end of namespace ug
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__BENCHMARKS__BENCH_DOMAIN__
+#define __H__UG__BENCHMARKS__BENCH_DOMAIN__
+
+#include <algorithm>
+#include <vector>
+#include "benchmark.h"
+#include "lib_disc/domain.h"
+#include "lib_grid/lib_grid_messages.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_disc/parallelization/domain_distribution.h"
+	#include "lib_grid/tools/partition_map.h"
+#endif
+
+namespace ug{
+namespace bench{
+
+///	number of cells in each direction of the global structured domain
+inline void StructuredDomainCells(size_t nOut[3], int dim, const Context& ctx)
+{
+	const Options& opt = ctx.options();
+	nOut[0] = opt.size * (opt.weak ? ctx.num_procs() : 1);
+	nOut[1] = dim > 1 ? opt.size : 1;
+	nOut[2] = dim > 2 ? opt.size : 1;
+}
+
+///	number of cells of the global structured domain
+inline size_t StructuredDomainSize(int dim, const Context& ctx)
+{
+	size_t n[3];
+	StructuredDomainCells(n, dim, ctx);
+	return n[0] * n[1] * n[2];
+}
+
+///	fills the grid of the domain with a structured grid of edges, quadrilaterals or hexahedra
+/**	Only the first process creates elements. All elements are assigned to the
+ * subset "Inner". With weak scaling the domain is extended in x-direction by
+ * the number of processes.*/
+template <typename TDomain>
+void CreateStructuredDomain(TDomain& dom, const Context& ctx)
+{
+	static const int dim = TDomain::dim;
+	typedef typename TDomain::position_type position_type;
+
+	MultiGrid& mg = *dom.grid();
+	typename TDomain::subset_handler_type& sh = *dom.subset_handler();
+	typename TDomain::position_accessor_type& aaPos = dom.position_accessor();
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS, 0));
+	if(ctx.proc_rank() == 0){
+		size_t n[3];
+		StructuredDomainCells(n, dim, ctx);
+		const number h = 1. / (number)ctx.options().size;
+		const size_t nv[3] = {n[0] + 1, dim > 1 ? n[1] + 1 : 1, dim > 2 ? n[2] + 1 : 1};
+
+		std::vector<Vertex*> vrts(nv[0] * nv[1] * nv[2]);
+		for(size_t k = 0; k < nv[2]; ++k)
+		for(size_t j = 0; j < nv[1]; ++j)
+		for(size_t i = 0; i < nv[0]; ++i){
+			Vertex* v = *mg.create<RegularVertex>();
+			const size_t ind[3] = {i, j, k};
+			position_type pos;
+			for(int d = 0; d < dim; ++d)
+				pos[d] = h * ind[d];
+			aaPos[v] = pos;
+			vrts[i + nv[0] * (j + nv[1] * k)] = v;
+		}
+
+		#define VRT(i, j, k) vrts[(i) + nv[0] * ((j) + nv[1] * (k))]
+		for(size_t k = 0; k < n[2]; ++k)
+		for(size_t j = 0; j < n[1]; ++j)
+		for(size_t i = 0; i < n[0]; ++i){
+			if(dim == 1)
+				mg.create<RegularEdge>(EdgeDescriptor(VRT(i, 0, 0), VRT(i+1, 0, 0)));
+			else if(dim == 2)
+				mg.create<Quadrilateral>(QuadrilateralDescriptor(
+						VRT(i, j, 0), VRT(i+1, j, 0), VRT(i+1, j+1, 0), VRT(i, j+1, 0)));
+			else
+				mg.create<Hexahedron>(HexahedronDescriptor(
+						VRT(i, j, k), VRT(i+1, j, k), VRT(i+1, j+1, k), VRT(i, j+1, k),
+						VRT(i, j, k+1), VRT(i+1, j, k+1), VRT(i+1, j+1, k+1), VRT(i, j+1, k+1)));
+		}
+		#undef VRT
+
+		sh.assign_subset(mg.begin<Vertex>(), mg.end<Vertex>(), 0);
+		sh.assign_subset(mg.begin<Edge>(), mg.end<Edge>(), 0);
+		sh.assign_subset(mg.begin<Face>(), mg.end<Face>(), 0);
+		sh.assign_subset(mg.begin<Volume>(), mg.end<Volume>(), 0);
+		sh.subset_info(0).name = "Inner";
+	}
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS, 0));
+}
+
+///	distributes a domain created through CreateStructuredDomain into slabs in x-direction
+template <typename TDomain>
+void DistributeStructuredDomain(TDomain& dom, const Context& ctx)
+{
+#ifdef UG_PARALLEL
+	const int numProcs = ctx.num_procs();
+	if(numProcs == 1)
+		return;
+
+	PartitionMap partitionMap;
+	partitionMap.assign_grid(*dom.grid());
+	if(ctx.proc_rank() == 0){
+		partitionMap.add_target_procs(0, numProcs);
+		PartitionDomain_RegularGrid(dom, partitionMap, numProcs, 1, 1, false);
+	}
+	DistributeDomain(dom, partitionMap, true);
+#endif
+}
+
+}//	end of namespace bench
+}//	end of namespace ug
+
+#endif
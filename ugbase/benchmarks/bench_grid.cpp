@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "benchmark.h"
+#include "bench_domain.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_grid/parallelization/parallel_refinement/parallel_refinement.h"
+#endif
+
+namespace ug{
+namespace bench{
+
+///	global refiner for the (possibly distributed) domain
+template <typename TDomain>
+static SmartPtr<IRefiner> CreateGlobalRefiner(TDomain& dom)
+{
+#ifdef UG_PARALLEL
+	if(pcl::NumProcs() > 1){
+		return SmartPtr<IRefiner>(
+				new ParallelGlobalRefiner_MultiGrid(*dom.distributed_grid_manager(),
+													dom.refinement_projector()));
+	}
+#endif
+	return SmartPtr<IRefiner>(
+			new GlobalMultiGridRefiner(*dom.grid(), dom.refinement_projector()));
+}
+
+template <typename TDomain>
+static void RunGridBenchmarks(Context& ctx)
+{
+	const size_t numCells = StructuredDomainSize(TDomain::dim, ctx);
+	SmartPtr<TDomain> spDom;
+
+	if(ctx.enabled("grid_refine")){
+		SmartPtr<IRefiner> spRefiner;
+		ctx.measure("grid_refine", numCells, 0, 0,
+			[&](){
+				spRefiner = SPNULL;
+				spDom = make_sp(new TDomain());
+				CreateStructuredDomain(*spDom, ctx);
+				DistributeStructuredDomain(*spDom, ctx);
+				spRefiner = CreateGlobalRefiner(*spDom);
+			},
+			[&](){spRefiner->refine();});
+	}
+
+#ifdef UG_PARALLEL
+	if(ctx.enabled("distribute_grid") && ctx.num_procs() > 1){
+		ctx.measure("distribute_grid", numCells, 0, 0,
+			[&](){
+				spDom = make_sp(new TDomain());
+				CreateStructuredDomain(*spDom, ctx);
+			},
+			[&](){DistributeStructuredDomain(*spDom, ctx);});
+	}
+#endif
+}
+
+void RunGridBenchmarks(Context& ctx)
+{
+	switch(ctx.options().dim){
+	#ifdef UG_DIM_1
+		case 1: RunGridBenchmarks<Domain1d>(ctx); break;
+	#endif
+	#ifdef UG_DIM_2
+		case 2: RunGridBenchmarks<Domain2d>(ctx); break;
+	#endif
+	#ifdef UG_DIM_3
+		case 3: RunGridBenchmarks<Domain3d>(ctx); break;
+	#endif
+		default: UG_THROW("RunGridBenchmarks: dimension " << ctx.options().dim
+						  << " is not compiled.");
+	}
+}
+
+}//	end of namespace bench
+}//	end of namespace ug
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+#include "benchmark.h"
+#include "common/error.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+	#include "pcl/pcl_process_communicator.h"
+	#include "pcl/pcl_util.h"
+#endif
+
+namespace ug{
+namespace bench{
+
+Options::Options() :
+	dim(0), size(64), reps(5), weak(false), tolerance(0.1)
+{
+//	prefer 2d, otherwise the first compiled dimension
+#if defined(UG_DIM_2)
+	dim = 2;
+#elif defined(UG_DIM_1)
+	dim = 1;
+#elif defined(UG_DIM_3)
+	dim = 3;
+#endif
+}
+
+
+double Result::min_time() const
+{
+	return times.empty() ? 0 : *std::min_element(times.begin(), times.end());
+}
+
+double Result::mean_time() const
+{
+	double sum = 0;
+	for(size_t i = 0; i < times.size(); ++i)
+		sum += times[i];
+	return times.empty() ? 0 : sum / times.size();
+}
+
+double Result::max_time() const
+{
+	return times.empty() ? 0 : *std::max_element(times.begin(), times.end());
+}
+
+
+Context::Context(const Options& opt) :
+	m_opt(opt)
+{
+}
+
+bool Context::enabled(const char* name) const
+{
+	return m_opt.filter.empty() || std::string(name).find(m_opt.filter) != std::string::npos;
+}
+
+int Context::num_procs() const
+{
+#ifdef UG_PARALLEL
+	return pcl::NumProcs();
+#else
+	return 1;
+#endif
+}
+
+int Context::proc_rank() const
+{
+#ifdef UG_PARALLEL
+	return pcl::ProcRank();
+#else
+	return 0;
+#endif
+}
+
+void Context::synchronize() const
+{
+#ifdef UG_PARALLEL
+	pcl::SynchronizeProcesses();
+#endif
+}
+
+double Context::max_over_procs(double t) const
+{
+#ifdef UG_PARALLEL
+	return pcl::ProcessCommunicator().allreduce(t, PCL_RO_MAX);
+#else
+	return t;
+#endif
+}
+
+
+void WriteResultsJSON(std::ostream& out, const Context& ctx)
+{
+	const Options& opt = ctx.options();
+	const std::vector<Result>& results = ctx.results();
+
+	out << std::setprecision(6);
+	out << "{\n";
+	out << "\"context\": {\"procs\": " << ctx.num_procs()
+		<< ", \"threads_per_proc\": 1"
+		<< ", \"hardware_threads\": " << std::thread::hardware_concurrency()
+		<< ", \"dim\": " << opt.dim << ", \"size\": " << opt.size
+		<< ", \"weak\": " << (opt.weak ? "true" : "false")
+		<< ", \"reps\": " << opt.reps << "},\n";
+	out << "\"benchmarks\": [\n";
+	for(size_t i = 0; i < results.size(); ++i){
+		const Result& res = results[i];
+		const double t = res.min_time();
+		out << "{\"name\": \"" << res.name << "\""
+			<< ", \"problem_size\": " << res.problemSize
+			<< ", \"procs\": " << ctx.num_procs()
+			<< ", \"threads\": 1"
+			<< ", \"time_min\": " << t
+			<< ", \"time_mean\": " << res.mean_time()
+			<< ", \"time_max\": " << res.max_time()
+			<< ", \"bandwidth_gbs\": " << (t > 0 ? res.bytes / t * 1e-9 : 0)
+			<< ", \"gflops\": " << (t > 0 ? res.flops / t * 1e-9 : 0)
+			<< "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "]\n}\n";
+}
+
+
+///	returns the value of key in a line written by WriteResultsJSON
+static std::string ExtractValue(const std::string& line, const std::string& key)
+{
+	std::string pattern = "\"" + key + "\": ";
+	size_t pos = line.find(pattern);
+	if(pos == std::string::npos)
+		return "";
+	pos += pattern.size();
+	if(line[pos] == '"'){
+		size_t end = line.find('"', pos + 1);
+		return line.substr(pos + 1, end - pos - 1);
+	}
+	size_t end = line.find_first_of(",}", pos);
+	return line.substr(pos, end - pos);
+}
+
+int CompareWithBaseline(const Context& ctx, const std::string& baselineFile)
+{
+	std::ifstream in(baselineFile.c_str());
+	UG_COND_THROW(!in, "Could not open baseline " << baselineFile);
+
+//	key: name, problem size and number of processes
+	std::map<std::string, double> baseline;
+	std::string line;
+	while(std::getline(in, line)){
+		std::string name = ExtractValue(line, "name");
+		if(name.empty())
+			continue;
+		std::string key = name + "/" + ExtractValue(line, "problem_size")
+						+ "/" + ExtractValue(line, "procs");
+		baseline[key] = atof(ExtractValue(line, "time_min").c_str());
+	}
+
+	int numRegressions = 0;
+	const std::vector<Result>& results = ctx.results();
+	UG_LOG("\nComparison with baseline " << baselineFile << " (tolerance "
+		   << ctx.options().tolerance * 100 << "%):\n");
+	for(size_t i = 0; i < results.size(); ++i){
+		const Result& res = results[i];
+		std::stringstream key;
+		key << res.name << "/" << res.problemSize << "/" << ctx.num_procs();
+		std::map<std::string, double>::iterator iter = baseline.find(key.str());
+		if(iter == baseline.end() || iter->second <= 0){
+			UG_LOG("  " << std::setw(24) << std::left << res.name << "  no baseline\n");
+			continue;
+		}
+
+		const double ratio = res.min_time() / iter->second;
+		const bool regression = ratio > 1 + ctx.options().tolerance;
+		if(regression)
+			++numRegressions;
+		UG_LOG("  " << std::setw(24) << std::left << res.name << "  "
+			   << std::fixed << std::setprecision(3) << ratio << std::defaultfloat
+			   << (regression ? "  REGRESSION" : "") << "\n");
+	}
+	return numRegressions;
+}
+
+}//	end of namespace bench
+}//	end of namespace ug
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__BENCHMARKS__BENCHMARK__
+#define __H__UG__BENCHMARKS__BENCHMARK__
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include "common/types.h"
+#include "common/util/smart_pointer.h"
+
+namespace ug{
+namespace bench{
+
+///	command line options of ugbench
+struct Options
+{
+	Options();
+
+	int				dim;		///< dimension of generated domains
+	size_t			size;		///< number of cells per direction and process slab
+	size_t			reps;		///< number of timed repetitions of each kernel
+	bool			weak;		///< if true the domain grows with the number of processes
+	std::string		filter;		///< only benchmarks whose name contains filter are run
+	std::string		outFile;	///< json output (stdout if empty)
+	std::string		baseline;	///< json output of an earlier run to compare with
+	number			tolerance;	///< relative slowdown which is reported as regression
+};
+
+///	timings of one benchmark
+struct Result
+{
+	std::string			name;
+	size_t				problemSize;	///< e.g. number of rows or elements
+	double				bytes;			///< memory traffic of one run (0 if unknown)
+	double				flops;			///< floating point operations of one run (0 if unknown)
+	std::vector<double>	times;			///< wall clock times of all repetitions (max over processes)
+
+	double min_time() const;
+	double mean_time() const;
+	double max_time() const;
+};
+
+///	runs benchmarks and collects their results
+/**	Each kernel is executed once for warm-up and then Options::reps times.
+ * Before each run all processes are synchronized. The time of a run is the
+ * maximum over all processes.*/
+class Context
+{
+	public:
+		Context(const Options& opt);
+
+		const Options& options() const		{return m_opt;}
+
+	///	returns true if the benchmark with the given name shall be run
+		bool enabled(const char* name) const;
+
+	///	number of processes and rank of this process
+		int num_procs() const;
+		int proc_rank() const;
+
+	///	measures run. prep is called before each run and isn't timed.
+		template <class TPrep, class TRun>
+		void measure(const char* name, size_t problemSize, double bytes, double flops,
+					 TPrep prep, TRun run);
+
+	///	measures run without preparation
+		template <class TRun>
+		void measure(const char* name, size_t problemSize, double bytes, double flops,
+					 TRun run)
+		{measure(name, problemSize, bytes, flops, NoPreparation(), run);}
+
+		const std::vector<Result>& results() const	{return m_results;}
+
+	private:
+		struct NoPreparation{void operator()() const {}};
+
+		void synchronize() const;
+		double max_over_procs(double t) const;
+
+		Options				m_opt;
+		std::vector<Result>	m_results;
+};
+
+///	writes all results as json to out
+void WriteResultsJSON(std::ostream& out, const Context& ctx);
+
+///	compares all results to the ones stored in baselineFile
+/**	Results are matched by name, problem size and number of processes.
+ * A benchmark whose minimal time exceeds the baseline by more than
+ * Options::tolerance is reported.
+ * \return	the number of detected regressions*/
+int CompareWithBaseline(const Context& ctx, const std::string& baselineFile);
+
+///	\{
+///	benchmark groups. Each group checks Context::enabled for its benchmarks.
+void RunAlgebraBenchmarks(Context& ctx);
+void RunGridBenchmarks(Context& ctx);
+void RunDiscBenchmarks(Context& ctx);
+///	\}
+
+}//	end of namespace bench
+}//	end of namespace ug
+
+#include "benchmark_impl.h"
+
+#endif
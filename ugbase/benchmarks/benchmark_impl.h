@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__BENCHMARKS__BENCHMARK_IMPL__
+#define __H__UG__BENCHMARKS__BENCHMARK_IMPL__
+
+#include <chrono>
+#include "common/log.h"
+
+namespace ug{
+namespace bench{
+
+template <class TPrep, class TRun>
+void Context::
+measure(const char* name, size_t problemSize, double bytes, double flops,
+		TPrep prep, TRun run)
+{
+	Result res;
+	res.name = name;
+	res.problemSize = problemSize;
+	res.bytes = bytes;
+	res.flops = flops;
+
+	for(size_t i = 0; i <= m_opt.reps; ++i){
+		prep();
+		synchronize();
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		run();
+		double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		t = max_over_procs(t);
+	//	the first run is used for warm-up only
+		if(i > 0)
+			res.times.push_back(t);
+	}
+
+	UG_LOG("  " << name << " (size " << problemSize << "): min "
+		   << res.min_time() << " s, mean " << res.mean_time() << " s\n");
+	m_results.push_back(res);
+}
+
+}//	end of namespace bench
+}//	end of namespace ug
+
+#endif
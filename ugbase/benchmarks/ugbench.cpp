@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "ug.h"
+#include "benchmark.h"
+#include "common/error.h"
+#include "common/log.h"
+
+using namespace std;
+using namespace ug;
+using namespace ug::bench;
+
+static void PrintUsage()
+{
+	UG_LOG("usage: ugbench [options]\n"
+		   "  --dim <d>          dimension of generated domains\n"
+		   "  --size <n>         cells per direction (per process slab if --weak)\n"
+		   "  --reps <n>         timed repetitions per benchmark\n"
+		   "  --weak             grow the problem with the number of processes\n"
+		   "  --filter <str>     only run benchmarks whose name contains str\n"
+		   "  --out <file>       write json results to file instead of stdout\n"
+		   "  --baseline <file>  compare with json results of an earlier run\n"
+		   "  --tolerance <t>    relative slowdown reported as regression\n");
+}
+
+static bool ParseOptions(Options& opt, int argc, char** argv)
+{
+	for(int i = 1; i < argc; ++i){
+		const char* arg = argv[i];
+		const bool hasValue = (i + 1 < argc);
+		if(strcmp(arg, "--weak") == 0)
+			opt.weak = true;
+		else if(strcmp(arg, "--help") == 0)
+			return false;
+		else if(!hasValue){
+			UG_LOG("ugbench: missing value for " << arg << "\n");
+			return false;
+		}
+		else if(strcmp(arg, "--dim") == 0)			opt.dim = atoi(argv[++i]);
+		else if(strcmp(arg, "--size") == 0)			opt.size = strtoul(argv[++i], NULL, 10);
+		else if(strcmp(arg, "--reps") == 0)			opt.reps = strtoul(argv[++i], NULL, 10);
+		else if(strcmp(arg, "--filter") == 0)		opt.filter = argv[++i];
+		else if(strcmp(arg, "--out") == 0)			opt.outFile = argv[++i];
+		else if(strcmp(arg, "--baseline") == 0)		opt.baseline = argv[++i];
+		else if(strcmp(arg, "--tolerance") == 0)	opt.tolerance = atof(argv[++i]);
+		else{
+			UG_LOG("ugbench: unknown option " << arg << "\n");
+			return false;
+		}
+	}
+	return opt.size > 0 && opt.reps > 0;
+}
+
+int main(int argc, char** argv)
+{
+	UGInit(&argc, &argv);
+
+	Options opt;
+	if(!ParseOptions(opt, argc, argv)){
+		PrintUsage();
+		UGFinalize();
+		return 1;
+	}
+
+	int numRegressions = 0;
+	bool errorOccurred = false;
+	try{
+		Context ctx(opt);
+		UG_LOG("ugbench: dim " << opt.dim << ", size " << opt.size
+			   << (opt.weak ? " (weak scaling)" : " (strong scaling)")
+			   << ", " << ctx.num_procs() << " procs, " << opt.reps << " reps\n");
+
+		RunAlgebraBenchmarks(ctx);
+		RunGridBenchmarks(ctx);
+		RunDiscBenchmarks(ctx);
+
+		if(ctx.proc_rank() == 0){
+			if(opt.outFile.empty())
+				WriteResultsJSON(cout, ctx);
+			else{
+				ofstream out(opt.outFile.c_str());
+				UG_COND_THROW(!out, "ugbench: can't open " << opt.outFile);
+				WriteResultsJSON(out, ctx);
+			}
+
+			if(!opt.baseline.empty())
+				numRegressions = CompareWithBaseline(ctx, opt.baseline);
+		}
+	}
+	catch(UGError& err){
+		UG_ERR_LOG("ugbench: " << err.get_msg() << "\n");
+		errorOccurred = true;
+	}
+
+	UGFinalize();
+
+	if(errorOccurred)
+		return 2;
+	return numRegressions > 0 ? 1 : 0;
+}
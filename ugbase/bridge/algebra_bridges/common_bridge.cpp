@@ -50,6 +50,7 @@
 #include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
 #include "lib_algebra/operator/interface/operator_inverse.h"
 #include "lib_algebra/operator/interface/linear_iterator.h"
+#include "lib_algebra/algebra_common/multi_vector.h"
 
 #include "lib_algebra/operator/debug_writer.h"
 
@@ -63,6 +64,7 @@
 #include "matrix_diagonal.h"
 
 #include "lib_algebra/operator/energy_convergence_check.h"
+#include "lib_algebra/common/matrixio/matrix_io_binary.h"
 
 using namespace std;
 
@@ -74,6 +76,33 @@ namespace AlgebraCommon{
 /// \addtogroup algebracommon_bridge
 /// \{
 
+///	writes a matrix to a binary algebra file (\sa WriteMatrixBinary)
+template <typename TMatrix>
+void SaveMatrixBinary(const TMatrix& A, const char* filename)
+{
+	WriteMatrixBinary(filename, A);
+}
+
+///	reads a matrix from a binary algebra file (\sa ReadMatrixBinary)
+template <typename TMatrix>
+void LoadMatrixBinary(TMatrix& A, const char* filename)
+{
+	ReadMatrixBinary(filename, A);
+}
+
+///	writes a vector to a binary algebra file (\sa WriteVectorBinary)
+template <typename TVector>
+void SaveVectorBinary(const TVector& v, const char* filename)
+{
+	WriteVectorBinary(filename, v);
+}
+
+///	reads a vector from a binary algebra file (\sa ReadVectorBinary)
+template <typename TVector>
+void LoadVectorBinary(TVector& v, const char* filename)
+{
+	ReadVectorBinary(filename, v);
+}
 
 
 /**
@@ -172,6 +201,20 @@ static void Algebra(Registry& reg, string grp)
 				&VecLog<vector_type>, grp, "", "dst#vec", "log(vec) (elementwise)");
 	}
 
+//	MultiVector
+	{
+		typedef MultiVector<vector_type> T;
+		string name = string("MultiVector").append(suffix);
+		reg.add_class_<T>(name, grp, "Block of vectors processed together, e.g. for several right-hand sides")
+			.add_constructor()
+			.add_method("push_back", &T::push_back, "", "vector", "adds a column (the vector is shared, not copied)")
+			.add_method("vector", static_cast<SmartPtr<vector_type> (T::*)(size_t)>(&T::vector), "vector", "column", "returns a column")
+			.add_method("num_vectors", &T::num_vectors, "number of columns")
+			.add_method("clear", &T::clear, "", "", "removes all columns")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MultiVector", tag);
+	}
+
 //	VecScaleAddClass
 	{
 		string name = string("VecScaleAddClass").append(suffix);
@@ -201,6 +244,22 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "Matrix", tag);
 	}
 
+//	binary matrix and vector files
+	{
+		reg.add_function("SaveMatrixBinary", &SaveMatrixBinary<matrix_type>, grp,
+				"", "matrix#filename|save-dialog",
+				"Writes the matrix to a binary file, which can be memory mapped on reading. In parallel, all processes write into one file.");
+		reg.add_function("LoadMatrixBinary", &LoadMatrixBinary<matrix_type>, grp,
+				"", "matrix#filename|load-dialog",
+				"Reads a matrix written by SaveMatrixBinary");
+		reg.add_function("SaveVectorBinary", &SaveVectorBinary<vector_type>, grp,
+				"", "vector#filename|save-dialog",
+				"Writes the vector to a binary file, which can be memory mapped on reading. In parallel, all processes write into one file.");
+		reg.add_function("LoadVectorBinary", &LoadVectorBinary<vector_type>, grp,
+				"", "vector#filename|load-dialog",
+				"Reads a vector written by SaveVectorBinary");
+	}
+
 //	ApplyLinearSolver
 	{
 		reg.add_function( "ApplyLinearSolver",
@@ -303,6 +362,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("clone", &T::clone, "SmartPointer to a copy of this object", "", "returns a clone of the object which can be modified independently")
 			.add_method("apply", &T::apply)
 			.add_method("apply_update_defect", &T::apply_update_defect)
+			.add_method("apply_multi", &T::apply_multi, "Success", "c#d",
+					"applies the iterator to all columns of a MultiVector at once. For solvers: solves A*u = f for all columns u, f")
 			.add_method("init", OVERLOADED_METHOD_PTR(bool, T, init, (SmartPtr<ILinearOperator<vector_type,vector_type> > L) ))
 			.add_method("init", OVERLOADED_METHOD_PTR(bool, T, init, (SmartPtr<ILinearOperator<vector_type,vector_type> > L, const vector_type &u) ))
 			.add_method("name", &T::name);
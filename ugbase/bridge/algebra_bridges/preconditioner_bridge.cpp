@@ -152,6 +152,25 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
 
+//	Chebyshev
+	{
+		typedef Chebyshev<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("Chebyshev").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Chebyshev polynomial smoother")
+			.add_constructor()
+			.template add_constructor<void (*)(size_t)>("Degree")
+			.add_method("set_degree", &T::set_degree, "", "degree", "degree of the polynomial (number of matrix-vector products per step)")
+			.add_method("set_eigenvalue_ratio", &T::set_eigenvalue_ratio, "", "ratio", "lambda_max / lambda_min of the damped part of the spectrum")
+			.add_method("set_num_power_iterations", &T::set_num_power_iterations, "", "num", "number of power iterations to estimate lambda_max")
+			.add_method("set_safety_factor", &T::set_safety_factor, "", "factor", "factor applied to the estimated lambda_max")
+			.add_method("set_max_eigenvalue", &T::set_max_eigenvalue, "", "lambda", "prescribes lambda_max of D^{-1}A (<= 0: estimate)")
+			.add_method("set_l1_jacobi", &T::set_l1_jacobi, "", "bL1", "use the L1-Jacobi diagonal")
+			.add_method("max_eigenvalue", &T::max_eigenvalue, "lambda_max", "", "upper bound of the damped spectrum")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Chebyshev", tag);
+	}
+
 //	GaussSeidelBase
 	{
 		typedef GaussSeidelBase<TAlgebra> T;
@@ -243,6 +243,7 @@ static void Algebra(Registry& reg, string grp)
 			.ADD_CONSTRUCTOR( (size_t restar) )("restart")
 			.add_method("add_postprocess_corr", &T::add_postprocess_corr, "adds a postprocess of the corrections", "op")
 			.add_method("remove_postprocess_corr", &T::remove_postprocess_corr, "removes a postprocess of the corrections", "op")
+			.add_method("set_classical_gram_schmidt", &T::set_classical_gram_schmidt, "", "bCGS", "if true, classical Gram-Schmidt with a single fused reduction per iteration is used instead of modified Gram-Schmidt")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GMRES", tag);
 	}
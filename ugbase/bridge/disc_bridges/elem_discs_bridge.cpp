@@ -52,6 +52,7 @@
 #include "lib_disc/spatial_disc/elem_disc/neumann_boundary/fe/neumann_boundary_fe.h"
 #include "lib_disc/spatial_disc/elem_disc/inner_boundary/inner_boundary.h"
 #include "lib_disc/spatial_disc/elem_disc/dirac_source/lagrange_dirac_source.h"
+#include "lib_disc/spatial_disc/elem_disc/diffusion_sum_factorization/diffusion_sum_factorization_fe.h"
 
 using namespace std;
 
@@ -181,6 +182,19 @@ static void Domain(Registry& reg, string grp)
 		reg.add_class_to_group(name, "NeumannBoundaryFE", tag);
 	}
 
+//	Diffusion using sum factorization
+	{
+		typedef DiffusionSumFactorizationFE<TDomain> T;
+		typedef IElemDisc<TDomain> TBase;
+		string name = string("DiffusionSumFactorizationFE").append(suffix);
+		reg.add_class_<T, TBase >(name, elemGrp)
+			.template add_constructor<void (*)(const char*, const char*)>("Function#Subsets")
+			.add_method("set_diffusion", &T::set_diffusion, "", "Diffusion", "Sets the constant diffusion coefficient")
+			.add_method("set_source", &T::set_source, "", "Source", "Sets the constant source")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "DiffusionSumFactorizationFE", tag);
+	}
+
 #if 0
 //	Inner Boundaries
 	{
@@ -45,6 +45,7 @@
 // lib_disc includes
 #include "lib_disc/dof_manager/dof_distribution.h"
 #include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/function_spaces/batch_point_evaluation.h"
 
 // user data
 #include "lib_disc/spatial_disc/user_data/user_data.h"
@@ -80,7 +81,7 @@ class NumberValuedUserDataEvaluator
 	typedef GridFunction<TDomain, TAlgebra> TGridFunction;
 	typedef typename TGridFunction::template dim_traits<dim>::grid_base_object TElem;	
 
-	typedef lg_ntree<dim, dim, TElem>	tree_t;
+	typedef BatchPointLocator<TDomain>	locator_t;
 
 	public:
 
@@ -98,6 +99,39 @@ class NumberValuedUserDataEvaluator
 			return result;
 		}
 
+		/// evaluates the data at a batch of points, given as flat array of coordinates
+		/**
+		 * The points are located concurrently on several threads and evaluated
+		 * in their order along a Morton curve. Points which are not found on
+		 * any process are evaluated as 0. In parallel, this method is collective,
+		 * but each process may pass different points.
+		 */
+		std::vector<number> evaluateBatchLua(const std::vector<number>& vCoords, SmartPtr<TGridFunction> u, number time)
+		{
+			if(!m_initialized)
+				initialize(u);
+
+			std::vector<MathVector<dim> > vPos;
+			FlatCoordinatesToPositions<dim>(vPos, vCoords);
+
+			std::vector<number> vResult;
+			std::vector<char> vFound;
+			auto localEval = [&](std::vector<number>& vRes, std::vector<char>& vFnd,
+								 const std::vector<MathVector<dim> >& vP)
+				{evaluateBatchOnThisProcess(vP, vRes, vFnd, u, time);};
+			EvaluateBatchOnOwningProcs<dim>(vResult, vFound, vPos, 1, m_spLocator->bounding_box(), localEval);
+
+			return vResult;
+		}
+
+		/// sets the number of threads used to locate batches of points
+		void set_num_threads(size_t numThreads)
+		{
+			m_numThreads = numThreads;
+			if(m_initialized)
+				m_spLocator->set_num_threads(numThreads);
+		}
+
 
 		bool evaluate(const std::vector<number>& pos,
 									number& result,
@@ -143,8 +177,6 @@ class NumberValuedUserDataEvaluator
 									SmartPtr<TGridFunction> u,
 									number time)
 		{
-			TElem* elem = NULL;
-
 			MathVector<dim> globalPosition;
 
 			for(int i = 0; i < dim; i++)
@@ -152,7 +184,8 @@ class NumberValuedUserDataEvaluator
 				globalPosition[i] = pos[i];
 			}
 
-			if(!FindContainingElement(elem, *m_tree, globalPosition))
+			TElem* elem = m_spLocator->locate(globalPosition, NULL);
+			if(elem == NULL)
 			{
 				result = 0;
 				return false;
@@ -162,9 +195,6 @@ class NumberValuedUserDataEvaluator
 			std::vector<MathVector<dim> > vCornerCoords;
 			CollectCornerCoordinates(vCornerCoords, *elem, *u->domain());
 
-			//	get subset
-			int si = u->domain()->subset_handler()->get_subset_index(elem);
-
 			//	reference object id
 			const ReferenceObjectID roid = elem->reference_object_id();
 
@@ -175,6 +205,50 @@ class NumberValuedUserDataEvaluator
 			VecSet(locPos, 0.5);
 			map.global_to_local(locPos, globalPosition);
 
+			evaluateInElement(elem, vCornerCoords, globalPosition, locPos, result, u, time);
+
+			return true;
+		}
+
+		void evaluateBatchOnThisProcess(const std::vector<MathVector<dim> >& vPos,
+										std::vector<number>& vResult,
+										std::vector<char>& vFound,
+										SmartPtr<TGridFunction> u,
+										number time)
+		{
+			std::vector<TElem*> vElem;
+			std::vector<MathVector<dim> > vLocPos;
+			std::vector<size_t> vOrder;
+			m_spLocator->locate(vElem, vLocPos, vPos, &vOrder);
+
+			vResult.assign(vPos.size(), 0);
+			vFound.assign(vPos.size(), false);
+
+			// the user data may not be thread-safe (e.g. lua callbacks), so it is
+			// evaluated sequentially, but in the cache friendly order of the curve
+			std::vector<MathVector<dim> > vCornerCoords;
+			for(size_t k = 0; k < vOrder.size(); k++)
+			{
+				const size_t i = vOrder[k];
+				if(vElem[i] == NULL) continue;
+
+				CollectCornerCoordinates(vCornerCoords, *vElem[i], *u->domain());
+				evaluateInElement(vElem[i], vCornerCoords, vPos[i], vLocPos[i], vResult[i], u, time);
+				vFound[i] = true;
+			}
+		}
+
+		void evaluateInElement(TElem* elem,
+							   std::vector<MathVector<dim> >& vCornerCoords,
+							   const MathVector<dim>& globalPosition,
+							   const MathVector<dim>& locPos,
+							   number& result,
+							   SmartPtr<TGridFunction> u,
+							   number time)
+		{
+			//	get subset
+			int si = u->domain()->subset_handler()->get_subset_index(elem);
+
 			// storage for the result
 			number value;
 
@@ -211,21 +285,21 @@ class NumberValuedUserDataEvaluator
 				UG_CATCH_THROW("NumberValuedUserDataEvaluator: Cannot evaluate data.");
 			}
 
-			result = value;			
-
-			return true;
+			result = value;
 		}
 
 		void initialize(SmartPtr<TGridFunction> u)
 		{
 			m_initialized = true;
 
-			m_tree = make_sp(new tree_t(*u->domain()->grid(), u->domain()->position_attachment()));
-			m_tree->create_tree(u->template begin<TElem>(), u->template end<TElem>());
+			m_spLocator = make_sp(new locator_t(u->domain()));
+			m_spLocator->set_elements(u->template begin<TElem>(), u->template end<TElem>());
+			m_spLocator->set_num_threads(m_numThreads);
 		}
 
 		bool m_initialized = false;
-		SmartPtr<tree_t> m_tree;
+		size_t m_numThreads = 1;
+		SmartPtr<locator_t> m_spLocator;
 		SmartPtr<UserData<number, dim> > m_userData;
 
 };
@@ -237,7 +311,7 @@ class VectorValuedUserDataEvaluator
 	typedef GridFunction<TDomain, TAlgebra> TGridFunction;
 	typedef typename TGridFunction::template dim_traits<dim>::grid_base_object TElem;	
 
-	typedef lg_ntree<dim, dim, TElem>	tree_t;
+	typedef BatchPointLocator<TDomain>	locator_t;
 
 	public:
 
@@ -255,6 +329,40 @@ class VectorValuedUserDataEvaluator
 			return result;
 		}
 
+		/// evaluates the data at a batch of points, given as flat array of coordinates
+		/**
+		 * The result contains dim entries for each point. The points are located
+		 * concurrently on several threads and evaluated in their order along a
+		 * Morton curve. Points which are not found on any process are evaluated
+		 * as 0. In parallel, this method is collective, but each process may
+		 * pass different points.
+		 */
+		std::vector<number> evaluateBatchLua(const std::vector<number>& vCoords, SmartPtr<TGridFunction> u, number time)
+		{
+			if(!m_initialized)
+				initialize(u);
+
+			std::vector<MathVector<dim> > vPos;
+			FlatCoordinatesToPositions<dim>(vPos, vCoords);
+
+			std::vector<number> vResult;
+			std::vector<char> vFound;
+			auto localEval = [&](std::vector<number>& vRes, std::vector<char>& vFnd,
+								 const std::vector<MathVector<dim> >& vP)
+				{evaluateBatchOnThisProcess(vP, vRes, vFnd, u, time);};
+			EvaluateBatchOnOwningProcs<dim>(vResult, vFound, vPos, dim, m_spLocator->bounding_box(), localEval);
+
+			return vResult;
+		}
+
+		/// sets the number of threads used to locate batches of points
+		void set_num_threads(size_t numThreads)
+		{
+			m_numThreads = numThreads;
+			if(m_initialized)
+				m_spLocator->set_num_threads(numThreads);
+		}
+
 
 		bool evaluate(const std::vector<number>& pos,
 									std::vector<number>& result,
@@ -327,7 +435,8 @@ class VectorValuedUserDataEvaluator
 				globalPosition[i] = pos[i];
 			}
 
-			if(!FindContainingElement(elem, *m_tree, globalPosition))
+			elem = m_spLocator->locate(globalPosition, NULL);
+			if(elem == NULL)
 			{
 				return false;
 			}
@@ -452,8 +561,6 @@ class VectorValuedUserDataEvaluator
 		{
 			result.resize(TDomain::dim);
 
-			TElem* elem = NULL;
-
 			MathVector<dim> globalPosition;
 
 			for(int i = 0; i < dim; i++)
@@ -461,7 +568,8 @@ class VectorValuedUserDataEvaluator
 				globalPosition[i] = pos[i];
 			}
 
-			if(!FindContainingElement(elem, *m_tree, globalPosition))
+			TElem* elem = m_spLocator->locate(globalPosition, NULL);
+			if(elem == NULL)
 			{
 				return false;
 			}
@@ -470,9 +578,6 @@ class VectorValuedUserDataEvaluator
 			std::vector<MathVector<dim> > vCornerCoords;
 			CollectCornerCoordinates(vCornerCoords, *elem, *u->domain());
 
-			//	get subset
-			int si = u->domain()->subset_handler()->get_subset_index(elem);
-
 			//	reference object id
 			const ReferenceObjectID roid = elem->reference_object_id();
 
@@ -483,8 +588,58 @@ class VectorValuedUserDataEvaluator
 			VecSet(locPos, 0.5);
 			map.global_to_local(locPos, globalPosition);
 
-			// storage for the result
 			MathVector<dim> value;
+			evaluateInElement(elem, vCornerCoords, globalPosition, locPos, value, u, time);
+
+			for(int i = 0; i < dim; i++)
+			{
+				result[i] = value[i];
+			}
+
+			return true;
+		}
+
+		void evaluateBatchOnThisProcess(const std::vector<MathVector<dim> >& vPos,
+										std::vector<number>& vResult,
+										std::vector<char>& vFound,
+										SmartPtr<TGridFunction> u,
+										number time)
+		{
+			std::vector<TElem*> vElem;
+			std::vector<MathVector<dim> > vLocPos;
+			std::vector<size_t> vOrder;
+			m_spLocator->locate(vElem, vLocPos, vPos, &vOrder);
+
+			vResult.assign(dim * vPos.size(), 0);
+			vFound.assign(vPos.size(), false);
+
+			// the user data may not be thread-safe (e.g. lua callbacks), so it is
+			// evaluated sequentially, but in the cache friendly order of the curve
+			std::vector<MathVector<dim> > vCornerCoords;
+			MathVector<dim> value;
+			for(size_t k = 0; k < vOrder.size(); k++)
+			{
+				const size_t i = vOrder[k];
+				if(vElem[i] == NULL) continue;
+
+				CollectCornerCoordinates(vCornerCoords, *vElem[i], *u->domain());
+				evaluateInElement(vElem[i], vCornerCoords, vPos[i], vLocPos[i], value, u, time);
+				for(int d = 0; d < dim; d++)
+					vResult[dim * i + d] = value[d];
+				vFound[i] = true;
+			}
+		}
+
+		void evaluateInElement(TElem* elem,
+							   std::vector<MathVector<dim> >& vCornerCoords,
+							   const MathVector<dim>& globalPosition,
+							   const MathVector<dim>& locPos,
+							   MathVector<dim>& value,
+							   SmartPtr<TGridFunction> u,
+							   number time)
+		{
+			//	get subset
+			int si = u->domain()->subset_handler()->get_subset_index(elem);
 
 			//	get local solution if needed
 			if(m_userData->requires_grid_fct())
@@ -518,25 +673,20 @@ class VectorValuedUserDataEvaluator
 				}
 				UG_CATCH_THROW("VectorValuedUserDataEvaluator: Cannot evaluate data.");
 			}
-
-			for(int i = 0; i < dim; i++)
-			{
-				result[i] = value[i];
-			}
-
-			return true;
 		}
 
 		void initialize(SmartPtr<TGridFunction> u)
 		{
 			m_initialized = true;
 
-			m_tree = make_sp(new tree_t(*u->domain()->grid(), u->domain()->position_attachment()));
-			m_tree->create_tree(u->template begin<TElem>(), u->template end<TElem>());
+			m_spLocator = make_sp(new locator_t(u->domain()));
+			m_spLocator->set_elements(u->template begin<TElem>(), u->template end<TElem>());
+			m_spLocator->set_num_threads(m_numThreads);
 		}
 
 		bool m_initialized = false;
-		SmartPtr<tree_t> m_tree;
+		size_t m_numThreads = 1;
+		SmartPtr<locator_t> m_spLocator;
 		SmartPtr<UserData<MathVector<dim>, dim> > m_userData;
 
 };
@@ -1079,6 +1229,8 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_<T>(name, grp)
 					   	.template add_constructor<void (*)(SmartPtr<UserData<MathVector<TDomain::dim>, TDomain::dim> >) >("")
 					   	.add_method("evaluate", &T::evaluateLua, "point#result#solution#time", "")
+					   	.add_method("evaluate_batch", &T::evaluateBatchLua, "results#points#solution#time", "")
+					   	.add_method("set_num_threads", &T::set_num_threads, "", "numThreads")
 						.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "VectorValuedUserDataEvaluator", tag);
 	}
@@ -1102,9 +1254,24 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_<T>(name, grp)
 					   	.template add_constructor<void (*)(SmartPtr<UserData<number, TDomain::dim> >) >("")
 					   	.add_method("evaluate", &T::evaluateLua, "point#result#solution#time", "")
+					   	.add_method("evaluate_batch", &T::evaluateBatchLua, "results#points#solution#time", "")
+					   	.add_method("set_num_threads", &T::set_num_threads, "", "numThreads")
 						.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "NumberValuedUserDataEvaluator", tag);
 	}
+	{
+		typedef GridFunctionBatchEvaluator<TFct> T;
+		string name = string("GridFunctionBatchEvaluator").append(suffix);
+
+		reg.add_class_<T>(name, grp)
+					   	.template add_constructor<void (*)(SmartPtr<TFct>, const char*)>("GridFunction#Components")
+					   	.add_method("evaluate", static_cast<std::vector<number> (T::*)(const std::vector<number>&)>(&T::evaluate), "values#points", "")
+					   	.add_method("set_num_threads", &T::set_num_threads, "", "numThreads")
+					   	.add_method("set_max_walk_steps", &T::set_max_walk_steps, "", "numSteps")
+					   	.add_method("num_components", &T::num_components)
+						.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "GridFunctionBatchEvaluator", tag);
+	}
 	{
 		typedef PointEvaluatorFactory<TDomain, TAlgebra> T;
 		string name = string("PointEvaluatorFactory").append(suffix);
@@ -602,6 +602,8 @@ static void Common(Registry& reg, string grp)
 		.add_method("init_levels", &T::init_levels)
 		.add_method("init_surfaces", &T::init_surfaces)
 		.add_method("init_top_surface", &T::init_top_surface)
+		.add_method("enable_surface_element_lists", &T::enable_surface_element_lists, "", "enable")
+		.add_method("enable_index_preservation", &T::enable_index_preservation, "", "enable")
 
 		.add_method("clear", &T::clear)
 		.add_method("add_fct", static_cast<void (T::*)(const char*, const char*, int, const char*)>(&T::add),
@@ -235,6 +235,9 @@ static void DomainAlgebra(Registry& reg, string grp)
 		.add_method("set_relax", &T::set_relax, "", "relax")
 		.add_method("select_schur_cmp", &T::select_schur_cmp, "", "")
 		.add_method("set_elim_offdiag", &T::set_elim_offdiag, "", "")
+		.add_method("set_cache_factorization", &T::set_cache_factorization, "", "bCache", "cache LU factorizations of the patch matrices")
+		.add_method("set_variant", &T::set_variant, "", "variant", "multiplicative | colored | additive")
+		.add_method("set_num_threads", &T::set_num_threads, "", "numThreads", "threads for colored and additive variant")
 		.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ElementGaussSeidel", tag);
 	}
@@ -47,6 +47,7 @@
 
 #include "lib_disc/io/vtkoutput.h"
 #include "lib_disc/io/vtk_export_ho.h"
+#include "lib_disc/io/checkpoint.h"
 #include "common/profiler/profiler.h"
 
 #include "../util_overloaded.h"
@@ -144,6 +145,26 @@ static void DomainAlgebra(Registry& reg, string grp)
 	}
 
 
+//	Checkpoint
+	{
+		typedef Checkpoint<TDomain, TAlgebra> T;
+		string name = string("Checkpoint").append(suffix);
+		reg.add_class_<T>(name, grp, "Writes and restores grid functions together with the grid hierarchy, independent of the number of processes.")
+			.add_constructor()
+			.add_method("add", &T::add, "", "gridFunction#name", "adds a grid function which is written with each checkpoint")
+			.add_method("set_number", &T::set_number, "", "name#value", "sets a number which is written with each checkpoint")
+			.add_method("get_number", &T::get_number, "value", "name")
+			.add_method("has_number", &T::has_number, "", "name")
+			.add_method("write", &T::write, "", "filename", "starts writing a checkpoint (collective)")
+			.add_method("wait", &T::wait, "", "", "waits until the last checkpoint was written (collective)")
+			.add_method("read_domain", &T::read_domain, "", "domain#filename", "loads and distributes the stored grid (collective)")
+			.add_method("has_function", &T::has_function, "", "name")
+			.add_method("restore", &T::restore, "", "gridFunction#name", "writes the stored values to the given grid function")
+			.add_method("release", &T::release)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Checkpoint", tag);
+	}
+
 //	GridFunctionDebugWriter
 	{
 		typedef GridFunctionDebugWriter<TDomain, TAlgebra> T;
@@ -457,6 +457,14 @@ static void Domain(Registry& reg, string grp)
 					"", "Domain # Filename # procID | load-dialog | endings=[\"ugx\"]; description=\"*.ugx-Files\" # Number Refinements",
 					"Loads a domain", "No help");
 
+//	SavePartitionedDomain / LoadPartitionedDomain
+	reg.add_function("SavePartitionedDomain", &SavePartitionedDomain<TDomain>, grp,
+					"", "Domain # PartitionMap # Filename|save-dialog| endings=[\"ugb\"]",
+					"Saves each partition of a domain to its own section of a ugb-file", "No help");
+	reg.add_function("LoadPartitionedDomain", &LoadPartitionedDomain<TDomain>, grp,
+					"", "Domain # Filename | load-dialog | endings=[\"ugb\"]; description=\"*.ugb-Files\"",
+					"Loads the local part of a domain from a file written by SavePartitionedDomain", "No help");
+
 //	LoadAndRefineDomain
 	reg.add_function("LoadAndRefineDomain", &LoadAndRefineDomain<TDomain>, grp,
 					"", "Domain # Filename # NumRefines | load-dialog | endings=[\"ugx\"]; description=\"*.ugx-Files\" # Number Refinements",
@@ -562,6 +570,10 @@ static void Common(Registry& reg, string grp)
 			.add_method("refinement_projector", &T::refinement_projector,
 						"projector", "")
 			.add_method("geometry3d", &T::geometry3d, "geometry3d", "")
+			.add_method("reorder_along_space_filling_curve",
+						&T::reorder_along_space_filling_curve, "", "curve")
+			.add_method("set_space_filling_curve_reordering",
+						&T::set_space_filling_curve_reordering, "", "curve")
 			.set_construct_as_smart_pointer(true);
 	}
 
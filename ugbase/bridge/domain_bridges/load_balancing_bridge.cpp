@@ -47,6 +47,7 @@
 	#include "lib_grid/parallelization/load_balancer.h"
 	#include "lib_grid/parallelization/load_balancer_util.h"
 	#include "lib_grid/parallelization/partitioner_dynamic_bisection.h"
+	#include "lib_grid/parallelization/partitioner_space_filling_curve.h"
 	#include "lib_grid/parallelization/balance_weights_ref_marks.h"
 	#include "lib_grid/parallelization/partition_pre_processors/replace_coordinate.h"
 	#include "lib_grid/parallelization/partition_post_processors/smooth_partition_bounds.h"
@@ -197,6 +198,38 @@ static void RegisterDynamicBisectionPartitioner(
 	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
 }
 
+template <class TDomain, class TPartitioner>
+static void RegisterSpaceFillingCurvePartitioner(
+	Registry& reg,
+	string name,
+	string grpName,
+	string clsGrpName)
+{
+	reg.add_class_<TPartitioner, IPartitioner>(name, grpName)
+		.template add_constructor<void (*)(TDomain&)>()
+		.add_method("set_subset_handler",
+			&TPartitioner::set_subset_handler)
+		.add_method("set_curve",
+			&TPartitioner::set_curve, "", "curve")
+		.add_method("set_imbalance_tolerance",
+			&TPartitioner::set_imbalance_tolerance, "", "tolerance")
+		.add_method("imbalance_tolerance",
+			&TPartitioner::imbalance_tolerance)
+		.add_method("num_split_iterations",
+			&TPartitioner::num_split_iterations)
+		.add_method("set_num_split_iterations",
+			&TPartitioner::set_num_split_iterations)
+		.add_method("reset_splits",
+			&TPartitioner::reset_splits)
+		.add_method("expected_migration_volume",
+			&TPartitioner::expected_migration_volume)
+		.add_method("expected_migration_ratio",
+			&TPartitioner::expected_migration_ratio)
+		.set_construct_as_smart_pointer(true);
+
+	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
+}
+
 template <class TDomain, class elem_t>
 static void RegisterSmoothPartitionBounds(
 	Registry& reg,
@@ -308,6 +341,7 @@ static void Common(Registry& reg, string grp) {
 		reg.add_class_<T>("LoadBalancer", grp)
 				//.add_method("add_distribution_level", &T::add_distribution_level)
 				.add_method("enable_vertical_interface_creation", &T::enable_vertical_interface_creation)
+				.add_method("enable_data_compression", &T::enable_data_compression)
 				.add_method("set_next_process_hierarchy", &T::set_next_process_hierarchy)
 				.add_method("rebalance", &T::rebalance)
 				.add_method("set_balance_threshold", &T::set_balance_threshold)
@@ -318,6 +352,11 @@ static void Common(Registry& reg, string grp) {
 				.add_method("print_last_quality_record", &T::print_last_quality_record)
 				.add_method("estimate_distribution_quality", static_cast<number (T::*)()>(&T::estimate_distribution_quality))
 				.add_method("set_balance_weights", &T::set_balance_weights)
+				.add_method("enable_diffusive_balancing", &T::enable_diffusive_balancing, "", "enable")
+				.add_method("diffusive_balancing_enabled", &T::diffusive_balancing_enabled)
+				.add_method("set_max_diffusion_rounds", &T::set_max_diffusion_rounds, "", "numRounds")
+				.add_method("max_diffusion_rounds", &T::max_diffusion_rounds)
+				.add_method("estimated_migration_bytes", &T::estimated_migration_bytes)
 				.add_method("problems_occurred", &T::problems_occurred);
 	}
 
@@ -332,6 +371,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Edge, 1> > >(
+			reg,
+			"EdgePartitioner_SpaceFillingCurve1d",
+			grp,
+			"Partitioner_SpaceFillingCurve");
+
 
 		RegisterSmoothPartitionBounds<TDomain, Edge>(
 			reg,
@@ -358,6 +405,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Edge, 2> > >(
+			reg,
+			"EdgePartitioner_SpaceFillingCurve2d",
+			grp,
+			"ManifoldPartitioner_SpaceFillingCurve");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 2> > >(
@@ -366,6 +421,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Face, 2> > >(
+			reg,
+			"FacePartitioner_SpaceFillingCurve2d",
+			grp,
+			"Partitioner_SpaceFillingCurve");
+
 		RegisterSmoothPartitionBounds<TDomain, Face>(
 			reg,
 			"SmoothPartitionBounds2d",
@@ -391,6 +454,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"HyperManifoldPartitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Edge, 3> > >(
+			reg,
+			"EdgePartitioner_SpaceFillingCurve3d",
+			grp,
+			"HyperManifoldPartitioner_SpaceFillingCurve");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 3> > >(
@@ -399,6 +470,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Face, 3> > >(
+			reg,
+			"FacePartitioner_SpaceFillingCurve3d",
+			grp,
+			"ManifoldPartitioner_SpaceFillingCurve");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Volume, 3> > >(
@@ -407,6 +486,14 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSpaceFillingCurvePartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SpaceFillingCurve<Volume, 3> > >(
+			reg,
+			"VolumePartitioner_SpaceFillingCurve3d",
+			grp,
+			"Partitioner_SpaceFillingCurve");
+
 		RegisterSmoothPartitionBounds<TDomain, Volume>(
 			reg,
 			"SmoothPartitionBounds3d",
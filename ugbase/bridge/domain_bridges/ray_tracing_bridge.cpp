@@ -35,7 +35,7 @@
 #include "bridge/bridge.h"
 #include "bridge/util.h"
 #include "bridge/util_domain_dependent.h"
-#include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+#include "lib_grid/algorithms/space_partitioning/face_bvh.h"
 #include "lib_grid/tools/subset_group.h"
 
 #include <lib_grid/algorithms/projections/overlying_subset_finder.hpp>
@@ -50,33 +50,35 @@ class DomainRayTracer {
 		typedef vector3 vector_t;
 
 		DomainRayTracer(Domain3d& dom) :
-			m_tree(*dom.grid(), dom.position_attachment()),
 			m_small(SMALL),
 			m_dom(&dom)
 		{}
 
 		void set_small(number small)	{m_small = small;}
 
+	///	number of threads used to build the hierarchy and to trace streams of rays
+		void set_num_threads(size_t numThreads)	{m_bvh.set_num_threads(numThreads);}
+
 		void init (const std::vector<int>& subsetIndices)
 		{
 			MultiGrid& mg = *m_dom->grid();
 			MGSubsetHandler& sh = *m_dom->subset_handler();
 
-			std::vector<Triangle*>	tris;
+			std::vector<Face*>	faces;
 			for(size_t is = 0; is < subsetIndices.size(); ++is){
 				int si = subsetIndices[is];
 				for(int lvl = 0; lvl < (int)sh.num_levels(); ++lvl){
-					for(TriangleIterator it = sh.begin<Triangle>(si, lvl);
-						it != sh.end<Triangle>(si, lvl); ++it)
+					for(FaceIterator it = sh.begin<Face>(si, lvl);
+						it != sh.end<Face>(si, lvl); ++it)
 					{
-						Triangle* t = *it;
-						if(!mg.has_children(t))
-							tris.push_back(t);
+						Face* f = *it;
+						if(!mg.has_children(f))
+							faces.push_back(f);
 					}
 				}
 			}
 
-			m_tree.create_tree(tris.begin(), tris.end());
+			m_bvh.create(faces, m_dom->position_accessor());
 		}
 		
 		void init (const char* subsetNames)
@@ -89,7 +91,7 @@ class DomainRayTracer {
 		size_t trace_ray(const vector_t& from, const vector_t& dir)
 		{
 			m_tracePoints.clear();
-			RayElementIntersections(m_intersectionRecords, m_tree, from, dir, m_small);
+			RayElementIntersections(m_intersectionRecords, m_bvh, from, dir, m_small);
 			for_each_in_vec(intersection_record_t& r, m_intersectionRecords){
 				m_tracePoints.push_back(PointOnRay(from, dir, r.smin));
 			}end_for;
@@ -102,6 +104,44 @@ class DomainRayTracer {
 		number trace_point_y(size_t i) const		{return m_tracePoints[i].y();}
 		number trace_point_z(size_t i) const		{return m_tracePoints[i].z();}
 
+	///	traces a stream of rays and returns the local ray coordinate of the first hit of each ray
+	/**	Origins and directions are given as flat arrays with 3 entries per ray.
+	 * Only hits with a non-negative local coordinate are considered. For rays
+	 * which don't hit any face, -1 is returned.*/
+		std::vector<number> first_hits(const std::vector<number>& rayFroms,
+									   const std::vector<number>& rayDirs)
+		{
+			UG_COND_THROW(rayFroms.size() != rayDirs.size() || rayFroms.size() % 3 != 0,
+						  "DomainRayTracer: Expected 3 coordinates per ray origin and direction.");
+
+			std::vector<vector_t> froms(rayFroms.size() / 3), dirs(rayDirs.size() / 3);
+			for(size_t i = 0; i < froms.size(); ++i){
+				froms[i] = vector_t(rayFroms[3*i], rayFroms[3*i+1], rayFroms[3*i+2]);
+				dirs[i] = vector_t(rayDirs[3*i], rayDirs[3*i+1], rayDirs[3*i+2]);
+			}
+
+			std::vector<intersection_record_t> records;
+			std::vector<bool> hits;
+			m_bvh.first_ray_intersections(records, hits, froms, dirs, m_small);
+
+			std::vector<number> s(froms.size(), -1);
+			for(size_t i = 0; i < s.size(); ++i){
+				if(hits[i])
+					s[i] = records[i].smin;
+			}
+			return s;
+		}
+
+	///	returns the point on the traced faces which is closest to the given point
+		const vector_t& closest_point(const vector_t& p)
+		{
+			Face* f;
+			if(!m_bvh.closest_point(m_closestPoint, f, p))
+				UG_THROW("DomainRayTracer: closest_point requires a previous call to init "
+						 "with a non-empty set of faces.");
+			return m_closestPoint;
+		}
+
 		// size_t closest_point_index() const
 		// {
 		// 	if(m_tracePoints.empty())
@@ -127,12 +167,12 @@ class DomainRayTracer {
 		// int trace_point_subset_index(size_t i) const;
 
 	private:
-		typedef lg_ntree<3, 3, Triangle>	tree_t;
-		typedef RayElemIntersectionRecord<Triangle*>	intersection_record_t;
+		typedef FaceBVH::intersection_record_t	intersection_record_t;
 
 		std::vector<vector_t>	m_tracePoints;
 		std::vector<intersection_record_t>	m_intersectionRecords;
-		tree_t					m_tree;
+		FaceBVH					m_bvh;
+		vector_t				m_closestPoint;
 		number					m_small;
 		Domain3d*				m_dom;
 };
@@ -151,6 +191,7 @@ struct Functionality {
 		reg.add_class_<DomainRayTracer>("DomainRayTracer", grp)
 				.add_constructor<void (*)(Domain3d&)> ()
 				.add_method("set_small", &T::set_small, "", "small", "")
+				.add_method("set_num_threads", &T::set_num_threads, "", "numThreads", "")
 				.add_method("init", static_cast<void (T::*) (const std::vector<int>&)>(&T::init), "", "subsetIndices", "")
 				.add_method("init", static_cast<void (T::*) (const char*)>(&T::init), "", "subsetNames", "")
 				.add_method("trace_ray", &T::trace_ray, "", "rayFrom # rayTo", "")
@@ -158,7 +199,9 @@ struct Functionality {
 				.add_method("trace_point", &T::trace_point, "point", "index", "")
 				.add_method("trace_point_x", &T::trace_point_x, "xCoord", "index", "")
 				.add_method("trace_point_y", &T::trace_point_y, "yCoord", "index", "")
-				.add_method("trace_point_z", &T::trace_point_z, "zCoord", "index", "");
+				.add_method("trace_point_z", &T::trace_point_z, "zCoord", "index", "")
+				.add_method("first_hits", &T::first_hits, "localRayCoords", "rayFroms # rayDirs", "")
+				.add_method("closest_point", &T::closest_point, "point", "point", "");
 	}
 
 
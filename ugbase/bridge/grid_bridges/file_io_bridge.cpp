@@ -35,6 +35,7 @@
 #include "lib_grid/multi_grid.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/file_io/file_io_ugx.h"
+#include "lib_grid/file_io/file_io_ugb.h"
 
 using namespace std;
 
@@ -118,6 +119,15 @@ void RegisterGridBridge_FileIO(Registry& reg, string parentGroup)
 //					"", "go#filename")
 		.add_function("SaveGridHierarchy", &SaveGridHierarchy, grp,
 				"", "mg#filename")
+		.add_function("ConvertUGXToUGB", &ConvertUGXToUGB, grp,
+				"success", "ugxFilename#ugbFilename",
+				"Converts a ugx file to the binary ugb format.")
+		.add_function("ConvertUGBToUGX", &ConvertUGBToUGX, grp,
+				"success", "ugbFilename#ugxFilename",
+				"Converts a binary ugb file to the ugx format.")
+		.add_function("SetUGXReaderNumThreads", &GridReaderUGXStream::set_default_num_threads, grp,
+				"", "numThreads",
+				"Sets the number of threads which are used to parse numbers when ugx files are loaded.")
 		.add_function("SaveGridHierarchyTransformed",
 					  static_cast<bool (*)(MultiGrid&, ISubsetHandler&, const char*, number)>(
 							  &SaveGridHierarchyTransformed),
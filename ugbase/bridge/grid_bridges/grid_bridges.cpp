@@ -52,6 +52,7 @@ void RegisterBridge_Grid(Registry& reg, string parentGroup)
 		RegisterGridBridge_Layers(reg, parentGroup);
 		RegisterGridBridge_Debug(reg, parentGroup);
 		RegisterGridBridge_Misc(reg, parentGroup);
+		RegisterGridBridge_Smoothing(reg, parentGroup);
 	}
 	UG_REGISTRY_CATCH_THROW(parentGroup);
 }
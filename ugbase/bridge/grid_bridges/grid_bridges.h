@@ -48,6 +48,7 @@ void RegisterGridBridge_FileIO(Registry& reg, std::string parentGroup);
 void RegisterGridBridge_Layers(Registry& reg, std::string parentGroup);
 void RegisterGridBridge_Debug(Registry& reg, std::string parentGroup);
 void RegisterGridBridge_Misc(Registry& reg, std::string parentGroup);
+void RegisterGridBridge_Smoothing(Registry& reg, std::string parentGroup);
 
 }//	end of namespace	
 }//	end of namespace
@@ -33,6 +33,7 @@
 #include "grid_bridges.h"
 #include "common/space_partitioning/ntree_traverser.h"
 #include "lib_grid/algorithms/debug_util.h"
+#include "lib_grid/algorithms/remeshing/resolve_intersections.h"
 #include "lib_grid/refinement/hanging_node_refiner_grid.h"
 #include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
 #include "lib_grid/file_io/file_io.h"
@@ -95,6 +96,14 @@ bool TestNTree(const char* filename)
 	return true;
 }
 
+bool ResolveTriangleIntersections(Grid& grid, number snapThreshold, size_t numThreads)
+{
+	UG_COND_THROW(!grid.has_vertex_attachment(aPosition),
+				  "ResolveTriangleIntersections: aPosition is not attached to the grid.");
+	return ResolveTriangleIntersections(grid, grid.begin<Triangle>(), grid.end<Triangle>(),
+										snapThreshold, aPosition, numThreads);
+}
+
 void RegisterGridBridge_Misc(Registry& reg, string parentGroup)
 {
 	string grp = parentGroup;
@@ -103,6 +112,12 @@ void RegisterGridBridge_Misc(Registry& reg, string parentGroup)
 		.add_function("PrintAttachmentInfo", &PrintAttachmentInfo, grp);
 	
 	reg.add_function("TestNTree", &TestNTree, grp);
+
+	reg.add_function("ResolveTriangleIntersections",
+			static_cast<bool (*)(Grid&, number, size_t)>(&ResolveTriangleIntersections),
+			grp, "Success", "grid#snapThreshold#numThreads",
+			"Resolves intersections between all triangles of the grid. The "
+			"narrow phase of the intersection tests runs on numThreads threads.");
 	
 	reg.add_function("CreateGridGlobalDebugInfoProvider", static_cast<void (*) (Grid&,ISubsetHandler&)>(&grid_global_debug_info_provider::create), grp);
 }
@@ -264,6 +264,8 @@ void RegisterGridBridge_Refinement(Registry& reg, string parentGroup)
 		.add_constructor()
 		.add_method("assign_grid", static_cast<void (GlobalMultiGridRefiner::*)(MultiGrid&)>(&GlobalMultiGridRefiner::assign_grid),
 				"", "mg")
+		.add_method("set_num_threads", &GlobalMultiGridRefiner::set_num_threads, "", "numThreads")
+		.add_method("num_threads", &GlobalMultiGridRefiner::num_threads, "numThreads")
 		.set_construct_as_smart_pointer(true);
 
 	{
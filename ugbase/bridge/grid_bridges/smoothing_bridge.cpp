@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "grid_bridges.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+#include "lib_grid/algorithms/smoothing/manifold_smoothing.h"
+#include "lib_grid/algorithms/smoothing/jacobi_smoothing.h"
+#include "lib_grid/callbacks/selection_callbacks.h"
+#include "lib_grid/tools/selector_grid.h"
+
+using namespace std;
+
+namespace ug{
+namespace bridge{
+
+static Grid::VertexAttachmentAccessor<APosition>
+PositionAccessor(Grid& g, const char* callerName)
+{
+	UG_COND_THROW(!g.has_vertex_attachment(aPosition),
+				  callerName << ": aPosition is not attached to the grid.");
+	return Grid::VertexAttachmentAccessor<APosition>(g, aPosition);
+}
+
+
+static void LaplacianSmoothSelected(Selector& sel, number alpha, int numIterations)
+{
+	Grid& g = *sel.grid();
+	Grid::VertexAttachmentAccessor<APosition> aaPos = PositionAccessor(g, "LaplacianSmooth");
+	LaplacianSmooth(g, sel.begin<Vertex>(), sel.end<Vertex>(), aaPos,
+					alpha, numIterations);
+}
+
+static void LaplacianSmoothJacobiSelected(Selector& sel, number alpha,
+										  int numIterations, size_t numThreads)
+{
+	Grid& g = *sel.grid();
+	Grid::VertexAttachmentAccessor<APosition> aaPos = PositionAccessor(g, "LaplacianSmoothJacobi");
+	LaplacianSmoothJacobi(g, sel.begin<Vertex>(), sel.end<Vertex>(), aaPos,
+						  alpha, numIterations, numThreads);
+}
+
+static void TangentialSmoothSimpleSelected(Selector& sel, number alpha, int numIterations)
+{
+	Grid& g = *sel.grid();
+	Grid::VertexAttachmentAccessor<APosition> aaPos = PositionAccessor(g, "TangentialSmoothSimple");
+	TangentialSmoothSimple(g, sel.begin<Vertex>(), sel.end<Vertex>(), aaPos,
+						   alpha, (size_t)numIterations);
+}
+
+static void TangentialSmoothSimpleJacobiSelected(Selector& sel, number alpha,
+												 int numIterations, size_t numThreads)
+{
+	Grid& g = *sel.grid();
+	Grid::VertexAttachmentAccessor<APosition> aaPos = PositionAccessor(g, "TangentialSmoothSimpleJacobi");
+	TangentialSmoothSimpleJacobi(g, sel.begin<Vertex>(), sel.end<Vertex>(), aaPos,
+								 alpha, (size_t)numIterations, numThreads);
+}
+
+static void WeightedEdgeSmoothSelected(Selector& sel, number alpha, int numIterations)
+{
+	Grid& g = *sel.grid();
+	Grid::VertexAttachmentAccessor<APosition> aaPos = PositionAccessor(g, "WeightedEdgeSmooth");
+	WeightedEdgeSmooth(g, sel.begin<Vertex>(), sel.end<Vertex>(), aaPos,
+					   alpha, numIterations, IsSelected(sel));
+}
+
+static void WeightedEdgeSmoothJacobiSelected(Selector& sel, number alpha,
+											 int numIterations, size_t numThreads)
+{
+	Grid& g = *sel.grid();
+	Grid::VertexAttachmentAccessor<APosition> aaPos = PositionAccessor(g, "WeightedEdgeSmoothJacobi");
+	WeightedEdgeSmoothJacobi(g, sel.begin<Vertex>(), sel.end<Vertex>(), aaPos,
+							 alpha, numIterations, IsSelected(sel), numThreads);
+}
+
+void RegisterGridBridge_Smoothing(Registry& reg, string parentGroup)
+{
+	string grp = parentGroup;
+
+//	the serial smoothers move each vertex right after its neighborhood was
+//	evaluated (Gauss-Seidel like). The Jacobi variants only use the positions
+//	of the previous iteration and may thus run on several threads.
+	reg.add_function("LaplacianSmooth", &LaplacianSmoothSelected, grp, "",
+			"selector#alpha#numIterations",
+			"Moves the selected vertices towards the center of their neighborhood.")
+		.add_function("LaplacianSmoothJacobi", &LaplacianSmoothJacobiSelected, grp, "",
+			"selector#alpha#numIterations#numThreads",
+			"Jacobi variant of LaplacianSmooth, running on numThreads threads.")
+		.add_function("TangentialSmoothSimple", &TangentialSmoothSimpleSelected, grp, "",
+			"selector#alpha#numIterations",
+			"Moves the selected vertices of a surface grid in their tangential plane.")
+		.add_function("TangentialSmoothSimpleJacobi", &TangentialSmoothSimpleJacobiSelected, grp, "",
+			"selector#alpha#numIterations#numThreads",
+			"Jacobi variant of TangentialSmoothSimple, running on numThreads threads.")
+		.add_function("WeightedEdgeSmooth", &WeightedEdgeSmoothSelected, grp, "",
+			"selector#alpha#numIterations",
+			"Moves the selected vertices along their edges, weighted by the squared edge lengths.")
+		.add_function("WeightedEdgeSmoothJacobi", &WeightedEdgeSmoothJacobiSelected, grp, "",
+			"selector#alpha#numIterations#numThreads",
+			"Jacobi variant of WeightedEdgeSmooth, running on numThreads threads.");
+}
+
+}//	end of namespace
+}//	end of namespace
@@ -34,6 +34,7 @@
 #include "bridge/bridge.h"
 #include "common/profiler/profiler.h"
 #include "common/profiler/profile_node.h"
+#include "common/profiler/hardware_counters.h"
 #include "ug.h" // Required for UGOutputProfileStatsOnExit.
 #include <string>
 #include <sstream>
@@ -142,6 +143,16 @@ void RegisterBridge_Profiler(Registry &reg, string parentGroup)
 				"time in milliseconds spend in this node including subnodes", "")
 		.add_method("is_valid", &UGProfileNode::valid, "true if node has been found", "")
 
+		// hardware counters
+		.add_method("get_self_hw_counter", &UGProfileNode::get_self_hw_counter,
+				"count of the hardware counter in this node excluding subnodes", "name|selection|value=[\"cycles\",\"instructions\",\"llc_references\",\"llc_misses\"]")
+		.add_method("get_total_hw_counter", &UGProfileNode::get_total_hw_counter,
+				"count of the hardware counter in this node including subnodes", "name|selection|value=[\"cycles\",\"instructions\",\"llc_references\",\"llc_misses\"]")
+		.add_method("get_ipc", &UGProfileNode::get_ipc,
+				"instructions per cycle in this node including subnodes", "")
+		.add_method("get_bandwidth_gbs", &UGProfileNode::get_bandwidth_gbs,
+				"memory bandwidth in GB/s in this node including subnodes, estimated by last level cache misses", "")
+
 	  		.add_method("groups", &UGProfileNode::groups, "", "")
 
 		;
@@ -169,6 +180,12 @@ void RegisterBridge_Profiler(Registry &reg, string parentGroup)
 					OVERLOADED_FUNCTION_PTR(void, WriteProfileDataXML, (const char*, int)),
 					 grp,
 	                 "", "filename|save-dialog|endings=[\"pdxml\"]", "writes a XML-file with profile data viewable with the ShinyProfileViewer. Pick a filename ending with .pdxml");
+	reg.add_function("WriteProfileTrace", &WriteProfileTraceJSON, grp,
+	                 "", "filename|save-dialog|endings=[\"json\"]", "writes the recorded trace events of all procs and threads in the Chrome trace-event format, viewable with chrome://tracing or Perfetto. Has to be called on all procs.");
+	reg.add_function("EnableProfileTrace", &EnableProfileTrace, grp,
+	                 "", "bEnable", "enables recording of trace events for WriteProfileTrace");
+	reg.add_function("SetProfileTraceMaxEvents", &SetProfileTraceMaxEvents, grp,
+	                 "", "maxEventsPerThread", "maximal number of trace events recorded per thread");
 	reg.add_function("WriteCallLog",
 						OVERLOADED_FUNCTION_PTR(void, WriteCallLog, (const char*)),
 						 grp,
@@ -180,6 +197,13 @@ void RegisterBridge_Profiler(Registry &reg, string parentGroup)
 
 	reg.add_function("UpdateProfiler", &UpdateProfiler_BridgeImpl, grp);
 
+	reg.add_function("EnableHardwareCounters", &EnableHardwareCounters, grp,
+	                 "previous state", "bEnable", "enables recording of hardware counters (cycles, instructions, last level cache references and misses) for profile nodes of the main thread. Requires linux perf events.");
+	reg.add_function("HasHardwareCounters", &HasHardwareCounters, grp,
+	                 "true if hardware counters were opened successfully");
+	reg.add_function("SetHardwareCountersMaxDepth", &SetHardwareCountersMaxDepth, grp,
+	                 "", "depth", "counters are only read at transitions of zones up to this depth (default 1: top level zones). Deeper zones are counted in their enclosing zone.");
+
 	reg.add_function("SetShinyCallLoggingMaxFrequency", &SetShinyCallLoggingMaxFrequency, grp, "", "maxFreq");
 
 	reg.add_function("SetFrequency", &SetFrequency, grp, "", "CSV-File");
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstring>
+#include <vector>
+#include "common/log.h"
+#include "hardware_counters.h"
+
+#ifdef UG_PROFILER_SHINY
+#include "profiler.h"
+#endif
+
+#if defined(UG_PROFILER_SHINY) && defined(__linux__)
+	#define UG_HARDWARE_COUNTERS_PERF_EVENT
+	#include <cerrno>
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace ug{
+
+static const char* s_hardwareCounterNames[NUM_HARDWARE_COUNTERS] =
+	{"cycles", "instructions", "llc_references", "llc_misses"};
+
+const char* HardwareCounterName(int counter)
+{
+	if(counter < 0 || counter >= NUM_HARDWARE_COUNTERS)
+		return "";
+	return s_hardwareCounterNames[counter];
+}
+
+int HardwareCounterFromName(const std::string& name)
+{
+	for(int i = 0; i < NUM_HARDWARE_COUNTERS; ++i){
+		if(name == s_hardwareCounterNames[i])
+			return i;
+	}
+	return -1;
+}
+
+size_t HardwareCounterCacheLineSize()
+{
+	size_t lineSize = 64;
+#if defined(UG_HARDWARE_COUNTERS_PERF_EVENT) && defined(_SC_LEVEL3_CACHE_LINESIZE)
+	long l = sysconf(_SC_LEVEL3_CACHE_LINESIZE);
+	if(l > 0)
+		lineSize = (size_t)l;
+#endif
+	return lineSize;
+}
+
+
+static size_t s_hardwareCountersMaxDepth = 1;
+
+size_t GetHardwareCountersMaxDepth()
+{
+	return s_hardwareCountersMaxDepth;
+}
+
+
+#ifdef UG_HARDWARE_COUNTERS_PERF_EVENT
+////////////////////////////////////////////////////////////////////////////////
+//	perf_event_open based implementation
+
+bool g_HardwareCountersEnabled = false;
+uint32 g_HardwareCountersMaxDepth = 1;
+
+namespace{
+
+struct HardwareCounterValues
+{
+	HardwareCounterValues() : timeNs(0)	{memset(v, 0, sizeof(v));}
+	uint64 v[NUM_HARDWARE_COUNTERS];
+	uint64 timeNs;
+};
+
+///	counts of the nodes, indexed by ProfileNode::hwCounterSlot - 1
+vector<HardwareCounterValues>	selfCounters;
+vector<HardwareCounterValues>	totalCounters;
+HardwareCounterValues			lastValues;
+
+bool	countersOpened = false;
+int		counterFds[NUM_HARDWARE_COUNTERS];
+///	position of each counter in the data read from the group (or -1)
+int		counterGroupPos[NUM_HARDWARE_COUNTERS];
+
+
+long PerfEventOpen(perf_event_attr* attr, int groupFd)
+{
+//	measure the calling thread on any cpu
+	return syscall(__NR_perf_event_open, attr, 0, -1, groupFd, 0);
+}
+
+///	opens all counters as one group, led by the cycle counter
+bool OpenHardwareCounters()
+{
+	static const uint64 configs[NUM_HARDWARE_COUNTERS] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_REFERENCES,
+		PERF_COUNT_HW_CACHE_MISSES
+	};
+
+	int numOpened = 0;
+	for(int i = 0; i < NUM_HARDWARE_COUNTERS; ++i){
+		counterFds[i] = -1;
+		counterGroupPos[i] = -1;
+
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = configs[i];
+		attr.disabled = (i == HWC_CYCLES) ? 1 : 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED;
+
+		int fd = (int)PerfEventOpen(&attr, (i == HWC_CYCLES) ? -1 : counterFds[HWC_CYCLES]);
+		if(fd < 0){
+			if(i == HWC_CYCLES){
+				UG_LOG("WARNING in EnableHardwareCounters: perf_event_open failed ("
+					   << strerror(errno) << "). Check the value of "
+					   "/proc/sys/kernel/perf_event_paranoid.\n");
+				return false;
+			}
+			UG_LOG("WARNING in EnableHardwareCounters: counter '"
+				   << HardwareCounterName(i) << "' is not available.\n");
+			continue;
+		}
+		counterFds[i] = fd;
+		counterGroupPos[i] = numOpened++;
+	}
+
+	ioctl(counterFds[HWC_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(counterFds[HWC_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	return true;
+}
+
+bool ReadHardwareCounters(HardwareCounterValues& valsOut)
+{
+//	layout of PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED:
+//	number of values, enabled time in ns, followed by the values
+	uint64 buf[2 + NUM_HARDWARE_COUNTERS];
+	ssize_t numRead = read(counterFds[HWC_CYCLES], buf, sizeof(buf));
+	if(numRead < 2 * (ssize_t)sizeof(uint64))
+		return false;
+
+	valsOut.timeNs = buf[1];
+	for(int i = 0; i < NUM_HARDWARE_COUNTERS; ++i){
+		if(counterGroupPos[i] >= 0 && (uint64)counterGroupPos[i] < buf[0])
+			valsOut.v[i] = buf[2 + counterGroupPos[i]];
+		else
+			valsOut.v[i] = 0;
+	}
+	return true;
+}
+
+///	returns the counts of the node, a record is created on first access
+HardwareCounterValues& SelfCounters(Shiny::ProfileNode* node)
+{
+	if(node->hwCounterSlot == 0){
+		selfCounters.push_back(HardwareCounterValues());
+		node->hwCounterSlot = (uint32)selfCounters.size();
+	}
+	return selfCounters[node->hwCounterSlot - 1];
+}
+
+///	returns the node of the counter depth to which counts in the given node are attributed
+Shiny::ProfileNode* CounterNode(Shiny::ProfileNode* node)
+{
+	while(node->entryLevel > g_HardwareCountersMaxDepth && node->parent)
+		node = node->parent;
+	return node;
+}
+
+void CalcTotalHardwareCounters(Shiny::ProfileNode* p)
+{
+	HardwareCounterValues total = SelfCounters(p);
+
+	for(Shiny::ProfileNode* c = p->firstChild; c != NULL; c = c->nextSibling)
+	{
+		CalcTotalHardwareCounters(c);
+		const HardwareCounterValues& childTotal = totalCounters[c->hwCounterSlot - 1];
+		for(int i = 0; i < NUM_HARDWARE_COUNTERS; ++i)
+			total.v[i] += childTotal.v[i];
+		total.timeNs += childTotal.timeNs;
+		if(c == p->lastChild)
+			break;
+	}
+
+	if(totalCounters.size() < selfCounters.size())
+		totalCounters.resize(selfCounters.size());
+	totalCounters[p->hwCounterSlot - 1] = total;
+}
+
+const HardwareCounterValues* GetHardwareCounters(const vector<HardwareCounterValues>& vCounters,
+												 const Shiny::ProfileNode* p)
+{
+	if(p->hwCounterSlot == 0 || p->hwCounterSlot > vCounters.size())
+		return NULL;
+	return &vCounters[p->hwCounterSlot - 1];
+}
+
+uint64 GetHardwareCounter(const vector<HardwareCounterValues>& vCounters,
+						  const Shiny::ProfileNode* p, int counter)
+{
+	if(counter < 0 || counter >= NUM_HARDWARE_COUNTERS)
+		return 0;
+	const HardwareCounterValues* vals = GetHardwareCounters(vCounters, p);
+	if(!vals)
+		return 0;
+	return vals->v[counter];
+}
+
+}//	end of anonymous namespace
+
+
+bool EnableHardwareCounters(bool b)
+{
+	bool prev = g_HardwareCountersEnabled;
+	if(b == prev)
+		return prev;
+
+	if(b){
+		if(!countersOpened){
+			if(!OpenHardwareCounters())
+				return prev;
+			countersOpened = true;
+		}
+	//	counts between disabling and enabling are not attributed to any node
+		ReadHardwareCounters(lastValues);
+	}
+	else
+		AppendHardwareCountersToNode(CounterNode(Shiny::ProfileManager::instance._curNode));
+
+	g_HardwareCountersEnabled = b;
+	return prev;
+}
+
+bool IsHardwareCountersEnabled()
+{
+	return g_HardwareCountersEnabled;
+}
+
+bool HasHardwareCounters()
+{
+	return countersOpened;
+}
+
+bool HasHardwareCounter(int counter)
+{
+	if(!countersOpened || counter < 0 || counter >= NUM_HARDWARE_COUNTERS)
+		return false;
+	return counterFds[counter] >= 0;
+}
+
+void SetHardwareCountersMaxDepth(size_t depth)
+{
+	if(depth < 1)
+		depth = 1;
+//	counts of the current zone belong to the node of the old depth
+	if(g_HardwareCountersEnabled)
+		AppendHardwareCountersToNode(CounterNode(Shiny::ProfileManager::instance._curNode));
+	s_hardwareCountersMaxDepth = depth;
+	g_HardwareCountersMaxDepth = (uint32)depth;
+}
+
+void AppendHardwareCountersToNode(Shiny::ProfileNode* node)
+{
+	HardwareCounterValues curValues;
+	if(!ReadHardwareCounters(curValues))
+		return;
+
+	HardwareCounterValues& self = SelfCounters(node);
+	for(int i = 0; i < NUM_HARDWARE_COUNTERS; ++i)
+		self.v[i] += curValues.v[i] - lastValues.v[i];
+	self.timeNs += curValues.timeNs - lastValues.timeNs;
+	lastValues = curValues;
+}
+
+void UpdateTotalHardwareCounters()
+{
+	if(!countersOpened)
+		return;
+	if(g_HardwareCountersEnabled)
+		AppendHardwareCountersToNode(CounterNode(Shiny::ProfileManager::instance._curNode));
+
+	CalcTotalHardwareCounters(&Shiny::ProfileManager::instance.rootNode);
+}
+
+uint64 GetSelfHardwareCounter(const Shiny::ProfileNode* p, int counter)
+{
+	return GetHardwareCounter(selfCounters, p, counter);
+}
+
+uint64 GetTotalHardwareCounter(const Shiny::ProfileNode* p, int counter)
+{
+	return GetHardwareCounter(totalCounters, p, counter);
+}
+
+double GetTotalHardwareCounterSeconds(const Shiny::ProfileNode* p)
+{
+	const HardwareCounterValues* vals = GetHardwareCounters(totalCounters, p);
+	if(!vals)
+		return 0.0;
+	return (double)vals->timeNs * 1e-9;
+}
+
+#else
+////////////////////////////////////////////////////////////////////////////////
+//	hardware counters not available
+
+bool EnableHardwareCounters(bool b)
+{
+	if(b){
+		UG_LOG("WARNING in EnableHardwareCounters: Hardware counters are only "
+			   "available with the shiny profiler on linux.\n");
+	}
+	return false;
+}
+
+bool IsHardwareCountersEnabled()		{return false;}
+bool HasHardwareCounters()				{return false;}
+bool HasHardwareCounter(int counter)	{return false;}
+
+void SetHardwareCountersMaxDepth(size_t depth)
+{
+	s_hardwareCountersMaxDepth = (depth < 1) ? 1 : depth;
+}
+
+#ifdef UG_PROFILER_SHINY
+bool g_HardwareCountersEnabled = false;
+uint32 g_HardwareCountersMaxDepth = 1;
+
+void AppendHardwareCountersToNode(Shiny::ProfileNode* node)		{}
+void UpdateTotalHardwareCounters()								{}
+
+uint64 GetSelfHardwareCounter(const Shiny::ProfileNode* p, int counter)
+{
+	return 0;
+}
+
+uint64 GetTotalHardwareCounter(const Shiny::ProfileNode* p, int counter)
+{
+	return 0;
+}
+
+double GetTotalHardwareCounterSeconds(const Shiny::ProfileNode* p)
+{
+	return 0.0;
+}
+#endif
+
+#endif
+
+}//	end of namespace
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+/*
+ * Hardware performance counters for profile nodes.
+ *
+ * On Linux the counters are read through perf_event_open. They are only
+ * recorded while enabled with EnableHardwareCounters(true) and only for
+ * zones entered by the main thread. The counts of each zone are attributed
+ * like the self time of shiny: the counts between two zone transitions are
+ * added to the current node.
+ *
+ * Reading the counters requires a system call. To not distort small zones,
+ * the counters are only read when a zone up to the counter depth is entered
+ * or left (see SetHardwareCountersMaxDepth). By default these are the top
+ * level zones only. The counts of deeper zones are attributed to their
+ * enclosing zone of the counter depth.
+ *
+ * Whether the counters are accessible depends on
+ * /proc/sys/kernel/perf_event_paranoid (has to be <= 2 for user space counts).
+ */
+
+#ifndef __H__UG__COMMON__PROFILER__HARDWARE_COUNTERS__
+#define __H__UG__COMMON__PROFILER__HARDWARE_COUNTERS__
+
+#include <string>
+#include "common/types.h"
+#ifdef UG_PROFILER_SHINY
+#include "src/ShinyNode.h"
+#endif
+
+namespace ug{
+
+///	the recorded hardware events
+enum HardwareCounter
+{
+	HWC_CYCLES = 0,
+	HWC_INSTRUCTIONS,
+	HWC_LLC_REFERENCES,
+	HWC_LLC_MISSES,
+	NUM_HARDWARE_COUNTERS
+};
+
+///	returns the name of the counter as used in the bridge (e.g. "llc_misses")
+const char* HardwareCounterName(int counter);
+
+///	returns the counter with the given name or -1, if no such counter exists
+int HardwareCounterFromName(const std::string& name);
+
+/**
+ * With EnableHardwareCounters(true) the counters are opened and started,
+ * with EnableHardwareCounters(false) recording stops.
+ * @return previous state.
+ */
+bool EnableHardwareCounters(bool b);
+
+///	returns true if hardware counters are currently recorded
+bool IsHardwareCountersEnabled();
+
+///	returns true if hardware counters are supported by this build and system
+bool HasHardwareCounters();
+
+///	returns true if the given counter could be opened on this system
+bool HasHardwareCounter(int counter);
+
+///	assumed number of bytes transferred by each last level cache miss
+size_t HardwareCounterCacheLineSize();
+
+///	sets the depth of the zones at whose transitions the counters are read (default 1)
+/**	A depth of 1 reads the counters only when top level zones are entered or
+ * left. Larger depths give counts for nested zones, too, at the cost of a
+ * system call for each of their transitions.*/
+void SetHardwareCountersMaxDepth(size_t depth);
+
+///	returns the depth of the zones at whose transitions the counters are read
+size_t GetHardwareCountersMaxDepth();
+
+#ifdef UG_PROFILER_SHINY
+extern bool g_HardwareCountersEnabled;
+extern uint32 g_HardwareCountersMaxDepth;
+
+///	adds the counts since the last call to the given node
+void AppendHardwareCountersToNode(Shiny::ProfileNode* node);
+
+///	reads the counters if a zone up to the counter depth is entered
+inline void HardwareCountersEnterZone(Shiny::ProfileNode* curNode)
+{
+	if(g_HardwareCountersEnabled && curNode->entryLevel < g_HardwareCountersMaxDepth)
+		AppendHardwareCountersToNode(curNode);
+}
+
+///	reads the counters if a zone up to the counter depth is left
+inline void HardwareCountersLeaveZone(Shiny::ProfileNode* curNode)
+{
+	if(g_HardwareCountersEnabled && curNode->entryLevel <= g_HardwareCountersMaxDepth)
+		AppendHardwareCountersToNode(curNode);
+}
+
+///	calculates the total counts of each node from its self counts
+void UpdateTotalHardwareCounters();
+
+uint64 GetSelfHardwareCounter(const Shiny::ProfileNode* p, int counter);
+uint64 GetTotalHardwareCounter(const Shiny::ProfileNode* p, int counter);
+
+///	returns the accumulated time in seconds during which counts were added to the node or its subnodes
+double GetTotalHardwareCounterSeconds(const Shiny::ProfileNode* p);
+#endif
+
+}//	end of namespace
+
+#endif
@@ -48,6 +48,7 @@
 #include "pcl/pcl_base.h"
 #include "common/error.h"
 #include "memtracker.h"
+#include "hardware_counters.h"
 
 #ifdef UG_PARALLEL
 #include "pcl/pcl.h"
@@ -65,8 +66,9 @@ namespace ug
 
 void ProfilerUpdate()
 {
-	Shiny::ProfileManager::instance.update(1.0);
+	UpdateProfiler(1.0);
 	UpdateTotalMem();
+	UpdateTotalHardwareCounters();
 }
 
 
@@ -144,6 +146,51 @@ string UGProfileNode::get_mem_info(double fullMem) const
 		return "";
 }
 
+double UGProfileNode::get_self_hw_counter(const std::string& name) const
+{
+	if(!valid()) return 0.0;
+	return (double)GetSelfHardwareCounter(this, HardwareCounterFromName(name));
+}
+
+double UGProfileNode::get_total_hw_counter(const std::string& name) const
+{
+	if(!valid()) return 0.0;
+	return (double)GetTotalHardwareCounter(this, HardwareCounterFromName(name));
+}
+
+double UGProfileNode::get_ipc() const
+{
+	if(!valid()) return 0.0;
+	double cycles = (double)GetTotalHardwareCounter(this, HWC_CYCLES);
+	if(cycles == 0.0) return 0.0;
+	return (double)GetTotalHardwareCounter(this, HWC_INSTRUCTIONS) / cycles;
+}
+
+double UGProfileNode::get_bandwidth_gbs() const
+{
+	if(!valid()) return 0.0;
+//	the counters are cumulative, so they are related to the time during which
+//	they were recorded and not to the (damped) profiler time
+	double seconds = GetTotalHardwareCounterSeconds(this);
+	if(seconds == 0.0) return 0.0;
+	double bytes = (double)GetTotalHardwareCounter(this, HWC_LLC_MISSES)
+					* HardwareCounterCacheLineSize();
+	return bytes / seconds * 1e-9;
+}
+
+string UGProfileNode::get_hw_counter_info() const
+{
+	if(HasHardwareCounters())
+	{
+		stringstream s;
+		s << right << fixed << setprecision(2) << setw(6) << get_ipc() << " "
+		  << setw(9) << get_bandwidth_gbs() << "  ";
+		return s.str();
+	}
+	else
+		return "";
+}
+
 string UGProfileNode::call_tree(double dSkipMarginal) const
 {
 	if(!valid()) return "Profile Node not valid!";
@@ -322,6 +369,7 @@ string UGProfileNode::print_node(double fullMs, double fullMem, size_t offset) c
 			right << setw(PROFILER_BRIDGE_OUTPUT_WIDTH_PERC) << floor(get_avg_total_time_ms() / fullMs * 100) << "%  ";
 	if(fullMem >= 0.0)
 		s << get_mem_info(fullMem);
+	s << get_hw_counter_info();
 	if(zone->groups != NULL)
 		s << zone->groups;
 	return s.str();
@@ -470,6 +518,10 @@ void UGProfileNode::log_header(stringstream &s, const char *name)
 		s << "  " << setw(10+5+3) << "self mem" << "   " <<
 				setw(10) << "total mem";
 	}
+	if(HasHardwareCounters())
+	{
+		s << "  " << setw(6) << "IPC" << " " << setw(9) << "GB/s";
+	}
 
 	s << "\n";
 }
@@ -849,6 +901,139 @@ void WriteProfileDataXML(const char *filename, int procId)
 	
 }
 
+static void WriteTraceJSONString(ostream &out, const char *str)
+{
+	out << '"';
+	for(const char *p = str; p && *p; ++p)
+	{
+		switch(*p)
+		{
+			case '"':	out << "\\\""; break;
+			case '\\':	out << "\\\\"; break;
+			case '\n':	out << "\\n"; break;
+			case '\t':	out << "\\t"; break;
+			default:
+				if((unsigned char)*p < 0x20)	out << ' ';
+				else							out << *p;
+		}
+	}
+	out << '"';
+}
+
+///	writes the trace events of all threads of this process.
+/**	each event is preceded by a comma, except for the very first if bFirst is true.
+ * timestamps are given in microseconds relative to startWallTimeUs.*/
+static void WriteTraceEventsJSON(ostream &out, int pid, double startWallTimeUs, bool bFirst)
+{
+	Shiny::tick_t refTick, curTick;
+	double refWallTimeUs;
+	GetProfileTraceTimeReference(refTick, refWallTimeUs);
+	Shiny::GetTicks(&curTick);
+
+	const double usPerTick = 1e6 / (double)Shiny::GetTickFreq();
+	const double offsetUs = refWallTimeUs - startWallTimeUs;
+
+	out << fixed << setprecision(3);
+	out << (bFirst ? "" : ",\n")
+		<< "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+		<< ",\"tid\":0,\"args\":{\"name\":\"proc " << pid << "\"}}";
+
+	vector<ThreadProfiler*> threads = ThreadProfiler::all_threads();
+	for(size_t i = 0; i < threads.size(); ++i)
+	{
+		const ThreadProfiler &tp = *threads[i];
+		out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+			<< ",\"tid\":" << tp.index() << ",\"args\":{\"name\":";
+		WriteTraceJSONString(out, tp.name().c_str());
+		out << "}}";
+
+		const vector<ProfileTraceEvent> &events = tp.trace_events();
+		for(size_t j = 0; j < events.size(); ++j)
+		{
+			const ProfileTraceEvent &ev = events[j];
+		//	events which are still open end now
+			Shiny::tick_t end = (ev.end != 0) ? ev.end : curTick;
+			double ts = offsetUs + (double)(int64_t)(ev.begin - refTick) * usPerTick;
+			double dur = (double)(end - ev.begin) * usPerTick;
+
+			out << ",\n{\"name\":";
+			WriteTraceJSONString(out, ev.zone->name);
+			out << ",\"cat\":";
+			WriteTraceJSONString(out, ev.zone->groups ? ev.zone->groups : "ug");
+			out << ",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << dur
+				<< ",\"pid\":" << pid << ",\"tid\":" << tp.index() << "}";
+		}
+
+		if(tp.num_dropped_trace_events() > 0){
+			UG_LOG("WARNING in WriteProfileTraceJSON: " << tp.num_dropped_trace_events()
+				   << " trace events of " << tp.name() << " on proc " << pid
+				   << " were dropped. Increase the limit with SetProfileTraceMaxEvents.\n");
+		}
+	}
+}
+
+void WriteProfileTraceJSON(const char *filename)
+{
+	Shiny::tick_t refTick;
+	double startWallTimeUs;
+	GetProfileTraceTimeReference(refTick, startWallTimeUs);
+
+	int rank = 0;
+#ifdef UG_PARALLEL
+	rank = pcl::ProcRank();
+	pcl::ProcessCommunicator pc;
+	startWallTimeUs = pc.allreduce(startWallTimeUs, PCL_RO_MIN);
+
+	typedef pcl::SingleLevelLayout<pcl::OrderedInterface<size_t, vector> >
+		IndexLayout;
+
+	pcl::InterfaceCommunicator<IndexLayout> ic;
+	if(rank == 0)
+	{
+#endif
+		fstream f(filename, ios::out);
+		f << "{\"traceEvents\":[\n";
+		WriteTraceEventsJSON(f, rank, startWallTimeUs, true);
+
+#ifdef UG_PARALLEL
+		vector<ug::BinaryBuffer> buffers(pcl::NumProcs()-1);
+		for(int i=1; i<pcl::NumProcs(); i++)
+			ic.receive_raw(i, buffers[i-1]);
+		ic.communicate();
+
+		for(int i=1; i<pcl::NumProcs(); i++)
+		{
+			string s;
+			Deserialize(buffers[i-1], s);
+			f << s;
+		}
+#endif
+		f << "\n],\n\"displayTimeUnit\":\"ms\"}\n";
+
+#ifdef UG_PARALLEL
+	}
+	else
+	{
+		stringstream ss;
+		WriteTraceEventsJSON(ss, rank, startWallTimeUs, false);
+		BinaryBuffer buf;
+		Serialize(buf, ss.str());
+		ic.send_raw(0, buf.buffer(), buf.write_pos(), false);
+		ic.communicate();
+	}
+#endif
+}
+
+void EnableProfileTrace(bool enable)
+{
+	g_ProfileTraceEnabled = enable;
+}
+
+void SetProfileTraceMaxEvents(size_t maxEventsPerThread)
+{
+	g_ProfileTraceMaxEvents = maxEventsPerThread;
+}
+
 const UGProfileNode *GetProfileNode(const char *name, const UGProfileNode *node)
 {
 	ProfilerUpdate();
@@ -966,6 +1151,26 @@ double UGProfileNode::get_total_mem() const
 	return 0.0;
 }
 
+double UGProfileNode::get_self_hw_counter(const std::string& name) const
+{
+	return 0.0;
+}
+
+double UGProfileNode::get_total_hw_counter(const std::string& name) const
+{
+	return 0.0;
+}
+
+double UGProfileNode::get_ipc() const
+{
+	return 0.0;
+}
+
+double UGProfileNode::get_bandwidth_gbs() const
+{
+	return 0.0;
+}
+
 double UGProfileNode::get_self_mem() const
 {
 	return 0.0;
@@ -1045,6 +1250,21 @@ void WriteProfileDataXML(const char *filename)
 	return;
 }
 
+void WriteProfileTraceJSON(const char *filename)
+{
+	return;
+}
+
+void EnableProfileTrace(bool enable)
+{
+	if(enable)
+		UG_LOG("Profile trace only available with the shiny profiler.\n");
+}
+
+void SetProfileTraceMaxEvents(size_t maxEventsPerThread)
+{
+}
+
 void WriteProfileDataXML(const char *filename, int procId)
 {
 	return;
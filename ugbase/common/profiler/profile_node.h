@@ -72,6 +72,20 @@ public:
 	double get_self_mem() const;
 	double get_total_mem() const;
 
+	/// \return count of the given hardware counter (e.g. "cycles") in this node excluding subnodes
+	double get_self_hw_counter(const std::string& name) const;
+
+	/// \return count of the given hardware counter (e.g. "cycles") in this node including subnodes
+	double get_total_hw_counter(const std::string& name) const;
+
+	/// \return instructions per cycle in this node including subnodes
+	double get_ipc() const;
+
+	/// \return memory bandwidth in GB/s in this node including subnodes,
+	///			estimated by the last level cache misses times the cache line size
+	///			per second of recorded counters
+	double get_bandwidth_gbs() const;
+
 	/**
 	 * @param dSkipMarginal 	nodes with full*dSkipMarginal > node->full[ms or mem] are skipped
 	 * @return call tree profile information
@@ -167,6 +181,11 @@ private:
 	 */
 	std::string get_mem_info(double fullMem) const;
 
+	/**
+	 * @brief prints the derived hardware counter metrics (IPC, GB/s) of a node
+	 */
+	std::string get_hw_counter_info() const;
+
 
 	/**
 	 * @brief recursive print this node and its subnodes into stringstream s
@@ -238,6 +257,23 @@ void WriteProfileDataXML(const char *filename, int procId);
 void WriteCallLog(const char *filename);
 void WriteCallLog(const char *filename, int procId);
 
+///	Writes the recorded trace events of all procs and threads to the specified file
+/**	The file uses the Chrome trace-event format (JSON), which can be viewed in
+ * chrome://tracing or Perfetto. Each process shows up with its rank as pid and
+ * each thread with its index as tid. Timestamps are aligned by the wall clock
+ * time of the processes.
+ * Recording of trace events has to be enabled through EnableProfileTrace.
+ *
+ * \note has to be called on all processes.
+ */
+void WriteProfileTraceJSON(const char *filename);
+
+///	Enables or disables the recording of trace events (disabled by default)
+void EnableProfileTrace(bool enable);
+
+///	Sets the maximal number of trace events which are recorded per thread
+void SetProfileTraceMaxEvents(size_t maxEventsPerThread);
+
 }
 
 
@@ -64,7 +64,7 @@ ProfileNodeManager::
 ProfileNodeManager& ProfileNodeManager::
 inst()
 {
-	static ProfileNodeManager pnm;
+	static thread_local ProfileNodeManager pnm;
 	return pnm;
 }
 
@@ -72,7 +72,10 @@ inst()
 
 
 #ifdef UG_PROFILER_SHINY
-AutoProfileNode::AutoProfileNode() : m_bActive(true)
+AutoProfileNode::AutoProfileNode() :
+	m_bActive(true),
+	m_pThreadProfiler(NULL),
+	m_traceEvent(ug::ThreadProfiler::NO_TRACE_EVENT)
 #endif
 #if defined(UG_PROFILER_SCALASCA) || defined(UG_PROFILER_VAMPIR)
 AutoProfileNode::AutoProfileNode(const char* name) : m_bActive(true), m_pName(name)
@@ -88,7 +91,14 @@ void AutoProfileNode::release()
 {
 	if(m_bActive){
 #ifdef UG_PROFILER_SHINY
-		Shiny::ProfileManager::instance._endCurNode();
+		if(m_traceEvent != ug::ThreadProfiler::NO_TRACE_EVENT)
+			m_pThreadProfiler->end_trace_event(m_traceEvent);
+		if(m_pThreadProfiler->is_main_thread()){
+			ug::HardwareCountersLeaveZone(Shiny::ProfileManager::instance._curNode);
+			Shiny::ProfileManager::instance._endCurNode();
+		}
+		else
+			m_pThreadProfiler->end_zone();
 		PROFILE_LOG_CALL_END();
 #endif
 #ifdef UG_PROFILER_SCALASCA
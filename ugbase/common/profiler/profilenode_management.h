@@ -34,11 +34,24 @@
 #define PROFILENODE_MANAGEMENT_H_
 
 #include <stack>
+#include <cstddef>
 #ifdef UG_PROFILER_SCOREP
 #include <scorep/SCOREP_User.h>
 #endif
+#ifdef UG_PROFILER_SHINY
+namespace Shiny{
+	struct ProfileNode;
+	struct ProfileZone;
+}
+namespace ug{
+	class ThreadProfiler;
+}
+#endif
 class AutoProfileNode;
 
+///	keeps track of the open AutoProfileNodes of the calling thread
+/**	Each thread has its own instance, so that profile nodes may be opened
+ * and closed concurrently by different threads.*/
 class ProfileNodeManager
 {
 	public:
@@ -62,6 +75,10 @@ class AutoProfileNode
 	public:
 #ifdef UG_PROFILER_SHINY
 		AutoProfileNode();
+
+	///	enters the given zone in the call tree of the calling thread
+	/**	Defined inline in thread_profile.h.*/
+		inline void begin(Shiny::ProfileNode** cache, Shiny::ProfileZone* zone);
 #endif
 #if defined(UG_PROFILER_SCALASCA) || defined(UG_PROFILER_VAMPIR)
 		AutoProfileNode(const char* name);
@@ -77,6 +94,10 @@ class AutoProfileNode
 
 	private:
 		bool m_bActive;
+#ifdef UG_PROFILER_SHINY
+		ug::ThreadProfiler* m_pThreadProfiler;
+		size_t m_traceEvent;
+#endif
 #if defined(UG_PROFILER_SCALASCA) || defined(UG_PROFILER_VAMPIR)
 		const char* m_pName;
 #endif
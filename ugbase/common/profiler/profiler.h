@@ -62,6 +62,7 @@
 	#define SHINY_PROFILER TRUE
 	#include "src/ShinyManager.h"
 	#include "src/ShinyNode.h"
+	#include "thread_profile.h"
 
 
 	/**	Helper makro used in PROFILE_BEGIN and PROFILE_FUNC.*/
@@ -78,7 +79,7 @@
 			static Shiny::ProfileNodeCache cache =			\
 				&Shiny::ProfileNode::_dummy;				\
 															\
-			Shiny::ProfileManager::instance._beginNode(&cache, &__ShinyZone_##id);\
+			id.begin(&cache, &__ShinyZone_##id);			\
 		}\
 		PROFILE_LOG_CALL_START()
 
@@ -107,7 +108,7 @@
 
 	/**	Performs update on the profiler (call before output)*/
 	#define PROFILER_UPDATE									\
-		Shiny::ProfileManager::instance.update
+		ug::UpdateProfiler
 
 	/**	Outputs the profile-times*/
 	#define PROFILER_OUTPUT									\
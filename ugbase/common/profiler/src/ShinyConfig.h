@@ -81,4 +81,22 @@ restrictions:
 #   define SHINY_COMPILER	SHINY_COMPILER_OTHER
 #endif
 
+
+//-----------------------------------------------------------------------------
+
+//	CHANGE: ticks are read from the time stamp counter on x86 POSIX systems.
+//	Reading the TSC costs a few cycles, compared to a system call for
+//	gettimeofday. Its frequency is calibrated against the steady clock.
+//	Note that this assumes an invariant TSC (constant rate, synchronized
+//	between cores), which holds for all recent x86 processors.
+//	Define SHINY_USE_TSC as FALSE to fall back to gettimeofday.
+#ifndef SHINY_USE_TSC
+#	if SHINY_PLATFORM == SHINY_PLATFORM_POSIX && SHINY_COMPILER == SHINY_COMPILER_GNUC \
+		&& (defined(__x86_64__) || defined(__i386__))
+#		define SHINY_USE_TSC	TRUE
+#	else
+#		define SHINY_USE_TSC	FALSE
+#	endif
+#endif
+
 #endif // ifndef SHINY_*_H
@@ -55,6 +55,10 @@ namespace Shiny {
 
 		ProfileData data;
 
+		// CHANGE:	index+1 of the hardware counter record of this node or 0.
+		//			See ugbase/common/profiler/hardware_counters.h
+		uint32_t hwCounterSlot;
+
 		static ProfileNode _dummy;
 
 		//
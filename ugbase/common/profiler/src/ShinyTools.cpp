@@ -31,6 +31,10 @@ restrictions:
 #include <sys/time.h>
 #endif
 
+#if SHINY_USE_TSC == TRUE
+#include <chrono>
+#endif
+
 namespace Shiny {
 
 
@@ -77,6 +81,49 @@ namespace Shiny {
 	}
 
 
+//-----------------------------------------------------------------------------
+
+#elif SHINY_PLATFORM == SHINY_PLATFORM_POSIX && SHINY_USE_TSC == TRUE
+
+	struct TscReference {
+		tick_t ticks;
+		std::chrono::steady_clock::time_point time;
+	};
+
+	static const TscReference& _GetTscReference(void) {
+		static TscReference ref = { __rdtsc(), std::chrono::steady_clock::now() };
+		return ref;
+	}
+
+//	the reference point is taken at startup, so that the calibration in
+//	_InitTickFreq normally does not have to wait.
+	static const TscReference& _tscReferenceAtStartup = _GetTscReference();
+
+	tick_t _InitTickFreq(void) {
+		const TscReference& ref = _GetTscReference();
+		const std::chrono::duration<double> minInterval(0.05);
+
+		std::chrono::duration<double> elapsed;
+		tick_t ticks;
+		do {
+			elapsed = std::chrono::steady_clock::now() - ref.time;
+			GetTicks(&ticks);
+		} while (elapsed < minInterval);
+
+		return (tick_t) ((double) (ticks - ref.ticks) / elapsed.count());
+	}
+
+	tick_t GetTickFreq(void) {
+		static tick_t freq = _InitTickFreq();
+		return freq;
+	}
+
+	float GetTickInvFreq(void) {
+		static float invfreq = 1.0f / GetTickFreq();
+		return invfreq;
+	}
+
+
 //-----------------------------------------------------------------------------
 
 #elif SHINY_PLATFORM == SHINY_PLATFORM_POSIX
@@ -35,6 +35,10 @@ New code is marked with //sreiter
 
 #include "ShinyPrereqs.h"
 
+#if SHINY_USE_TSC == TRUE
+#include <x86intrin.h>
+#endif
+
 
 namespace Shiny {
 
@@ -52,7 +56,11 @@ namespace Shiny {
 
 //-----------------------------------------------------------------------------
 
+#if SHINY_USE_TSC == TRUE
+	SHINY_INLINE void GetTicks(tick_t *p) { *p = __rdtsc(); }
+#else
 	void GetTicks(tick_t *p);
+#endif
 
 	tick_t GetTickFreq(void);
 
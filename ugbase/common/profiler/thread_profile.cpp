@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "profiler.h"
+#include "thread_profile.h"
+
+namespace ug{
+
+bool	g_ProfileTraceEnabled = false;
+size_t	g_ProfileTraceMaxEvents = 1 << 20;
+
+const size_t ThreadProfiler::NO_TRACE_EVENT;
+
+////////////////////////////////////////////////////////////////////////////////
+//	registry of thread profilers
+namespace{
+
+struct ThreadProfilerRegistry
+{
+	std::mutex						mutex;
+	std::vector<ThreadProfiler*>	profilers;	///< entry 0 is the main thread
+	int								numWorkers;
+};
+
+ThreadProfilerRegistry& Registry()
+{
+	static ThreadProfilerRegistry reg;
+	return reg;
+}
+
+std::thread::id MainThreadId()
+{
+	static std::thread::id id = std::this_thread::get_id();
+	return id;
+}
+
+struct TimeReference
+{
+	Shiny::tick_t	tick;
+	double			wallTimeUs;
+};
+
+TimeReference CurrentTimeReference()
+{
+	TimeReference ref;
+	Shiny::GetTicks(&ref.tick);
+	ref.wallTimeUs = std::chrono::duration<double, std::micro>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	return ref;
+}
+
+const TimeReference& TraceTimeReference()
+{
+	static TimeReference ref = CurrentTimeReference();
+	return ref;
+}
+
+//	static initialization is performed by the main thread. This fixes the id of
+//	the main thread and the reference time before any zone is entered.
+const std::thread::id s_mainThreadId = MainThreadId();
+const TimeReference& s_traceTimeReference = TraceTimeReference();
+
+}//	end of anonymous namespace
+
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadProfiler::
+ThreadProfiler(int index, const std::string& name) :
+	m_index(index),
+	m_name(name),
+	m_rootCache(&Shiny::ProfileNode::_dummy),
+	m_curNode(&m_root),
+	m_numDroppedTraceEvents(0)
+{
+	Shiny::ProfileZone zone = {
+		NULL, Shiny::ProfileZone::STATE_HIDDEN, m_name.c_str(),
+		NULL, NULL, 0,
+		{ { 0, 0 }, { 0, 0 }, { 0, 0 } }
+	};
+	m_zone = zone;
+
+	m_root.zone = &m_zone;
+	m_root.parent = NULL;
+	m_root.lastChild = NULL;
+	m_root.entryCount = 0;
+	m_root.selfTicks = 0;
+	m_root.shinyCache = &Shiny::ProfileNode::_dummy;
+
+	Shiny::GetTicks(&m_lastTick);
+}
+
+ThreadProfiler* ThreadProfiler::
+create_for_current_thread()
+{
+	ThreadProfilerRegistry& reg = Registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+
+	if(reg.profilers.empty()){
+		reg.profilers.push_back(NULL);
+		reg.numWorkers = 0;
+	}
+
+	if(std::this_thread::get_id() == MainThreadId()){
+		if(!reg.profilers[0])
+			reg.profilers[0] = new ThreadProfiler(0, "<main thread>");
+		return reg.profilers[0];
+	}
+
+	int index = ++reg.numWorkers;
+	std::stringstream ss;
+	ss << "<thread " << index << ">";
+	ThreadProfiler* tp = new ThreadProfiler(index, ss.str());
+	reg.profilers.push_back(tp);
+	return tp;
+}
+
+std::vector<ThreadProfiler*> ThreadProfiler::
+all_threads()
+{
+	ThreadProfilerRegistry& reg = Registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+
+	std::vector<ThreadProfiler*> threads;
+	for(size_t i = 0; i < reg.profilers.size(); ++i){
+		if(reg.profilers[i])
+			threads.push_back(reg.profilers[i]);
+	}
+	return threads;
+}
+
+ThreadProfileNode* ThreadProfiler::
+find_or_create_child_node(ThreadProfileNode* node, Shiny::ProfileZone* zone)
+{
+	for(size_t i = 0; i < node->children.size(); ++i){
+		if(node->children[i]->zone == zone){
+			node->lastChild = node->children[i];
+			return node->lastChild;
+		}
+	}
+
+	ThreadProfileNode* child = new ThreadProfileNode;
+	child->zone = zone;
+	child->parent = node;
+	child->lastChild = NULL;
+	child->entryCount = 0;
+	child->selfTicks = 0;
+	child->shinyCache = &Shiny::ProfileNode::_dummy;
+	node->children.push_back(child);
+	node->lastChild = child;
+	return child;
+}
+
+void ThreadProfiler::
+merge_into_shiny_tree()
+{
+	if(is_main_thread() || m_root.children.empty())
+		return;
+
+	Shiny::ProfileManager& pm = Shiny::ProfileManager::instance;
+	Shiny::ProfileNode* curNode = pm._curNode;
+
+//	the root of this thread's tree is added as a child of shiny's root node.
+	pm._curNode = &pm.rootNode;
+	Shiny::ProfileNode* threadNode = pm._lookupNode(&m_rootCache, &m_zone);
+	threadNode->beginEntry();
+
+	for(size_t i = 0; i < m_root.children.size(); ++i)
+		merge_rec(m_root.children[i], threadNode);
+
+//	time outside of any zone is not accounted for
+	m_root.selfTicks = 0;
+	pm._curNode = curNode;
+}
+
+void ThreadProfiler::
+merge_rec(ThreadProfileNode* node, Shiny::ProfileNode* shinyParent)
+{
+	Shiny::ProfileManager& pm = Shiny::ProfileManager::instance;
+	pm._curNode = shinyParent;
+	Shiny::ProfileNode* shinyNode = pm._lookupNode(&node->shinyCache, node->zone);
+
+	shinyNode->_last.entryCount += node->entryCount;
+	shinyNode->_last.selfTicks += node->selfTicks;
+	node->entryCount = 0;
+	node->selfTicks = 0;
+
+	for(size_t i = 0; i < node->children.size(); ++i)
+		merge_rec(node->children[i], shinyNode);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void MergeThreadProfiles()
+{
+	std::vector<ThreadProfiler*> threads = ThreadProfiler::all_threads();
+	for(size_t i = 0; i < threads.size(); ++i)
+		threads[i]->merge_into_shiny_tree();
+}
+
+void UpdateProfiler(float damping)
+{
+	MergeThreadProfiles();
+	Shiny::ProfileManager::instance.update(damping);
+}
+
+void GetProfileTraceTimeReference(Shiny::tick_t& tick, double& wallTimeUs)
+{
+	const TimeReference& ref = TraceTimeReference();
+	tick = ref.tick;
+	wallTimeUs = ref.wallTimeUs;
+}
+
+}//	end of namespace
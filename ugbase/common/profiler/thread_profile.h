@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__PROFILER__THREAD_PROFILE__
+#define __H__UG__COMMON__PROFILER__THREAD_PROFILE__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "src/ShinyManager.h"
+#include "profilenode_management.h"
+#include "hardware_counters.h"
+
+namespace ug{
+
+///	node of the call tree which is recorded by a worker thread
+struct ThreadProfileNode
+{
+	Shiny::ProfileZone*				zone;
+	ThreadProfileNode*				parent;
+	std::vector<ThreadProfileNode*>	children;
+	ThreadProfileNode*				lastChild;	///< speeds up repeated lookups
+	uint32_t						entryCount;
+	Shiny::tick_t					selfTicks;
+	Shiny::ProfileNodeCache			shinyCache;	///< used when merged into shiny's tree
+};
+
+///	an entered and (unless end == 0) left zone, recorded for the trace export
+struct ProfileTraceEvent
+{
+	const Shiny::ProfileZone*	zone;
+	Shiny::tick_t				begin;
+	Shiny::tick_t				end;
+};
+
+extern bool		g_ProfileTraceEnabled;
+extern size_t	g_ProfileTraceMaxEvents;
+
+///	true if begin and end of profiled zones are recorded for the trace export
+inline bool ProfileTraceEnabled()	{return g_ProfileTraceEnabled;}
+
+
+///	Per-thread profiling data
+/**	Shiny's ProfileManager is a process wide singleton and thus may only be
+ * used by one thread. It is reserved for the main thread. All other threads
+ * record their calls into a call tree of their own, without any locking.
+ * Those trees are merged into shiny's call tree by MergeThreadProfiles,
+ * where each thread shows up as a separate child of the root node.
+ *
+ * Besides that each thread (including the main thread) stores its trace
+ * events, if tracing was enabled through EnableProfileTrace.
+ *
+ * \note	Merging and the trace export read the data of all threads. They
+ *			thus should only be invoked while worker threads are idle, e.g.
+ *			between two parallel sections.
+ */
+class ThreadProfiler
+{
+	public:
+		static const size_t NO_TRACE_EVENT = (size_t)-1;
+
+	///	returns the profiler of the calling thread. Created on the first call.
+		static inline ThreadProfiler& local()
+		{
+			static thread_local ThreadProfiler* tp = NULL;
+			if(!tp)
+				tp = create_for_current_thread();
+			return *tp;
+		}
+
+	///	returns the profilers of all threads which were profiled so far
+	/**	The profiler of the main thread (if any) is the first entry.*/
+		static std::vector<ThreadProfiler*> all_threads();
+
+		inline bool is_main_thread() const		{return m_index == 0;}
+
+	///	index of the thread. The main thread has index 0.
+		inline int index() const				{return m_index;}
+
+		inline const std::string& name() const	{return m_name;}
+
+	///	enters the given zone in the call tree of this thread
+		inline void begin_zone(Shiny::ProfileZone* zone)
+		{
+			append_ticks_to_cur_node();
+			m_curNode = child_node(m_curNode, zone);
+			++m_curNode->entryCount;
+		}
+
+	///	leaves the current zone in the call tree of this thread
+		inline void end_zone()
+		{
+			append_ticks_to_cur_node();
+			if(m_curNode->parent)
+				m_curNode = m_curNode->parent;
+		}
+
+	///	records the begin of a zone. Returns the index of the event.
+	/**	If the maximal number of events is reached, NO_TRACE_EVENT is returned.*/
+		inline size_t begin_trace_event(const Shiny::ProfileZone* zone)
+		{
+			if(m_trace.size() >= g_ProfileTraceMaxEvents){
+				++m_numDroppedTraceEvents;
+				return NO_TRACE_EVENT;
+			}
+			ProfileTraceEvent ev;
+			ev.zone = zone;
+			Shiny::GetTicks(&ev.begin);
+			ev.end = 0;
+			m_trace.push_back(ev);
+			return m_trace.size() - 1;
+		}
+
+	///	records the end of a zone, whose begin was recorded as the given event
+		inline void end_trace_event(size_t ev)
+		{
+			if(ev < m_trace.size())
+				Shiny::GetTicks(&m_trace[ev].end);
+		}
+
+		inline const std::vector<ProfileTraceEvent>& trace_events() const
+		{return m_trace;}
+
+	///	number of events which were not recorded since the buffer was full
+		inline size_t num_dropped_trace_events() const
+		{return m_numDroppedTraceEvents;}
+
+	///	adds the recorded call tree to shiny's call tree and resets it
+	/**	May only be called from the main thread.*/
+		void merge_into_shiny_tree();
+
+	private:
+		ThreadProfiler(int index, const std::string& name);
+
+		static ThreadProfiler* create_for_current_thread();
+
+		inline void append_ticks_to_cur_node()
+		{
+			Shiny::tick_t curTick;
+			Shiny::GetTicks(&curTick);
+			m_curNode->selfTicks += curTick - m_lastTick;
+			m_lastTick = curTick;
+		}
+
+		inline ThreadProfileNode* child_node(ThreadProfileNode* node,
+											 Shiny::ProfileZone* zone)
+		{
+			if(node->lastChild && node->lastChild->zone == zone)
+				return node->lastChild;
+			return find_or_create_child_node(node, zone);
+		}
+
+		ThreadProfileNode* find_or_create_child_node(ThreadProfileNode* node,
+													 Shiny::ProfileZone* zone);
+
+		void merge_rec(ThreadProfileNode* node, Shiny::ProfileNode* shinyParent);
+
+	private:
+		int							m_index;
+		std::string					m_name;
+		Shiny::ProfileZone			m_zone;
+		ThreadProfileNode			m_root;
+		Shiny::ProfileNodeCache		m_rootCache;
+		ThreadProfileNode*			m_curNode;
+		Shiny::tick_t				m_lastTick;
+
+		std::vector<ProfileTraceEvent>	m_trace;
+		size_t							m_numDroppedTraceEvents;
+};
+
+
+///	adds the call trees of all worker threads to shiny's call tree
+/**	May only be called from the main thread, while worker threads are idle.*/
+void MergeThreadProfiles();
+
+///	merges the call trees of all threads and updates shiny's profile data
+void UpdateProfiler(float damping = 0.9f);
+
+///	returns the tick and the wall clock time (in microseconds since epoch)
+///	of a common reference point, used to align traces of different processes
+void GetProfileTraceTimeReference(Shiny::tick_t& tick, double& wallTimeUs);
+
+}//	end of namespace
+
+
+inline void AutoProfileNode::
+begin(Shiny::ProfileNodeCache* cache, Shiny::ProfileZone* zone)
+{
+	ug::ThreadProfiler& tp = ug::ThreadProfiler::local();
+	m_pThreadProfiler = &tp;
+
+	if(tp.is_main_thread()){
+		ug::HardwareCountersEnterZone(Shiny::ProfileManager::instance._curNode);
+		Shiny::ProfileManager::instance._beginNode(cache, zone);
+	}
+	else
+		tp.begin_zone(zone);
+
+	if(ug::ProfileTraceEnabled())
+		m_traceEvent = tp.begin_trace_event(zone);
+}
+
+#endif
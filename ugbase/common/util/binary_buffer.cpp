@@ -30,6 +30,7 @@
  * GNU Lesser General Public License for more details.
  */
 
+#include <algorithm>
 #include "binary_buffer.h"
 
 namespace ug
@@ -71,4 +72,11 @@ void BinaryBuffer::set_write_pos(size_t pos)
 	m_writePos = pos;
 }
 
+void BinaryBuffer::swap(BinaryBuffer& buf)
+{
+	m_data.swap(buf.m_data);
+	std::swap(m_readPos, buf.m_readPos);
+	std::swap(m_writePos, buf.m_writePos);
+}
+
 }//	end of namespace
@@ -101,6 +101,9 @@ class BinaryBuffer
 	///	sets the write position.
 		void set_write_pos(size_t pos);
 
+	///	exchanges the memory and the read and write positions with buf
+		void swap(BinaryBuffer& buf);
+
 	private:
 		std::vector<char>	m_data;
 		size_t				m_readPos;
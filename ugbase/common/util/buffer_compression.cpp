@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "buffer_compression.h"
+#include "common/error.h"
+
+namespace ug{
+
+//	The compressed block starts with the uncompressed and the compressed size
+//	(uint64 each), followed by a sequence of tokens. Each token holds the number
+//	of literals in its upper and the match length minus MIN_MATCH in its lower
+//	four bits. Values of 15 are continued by bytes of 255, terminated by a
+//	smaller byte. Literals follow the token, then a 2 byte offset to the start
+//	of the match. The last token only holds literals.
+static const size_t MIN_MATCH = 4;
+static const size_t MAX_OFFSET = 65535;
+static const int MIN_HASH_LOG = 8;
+static const int MAX_HASH_LOG = 16;
+
+static inline uint32 Read32(const byte* p)
+{
+	uint32 v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static inline size_t HashSequence(uint32 v, int hashLog)
+{
+	return (v * 2654435761u) >> (32 - hashLog);
+}
+
+static inline byte* WriteLength(byte* op, size_t len)
+{
+	while(len >= 255){
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = (byte)len;
+	return op;
+}
+
+static inline size_t ReadLength(const byte*& ip, const byte* end, size_t len)
+{
+	if(len < 15)
+		return len;
+	byte b;
+	do{
+		UG_COND_THROW(ip >= end, "DecompressBinaryBuffer: corrupt data.");
+		b = *ip++;
+		len += b;
+	}while(b == 255);
+	return len;
+}
+
+static inline byte* WriteSequence(byte* op, const byte* literals, size_t numLiterals,
+								  size_t matchLen)
+{
+	byte* token = op++;
+	*token = (byte)((std::min<size_t>(numLiterals, 15) << 4)
+					| std::min<size_t>(matchLen, 15));
+	if(numLiterals >= 15)
+		op = WriteLength(op, numLiterals - 15);
+	if(numLiterals > 0)
+		memcpy(op, literals, numLiterals);
+	return op + numLiterals;
+}
+
+
+void CompressBinaryBuffer(BinaryBuffer& out, BinaryBuffer& in)
+{
+	const byte* src = (const byte*)in.buffer() + in.read_pos();
+	const size_t n = in.write_pos() - in.read_pos();
+	const byte* end = src + n;
+
+//	worst case: all bytes are literals
+	const size_t headerSize = 2 * sizeof(uint64);
+	const size_t outBegin = out.write_pos();
+	out.reserve(outBegin + headerSize + n + n / 255 + 16);
+	byte* dst = (byte*)out.buffer() + outBegin + headerSize;
+	byte* op = dst;
+
+//	the hash table is sized to the input, so that small buffers do not
+//	allocate and clear the full table
+	int hashLog = MIN_HASH_LOG;
+	while(hashLog < MAX_HASH_LOG && (size_t(1) << hashLog) < n)
+		++hashLog;
+	std::vector<size_t> table(size_t(1) << hashLog, 0);
+	const byte* anchor = src;
+	const byte* ip = src;
+
+	if(n >= MIN_MATCH){
+		const byte* matchLimit = end - MIN_MATCH;
+		while(ip <= matchLimit){
+			const uint32 seq = Read32(ip);
+			const size_t h = HashSequence(seq, hashLog);
+			const byte* ref = src + table[h];
+			table[h] = ip - src;
+
+			if(ref < ip && (size_t)(ip - ref) <= MAX_OFFSET && Read32(ref) == seq){
+				const byte* mp = ip + MIN_MATCH;
+				const byte* rp = ref + MIN_MATCH;
+				while(mp < end && *mp == *rp){
+					++mp;
+					++rp;
+				}
+
+				const size_t matchLen = (mp - ip) - MIN_MATCH;
+				op = WriteSequence(op, anchor, ip - anchor, matchLen);
+				const size_t offset = ip - ref;
+				*op++ = (byte)(offset & 0xFF);
+				*op++ = (byte)(offset >> 8);
+				if(matchLen >= 15)
+					op = WriteLength(op, matchLen - 15);
+
+				ip = mp;
+				anchor = ip;
+			}
+			else{
+			//	skip faster through incompressible data
+				ip += 1 + ((ip - anchor) >> 6);
+			}
+		}
+	}
+
+//	the remaining bytes are written as literals
+	op = WriteSequence(op, anchor, end - anchor, 0);
+
+	uint64 header[2];
+	header[0] = n;
+	header[1] = op - dst;
+	memcpy(out.buffer() + outBegin, header, headerSize);
+	out.set_write_pos(outBegin + headerSize + (op - dst));
+	in.set_read_pos(in.write_pos());
+}
+
+
+void DecompressBinaryBuffer(BinaryBuffer& out, BinaryBuffer& in)
+{
+	uint64 header[2];
+	in.read((char*)header, 2 * sizeof(uint64));
+	UG_COND_THROW(in.read_pos() + header[1] > in.write_pos(),
+				  "DecompressBinaryBuffer: compressed block exceeds the buffer.");
+
+	const byte* ip = (const byte*)in.buffer() + in.read_pos();
+	const byte* end = ip + header[1];
+
+	const size_t outBegin = out.write_pos();
+	out.reserve(outBegin + header[0]);
+	byte* dst = (byte*)out.buffer() + outBegin;
+	byte* dstEnd = dst + header[0];
+	byte* op = dst;
+
+	while(ip < end){
+		const byte token = *ip++;
+		const size_t numLiterals = ReadLength(ip, end, token >> 4);
+		UG_COND_THROW((size_t)(end - ip) < numLiterals
+					  || (size_t)(dstEnd - op) < numLiterals,
+					  "DecompressBinaryBuffer: corrupt data.");
+		if(numLiterals > 0)
+			memcpy(op, ip, numLiterals);
+		ip += numLiterals;
+		op += numLiterals;
+
+	//	the last sequence only holds literals
+		if(ip == end)
+			break;
+
+		UG_COND_THROW(end - ip < 2, "DecompressBinaryBuffer: corrupt data.");
+		const size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+		const size_t matchLen = ReadLength(ip, end, token & 0x0F) + MIN_MATCH;
+		UG_COND_THROW(offset == 0 || offset > (size_t)(op - dst)
+					  || (size_t)(dstEnd - op) < matchLen,
+					  "DecompressBinaryBuffer: corrupt data.");
+
+	//	source and target may overlap, so that bytes have to be copied one by one
+		const byte* mp = op - offset;
+		for(size_t i = 0; i < matchLen; ++i)
+			op[i] = mp[i];
+		op += matchLen;
+	}
+
+	UG_COND_THROW(op != dstEnd, "DecompressBinaryBuffer: size mismatch.");
+	out.set_write_pos(outBegin + header[0]);
+	in.set_read_pos(in.read_pos() + header[1]);
+}
+
+}//	end of namespace
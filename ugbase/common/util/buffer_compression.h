@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG_buffer_compression__
+#define __H__UG_buffer_compression__
+
+#include "binary_buffer.h"
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	compresses the unread bytes of 'in' and appends the result to 'out'
+/**	A fast byte oriented LZ77 codec without entropy coding is used, which
+ * trades compression ratio for speed. It works well on serialized grids and
+ * attachments, which contain many repeated byte sequences.
+ * The read position of 'in' is moved to its write position.*/
+void CompressBinaryBuffer(BinaryBuffer& out, BinaryBuffer& in);
+
+///	decompresses data written by CompressBinaryBuffer and appends it to 'out'
+/**	Starts reading at the read position of 'in' and advances it by the
+ * size of the compressed block.*/
+void DecompressBinaryBuffer(BinaryBuffer& out, BinaryBuffer& in);
+
+// end group ugbase_common_util
+/// \}
+
+}//	end of namespace
+
+#endif
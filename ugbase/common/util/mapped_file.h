@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__mapped_file__
+#define __H__UG__mapped_file__
+
+#include <cstddef>
+#include "common/ug_config.h"
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	Read-only memory mapping of a file
+/**	The contents of the file are mapped into the address space of the process,
+ * so that they can be accessed without reading them into a buffer first.
+ * Pages are loaded lazily by the operating system on first access and may be
+ * shared between processes which map the same file.
+ *
+ * The class throws an UGError if a file can not be opened or mapped.
+ * Mapped files can't be copied.*/
+class UG_API MappedFile
+{
+	public:
+		MappedFile();
+		MappedFile(const char* filename);
+		~MappedFile();
+
+	///	maps the given file. A previously mapped file is released first.
+		void open(const char* filename);
+
+	///	releases the mapping
+		void close();
+
+		bool is_open() const				{return m_data != NULL || m_bEmpty;}
+
+	///	start of the mapped contents. NULL if the file is empty or not open.
+		const char* data() const			{return m_data;}
+
+	///	size of the mapped file in bytes
+		size_t size() const					{return m_size;}
+
+	private:
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+
+		const char*	m_data;
+		size_t		m_size;
+		bool		m_bEmpty;
+		void*		m_fileHandle;
+		void*		m_mapHandle;
+};
+
+// end group ugbase_common_util
+/// \}
+
+}//	end of namespace
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "../mapped_file.h"
+#include "common/error.h"
+
+namespace ug{
+
+MappedFile::MappedFile() :
+	m_data(NULL), m_size(0), m_bEmpty(false), m_fileHandle(NULL), m_mapHandle(NULL)
+{}
+
+MappedFile::MappedFile(const char* filename) :
+	m_data(NULL), m_size(0), m_bEmpty(false), m_fileHandle(NULL), m_mapHandle(NULL)
+{
+	open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+void MappedFile::open(const char* filename)
+{
+	close();
+
+	int fd = ::open(filename, O_RDONLY);
+	if(fd == -1){
+		UG_THROW("MappedFile: Couldn't open file '" << filename << "': "
+				 << strerror(errno));
+	}
+
+	struct stat st;
+	if(fstat(fd, &st) != 0){
+		int err = errno;
+		::close(fd);
+		UG_THROW("MappedFile: Couldn't determine size of file '" << filename
+				 << "': " << strerror(err));
+	}
+
+	if(st.st_size == 0){
+		::close(fd);
+		m_bEmpty = true;
+		return;
+	}
+
+	void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+//	the mapping stays valid after the descriptor was closed
+	int err = errno;
+	::close(fd);
+	if(p == MAP_FAILED){
+		UG_THROW("MappedFile: Couldn't map file '" << filename << "': "
+				 << strerror(err));
+	}
+
+	m_data = static_cast<const char*>(p);
+	m_size = (size_t)st.st_size;
+}
+
+void MappedFile::close()
+{
+	if(m_data)
+		munmap(const_cast<char*>(m_data), m_size);
+	m_data = NULL;
+	m_size = 0;
+	m_bEmpty = false;
+}
+
+}//	end of namespace
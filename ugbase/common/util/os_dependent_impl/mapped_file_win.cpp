@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include "../mapped_file.h"
+#include "common/error.h"
+
+namespace ug{
+
+MappedFile::MappedFile() :
+	m_data(NULL), m_size(0), m_bEmpty(false), m_fileHandle(NULL), m_mapHandle(NULL)
+{}
+
+MappedFile::MappedFile(const char* filename) :
+	m_data(NULL), m_size(0), m_bEmpty(false), m_fileHandle(NULL), m_mapHandle(NULL)
+{
+	open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+void MappedFile::open(const char* filename)
+{
+	close();
+
+	HANDLE hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+							   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+		UG_THROW("MappedFile: Couldn't open file '" << filename << "'.");
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(hFile, &fileSize)){
+		CloseHandle(hFile);
+		UG_THROW("MappedFile: Couldn't determine size of file '" << filename << "'.");
+	}
+
+	if(fileSize.QuadPart == 0){
+		CloseHandle(hFile);
+		m_bEmpty = true;
+		return;
+	}
+
+	HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(hMap == NULL){
+		CloseHandle(hFile);
+		UG_THROW("MappedFile: Couldn't map file '" << filename << "'.");
+	}
+
+	void* p = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+	if(p == NULL){
+		CloseHandle(hMap);
+		CloseHandle(hFile);
+		UG_THROW("MappedFile: Couldn't map file '" << filename << "'.");
+	}
+
+	m_data = static_cast<const char*>(p);
+	m_size = (size_t)fileSize.QuadPart;
+	m_fileHandle = hFile;
+	m_mapHandle = hMap;
+}
+
+void MappedFile::close()
+{
+	if(m_data)
+		UnmapViewOfFile(m_data);
+	if(m_mapHandle)
+		CloseHandle((HANDLE)m_mapHandle);
+	if(m_fileHandle)
+		CloseHandle((HANDLE)m_fileHandle);
+	m_data = NULL;
+	m_size = 0;
+	m_bEmpty = false;
+	m_fileHandle = NULL;
+	m_mapHandle = NULL;
+}
+
+}//	end of namespace
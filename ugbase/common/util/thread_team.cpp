@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "thread_team.h"
+
+namespace ug{
+
+ThreadTeam::ThreadTeam() :
+	m_jobGeneration(0), m_numBusy(0), m_bStop(false), m_job(NULL), m_func(NULL),
+	m_barrierCount(0), m_barrierGeneration(0)
+{
+}
+
+ThreadTeam::ThreadTeam(size_t numThreads) :
+	m_jobGeneration(0), m_numBusy(0), m_bStop(false), m_job(NULL), m_func(NULL),
+	m_barrierCount(0), m_barrierGeneration(0)
+{
+	set_num_threads(numThreads);
+}
+
+ThreadTeam::~ThreadTeam()
+{
+	stop_workers();
+}
+
+void ThreadTeam::set_num_threads(size_t numThreads)
+{
+	if(numThreads < 1)
+		numThreads = 1;
+	if(numThreads == num_threads())
+		return;
+
+	stop_workers();
+	m_bStop = false;
+	for(size_t t = 1; t < numThreads; ++t)
+		m_vWorker.push_back(std::thread(&ThreadTeam::worker_loop, this, t, m_jobGeneration));
+}
+
+void ThreadTeam::stop_workers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStop = true;
+	}
+	m_cvStart.notify_all();
+	for(size_t i = 0; i < m_vWorker.size(); ++i)
+		m_vWorker[i].join();
+	m_vWorker.clear();
+}
+
+void ThreadTeam::run_job(JobFunc job, const void* func)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = job;
+		m_func = func;
+		m_exception = std::exception_ptr();
+		m_numBusy = m_vWorker.size();
+		++m_jobGeneration;
+	}
+	m_cvStart.notify_all();
+
+	execute(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cvDone.wait(lock, [this]{return m_numBusy == 0;});
+
+	if(m_exception){
+		std::exception_ptr e = m_exception;
+		m_exception = std::exception_ptr();
+		std::rethrow_exception(e);
+	}
+}
+
+void ThreadTeam::execute(size_t threadIndex)
+{
+	try{
+		m_job(m_func, threadIndex);
+	}
+	catch(...){
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(!m_exception)
+			m_exception = std::current_exception();
+	}
+}
+
+void ThreadTeam::worker_loop(size_t threadIndex, size_t lastGeneration)
+{
+	for(;;){
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cvStart.wait(lock, [&]{return m_bStop || m_jobGeneration != lastGeneration;});
+			if(m_bStop)
+				return;
+			lastGeneration = m_jobGeneration;
+		}
+
+		execute(threadIndex);
+
+		bool bLast;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			bLast = (--m_numBusy == 0);
+		}
+		if(bLast)
+			m_cvDone.notify_one();
+	}
+}
+
+void ThreadTeam::barrier()
+{
+	const size_t generation = m_barrierGeneration.load();
+	if(m_barrierCount.fetch_add(1) + 1 == num_threads()){
+		m_barrierCount.store(0);
+		m_barrierGeneration.fetch_add(1);
+	}
+	else{
+		while(m_barrierGeneration.load() == generation)
+			std::this_thread::yield();
+	}
+}
+
+}//	end of namespace
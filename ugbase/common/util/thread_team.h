@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__UTIL__THREAD_TEAM__
+#define __H__UG__COMMON__UTIL__THREAD_TEAM__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	A set of worker threads which is kept alive between parallel regions
+/**
+ * Creating threads for each parallel region costs tens of microseconds per
+ * thread, which often is more than a small region (e.g. one color of a
+ * smoother or one block of elements) takes. A ThreadTeam creates its workers
+ * once and reuses them for all calls to run.
+ *
+ * run(func) calls func(t) on the calling thread (t = 0) and on each worker
+ * (t = 1, ..., num_threads()-1) and returns once all calls returned. Inside
+ * func, barrier() synchronizes all threads of the team. Idle workers sleep on
+ * a condition variable, waiting threads in barrier() yield.
+ *
+ * If func throws, the first exception is rethrown by run. Since the other
+ * threads would wait forever, func must not throw if barrier is used.
+ *
+ * run may only be called by one thread at a time and must not be nested.
+ */
+class ThreadTeam
+{
+	public:
+	///	creates a team consisting of the calling thread only
+		ThreadTeam();
+
+	///	creates a team of numThreads threads (including the calling thread)
+		explicit ThreadTeam(size_t numThreads);
+
+		~ThreadTeam();
+
+	///	sets the number of threads, including the calling thread
+		void set_num_threads(size_t numThreads);
+
+	///	returns the number of threads, including the calling thread
+		size_t num_threads() const			{return m_vWorker.size() + 1;}
+
+	///	calls func(t) on all threads of the team and waits for completion
+		template <typename TFunc>
+		void run(const TFunc& func)
+		{
+			if(m_vWorker.empty()){
+				func(0);
+				return;
+			}
+			run_job(&CallFunc<TFunc>, &func);
+		}
+
+	///	calls func(begin, end, t) on thread t for contiguous ranges of [0, num)
+	/**	Thread t handles [t*num/n, (t+1)*num/n) with n = num_threads(). Empty
+	 * ranges are skipped. Exceptions are rethrown as in run.*/
+		template <typename TFunc>
+		void run_ranges(size_t num, const TFunc& func)
+		{
+			if(num == 0)
+				return;
+			run(RangeCaller<TFunc>(func, num, num_threads()));
+		}
+
+	///	waits until all threads of the team reached the barrier
+	/**	May only be called inside of a function passed to run.*/
+		void barrier();
+
+	private:
+		typedef void (*JobFunc)(const void* func, size_t threadIndex);
+
+		template <typename TFunc>
+		static void CallFunc(const void* func, size_t threadIndex)
+		{
+			(*static_cast<const TFunc*>(func))(threadIndex);
+		}
+
+	///	calls the range function of run_ranges for the range of a thread
+		template <typename TFunc>
+		struct RangeCaller
+		{
+			RangeCaller(const TFunc& f, size_t n, size_t nt)
+				: func(f), num(n), numThreads(nt) {}
+			void operator()(size_t t) const
+			{
+				const size_t begin = t * num / numThreads;
+				const size_t end = (t + 1) * num / numThreads;
+				if(begin < end)
+					func(begin, end, t);
+			}
+			const TFunc& func;
+			size_t num, numThreads;
+		};
+
+		void run_job(JobFunc job, const void* func);
+		void execute(size_t threadIndex);
+		void worker_loop(size_t threadIndex, size_t lastGeneration);
+		void stop_workers();
+
+	//	teams hold threads and are therefore not copyable
+		ThreadTeam(const ThreadTeam&);
+		ThreadTeam& operator=(const ThreadTeam&);
+
+	private:
+		std::vector<std::thread>	m_vWorker;
+
+		std::mutex					m_mutex;
+		std::condition_variable		m_cvStart;
+		std::condition_variable		m_cvDone;
+
+	///	incremented for each job, workers start on a change
+		size_t						m_jobGeneration;
+		size_t						m_numBusy;
+		bool						m_bStop;
+
+		JobFunc						m_job;
+		const void*					m_func;
+		std::exception_ptr			m_exception;
+
+		std::atomic<size_t>			m_barrierCount;
+		std::atomic<size_t>			m_barrierGeneration;
+};
+
+/// \}
+
+}//	end of namespace
+
+#endif
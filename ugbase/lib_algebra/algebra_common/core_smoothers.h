@@ -32,6 +32,9 @@
 
 #ifndef __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
 #define __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
+
+#include <vector>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace ug
@@ -205,6 +208,94 @@ void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const
 	gs_step_UR(A, c, c, relaxFactor);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	gs_step_LL_multi, gs_step_UR_multi, sgs_step_multi
+/**
+ * \brief Gauss-Seidel steps for several defects at once.
+ * These methods compute the same corrections as gs_step_LL, gs_step_UR and sgs_step
+ * for each column of the MultiVectors c and d. Each matrix row is loaded once and
+ * applied to all columns, i.e. the matrix is streamed once for all defects.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c MultiVector of corrections
+ * \param d MultiVector of defects
+ * \sa gs_step_LL, gs_step_UR, sgs_step
+ */
+template<typename Matrix_type, typename MultiVector_type>
+void gs_step_LL_multi(const Matrix_type &A, MultiVector_type &c, const MultiVector_type &d, const number relaxFactor)
+{
+	typedef typename Matrix_type::value_type matrix_block;
+	typedef typename Matrix_type::const_row_iterator const_row_it;
+	typedef typename MultiVector_type::vector_type vector_type;
+
+	const size_t k = c.num_vectors();
+	std::vector<typename vector_type::value_type> s(k);
+
+	const size_t sz = c.size();
+	for (size_t i = 0; i < sz; ++i)
+	{
+		for(size_t e = 0; e < k; ++e)
+			s[e] = d[e][i];
+
+		const const_row_it rowEnd = A.end_row(i);
+		const_row_it it = A.begin_row(i);
+		for(; it != rowEnd && it.index() < i; ++it)
+			for(size_t e = 0; e < k; ++e)
+				MatMultAdd(s[e], 1.0, s[e], -1.0, it.value(), c[e][it.index()]);
+
+		const matrix_block& A_ii = it.index() == i ? it.value() : matrix_block(0);
+		for(size_t e = 0; e < k; ++e)
+			InverseMatMult(c[e][i], relaxFactor, A_ii, s[e]);
+	}
+}
+
+template<typename Matrix_type, typename MultiVector_type>
+void gs_step_UR_multi(const Matrix_type &A, MultiVector_type &c, const MultiVector_type &d, const number relaxFactor)
+{
+	typedef typename MultiVector_type::vector_type vector_type;
+
+	const size_t k = c.num_vectors();
+	std::vector<typename vector_type::value_type> s(k);
+
+	if(c.size() == 0) return;
+	size_t i = c.size()-1;
+	do
+	{
+		for(size_t e = 0; e < k; ++e)
+			s[e] = d[e][i];
+		typename Matrix_type::const_row_iterator diag = A.get_connection(i, i);
+
+		typename Matrix_type::const_row_iterator it = diag; ++it;
+		for(; it != A.end_row(i); ++it)
+			for(size_t e = 0; e < k; ++e)
+				MatMultAdd(s[e], 1.0, s[e], -1.0, it.value(), c[e][it.index()]);
+
+		for(size_t e = 0; e < k; ++e)
+			InverseMatMult(c[e][i], relaxFactor, diag.value(), s[e]);
+	} while(i-- != 0);
+}
+
+template<typename Matrix_type, typename MultiVector_type>
+void sgs_step_multi(const Matrix_type &A, MultiVector_type &c, const MultiVector_type &d, const number relaxFactor)
+{
+	typedef typename MultiVector_type::vector_type vector_type;
+
+	// c1 = (D-L)^{-1} d
+	gs_step_LL_multi(A, c, d, relaxFactor);
+
+	// c2 = D c1
+	typename vector_type::value_type s;
+	for(size_t i = 0; i<c.size(); i++)
+		for(size_t e = 0; e < c.num_vectors(); ++e)
+		{
+			s=c[e][i];
+			MatMult(c[e][i], 1.0, A(i, i), s);
+		}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR_multi(A, c, c, relaxFactor);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //	diag_step
 /**
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MULTI_VECTOR__
+#define __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MULTI_VECTOR__
+
+#include <cmath>
+#include <vector>
+#include "common/assert.h"
+#include "common/error.h"
+#include "common/util/smart_pointer.h"
+#include "lib_algebra/common/operations_vec.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl.h"
+	#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	a block of vectors sharing size and parallel layout
+/**
+ * A MultiVector holds k vectors ("columns") of the same size, e.g. the
+ * solutions or right-hand sides of a system solved for k right-hand sides at
+ * once. Operators, preconditioners and solvers supporting multiple vectors
+ * (see apply_multi) process all columns within one pass over the matrix, so
+ * that the matrix is streamed once for k vectors instead of k times.
+ *
+ * The columns are stored by smart pointers. Therefore a MultiVector can also
+ * be used as view on a subset of the columns of another MultiVector (see
+ * select). Copying is only possible explicitly through clone.
+ *
+ * \tparam	TVector		type of the columns
+ */
+template <typename TVector>
+class MultiVector
+{
+	public:
+		typedef TVector vector_type;
+		typedef MultiVector<TVector> this_type;
+
+	public:
+		MultiVector() {}
+
+	///	creates numVectors columns with the same layout as templ (values are not set)
+		MultiVector(size_t numVectors, const TVector& templ)
+		{
+			resize(numVectors, templ);
+		}
+
+	///	resizes to numVectors columns. New columns are created like templ without values.
+		void resize(size_t numVectors, const TVector& templ)
+		{
+			const size_t oldSize = m_vVec.size();
+			m_vVec.resize(numVectors);
+			for(size_t e = oldSize; e < numVectors; ++e)
+				m_vVec[e] = templ.clone_without_values();
+		}
+
+	///	adds a column
+		void push_back(SmartPtr<TVector> spVec)	{m_vVec.push_back(spVec);}
+
+	///	removes all columns
+		void clear()							{m_vVec.clear();}
+
+	///	number of columns
+		size_t num_vectors() const				{return m_vVec.size();}
+
+	///	size of each column
+		size_t size() const		{return m_vVec.empty() ? 0 : m_vVec[0]->size();}
+
+	///	access to a column
+	///	\{
+		TVector& operator[](size_t e)
+		{
+			UG_ASSERT(e < m_vVec.size(), "MultiVector: invalid column " << e);
+			return *m_vVec[e];
+		}
+		const TVector& operator[](size_t e) const
+		{
+			UG_ASSERT(e < m_vVec.size(), "MultiVector: invalid column " << e);
+			return *m_vVec[e];
+		}
+		SmartPtr<TVector> vector(size_t e)				{return m_vVec[e];}
+		ConstSmartPtr<TVector> vector(size_t e) const	{return m_vVec[e];}
+	///	\}
+
+	///	makes view a MultiVector sharing the columns vInd of this MultiVector
+		void select(this_type& view, const std::vector<size_t>& vInd)
+		{
+			view.m_vVec.resize(vInd.size());
+			for(size_t i = 0; i < vInd.size(); ++i)
+				view.m_vVec[i] = m_vVec[vInd[i]];
+		}
+
+	///	returns a MultiVector with the same layout and values
+		SmartPtr<this_type> clone() const
+		{
+			SmartPtr<this_type> sp = make_sp(new this_type);
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				sp->m_vVec.push_back(m_vVec[e]->clone());
+			return sp;
+		}
+
+	///	returns a MultiVector with the same layout without setting the values
+		SmartPtr<this_type> clone_without_values() const
+		{
+			SmartPtr<this_type> sp = make_sp(new this_type);
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				sp->m_vVec.push_back(m_vVec[e]->clone_without_values());
+			return sp;
+		}
+
+	///	copies the values of all columns of v
+		void assign(const this_type& v)
+		{
+			UG_COND_THROW(v.num_vectors() != num_vectors(),
+						  "MultiVector::assign: number of vectors differs.");
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				*m_vVec[e] = *v.m_vVec[e];
+		}
+
+	///	sets all entries of all columns to w
+		void set(number w)
+		{
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				m_vVec[e]->set(w);
+		}
+
+#ifdef UG_PARALLEL
+	///	sets the storage type of all columns
+		void set_storage_type(uint type)
+		{
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				m_vVec[e]->set_storage_type(type);
+		}
+
+	///	changes the storage type of all columns
+		bool change_storage_type(ParallelStorageType type)
+		{
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				if(!m_vVec[e]->change_storage_type(type))
+					return false;
+			return true;
+		}
+
+	///	returns true if all columns have the storage type
+		bool has_storage_type(uint type) const
+		{
+			for(size_t e = 0; e < m_vVec.size(); ++e)
+				if(!m_vVec[e]->has_storage_type(type))
+					return false;
+			return true;
+		}
+#endif
+
+	private:
+	//	use clone or select instead
+		MultiVector(const this_type&);
+		this_type& operator=(const this_type&);
+
+		std::vector<SmartPtr<TVector> > m_vVec;
+};
+
+
+///	computes res[e] = (a[e], b[e]) for all columns with a single global reduction
+template <typename TVector>
+void MultiVecProd(std::vector<number>& res,
+                  const MultiVector<TVector>& a, const MultiVector<TVector>& b)
+{
+	UG_ASSERT(a.num_vectors() == b.num_vectors(), "MultiVecProd: sizes differ.");
+	const size_t k = a.num_vectors();
+	std::vector<double> resLocal(k, 0.0);
+	for(size_t e = 0; e < k; ++e){
+#ifdef UG_PARALLEL
+	//	additive <-> consistent and unique <-> unique need no communication,
+	//	otherwise the first vector is changed as in ParallelVector::dotprod
+		TVector& ae = const_cast<TVector&>(a[e]);
+		const TVector& be = b[e];
+		if(!((ae.has_storage_type(PST_ADDITIVE) && be.has_storage_type(PST_CONSISTENT))
+			|| (ae.has_storage_type(PST_CONSISTENT) && be.has_storage_type(PST_ADDITIVE))
+			|| (ae.has_storage_type(PST_UNIQUE) && be.has_storage_type(PST_UNIQUE))))
+		{
+			if(ae.has_storage_type(PST_UNIQUE) && be.has_storage_type(PST_ADDITIVE))
+				ae.change_storage_type(PST_CONSISTENT);
+			else
+				ae.change_storage_type(PST_UNIQUE);
+		}
+#endif
+		VecProd(a[e], b[e], resLocal[e]);
+	}
+
+	res.resize(k);
+#ifdef UG_PARALLEL
+	if(k > 0 && !a[0].layouts()->proc_comm().empty()){
+		a[0].layouts()->proc_comm().allreduce(&resLocal.front(), &res.front(),
+		                                      (int)k, PCL_DT_DOUBLE, PCL_RO_SUM);
+		return;
+	}
+#endif
+	for(size_t e = 0; e < k; ++e) res[e] = resLocal[e];
+}
+
+///	computes res[e] = ||a[e]||_2 for all columns with a single global reduction
+template <typename TVector>
+void MultiVecNorm(std::vector<number>& res, const MultiVector<TVector>& a)
+{
+	const size_t k = a.num_vectors();
+	std::vector<double> resLocal(k, 0.0);
+	for(size_t e = 0; e < k; ++e){
+#ifdef UG_PARALLEL
+		if(!const_cast<TVector&>(a[e]).change_storage_type(PST_UNIQUE))
+			UG_THROW("MultiVecNorm: Cannot change ParallelStorageType to unique.");
+#endif
+		VecNormSquaredAdd(a[e], resLocal[e]);
+	}
+
+	res.resize(k);
+#ifdef UG_PARALLEL
+	if(k > 0 && !a[0].layouts()->proc_comm().empty()){
+		std::vector<double> resGlobal(k);
+		a[0].layouts()->proc_comm().allreduce(&resLocal.front(), &resGlobal.front(),
+		                                      (int)k, PCL_DT_DOUBLE, PCL_RO_SUM);
+		resLocal.swap(resGlobal);
+	}
+#endif
+	for(size_t e = 0; e < k; ++e) res[e] = std::sqrt(resLocal[e]);
+}
+
+///	computes dest[e] = alpha[e]*v1[e] + beta[e]*v2[e] for all columns
+template <typename TVector>
+void MultiVecScaleAdd(MultiVector<TVector>& dest,
+                      const std::vector<number>& alpha, const MultiVector<TVector>& v1,
+                      const std::vector<number>& beta, const MultiVector<TVector>& v2)
+{
+	for(size_t e = 0; e < dest.num_vectors(); ++e)
+		VecScaleAdd(dest[e], alpha[e], v1[e], beta[e], v2[e]);
+}
+
+
+template <typename T> class SparseMatrix;
+#ifdef UG_PARALLEL
+template <typename T> class ParallelMatrix;
+#endif
+
+///	computes res[e] = A*x[e] for all columns
+/**	This is the fallback for matrices without a multi-vector kernel, the
+ * matrix is applied to each column separately.*/
+template <typename TMatrix, typename TVector>
+void MatMultMulti(MultiVector<TVector>& res, TMatrix& A, const MultiVector<TVector>& x)
+{
+	for(size_t e = 0; e < x.num_vectors(); ++e)
+		A.apply(res[e], x[e]);
+}
+
+///	computes res[e] = A*x[e] for all columns within one pass over A
+template <typename T, typename TVector>
+void MatMultMulti(MultiVector<TVector>& res, SparseMatrix<T>& A, const MultiVector<TVector>& x)
+{
+	A.apply_multi(res, x);
+}
+
+#ifdef UG_PARALLEL
+///	computes res[e] = A*x[e] for all columns within one pass over A
+template <typename TMatrix, typename TVector>
+void MatMultMulti(MultiVector<TVector>& res, ParallelMatrix<TMatrix>& A, const MultiVector<TVector>& x)
+{
+	A.apply_multi(res, x);
+}
+#endif
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MULTI_VECTOR__ */
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstring>
+#include <fstream>
+#include "matrix_io_binary.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/parallel_file.h"
+#endif
+
+namespace ug
+{
+
+static const char* const BinaryAlgebraMagic = "UG4ALGB";
+static const uint32_t BinaryAlgebraByteOrder = 0x01020304;
+static const uint64_t BinaryAlgebraAlignment = 64;
+
+static uint64_t AlignBinaryOffset(uint64_t offset)
+{
+	return (offset + BinaryAlgebraAlignment - 1) / BinaryAlgebraAlignment
+			* BinaryAlgebraAlignment;
+}
+
+static BinaryAlgebraFileHeader
+CreateBinaryAlgebraHeader(BinaryAlgebraContent content, size_t valueSize,
+						  size_t blockRows, size_t blockCols, size_t numSections)
+{
+	BinaryAlgebraFileHeader h;
+	memset(&h, 0, sizeof(h));
+	strcpy(h.magic, BinaryAlgebraMagic);
+	h.version = BinaryAlgebraFileVersion;
+	h.content = content;
+	h.byteOrder = BinaryAlgebraByteOrder;
+	h.valueSize = (uint32_t)valueSize;
+	h.blockRows = (uint32_t)blockRows;
+	h.blockCols = (uint32_t)blockCols;
+	h.numSections = numSections;
+	return h;
+}
+
+///	offset of the first data block in a file with the given number of sections
+static uint64_t BinaryAlgebraDataStart(size_t numSections)
+{
+	return AlignBinaryOffset(sizeof(BinaryAlgebraFileHeader)
+							 + numSections * sizeof(BinaryAlgebraSection));
+}
+
+///	fills the section record with the offsets of the data blocks, starting at the given offset
+/**	returns the offset behind the last data block (aligned).*/
+static uint64_t
+LayoutBinaryAlgebraSection(BinaryAlgebraSection& secOut,
+						   const BinaryAlgebraSectionData& data,
+						   size_t valueSize, uint64_t offset)
+{
+	memset(&secOut, 0, sizeof(secOut));
+	secOut.numRows = data.numRows;
+	secOut.numCols = data.numCols;
+	secOut.nnz = data.nnz;
+	secOut.storageMask = data.storageMask;
+	secOut.layoutSize = data.layoutSize;
+
+	if(data.rowStart){
+		secOut.rowStartOffset = offset;
+		offset = AlignBinaryOffset(offset + (data.numRows + 1) * sizeof(int64_t));
+		secOut.colIndOffset = offset;
+		offset = AlignBinaryOffset(offset + data.nnz * sizeof(int32_t));
+	}
+
+	secOut.valueOffset = offset;
+	offset = AlignBinaryOffset(offset + data.nnz * valueSize);
+
+	if(data.layoutSize > 0){
+		secOut.layoutOffset = offset;
+		offset = AlignBinaryOffset(offset + data.layoutSize * sizeof(int64_t));
+	}
+	return offset;
+}
+
+///	calls write(offset, data, size) for each data block of the section
+template <class TWriter>
+static void WriteBinaryAlgebraBlocks(TWriter& writer, const BinaryAlgebraSection& sec,
+									 const BinaryAlgebraSectionData& data, size_t valueSize)
+{
+	if(data.rowStart){
+		writer.write_at(sec.rowStartOffset, data.rowStart, (data.numRows + 1) * sizeof(int64_t));
+		writer.write_at(sec.colIndOffset, data.colInd, data.nnz * sizeof(int32_t));
+	}
+	writer.write_at(sec.valueOffset, data.values, data.nnz * valueSize);
+	if(data.layoutSize > 0)
+		writer.write_at(sec.layoutOffset, data.layout, data.layoutSize * sizeof(int64_t));
+}
+
+
+namespace{
+///	writes blocks at increasing offsets into a local file, filling gaps with zeros
+class SequentialBinaryWriter
+{
+	public:
+		SequentialBinaryWriter(const char* filename) : m_pos(0)
+		{
+			m_out.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+			UG_COND_THROW(!m_out, "Couldn't open file '" << filename << "' for writing.");
+		}
+
+		void write_at(uint64_t offset, const void* data, size_t size)
+		{
+			UG_ASSERT(offset >= m_pos, "Blocks have to be written at increasing offsets.");
+			static const char zeros[BinaryAlgebraAlignment] = {0};
+			while(m_pos < offset){
+				size_t num = (size_t)std::min<uint64_t>(offset - m_pos, BinaryAlgebraAlignment);
+				m_out.write(zeros, num);
+				m_pos += num;
+			}
+			if(size > 0)
+				m_out.write(static_cast<const char*>(data), size);
+			m_pos += size;
+			UG_COND_THROW(!m_out, "Writing " << size << " bytes at offset "
+						  << offset << " failed.");
+		}
+
+	private:
+		std::ofstream	m_out;
+		uint64_t		m_pos;
+};
+}//	end of anonymous namespace
+
+
+void WriteBinaryAlgebraFile(const char* filename, BinaryAlgebraContent content,
+							size_t valueSize, size_t blockRows, size_t blockCols,
+							const BinaryAlgebraSectionData& data)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	BinaryAlgebraFileHeader header =
+		CreateBinaryAlgebraHeader(content, valueSize, blockRows, blockCols, 1);
+
+	BinaryAlgebraSection sec;
+	LayoutBinaryAlgebraSection(sec, data, valueSize, BinaryAlgebraDataStart(1));
+
+	SequentialBinaryWriter out(filename);
+	out.write_at(0, &header, sizeof(header));
+	out.write_at(sizeof(header), &sec, sizeof(sec));
+	WriteBinaryAlgebraBlocks(out, sec, data, valueSize);
+}
+
+
+#ifdef UG_PARALLEL
+void WriteBinaryAlgebraFileParallel(const char* filename, BinaryAlgebraContent content,
+									size_t valueSize, size_t blockRows, size_t blockCols,
+									const BinaryAlgebraSectionData& data)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	pcl::ProcessCommunicator pc;
+	const size_t numProcs = pc.size();
+	const size_t rank = pc.get_local_proc_id();
+
+//	size of the local section determines the offsets of all following sections
+	BinaryAlgebraSection sec;
+	uint64_t localSize = LayoutBinaryAlgebraSection(sec, data, valueSize, 0);
+	std::vector<uint64_t> sizes(numProcs);
+	pc.allgather(&localSize, 1, PCL_DT_UNSIGNED_LONG_LONG,
+				 &sizes.front(), 1, PCL_DT_UNSIGNED_LONG_LONG);
+
+	uint64_t offset = BinaryAlgebraDataStart(numProcs);
+	for(size_t i = 0; i < rank; ++i)
+		offset += sizes[i];
+	LayoutBinaryAlgebraSection(sec, data, valueSize, offset);
+
+	std::vector<BinaryAlgebraSection> table(numProcs);
+	pc.allgather(&sec, sizeof(sec), PCL_DT_BYTE,
+				 &table.front(), sizeof(sec), PCL_DT_BYTE);
+
+	pcl::SharedFileWriter out(filename, pc);
+	if(rank == 0){
+		BinaryAlgebraFileHeader header =
+			CreateBinaryAlgebraHeader(content, valueSize, blockRows, blockCols, numProcs);
+		out.write_at(0, &header, sizeof(header));
+		out.write_at(sizeof(header), &table.front(), numProcs * sizeof(BinaryAlgebraSection));
+	}
+	WriteBinaryAlgebraBlocks(out, sec, data, valueSize);
+	out.close();
+}
+
+
+void EncodeAlgebraLayouts(std::vector<int64_t>& dataOut, const AlgebraLayouts& layouts)
+{
+	dataOut.clear();
+	const IndexLayout* vLayouts[] = {&layouts.master(), &layouts.slave()};
+	for(size_t i = 0; i < 2; ++i){
+		const IndexLayout& layout = *vLayouts[i];
+		size_t numInterfacesPos = dataOut.size();
+		dataOut.push_back(0);
+		for(IndexLayout::const_iterator iter = layout.begin(); iter != layout.end(); ++iter)
+		{
+			const IndexLayout::Interface& interface = layout.interface(iter);
+			dataOut.push_back(layout.proc_id(iter));
+			dataOut.push_back(interface.size());
+			for(IndexLayout::Interface::const_iterator iiter = interface.begin();
+				iiter != interface.end(); ++iiter)
+			{
+				dataOut.push_back(interface.get_element(iiter));
+			}
+			++dataOut[numInterfacesPos];
+		}
+	}
+}
+
+void DecodeAlgebraLayouts(AlgebraLayouts& layoutsOut, const int64_t* data, size_t size)
+{
+	layoutsOut.clear();
+	IndexLayout* vLayouts[] = {&layoutsOut.master(), &layoutsOut.slave()};
+	size_t pos = 0;
+	for(size_t i = 0; i < 2; ++i){
+		UG_COND_THROW(pos >= size, "Invalid layout data in binary algebra file.");
+		int64_t numInterfaces = data[pos++];
+		for(int64_t j = 0; j < numInterfaces; ++j){
+			UG_COND_THROW(pos + 2 > size, "Invalid layout data in binary algebra file.");
+			int proc = (int)data[pos++];
+			size_t num = (size_t)data[pos++];
+			UG_COND_THROW(pos + num > size, "Invalid layout data in binary algebra file.");
+			IndexLayout::Interface& interface = vLayouts[i]->interface(proc);
+			for(size_t k = 0; k < num; ++k)
+				interface.push_back((size_t)data[pos++]);
+		}
+	}
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	BinaryAlgebraFile
+void BinaryAlgebraFile::open(const char* filename)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	m_file.open(filename);
+	m_filename = filename;
+
+	UG_COND_THROW(m_file.size() < sizeof(BinaryAlgebraFileHeader),
+				  "'" << filename << "' is not a binary algebra file.");
+
+	const BinaryAlgebraFileHeader& h = header();
+	UG_COND_THROW(strncmp(h.magic, BinaryAlgebraMagic, sizeof(h.magic)) != 0,
+				  "'" << filename << "' is not a binary algebra file.");
+	UG_COND_THROW(h.byteOrder != BinaryAlgebraByteOrder,
+				  "Binary algebra file '" << filename << "' was written with a different byte order.");
+	UG_COND_THROW(h.version > BinaryAlgebraFileVersion,
+				  "Binary algebra file '" << filename << "' has version " << h.version
+				  << ", but only versions up to " << BinaryAlgebraFileVersion << " are supported.");
+
+//	check that the section table and all blocks lie inside the file
+	block(sizeof(BinaryAlgebraFileHeader), h.numSections * sizeof(BinaryAlgebraSection));
+	for(size_t i = 0; i < num_sections(); ++i){
+		const BinaryAlgebraSection& s = section(i);
+		if(h.content == BAC_MATRIX){
+			row_start(i);
+			col_indices(i);
+			block(s.valueOffset, s.nnz * h.valueSize);
+		}
+		else
+			block(s.valueOffset, s.numRows * h.valueSize);
+		layout(i);
+	}
+}
+
+void BinaryAlgebraFile::close()
+{
+	m_file.close();
+	m_filename.clear();
+}
+
+const BinaryAlgebraFileHeader& BinaryAlgebraFile::header() const
+{
+	UG_COND_THROW(!m_file.data(), "BinaryAlgebraFile: no file opened.");
+	return *reinterpret_cast<const BinaryAlgebraFileHeader*>(m_file.data());
+}
+
+const BinaryAlgebraSection& BinaryAlgebraFile::section(size_t i) const
+{
+	UG_COND_THROW(i >= num_sections(), "Section " << i << " requested, but binary algebra file '"
+				  << m_filename << "' only contains " << num_sections() << " sections.");
+	return reinterpret_cast<const BinaryAlgebraSection*>
+			(m_file.data() + sizeof(BinaryAlgebraFileHeader))[i];
+}
+
+void BinaryAlgebraFile::check_content(BinaryAlgebraContent content, size_t valueSize,
+									  size_t blockRows, size_t blockCols) const
+{
+	const BinaryAlgebraFileHeader& h = header();
+	UG_COND_THROW(h.content != (uint32_t)content,
+				  "Binary algebra file '" << m_filename << "' contains a "
+				  << (h.content == BAC_MATRIX ? "matrix" : "vector") << ".");
+	UG_COND_THROW(h.valueSize != valueSize || h.blockRows != blockRows
+				  || h.blockCols != blockCols,
+				  "Binary algebra file '" << m_filename << "' contains " << h.blockRows
+				  << "x" << h.blockCols << " block values of " << h.valueSize
+				  << " bytes, but " << blockRows << "x" << blockCols << " blocks of "
+				  << valueSize << " bytes are expected.");
+}
+
+const int64_t* BinaryAlgebraFile::row_start(size_t i) const
+{
+	const BinaryAlgebraSection& s = section(i);
+	return reinterpret_cast<const int64_t*>
+			(block(s.rowStartOffset, (s.numRows + 1) * sizeof(int64_t)));
+}
+
+const int32_t* BinaryAlgebraFile::col_indices(size_t i) const
+{
+	const BinaryAlgebraSection& s = section(i);
+	return reinterpret_cast<const int32_t*>(block(s.colIndOffset, s.nnz * sizeof(int32_t)));
+}
+
+const int64_t* BinaryAlgebraFile::layout(size_t i) const
+{
+	const BinaryAlgebraSection& s = section(i);
+	if(s.layoutSize == 0)
+		return NULL;
+	return reinterpret_cast<const int64_t*>
+			(block(s.layoutOffset, s.layoutSize * sizeof(int64_t)));
+}
+
+const char* BinaryAlgebraFile::block(uint64_t offset, uint64_t size) const
+{
+//	empty blocks at the end of a file may start behind its last byte
+	if(size == 0)
+		return NULL;
+	UG_COND_THROW(offset > m_file.size() || size > m_file.size() - offset,
+				  "Binary algebra file '" << m_filename << "' is truncated or corrupt.");
+	return m_file.data() + offset;
+}
+
+} // namespace ug
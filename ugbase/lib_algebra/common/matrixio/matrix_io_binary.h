@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__MATRIX_IO_BINARY_H
+#define __H__UG__LIB_ALGEBRA__MATRIX_IO_BINARY_H
+
+#include <vector>
+
+#include "common/types.h"
+#include "common/error.h"
+#include "common/util/mapped_file.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/cpu_algebra_types.h"
+
+namespace ug
+{
+
+/// \addtogroup matrixio
+/// \{
+
+/**
+ * \brief Binary container format for sparse matrices and vectors
+ *
+ * Binary algebra files store the raw arrays of matrices in CRS format and of
+ * vectors, so that they can be written and read without any formatting or
+ * parsing. All data blocks are 64 byte aligned, which allows to access them
+ * directly in a memory mapping of the file (see BinaryAlgebraFile).
+ *
+ * A file consists of
+ * - a BinaryAlgebraFileHeader,
+ * - a table of BinaryAlgebraSection records, one per section,
+ * - the data blocks of all sections.
+ *
+ * Files written in serial contain one section. Files written in parallel
+ * contain one section per process, each with the local matrix or vector and
+ * the master- and slave-layouts of the process. All processes write into the
+ * same file.
+ *
+ * Data blocks of a section:
+ * - row start: numRows+1 int64 entries (matrices only),
+ * - column indices: nnz int32 entries (matrices only),
+ * - values: nnz (matrices) or numRows (vectors) block values of valueSize bytes,
+ * - layouts: layoutSize int64 entries, see EncodeAlgebraLayouts.
+ *
+ * Files are written in the byte order of the writing machine. Reading a file
+ * with a different byte order is rejected.
+ */
+enum BinaryAlgebraContent
+{
+	BAC_MATRIX = 1,
+	BAC_VECTOR = 2
+};
+
+///	header at the beginning of each binary algebra file (64 bytes)
+struct BinaryAlgebraFileHeader
+{
+	char		magic[8];		///< "UG4ALGB" (zero terminated)
+	uint32_t	version;		///< format version, see BinaryAlgebraFileVersion
+	uint32_t	content;		///< a value of BinaryAlgebraContent
+	uint32_t	byteOrder;		///< 0x01020304 as written by the writing machine
+	uint32_t	valueSize;		///< size of one (block) value in bytes
+	uint32_t	blockRows;		///< number of rows of a block value
+	uint32_t	blockCols;		///< number of columns of a block value
+	uint64_t	numSections;	///< number of sections (processes)
+	uint64_t	reserved[3];
+};
+
+///	record describing one section of a binary algebra file (72 bytes)
+/**	All offsets are absolute byte offsets in the file. Offsets of blocks
+ * which don't exist are 0.*/
+struct BinaryAlgebraSection
+{
+	uint64_t	numRows;
+	uint64_t	numCols;
+	uint64_t	nnz;			///< number of stored (block) entries
+	uint64_t	storageMask;	///< parallel storage type, PST_UNDEFINED in serial
+	uint64_t	rowStartOffset;
+	uint64_t	colIndOffset;
+	uint64_t	valueOffset;
+	uint64_t	layoutOffset;
+	uint64_t	layoutSize;		///< number of int64 entries of the layout block
+};
+
+///	current version of the binary algebra format
+const uint32_t BinaryAlgebraFileVersion = 1;
+
+
+///	Read-only access to a memory-mapped binary algebra file
+/**	The file is mapped on open and stays mapped until close is called or the
+ * object is destroyed. The arrays returned by the access methods point into
+ * the mapping, so they are only valid while the file is open. The header and
+ * the section table are validated on open. An UGError is thrown if the file is
+ * not a valid binary algebra file.*/
+class BinaryAlgebraFile
+{
+	public:
+		BinaryAlgebraFile()	{}
+		BinaryAlgebraFile(const char* filename)	{open(filename);}
+
+		void open(const char* filename);
+		void close();
+
+		const BinaryAlgebraFileHeader& header() const;
+		size_t num_sections() const		{return (size_t)header().numSections;}
+		const BinaryAlgebraSection& section(size_t i) const;
+
+	///	throws if the file doesn't contain the given content with the given block values
+		void check_content(BinaryAlgebraContent content, size_t valueSize,
+						   size_t blockRows, size_t blockCols) const;
+
+		const int64_t* row_start(size_t i) const;
+		const int32_t* col_indices(size_t i) const;
+		const int64_t* layout(size_t i) const;
+
+		template <typename TValue>
+		const TValue* values(size_t i) const
+		{
+			const BinaryAlgebraSection& s = section(i);
+			size_t num = (header().content == BAC_MATRIX) ? s.nnz : s.numRows;
+			return reinterpret_cast<const TValue*>(block(s.valueOffset, num * sizeof(TValue)));
+		}
+
+	private:
+	///	returns a pointer to the block at the given offset, checking the bounds
+		const char* block(uint64_t offset, uint64_t size) const;
+
+		MappedFile	m_file;
+		std::string	m_filename;
+};
+
+
+///	raw arrays of the local part of a matrix or vector which are to be written
+/**	\sa WriteBinaryAlgebraFile*/
+struct BinaryAlgebraSectionData
+{
+	BinaryAlgebraSectionData() :
+		numRows(0), numCols(0), nnz(0), storageMask(0),
+		rowStart(NULL), colInd(NULL), values(NULL), layout(NULL), layoutSize(0)
+	{}
+
+	uint64_t		numRows;
+	uint64_t		numCols;
+	uint64_t		nnz;
+	uint64_t		storageMask;
+	const int64_t*	rowStart;
+	const int32_t*	colInd;
+	const void*		values;
+	const int64_t*	layout;
+	uint64_t		layoutSize;
+};
+
+///	writes a binary algebra file with one section
+void WriteBinaryAlgebraFile(const char* filename, BinaryAlgebraContent content,
+							size_t valueSize, size_t blockRows, size_t blockCols,
+							const BinaryAlgebraSectionData& data);
+
+#ifdef UG_PARALLEL
+///	writes a binary algebra file with one section per process (collective)
+/**	All processes of pcl::PCD_WORLD write their section into the same file.
+ * The section of a process is given by its rank.*/
+void WriteBinaryAlgebraFileParallel(const char* filename, BinaryAlgebraContent content,
+									size_t valueSize, size_t blockRows, size_t blockCols,
+									const BinaryAlgebraSectionData& data);
+
+///	encodes the horizontal master and slave layouts into a sequence of integers
+/**	For master and slave layout: the number of interfaces, followed by
+ * (proc, numIndices, indices...) for each interface.*/
+void EncodeAlgebraLayouts(std::vector<int64_t>& dataOut, const AlgebraLayouts& layouts);
+
+///	restores the horizontal master and slave layouts encoded by EncodeAlgebraLayouts
+void DecodeAlgebraLayouts(AlgebraLayouts& layoutsOut, const int64_t* data, size_t size);
+#endif
+
+
+namespace matrixio_binary_detail
+{
+
+template <typename TValue>
+void SetMatrixData(BinaryAlgebraSectionData& data, std::vector<int64_t>& rowStart,
+				   const SparseMatrix<TValue>& A)
+{
+	const size_t numRows = A.num_rows();
+	const int* pRowStart = NULL;
+	const int* pColInd = NULL;
+	const TValue* pValues = NULL;
+
+	rowStart.assign(numRows + 1, 0);
+	if(numRows > 0 && A.num_cols() > 0){
+		A.get_crs_arrays(pRowStart, pColInd, pValues);
+		for(size_t i = 0; i <= numRows; ++i)
+			rowStart[i] = pRowStart[i];
+	}
+
+	data.numRows = numRows;
+	data.numCols = A.num_cols();
+	data.nnz = (uint64_t)rowStart[numRows];
+	data.rowStart = &rowStart[0];
+	data.colInd = pColInd;
+	data.values = pValues;
+}
+
+template <typename TValue>
+void GetMatrixData(SparseMatrix<TValue>& A, const BinaryAlgebraFile& file, size_t section)
+{
+	const BinaryAlgebraSection& s = file.section(section);
+	const int64_t* rowStart = file.row_start(section);
+	UG_COND_THROW(rowStart[0] != 0 || (uint64_t)rowStart[s.numRows] != s.nnz,
+				  "Invalid row start array in section " << section << " of binary matrix file.");
+
+	A.set_crs(s.numRows, s.numCols, rowStart, file.col_indices(section),
+			  file.values<TValue>(section));
+}
+
+template <typename TValue>
+void SetVectorData(BinaryAlgebraSectionData& data, const Vector<TValue>& v)
+{
+	data.numRows = v.size();
+	data.numCols = 1;
+	data.nnz = v.size();
+	data.values = v.size() > 0 ? &v[0] : NULL;
+}
+
+template <typename TValue>
+void GetVectorData(Vector<TValue>& v, const BinaryAlgebraFile& file, size_t section)
+{
+	const BinaryAlgebraSection& s = file.section(section);
+	if(v.size() != s.numRows)
+		v.resize(s.numRows, false);
+
+	const TValue* values = file.values<TValue>(section);
+	for(size_t i = 0; i < s.numRows; ++i)
+		v[i] = values[i];
+}
+
+#ifdef UG_PARALLEL
+template <typename TObject>
+void SetParallelData(BinaryAlgebraSectionData& data, std::vector<int64_t>& layout,
+					 const TObject& obj)
+{
+	data.storageMask = obj.get_storage_mask();
+	EncodeAlgebraLayouts(layout, *obj.layouts());
+	data.layout = layout.empty() ? NULL : &layout[0];
+	data.layoutSize = layout.size();
+}
+
+template <typename TObject>
+void GetParallelData(TObject& obj, const BinaryAlgebraFile& file, size_t section)
+{
+	const BinaryAlgebraSection& s = file.section(section);
+	obj.set_storage_type((uint)s.storageMask);
+
+	if(obj.layouts()->master().empty() && obj.layouts()->slave().empty()
+		&& s.layoutSize > 0)
+	{
+		SmartPtr<AlgebraLayouts> spLayouts(new AlgebraLayouts);
+		DecodeAlgebraLayouts(*spLayouts, file.layout(section), (size_t)s.layoutSize);
+		obj.set_layouts(spLayouts);
+	}
+}
+
+inline size_t LocalSection(const BinaryAlgebraFile& file)
+{
+	UG_COND_THROW(file.num_sections() != (size_t)pcl::NumProcs(),
+				  "Binary algebra file contains " << file.num_sections()
+				  << " sections, but running on " << pcl::NumProcs() << " processes.");
+	return (size_t)pcl::ProcRank();
+}
+#endif
+
+}//	end of namespace matrixio_binary_detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	serial matrices and vectors
+
+///	writes the given matrix to a binary algebra file
+/**	Only matrices with fixed size block values are supported. The matrix is
+ * defragmented before writing.*/
+template <typename TValue>
+void WriteMatrixBinary(const char* filename, const SparseMatrix<TValue>& A)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!block_traits<TValue>::is_static,
+				  "WriteMatrixBinary: Only fixed size block values are supported.");
+
+	std::vector<int64_t> rowStart;
+	BinaryAlgebraSectionData data;
+	matrixio_binary_detail::SetMatrixData(data, rowStart, A);
+	WriteBinaryAlgebraFile(filename, BAC_MATRIX, sizeof(TValue),
+						   block_traits<TValue>::static_num_rows,
+						   block_traits<TValue>::static_num_cols, data);
+}
+
+///	reads a matrix from a binary algebra file
+/**	The arrays of the given section are copied from the memory mapped file into
+ * the matrix, no parsing is involved.*/
+template <typename TValue>
+void ReadMatrixBinary(const char* filename, SparseMatrix<TValue>& A, size_t section = 0)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!block_traits<TValue>::is_static,
+				  "ReadMatrixBinary: Only fixed size block values are supported.");
+
+	BinaryAlgebraFile file(filename);
+	file.check_content(BAC_MATRIX, sizeof(TValue),
+					   block_traits<TValue>::static_num_rows,
+					   block_traits<TValue>::static_num_cols);
+	matrixio_binary_detail::GetMatrixData(A, file, section);
+}
+
+///	writes the given vector to a binary algebra file
+/**	Only vectors with fixed size block values are supported.*/
+template <typename TValue>
+void WriteVectorBinary(const char* filename, const Vector<TValue>& v)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!block_traits<TValue>::is_static,
+				  "WriteVectorBinary: Only fixed size block values are supported.");
+
+	BinaryAlgebraSectionData data;
+	matrixio_binary_detail::SetVectorData(data, v);
+	WriteBinaryAlgebraFile(filename, BAC_VECTOR, sizeof(TValue),
+						   block_traits<TValue>::static_size, 1, data);
+}
+
+///	reads a vector from a binary algebra file
+/**	The vector is resized to the size stored in the file.*/
+template <typename TValue>
+void ReadVectorBinary(const char* filename, Vector<TValue>& v, size_t section = 0)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!block_traits<TValue>::is_static,
+				  "ReadVectorBinary: Only fixed size block values are supported.");
+
+	BinaryAlgebraFile file(filename);
+	file.check_content(BAC_VECTOR, sizeof(TValue), block_traits<TValue>::static_size, 1);
+	matrixio_binary_detail::GetVectorData(v, file, section);
+}
+
+#ifdef UG_PARALLEL
+////////////////////////////////////////////////////////////////////////////////
+//	parallel matrices and vectors
+
+///	writes the local parts of a parallel matrix into one shared file (collective)
+/**	Each process writes its local matrix, its storage type and its master- and
+ * slave-layouts into its own section of the file.*/
+template <typename TMatrix>
+void WriteMatrixBinary(const char* filename, const ParallelMatrix<TMatrix>& A)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename TMatrix::value_type value_type;
+	UG_COND_THROW(!block_traits<value_type>::is_static,
+				  "WriteMatrixBinary: Only fixed size block values are supported.");
+
+	std::vector<int64_t> rowStart, layout;
+	BinaryAlgebraSectionData data;
+	matrixio_binary_detail::SetMatrixData(data, rowStart, A);
+	matrixio_binary_detail::SetParallelData(data, layout, A);
+	WriteBinaryAlgebraFileParallel(filename, BAC_MATRIX, sizeof(value_type),
+								   block_traits<value_type>::static_num_rows,
+								   block_traits<value_type>::static_num_cols, data);
+}
+
+///	reads the local part of a parallel matrix from a shared file
+/**	The file has to contain one section per process. The storage type is
+ * restored. The layouts stored in the file are only used if the matrix
+ * has no master- and slave-layouts yet.*/
+template <typename TMatrix>
+void ReadMatrixBinary(const char* filename, ParallelMatrix<TMatrix>& A)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename TMatrix::value_type value_type;
+	UG_COND_THROW(!block_traits<value_type>::is_static,
+				  "ReadMatrixBinary: Only fixed size block values are supported.");
+
+	BinaryAlgebraFile file(filename);
+	file.check_content(BAC_MATRIX, sizeof(value_type),
+					   block_traits<value_type>::static_num_rows,
+					   block_traits<value_type>::static_num_cols);
+	size_t section = matrixio_binary_detail::LocalSection(file);
+	matrixio_binary_detail::GetMatrixData(A, file, section);
+	matrixio_binary_detail::GetParallelData(A, file, section);
+}
+
+///	writes the local parts of a parallel vector into one shared file (collective)
+template <typename TVector>
+void WriteVectorBinary(const char* filename, const ParallelVector<TVector>& v)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename TVector::value_type value_type;
+	UG_COND_THROW(!block_traits<value_type>::is_static,
+				  "WriteVectorBinary: Only fixed size block values are supported.");
+
+	std::vector<int64_t> layout;
+	BinaryAlgebraSectionData data;
+	matrixio_binary_detail::SetVectorData(data, v);
+	matrixio_binary_detail::SetParallelData(data, layout, v);
+	WriteBinaryAlgebraFileParallel(filename, BAC_VECTOR, sizeof(value_type),
+								   block_traits<value_type>::static_size, 1, data);
+}
+
+///	reads the local part of a parallel vector from a shared file
+/**	\sa ReadMatrixBinary(const char*, ParallelMatrix<TMatrix>&)*/
+template <typename TVector>
+void ReadVectorBinary(const char* filename, ParallelVector<TVector>& v)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename TVector::value_type value_type;
+	UG_COND_THROW(!block_traits<value_type>::is_static,
+				  "ReadVectorBinary: Only fixed size block values are supported.");
+
+	BinaryAlgebraFile file(filename);
+	file.check_content(BAC_VECTOR, sizeof(value_type), block_traits<value_type>::static_size, 1);
+	size_t section = matrixio_binary_detail::LocalSection(file);
+	matrixio_binary_detail::GetVectorData(v, file, section);
+	matrixio_binary_detail::GetParallelData(v, file, section);
+}
+#endif
+
+// end group matrixio
+/// \}
+
+} // namespace ug
+
+#endif // __H__UG__LIB_ALGEBRA__MATRIX_IO_BINARY_H
@@ -35,6 +35,7 @@
 
 #include <stddef.h> // size_t
 #include <cmath> // log, exp
+#include <vector>
 
 namespace ug
 {
@@ -194,6 +195,28 @@ inline double VecProd(const vector_t &a, const vector_t &b)
 }
 
 
+//! calculates res[k] = scal<a, *vs[k]> for all k within a single pass over a
+template<typename vector_t>
+inline void VecProdMulti(const vector_t &a, const std::vector<const vector_t*> &vs,
+                         std::vector<double> &res)
+{
+	res.assign(vs.size(), 0.0);
+	for(size_t i=0; i<a.size(); i++)
+		for(size_t k=0; k<vs.size(); k++)
+			VecProdAdd(a[i], (*vs[k])[i], res[k]);
+}
+
+//! calculates dest += sum_k alpha[k] * (*vs[k]) within a single pass over dest
+template<typename vector_t>
+inline void VecScaleAppendMulti(vector_t &dest, const std::vector<double> &alpha,
+                                const std::vector<const vector_t*> &vs)
+{
+	for(size_t i=0; i<dest.size(); i++)
+		for(size_t k=0; k<vs.size(); k++)
+			VecScaleAdd(dest[i], 1.0, dest[i], alpha[k], (*vs[k])[i]);
+}
+
+
 //! calculates s += norm_2^2(a)
 template<typename vector_t>
 inline void VecNormSquaredAdd(const vector_t &a, double &sum)
@@ -168,6 +168,20 @@ public:
 			const number &alpha1, const vector_t &v1,
 			const number &beta1, const vector_t &w1) const;
 
+	//! calculate dest[e] = alpha1*v1[e] + beta1*A*w1[e] for all columns e of a MultiVector
+	/** The matrix is traversed once for all columns. dest must not share columns with w1.*/
+	template<typename multi_vector_t>
+	void axpy_multi(multi_vector_t &dest,
+			const number &alpha1, const multi_vector_t &v1,
+			const number &beta1, const multi_vector_t &w1) const;
+
+	//! calculate res[e] = A x[e] for all columns e of a MultiVector
+	template<typename multi_vector_t>
+	void apply_multi(multi_vector_t &res, const multi_vector_t &x) const
+	{
+		axpy_multi(res, 0.0, res, 1.0, x);
+	}
+
 	//! calculated dest = beta1*A*w1 . For empty rows, dest will not be changed
 	template<typename vector_t>
 	void apply_ignore_zero_rows(vector_t &dest,
@@ -639,6 +653,35 @@ public:
 		nnz = total_num_connections();
 	}
 
+	/**
+	 * returns pointers to the arrays of the defragmented matrix in CRS format.
+	 * note that these are only valid as long as the matrix is not modified.
+	 * @param pRowStart	(out) row i is from pRowStart[i] to pRowStart[i+1]
+	 * @param pColInd	(out) pColInd[i] is colum index of nonzero i
+	 * @param pValues	(out) pValues[i] is the value of nonzero i
+	 */
+	void get_crs_arrays(const int *&pRowStart, const int *&pColInd,
+			const value_type *&pValues) const
+	{
+		defragment();
+		pRowStart = &rowStart[0];
+		pColInd = cols.empty() ? NULL : &cols[0];
+		pValues = values.empty() ? NULL : &values[0];
+	}
+
+	/**
+	 * sets the matrix from arrays in CRS format. the column indices of
+	 * each row have to be sorted.
+	 * @param numRows   	num rows of the matrix
+	 * @param numCols		num cols of the matrix
+	 * @param pRowStart		row i is from pRowStart[i] to pRowStart[i+1], pRowStart[0] = 0
+	 * @param pColInd		pColInd[i] is colum index of nonzero i
+	 * @param pValues		pValues[i] is the value of nonzero i
+	 */
+	template<typename TRowIndex>
+	void set_crs(size_t numRows, size_t numCols, const TRowIndex *pRowStart,
+			const int *pColInd, const value_type *pValues);
+
 	/**
 	 * assigns a reference to the values vector to argument vector
 	 * 
@@ -138,6 +138,39 @@ void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 }
 
 
+template<typename T>
+template<typename TRowIndex>
+void SparseMatrix<T>::set_crs(size_t numRows, size_t numCols,
+		const TRowIndex *pRowStart, const int *pColInd, const value_type *pValues)
+{
+	PROFILE_SPMATRIX(SparseMatrix_set_crs);
+	UG_ASSERT(iIterators == 0, "set_crs while using iterators.");
+	const size_t newNNZ = (size_t)pRowStart[numRows];
+
+	rowStart.resize(numRows+1);
+	rowMax.resize(numRows);
+	rowEnd.resize(numRows);
+	for(size_t r=0; r<numRows; ++r)
+	{
+		rowStart[r] = (int)pRowStart[r];
+		rowEnd[r] = rowMax[r] = (int)pRowStart[r+1];
+	}
+	rowStart[numRows] = (int)newNNZ;
+	m_numCols = numCols;
+
+	cols.assign(pColInd, pColInd + newNNZ);
+	if(bNeedsValues) values.assign(pValues, pValues + newNNZ);
+	nnz = newNNZ;
+	maxValues = newNNZ;
+	fragmented = 0;
+
+#ifdef CHECK_ROW_ITERATORS
+	nrOfRowIterators.clear();
+	nrOfRowIterators.resize(numRows, 0);
+#endif
+}
+
+
 template<typename T>
 void SparseMatrix<T>::clear_retain_structure()
 {
@@ -338,6 +371,54 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	}
 }
 
+// calculate dest[e] = alpha1*v1[e] + beta1*A*w1[e] for all columns e
+template<typename T>
+template<typename multi_vector_t>
+void SparseMatrix<T>::axpy_multi(multi_vector_t &dest,
+		const number &alpha1, const multi_vector_t &v1,
+		const number &beta1, const multi_vector_t &w1) const
+{
+	PROFILE_SPMATRIX(SparseMatrix_axpy_multi);
+	check_fragmentation();
+	typedef typename multi_vector_t::vector_type vector_t;
+
+	const size_t k = dest.num_vectors();
+	UG_ASSERT(w1.num_vectors() == k && (alpha1 == 0.0 || v1.num_vectors() == k),
+			  "number of vectors differs");
+	if(k == 0) return;
+
+//	resolve the columns once, the row loop below only touches raw vectors
+	std::vector<vector_t*> pDest(k);
+	std::vector<const vector_t*> pV1(k), pW1(k);
+	for(size_t e = 0; e < k; ++e){
+		pDest[e] = &dest[e];
+		pW1[e] = &w1[e];
+		pV1[e] = (alpha1 == 0.0) ? pDest[e] : &v1[e];
+	}
+
+	for(size_t i=0; i < num_rows(); i++)
+	{
+		for(size_t e = 0; e < k; ++e){
+			if(alpha1 == 0.0)
+				(*pDest[e])[i] = 0.0;
+			else if(pDest[e] != pV1[e])
+				VecScaleAssign((*pDest[e])[i], alpha1, (*pV1[e])[i]);
+			else if(alpha1 != 1.0)
+				(*pDest[e])[i] *= alpha1;
+		}
+
+	//	each matrix entry is loaded once and applied to all columns
+		const size_t itEnd = rowEnd[i];
+		for(size_t conn = rowStart[i]; conn < itEnd; ++conn)
+		{
+			const value_type &a = values[conn];
+			const size_t j = cols[conn];
+			for(size_t e = 0; e < k; ++e)
+				MatMultAdd((*pDest[e])[i], 1.0, (*pDest[e])[i], beta1, a, (*pW1[e])[j]);
+		}
+	}
+}
+
 // calculate dest = alpha1*v1 + beta1*A^T*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
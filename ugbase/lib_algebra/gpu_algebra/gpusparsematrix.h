@@ -210,6 +210,15 @@ public:
 			return axpy(res, 1.0, res, -1.0, x);
 		}
 
+		//! calculate res[e] = A x[e] for all columns of a MultiVector (one SpMV per column)
+		template<typename multi_vector_t>
+		bool apply_multi(multi_vector_t &res, const multi_vector_t &x) const
+		{
+			for(size_t e = 0; e < x.num_vectors(); ++e)
+				if(!apply(res[e], x[e])) return false;
+			return true;
+		}
+
 
 
 	/**
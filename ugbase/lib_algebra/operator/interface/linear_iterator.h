@@ -35,6 +35,7 @@
 
 #include "lib_algebra/operator/damping.h"
 #include "common/util/smart_pointer.h"
+#include "lib_algebra/algebra_common/multi_vector.h"
 
 namespace ug{
 
@@ -151,6 +152,24 @@ class ILinearIterator
 	 */
 		virtual bool apply_update_defect(Y& c, X& d) = 0;
 
+	///	compute new corrections c[e] = B*d[e] for several defects at once
+	/**
+	 * This method applies the iterator to all columns of d, e.g. when a system
+	 * is solved for several right-hand sides. The default implementation calls
+	 * apply for each column. Iterators that can process all columns within
+	 * one pass over their data (matrix, factorization) overwrite this method.
+	 *
+	 * \param[in]	d		defects
+	 * \param[out]	c		corrections
+	 * \returns		bool	success flag
+	 */
+		virtual bool apply_multi(MultiVector<Y>& c, const MultiVector<X>& d)
+		{
+			for(size_t e = 0; e < d.num_vectors(); ++e)
+				if(!apply(c[e], d[e])) return false;
+			return true;
+		}
+
 	///	sets a scaling for the correction
 	/**
 	 * Sets a scaling for the correction, i.e., once the correction has been
@@ -34,6 +34,7 @@
 #define __H__LIB_ALGEBRA__OPERATOR__INTERFACE__LINEAR_OPERATOR__
 
 #include "operator.h"
+#include "lib_algebra/algebra_common/multi_vector.h"
 
 namespace ug{
 
@@ -138,6 +139,22 @@ class ILinearOperator : public IOperator<X,Y>
 	 */
 		virtual void apply_sub(Y& f, const X& u) = 0;
 
+	// 	applies the operator to several functions
+	/**
+	 * This method applies the operator to all columns of u, i.e.
+	 * f[e] = L*u[e]. The default implementation calls apply for each column.
+	 * Matrix based operators overwrite it in order to traverse the matrix
+	 * only once for all columns.
+	 *
+	 * \param[in]	u		domain functions
+	 * \param[out]	f		codomain functions
+	 */
+		virtual void apply_multi(MultiVector<Y>& f, const MultiVector<X>& u)
+		{
+			for(size_t e = 0; e < u.num_vectors(); ++e)
+				apply(f[e], u[e]);
+		}
+
 	/// virtual	destructor
 		virtual ~ILinearOperator() {};
 };
@@ -70,6 +70,12 @@ class MatrixOperator :	public virtual ILinearOperator<X,Y>,
 	// 	Apply Operator, i.e. f = f - L*u;
 		virtual void apply_sub(Y& f, const X& u) {matrix_type::matmul_minus(f,u);}
 
+	// 	Apply Operator to several functions, f[e] = L*u[e] (one pass over the matrix)
+		virtual void apply_multi(MultiVector<Y>& f, const MultiVector<X>& u)
+		{
+			MatMultMulti(f, get_matrix(), u);
+		}
+
 	// 	Access to matrix
 		virtual M& get_matrix() {return *this;};
 };
@@ -174,6 +174,26 @@ class IPreconditioner :
 	 */
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)  = 0;
 
+	///	computes new corrections c[e] = B*d[e] for several defects
+	/**
+	 * This method computes the corrections for all columns of d. The default
+	 * implementation calls 'step' for each column. Preconditioners whose
+	 * application traverses a matrix or factorization overwrite this method in
+	 * order to process all columns within one traversal.
+	 *
+	 * \param[in]	mat			underlying matrix (i.e. L in L*u = f)
+	 * \param[out]	c			corrections
+	 * \param[in]	d			defects
+	 * \returns		bool		success flag
+	 */
+		virtual bool step_multi(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                        MultiVector<vector_type>& c, const MultiVector<vector_type>& d)
+		{
+			for(size_t e = 0; e < d.num_vectors(); ++e)
+				if(!step(pOp, c[e], d[e])) return false;
+			return true;
+		}
+
 	///	cleans the operator
 		virtual bool postprocess() = 0;
 
@@ -325,6 +345,65 @@ class IPreconditioner :
 			return true;
 		}
 
+	///	compute new corrections c[e] = B*d[e] for several defects
+	/**
+	 * This method implements the virtual method of the ILinearIterator-interface.
+	 * Basically, besides some common checks the request is forwarded to the
+	 * (virtual) 'step_multi'-method.
+	 *
+	 * \param[out]	c		corrections
+	 * \param[in]	d		defects
+	 * \returns		bool	success flag
+	 */
+		virtual bool apply_multi(MultiVector<vector_type>& c, const MultiVector<vector_type>& d)
+		{
+		//	Check that operator is initialized
+			if(!m_bInit)
+			{
+				UG_LOG("ERROR in '"<<name()<<"::apply_multi': Iterator not initialized.\n");
+				return false;
+			}
+
+		//	Check number of vectors, parallel status and sizes
+			THROW_IF_NOT_EQUAL(c.num_vectors(), d.num_vectors());
+			for(size_t e = 0; e < d.num_vectors(); ++e)
+			{
+				#ifdef UG_PARALLEL
+				if(!d[e].has_storage_type(PST_ADDITIVE))
+					UG_THROW(name() << "::apply_multi: Wrong parallel "
+					               "storage format. Defects must be additive.");
+				#endif
+				THROW_IF_NOT_EQUAL_4(c[e].size(), d[e].size(),
+						m_spApproxOperator->num_rows(), m_spApproxOperator->num_cols());
+			}
+
+		// 	apply iterator: c[e] = B*d[e]
+			if(!step_multi(m_spApproxOperator, c, d))
+			{
+				UG_LOG("ERROR in '"<<name()<<"::apply_multi': Step Routine failed.\n");
+				return false;
+			}
+
+			for(size_t e = 0; e < c.num_vectors(); ++e)
+			{
+			//	apply scaling
+				const number kappa = damping()->damping(c[e], d[e], m_spApproxOperator);
+				if(kappa != 1.0){
+					c[e] *= kappa;
+				}
+
+			//	Correction is always consistent
+				#ifdef UG_PARALLEL
+				if(!c[e].change_storage_type(PST_CONSISTENT))
+					UG_THROW(name() << "::apply_multi': Cannot change "
+							"parallel storage type of correction to consistent.");
+				#endif
+			}
+
+		//	we're done
+			return true;
+		}
+
 	///	compute new correction c = B*d and update defect d:= d - L*c
 	/**
 	 * This method implements the virtual method of the ILinearIterator-interface.
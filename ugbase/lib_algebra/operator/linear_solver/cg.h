@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__OPERATOR__LINEAR_SOLVER__CG__
 
 #include <iostream>
+#include <sstream>
 #include <string>
 
 #include "lib_algebra/operator/interface/operator.h"
@@ -240,6 +241,136 @@ class CG
 		//	post output
 			return convergence_check()->post();
 		}
+
+	///	Solve J(u)*x[e] = b[e] for several right-hand sides (pseudo-block CG)
+	/**
+	 * Performs an independent CG iteration for each column. The iterations
+	 * share the applications of the operator and the preconditioner, such that
+	 * the matrix is traversed once per iteration for all columns, and the
+	 * global reductions of the scalar products. Each column is checked by its
+	 * own clone of the convergence check and leaves the iteration when it
+	 * has converged.
+	 */
+		virtual bool apply_multi(MultiVector<vector_type>& x, const MultiVector<vector_type>& b)
+		{
+			PROFILE_BEGIN_GROUP(CG_apply_multi, "CG algebra");
+			typedef MultiVector<vector_type> multi_vector_type;
+
+			const size_t k = b.num_vectors();
+			THROW_IF_NOT_EQUAL(x.num_vectors(), k);
+			if(k == 0) return true;
+
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("CG::apply_multi: Inadequate storage format of Vectors.");
+			#endif
+
+		//	create help vectors
+			SmartPtr<multi_vector_type> spR = b.clone(); multi_vector_type& r = *spR;
+			SmartPtr<multi_vector_type> spQ = b.clone_without_values(); multi_vector_type& q = *spQ;
+			SmartPtr<multi_vector_type> spZ = x.clone_without_values(); multi_vector_type& z = *spZ;
+			SmartPtr<multi_vector_type> spP = x.clone_without_values(); multi_vector_type& p = *spP;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_multi(q, x);
+			for(size_t e = 0; e < k; ++e)
+				VecScaleAdd(r[e], 1.0, r[e], -1.0, q[e]);
+
+		// 	Preconditioning
+			if(!precondition_multi(z, r)) return false;
+
+		//	one convergence check per column
+			prepare_conv_check();
+			std::vector<SmartPtr<IConvergenceCheck<vector_type> > > vConvCheck(k);
+			for(size_t e = 0; e < k; ++e)
+			{
+				std::stringstream ss; ss << name() << " [rhs " << e << "]";
+				vConvCheck[e] = convergence_check()->clone();
+				vConvCheck[e]->set_name(ss.str());
+				vConvCheck[e]->start(r[e]);
+			}
+
+		// 	start search directions and rho
+			p.assign(z);
+			std::vector<number> rhoOld(k), vProd;
+			MultiVecProd(rhoOld, z, r);
+
+		//	columns that are still iterated and views on them
+			std::vector<size_t> vActive;
+			for(size_t e = 0; e < k; ++e)
+				if(!vConvCheck[e]->iteration_ended()) vActive.push_back(e);
+			multi_vector_type pA, qA, rA, zA;
+
+		// 	Iteration loop
+			while(!vActive.empty())
+			{
+			// 	Build q = A*p (q is additive afterwards)
+				p.select(pA, vActive); q.select(qA, vActive);
+				linear_operator()->apply_multi(qA, pA);
+
+			// 	lambda = (q,p)
+				MultiVecProd(vProd, qA, pA);
+
+				std::vector<size_t> vStillActive;
+				for(size_t a = 0; a < vActive.size(); ++a)
+				{
+					const size_t e = vActive[a];
+					number lambda = vProd[a];
+
+				//	check lambda (see apply_return_defect)
+					if(lambda == 0.0)
+					{
+						if (p[e].size())
+						{
+							UG_LOG("ERROR in 'CG::apply_multi': lambda=" <<
+								lambda<< " is not admitted for rhs " << e
+								<< ". Aborting solver.\n");
+							return false;
+						}
+						else
+							lambda = 1.0;
+					}
+
+				//	alpha = rho / (q,p)
+					const number alpha = rhoOld[e]/lambda;
+
+				// 	Update x := x + alpha*p, r := r - alpha*q
+					VecScaleAdd(x[e], 1.0, x[e], alpha, p[e]);
+					VecScaleAdd(r[e], 1.0, r[e], -alpha, q[e]);
+
+				// 	Check convergence
+					vConvCheck[e]->update(r[e]);
+					if(!vConvCheck[e]->iteration_ended())
+						vStillActive.push_back(e);
+				}
+				vActive.swap(vStillActive);
+				if(vActive.empty()) break;
+
+			// 	Preconditioning
+				r.select(rA, vActive); z.select(zA, vActive);
+				if(!precondition_multi(zA, rA)) return false;
+
+			// 	new rho = (z,r)
+				MultiVecProd(vProd, zA, rA);
+
+				for(size_t a = 0; a < vActive.size(); ++a)
+				{
+					const size_t e = vActive[a];
+
+				// 	new direction p := beta * p + z, beta = rho / rhoOld
+					const number beta = vProd[a]/rhoOld[e];
+					VecScaleAdd(p[e], beta, p[e], 1.0, z[e]);
+					rhoOld[e] = vProd[a];
+				}
+			}
+
+		//	post output
+			bool bConverged = true;
+			for(size_t e = 0; e < k; ++e)
+				bConverged = vConvCheck[e]->post() && bConverged;
+			return bConverged;
+		}
 		
 	///	adds a post-process for the iterates
 		void add_postprocess_corr (SmartPtr<IPProcessVector<vector_type> > p)
@@ -270,6 +401,31 @@ class CG
 			convergence_check()->set_info(s);
 		}
 
+	///	computes z[e] = M^-1 * r[e], makes z consistent and post-processes it
+		bool precondition_multi(MultiVector<vector_type>& z, const MultiVector<vector_type>& r)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply_multi(z, r))
+				{
+					UG_LOG("ERROR in 'CG::apply_multi': "
+							"Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else z.assign(r);
+
+			#ifdef UG_PARALLEL
+			if(!z.change_storage_type(PST_CONSISTENT))
+				UG_THROW("CG::apply_multi: "
+								"Cannot convert z to consistent vector.");
+			#endif
+
+			for(size_t e = 0; e < z.num_vectors(); ++e)
+				m_corr_post_process.apply (z[e]);
+			return true;
+		}
+
 	/// debugger output: solution and residual
 		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
 		{
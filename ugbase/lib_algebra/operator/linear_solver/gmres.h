@@ -58,6 +58,15 @@ namespace ug{
  *
  * - Saad, "Iterative Methods For Sparse Linear Systems"
  *
+ * By default the Arnoldi basis is orthogonalized by modified Gram-Schmidt,
+ * which needs j+2 global reductions in iteration j. With
+ * set_classical_gram_schmidt(true) classical Gram-Schmidt is used instead:
+ * all projections and the norm are computed by one multi-dot product with a
+ * single fused reduction. To retain the stability of modified Gram-Schmidt,
+ * a second orthogonalization pass is performed whenever the norm drops below
+ * 1/sqrt(2) of its previous value (Daniel, Gragg, Kaufman, Stewart), which
+ * is rarely the case.
+ *
  * \tparam 	TVector		vector type
  */
 template <typename TVector>
@@ -79,13 +88,13 @@ class GMRES
 
 	public:
 	///	default constructor
-		GMRES(size_t restart) : m_restart(restart) {};
+		GMRES(size_t restart) : m_restart(restart), m_bCGS(false) {};
 
 	///	constructor setting the preconditioner and the convergence check
 		GMRES( size_t restart,
 		       SmartPtr<ILinearIterator<vector_type> > spPrecond,
 		       SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
-			: base_type(spPrecond, spConvCheck), m_restart(restart)
+			: base_type(spPrecond, spConvCheck), m_restart(restart), m_bCGS(false)
 		{};
 
 	///	name of solver
@@ -204,19 +213,25 @@ class GMRES
 				//	post-process the correction
 					m_corr_post_process.apply (*v[j+1]);
 
-				//	loop previous steps
-					for(size_t i = 0; i <= j; ++i)
+				//	orthogonalize v[j+1] against the previous vectors and
+				//	compute h_{j+1,j}
+					if(m_bCGS)
+						orthogonalize_classical(v, h, j);
+					else
 					{
-					//	h_ij := (r, v[j])
-						h[i][j] = VecProd(*v[j+1], *v[i]);
+					//	loop previous steps
+						for(size_t i = 0; i <= j; ++i)
+						{
+						//	h_ij := (r, v[j])
+							h[i][j] = VecProd(*v[j+1], *v[i]);
+
+						//	v[j+1] -= h_ij * v[i]
+							VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+						}
 
-					//	v[j+1] -= h_ij * v[i]
-						VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+						h[j+1][j] = v[j+1]->norm();
 					}
 
-				//	compute h_{j+1,j}
-					h[j+1][j] = v[j+1]->norm();
-
 				//	update h
 					for(size_t i = 0; i < j; ++i)
 					{
@@ -279,11 +294,212 @@ class GMRES
 			return convergence_check()->post();
 		}
 
+	// 	Solve J(u)*x[e] = b[e] for several right-hand sides (pseudo-block GMRES)
+	/**
+	 * Performs an independent restarted GMRES iteration for each column. The
+	 * iterations share the applications of the operator and the
+	 * preconditioner, such that the matrix is traversed once per Arnoldi step
+	 * for all columns, and the global reductions of the (modified)
+	 * Gram-Schmidt orthogonalization. Each column is checked by its own clone
+	 * of the convergence check and leaves the iteration at the next restart
+	 * after it has converged.
+	 */
+		virtual bool apply_multi(MultiVector<vector_type>& x, const MultiVector<vector_type>& b)
+		{
+			typedef MultiVector<vector_type> multi_vector_type;
+
+			const size_t k = b.num_vectors();
+			THROW_IF_NOT_EQUAL(x.num_vectors(), k);
+			if(k == 0) return true;
+
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("GMRES: Inadequate storage format of Vectors.");
+			#endif
+
+		// 	build defect:  r := b - A*x
+			SmartPtr<multi_vector_type> spR = b.clone(); multi_vector_type& r = *spR;
+			SmartPtr<multi_vector_type> spT = b.clone_without_values(); multi_vector_type& t = *spT;
+			linear_operator()->apply_multi(t, x);
+			for(size_t e = 0; e < k; ++e)
+				VecScaleAdd(r[e], 1.0, r[e], -1.0, t[e]);
+
+		//	one convergence check per column
+			prepare_conv_check();
+			std::vector<SmartPtr<IConvergenceCheck<vector_type> > > vConvCheck(k);
+			for(size_t e = 0; e < k; ++e)
+			{
+				std::stringstream ss; ss << name() << " [rhs " << e << "]";
+				vConvCheck[e] = convergence_check()->clone();
+				vConvCheck[e]->set_name(ss.str());
+				vConvCheck[e]->start(r[e]);
+			}
+
+		//	storage for v and, per column, h, gamma, c, s
+			std::vector<SmartPtr<multi_vector_type> > v(m_restart+1);
+			for(size_t j = 0; j < v.size(); ++j) v[j] = x.clone_without_values();
+			std::vector<std::vector<std::vector<number> > > h(k,
+					std::vector<std::vector<number> >(m_restart+1, std::vector<number>(m_restart+1)));
+			std::vector<std::vector<number> > gamma(k, std::vector<number>(m_restart+1));
+			std::vector<std::vector<number> > c(k, std::vector<number>(m_restart+1));
+			std::vector<std::vector<number> > s(k, std::vector<number>(m_restart+1));
+			std::vector<number> oldNorm(k), vProd;
+
+		//	columns that are still iterated and views on them
+			std::vector<size_t> vActive;
+			for(size_t e = 0; e < k; ++e)
+				if(!vConvCheck[e]->iteration_ended()) vActive.push_back(e);
+			std::vector<SmartPtr<multi_vector_type> > vA(m_restart+1);
+			for(size_t j = 0; j < vA.size(); ++j) vA[j] = make_sp(new multi_vector_type);
+			multi_vector_type rA, tA, xA;
+
+		// 	Iteration loop
+			while(!vActive.empty())
+			{
+				const size_t numActive = vActive.size();
+				for(size_t j = 0; j < vA.size(); ++j) v[j]->select(*vA[j], vActive);
+				r.select(rA, vActive); t.select(tA, vActive); x.select(xA, vActive);
+
+			// 	apply v[0] = M^-1 * (b-A*x)
+				if(!precondition_multi(*vA[0], rA, "b-A*x0")) return false;
+
+			// 	compute norm of initial residuum and normalize v[0]
+				MultiVecNorm(vProd, *vA[0]);
+				for(size_t a = 0; a < numActive; ++a){
+					oldNorm[a] = gamma[vActive[a]][0] = vProd[a];
+					(*vA[0])[a] *= 1./vProd[a];
+				}
+
+			//	loop gmres iterations
+				for(size_t j = 0; j < m_restart; ++j)
+				{
+					multi_vector_type& vj = *vA[j];
+					multi_vector_type& vj1 = *vA[j+1];
+
+#ifdef UG_PARALLEL
+					if(!vj.change_storage_type(PST_CONSISTENT))
+						UG_THROW("GMRES: Cannot convert v["<<j<<"] to consistent vector.");
+#endif
+
+				// 	apply v[j+1] = M^-1 * A * v[j]
+					linear_operator()->apply_multi(tA, vj);
+					if(!precondition_multi(vj1, tA, "A*v[j]")) return false;
+
+					#ifdef UG_PARALLEL
+					if(!vj.change_storage_type(PST_UNIQUE))
+						UG_THROW("GMRES: Cannot convert v["<<j<<"] to unique vector.");
+					#endif
+
+				//	modified Gram-Schmidt, the projections of all columns
+				//	share one reduction
+					for(size_t i = 0; i <= j; ++i)
+					{
+						MultiVecProd(vProd, vj1, *vA[i]);
+						for(size_t a = 0; a < numActive; ++a){
+							h[vActive[a]][i][j] = vProd[a];
+							VecScaleAppend(vj1[a], (*vA[i])[a], (-1)*vProd[a]);
+						}
+					}
+					MultiVecNorm(vProd, vj1);
+
+					for(size_t a = 0; a < numActive; ++a)
+					{
+						const size_t e = vActive[a];
+						std::vector<std::vector<number> >& he = h[e];
+						he[j+1][j] = vProd[a];
+
+					//	update h
+						for(size_t i = 0; i < j; ++i)
+						{
+							const number hij = he[i][j];
+							const number hi1j = he[i+1][j];
+
+							he[i][j]   =  c[e][i+1]*hij + s[e][i+1]*hi1j;
+							he[i+1][j] =  s[e][i+1]*hij - c[e][i+1]*hi1j;
+						}
+
+					//	alpha := sqrt(h_jj ^2 + h_{j+1,j}^2)
+						const number alpha = sqrt(he[j][j]*he[j][j] + he[j+1][j]*he[j+1][j]);
+
+					//	update s, c
+						s[e][j+1] = he[j+1][j] / alpha;
+						c[e][j+1] = he[j][j]   / alpha;
+						he[j][j] = alpha;
+
+					//	compute new norm
+						gamma[e][j+1] = s[e][j+1]*gamma[e][j];
+						gamma[e][j] = c[e][j+1]*gamma[e][j];
+
+						if(preconditioner().valid()) {
+							UG_LOG(std::string(vConvCheck[e]->get_offset(),' '));
+							UG_LOG("% GMRES [rhs " << e << "] " <<std::setw(4) <<j+1<<": "
+								   << gamma[e][j+1] << "    " << gamma[e][j+1] / oldNorm[a]);
+							UG_LOG(" (in Precond-Norm) \n");
+							oldNorm[a] = gamma[e][j+1];
+						}
+						else{
+							vConvCheck[e]->update_defect(gamma[e][j+1]);
+						}
+
+					//	normalize v[j+1]
+						vj1[a] *= 1./(he[j+1][j]);
+					}
+				}
+
+			//	compute current x
+				for(size_t a = 0; a < numActive; ++a)
+				{
+					const size_t e = vActive[a];
+					const size_t numIter = m_restart-1;
+					for(size_t i = numIter; ; --i){
+						for(size_t j = i+1; j <= numIter; ++j)
+							gamma[e][i] -= h[e][i][j] * gamma[e][j];
+
+						gamma[e][i] /= h[e][i][i];
+
+					//	x = x + gamma[i] * v[i]
+						VecScaleAppend(xA[a], (*vA[i])[a], gamma[e][i]);
+
+						if(i == 0) break;
+					}
+				}
+
+			//	compute fresh defect: r := b - A*x
+				#ifdef UG_PARALLEL
+				if(!xA.change_storage_type(PST_CONSISTENT))
+					UG_THROW("GMRES: Cannot convert x to consistent vector.");
+				#endif
+				linear_operator()->apply_multi(tA, xA);
+				std::vector<size_t> vStillActive;
+				for(size_t a = 0; a < numActive; ++a)
+				{
+					const size_t e = vActive[a];
+					rA[a] = b[e];
+					VecScaleAdd(rA[a], 1.0, rA[a], -1.0, tA[a]);
+
+					if(preconditioner().valid())
+						vConvCheck[e]->update(rA[a]);
+					if(!vConvCheck[e]->iteration_ended())
+						vStillActive.push_back(e);
+				}
+				vActive.swap(vStillActive);
+			}
+
+		//	print ending output
+			bool bConverged = true;
+			for(size_t e = 0; e < k; ++e)
+				bConverged = vConvCheck[e]->post() && bConverged;
+			return bConverged;
+		}
+
 	public:
 		virtual std::string config_string() const
 		{
 			std::stringstream ss;
-			ss << "GMRes ( restart = " << m_restart << ")\n";
+			ss << "GMRes ( restart = " << m_restart;
+			if(m_bCGS) ss << ", classical Gram-Schmidt";
+			ss << ")\n";
 			ss << base_type::config_string_preconditioner_convergence_check();
 			return ss.str();
 		}
@@ -300,6 +516,9 @@ class GMRES
 			m_corr_post_process.remove (p);
 		}
 
+	///	sets if classical Gram-Schmidt with a single reduction per iteration is used
+		void set_classical_gram_schmidt(bool bCGS) {m_bCGS = bCGS;}
+
 	protected:
 	///	prepares the output of the convergence check
 		void prepare_conv_check()
@@ -317,10 +536,81 @@ class GMRES
 			convergence_check()->set_info(s);
 		}
 
+	///	computes v = M^-1 * r (or copies r), makes v unique and post-processes it
+		bool precondition_multi(MultiVector<vector_type>& v, const MultiVector<vector_type>& r,
+		                        const char* what)
+		{
+			if(preconditioner().valid()){
+				if(!preconditioner()->apply_multi(v, r)){
+					UG_LOG("GMRES: Cannot apply preconditioner to " << what << ".\n");
+					return false;
+				}
+			}
+			else v.assign(r);
+
+			#ifdef UG_PARALLEL
+			if(!v.change_storage_type(PST_UNIQUE))
+				UG_THROW("GMRES: Cannot convert vector to unique vector.");
+			#endif
+
+			for(size_t e = 0; e < v.num_vectors(); ++e)
+				m_corr_post_process.apply (v[e]);
+			return true;
+		}
+
+	///	orthogonalizes v[j+1] by classical Gram-Schmidt
+	/**	The projections h_ij = (v[j+1], v[i]), i=0..j, and the norm of v[j+1] are
+	 * computed by one multi-dot product (one reduction). The norm after the
+	 * update is obtained as ||w||^2 - sum_i h_ij^2. A second pass is only
+	 * performed, if this norm dropped below 1/sqrt(2) of the norm before.*/
+		void orthogonalize_classical(std::vector<SmartPtr<vector_type> >& v,
+		                             std::vector<std::vector<number> >& h,
+		                             size_t j)
+		{
+			vector_type& w = *v[j+1];
+
+		//	v[0], ..., v[j] and w itself (for its norm)
+			std::vector<const vector_type*> vs(j+2);
+			for(size_t i = 0; i <= j+1; ++i) vs[i] = v[i].get();
+			std::vector<const vector_type*> basis(vs.begin(), vs.begin() + j+1);
+
+			std::vector<double> proj;
+			std::vector<double> alpha(j+1);
+			number normSq = 0;
+			for(size_t i = 0; i <= j; ++i) h[i][j] = 0;
+
+			for(int pass = 0; pass < 2; ++pass)
+			{
+				VecProdMulti(w, vs, proj);
+
+			//	w -= sum_i (w, v[i]) v[i]
+				number projSq = 0;
+				for(size_t i = 0; i <= j; ++i){
+					h[i][j] += proj[i];
+					alpha[i] = -proj[i];
+					projSq += proj[i]*proj[i];
+				}
+				VecScaleAppendMulti(w, alpha, basis);
+
+				const number wNormSq = proj[j+1];
+				normSq = wNormSq - projSq;
+
+			//	no cancellation: w is orthogonal to working precision
+				if(normSq > 0.5 * wNormSq) break;
+			}
+
+		//	the norm computed from the projections is not reliable anymore
+			if(normSq <= 0) h[j+1][j] = w.norm();
+			else h[j+1][j] = sqrt(normSq);
+		}
+
 	protected:
 	///	restart parameter
 		size_t m_restart;
 
+	///	flag if classical Gram-Schmidt is used for the orthogonalization
+		bool m_bCGS;
+
 	///	postprocessor for the correction in the iterations
 		/**
 		 * These postprocess operations are applied to the preconditioned
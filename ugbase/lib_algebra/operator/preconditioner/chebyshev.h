@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+
+#include <cmath>
+#include <sstream>
+
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/small_algebra/additional_math.h"
+#include "lib_algebra/cpu_algebra/vector.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	Chebyshev polynomial smoother
+/**
+ * The correction c = p(D^{-1} A) D^{-1} d is computed by a Chebyshev iteration
+ * of the given degree for A c = d (starting with c = 0), preconditioned by the
+ * (block) diagonal D of A. The polynomial is chosen to damp the eigenvalues of
+ * D^{-1} A in the interval [lambda_max / ratio, lambda_max], which makes it a
+ * smoother for the upper part of the spectrum.
+ *
+ * The largest eigenvalue of D^{-1} A is estimated in preprocess by a few
+ * steps of the power method (Rayleigh quotient (x, Ax) / (x, Dx)), enlarged by
+ * a safety factor. It may also be prescribed by set_max_eigenvalue.
+ *
+ * Optionally, the L1-Jacobi diagonal is used, i.e. the sum of the absolute
+ * values of the off-diagonal entries of a row is added to the diagonal. This
+ * guarantees lambda_max(D^{-1} A) <= 1 for symmetric positive definite A,
+ * such that degree 1 with ratio 1 (i.e. undamped L1-Jacobi) is convergent.
+ *
+ * A smoothing step only consists of matrix-vector products, diagonal scaling
+ * and vector updates. In parallel, no global reductions are needed, but only
+ * one exchange of interface values per degree (to make the search direction
+ * consistent), just as for the Jacobi method.
+ *
+ *	References:
+ * <ul>
+ * <li> M. Adams, M. Brezina, J. Hu, R. Tuminaro. Parallel multigrid smoothing:
+ *      polynomial versus Gauss-Seidel. J. Comput. Phys. 188 (2003)
+ * <li> Y. Saad. Iterative Methods For Sparse Linear Systems, Alg. 12.1
+ * </ul>
+ */
+template <typename TAlgebra>
+class Chebyshev : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		using base_type::set_debug;
+		using base_type::debug_writer;
+		using base_type::write_debug;
+		using base_type::approx_operator;
+
+	public:
+	///	default constructor
+		Chebyshev() :
+			m_degree(3), m_eigenvalueRatio(30.0), m_numPowerIterations(10),
+			m_safetyFactor(1.1), m_userMaxEigenvalue(0.0), m_bL1(false),
+			m_maxEigenvalue(0.0)
+		{}
+
+	///	constructor setting the degree of the polynomial
+		Chebyshev(size_t degree) :
+			m_degree(degree), m_eigenvalueRatio(30.0), m_numPowerIterations(10),
+			m_safetyFactor(1.1), m_userMaxEigenvalue(0.0), m_bL1(false),
+			m_maxEigenvalue(0.0)
+		{}
+
+	/// clone constructor
+		Chebyshev(const Chebyshev<TAlgebra> &parent) :
+			base_type(parent),
+			m_degree(parent.m_degree),
+			m_eigenvalueRatio(parent.m_eigenvalueRatio),
+			m_numPowerIterations(parent.m_numPowerIterations),
+			m_safetyFactor(parent.m_safetyFactor),
+			m_userMaxEigenvalue(parent.m_userMaxEigenvalue),
+			m_bL1(parent.m_bL1),
+			m_maxEigenvalue(0.0)
+		{}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new Chebyshev<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~Chebyshev() {}
+
+	///	sets the degree of the polynomial, i.e. the number of matrix-vector products per step
+		void set_degree(size_t degree)
+		{
+			UG_COND_THROW(degree == 0, "Chebyshev: degree must be at least 1.");
+			m_degree = degree;
+		}
+
+	///	sets the ratio lambda_max / lambda_min of the damped eigenvalue interval
+		void set_eigenvalue_ratio(number ratio)
+		{
+			UG_COND_THROW(ratio < 1.0, "Chebyshev: eigenvalue ratio must be >= 1.");
+			m_eigenvalueRatio = ratio;
+		}
+
+	///	sets the number of power iterations used to estimate lambda_max
+		void set_num_power_iterations(size_t num)	{m_numPowerIterations = num;}
+
+	///	sets the factor by which the estimated lambda_max is enlarged
+		void set_safety_factor(number factor)		{m_safetyFactor = factor;}
+
+	///	prescribes lambda_max of D^{-1} A. A value <= 0 enables the estimation.
+		void set_max_eigenvalue(number lambda)		{m_userMaxEigenvalue = lambda;}
+
+	///	sets if the L1-Jacobi diagonal is used instead of the diagonal of A
+		void set_l1_jacobi(bool bL1)				{m_bL1 = bL1;}
+
+	///	returns the upper bound of the damped eigenvalue interval used in the last preprocess
+		number max_eigenvalue() const				{return m_maxEigenvalue;}
+
+		virtual std::string config_string() const
+		{
+			std::stringstream ss;
+			ss << "Chebyshev (degree = " << m_degree << ", ratio = "
+			   << m_eigenvalueRatio << (m_bL1 ? ", L1-Jacobi diagonal" : "") << ")";
+			return ss.str();
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "Chebyshev";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_preprocess, "algebra Chebyshev");
+
+			matrix_type &mat = *pOp;
+			const size_t size = mat.num_rows();
+			if(size != mat.num_cols())
+			{
+				UG_LOG("Square Matrix needed for Chebyshev Iteration.\n");
+				return false;
+			}
+
+		//	the (L1-) diagonal of the matrix
+			vector_type diag;
+			diag.resize(size);
+		#ifdef UG_PARALLEL
+			diag.set_layouts(mat.layouts());
+		#endif
+			for(size_t i = 0; i < size; ++i)
+			{
+				typename matrix_type::value_type d = mat(i, i);
+				if(m_bL1)
+				{
+					const matrix_type& A = mat;
+					for(typename matrix_type::const_row_iterator conn = A.begin_row(i);
+						conn != A.end_row(i); ++conn)
+					{
+						if(conn.index() == i) continue;
+						const typename matrix_type::value_type& a = conn.value();
+						for(size_t r = 0; r < GetRows(a); ++r)
+							for(size_t c = 0; c < GetCols(a); ++c)
+								BlockRef(d, r, r) += std::fabs(BlockRef(a, r, c));
+					}
+				}
+				diag[i] = d;
+			}
+
+		//	make diagonal consistent
+		#ifdef UG_PARALLEL
+			diag.set_storage_type(PST_ADDITIVE);
+			diag.change_storage_type(PST_CONSISTENT);
+		#endif
+			if(size > 0 && !CheckVectorInvertible(diag))
+				return false;
+
+			m_diagInv.resize(size);
+			for(size_t i = 0; i < size; ++i)
+				GetInverse(m_diagInv[i], diag[i]);
+
+		//	upper bound of the spectrum of D^{-1} A
+			if(m_userMaxEigenvalue > 0)
+				m_maxEigenvalue = m_userMaxEigenvalue;
+			else
+				m_maxEigenvalue = m_safetyFactor * estimate_max_eigenvalue(pOp, diag);
+
+			m_spR = SPNULL;
+			m_spZ = SPNULL;
+			m_spP = SPNULL;
+			return true;
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_step, "algebra Chebyshev");
+
+			if(m_spR.invalid() || m_spR->size() != d.size())
+			{
+				m_spR = d.clone_without_values();
+				m_spZ = d.clone_without_values();
+				m_spP = d.clone_without_values();
+			}
+			vector_type& r = *m_spR;
+			vector_type& z = *m_spZ;
+			vector_type& p = *m_spP;
+
+		//	center and half width of the damped interval
+			const number lambdaMin = m_maxEigenvalue / m_eigenvalueRatio;
+			const number theta = 0.5 * (m_maxEigenvalue + lambdaMin);
+			const number delta = 0.5 * (m_maxEigenvalue - lambdaMin);
+
+		//	p = 1/theta D^{-1} d, c = p
+			apply_diag_inv(p, d);
+			p *= 1.0 / theta;
+			c = p;
+
+			if(delta <= 0) return true;
+
+			const number sigma = theta / delta;
+			number rho = 1.0 / sigma;
+			for(size_t k = 1; k < m_degree; ++k)
+			{
+			//	r = d - A c
+				r = d;
+				pOp->apply_sub(r, c);
+
+			//	p = rho_new * rho * p + 2 rho_new / delta * D^{-1} r
+				const number rhoNew = 1.0 / (2.0 * sigma - rho);
+				apply_diag_inv(z, r);
+				VecScaleAdd(p, rhoNew * rho, p, 2.0 * rhoNew / delta, z);
+
+			//	c = c + p
+				VecScaleAdd(c, 1.0, c, 1.0, p);
+				rho = rhoNew;
+			}
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	computes the consistent vector c = D^{-1} d for an additive d
+		void apply_diag_inv(vector_type& c, const vector_type& d)
+		{
+			for(size_t i = 0; i < m_diagInv.size(); ++i)
+				MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+
+		#ifdef UG_PARALLEL
+			c.set_storage_type(PST_ADDITIVE);
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW(name() << ": Cannot change parallel storage type to consistent.");
+		#endif
+		}
+
+	///	estimates the largest eigenvalue of D^{-1} A by the power method
+		number estimate_max_eigenvalue(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                               const vector_type& diag)
+		{
+			PROFILE_FUNC_GROUP("algebra Chebyshev");
+
+			const size_t size = diag.size();
+			SmartPtr<vector_type> spX = diag.clone_without_values();
+			SmartPtr<vector_type> spAX = diag.clone_without_values();
+			SmartPtr<vector_type> spDX = diag.clone_without_values();
+			vector_type& x = *spX;
+			vector_type& ax = *spAX;
+			vector_type& dx = *spDX;
+
+			x.set_random(-1.0, 1.0);
+
+			number lambda = 0;
+			for(size_t iter = 0; iter < m_numPowerIterations; ++iter)
+			{
+			//	Rayleigh quotient (x, Ax) / (x, Dx), with x consistent
+				pOp->apply(ax, x);
+				for(size_t i = 0; i < size; ++i)
+					MatMult(dx[i], 1.0, diag[i], x[i]);
+			#ifdef UG_PARALLEL
+				dx.set_storage_type(PST_CONSISTENT);
+				dx.change_storage_type(PST_UNIQUE);
+			#endif
+				const number xDx = VecProd(x, dx);
+				if(xDx <= 0) break;
+				lambda = VecProd(x, ax) / xDx;
+
+			//	x = D^{-1} A x / ||D^{-1} A x||
+				apply_diag_inv(x, ax);
+				const number norm = x.norm();
+				if(norm == 0) break;
+				x *= 1.0 / norm;
+			#ifdef UG_PARALLEL
+				x.change_storage_type(PST_CONSISTENT);
+			#endif
+			}
+
+			return lambda;
+		}
+
+	protected:
+	///	type of block-inverse
+		typedef typename block_traits<typename matrix_type::value_type>::inverse_type inverse_type;
+
+	///	inverse of the (L1-) diagonal
+		std::vector<inverse_type> m_diagInv;
+
+	///	degree of the polynomial
+		size_t m_degree;
+
+	///	ratio lambda_max / lambda_min of the damped interval
+		number m_eigenvalueRatio;
+
+	///	number of power iterations for the estimate of lambda_max
+		size_t m_numPowerIterations;
+
+	///	factor applied to the estimated lambda_max
+		number m_safetyFactor;
+
+	///	prescribed lambda_max (estimated if <= 0)
+		number m_userMaxEigenvalue;
+
+	///	flag if L1-Jacobi diagonal is used
+		bool m_bL1;
+
+	///	upper bound of the damped interval
+		number m_maxEigenvalue;
+
+	///	work vectors
+		SmartPtr<vector_type> m_spR, m_spZ, m_spP;
+};
+
+} // end namespace ug
+
+#endif
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__FACTORIZED_PATCHES__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__FACTORIZED_PATCHES__
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "common/util/thread_team.h"
+#include "lib_algebra/small_algebra/small_algebra.h"
+
+namespace ug{
+
+///	Set of index patches of a matrix with cached LU factorizations of the patch matrices
+/**
+ * Block smoothers like Vanka or ElementGaussSeidel solve a small dense system
+ * A_p x_p = (d - A c)_p for every patch p of indices. This class stores the
+ * index lists of all patches and the LU factorizations (with partial pivoting)
+ * of the patch matrices A_p contiguously in memory, such that the matrices
+ * only have to be extracted and factorized once per matrix (in factorize)
+ * and each smoothing step only needs the forward and backward substitutions.
+ *
+ * In addition, the patches can be colored (color), such that two patches
+ * of the same color neither share an index nor are coupled by the matrix.
+ * The patches of one color are then independent and are processed by
+ * several threads in colored_gauss_seidel_step and additive_step. The
+ * threads are created once and synchronized by barriers between the colors.
+ *
+ * Only algebras with a fixed block size are supported (see supported). Users
+ * have to fall back to an uncached patch solve for other algebras.
+ */
+template <typename TAlgebra>
+class FactorizedPatches
+{
+	public:
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	row iterator
+		typedef typename matrix_type::const_row_iterator const_row_iterator;
+
+	///	block size of the algebra
+		static const int blockSize = TAlgebra::blockSize;
+
+	public:
+	///	constructor
+		FactorizedPatches() : m_numThreads(1) {clear();}
+
+	///	returns if the algebra is supported, i.e. if it has a fixed block size
+		static bool supported() {return blockSize > 0;}
+
+	///	removes all patches
+		void clear()
+		{
+			m_vIndOffset.assign(1, 0);
+			m_vInd.clear();
+			m_vLUOffset.clear();
+			m_vLU.clear();
+			m_vPivot.clear();
+			m_vColorOffset.clear();
+			m_vColoredPatch.clear();
+			m_bFactorized = false;
+		}
+
+	///	adds a patch consisting of the algebra indices [begin, end)
+		template <typename TIter>
+		void add_patch(TIter begin, TIter end)
+		{
+			m_vInd.insert(m_vInd.end(), begin, end);
+			m_vIndOffset.push_back(m_vInd.size());
+			m_bFactorized = false;
+		}
+
+	///	returns the number of patches
+		size_t num_patches() const {return m_vIndOffset.size() - 1;}
+
+	///	returns the number of algebra indices of a patch
+		size_t num_indices(size_t p) const {return m_vIndOffset[p+1] - m_vIndOffset[p];}
+
+	///	returns the algebra indices of a patch
+		const size_t* indices(size_t p) const {return &m_vInd[m_vIndOffset[p]];}
+
+	///	returns if the patch matrices are factorized
+		bool factorized() const {return m_bFactorized;}
+
+	///	returns the maximal number of scalar unknowns of a patch
+		size_t max_patch_size() const
+		{
+			size_t maxSize = 1;
+			for(size_t p = 0; p < num_patches(); ++p)
+				maxSize = std::max(maxSize, num_indices(p) * blockSize);
+			return maxSize;
+		}
+
+	///	returns the number of colors (0 if not colored)
+		size_t num_colors() const {return m_vColorOffset.empty() ? 0 : m_vColorOffset.size() - 1;}
+
+	///	sets the number of threads used for colored and additive steps
+		void set_num_threads(size_t numThreads) {m_numThreads = std::max<size_t>(numThreads, 1);}
+
+	///	returns the number of threads
+		size_t num_threads() const {return m_numThreads;}
+
+	///	extracts the patch matrices from A and computes their LU factorizations
+		void factorize(const matrix_type& A)
+		{
+			PROFILE_FUNC_GROUP("algebra FactorizedPatches");
+			UG_COND_THROW(!supported(), "FactorizedPatches: only fixed block sizes supported.");
+
+			const size_t numPatches = num_patches();
+			m_vLUOffset.resize(numPatches + 1);
+			m_vLUOffset[0] = 0;
+			for(size_t p = 0; p < numPatches; ++p){
+				const size_t n = num_indices(p) * blockSize;
+				m_vLUOffset[p+1] = m_vLUOffset[p] + n*n;
+			}
+			m_vLU.assign(m_vLUOffset[numPatches], 0.0);
+			m_vPivot.resize(m_vInd.size() * blockSize);
+
+		//	local index of an algebra index in the current patch
+			std::vector<int> vLocal(A.num_rows(), -1);
+
+			for(size_t p = 0; p < numPatches; ++p)
+			{
+				const size_t numInd = num_indices(p);
+				const size_t* ind = indices(p);
+				const size_t n = numInd * blockSize;
+				number* lu = &m_vLU[m_vLUOffset[p]];
+
+				for(size_t j = 0; j < numInd; ++j)
+					vLocal[ind[j]] = (int)j;
+
+				for(size_t j = 0; j < numInd; ++j)
+					for(const_row_iterator it = A.begin_row(ind[j]); it != A.end_row(ind[j]); ++it)
+					{
+						const int k = vLocal[it.index()];
+						if(k < 0) continue;
+						for(int r = 0; r < blockSize; ++r)
+							for(int c = 0; c < blockSize; ++c)
+								lu[(j*blockSize + r)*n + k*blockSize + c]
+									= BlockRef(it.value(), r, c);
+					}
+
+				for(size_t j = 0; j < numInd; ++j)
+					vLocal[ind[j]] = -1;
+
+				if(!decompose(lu, n, &m_vPivot[m_vIndOffset[p] * blockSize]))
+					UG_THROW("FactorizedPatches: matrix of patch " << p << " with "
+							<< numInd << " indices is singular.");
+			}
+
+			m_bFactorized = true;
+		}
+
+	///	colors the patches such that patches of the same color are independent
+	/**
+	 * Two patches p and q get different colors if they share an index or if
+	 * A couples an index of p to an index of q (or vice versa).
+	 */
+		void color(const matrix_type& A)
+		{
+			PROFILE_FUNC_GROUP("algebra FactorizedPatches");
+
+			const size_t numPatches = num_patches();
+
+		//	patches containing an index (compressed row storage)
+			std::vector<size_t> vPatchOfIndOffset(A.num_rows() + 1, 0);
+			for(size_t i = 0; i < m_vInd.size(); ++i)
+				++vPatchOfIndOffset[m_vInd[i] + 1];
+			for(size_t i = 0; i < A.num_rows(); ++i)
+				vPatchOfIndOffset[i+1] += vPatchOfIndOffset[i];
+			std::vector<size_t> vPatchOfInd(m_vInd.size());
+			{
+				std::vector<size_t> vPos(vPatchOfIndOffset.begin(), vPatchOfIndOffset.end() - 1);
+				for(size_t p = 0; p < numPatches; ++p)
+					for(size_t j = m_vIndOffset[p]; j < m_vIndOffset[p+1]; ++j)
+						vPatchOfInd[vPos[m_vInd[j]]++] = p;
+			}
+
+		//	symmetric patch adjacency
+			std::vector<std::vector<size_t> > vNeighbor(numPatches);
+			for(size_t p = 0; p < numPatches; ++p)
+			{
+				const size_t* ind = indices(p);
+				for(size_t j = 0; j < num_indices(p); ++j)
+				{
+					for(size_t k = vPatchOfIndOffset[ind[j]]; k < vPatchOfIndOffset[ind[j]+1]; ++k)
+						vNeighbor[p].push_back(vPatchOfInd[k]);
+					for(const_row_iterator it = A.begin_row(ind[j]); it != A.end_row(ind[j]); ++it)
+						for(size_t k = vPatchOfIndOffset[it.index()]; k < vPatchOfIndOffset[it.index()+1]; ++k)
+						{
+							vNeighbor[p].push_back(vPatchOfInd[k]);
+							vNeighbor[vPatchOfInd[k]].push_back(p);
+						}
+				}
+			}
+
+		//	greedy coloring
+			std::vector<size_t> vColor(numPatches, (size_t)-1);
+			std::vector<size_t> vUsedBy;
+			size_t numColors = 0;
+			for(size_t p = 0; p < numPatches; ++p)
+			{
+				for(size_t k = 0; k < vNeighbor[p].size(); ++k){
+					const size_t c = vColor[vNeighbor[p][k]];
+					if(c != (size_t)-1) vUsedBy[c] = p;
+				}
+				size_t c = 0;
+				while(c < numColors && vUsedBy[c] == p) ++c;
+				if(c == numColors){++numColors; vUsedBy.push_back((size_t)-1);}
+				vColor[p] = c;
+			}
+
+		//	sort patches by color
+			m_vColorOffset.assign(numColors + 1, 0);
+			for(size_t p = 0; p < numPatches; ++p)
+				++m_vColorOffset[vColor[p] + 1];
+			for(size_t c = 0; c < numColors; ++c)
+				m_vColorOffset[c+1] += m_vColorOffset[c];
+			m_vColoredPatch.resize(numPatches);
+			std::vector<size_t> vPos(m_vColorOffset.begin(), m_vColorOffset.end() - 1);
+			for(size_t p = 0; p < numPatches; ++p)
+				m_vColoredPatch[vPos[vColor[p]]++] = p;
+		}
+
+	///	solves A_p x = b in place for a patch p (x holds b on entry)
+		void solve(size_t p, number* x) const
+		{
+			const size_t n = num_indices(p) * blockSize;
+			const number* lu = &m_vLU[m_vLUOffset[p]];
+			const size_t* pivot = &m_vPivot[m_vIndOffset[p] * blockSize];
+
+			for(size_t i = 0; i < n; ++i)
+				if(pivot[i] != i) std::swap(x[i], x[pivot[i]]);
+
+			for(size_t i = 0; i < n; ++i){
+				number s = x[i];
+				for(size_t k = 0; k < i; ++k) s -= lu[i*n + k] * x[k];
+				x[i] = s;
+			}
+
+			for(size_t i = n; i-- > 0;){
+				number s = x[i];
+				for(size_t k = i+1; k < n; ++k) s -= lu[i*n + k] * x[k];
+				x[i] = s / lu[i*n + i];
+			}
+		}
+
+	///	performs the block correction of one patch
+	/**
+	 * Computes s = (d - A c)_p and updates c_p += relax * A_p^{-1} s. If
+	 * bOverwrite is set, c_p is set to zero before and overwritten by the
+	 * correction.
+	 *
+	 * \param[in]	work	buffer of size >= blockSize * num_indices(p)
+	 */
+		void correct(size_t p, const matrix_type& A, vector_type& c,
+		             const vector_type& d, number relax, number* work,
+		             bool bOverwrite = false) const
+		{
+			const size_t numInd = num_indices(p);
+			const size_t* ind = indices(p);
+
+			if(bOverwrite)
+				for(size_t j = 0; j < numInd; ++j)
+					c[ind[j]] = 0.0;
+
+			for(size_t j = 0; j < numInd; ++j)
+			{
+				typename vector_type::value_type sj = d[ind[j]];
+				for(const_row_iterator it = A.begin_row(ind[j]); it != A.end_row(ind[j]); ++it)
+					MatMultAdd(sj, 1.0, sj, -1.0, it.value(), c[it.index()]);
+				for(int b = 0; b < blockSize; ++b)
+					work[j*blockSize + b] = BlockRef(sj, b);
+			}
+
+			solve(p, work);
+
+			for(size_t j = 0; j < numInd; ++j)
+				for(int b = 0; b < blockSize; ++b)
+					BlockRef(c[ind[j]], b) = (bOverwrite ? 0.0 : BlockRef(c[ind[j]], b))
+											+ relax * work[j*blockSize + b];
+		}
+
+	///	multiplicative (Gauss-Seidel) sweep over all patches in the order they were added
+		void gauss_seidel_step(const matrix_type& A, vector_type& c, const vector_type& d,
+		                       number relax, bool bOverwrite = false)
+		{
+			PROFILE_FUNC_GROUP("algebra FactorizedPatches");
+			UG_COND_THROW(!m_bFactorized, "FactorizedPatches: not factorized.");
+
+			m_vvWork.resize(1);
+			m_vvWork[0].resize(max_patch_size());
+			for(size_t p = 0; p < num_patches(); ++p)
+				correct(p, A, c, d, relax, &m_vvWork[0][0], bOverwrite);
+		}
+
+	///	multiplicative sweep over the colors, the patches of a color are processed in parallel
+	/**
+	 * Since the patches of a color are independent, the result equals a
+	 * sequential Gauss-Seidel sweep over the patches sorted by colors.
+	 */
+		void colored_gauss_seidel_step(const matrix_type& A, vector_type& c,
+		                               const vector_type& d, number relax)
+		{
+			PROFILE_FUNC_GROUP("algebra FactorizedPatches");
+			UG_COND_THROW(!m_bFactorized, "FactorizedPatches: not factorized.");
+			UG_COND_THROW(num_colors() == 0 && num_patches() > 0,
+						  "FactorizedPatches: patches not colored.");
+
+			prepare_work();
+			for_each_patch_by_color(CorrectPatch(*this, A, c, d, relax));
+		}
+
+	///	additive (block-Jacobi) step over all patches: c += relax * sum_p A_p^{-1} d_p
+		void additive_step(vector_type& c, const vector_type& d, number relax)
+		{
+			PROFILE_FUNC_GROUP("algebra FactorizedPatches");
+			UG_COND_THROW(!m_bFactorized, "FactorizedPatches: not factorized.");
+			UG_COND_THROW(num_colors() == 0 && num_patches() > 0,
+						  "FactorizedPatches: patches not colored.");
+
+		//	patches of a color are disjoint, such that c can be updated concurrently
+			prepare_work();
+			for_each_patch_by_color(AddPatch(*this, c, d, relax));
+		}
+
+	protected:
+	///	LU decomposition with partial pivoting of a row-major n x n matrix
+		static bool decompose(number* A, size_t n, size_t* pivot)
+		{
+			for(size_t k = 0; k < n; ++k)
+			{
+				size_t biggest = k;
+				for(size_t i = k+1; i < n; ++i)
+					if(std::fabs(A[i*n + k]) > std::fabs(A[biggest*n + k]))
+						biggest = i;
+				pivot[k] = biggest;
+				if(biggest != k)
+					for(size_t j = 0; j < n; ++j)
+						std::swap(A[k*n + j], A[biggest*n + j]);
+
+				if(A[k*n + k] == 0.0) return false;
+
+				for(size_t i = k+1; i < n; ++i)
+				{
+					const number l = (A[i*n + k] /= A[k*n + k]);
+					for(size_t j = k+1; j < n; ++j)
+						A[i*n + j] -= l * A[k*n + j];
+				}
+			}
+			return true;
+		}
+
+	///	resizes the work buffers of all threads and starts the threads
+		void prepare_work()
+		{
+			m_team.set_num_threads(m_numThreads);
+			m_vvWork.resize(m_numThreads);
+			const size_t maxSize = max_patch_size();
+			for(size_t t = 0; t < m_vvWork.size(); ++t)
+				m_vvWork[t].resize(maxSize);
+		}
+
+	///	calls func(p, work) for all patches, color by color
+	/**	The patches of a color are distributed in contiguous ranges to the
+	 * threads of the team. The threads wait for each other before they
+	 * proceed to the next color.*/
+		template <typename TFunc>
+		void for_each_patch_by_color(const TFunc& func)
+		{
+			if(m_team.num_threads() <= 1){
+				for(size_t i = 0; i < m_vColoredPatch.size(); ++i)
+					func(m_vColoredPatch[i], &m_vvWork[0][0]);
+				return;
+			}
+			m_team.run(ColorSweep<TFunc>(*this, func));
+		}
+
+	///	the part of a colored sweep performed by one thread of the team
+		template <typename TFunc>
+		struct ColorSweep
+		{
+			ColorSweep(FactorizedPatches& patches, const TFunc& func)
+				: m_patches(patches), m_func(func) {}
+			void operator()(size_t t) const
+			{
+				const size_t numThreads = m_patches.m_team.num_threads();
+				number* work = &m_patches.m_vvWork[t][0];
+				for(size_t col = 0; col < m_patches.num_colors(); ++col)
+				{
+					const size_t* patches = &m_patches.m_vColoredPatch[m_patches.m_vColorOffset[col]];
+					const size_t num = m_patches.m_vColorOffset[col+1] - m_patches.m_vColorOffset[col];
+					for(size_t i = t * num / numThreads; i < (t+1) * num / numThreads; ++i)
+						m_func(patches[i], work);
+					m_patches.m_team.barrier();
+				}
+			}
+			FactorizedPatches& m_patches;
+			const TFunc& m_func;
+		};
+
+	///	functor performing the Gauss-Seidel correction of a patch
+		struct CorrectPatch
+		{
+			CorrectPatch(const FactorizedPatches& patches, const matrix_type& A,
+			             vector_type& c, const vector_type& d, number relax)
+				: m_patches(patches), m_A(A), m_c(c), m_d(d), m_relax(relax) {}
+			void operator()(size_t p, number* work) const
+			{
+				m_patches.correct(p, m_A, m_c, m_d, m_relax, work);
+			}
+			const FactorizedPatches& m_patches;
+			const matrix_type& m_A;
+			vector_type& m_c;
+			const vector_type& m_d;
+			number m_relax;
+		};
+
+	///	functor adding the local solution A_p^{-1} d_p of a patch
+		struct AddPatch
+		{
+			AddPatch(const FactorizedPatches& patches, vector_type& c,
+			         const vector_type& d, number relax)
+				: m_patches(patches), m_c(c), m_d(d), m_relax(relax) {}
+			void operator()(size_t p, number* work) const
+			{
+				const size_t numInd = m_patches.num_indices(p);
+				const size_t* ind = m_patches.indices(p);
+				for(size_t j = 0; j < numInd; ++j)
+					for(int b = 0; b < blockSize; ++b)
+						work[j*blockSize + b] = BlockRef(m_d[ind[j]], b);
+				m_patches.solve(p, work);
+				for(size_t j = 0; j < numInd; ++j)
+					for(int b = 0; b < blockSize; ++b)
+						BlockRef(m_c[ind[j]], b) += m_relax * work[j*blockSize + b];
+			}
+			const FactorizedPatches& m_patches;
+			vector_type& m_c;
+			const vector_type& m_d;
+			number m_relax;
+		};
+
+	protected:
+	///	offsets of the patches in m_vInd
+		std::vector<size_t> m_vIndOffset;
+
+	///	algebra indices of all patches
+		std::vector<size_t> m_vInd;
+
+	///	offsets of the patch matrices in m_vLU
+		std::vector<size_t> m_vLUOffset;
+
+	///	LU factors of all patch matrices (row-major)
+		std::vector<number> m_vLU;
+
+	///	row interchanges of the LU factorizations (offsets as blockSize * m_vIndOffset)
+		std::vector<size_t> m_vPivot;
+
+	///	offsets of the colors in m_vColoredPatch
+		std::vector<size_t> m_vColorOffset;
+
+	///	patches sorted by color
+		std::vector<size_t> m_vColoredPatch;
+
+	///	flag if factorization is up to date
+		bool m_bFactorized;
+
+	///	number of threads
+		size_t m_numThreads;
+
+	///	threads used for colored and additive steps
+		ThreadTeam m_team;
+
+	///	work buffers (one per thread)
+		std::vector<std::vector<number> > m_vvWork;
+};
+
+} // end namespace ug
+
+#endif
@@ -159,6 +159,54 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax) = 0;
 
+	///	performs the step for several defects, the default applies step to each column
+		virtual void step_multi(const matrix_type &A, MultiVector<vector_type> &c,
+		                        const MultiVector<vector_type> &d, const number relax)
+		{
+			for(size_t e = 0; e < d.num_vectors(); ++e)
+				step(A, c[e], d[e], relax);
+		}
+
+	//	Stepping routine for several defects
+		virtual bool step_multi(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                        MultiVector<vector_type>& c, const MultiVector<vector_type>& d)
+		{
+			PROFILE_BEGIN_GROUP(GaussSeidel_step_multi, "algebra gaussseidel");
+
+#ifdef UG_PARALLEL
+			if(pcl::NumProcs() > 1)
+			{
+			//	overlap buffers exist for a single vector only
+				if(m_useOverlap)
+					return base_type::step_multi(pOp, c, d);
+
+			//	make defects consistent resp. unique, cf. step
+				SmartPtr<MultiVector<vector_type> > spDtmp = d.clone();
+				spDtmp->change_storage_type(m_bConsistentInterfaces ? PST_CONSISTENT : PST_UNIQUE);
+
+				THROW_IF_NOT_EQUAL_3(c.size(), spDtmp->size(), m_A.num_rows());
+				step_multi(m_A, c, *spDtmp, m_relax);
+
+			//	only master corrections are used
+				c.set_storage_type(PST_UNIQUE);
+				c.change_storage_type(PST_CONSISTENT);
+
+				return true;
+			}
+			else
+#endif
+			{
+				matrix_type &A = *pOp;
+				THROW_IF_NOT_EQUAL_4(c.size(), d.size(), A.num_rows(), A.num_cols());
+
+				step_multi(A, c, d, m_relax);
+#ifdef UG_PARALLEL
+				c.set_storage_type(PST_CONSISTENT);
+#endif
+				return true;
+			}
+		}
+
 	//	Stepping routine
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
 		{
@@ -298,6 +346,13 @@ public:
 		{
 			gs_step_LL(A, c, d, relax);
 		}
+
+	//	Stepping routine for several defects
+		virtual void step_multi(const matrix_type &A, MultiVector<vector_type> &c,
+		                        const MultiVector<vector_type> &d, const number relax)
+		{
+			gs_step_LL_multi(A, c, d, relax);
+		}
 };
 
 /// Gauss-Seidel preconditioner for the 'backward' ordering of the dofs
@@ -343,6 +398,13 @@ public:
 		{
 			gs_step_UR(A, c, d, relax);
 		}
+
+	//	Stepping routine for several defects
+		virtual void step_multi(const matrix_type &A, MultiVector<vector_type> &c,
+		                        const MultiVector<vector_type> &d, const number relax)
+		{
+			gs_step_UR_multi(A, c, d, relax);
+		}
 };
 
 
@@ -377,6 +439,13 @@ public:
 		{
 			sgs_step(A, c, d, relax);
 		}
+
+	//	Stepping routine for several defects
+		virtual void step_multi(const matrix_type &A, MultiVector<vector_type> &c,
+		                        const MultiVector<vector_type> &d, const number relax)
+		{
+			sgs_step_multi(A, c, d, relax);
+		}
 };
 
 } // end namespace ug
@@ -318,6 +318,89 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 	return result;
 }
 
+// solve x[e] = L^-1 b[e] for all columns e within one pass over L
+template<typename Matrix_type, typename MultiVector_type>
+bool invert_L_multi(const Matrix_type &A, MultiVector_type &x, const MultiVector_type &b)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+	typedef typename MultiVector_type::vector_type vector_type;
+
+	const size_t k = x.num_vectors();
+	std::vector<typename vector_type::value_type> s(k);
+	for(size_t i=0; i < x.size(); i++)
+	{
+		for(size_t e = 0; e < k; ++e)
+			s[e] = b[e][i];
+		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			if(it.index() >= i) continue;
+			for(size_t e = 0; e < k; ++e)
+				MatMultAdd(s[e], 1.0, s[e], -1.0, it.value(), x[e][it.index()]);
+		}
+		for(size_t e = 0; e < k; ++e)
+			x[e][i] = s[e];
+	}
+
+	return true;
+}
+
+// solve x[e] = U^-1 * b[e] for all columns e within one pass over U
+// (see invert_U for the treatment of the last row)
+template<typename Matrix_type, typename MultiVector_type>
+bool invert_U_multi(const Matrix_type &A, MultiVector_type &x, const MultiVector_type &b,
+                    const number eps = 1e-8)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+	typedef typename MultiVector_type::vector_type vector_type;
+
+	const size_t k = x.num_vectors();
+	std::vector<typename vector_type::value_type> s(k);
+
+	bool result = true;
+
+	if(x.size() > 0)
+	{
+		size_t i=x.size()-1;
+		for(size_t e = 0; e < k; ++e)
+		{
+			s[e] = b[e][i];
+			if (BlockNorm(A(i,i)) <= eps * BlockNorm(s[e]))
+			{
+				UG_LOG("ILU Warning: Near-zero last diagonal entry "
+						"with norm "<<BlockNorm(A(i,i))<<" in U "
+						"for non-near-zero rhs entry with norm "
+						<< BlockNorm(s[e]) << ". Setting rhs to zero.\n"
+						"NOTE: Reduce 'eps' using e.g. ILU::set_inversion_eps(...) "
+						"to avoid this warning. Current eps: " << eps << ".\n")
+				x[e][i] = 0;
+				result = false;
+			} else {
+				InverseMatMult(x[e][i], 1.0, A(i,i), s[e]);
+			}
+		}
+	}
+	if(x.size() <= 1) return result;
+
+	for(size_t i = x.size()-2; ; --i)
+	{
+		for(size_t e = 0; e < k; ++e)
+			s[e] = b[e][i];
+		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			if(it.index() <= i) continue;
+			for(size_t e = 0; e < k; ++e)
+				MatMultAdd(s[e], 1.0, s[e], -1.0, it.value(), x[e][it.index()]);
+		}
+		for(size_t e = 0; e < k; ++e)
+			InverseMatMult(x[e][i], 1.0, A(i,i), s[e]);
+		if(i == 0) break;
+	}
+
+	return result;
+}
+
 ///	ILU / ILU(beta) preconditioner
 template <typename TAlgebra>
 class ILU : public IPreconditioner<TAlgebra>
@@ -682,6 +765,45 @@ class ILU : public IPreconditioner<TAlgebra>
 			return true;
 		}
 
+	//	Stepping routine for several defects
+	/**	The factorization is traversed once for all defects. Overlaps and
+	 * reorderings use the single vector step for each column.*/
+		virtual bool step_multi(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                        MultiVector<vector_type>& c,
+		                        const MultiVector<vector_type>& d)
+		{
+			PROFILE_BEGIN_GROUP(ILU_step_multi, "algebra ILU");
+
+			if(!(m_spOrderingAlgo.invalid() || m_bSortIsIdentity))
+				return base_type::step_multi(pOp, c, d);
+
+			#ifdef UG_PARALLEL
+				if(m_useOverlap)
+					return base_type::step_multi(pOp, c, d);
+
+			//	make defects consistent resp. unique, cf. step
+				SmartPtr<MultiVector<vector_type> > spDtmp = d.clone();
+				spDtmp->change_storage_type(m_useConsistentInterfaces ? PST_CONSISTENT : PST_UNIQUE);
+
+				SmartPtr<MultiVector<vector_type> > spH = c.clone_without_values();
+				if(!invert_L_multi(m_ILU, *spH, *spDtmp))
+					print_debugger_message("ILU: There were issues at inverting L\n");
+				if(!invert_U_multi(m_ILU, c, *spH, m_invEps))
+					print_debugger_message("ILU: There were issues at inverting U\n");
+
+				c.set_storage_type(m_useConsistentInterfaces ? PST_UNIQUE : PST_ADDITIVE);
+				c.change_storage_type(PST_CONSISTENT);
+			#else
+				SmartPtr<MultiVector<vector_type> > spH = c.clone_without_values();
+				if(!invert_L_multi(m_ILU, *spH, d))
+					print_debugger_message("ILU: There were issues at inverting L\n");
+				if(!invert_U_multi(m_ILU, c, *spH, m_invEps))
+					print_debugger_message("ILU: There were issues at inverting U\n");
+			#endif
+
+			return true;
+		}
+
 	///	Postprocess routine
 		virtual bool postprocess() {return true;}
 
@@ -299,6 +299,15 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			return true;
 		}
 
+	//	the diagonal scaling has no matrix traversal to share, but the
+	//	constant damping has to be treated as in apply
+		virtual bool apply_multi(MultiVector<vector_type>& c, const MultiVector<vector_type>& d)
+		{
+			for(size_t e = 0; e < d.num_vectors(); ++e)
+				if(!apply(c[e], d[e])) return false;
+			return true;
+		}
+
 	protected:
 	///	type of block-inverse
 		typedef typename block_traits<typename matrix_type::value_type>::inverse_type inverse_type;
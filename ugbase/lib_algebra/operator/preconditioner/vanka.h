@@ -35,6 +35,7 @@
 
 #include "common/util/smart_pointer.h"
 #include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/preconditioner/factorized_patches.h"
 
 #ifdef UG_PARALLEL
 	#include "pcl/pcl_util.h"
@@ -250,6 +251,7 @@ class Vanka : public IPreconditioner<TAlgebra>
 	///	Preprocess routine
 		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
 		{
+			m_patches.clear();
 #ifdef UG_PARALLEL
 			if(pcl::NumProcs() > 1)
 			{
@@ -275,7 +277,7 @@ class Vanka : public IPreconditioner<TAlgebra>
 				dhelp.resize(d.size()); dhelp = d;
 				dhelp.change_storage_type(PST_UNIQUE);
 
-				if(!Vanka_step(m_A, c, dhelp, m_relax)) return false;
+				if(!vanka_step(m_A, c, dhelp)) return false;
 
 				c.set_storage_type(PST_UNIQUE);
 				return true;
@@ -283,7 +285,7 @@ class Vanka : public IPreconditioner<TAlgebra>
 			else
 #endif
 			{
-				if(!Vanka_step(*pOp, c, d, m_relax)) return false;
+				if(!vanka_step(*pOp, c, d)) return false;
 
 #ifdef UG_PARALLEL
 				c.set_storage_type(PST_UNIQUE);
@@ -295,11 +297,44 @@ class Vanka : public IPreconditioner<TAlgebra>
 	///	Postprocess routine
 		virtual bool postprocess() {return true;}
 
+	///	Vanka step, reusing the patch factorizations if the algebra has a fixed block size
+		bool vanka_step(const matrix_type& A, vector_type& c, const vector_type& d)
+		{
+			if(!FactorizedPatches<TAlgebra>::supported())
+				return Vanka_step(A, c, d, m_relax);
+			cached_step(A, c, d);
+			return true;
+		}
+
+	///	Vanka step reusing the factorized patch matrices of the pressure rows
+		void cached_step(const matrix_type& A, vector_type& c, const vector_type& d)
+		{
+			if(!m_patches.factorized())
+			{
+				std::vector<size_t> vInd;
+				for(size_t i = 0; i < A.num_rows(); ++i)
+				{
+					if (A(i,i)!=0) continue;
+					vInd.clear();
+					for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it)
+						vInd.push_back(it.index());
+					m_patches.add_patch(vInd.begin(), vInd.end());
+				}
+				m_patches.factorize(A);
+			}
+
+			for(size_t i=0; i < c.size(); i++)
+				c[i]=0;
+			m_patches.gauss_seidel_step(A, c, d, m_relax);
+		}
+
 	protected:
 #ifdef UG_PARALLEL
 		matrix_type m_A;
 #endif
 
+	///	patches of the pressure rows with cached factorizations
+		FactorizedPatches<TAlgebra> m_patches;
 };
 
 ///	Diagvanka Preconditioner, description see above diagvanka_step function
@@ -40,6 +40,7 @@
 #include "algebra_layouts.h"
 #include "lib_algebra/common/operations.h"
 #include "parallel_vector.h"
+#include "lib_algebra/algebra_common/multi_vector.h"
 
 namespace ug
 {
@@ -128,6 +129,10 @@ class ParallelMatrix : public TMatrix
 		template<typename TPVector>
 		bool apply(TPVector &res, const TPVector &x) const;
 
+	/// calculate res[e] = A x[e] for all columns of a MultiVector
+		template<typename TPVector>
+		bool apply_multi(MultiVector<TPVector> &res, const MultiVector<TPVector> &x) const;
+
 	/// calculate res = A.T x
 		template<typename TPVector>
 		bool apply_transposed(TPVector &res, const TPVector &x) const;
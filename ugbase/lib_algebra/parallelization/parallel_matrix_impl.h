@@ -117,6 +117,47 @@ apply(TPVector &res, const TPVector &x) const
 	return true;
 }
 
+// calculate res[e] = A x[e] for all columns
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+apply_multi(MultiVector<TPVector> &res, const MultiVector<TPVector> &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+//	check types combinations, as in apply
+	std::vector<int> vType(x.num_vectors(), -1);
+	for(size_t e = 0; e < x.num_vectors(); ++e)
+	{
+		if(has_storage_type(PST_ADDITIVE)
+				&& x[e].has_storage_type(PST_CONSISTENT)) vType[e] = 0;
+		if(has_storage_type(PST_CONSISTENT)
+				&& x[e].has_storage_type(PST_ADDITIVE)) vType[e] = 1;
+		if(has_storage_type(PST_CONSISTENT)
+				&& x[e].has_storage_type(PST_CONSISTENT)) vType[e] = 2;
+
+		if(vType[e] == -1)
+		{
+			UG_THROW("ParallelMatrix::apply_multi (b = A*x): "
+					"Wrong storage type of Matrix/Vector: Possibilities are:\n"
+					"    - A is PST_ADDITIVE and x is PST_CONSISTENT\n"
+					"    - A is PST_CONSISTENT and x is PST_ADDITIVE\n"
+					"    (storage type of A = " << get_storage_type() << ", x[" << e
+					<< "] = " << x[e].get_storage_type() << ")");
+		}
+	}
+
+//	apply on single process vectors
+	TMatrix::apply_multi(res, x);
+
+//	set outgoing vectors to additive storage
+	for(size_t e = 0; e < res.num_vectors(); ++e)
+		res[e].set_storage_type(vType[e] == 2 ? PST_CONSISTENT : PST_ADDITIVE);
+
+//	we're done.
+	return true;
+}
+
 // calculate res = A.T x
 template <typename TMatrix>
 template<typename TPVector>
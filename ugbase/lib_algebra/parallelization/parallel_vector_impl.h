@@ -510,6 +510,60 @@ inline double VecProd(const ParallelVector<T> &a, const ParallelVector<T> &b)
 	return const_cast<ParallelVector<T>* >(&a)->dotprod(b);
 }
 
+// computes res[k] = scal<a, *vs[k]> for all k using a single reduction
+/* a is made unique, vectors in vs which are neither unique nor consistent are
+ * made unique as well. a itself may be contained in vs to obtain its squared norm.*/
+template<typename T>
+inline void VecProdMulti(const ParallelVector<T> &a,
+                         const std::vector<const ParallelVector<T>*> &vs,
+                         std::vector<double> &res)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	if(!const_cast<ParallelVector<T>*>(&a)->change_storage_type(PST_UNIQUE))
+		UG_THROW("VecProdMulti: Cannot change ParallelStorageType to unique.");
+
+	std::vector<const T*> vsLocal(vs.size());
+	for(size_t k = 0; k < vs.size(); ++k){
+		if(!vs[k]->has_storage_type(PST_CONSISTENT)
+			&& !vs[k]->has_storage_type(PST_UNIQUE))
+		{
+			if(!const_cast<ParallelVector<T>*>(vs[k])->change_storage_type(PST_UNIQUE))
+				UG_THROW("VecProdMulti: Cannot change ParallelStorageType to unique.");
+		}
+		vsLocal[k] = vs[k];
+	}
+
+	std::vector<double> resLocal;
+	VecProdMulti((const T&)a, vsLocal, resLocal);
+
+	if(a.layouts()->proc_comm().empty() || resLocal.empty())
+		res = resLocal;
+	else{
+		res.resize(resLocal.size());
+		a.layouts()->proc_comm().allreduce(&resLocal.front(), &res.front(),
+		                                   (int)resLocal.size(),
+		                                   PCL_DT_DOUBLE, PCL_RO_SUM);
+	}
+}
+
+// calculates dest += sum_k alpha[k] * (*vs[k])
+template<typename T>
+inline void VecScaleAppendMulti(ParallelVector<T> &dest, const std::vector<double> &alpha,
+                                const std::vector<const ParallelVector<T>*> &vs)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	uint mask = dest.get_storage_mask();
+	std::vector<const T*> vsLocal(vs.size());
+	for(size_t k = 0; k < vs.size(); ++k){
+		mask &= vs[k]->get_storage_mask();
+		vsLocal[k] = vs[k];
+	}
+	UG_COND_THROW(mask == 0, "VecScaleAppendMulti: cannot add vectors because their storage masks are incompatible");
+	dest.set_storage_type(mask);
+
+	VecScaleAppendMulti((T&)dest, alpha, vsLocal);
+}
+
 // Elementwise (Hadamard) product of two vectors
 template<typename T>
 inline void VecHadamardProd(ParallelVector<T> &dest, const ParallelVector<T> &v1, const ParallelVector<T> &v2)
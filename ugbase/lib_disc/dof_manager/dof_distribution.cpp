@@ -71,7 +71,9 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	  m_spSurfView(spSurfView),
 	  m_gridLevel(level),
 	  m_spDoFIndexStorage(spDoFIndexStorage),
-	  m_numIndex(0)
+	  m_numIndex(0),
+	  m_bPreserveIndices(false),
+	  m_bCollectIndices(false)
 {
 	if(m_spDoFIndexStorage.invalid())
 		m_spDoFIndexStorage = SmartPtr<DoFIndexStorage>(new DoFIndexStorage(spMG, spDDInfo));
@@ -163,6 +165,17 @@ add(TBaseObject* obj, const ReferenceObjectID roid, const int si)
 	size_t numNewIndex = 1;
 	if(!m_bGrouped) numNewIndex = num_dofs(roid,si);
 
+//	during an index preserving reinit the index is assigned later on
+	if(m_bCollectIndices){
+		PendingIndex pi;
+		pi.obj = obj;
+		pi.prevIndex = previous_index(obj);
+		pi.numIndex = numNewIndex;
+		pi.si = si;
+		m_vPendingIndex.push_back(pi);
+		return;
+	}
+
 // 	set first available index to the object. The first available index is the
 //	first managed index plus the size of the index set. (If holes are in the
 //	index set, this is not treated here, holes remain)
@@ -174,15 +187,57 @@ add(TBaseObject* obj, const ReferenceObjectID roid, const int si)
 	m_vNumIndexOnSubset[si] += numNewIndex;
 
 // 	if obj is a master, assign all its slaves
-	if(master) {
-		typedef typename PeriodicBoundaryManager::Group<TBaseObject>::SlaveContainer SlaveContainer;
-		typedef typename PeriodicBoundaryManager::Group<TBaseObject>::SlaveIterator SlaveIterator;
-		SlaveContainer& slaves = *m_spMG->periodic_boundary_manager()->slaves(obj);
-		size_t master_index = obj_index(obj);
-		for(SlaveIterator iter = slaves.begin(); iter != slaves.end(); ++iter){
-			obj_index(*iter) = master_index;
-		}
+	if(master)
+		copy_index_to_periodic_slaves(obj);
+}
+
+template <typename TBaseObject>
+void DoFDistribution::
+copy_index_to_periodic_slaves(TBaseObject* obj)
+{
+	typedef typename PeriodicBoundaryManager::Group<TBaseObject>::SlaveContainer SlaveContainer;
+	typedef typename PeriodicBoundaryManager::Group<TBaseObject>::SlaveIterator SlaveIterator;
+	SlaveContainer& slaves = *m_spMG->periodic_boundary_manager()->slaves(obj);
+	size_t master_index = obj_index(obj);
+	for(SlaveIterator iter = slaves.begin(); iter != slaves.end(); ++iter){
+		obj_index(*iter) = master_index;
+	}
+}
+
+template <typename TBaseElem>
+void DoFDistribution::
+copy_index_to_shadow_copies(TBaseElem* elem)
+{
+	const SurfaceView& sv = *m_spSurfView;
+	MultiGrid& mg = *m_spMG;
+
+//	with index preservation, also pure shadows which are copies keep the index,
+//	so that it is found again when coarsening makes them surface elements
+	TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
+	while(p && (sv.is_contained(p, grid_level(), SurfaceView::SHADOW_RIM_COPY)
+				|| (m_bPreserveIndices && mg.num_children<TBaseElem>(p) == 1))){
+		obj_index(p) = obj_index(elem);
+		p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
+	}
+}
+
+template <typename TBaseElem>
+size_t DoFDistribution::
+previous_index(TBaseElem* elem) const
+{
+	size_t index = obj_index(elem);
+	if(index != (size_t)-1 || !grid_level().is_surface())
+		return index;
+
+//	a new element which is the only child of its parent replaces the parent
+//	in the surface and takes over its index
+	MultiGrid& mg = *m_pMG;
+	TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
+	while(p && (index == (size_t)-1) && (mg.num_children<TBaseElem>(p) == 1)){
+		index = obj_index(p);
+		p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
 	}
+	return index;
 }
 
 template <typename TBaseElem>
@@ -1382,15 +1437,15 @@ void DoFDistribution::reinit()
 					}
 				}
 
-			//	create a dof and copy it down to SHADOW_COPY parents
+			//	create a dof and copy it down to SHADOW_COPY parents. During an
+			//	index preserving reinit this is done in assign_pending_indices.
 				const ReferenceObjectID roid = elem->reference_object_id();
 				add(elem, roid, si);
 
-				TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
-				while(p && sv.is_contained(p, grid_level(), SurfaceView::SHADOW_RIM_COPY)){
-					obj_index(p) = obj_index(elem);
-					p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
-				}
+				if(!m_bCollectIndices)
+					copy_index_to_shadow_copies(elem);
+				else
+					reset_indices_of_refined_parents(elem);
 			}
 		} // end subset
 	}
@@ -1429,6 +1484,9 @@ void DoFDistribution::reinit()
 
 void DoFDistribution::reinit()
 {
+	const size_t numOldIndex = m_numIndex;
+	m_bCollectIndices = m_bPreserveIndices && (numOldIndex > 0);
+
 	m_numIndex = 0;
 	m_vNumIndexOnSubset.resize(0);
 	m_vNumIndexOnSubset.resize(num_subsets(), 0);
@@ -1438,11 +1496,162 @@ void DoFDistribution::reinit()
 	if(max_dofs(FACE))   reinit<Face>();
 	if(max_dofs(VOLUME)) reinit<Volume>();
 
+	if(m_bCollectIndices){
+		m_bCollectIndices = false;
+		assign_pending_indices(numOldIndex);
+	}
+
 #ifdef UG_PARALLEL
 	reinit_layouts_and_communicator();
 #endif
 }
 
+void DoFDistribution::assign_pending_indices(size_t numOldIndex)
+{
+//	claim the previous index blocks which are still valid. Blocks which are
+//	out of range or overlap an already claimed block receive new indices.
+	std::vector<bool> vUsed(numOldIndex, false);
+	for(size_t i = 0; i < m_vPendingIndex.size(); ++i){
+		PendingIndex& pi = m_vPendingIndex[i];
+		const size_t first = pi.prevIndex;
+		bool valid = (first < numOldIndex) && (pi.numIndex <= numOldIndex - first);
+		for(size_t j = 0; valid && j < pi.numIndex; ++j)
+			if(vUsed[first + j]) valid = false;
+
+		if(!valid){
+			pi.prevIndex = (size_t)-1;
+			continue;
+		}
+
+		for(size_t j = 0; j < pi.numIndex; ++j)
+			vUsed[first + j] = true;
+	}
+
+//	remove unused indices by shifting, which keeps the order of the others
+	std::vector<size_t> vNewIndex(numOldIndex);
+	m_numIndex = 0;
+	for(size_t i = 0; i < numOldIndex; ++i){
+		vNewIndex[i] = m_numIndex;
+		if(vUsed[i]) ++m_numIndex;
+	}
+
+	UG_DLOG(LIB_DISC, 2, "DoFDistribution: preserved " << m_numIndex
+			<< " of " << numOldIndex << " indices.\n");
+
+//	assign preserved indices and append new ones
+	for(size_t i = 0; i < m_vPendingIndex.size(); ++i){
+		const PendingIndex& pi = m_vPendingIndex[i];
+		size_t index;
+		if(pi.prevIndex != (size_t)-1)
+			index = vNewIndex[pi.prevIndex];
+		else{
+			index = m_numIndex;
+			m_numIndex += pi.numIndex;
+		}
+		m_vNumIndexOnSubset[pi.si] += pi.numIndex;
+
+		switch(pi.obj->base_object_id()){
+			case VERTEX: assign_pending_index(static_cast<Vertex*>(pi.obj), index); break;
+			case EDGE:   assign_pending_index(static_cast<Edge*>(pi.obj), index); break;
+			case FACE:   assign_pending_index(static_cast<Face*>(pi.obj), index); break;
+			case VOLUME: assign_pending_index(static_cast<Volume*>(pi.obj), index); break;
+			default: UG_THROW("Base Object type not found.");
+		}
+	}
+
+	m_vPendingIndex.clear();
+}
+
+void DoFDistribution::enable_index_preservation(bool enable)
+{
+//	indices of elements which left the surface before are not reliable
+	if(enable && !m_bPreserveIndices && m_numIndex > 0)
+		reset_indices_outside_surface();
+	m_bPreserveIndices = enable;
+	m_spDoFIndexStorage->enable_index_pass_on(enable);
+}
+
+void DoFDistribution::reset_indices_outside_surface()
+{
+	if(!grid_level().is_surface())
+		return;
+
+	if(max_dofs(VERTEX)) reset_indices_outside_surface<Vertex>();
+	if(max_dofs(EDGE))   reset_indices_outside_surface<Edge>();
+	if(max_dofs(FACE))   reset_indices_outside_surface<Face>();
+	if(max_dofs(VOLUME)) reset_indices_outside_surface<Volume>();
+}
+
+template <typename TBaseElem>
+void DoFDistribution::reset_indices_outside_surface()
+{
+	typedef typename geometry_traits<TBaseElem>::iterator iterator;
+	const SurfaceView& sv = *m_spSurfView;
+	MultiGrid& mg = *m_spMG;
+
+	for(iterator iter = mg.begin<TBaseElem>(); iter != mg.end<TBaseElem>(); ++iter){
+		TBaseElem* elem = *iter;
+		if(sv.is_contained(elem, grid_level(), SurfaceView::ALL))
+			continue;
+
+	//	copies of a surface element share its index (see copy_index_to_shadow_copies)
+		TBaseElem* c = elem;
+		while(mg.num_children<TBaseElem>(c) == 1
+			  && !sv.is_contained(c, grid_level(), SurfaceView::ALL))
+			c = mg.get_child<TBaseElem>(c, 0);
+
+		if(c == elem || obj_index(c) != obj_index(elem)
+			|| !sv.is_contained(c, grid_level(), SurfaceView::ALL))
+			obj_index(elem) = (size_t)-1;
+	}
+}
+
+template <typename TBaseElem>
+void DoFDistribution::reset_indices_of_refined_parents(TBaseElem* elem)
+{
+	const SurfaceView& sv = *m_spSurfView;
+	MultiGrid& mg = *m_spMG;
+
+//	Parents with several children left the surface when they were refined. Their
+//	index is reset together with the one of their copies, i.e. the parents with
+//	a single child sharing the index. Indices of other parents with a single
+//	child are overwritten in copy_index_to_shadow_copies. Since the indices of
+//	all parents above a reset parent have been reset before, the walk stops there.
+	TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
+	while(p){
+		if(mg.num_children<TBaseElem>(p) > 1
+			&& !sv.is_contained(p, grid_level(), SurfaceView::ALL))
+		{
+			const size_t index = obj_index(p);
+			if(index == (size_t)-1)
+				break;
+
+			obj_index(p) = (size_t)-1;
+			p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
+			while(p && mg.num_children<TBaseElem>(p) == 1 && obj_index(p) == index
+				  && !sv.is_contained(p, grid_level(), SurfaceView::ALL))
+			{
+				obj_index(p) = (size_t)-1;
+				p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
+			}
+			continue;
+		}
+		p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
+	}
+}
+
+template <typename TBaseElem>
+void DoFDistribution::assign_pending_index(TBaseElem* elem, size_t index)
+{
+	obj_index(elem) = index;
+
+	if(m_spMG->has_periodic_boundaries()
+		&& m_spMG->periodic_boundary_manager()->is_master(elem))
+		copy_index_to_periodic_slaves(elem);
+
+	if(grid_level().is_surface())
+		copy_index_to_shadow_copies(elem);
+}
 
 #ifdef UG_PARALLEL
 void DoFDistribution::reinit_layouts_and_communicator()
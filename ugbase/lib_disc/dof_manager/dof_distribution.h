@@ -220,6 +220,28 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// return the number of dofs distributed on subset si
 		size_t num_indices(int si) const {return m_vNumIndexOnSubset[si];}
 
+		///	enables a stable index numbering in reinit (disabled by default)
+		/**	If enabled, reinit keeps the numbering of all indices whose elements
+		 * still carry dofs after grid adaption. Indices which are no longer
+		 * used are removed by shifting the following indices down, so that
+		 * the relative order of all preserved indices remains the same (e.g.
+		 * the order established by permute_indices). Indices of new elements
+		 * are appended. If only new indices were created (e.g. refinement
+		 * with vertex dofs only), all old indices stay unchanged.
+		 *
+		 * A new element which is the only child of a parent of the same type
+		 * takes over the index of its parent. Elements which leave the surface
+		 * lose their index, so that only indices of the previous surface are
+		 * reused.
+		 *
+		 * Only the numbering is affected. reinit still visits all elements of
+		 * the surface, and index layouts, matrices and grid functions are
+		 * recreated as without this option.*/
+		void enable_index_preservation(bool enable);
+
+		///	returns whether index preservation is enabled
+		bool index_preservation_enabled() const {return m_bPreserveIndices;}
+
 	public:
 		/// extracts all indices of the element (sorted)
 		/**
@@ -446,6 +468,40 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		template <typename TBaseObject>
 		void add(TBaseObject* obj, const ReferenceObjectID roid, const int si);
 
+		///	assigns the index of a periodic master to its slaves
+		template <typename TBaseObject>
+		void copy_index_to_periodic_slaves(TBaseObject* obj);
+
+		///	passes the index of a surface element down to its SHADOW_RIM_COPY parents
+		template <typename TBaseElem>
+		void copy_index_to_shadow_copies(TBaseElem* elem);
+
+		///	returns the index an element had before reinit or (size_t)-1
+		template <typename TBaseElem>
+		size_t previous_index(TBaseElem* elem) const;
+
+		///	assigns the indices collected by add during an index preserving reinit
+		void assign_pending_indices(size_t numOldIndex);
+
+		template <typename TBaseElem>
+		void assign_pending_index(TBaseElem* elem, size_t index);
+
+		///	sets the index of all elements which are not in the surface to (size_t)-1
+		/**	This is only done for surface dof distributions, which use all
+		 * elements of the multigrid. It costs one pass over the multigrid and
+		 * is only performed when index preservation is enabled for a
+		 * distribution which already holds indices.*/
+		void reset_indices_outside_surface();
+
+		template <typename TBaseElem>
+		void reset_indices_outside_surface();
+
+		///	resets the indices of parents of elem which left the surface
+		/**	Called for each element during an index preserving reinit, so that
+		 * stale indices can't collide with preserved ones.*/
+		template <typename TBaseElem>
+		void reset_indices_of_refined_parents(TBaseElem* elem);
+
 		///	checks that subset assignment is ok
 		void check_subsets();
 
@@ -485,6 +541,23 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// number of distributed indices on each subset
 		std::vector<size_t> m_vNumIndexOnSubset;
 
+		///	flag if indices are preserved during reinit
+		bool m_bPreserveIndices;
+
+		///	true while add only collects the index blocks (index preserving reinit)
+		bool m_bCollectIndices;
+
+		///	an index block whose index is assigned after all elements have been visited
+		struct PendingIndex{
+			GridObject* obj;
+			size_t prevIndex;
+			size_t numIndex;
+			int si;
+		};
+
+		///	index blocks collected during an index preserving reinit
+		std::vector<PendingIndex> m_vPendingIndex;
+
 	public:
 		/// returns the connections
 		void get_connections(std::vector<std::vector<size_t> >& vvConnection) const;
@@ -38,7 +38,8 @@ DoFIndexStorage::
 DoFIndexStorage(SmartPtr<MultiGrid> spMG,
                 ConstSmartPtr<DoFDistributionInfo> spDDInfo)
 :	DoFDistributionInfoProvider(spDDInfo),
- 	m_spMG(spMG)
+ 	m_spMG(spMG),
+ 	m_bPassOnIndices(false)
 {
 	init_attachments();
 }
@@ -53,19 +54,19 @@ void DoFIndexStorage::init_attachments()
 {
 //	attach DoFs to vertices
 	if(max_dofs(VERTEX)) {
-		multi_grid()->attach_to_dv<Vertex>(m_aIndex, (size_t)-1);
+		multi_grid()->attach_to_dv<Vertex>(m_aIndex, (size_t)-1, m_bPassOnIndices);
 		m_aaIndexVRT.access(*multi_grid(), m_aIndex);
 	}
 	if(max_dofs(EDGE)) {
-		multi_grid()->attach_to_dv<Edge>(m_aIndex, (size_t)-1);
+		multi_grid()->attach_to_dv<Edge>(m_aIndex, (size_t)-1, m_bPassOnIndices);
 		m_aaIndexEDGE.access(*multi_grid(), m_aIndex);
 	}
 	if(max_dofs(FACE)) {
-		multi_grid()->attach_to_dv<Face>(m_aIndex, (size_t)-1);
+		multi_grid()->attach_to_dv<Face>(m_aIndex, (size_t)-1, m_bPassOnIndices);
 		m_aaIndexFACE.access(*multi_grid(), m_aIndex);
 	}
 	if(max_dofs(VOLUME)) {
-		multi_grid()->attach_to_dv<Volume>(m_aIndex, (size_t)-1);
+		multi_grid()->attach_to_dv<Volume>(m_aIndex, (size_t)-1, m_bPassOnIndices);
 		m_aaIndexVOL.access(*multi_grid(), m_aIndex);
 	}
 }
@@ -84,6 +85,33 @@ void DoFIndexStorage::clear_attachments()
 	m_aaIndexVOL.invalidate();
 }
 
+void DoFIndexStorage::enable_index_pass_on(bool enable)
+{
+	if(enable == m_bPassOnIndices)
+		return;
+	m_bPassOnIndices = enable;
+
+//	the pass on behaviour is fixed when an attachment is attached. The indices
+//	are thus swapped into a new attachment.
+	ADoF aNewIndex;
+	if(m_aaIndexVRT.valid()) reattach_index<Vertex>(aNewIndex, m_aaIndexVRT);
+	if(m_aaIndexEDGE.valid()) reattach_index<Edge>(aNewIndex, m_aaIndexEDGE);
+	if(m_aaIndexFACE.valid()) reattach_index<Face>(aNewIndex, m_aaIndexFACE);
+	if(m_aaIndexVOL.valid()) reattach_index<Volume>(aNewIndex, m_aaIndexVOL);
+	m_aIndex = aNewIndex;
+}
+
+template <class TElem, class TAccessor>
+void DoFIndexStorage::reattach_index(ADoF& aNewIndex, TAccessor& aaIndex)
+{
+	MultiGrid& mg = *multi_grid();
+	mg.attach_to_dv<TElem>(aNewIndex, (size_t)-1, m_bPassOnIndices);
+	mg.get_attachment_data_container<TElem>(aNewIndex)->swap(
+			*mg.get_attachment_data_container<TElem>(m_aIndex));
+	mg.detach_from<TElem>(m_aIndex);
+	aaIndex.access(mg, aNewIndex);
+}
+
 size_t& DoFIndexStorage::obj_index(GridObject* obj)
 {
 	switch(obj->base_object_id())
@@ -68,6 +68,13 @@ class DoFIndexStorage : public DoFDistributionInfoProvider
 		inline const size_t& obj_index(Volume* vol)     const {return m_aaIndexVOL[vol];}
 		/// \}
 
+		///	enables passing indices on to elements which replace an element
+		/**	If enabled, an element which replaces another one (e.g. when a
+		 * refiner replaces an edge by a constraining edge) inherits its index.
+		 * This is only needed by dof distributions with a stable numbering
+		 * (see DoFDistribution::enable_index_preservation) and disabled by default.*/
+		void enable_index_pass_on(bool enable);
+
 	protected:
 		/// initializes the attachments
 		void init_attachments();
@@ -91,6 +98,10 @@ class DoFIndexStorage : public DoFDistributionInfoProvider
 		typedef Grid::AttachmentAccessor<Volume, ADoF> volume_attachment_accessor_type;
 		/// \}
 
+		///	moves the indices of elements of type TElem to aNewIndex
+		template <class TElem, class TAccessor>
+		void reattach_index(ADoF& aNewIndex, TAccessor& aaIndex);
+
 		///	Attachments
 		///	\{
 		vertex_attachment_accessor_type m_aaIndexVRT;
@@ -98,6 +109,9 @@ class DoFIndexStorage : public DoFDistributionInfoProvider
 		face_attachment_accessor_type m_aaIndexFACE;
 		volume_attachment_accessor_type m_aaIndexVOL;
 		///	\}
+
+		///	flag if indices are passed on to replacing elements
+		bool m_bPassOnIndices;
 };
 
 } // end namespace ug
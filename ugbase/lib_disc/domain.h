@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__DOMAIN__
 
 #include "lib_grid/algorithms/subset_util.h"
+#include "lib_grid/algorithms/space_filling_curve_util.h"
 #include "lib_grid/refinement/projectors/refinement_projector.h"
 
 #include <map>
@@ -224,6 +225,24 @@ class IDomain
 	///	returns the geometry of the domain
 		virtual SPIGeometry3d geometry3d() const = 0;
 
+	///	reorders the elements of the grid along the given space filling curve
+	/**	Valid curves are "hilbert" and "morton". The elements of each level
+	 * and of each subset are sorted along the curve, together with their
+	 * attached data.*/
+		void reorder_along_space_filling_curve(const std::string& curve);
+
+	///	enables automatic reordering of the grid along a space filling curve
+	/**	If enabled, the grid is reordered along the given curve ("hilbert" or
+	 * "morton") each time a grid adaption has finished and each time the grid
+	 * has been created or redistributed. Since the domain is informed about
+	 * those events before DoFDistributions are updated, new DoF indices follow
+	 * the new element order. Pass "none" to disable the reordering (default).*/
+		void set_space_filling_curve_reordering(const std::string& curve);
+
+	protected:
+	///	reorders the elements of the grid along the given space filling curve
+		virtual void reorder_elements_along_sfc(SpaceFillingCurveType sfc) = 0;
+
 	protected:
 		#ifdef UG_PARALLEL
 		/// helper method to broadcast ug::RefinementProjectors to different processes
@@ -256,6 +275,9 @@ class IDomain
 		bool	m_isAdaptive;
 		bool	m_adaptionIsActive;
 
+		bool					m_bSFCReordering;
+		SpaceFillingCurveType	m_sfcType;
+
 	/**	this callback is called by the message hub, when a grid adaption has been
 	 * performed. It will call all necessary actions in order to keep the grid
 	 * correct for computations. */
@@ -337,6 +359,9 @@ class Domain : public IDomain<TGrid, TSubsetHandler>
 
 		virtual SPIGeometry3d geometry3d() const	{return m_geometry3d;}
 
+	protected:
+		virtual void reorder_elements_along_sfc(SpaceFillingCurveType sfc);
+
 	protected:
 		position_attachment_type m_aPos;	///<Position Attachment
 		position_accessor_type	m_aaPos;		///<Accessor
@@ -36,6 +36,7 @@
 #include "domain.h"
 #include "common/serialization.h"
 #include "common/profiler/profiler.h"
+#include "common/util/string_util.h"
 
 #ifdef UG_PARALLEL
 	#include "lib_grid/refinement/projectors/projectors.h"
@@ -63,7 +64,9 @@ IDomain<TGrid,TSubsetHandler>::IDomain(bool isAdaptive)
 	m_spGrid(new TGrid(GRIDOPT_NONE)),	// Note: actual options are set by the derived class (dimension dependent).
 	m_spSH(new TSubsetHandler(*m_spGrid)),
 	m_isAdaptive(isAdaptive),
-	m_adaptionIsActive(false)
+	m_adaptionIsActive(false),
+	m_bSFCReordering(false),
+	m_sfcType(SFC_HILBERT)
 {
 	#ifdef UG_PARALLEL
 	//	the grid has to be prepared for parallelism
@@ -169,6 +172,8 @@ grid_adaption_callback(const GridMessage_Adaption& msg)
 		//if(msg.adaptive()){
 			if(msg.adaption_ends())
 			{
+				if(m_bSFCReordering)
+					reorder_elements_along_sfc(m_sfcType);
 				update_domain_info();
 				m_adaptionIsActive = false;
 			}
@@ -189,6 +194,8 @@ void IDomain<TGrid,TSubsetHandler>::
 grid_creation_callback(const GridMessage_Creation& msg)
 {
 	if(msg.msg() == GMCT_CREATION_STOPS){
+		if(m_bSFCReordering)
+			reorder_elements_along_sfc(m_sfcType);
 		if(msg.proc_id() != -1)
 			update_subset_infos(msg.proc_id());
 		update_domain_info();
@@ -207,6 +214,25 @@ grid_distribution_callback(const GridMessage_Distribution& msg)
 }
 
 
+template <typename TGrid, typename TSubsetHandler>
+void IDomain<TGrid,TSubsetHandler>::
+reorder_along_space_filling_curve(const std::string& curve)
+{
+	reorder_elements_along_sfc(SpaceFillingCurveTypeFromString(curve));
+}
+
+template <typename TGrid, typename TSubsetHandler>
+void IDomain<TGrid,TSubsetHandler>::
+set_space_filling_curve_reordering(const std::string& curve)
+{
+	if(curve.empty() || ToLower(curve) == "none"){
+		m_bSFCReordering = false;
+		return;
+	}
+	m_sfcType = SpaceFillingCurveTypeFromString(curve);
+	m_bSFCReordering = true;
+}
+
 template <typename TGrid, typename TSubsetHandler>
 void IDomain<TGrid,TSubsetHandler>::
 update_domain_info()
@@ -691,6 +717,14 @@ Domain(bool isAdaptive) : IDomain<TGrid, TSubsetHandler>(isAdaptive)
 	this->m_refinementProjector = make_sp(new RefinementProjector(m_geometry3d));
 }
 
+template <int d, typename TGrid, typename TSubsetHandler>
+void Domain<d,TGrid,TSubsetHandler>::
+reorder_elements_along_sfc(SpaceFillingCurveType sfc)
+{
+	ReorderGridAlongSpaceFillingCurve(*this->grid(), this->subset_handler().get(),
+									  m_aaPos, sfc);
+}
+
 
 } // end namespace ug
 
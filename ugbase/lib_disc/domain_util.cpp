@@ -36,6 +36,7 @@
 #include "common/util/file_util.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/file_io/file_io_ugx.h"
+#include "lib_grid/parallelization/partitioned_grid_io.h"
 #include "lib_grid/algorithms/geom_obj_util/misc_util.h"
 #include "lib_grid/refinement/projectors/projection_handler.h"
 #include "common/profiler/profiler.h"
@@ -112,6 +113,40 @@ void SaveDomain(TDomain& domain, const char* filename)
 }
 
 
+template <typename TDomain>
+void SavePartitionedDomain(TDomain& domain, PartitionMap& partitionMap,
+						   const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	SmartPtr<ProjectionHandler> ph =
+		domain.refinement_projector().template cast_dynamic<ProjectionHandler>();
+
+	if(!SavePartitionedGrid(*domain.grid(), *domain.subset_handler(), partitionMap,
+							filename, domain.position_attachment(), ph.get()))
+	{
+		UG_THROW("SavePartitionedDomain: Could not save to file: " << filename);
+	}
+}
+
+
+template <typename TDomain>
+void LoadPartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	SPProjectionHandler ph = make_sp(new ProjectionHandler(domain.geometry3d(),
+														   domain.subset_handler()));
+
+	if(!LoadPartitionedGrid(*domain.grid(), *domain.subset_handler(), filename,
+							domain.position_attachment(), ph.get()))
+	{
+		UG_THROW("LoadPartitionedDomain: Could not load file: " << filename);
+	}
+
+	if(ph->num_projectors() > 0)
+		domain.set_refinement_projector(ph);
+}
+
+
 template <typename TDomain>
 number MaxElementDiameter(TDomain& domain, int level)
 {
@@ -142,6 +177,14 @@ template void SaveDomain<Domain1d>(Domain1d& domain, const char* filename);
 template void SaveDomain<Domain2d>(Domain2d& domain, const char* filename);
 template void SaveDomain<Domain3d>(Domain3d& domain, const char* filename);
 
+template void SavePartitionedDomain<Domain1d>(Domain1d& domain, PartitionMap& partitionMap, const char* filename);
+template void SavePartitionedDomain<Domain2d>(Domain2d& domain, PartitionMap& partitionMap, const char* filename);
+template void SavePartitionedDomain<Domain3d>(Domain3d& domain, PartitionMap& partitionMap, const char* filename);
+
+template void LoadPartitionedDomain<Domain1d>(Domain1d& domain, const char* filename);
+template void LoadPartitionedDomain<Domain2d>(Domain2d& domain, const char* filename);
+template void LoadPartitionedDomain<Domain3d>(Domain3d& domain, const char* filename);
+
 template number MaxElementDiameter<Domain1d>(Domain1d& domain, int level);
 template number MaxElementDiameter<Domain2d>(Domain2d& domain, int level);
 template number MaxElementDiameter<Domain3d>(Domain3d& domain, int level);
@@ -35,6 +35,7 @@
 
 // other lib_discretization headers
 #include "domain.h"
+#include "lib_grid/tools/partition_map.h"
 
 namespace ug{
 
@@ -58,6 +59,19 @@ void LoadDomain(TDomain& domain, const char* filename, int procId);
 template <typename TDomain>
 void SaveDomain(TDomain& domain, const char* filename);
 
+///	Saves each part of a partitioned domain to its own section of a ugb-file.
+/**	The file can be loaded in parallel through LoadPartitionedDomain, where each
+ * process only reads its own part. See SavePartitionedGrid for details.*/
+template <typename TDomain>
+void SavePartitionedDomain(TDomain& domain, PartitionMap& partitionMap,
+						   const char* filename);
+
+///	Loads the part of the local process from a file written by SavePartitionedDomain.
+/**	The domain is distributed afterwards, without any redistribution step.
+ * See LoadPartitionedGrid for details.*/
+template <typename TDomain>
+void LoadPartitionedDomain(TDomain& domain, const char* filename);
+
 
 ////////////////////////////////////////////////////////////////////////
 ///	returns the corner coordinates of a geometric object
@@ -83,6 +83,7 @@ init(SmartPtr<subset_handler_type> spMGSH,
 	m_spDoFDistributionInfo = SmartPtr<DoFDistributionInfo>(new DoFDistributionInfo(spMGSH));
 	m_algebraType = algebraType;
 	m_bAdaptionIsActive = false;
+	m_bPreserveIndices = false;
 	m_RevCnt = RevisionCounter(this);
 
 	this->set_dof_distribution_info(m_spDoFDistributionInfo);
@@ -342,6 +343,7 @@ void IApproximationSpace::create_dof_distribution(const GridLevel& gl)
 	SmartPtr<DoFDistribution> spDD = SmartPtr<DoFDistribution>(new
 		DoFDistribution(m_spMG, m_spMGSH, m_spDoFDistributionInfo,
 						m_spSurfaceView, gl, m_bGrouped, spIndexStrg));
+	spDD->enable_index_preservation(m_bPreserveIndices);
 
 //	add to list and sort
 	m_vDD.push_back(spDD);
@@ -355,6 +357,19 @@ void IApproximationSpace::surface_view_required()
 		m_spSurfaceView = SmartPtr<SurfaceView>(new SurfaceView(m_spMGSH));
 }
 
+void IApproximationSpace::enable_surface_element_lists(bool enable)
+{
+	surface_view_required();
+	m_spSurfaceView->enable_surface_element_lists(enable);
+}
+
+void IApproximationSpace::enable_index_preservation(bool enable)
+{
+	m_bPreserveIndices = enable;
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		m_vDD[i]->enable_index_preservation(enable);
+}
+
 void IApproximationSpace::dof_distribution_info_required()
 {
 //	init dd-info (and fix the function pattern by that)
@@ -207,6 +207,17 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	initializes all top surface dof distributions
 		void init_top_surface();
 
+	///	enables contiguous surface element lists in the surface view
+	/**	Iterations over the top surface then run over plain arrays instead of
+	 * all levels of the hierarchy. \sa SurfaceView::enable_surface_element_lists*/
+		void enable_surface_element_lists(bool enable);
+
+	///	enables a stable index numbering of all dof distributions during grid adaption
+	/**	Indices of elements which keep their dofs are then not renumbered from
+	 * scratch after each adaption step. The dof distributions are still
+	 * rebuilt. \sa DoFDistribution::enable_index_preservation*/
+		void enable_index_preservation(bool enable);
+
 	///	returns the current revision
 		const RevisionCounter& revision() const {return m_RevCnt;}
 
@@ -256,6 +267,9 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	flag if DoFs should be grouped
 		bool m_bGrouped;
 
+	///	flag if indices are preserved during grid adaption
+		bool m_bPreserveIndices;
+
 	///	DofDistributionInfo
 		SmartPtr<DoFDistributionInfo> m_spDoFDistributionInfo;
 
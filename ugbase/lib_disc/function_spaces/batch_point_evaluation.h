@@ -0,0 +1,730 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__FUNCTION_SPACE__BATCH_POINT_EVALUATION__
+#define __H__UG__LIB_DISC__FUNCTION_SPACE__BATCH_POINT_EVALUATION__
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "common/common.h"
+#include "common/math/misc/shapes.h"
+#include "common/util/thread_team.h"
+#include "lib_grid/algorithms/space_filling_curve_util.h"
+#include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+#include "lib_grid/grid_objects/grid_dim_traits.h"
+#include "lib_grid/tools/subset_group.h"
+#include "lib_disc/common/function_group.h"
+#include "lib_disc/common/multi_index.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/local_finite_element/local_finite_element_provider.h"
+#include "lib_disc/reference_element/reference_mapping.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_process_communicator.h"
+#endif
+
+namespace ug{
+
+namespace batch_point_detail{
+
+///	maps a global position to the local coordinates of an element
+/**	In contrast to the mappings of the ReferenceMappingProvider, which are
+ * shared singletons, the mapping is created on the stack. The method may thus
+ * be called concurrently from several threads.*/
+template <int dim> struct LocalCoordinates;
+
+template <> struct LocalCoordinates<1>
+{
+	static void compute(MathVector<1>& locPos, ReferenceObjectID roid,
+						const MathVector<1>* vCorner, const MathVector<1>& globPos)
+	{
+		if(roid != ROID_EDGE)
+			UG_THROW("LocalCoordinates: Unsupported reference object " << roid);
+		ReferenceMapping<ReferenceEdge, 1>(vCorner).global_to_local(locPos, globPos);
+	}
+};
+
+template <> struct LocalCoordinates<2>
+{
+	static void compute(MathVector<2>& locPos, ReferenceObjectID roid,
+						const MathVector<2>* vCorner, const MathVector<2>& globPos)
+	{
+		switch(roid){
+			case ROID_TRIANGLE:
+				ReferenceMapping<ReferenceTriangle, 2>(vCorner).global_to_local(locPos, globPos); break;
+			case ROID_QUADRILATERAL:
+				ReferenceMapping<ReferenceQuadrilateral, 2>(vCorner).global_to_local(locPos, globPos); break;
+			default: UG_THROW("LocalCoordinates: Unsupported reference object " << roid);
+		}
+	}
+};
+
+template <> struct LocalCoordinates<3>
+{
+	static void compute(MathVector<3>& locPos, ReferenceObjectID roid,
+						const MathVector<3>* vCorner, const MathVector<3>& globPos)
+	{
+		switch(roid){
+			case ROID_TETRAHEDRON:
+				ReferenceMapping<ReferenceTetrahedron, 3>(vCorner).global_to_local(locPos, globPos); break;
+			case ROID_PYRAMID:
+				ReferenceMapping<ReferencePyramid, 3>(vCorner).global_to_local(locPos, globPos); break;
+			case ROID_PRISM:
+				ReferenceMapping<ReferencePrism, 3>(vCorner).global_to_local(locPos, globPos); break;
+			case ROID_HEXAHEDRON:
+				ReferenceMapping<ReferenceHexahedron, 3>(vCorner).global_to_local(locPos, globPos); break;
+			case ROID_OCTAHEDRON:
+				ReferenceMapping<ReferenceOctahedron, 3>(vCorner).global_to_local(locPos, globPos); break;
+			default: UG_THROW("LocalCoordinates: Unsupported reference object " << roid);
+		}
+	}
+};
+
+}//	end of namespace batch_point_detail
+
+
+///	converts a flat array of coordinates into positions
+template <int dim>
+void FlatCoordinatesToPositions(std::vector<MathVector<dim> >& vPosOut,
+								const std::vector<number>& vCoords)
+{
+	if(vCoords.size() % dim != 0)
+		UG_THROW("FlatCoordinatesToPositions: Expected a multiple of "
+				 << dim << " coordinates, but given " << vCoords.size());
+
+	vPosOut.resize(vCoords.size() / dim);
+	for(size_t i = 0; i < vPosOut.size(); ++i)
+		for(int d = 0; d < dim; ++d)
+			vPosOut[i][d] = vCoords[dim * i + d];
+}
+
+
+///	Locates large sets of points in the elements of a domain
+/**
+ * The locator builds an lg_ntree over a set of full-dimensional elements of
+ * the domain. Given a batch of points, the points are first sorted along a
+ * Morton curve. Consecutive points in this order are typically close to each
+ * other, so that each point is searched by a walk through the vertex
+ * neighborhood of the element which contained the previous point. Only if
+ * the walk fails, the tree is traversed.
+ *
+ * The sorted points are split into contiguous ranges which are located
+ * concurrently by the threads of a ThreadTeam, which is kept alive between
+ * calls to locate. For each point, the containing element
+ * and the local coordinates inside this element are returned.
+ *
+ * \note	The grid is only read during locate, with one exception: the
+ *			option to store associated elements at vertices, which is
+ *			required for the neighbor walk, is enabled in set_elements.
+ */
+template <typename TDomain>
+class BatchPointLocator
+{
+	public:
+	///	world dimension
+		static const int dim = TDomain::dim;
+
+	///	element type
+		typedef typename grid_dim_traits<dim>::grid_base_object elem_t;
+
+	///	position type
+		typedef MathVector<dim> vector_t;
+
+	///	tree type
+		typedef lg_ntree<dim, dim, elem_t> tree_t;
+
+	public:
+	///	constructor
+		BatchPointLocator(SmartPtr<TDomain> spDomain)
+			: m_spDomain(spDomain),
+			  m_pGrid(spDomain->grid().get()),
+			  m_aaPos(spDomain->position_accessor()),
+			  m_tree(*spDomain->grid(), spDomain->position_attachment()),
+			  m_maxWalkSteps(8)
+		{
+			VecSet(m_box.min, std::numeric_limits<number>::max());
+			VecSet(m_box.max, -std::numeric_limits<number>::max());
+		}
+
+	///	sets the elements in which points are searched
+		template <typename TIterator>
+		void set_elements(TIterator begin, TIterator end)
+		{
+			m_vElem.clear();
+			for(TIterator iter = begin; iter != end; ++iter)
+				m_vElem.push_back(*iter);
+			std::sort(m_vElem.begin(), m_vElem.end());
+			m_tree.create_tree(m_vElem.begin(), m_vElem.end());
+
+			VecSet(m_box.min, std::numeric_limits<number>::max());
+			VecSet(m_box.max, -std::numeric_limits<number>::max());
+			for(size_t i = 0; i < m_vElem.size(); ++i){
+				elem_t* e = m_vElem[i];
+				for(size_t j = 0; j < e->num_vertices(); ++j){
+					const vector_t& p = m_aaPos[e->vertex(j)];
+					for(int d = 0; d < dim; ++d){
+						m_box.min[d] = std::min(m_box.min[d], p[d]);
+						m_box.max[d] = std::max(m_box.max[d], p[d]);
+					}
+				}
+			}
+
+		//	the neighbor walk requires the elements associated with a vertex.
+		//	The option is enabled here, since it must not be enabled
+		//	concurrently during locate.
+			Grid& grid = *m_pGrid;
+			const uint opt = (dim == 1) ? VRTOPT_STORE_ASSOCIATED_EDGES
+							 : ((dim == 2) ? VRTOPT_STORE_ASSOCIATED_FACES
+										   : VRTOPT_STORE_ASSOCIATED_VOLUMES);
+			if(!grid.option_is_enabled(opt))
+				grid.enable_options(opt);
+		}
+
+	///	number of elements in which points are searched
+		size_t num_elements() const	{return m_vElem.size();}
+
+	///	bounding box of all elements (min > max if there are no elements)
+		const AABox<vector_t>& bounding_box() const	{return m_box;}
+
+	///	sets the number of threads used in locate
+		void set_num_threads(size_t numThreads) {m_team.set_num_threads(numThreads);}
+
+	///	returns the number of threads
+		size_t num_threads() const {return m_team.num_threads();}
+
+	///	threads used in locate, e.g. to process the located points
+	/**	The team must not be used concurrently with locate.*/
+		ThreadTeam& thread_team() const {return m_team;}
+
+	///	sets the maximal number of steps of the neighbor walk before the tree is used
+		void set_max_walk_steps(size_t numSteps) {m_maxWalkSteps = numSteps;}
+
+	///	returns whether the element is one of the elements of the locator
+		bool contains(elem_t* e) const
+		{
+			return std::binary_search(m_vElem.begin(), m_vElem.end(), e);
+		}
+
+	///	computes the order of the given points along a Morton curve
+		static void morton_order(std::vector<size_t>& vOrderOut,
+								 const std::vector<vector_t>& vPos)
+		{
+			vOrderOut.resize(vPos.size());
+			if(vPos.empty()) return;
+
+			vector_t boxMin = vPos[0], boxMax = vPos[0];
+			for(size_t i = 1; i < vPos.size(); ++i){
+				for(int d = 0; d < dim; ++d){
+					boxMin[d] = std::min(boxMin[d], vPos[i][d]);
+					boxMax[d] = std::max(boxMax[d], vPos[i][d]);
+				}
+			}
+
+			std::vector<std::pair<uint64, size_t> > vKey(vPos.size());
+			for(size_t i = 0; i < vPos.size(); ++i)
+				vKey[i] = std::make_pair(SpaceFillingCurveIndex(vPos[i], boxMin, boxMax,
+																  SFC_MORTON), i);
+			std::sort(vKey.begin(), vKey.end());
+
+			for(size_t i = 0; i < vKey.size(); ++i)
+				vOrderOut[i] = vKey[i].second;
+		}
+
+	///	locates all given points
+	/**
+	 * \param[out]	vElemOut	containing element for each point (NULL if not found)
+	 * \param[out]	vLocPosOut	local coordinates of each point in its element
+	 * \param[in]	vPos		the points
+	 * \param[out]	pOrderOut	(optional) order of the points along the Morton
+	 *							curve, e.g. to evaluate them in this order.*/
+		void locate(std::vector<elem_t*>& vElemOut,
+					std::vector<vector_t>& vLocPosOut,
+					const std::vector<vector_t>& vPos,
+					std::vector<size_t>* pOrderOut = NULL) const
+		{
+			PROFILE_FUNC_GROUP("discretization");
+			std::vector<size_t> vOrderTmp;
+			std::vector<size_t>& vOrder = (pOrderOut != NULL) ? *pOrderOut : vOrderTmp;
+			morton_order(vOrder, vPos);
+
+			vElemOut.assign(vPos.size(), NULL);
+			vLocPosOut.resize(vPos.size());
+
+			m_team.run_ranges(vOrder.size(),
+							  LocateRange(*this, vOrder, vPos, vElemOut, vLocPosOut));
+		}
+
+	///	locates a single point, using the given element as start of the walk
+	/**	seed may be NULL. Returns NULL if the point was not found.*/
+		elem_t* locate(const vector_t& p, elem_t* seed) const
+		{
+			elem_t* e = (seed != NULL) ? walk(p, seed) : NULL;
+			if(e == NULL){
+				if(!m_box.contains_point(p) || !FindContainingElement(e, m_tree, p))
+					return NULL;
+			}
+			return e;
+		}
+
+	///	computes the local coordinates of a point inside an element
+		void local_coordinates(vector_t& locPos, elem_t* e, const vector_t& p,
+							   std::vector<vector_t>& vCornerTmp) const
+		{
+			CollectCornerCoordinates(vCornerTmp, *e, *m_spDomain);
+			VecSet(locPos, 0.5);
+			batch_point_detail::LocalCoordinates<dim>::compute(
+					locPos, e->reference_object_id(), &vCornerTmp[0], p);
+		}
+
+	protected:
+	///	walks from the seed through vertex-neighbors to an element containing p
+		elem_t* walk(const vector_t& p, elem_t* seed) const
+		{
+			typename Grid::traits<elem_t>::secure_container assElems;
+
+			elem_t* cur = seed;
+			if(ContainsPoint(cur, p, m_aaPos)) return cur;
+			number curDist = VecDistanceSq(center(cur), p);
+
+			for(size_t step = 0; step < m_maxWalkSteps; ++step){
+				elem_t* best = NULL;
+				number bestDist = curDist;
+				for(size_t i = 0; i < cur->num_vertices(); ++i){
+					m_pGrid->associated_elements(assElems, cur->vertex(i));
+					for(size_t j = 0; j < assElems.size(); ++j){
+						elem_t* e = assElems[j];
+						if(e == cur || !contains(e)) continue;
+						if(ContainsPoint(e, p, m_aaPos)) return e;
+						const number dist = VecDistanceSq(center(e), p);
+						if(dist < bestDist){
+							best = e;
+							bestDist = dist;
+						}
+					}
+				}
+				if(best == NULL) return NULL;
+				cur = best;
+				curDist = bestDist;
+			}
+			return NULL;
+		}
+
+	///	center of the corners of an element
+		vector_t center(elem_t* e) const
+		{
+			vector_t c;
+			VecSet(c, 0);
+			for(size_t i = 0; i < e->num_vertices(); ++i)
+				VecAppend(c, m_aaPos[e->vertex(i)]);
+			VecScale(c, c, 1.0 / (number)e->num_vertices());
+			return c;
+		}
+
+	///	locates a range of the sorted points, seeding each walk with the previous hit
+		struct LocateRange
+		{
+			LocateRange(const BatchPointLocator& loc, const std::vector<size_t>& order,
+						const std::vector<vector_t>& pos, std::vector<elem_t*>& elems,
+						std::vector<vector_t>& locPos)
+				: locator(loc), vOrder(order), vPos(pos), vElem(elems), vLocPos(locPos) {}
+
+			void operator()(size_t begin, size_t end, size_t) const
+			{
+				std::vector<vector_t> vCorner;
+				elem_t* seed = NULL;
+				for(size_t k = begin; k < end; ++k){
+					const size_t i = vOrder[k];
+					elem_t* e = locator.locate(vPos[i], seed);
+					vElem[i] = e;
+					if(e == NULL) continue;
+					locator.local_coordinates(vLocPos[i], e, vPos[i], vCorner);
+					seed = e;
+				}
+			}
+
+			const BatchPointLocator& locator;
+			const std::vector<size_t>& vOrder;
+			const std::vector<vector_t>& vPos;
+			std::vector<elem_t*>& vElem;
+			std::vector<vector_t>& vLocPos;
+		};
+
+	protected:
+		SmartPtr<TDomain> m_spDomain;
+		Grid* m_pGrid;
+		typename TDomain::position_accessor_type m_aaPos;
+		tree_t m_tree;
+
+	///	sorted elements of the tree, used to restrict the neighbor walk
+		std::vector<elem_t*> m_vElem;
+
+	///	bounding box of the elements
+		AABox<vector_t> m_box;
+
+	///	threads used in locate (mutable, since locate is const)
+		mutable ThreadTeam m_team;
+
+		size_t m_maxWalkSteps;
+};
+
+
+///	evaluates a batch of points on the processes whose elements contain them
+/**
+ * The evaluation on one process is performed by a single call of
+ * \code
+ * 	localEval(vValOut, vFoundOut, vPos)
+ * \endcode
+ * which has to resize vValOut to valSize * vPos.size() and vFoundOut to
+ * vPos.size() and return the values and whether each point was found.
+ *
+ * In parallel, the points given on a process may differ from those given on
+ * other processes. After the bounding boxes of all processes are gathered, each
+ * point is sent to all processes whose box contains it in a single all-to-all
+ * exchange. The values are returned in a second all-to-all exchange. If a
+ * point is found on several processes (e.g. on a process boundary), the mean
+ * of the values is used.
+ *
+ * \param[out]	vValOut		values (valSize per point, 0 if not found)
+ * \param[out]	vFoundOut	whether each point was found on some process
+ * \param[in]	vPos		points given on this process
+ * \param[in]	valSize		number of values per point
+ * \param[in]	localBox	bounding box of the elements of this process
+ * \param[in]	localEval	evaluator for points on this process
+ */
+template <int dim, typename TLocalEval>
+void EvaluateBatchOnOwningProcs(std::vector<number>& vValOut,
+								std::vector<char>& vFoundOut,
+								const std::vector<MathVector<dim> >& vPos,
+								size_t valSize,
+								const AABox<MathVector<dim> >& localBox,
+								TLocalEval& localEval)
+{
+	PROFILE_FUNC_GROUP("discretization");
+#ifdef UG_PARALLEL
+	pcl::ProcessCommunicator com;
+	const int numProcs = (int)com.size();
+	if(numProcs > 1)
+	{
+	//	gather the bounding boxes of all processes
+		std::vector<number> vBox(2*dim), vProcBox(2*dim*numProcs);
+		for(int d = 0; d < dim; ++d){
+			vBox[d] = localBox.min[d];
+			vBox[dim + d] = localBox.max[d];
+		}
+		com.allgather(&vBox[0], 2*dim, PCL_DT_DOUBLE, &vProcBox[0], 2*dim, PCL_DT_DOUBLE);
+
+	//	slightly enlarged, so that points on the boundary of a box are sent
+		std::vector<number> vTol(numProcs);
+		for(int p = 0; p < numProcs; ++p){
+			number ext = 0;
+			for(int d = 0; d < dim; ++d)
+				ext = std::max(ext, vProcBox[2*dim*p + dim + d] - vProcBox[2*dim*p + d]);
+			vTol[p] = SMALL * std::max<number>(ext, 1);
+		}
+
+	//	collect the points for each process (two passes: count, then fill)
+		std::vector<int> vSendCnt(numProcs, 0), vSendOff(numProcs + 1, 0);
+		std::vector<int> vProcs;
+		std::vector<size_t> vProcsOff(vPos.size() + 1, 0);
+		for(size_t i = 0; i < vPos.size(); ++i){
+			for(int p = 0; p < numProcs; ++p){
+				const number* box = &vProcBox[2*dim*p];
+				bool inside = true;
+				for(int d = 0; d < dim; ++d){
+					if(vPos[i][d] < box[d] - vTol[p] || vPos[i][d] > box[dim + d] + vTol[p]){
+						inside = false;
+						break;
+					}
+				}
+				if(inside){
+					vProcs.push_back(p);
+					++vSendCnt[p];
+				}
+			}
+			vProcsOff[i+1] = vProcs.size();
+		}
+		for(int p = 0; p < numProcs; ++p)
+			vSendOff[p+1] = vSendOff[p] + vSendCnt[p];
+
+		std::vector<number> vSendPos(dim * vProcs.size());
+		std::vector<size_t> vSendInd(vProcs.size());
+		std::vector<int> vFill(vSendOff.begin(), vSendOff.end() - 1);
+		for(size_t i = 0; i < vPos.size(); ++i){
+			for(size_t k = vProcsOff[i]; k < vProcsOff[i+1]; ++k){
+				const int slot = vFill[vProcs[k]]++;
+				vSendInd[slot] = i;
+				for(int d = 0; d < dim; ++d)
+					vSendPos[dim * slot + d] = vPos[i][d];
+			}
+		}
+
+	//	exchange the points
+		std::vector<int> vRecvCnt(numProcs), vRecvOff(numProcs + 1, 0);
+		com.alltoall(&vSendCnt[0], 1, PCL_DT_INT, &vRecvCnt[0], 1, PCL_DT_INT);
+		for(int p = 0; p < numProcs; ++p)
+			vRecvOff[p+1] = vRecvOff[p] + vRecvCnt[p];
+
+		std::vector<int> vCnt(numProcs), vOff(numProcs), vCntR(numProcs), vOffR(numProcs);
+		for(int p = 0; p < numProcs; ++p){
+			vCnt[p] = dim * vSendCnt[p];	vOff[p] = dim * vSendOff[p];
+			vCntR[p] = dim * vRecvCnt[p];	vOffR[p] = dim * vRecvOff[p];
+		}
+		std::vector<number> vRecvPos(dim * vRecvOff[numProcs] + 1);
+		vSendPos.resize(vSendPos.size() + 1);
+		com.alltoallv(&vSendPos[0], &vCnt[0], &vOff[0], PCL_DT_DOUBLE,
+					  &vRecvPos[0], &vCntR[0], &vOffR[0], PCL_DT_DOUBLE);
+
+	//	evaluate the received points
+		std::vector<MathVector<dim> > vLocalPos(vRecvOff[numProcs]);
+		for(size_t i = 0; i < vLocalPos.size(); ++i)
+			for(int d = 0; d < dim; ++d)
+				vLocalPos[i][d] = vRecvPos[dim * i + d];
+
+		std::vector<number> vLocalVal;
+		std::vector<char> vLocalFound;
+		localEval(vLocalVal, vLocalFound, vLocalPos);
+
+	//	send back values and found-flag
+		const int stride = (int)valSize + 1;
+		std::vector<number> vReply(stride * vLocalPos.size() + 1);
+		for(size_t i = 0; i < vLocalPos.size(); ++i){
+			for(size_t c = 0; c < valSize; ++c)
+				vReply[stride * i + c] = vLocalVal[valSize * i + c];
+			vReply[stride * i + valSize] = vLocalFound[i] ? 1 : 0;
+		}
+		for(int p = 0; p < numProcs; ++p){
+			vCnt[p] = stride * vRecvCnt[p];	vOff[p] = stride * vRecvOff[p];
+			vCntR[p] = stride * vSendCnt[p];	vOffR[p] = stride * vSendOff[p];
+		}
+		std::vector<number> vAnswer(stride * vSendInd.size() + 1);
+		com.alltoallv(&vReply[0], &vCnt[0], &vOff[0], PCL_DT_DOUBLE,
+					  &vAnswer[0], &vCntR[0], &vOffR[0], PCL_DT_DOUBLE);
+
+	//	average values of points found on several processes
+		vValOut.assign(valSize * vPos.size(), 0);
+		std::vector<int> vNumFound(vPos.size(), 0);
+		for(size_t k = 0; k < vSendInd.size(); ++k){
+			if(vAnswer[stride * k + valSize] == 0) continue;
+			const size_t i = vSendInd[k];
+			for(size_t c = 0; c < valSize; ++c)
+				vValOut[valSize * i + c] += vAnswer[stride * k + c];
+			++vNumFound[i];
+		}
+
+		vFoundOut.resize(vPos.size());
+		for(size_t i = 0; i < vPos.size(); ++i){
+			vFoundOut[i] = (vNumFound[i] > 0);
+			if(vNumFound[i] > 1)
+				for(size_t c = 0; c < valSize; ++c)
+					vValOut[valSize * i + c] /= vNumFound[i];
+		}
+		return;
+	}
+#endif
+
+	localEval(vValOut, vFoundOut, vPos);
+}
+
+
+///	Evaluates components of a grid function at large sets of points
+/**
+ * The points are located by a BatchPointLocator and the shape functions of
+ * the components are evaluated concurrently on the threads of the locator,
+ * which are reused for all calls to evaluate. In parallel, each point is
+ * evaluated on the processes owning it, see EvaluateBatchOnOwningProcs.
+ *
+ * Points are searched in the elements of all subsets in which all of the
+ * given components are defined.
+ */
+template <typename TGridFunction>
+class GridFunctionBatchEvaluator
+{
+	public:
+	///	world dimension of grid function
+		static const int dim = TGridFunction::dim;
+
+	///	domain type
+		typedef typename TGridFunction::domain_type domain_type;
+
+	///	element type
+		typedef typename BatchPointLocator<domain_type>::elem_t elem_t;
+
+	public:
+	///	constructor
+		GridFunctionBatchEvaluator(SmartPtr<TGridFunction> spGridFct, const char* cmps)
+			: m_spGridFct(spGridFct), m_locator(spGridFct->domain())
+		{
+			m_fctGrp = spGridFct->fct_grp_by_name(cmps);
+			if(m_fctGrp.size() == 0)
+				UG_THROW("GridFunctionBatchEvaluator: No components given.");
+
+			std::vector<elem_t*> vElem;
+			SubsetGroup ssGrp(spGridFct->domain()->subset_handler());
+			ssGrp.add_all();
+			for(size_t s = 0; s < ssGrp.size(); ++s){
+				const int si = ssGrp[s];
+				bool bDefined = true;
+				for(size_t f = 0; f < m_fctGrp.size(); ++f)
+					bDefined &= spGridFct->is_def_in_subset(m_fctGrp[f], si);
+				if(!bDefined) continue;
+
+				typename TGridFunction::template traits<elem_t>::const_iterator iter, iterEnd;
+				iterEnd = spGridFct->template end<elem_t>(si);
+				for(iter = spGridFct->template begin<elem_t>(si); iter != iterEnd; ++iter)
+					vElem.push_back(*iter);
+			}
+			m_locator.set_elements(vElem.begin(), vElem.end());
+		}
+
+	///	sets the number of threads used for location and evaluation
+		void set_num_threads(size_t numThreads) {m_locator.set_num_threads(numThreads);}
+
+	///	sets the maximal number of steps of the neighbor walk
+		void set_max_walk_steps(size_t numSteps) {m_locator.set_max_walk_steps(numSteps);}
+
+	///	number of values per point
+		size_t num_components() const {return m_fctGrp.size();}
+
+	///	evaluates all components at the given points
+	/**	Values are returned point by point, i.e. vValOut[i*num_components() + c].
+	 * This method is collective in parallel.*/
+		void evaluate(std::vector<number>& vValOut, std::vector<char>& vFoundOut,
+					  const std::vector<MathVector<dim> >& vPos)
+		{
+			EvaluateBatchOnOwningProcs<dim>(vValOut, vFoundOut, vPos, m_fctGrp.size(),
+											m_locator.bounding_box(), *this);
+		}
+
+	///	evaluates all components at the points given as flat array of coordinates
+	/**	Throws if a point is not found on any process.*/
+		std::vector<number> evaluate(const std::vector<number>& vCoords)
+		{
+			std::vector<MathVector<dim> > vPos;
+			FlatCoordinatesToPositions<dim>(vPos, vCoords);
+
+			std::vector<number> vVal;
+			std::vector<char> vFound;
+			evaluate(vVal, vFound, vPos);
+
+			for(size_t i = 0; i < vFound.size(); ++i)
+				if(!vFound[i])
+					UG_THROW("GridFunctionBatchEvaluator: Couldn't find an "
+							 "element containing the point " << vPos[i]);
+			return vVal;
+		}
+
+	///	evaluates the points on this process only
+		void operator()(std::vector<number>& vValOut, std::vector<char>& vFoundOut,
+						const std::vector<MathVector<dim> >& vPos) const
+		{
+			std::vector<elem_t*> vElem;
+			std::vector<MathVector<dim> > vLocPos;
+			std::vector<size_t> vOrder;
+			m_locator.locate(vElem, vLocPos, vPos, &vOrder);
+
+		//	request the shape function sets before the threads start, since
+		//	the provider creates them on first access
+			std::vector<const LocalShapeFunctionSet<dim>*> vTrialSpace(
+					NUM_REFERENCE_OBJECTS * m_fctGrp.size(), NULL);
+			for(size_t i = 0; i < vElem.size(); ++i){
+				if(vElem[i] == NULL) continue;
+				const ReferenceObjectID roid = vElem[i]->reference_object_id();
+				if(vTrialSpace[roid * m_fctGrp.size()] != NULL) continue;
+				for(size_t f = 0; f < m_fctGrp.size(); ++f)
+					vTrialSpace[roid * m_fctGrp.size() + f] =
+						&LocalFiniteElementProvider::get<dim>(roid,
+							m_spGridFct->local_finite_element_id(m_fctGrp[f]));
+			}
+
+			vValOut.assign(m_fctGrp.size() * vPos.size(), 0);
+			vFoundOut.resize(vPos.size());
+			for(size_t i = 0; i < vElem.size(); ++i)
+				vFoundOut[i] = (vElem[i] != NULL);
+
+			m_locator.thread_team().run_ranges(vOrder.size(),
+					EvaluateRange(*this, vOrder, vElem, vLocPos, vTrialSpace, vValOut));
+		}
+
+	protected:
+	///	evaluates the components for a range of the sorted points
+		struct EvaluateRange
+		{
+			EvaluateRange(const GridFunctionBatchEvaluator& ev,
+						  const std::vector<size_t>& order,
+						  const std::vector<elem_t*>& elems,
+						  const std::vector<MathVector<dim> >& locPos,
+						  const std::vector<const LocalShapeFunctionSet<dim>*>& trialSpace,
+						  std::vector<number>& val)
+				: eval(ev), vOrder(order), vElem(elems), vLocPos(locPos),
+				  vTrialSpace(trialSpace), vVal(val) {}
+
+			void operator()(size_t begin, size_t end, size_t) const
+			{
+				const TGridFunction& u = *eval.m_spGridFct;
+				const size_t numFct = eval.m_fctGrp.size();
+				std::vector<number> vShape;
+				std::vector<DoFIndex> vInd;
+				for(size_t k = begin; k < end; ++k){
+					const size_t i = vOrder[k];
+					elem_t* e = vElem[i];
+					if(e == NULL) continue;
+					const ReferenceObjectID roid = e->reference_object_id();
+					for(size_t f = 0; f < numFct; ++f){
+						vTrialSpace[roid * numFct + f]->shapes(vShape, vLocPos[i]);
+						u.dof_indices(e, eval.m_fctGrp[f], vInd);
+						number value = 0;
+						for(size_t sh = 0; sh < vShape.size(); ++sh)
+							value += DoFRef(u, vInd[sh]) * vShape[sh];
+						vVal[numFct * i + f] = value;
+					}
+				}
+			}
+
+			const GridFunctionBatchEvaluator& eval;
+			const std::vector<size_t>& vOrder;
+			const std::vector<elem_t*>& vElem;
+			const std::vector<MathVector<dim> >& vLocPos;
+			const std::vector<const LocalShapeFunctionSet<dim>*>& vTrialSpace;
+			std::vector<number>& vVal;
+		};
+
+	protected:
+		SmartPtr<TGridFunction> m_spGridFct;
+		FunctionGroup m_fctGrp;
+		BatchPointLocator<domain_type> m_locator;
+};
+
+}//	end of namespace ug
+
+#endif /* __H__UG__LIB_DISC__FUNCTION_SPACE__BATCH_POINT_EVALUATION__ */
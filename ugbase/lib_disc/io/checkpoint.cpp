@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include "checkpoint.h"
+#include "common/profiler/profiler.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_grid/parallelization/distributed_grid.h"
+	#include "lib_grid/parallelization/parallelization_util.h"
+#endif
+
+namespace ug{
+
+///	assigns global ids to all objects of the given type
+/**	\returns true if aGeomObjID was attached by this call, i.e. if the caller
+ * has to detach it again.*/
+template <class TElem>
+static bool CreateCheckpointGlobalIDs(MultiGrid& mg)
+{
+	const bool attach = !mg.has_attachment<TElem>(aGeomObjID);
+#ifdef UG_PARALLEL
+	DistributedGridManager* dgm = mg.distributed_grid_manager();
+	if(dgm){
+		CreateAndDistributeGlobalIDs<TElem>(mg, dgm->grid_layout_map());
+		return attach;
+	}
+#endif
+	if(attach)
+		mg.attach_to<TElem>(aGeomObjID);
+	Grid::AttachmentAccessor<TElem, AGeomObjID> aaID(mg, aGeomObjID);
+	size_t localID = 0;
+	for(typename Grid::traits<TElem>::iterator iter = mg.begin<TElem>();
+		iter != mg.end<TElem>(); ++iter, ++localID)
+	{
+		aaID[*iter] = MakeGeomObjID(0, localID);
+	}
+	return attach;
+}
+
+///	returns the objects of the given type sorted by the indices assigned during serialization
+template <class TElem>
+static void CollectInSerializationOrder(std::vector<TElem*>& vElemsOut, MultiGrid& mg,
+										MultiElementAttachmentAccessor<AInt>& aaIndex)
+{
+	vElemsOut.resize(mg.num<TElem>());
+	for(typename Grid::traits<TElem>::iterator iter = mg.begin<TElem>();
+		iter != mg.end<TElem>(); ++iter)
+	{
+		vElemsOut[aaIndex[*iter]] = *iter;
+	}
+}
+
+///	writes a flag for each object, which is false for ghosts
+template <class TElem>
+static void WriteCheckpointOwnership(BinaryBuffer& out, MultiGrid& mg,
+									 const std::vector<TElem*>& vElems)
+{
+	std::vector<char> owned(vElems.size(), 1);
+#ifdef UG_PARALLEL
+	DistributedGridManager* dgm = mg.distributed_grid_manager();
+	if(dgm){
+		for(size_t i = 0; i < vElems.size(); ++i)
+			owned[i] = !dgm->is_ghost(vElems[i]);
+	}
+#endif
+	Serialize(out, owned);
+}
+
+///	the part index is assigned to all objects which were flagged as owned
+template <class TElem>
+static void ReadCheckpointOwnership(BinaryBuffer& in,
+									MultiElementAttachmentAccessor<AInt>& aaOwner,
+									const std::vector<TElem*>& vElems, int part)
+{
+	std::vector<char> owned;
+	Deserialize(in, owned);
+	UG_COND_THROW(owned.size() != vElems.size(),
+				  "Corrupt ownership information in part " << part << " of checkpoint.");
+	for(size_t i = 0; i < vElems.size(); ++i){
+		if(owned[i])
+			aaOwner[vElems[i]] = part;
+	}
+}
+
+///	elements of part p are assigned to subset p*numTargetProcs/numParts
+/**	Elements which are ghosts in all parts inherit the subset of their parent.*/
+template <class TElem>
+static void AssignCheckpointPartition(SubsetHandler& shPartition, MultiGrid& mg,
+									  MultiElementAttachmentAccessor<AInt>& aaOwner,
+									  int numParts, int numTargetProcs)
+{
+	for(size_t lvl = 0; lvl < mg.num_levels(); ++lvl){
+		for(typename Grid::traits<TElem>::iterator iter = mg.begin<TElem>(lvl);
+			iter != mg.end<TElem>(lvl); ++iter)
+		{
+			TElem* e = *iter;
+			int target = 0;
+			if(aaOwner[e] >= 0)
+				target = (int)((long long)aaOwner[e] * numTargetProcs / numParts);
+			else{
+				TElem* parent = dynamic_cast<TElem*>(mg.get_parent(e));
+				if(parent)
+					target = std::max(0, shPartition.get_subset_index(parent));
+			}
+			shPartition.assign_subset(e, target);
+		}
+	}
+}
+
+
+void SerializeCheckpointPart(MultiGrid& mg, GridDataSerializationHandler& serializer,
+							 BinaryBuffer& out)
+{
+	PROFILE_FUNC_GROUP("disc");
+	const bool vrtIDs = CreateCheckpointGlobalIDs<Vertex>(mg);
+	const bool edgeIDs = CreateCheckpointGlobalIDs<Edge>(mg);
+	const bool faceIDs = CreateCheckpointGlobalIDs<Face>(mg);
+	const bool volIDs = CreateCheckpointGlobalIDs<Volume>(mg);
+
+	AInt aIndex;
+	mg.attach_to_all(aIndex);
+	MultiElementAttachmentAccessor<AInt> aaIndex(mg, aIndex);
+	MultiElementAttachmentAccessor<AGeomObjID> aaID(mg, aGeomObjID);
+
+	UG_COND_THROW(!SerializeMultiGridElements(mg, mg.get_grid_objects(), aaIndex, out, &aaID),
+				  "SerializeCheckpointPart: Serialization of the grid failed.");
+
+	std::vector<Vertex*> vVrts;
+	std::vector<Edge*> vEdges;
+	std::vector<Face*> vFaces;
+	std::vector<Volume*> vVols;
+	CollectInSerializationOrder(vVrts, mg, aaIndex);
+	CollectInSerializationOrder(vEdges, mg, aaIndex);
+	CollectInSerializationOrder(vFaces, mg, aaIndex);
+	CollectInSerializationOrder(vVols, mg, aaIndex);
+	mg.detach_from_all(aIndex);
+
+//	the ids are only needed for the serialization of the grid
+	if(vrtIDs) mg.detach_from_vertices(aGeomObjID);
+	if(edgeIDs) mg.detach_from_edges(aGeomObjID);
+	if(faceIDs) mg.detach_from_faces(aGeomObjID);
+	if(volIDs) mg.detach_from_volumes(aGeomObjID);
+
+	serializer.write_infos(out);
+	serializer.serialize(out, vVrts.begin(), vVrts.end());
+	serializer.serialize(out, vEdges.begin(), vEdges.end());
+	serializer.serialize(out, vFaces.begin(), vFaces.end());
+	serializer.serialize(out, vVols.begin(), vVols.end());
+
+	WriteCheckpointOwnership(out, mg, vVrts);
+	WriteCheckpointOwnership(out, mg, vEdges);
+	WriteCheckpointOwnership(out, mg, vFaces);
+	WriteCheckpointOwnership(out, mg, vVols);
+}
+
+
+void MergeCheckpointParts(MultiGrid& mg, const CheckpointArchive& archive,
+						  GridDataSerializationHandler& serializer,
+						  SubsetHandler& shPartition, int numTargetProcs)
+{
+	PROFILE_FUNC_GROUP("disc");
+	const bool attachIDs = !mg.has_vertex_attachment(aGeomObjID);
+	if(attachIDs)
+		mg.attach_to_all(aGeomObjID);
+	MultiElementAttachmentAccessor<AGeomObjID> aaID(mg, aGeomObjID);
+
+	AInt aOwner;
+	mg.attach_to_all_dv(aOwner, -1);
+	MultiElementAttachmentAccessor<AInt> aaOwner(mg, aOwner);
+
+	std::vector<Vertex*> vVrts;
+	std::vector<Edge*> vEdges;
+	std::vector<Face*> vFaces;
+	std::vector<Volume*> vVols;
+
+//	copies of objects in several parts are identified through their global ids
+	serializer.deserialization_starts();
+	for(size_t i = 0; i < archive.num_parts(); ++i){
+		BinaryBuffer in;
+		archive.read_part(i, in);
+		UG_COND_THROW(!DeserializeMultiGridElements(mg, in, &vVrts, &vEdges,
+													&vFaces, &vVols, &aaID),
+					  "MergeCheckpointParts: Deserialization of part " << i << " failed.");
+
+		serializer.read_infos(in);
+		serializer.deserialize(in, vVrts.begin(), vVrts.end());
+		serializer.deserialize(in, vEdges.begin(), vEdges.end());
+		serializer.deserialize(in, vFaces.begin(), vFaces.end());
+		serializer.deserialize(in, vVols.begin(), vVols.end());
+
+		ReadCheckpointOwnership(in, aaOwner, vVrts, (int)i);
+		ReadCheckpointOwnership(in, aaOwner, vEdges, (int)i);
+		ReadCheckpointOwnership(in, aaOwner, vFaces, (int)i);
+		ReadCheckpointOwnership(in, aaOwner, vVols, (int)i);
+	}
+	serializer.deserialization_done();
+
+	const int numParts = (int)archive.num_parts();
+	if(mg.num<Volume>() > 0)
+		AssignCheckpointPartition<Volume>(shPartition, mg, aaOwner, numParts, numTargetProcs);
+	else if(mg.num<Face>() > 0)
+		AssignCheckpointPartition<Face>(shPartition, mg, aaOwner, numParts, numTargetProcs);
+	else if(mg.num<Edge>() > 0)
+		AssignCheckpointPartition<Edge>(shPartition, mg, aaOwner, numParts, numTargetProcs);
+	else
+		AssignCheckpointPartition<Vertex>(shPartition, mg, aaOwner, numParts, numTargetProcs);
+
+	mg.detach_from_all(aOwner);
+	if(attachIDs)
+		mg.detach_from_all(aGeomObjID);
+}
+
+}//	end of namespace
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/util/smart_pointer.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "checkpoint_archive.h"
+
+namespace ug{
+
+///	values of all functions of a checkpoint which are associated with a grid object
+typedef Attachment<std::vector<number> >	ACheckpointValues;
+
+///	Serializes values stored in an ACheckpointValues attachment
+/**	On deserialization empty value sets don't replace existing ones. This is
+ * required since ghost copies of grid objects don't carry any DoFs.*/
+template <class TElem>
+class CheckpointValueSerializer : public GeomObjDataSerializer<TElem>
+{
+	public:
+		static SmartPtr<GeomObjDataSerializer<TElem> >
+		create(Grid& g, ACheckpointValues a)
+		{return SmartPtr<GeomObjDataSerializer<TElem> >(new CheckpointValueSerializer(g, a));}
+
+		CheckpointValueSerializer(Grid& g, ACheckpointValues a) :
+			m_aa(g, a, true)	{}
+
+		virtual ~CheckpointValueSerializer() {};
+
+		virtual void write_data(BinaryBuffer& out, TElem* o) const
+		{Serialize(out, m_aa[o]);}
+
+		virtual void read_data(BinaryBuffer& in, TElem* o)
+		{
+			Deserialize(in, m_tmp);
+			if(!m_tmp.empty())
+				m_aa[o].swap(m_tmp);
+		}
+
+	private:
+		Grid::AttachmentAccessor<TElem, ACheckpointValues>	m_aa;
+		std::vector<number>	m_tmp;
+};
+
+///	serializes the local part of the multigrid hierarchy for a checkpoint
+/**	Global ids are assigned to all grid objects first. The grid objects are
+ * followed by the data of the given serializer and by a flag for each object,
+ * which tells whether the object is a ghost. aGeomObjID is detached again
+ * afterwards, unless it was already attached before the call.*/
+void SerializeCheckpointPart(MultiGrid& mg, GridDataSerializationHandler& serializer,
+							 BinaryBuffer& out);
+
+///	merges all parts of the archive into the given (empty) multigrid
+/**	The elements of highest dimension are assigned to subsets of shPartition,
+ * so that elements of part p are assigned to p*numTargetProcs/numParts.
+ * The global ids of the parts are only used while merging. aGeomObjID is
+ * detached again afterwards, unless it was already attached before the call.*/
+void MergeCheckpointParts(MultiGrid& mg, const CheckpointArchive& archive,
+						  GridDataSerializationHandler& serializer,
+						  SubsetHandler& shPartition, int numTargetProcs);
+
+///	Writes and restores the state of a simulation, independent of the number of processes.
+/**	A checkpoint contains the complete multigrid hierarchy of a domain
+ * (positions, subset handler and additional subset handlers), the values of
+ * all registered grid functions and a set of named numbers, e.g. the current
+ * time, step size or step index of a time integrator.
+ *
+ * All processes write their part of the hierarchy together with global ids
+ * of the grid objects into one archive. DoF values are stored per grid
+ * object, so that they do not depend on the algebraic ordering. write() only
+ * serializes the local data and starts the transfer. The computation may
+ * continue while the data is written. The data is complete once wait() was
+ * called or the next checkpoint is written.
+ *
+ * read_domain() may be executed on a different number of processes than the
+ * one which wrote the archive. The first process merges the stored parts of
+ * the hierarchy and distributes the grid so that old process p sends its
+ * elements to new process p*M/N, where N and M are the old and new numbers of
+ * processes. Afterwards approximation spaces and grid functions may be
+ * created on the domain as usual and restore() writes the stored values to
+ * them. Use the load balancer afterwards if a better distribution is required.
+ *
+ * Refinement projectors of the domain are not stored.*/
+template <typename TDomain, typename TAlgebra>
+class Checkpoint
+{
+	public:
+		typedef GridFunction<TDomain, TAlgebra>				function_type;
+		typedef typename TDomain::position_attachment_type	position_attachment_type;
+
+		typedef ACheckpointValues							AValues;
+
+	public:
+		Checkpoint();
+		~Checkpoint();
+
+	///	adds a grid function whose values are written on each call to write
+	/**	All functions have to be defined on the same domain.*/
+		void add(SmartPtr<function_type> u, const char* name);
+
+	///	sets a named number which is written with the checkpoint
+		void set_number(const char* name, number val);
+
+	///	returns a number set through set_number or read through read_domain
+		number get_number(const char* name) const;
+
+	///	returns true if a number with the given name exists
+		bool has_number(const char* name) const;
+
+	///	writes the domain and all added functions to the given file (collective)
+	/**	The call returns once the local data was serialized. The file is
+	 * complete after wait() was called.*/
+		void write(const char* filename);
+
+	///	blocks until the last written checkpoint is complete (collective)
+		void wait();
+
+	///	loads and distributes the grid and the stored values (collective)
+	/**	The grid of the given domain has to be empty.*/
+		void read_domain(SmartPtr<TDomain> dom, const char* filename);
+
+	///	returns true if values for the given name were read by read_domain
+		bool has_function(const char* name) const;
+
+	///	writes the values stored for name to the given grid function
+	/**	The grid function has to be defined on the domain passed to
+	 * read_domain and has to have the functions it had when it was written.*/
+		void restore(SmartPtr<function_type> u, const char* name);
+
+	///	releases the values read through read_domain
+		void release();
+
+	protected:
+	///	collects serializers for positions, subset handlers and the given values
+		void add_serializers(GridDataSerializationHandler& serializer, TDomain& dom,
+							 const std::vector<std::string>& vSHNames,
+							 std::vector<AValues>& vValues);
+
+	///	copies the values of u into the given attachment
+		template <typename TBaseElem>
+		void copy_values(MultiGrid& mg, AValues& aValues, const function_type& u);
+
+	///	copies the values in the given attachment into u
+		template <typename TBaseElem>
+		void copy_values(function_type& u, MultiGrid& mg, AValues& aValues);
+
+	protected:
+		struct FunctionEntry{
+			std::string				name;
+			SmartPtr<function_type>	spGridFct;
+		};
+
+	///	functions which are written
+		std::vector<FunctionEntry>	m_vFunctions;
+
+	///	named numbers
+		std::map<std::string, number>	m_numbers;
+
+		CheckpointArchiveWriter	m_writer;
+
+	///	domain, names, function names and values of the last read_domain
+		SmartPtr<TDomain>		m_spReadDomain;
+		std::vector<std::string>	m_vReadNames;
+		std::vector<std::vector<std::string> >	m_vReadFctNames;
+		std::vector<AValues>	m_vReadValues;
+};
+
+}//	end of namespace
+
+#include "checkpoint_impl.h"
+
+#endif
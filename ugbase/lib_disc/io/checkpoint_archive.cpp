@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "checkpoint_archive.h"
+#include "common/error.h"
+#include "common/log.h"
+#include "common/profiler/profiler.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_process_communicator.h"
+#endif
+
+namespace ug{
+
+static const char* const CheckpointArchiveMagic = "UG4CHKP";
+static const uint64 CheckpointArchiveVersion = 1;
+static const uint64 CheckpointArchiveAlignment = 64;
+
+static uint64 AlignCheckpointOffset(uint64 offset)
+{
+	return (offset + CheckpointArchiveAlignment - 1) / CheckpointArchiveAlignment
+			* CheckpointArchiveAlignment;
+}
+
+///	writes header, offset table and padding to head. Returns the offsets of all parts.
+static void CreateCheckpointArchiveHead(BinaryBuffer& head, std::vector<uint64>& partOffsets,
+										uint64 metaSize, const std::vector<uint64>& partSizes)
+{
+	const uint64 numParts = partSizes.size();
+	CheckpointArchiveHeader header;
+	memset(&header, 0, sizeof(header));
+	strcpy(header.magic, CheckpointArchiveMagic);
+	header.version = CheckpointArchiveVersion;
+	header.numParts = numParts;
+	header.tableOffset = sizeof(header);
+	header.metaOffset = AlignCheckpointOffset(header.tableOffset + 2 * numParts * sizeof(uint64));
+	header.metaSize = metaSize;
+
+	std::vector<uint64> table(2 * numParts);
+	partOffsets.resize(numParts);
+	uint64 offset = AlignCheckpointOffset(header.metaOffset + metaSize);
+	for(size_t i = 0; i < numParts; ++i){
+		partOffsets[i] = offset;
+		table[2*i] = offset;
+		table[2*i+1] = partSizes[i];
+		offset = AlignCheckpointOffset(offset + partSizes[i]);
+	}
+
+	head.clear();
+	head.write((const char*)&header, sizeof(header));
+	if(numParts > 0)
+		head.write((const char*)&table.front(), table.size() * sizeof(uint64));
+	static const char zeros[CheckpointArchiveAlignment] = {0};
+	head.write(zeros, header.metaOffset - head.write_pos());
+}
+
+
+CheckpointArchiveWriter::CheckpointArchiveWriter() :
+	m_bWriting(false)
+#ifndef UG_PARALLEL
+	, m_bFailed(false)
+#endif
+{
+}
+
+CheckpointArchiveWriter::~CheckpointArchiveWriter()
+{
+	try{
+		wait();
+	}
+	catch(UGError& err){
+		UG_LOG("WARNING in ~CheckpointArchiveWriter: " << err.get_msg() << "\n");
+	}
+}
+
+void CheckpointArchiveWriter::write(const std::string& filename,
+									BinaryBuffer& meta, BinaryBuffer& part)
+{
+	PROFILE_FUNC_GROUP("disc");
+	wait();
+
+	std::swap(m_meta, meta);
+	std::swap(m_part, part);
+	meta.clear();
+	part.clear();
+
+	std::vector<uint64> partOffsets;
+
+#ifdef UG_PARALLEL
+	pcl::ProcessCommunicator pc;
+	const size_t numProcs = pc.size();
+	const size_t rank = pc.get_local_proc_id();
+
+	uint64 metaSize = m_meta.write_pos();
+	pc.broadcast(&metaSize, 1, 0);
+
+	uint64 localSize = m_part.write_pos();
+	std::vector<uint64> partSizes(numProcs);
+	pc.allgather(&localSize, 1, PCL_DT_UNSIGNED_LONG_LONG,
+				 &partSizes.front(), 1, PCL_DT_UNSIGNED_LONG_LONG);
+
+	CreateCheckpointArchiveHead(m_head, partOffsets, metaSize, partSizes);
+
+	m_spFile = make_sp(new pcl::SharedFileWriter(filename, pc));
+	m_bWriting = true;
+	if(rank == 0){
+		m_spFile->iwrite_at(0, m_head.buffer(), m_head.write_pos());
+		if(metaSize > 0)
+			m_spFile->iwrite_at(m_head.write_pos(), m_meta.buffer(), metaSize);
+	}
+	if(localSize > 0)
+		m_spFile->iwrite_at(partOffsets[rank], m_part.buffer(), localSize);
+#else
+	std::vector<uint64> partSizes(1, m_part.write_pos());
+	CreateCheckpointArchiveHead(m_head, partOffsets, m_meta.write_pos(), partSizes);
+
+	m_filename = filename;
+	m_bFailed = false;
+	m_bWriting = true;
+	const uint64 partOffset = partOffsets[0];
+	m_thread = std::thread([this, partOffset](){
+		std::ofstream out(m_filename.c_str(), std::ios::binary | std::ios::trunc);
+		if(!out){
+			m_bFailed = true;
+			return;
+		}
+		out.write(m_head.buffer(), m_head.write_pos());
+		out.write(m_meta.buffer(), m_meta.write_pos());
+		static const char zeros[CheckpointArchiveAlignment] = {0};
+		out.write(zeros, partOffset - m_head.write_pos() - m_meta.write_pos());
+		out.write(m_part.buffer(), m_part.write_pos());
+		m_bFailed = !out.good();
+	});
+#endif
+}
+
+void CheckpointArchiveWriter::wait()
+{
+	if(!m_bWriting)
+		return;
+
+	m_bWriting = false;
+#ifdef UG_PARALLEL
+	m_spFile->close();
+	m_spFile = SPNULL;
+#else
+	m_thread.join();
+	UG_COND_THROW(m_bFailed, "CheckpointArchiveWriter: Could not write to file "
+				  << m_filename);
+#endif
+	m_head.clear();
+	m_meta.clear();
+	m_part.clear();
+}
+
+
+CheckpointArchive::CheckpointArchive(const char* filename) :
+	m_file(filename)
+{
+	UG_COND_THROW(m_file.size() < sizeof(CheckpointArchiveHeader),
+				  "CheckpointArchive: " << filename << " is not a checkpoint archive.");
+
+	CheckpointArchiveHeader header;
+	memcpy(&header, m_file.data(), sizeof(header));
+	UG_COND_THROW(strncmp(header.magic, CheckpointArchiveMagic, sizeof(header.magic)) != 0,
+				  "CheckpointArchive: " << filename << " is not a checkpoint archive.");
+	UG_COND_THROW(header.version != CheckpointArchiveVersion,
+				  "CheckpointArchive: unsupported version " << header.version
+				  << " in " << filename);
+	UG_COND_THROW(header.tableOffset > m_file.size()
+				  || header.numParts > (m_file.size() - header.tableOffset) / (2 * sizeof(uint64)),
+				  "CheckpointArchive: corrupt offset table in " << filename);
+
+	m_numParts = (size_t)header.numParts;
+	m_metaOffset = header.metaOffset;
+	m_metaSize = header.metaSize;
+	m_tableOffset = header.tableOffset;
+}
+
+void CheckpointArchive::read_block(uint64 offset, uint64 size, BinaryBuffer& out) const
+{
+	UG_COND_THROW(offset > m_file.size() || size > m_file.size() - offset,
+				  "CheckpointArchive: block exceeds the size of the file.");
+	if(size > 0)
+		out.write(m_file.data() + offset, (size_t)size);
+}
+
+void CheckpointArchive::read_meta(BinaryBuffer& out) const
+{
+	read_block(m_metaOffset, m_metaSize, out);
+}
+
+void CheckpointArchive::read_part(size_t i, BinaryBuffer& out) const
+{
+	UG_COND_THROW(i >= m_numParts, "CheckpointArchive: bad part index " << i);
+	uint64 entry[2];
+	memcpy(entry, m_file.data() + m_tableOffset + 2 * i * sizeof(uint64), sizeof(entry));
+	read_block(entry[0], entry[1], out);
+}
+
+}//	end of namespace
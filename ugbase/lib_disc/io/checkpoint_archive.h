@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT_ARCHIVE__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT_ARCHIVE__
+
+#include <string>
+#include "common/types.h"
+#include "common/util/binary_buffer.h"
+#include "common/util/mapped_file.h"
+#include "common/util/smart_pointer.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/parallel_file.h"
+#else
+	#include <thread>
+#endif
+
+namespace ug{
+
+///	Header at the start of each checkpoint archive (64 bytes)
+/**	An archive consists of
+ * 	- the header,
+ * 	- a table with offset and size of each part (2 x uint64 per part),
+ * 	- a meta block written by the first process,
+ * 	- one part for each process which wrote the archive.
+ *
+ * All blocks are aligned to 64 bytes.*/
+struct CheckpointArchiveHeader
+{
+	char	magic[8];
+	uint64	version;
+	uint64	numParts;
+	uint64	tableOffset;
+	uint64	metaOffset;
+	uint64	metaSize;
+	uint64	reserved[2];
+};
+
+///	Writes a checkpoint archive, in which each process stores one part.
+/**	write is collective on all processes. It only prepares the file layout and
+ * starts the transfer of the data. The call returns before the data has
+ * actually been written. wait() has to be called (again collectively) before
+ * the archive is complete. A new write waits for the previous one first.
+ *
+ * The writer takes over the contents of the passed buffers, so that they
+ * may be reused by the caller immediately.
+ *
+ * In parallel environments the data is written to one shared file through
+ * non-blocking MPI-IO. Serial builds write from a separate thread.*/
+class CheckpointArchiveWriter
+{
+	public:
+		CheckpointArchiveWriter();
+		~CheckpointArchiveWriter();
+
+	///	starts writing the archive. The meta buffer is only considered on the first process.
+		void write(const std::string& filename, BinaryBuffer& meta, BinaryBuffer& part);
+
+	///	blocks until the archive which is currently written is complete
+		void wait();
+
+	///	returns true if a write has been started and wait() wasn't called yet.
+		bool is_writing() const				{return m_bWriting;}
+
+	private:
+		CheckpointArchiveWriter(const CheckpointArchiveWriter&);
+		CheckpointArchiveWriter& operator=(const CheckpointArchiveWriter&);
+
+		BinaryBuffer				m_head;
+		BinaryBuffer				m_meta;
+		BinaryBuffer				m_part;
+		bool						m_bWriting;
+
+	#ifdef UG_PARALLEL
+		SmartPtr<pcl::SharedFileWriter>	m_spFile;
+	#else
+		std::thread					m_thread;
+		bool						m_bFailed;
+		std::string					m_filename;
+	#endif
+};
+
+///	Read access to a checkpoint archive written by CheckpointArchiveWriter
+/**	The file is mapped into memory. Throws an UGError if the file is not
+ * a valid archive.*/
+class CheckpointArchive
+{
+	public:
+		CheckpointArchive(const char* filename);
+
+	///	number of processes which wrote the archive
+		size_t num_parts() const			{return m_numParts;}
+
+	///	appends the meta block to the given buffer
+		void read_meta(BinaryBuffer& out) const;
+
+	///	appends the i-th part to the given buffer
+		void read_part(size_t i, BinaryBuffer& out) const;
+
+	private:
+		void read_block(uint64 offset, uint64 size, BinaryBuffer& out) const;
+
+		MappedFile	m_file;
+		size_t		m_numParts;
+		uint64		m_metaOffset;
+		uint64		m_metaSize;
+		uint64		m_tableOffset;
+};
+
+}//	end of namespace
+
+#endif
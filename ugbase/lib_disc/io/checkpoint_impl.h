@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__
+#define __H__UG__LIB_DISC__IO__CHECKPOINT_IMPL__
+
+#include "checkpoint.h"
+#include "common/profiler/profiler.h"
+#include "common/serialization.h"
+#include "lib_disc/common/multi_index.h"
+#include "lib_grid/lib_grid_messages.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+	#include "pcl/pcl_process_communicator.h"
+	#include "pcl/pcl_util.h"
+	#include "lib_grid/parallelization/distribution.h"
+	#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
+
+namespace ug{
+
+template <typename TDomain, typename TAlgebra>
+Checkpoint<TDomain, TAlgebra>::
+Checkpoint()
+{
+}
+
+template <typename TDomain, typename TAlgebra>
+Checkpoint<TDomain, TAlgebra>::
+~Checkpoint()
+{
+	release();
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+add(SmartPtr<function_type> u, const char* name)
+{
+	for(size_t i = 0; i < m_vFunctions.size(); ++i){
+		UG_COND_THROW(m_vFunctions[i].name == name,
+					  "Checkpoint::add: A function named '" << name << "' was already added.");
+	}
+	if(!m_vFunctions.empty()){
+		UG_COND_THROW(u->domain() != m_vFunctions[0].spGridFct->domain(),
+					  "Checkpoint::add: All functions have to be defined on the same domain.");
+	}
+
+	FunctionEntry entry;
+	entry.name = name;
+	entry.spGridFct = u;
+	m_vFunctions.push_back(entry);
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+set_number(const char* name, number val)
+{
+	m_numbers[name] = val;
+}
+
+template <typename TDomain, typename TAlgebra>
+number Checkpoint<TDomain, TAlgebra>::
+get_number(const char* name) const
+{
+	std::map<std::string, number>::const_iterator iter = m_numbers.find(name);
+	UG_COND_THROW(iter == m_numbers.end(),
+				  "Checkpoint::get_number: No number named '" << name << "'.");
+	return iter->second;
+}
+
+template <typename TDomain, typename TAlgebra>
+bool Checkpoint<TDomain, TAlgebra>::
+has_number(const char* name) const
+{
+	return m_numbers.find(name) != m_numbers.end();
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+add_serializers(GridDataSerializationHandler& serializer, TDomain& dom,
+				const std::vector<std::string>& vSHNames,
+				std::vector<AValues>& vValues)
+{
+	MultiGrid& mg = *dom.grid();
+	serializer.add(GeomObjAttachmentSerializer<Vertex, position_attachment_type>::
+						create(mg, dom.position_attachment()));
+	serializer.add(SubsetHandlerSerializer::create(*dom.subset_handler()));
+
+	for(size_t i = 0; i < vSHNames.size(); ++i)
+		serializer.add(SubsetHandlerSerializer::create(
+							*dom.additional_subset_handler(vSHNames[i])));
+
+	for(size_t i = 0; i < vValues.size(); ++i){
+		serializer.add(CheckpointValueSerializer<Vertex>::create(mg, vValues[i]));
+		serializer.add(CheckpointValueSerializer<Edge>::create(mg, vValues[i]));
+		serializer.add(CheckpointValueSerializer<Face>::create(mg, vValues[i]));
+		serializer.add(CheckpointValueSerializer<Volume>::create(mg, vValues[i]));
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <typename TBaseElem>
+void Checkpoint<TDomain, TAlgebra>::
+copy_values(MultiGrid& mg, AValues& aValues, const function_type& u)
+{
+	typedef typename function_type::template traits<TBaseElem>::const_iterator iter_t;
+
+	Grid::AttachmentAccessor<TBaseElem, AValues> aaValues(mg, aValues);
+	std::vector<DoFIndex> ind;
+
+	for(iter_t iter = u.template begin<TBaseElem>();
+		iter != u.template end<TBaseElem>(); ++iter)
+	{
+		TBaseElem* elem = *iter;
+		std::vector<number>& vals = aaValues[elem];
+		vals.clear();
+		for(size_t fct = 0; fct < u.num_fct(); ++fct){
+			u.inner_dof_indices(elem, fct, ind);
+			for(size_t i = 0; i < ind.size(); ++i)
+				vals.push_back(DoFRef(u, ind[i]));
+		}
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+template <typename TBaseElem>
+void Checkpoint<TDomain, TAlgebra>::
+copy_values(function_type& u, MultiGrid& mg, AValues& aValues)
+{
+	typedef typename function_type::template traits<TBaseElem>::const_iterator iter_t;
+
+	Grid::AttachmentAccessor<TBaseElem, AValues> aaValues(mg, aValues);
+	std::vector<DoFIndex> ind;
+
+	for(iter_t iter = u.template begin<TBaseElem>();
+		iter != u.template end<TBaseElem>(); ++iter)
+	{
+		TBaseElem* elem = *iter;
+		const std::vector<number>& vals = aaValues[elem];
+	//	objects which were created after the checkpoint was written keep their values
+		if(vals.empty())
+			continue;
+
+		size_t k = 0;
+		for(size_t fct = 0; fct < u.num_fct(); ++fct){
+			u.inner_dof_indices(elem, fct, ind);
+			UG_COND_THROW(k + ind.size() > vals.size(),
+						  "Checkpoint::restore: Stored values don't match the grid function.");
+			for(size_t i = 0; i < ind.size(); ++i)
+				DoFRef(u, ind[i]) = vals[k++];
+		}
+		UG_COND_THROW(k != vals.size(),
+					  "Checkpoint::restore: Stored values don't match the grid function.");
+	}
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+write(const char* filename)
+{
+	PROFILE_FUNC_GROUP("disc");
+	UG_COND_THROW(m_vFunctions.empty(), "Checkpoint::write: No grid function was added.");
+
+	m_writer.wait();
+
+	TDomain& dom = *m_vFunctions[0].spGridFct->domain();
+	MultiGrid& mg = *dom.grid();
+
+//	values are stored per grid object and have to be consistent
+	std::vector<AValues> vValues(m_vFunctions.size());
+	for(size_t i = 0; i < m_vFunctions.size(); ++i){
+		SmartPtr<function_type> spU = m_vFunctions[i].spGridFct;
+	#ifdef UG_PARALLEL
+		if(!spU->has_storage_type(PST_CONSISTENT)){
+			spU = spU->clone();
+			spU->change_storage_type(PST_CONSISTENT);
+		}
+	#endif
+		mg.attach_to_all(vValues[i]);
+		copy_values<Vertex>(mg, vValues[i], *spU);
+		copy_values<Edge>(mg, vValues[i], *spU);
+		copy_values<Face>(mg, vValues[i], *spU);
+		copy_values<Volume>(mg, vValues[i], *spU);
+	}
+
+	std::vector<std::string> vSHNames = dom.additional_subset_handler_names();
+	GridDataSerializationHandler serializer;
+	add_serializers(serializer, dom, vSHNames, vValues);
+
+	BinaryBuffer part;
+	SerializeCheckpointPart(mg, serializer, part);
+
+	for(size_t i = 0; i < vValues.size(); ++i)
+		mg.detach_from_all(vValues[i]);
+
+//	the meta data is only taken from the first process
+	BinaryBuffer meta;
+	std::vector<std::string> vNames;
+	std::vector<std::vector<std::string> > vFctNames;
+	for(size_t i = 0; i < m_vFunctions.size(); ++i){
+		const function_type& u = *m_vFunctions[i].spGridFct;
+		vNames.push_back(m_vFunctions[i].name);
+		vFctNames.push_back(std::vector<std::string>());
+		for(size_t fct = 0; fct < u.num_fct(); ++fct)
+			vFctNames.back().push_back(u.name(fct));
+	}
+	Serialize(meta, (int)TDomain::dim);
+	Serialize(meta, vNames);
+	Serialize(meta, vFctNames);
+	Serialize(meta, vSHNames);
+	Serialize(meta, m_numbers);
+
+	m_writer.write(filename, meta, part);
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+wait()
+{
+	m_writer.wait();
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+read_domain(SmartPtr<TDomain> dom, const char* filename)
+{
+	PROFILE_FUNC_GROUP("disc");
+	m_writer.wait();
+	release();
+
+	MultiGrid& mg = *dom->grid();
+	int rank = 0;
+	int numProcs = 1;
+#ifdef UG_PARALLEL
+	rank = pcl::ProcRank();
+	numProcs = pcl::NumProcs();
+	UG_COND_THROW(!pcl::AllProcsTrue(mg.num<Vertex>() == 0),
+				  "Checkpoint::read_domain: The grid of the domain has to be empty.");
+#else
+	UG_COND_THROW(mg.num<Vertex>() != 0,
+				  "Checkpoint::read_domain: The grid of the domain has to be empty.");
+#endif
+
+//	only the first process reads the archive
+	SmartPtr<CheckpointArchive> spArchive;
+	BinaryBuffer meta;
+	if(rank == 0){
+		spArchive = make_sp(new CheckpointArchive(filename));
+		spArchive->read_meta(meta);
+	}
+#ifdef UG_PARALLEL
+	std::vector<char> metaData(meta.buffer(), meta.buffer() + meta.write_pos());
+	pcl::ProcessCommunicator().broadcast(metaData);
+	if(rank != 0 && !metaData.empty())
+		meta.write(&metaData.front(), metaData.size());
+#endif
+
+	int dim;
+	std::vector<std::string> vSHNames;
+	Deserialize(meta, dim);
+	UG_COND_THROW(dim != TDomain::dim, "Checkpoint::read_domain: The checkpoint was written "
+				  "for dimension " << dim << ", the domain has dimension " << TDomain::dim);
+	Deserialize(meta, m_vReadNames);
+	Deserialize(meta, m_vReadFctNames);
+	Deserialize(meta, vSHNames);
+	Deserialize(meta, m_numbers);
+
+	for(size_t i = 0; i < vSHNames.size(); ++i)
+		dom->create_additional_subset_handler(vSHNames[i]);
+
+	m_spReadDomain = dom;
+	m_vReadValues.resize(m_vReadNames.size());
+	for(size_t i = 0; i < m_vReadValues.size(); ++i)
+		mg.attach_to_all(m_vReadValues[i]);
+
+	GridDataSerializationHandler serializer;
+	add_serializers(serializer, *dom, vSHNames, m_vReadValues);
+
+	SubsetHandler shPartition(mg);
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS, 0));
+	if(spArchive.valid())
+		MergeCheckpointParts(mg, *spArchive, serializer, shPartition, numProcs);
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS, 0));
+	spArchive = SPNULL;
+
+#ifdef UG_PARALLEL
+	if(numProcs > 1){
+		std::vector<int> procMap(numProcs);
+		for(int i = 0; i < numProcs; ++i)
+			procMap[i] = i;
+		DistributeGrid(mg, shPartition, serializer, true, &procMap);
+	}
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+bool Checkpoint<TDomain, TAlgebra>::
+has_function(const char* name) const
+{
+	for(size_t i = 0; i < m_vReadNames.size(); ++i){
+		if(m_vReadNames[i] == name)
+			return true;
+	}
+	return false;
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+restore(SmartPtr<function_type> u, const char* name)
+{
+	PROFILE_FUNC_GROUP("disc");
+	UG_COND_THROW(m_spReadDomain.invalid(),
+				  "Checkpoint::restore: read_domain has to be called first.");
+	UG_COND_THROW(u->domain() != m_spReadDomain,
+				  "Checkpoint::restore: The function has to be defined on the domain "
+				  "passed to read_domain.");
+
+	size_t i = 0;
+	for(; i < m_vReadNames.size(); ++i){
+		if(m_vReadNames[i] == name)
+			break;
+	}
+	UG_COND_THROW(i == m_vReadNames.size(),
+				  "Checkpoint::restore: No function named '" << name << "' was stored.");
+
+	const std::vector<std::string>& vFctNames = m_vReadFctNames[i];
+	bool fctsMatch = (u->num_fct() == vFctNames.size());
+	for(size_t fct = 0; fctsMatch && fct < vFctNames.size(); ++fct)
+		fctsMatch = (u->name(fct) == vFctNames[fct]);
+	UG_COND_THROW(!fctsMatch, "Checkpoint::restore: The functions of '" << name
+				  << "' don't match the functions of the given grid function.");
+
+	MultiGrid& mg = *m_spReadDomain->grid();
+	copy_values<Vertex>(*u, mg, m_vReadValues[i]);
+	copy_values<Edge>(*u, mg, m_vReadValues[i]);
+	copy_values<Face>(*u, mg, m_vReadValues[i]);
+	copy_values<Volume>(*u, mg, m_vReadValues[i]);
+
+#ifdef UG_PARALLEL
+	u->set_storage_type(PST_CONSISTENT);
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+void Checkpoint<TDomain, TAlgebra>::
+release()
+{
+	if(m_spReadDomain.valid()){
+		MultiGrid& mg = *m_spReadDomain->grid();
+		for(size_t i = 0; i < m_vReadValues.size(); ++i)
+			mg.detach_from_all(m_vReadValues[i]);
+	}
+	m_spReadDomain = SPNULL;
+	m_vReadNames.clear();
+	m_vReadFctNames.clear();
+	m_vReadValues.clear();
+}
+
+}//	end of namespace
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+
+#include "lagrange_sum_factorization.h"
+#include "lagrange.h"
+#include "../common/lagrange1d.h"
+#include "lib_disc/quadrature/gauss_legendre/gauss_legendre.h"
+
+namespace ug{
+
+template <typename TRefElem>
+LagrangeSumFactorization<TRefElem>::
+LagrangeSumFactorization(size_t order, size_t quadOrder)
+	: m_order(order)
+{
+	UG_COND_THROW(order < 1, "LagrangeSumFactorization: order must be >= 1.");
+
+	const size_t p1 = order + 1;
+
+//	1D quadrature (the same as used by the Gauss tensor product rules)
+	GaussLegendre quadRule(quadOrder);
+	const size_t nq = quadRule.size();
+	m_vIP1D.resize(nq);
+	m_vWeight1D.resize(nq);
+	for(size_t q = 0; q < nq; ++q){
+		m_vIP1D[q] = quadRule.point(q)[0];
+		m_vWeight1D[q] = quadRule.weight(q);
+	}
+
+//	tensor product integration points, first coordinate running slowest
+	m_numIP = 1;
+	for(int d = 0; d < dim; ++d) m_numIP *= nq;
+	m_vIP.resize(m_numIP);
+	m_vWeight.resize(m_numIP);
+	for(size_t q = 0; q < m_numIP; ++q)
+	{
+		size_t rest = q;
+		m_vWeight[q] = 1.0;
+		for(int d = dim-1; d >= 0; --d){
+			m_vIP[q][d] = m_vIP1D[rest % nq];
+			m_vWeight[q] *= m_vWeight1D[rest % nq];
+			rest /= nq;
+		}
+	}
+
+//	1D basis values and derivatives
+	m_vB.resize(nq * p1);
+	m_vD.resize(nq * p1);
+	m_vBt.resize(nq * p1);
+	m_vDt.resize(nq * p1);
+	for(size_t i = 0; i < p1; ++i)
+	{
+		const Polynomial1D poly = EquidistantLagrange1D(i, order);
+		const Polynomial1D dPoly = poly.derivative();
+		for(size_t q = 0; q < nq; ++q){
+			m_vB[q*p1 + i] = m_vBt[i*nq + q] = poly.value(m_vIP1D[q]);
+			m_vD[q*p1 + i] = m_vDt[i*nq + q] = dPoly.value(m_vIP1D[q]);
+		}
+	}
+
+//	tensor index of the shape functions
+	FlexLagrangeLSFS<TRefElem> lsfs(order);
+	m_numSh = lsfs.num_sh();
+	m_vTensorIndex.resize(m_numSh);
+	for(size_t sh = 0; sh < m_numSh; ++sh)
+	{
+		const MathVector<dim,int>& ind = lsfs.multi_index(sh);
+		size_t index = 0;
+		for(int d = 0; d < dim; ++d)
+			index = index * p1 + ind[d];
+		m_vTensorIndex[sh] = index;
+	}
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+init_work(Work& work) const
+{
+//	intermediate tensors have mixed extents, bounded by the larger one
+	const size_t maxSize = std::max(m_numIP, m_numSh);
+	if(work.vTensor1.size() >= maxSize && work.vGrad.size() >= m_numIP)
+		return;
+
+	work.vTensor1.resize(maxSize);
+	work.vTensor2.resize(maxSize);
+	work.vIn.resize(maxSize);
+	work.vOut.resize(maxSize);
+	work.vSum.resize(maxSize);
+	work.vGrad.resize(m_numIP);
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+apply_1d(number* out, const number* in, const number* M,
+         size_t n, size_t m, size_t outer, size_t inner)
+{
+	for(size_t o = 0; o < outer; ++o)
+	{
+		const number* pIn = in + o * m * inner;
+		number* pOut = out + o * n * inner;
+		for(size_t r = 0; r < n; ++r)
+		{
+			number* pOutRow = pOut + r * inner;
+			for(size_t k = 0; k < inner; ++k) pOutRow[k] = 0.0;
+			for(size_t j = 0; j < m; ++j)
+			{
+				const number a = M[r*m + j];
+				const number* pInRow = pIn + j * inner;
+				for(size_t k = 0; k < inner; ++k)
+					pOutRow[k] += a * pInRow[k];
+			}
+		}
+	}
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+apply_tensor(number* out, const number* in,
+             const number* const vMat[], const size_t n[], const size_t m[],
+             Work& work) const
+{
+	size_t extent[dim];
+	for(int d = 0; d < dim; ++d) extent[d] = m[d];
+
+	const number* src = in;
+	for(int d = 0; d < dim; ++d)
+	{
+		size_t outer = 1, inner = 1;
+		for(int d2 = 0; d2 < d; ++d2) outer *= extent[d2];
+		for(int d2 = d+1; d2 < dim; ++d2) inner *= extent[d2];
+
+	//	last direction writes to the output, others alternate between buffers
+		number* dest = (d == dim-1) ? out
+					 : ((src == &work.vTensor1[0]) ? &work.vTensor2[0] : &work.vTensor1[0]);
+		apply_1d(dest, src, vMat[d], n[d], m[d], outer, inner);
+		extent[d] = n[d];
+		src = dest;
+	}
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+to_tensor(number* vTensor, const number* vCoeff) const
+{
+	for(size_t sh = 0; sh < m_numSh; ++sh)
+		vTensor[m_vTensorIndex[sh]] = vCoeff[sh];
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+from_tensor(number* vRes, const number* vTensor) const
+{
+	for(size_t sh = 0; sh < m_numSh; ++sh)
+		vRes[sh] = vTensor[m_vTensorIndex[sh]];
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+values(number* vValue, const number* vCoeff, Work& work) const
+{
+	init_work(work);
+	const size_t p1 = m_order + 1, nq = num_ip_1d();
+	const number* vMat[dim]; size_t n[dim], m[dim];
+	for(int d = 0; d < dim; ++d){vMat[d] = &m_vB[0]; n[d] = nq; m[d] = p1;}
+
+	to_tensor(&work.vIn[0], vCoeff);
+	apply_tensor(vValue, &work.vIn[0], vMat, n, m, work);
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+gradients(MathVector<dim>* vGrad, const number* vCoeff, Work& work) const
+{
+	init_work(work);
+	const size_t p1 = m_order + 1, nq = num_ip_1d();
+	const number* vMat[dim]; size_t n[dim], m[dim];
+	for(int d = 0; d < dim; ++d){n[d] = nq; m[d] = p1;}
+
+	number* vComp = &work.vOut[0];
+	to_tensor(&work.vIn[0], vCoeff);
+	for(int d = 0; d < dim; ++d)
+	{
+		for(int d2 = 0; d2 < dim; ++d2)
+			vMat[d2] = (d2 == d) ? &m_vD[0] : &m_vB[0];
+		apply_tensor(vComp, &work.vIn[0], vMat, n, m, work);
+		for(size_t q = 0; q < m_numIP; ++q)
+			vGrad[q][d] = vComp[q];
+	}
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+integrate(number* vRes, const number* vValue, Work& work) const
+{
+	init_work(work);
+	const size_t p1 = m_order + 1, nq = num_ip_1d();
+	const number* vMat[dim]; size_t n[dim], m[dim];
+	for(int d = 0; d < dim; ++d){vMat[d] = &m_vBt[0]; n[d] = p1; m[d] = nq;}
+
+	for(size_t q = 0; q < m_numIP; ++q)
+		work.vIn[q] = m_vWeight[q] * vValue[q];
+
+	apply_tensor(&work.vOut[0], &work.vIn[0], vMat, n, m, work);
+	from_tensor(vRes, &work.vOut[0]);
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+integrate_gradients(number* vRes, const MathVector<dim>* vGrad, Work& work) const
+{
+	init_work(work);
+	const size_t p1 = m_order + 1, nq = num_ip_1d();
+	const number* vMat[dim]; size_t n[dim], m[dim];
+	for(int d = 0; d < dim; ++d){n[d] = p1; m[d] = nq;}
+
+	number* vTensor = &work.vSum[0];
+	number* vComp = &work.vOut[0];
+	for(size_t i = 0; i < m_numSh; ++i) vTensor[i] = 0.0;
+	for(int d = 0; d < dim; ++d)
+	{
+		for(size_t q = 0; q < m_numIP; ++q)
+			work.vIn[q] = m_vWeight[q] * vGrad[q][d];
+
+		for(int d2 = 0; d2 < dim; ++d2)
+			vMat[d2] = (d2 == d) ? &m_vDt[0] : &m_vBt[0];
+		apply_tensor(vComp, &work.vIn[0], vMat, n, m, work);
+		for(size_t i = 0; i < m_numSh; ++i)
+			vTensor[i] += vComp[i];
+	}
+	from_tensor(vRes, vTensor);
+}
+
+template <typename TRefElem>
+void LagrangeSumFactorization<TRefElem>::
+apply_diffusion(number* vRes, const number* vCoeff,
+                const MathMatrix<dim,dim>* vTensor, Work& work) const
+{
+	init_work(work);
+	std::vector<MathVector<dim> >& vGrad = work.vGrad;
+	gradients(&vGrad[0], vCoeff, work);
+
+	MathVector<dim> flux;
+	for(size_t q = 0; q < m_numIP; ++q){
+		MatVecMult(flux, vTensor[q], vGrad[q]);
+		vGrad[q] = flux;
+	}
+
+	integrate_gradients(vRes, &vGrad[0], work);
+}
+
+template class LagrangeSumFactorization<ReferenceEdge>;
+template class LagrangeSumFactorization<ReferenceQuadrilateral>;
+template class LagrangeSumFactorization<ReferenceHexahedron>;
+
+} // end namespace ug
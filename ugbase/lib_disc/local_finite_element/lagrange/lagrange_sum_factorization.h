@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__LOCAL_FINITE_ELEMENT__LAGRANGE__LAGRANGE_SUM_FACTORIZATION__
+#define __H__UG__LIB_DISC__LOCAL_FINITE_ELEMENT__LAGRANGE__LAGRANGE_SUM_FACTORIZATION__
+
+#include <vector>
+
+#include "common/math/ugmath.h"
+
+namespace ug{
+
+///	Sum-factorized evaluation and integration for Lagrange elements on edges, quadrilaterals and hexahedra
+/**
+ * The Lagrange shape functions of order p on the reference cube [0,1]^d are
+ * products of the 1D equidistant Lagrange polynomials and the Gauss tensor
+ * product quadratures (GaussQuadratureQuadrilateral, GaussQuadratureHexahedron)
+ * are products of a 1D Gauss-Legendre rule with n points. Instead of
+ * evaluating all (p+1)^d shape functions at all n^d integration points, which
+ * costs O(p^{2d}) per element, the 1D basis matrices are applied dimension by
+ * dimension, which costs O(d p^{d+1}).
+ *
+ * Coefficient vectors are ordered like the shape functions of
+ * LagrangeLSFS<TRefElem, p> (i.e. in the usual local DoF order), integration
+ * points like the points of the corresponding Gauss tensor product quadrature
+ * of the same order. All gradients are with respect to reference coordinates,
+ * such that the geometry (Jacobian, determinant) has to be included by the
+ * caller into the values passed at the integration points. This way, the
+ * kernels can be used from element discretizations (local vectors of an
+ * element) as well as from matrix-free operators.
+ *
+ * The object itself is not modified by the evaluation methods. All temporary
+ * storage is passed by the caller in a Work object, such that one instance can
+ * be shared between threads as long as each thread uses its own Work.
+ *
+ * \tparam	TRefElem	ReferenceEdge, ReferenceQuadrilateral or ReferenceHexahedron
+ */
+template <typename TRefElem>
+class LagrangeSumFactorization
+{
+	public:
+	///	reference element dimension
+		static const int dim = TRefElem::dim;
+
+	///	temporary storage used by the evaluation methods
+		struct Work
+		{
+			std::vector<number> vTensor1, vTensor2, vIn, vOut, vSum;
+			std::vector<MathVector<dim> > vGrad;
+		};
+
+	public:
+	///	constructor
+	/**
+	 * \param[in]	order		order of the Lagrange shape functions
+	 * \param[in]	quadOrder	order of the Gauss tensor product quadrature
+	 */
+		LagrangeSumFactorization(size_t order, size_t quadOrder);
+
+	///	order of the shape functions
+		size_t order() const {return m_order;}
+
+	///	number of shape functions
+		size_t num_sh() const {return m_numSh;}
+
+	///	number of integration points
+		size_t num_ip() const {return m_numIP;}
+
+	///	number of 1D integration points
+		size_t num_ip_1d() const {return m_vIP1D.size();}
+
+	///	integration point in reference coordinates
+		const MathVector<dim>& ip(size_t q) const {return m_vIP[q];}
+
+	///	quadrature weight of an integration point
+		number weight(size_t q) const {return m_vWeight[q];}
+
+	///	resizes the buffers of a work object (done by all methods if needed)
+		void init_work(Work& work) const;
+
+	///	evaluates a function at all integration points
+	/**
+	 * \param[out]	vValue		values at the num_ip() integration points
+	 * \param[in]	vCoeff		num_sh() coefficients
+	 * \param[in]	work		temporary storage
+	 */
+		void values(number* vValue, const number* vCoeff, Work& work) const;
+
+	///	evaluates the reference gradient of a function at all integration points
+	/**
+	 * \param[out]	vGrad		gradients at the num_ip() integration points
+	 * \param[in]	vCoeff		num_sh() coefficients
+	 * \param[in]	work		temporary storage
+	 */
+		void gradients(MathVector<dim>* vGrad, const number* vCoeff, Work& work) const;
+
+	///	integrates against all shape functions: r_i = sum_q w_q f_q phi_i(x_q)
+	/**
+	 * \param[out]	vRes		num_sh() integrals (overwritten)
+	 * \param[in]	vValue		values f_q at the integration points
+	 * \param[in]	work		temporary storage
+	 */
+		void integrate(number* vRes, const number* vValue, Work& work) const;
+
+	///	integrates against all reference gradients: r_i = sum_q w_q g_q * grad phi_i(x_q)
+	/**
+	 * \param[out]	vRes		num_sh() integrals (overwritten)
+	 * \param[in]	vGrad		vectors g_q at the integration points
+	 * \param[in]	work		temporary storage
+	 */
+		void integrate_gradients(number* vRes, const MathVector<dim>* vGrad, Work& work) const;
+
+	///	applies a diffusion operator: r_i = sum_q w_q (C_q grad u(x_q)) * grad phi_i(x_q)
+	/**
+	 * For an element with mapping F, the physical stiffness matrix of a
+	 * diffusion tensor D is obtained by C_q = |det DF| DF^{-1} D DF^{-T}.
+	 *
+	 * \param[out]	vRes		num_sh() entries of A u (overwritten)
+	 * \param[in]	vCoeff		num_sh() coefficients of u
+	 * \param[in]	vTensor		tensors C_q at the integration points
+	 * \param[in]	work		temporary storage
+	 */
+		void apply_diffusion(number* vRes, const number* vCoeff,
+		                     const MathMatrix<dim,dim>* vTensor, Work& work) const;
+
+	protected:
+	///	applies the n x m matrix M (row-major) along axis of a tensor with given extents
+		static void apply_1d(number* out, const number* in, const number* M,
+		                     size_t n, size_t m, size_t outer, size_t inner);
+
+	///	maps num_sh() coefficients in shape function order to the tensor layout
+		void to_tensor(number* vTensor, const number* vCoeff) const;
+
+	///	maps a (p+1)^d tensor to num_sh() entries in shape function order
+		void from_tensor(number* vRes, const number* vTensor) const;
+
+	///	applies the 1D matrices vMat[d] (n[d] x m[d]) in all directions to a tensor
+		void apply_tensor(number* out, const number* in,
+		                  const number* const vMat[], const size_t n[], const size_t m[],
+		                  Work& work) const;
+
+	protected:
+	///	order and sizes
+		size_t m_order, m_numSh, m_numIP;
+
+	///	1D integration points and weights
+		std::vector<number> m_vIP1D, m_vWeight1D;
+
+	///	integration points and weights
+		std::vector<MathVector<dim> > m_vIP;
+		std::vector<number> m_vWeight;
+
+	///	1D shape values B(q,i) and derivatives D(q,i) at the 1D integration points
+		std::vector<number> m_vB, m_vD;
+
+	///	transposed 1D matrices
+		std::vector<number> m_vBt, m_vDt;
+
+	///	tensor index of each shape function
+		std::vector<size_t> m_vTensorIndex;
+};
+
+} // end namespace ug
+
+#endif
@@ -38,6 +38,7 @@
 #define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__ELEMENT_GAUSS_SEIDEL__
 
 #include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/preconditioner/factorized_patches.h"
 
 #include <vector>
 #include <algorithm>
@@ -299,7 +300,49 @@ void ElementGaussSeidelStep(const typename TAlgebra::matrix_type& A,
 }
 
 
+///	collects the algebra indices associated to each grouping object as a patch
+template<typename TGroupObj, typename TDomain, typename TAlgebra>
+void ElementGaussSeidelCollectPatches(GridFunction<TDomain, TAlgebra>& c,
+                                      FactorizedPatches<TAlgebra>& patches)
+{
+	typedef typename GridFunction<TDomain, TAlgebra>::element_type Element;
+	std::vector<Element*> vElem;
+	std::vector<size_t> vInd;
+
+	typedef typename GridFunction<TDomain, TAlgebra>::template traits<TGroupObj>::const_iterator GroupObjIter;
+	for(GroupObjIter iter = c.template begin<TGroupObj>();
+					 iter != c.template end<TGroupObj>(); ++iter){
+
+		// collect elems associated to grouping object
+		c.collect_associated(vElem, *iter);
+
+		// get all algebraic indices on patch without duplicates
+		vInd.clear();
+		for(size_t i = 0; i < vElem.size(); ++i)
+			c.algebra_indices(vElem[i], vInd, false);
+		if(vElem.size() > 1){
+		    std::sort(vInd.begin(), vInd.end());
+		    vInd.erase(std::unique(vInd.begin(), vInd.end()), vInd.end());
+		}
+
+		patches.add_patch(vInd.begin(), vInd.end());
+	}
+}
+
+
 ///	ElementGaussSeidel Preconditioner
+/**
+ * By default, the patch matrices are extracted and LU-factorized once after
+ * preprocess (in the first step) and reused in all subsequent steps. The
+ * variant determines how the patches are traversed:
+ * <ul>
+ * <li> "multiplicative": Gauss-Seidel sweep over the patches (default)
+ * <li> "colored": Gauss-Seidel sweep over colors of independent patches, the
+ *      patches of a color are processed in parallel by several threads
+ * <li> "additive": additive Schwarz (block-Jacobi) over all patches, processed
+ *      in parallel by several threads
+ * </ul>
+ */
 template <typename TDomain, typename TAlgebra>
 class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 {
@@ -328,16 +371,16 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		ElementGaussSeidel() : m_relax(1.0), m_type("element"), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel() : m_relax(1.0), m_type("element"), m_schur_alpha(1.0), m_elim_off_diag(false), m_bCache(true), m_variant("multiplicative") {};
 
 	///	constructor setting relaxation
-		ElementGaussSeidel(number relax) : m_relax(relax), m_type("element"), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel(number relax) : m_relax(relax), m_type("element"), m_schur_alpha(1.0), m_elim_off_diag(false), m_bCache(true), m_variant("multiplicative") {};
 
 	///	constructor setting type
-		ElementGaussSeidel(const std::string& type) : m_relax(1.0), m_type(type), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel(const std::string& type) : m_relax(1.0), m_type(type), m_schur_alpha(1.0), m_elim_off_diag(false), m_bCache(true), m_variant("multiplicative") {};
 
 	///	constructor setting relaxation and type
-		ElementGaussSeidel(number relax, const std::string& type) : m_relax(relax), m_type(type), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel(number relax, const std::string& type) : m_relax(relax), m_type(type), m_schur_alpha(1.0), m_elim_off_diag(false), m_bCache(true), m_variant("multiplicative") {};
 
 	///	Clone
 		virtual SmartPtr<ILinearIterator<vector_type> > clone()
@@ -348,6 +391,9 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 			newInst->set_damp(this->damping());
 			newInst->set_relax(m_relax);
 			newInst->set_type(m_type);
+			newInst->set_cache_factorization(m_bCache);
+			newInst->set_variant(m_variant);
+			newInst->set_num_threads(m_patches.num_threads());
 
 			newInst->m_schur_cmp =m_schur_cmp;
 			newInst->m_schur_alpha = m_schur_alpha;
@@ -365,7 +411,27 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 		void set_relax(number omega){m_relax=omega;};
 
 	/// set type
-		void set_type(const std::string& type){m_type=type;};
+		void set_type(const std::string& type){m_type=type; m_patches.clear();};
+
+	/// sets if the patch factorizations are cached between steps
+	/**	Caching is only possible for algebras with fixed block size and
+	 * without schur complement components. Otherwise, the patches are
+	 * extracted in each step.*/
+		void set_cache_factorization(bool bCache){m_bCache=bCache;};
+
+	/// sets the traversal of the patches ("multiplicative", "colored" or "additive")
+	/**	The colored and additive variants require cached factorizations.*/
+		void set_variant(const std::string& variant)
+		{
+			if(variant != "multiplicative" && variant != "colored" && variant != "additive")
+				UG_THROW("ElementGaussSeidel: wrong variant '"<<variant<<"'."
+						 " Options: multiplicative, colored, additive.");
+			m_variant=variant;
+			m_patches.clear();
+		};
+
+	/// sets the number of threads for the colored and additive variants
+		void set_num_threads(size_t numThreads){m_patches.set_num_threads(numThreads);};
 
 		void select_schur_cmp(const std::vector<std::string>& cmp, number alpha)
 		{
@@ -382,6 +448,7 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 	///	Preprocess routine
 		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
 		{
+			m_patches.clear();
 #ifdef UG_PARALLEL
 			if(pcl::NumProcs() > 1)
 			{
@@ -415,7 +482,8 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 				spDtmp->change_storage_type(PST_UNIQUE);
 				
 				// execute step
-				if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(m_A, *pC, *spDtmp, m_relax, m_schur_cmp, m_schur_alpha);
+				if (use_cache() && m_type == "element") cached_step<Element>(m_A, *pC, *spDtmp);
+				else if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(m_A, *pC, *spDtmp, m_relax, m_schur_cmp, m_schur_alpha);
 				else UG_THROW("ElementGaussSeidel: wrong patch type '"<<m_type<<"'."
 					      " Options: element, side, face, edge, vertex.");
 				
@@ -428,7 +496,17 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 #endif
 			  {
 			    matrix_type &A=*pOp; 
-			    if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
+			    if (use_cache())
+			    {
+			    	if (m_type == "element") cached_step<Element>(A, *pC, d);
+			    	else if (m_type == "side") cached_step<Side>(A, *pC, d);
+			    	else if (m_type == "face") cached_step<Face>(A, *pC, d);
+			    	else if (m_type == "edge") cached_step<Edge>(A, *pC, d);
+			    	else if (m_type == "vertex") cached_step<Vertex>(A, *pC, d);
+			    	else UG_THROW("ElementGaussSeidel: wrong patch type '"<<m_type<<"'."
+			    			" Options: element, side, face, edge, vertex.")
+			    }
+			    else if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
 			    else if	(m_type == "side") ElementGaussSeidelStep<Side,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
 			    else if	(m_type == "face") ElementGaussSeidelStep<Face,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
 			    else if	(m_type == "edge") ElementGaussSeidelStep<Edge,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
@@ -446,6 +524,37 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 	///	Postprocess routine
 		virtual bool postprocess() {return true;}
 
+	///	returns if the cached patch factorizations are used
+		bool use_cache() const
+		{
+			return m_bCache && FactorizedPatches<TAlgebra>::supported()
+#ifdef SCHUR_MOD
+					&& m_schur_cmp.empty()
+#endif
+					;
+		}
+
+	///	step using the cached patch factorizations
+		template <typename TGroupObj>
+		void cached_step(const matrix_type& A, grid_function_type& c, const vector_type& d)
+		{
+			if(!m_patches.factorized())
+			{
+				m_patches.clear();
+				ElementGaussSeidelCollectPatches<TGroupObj>(c, m_patches);
+				m_patches.factorize(A);
+				if(m_variant != "multiplicative") m_patches.color(A);
+			}
+
+			c.set(0.0);
+#ifdef UG_PARALLEL
+			c.set_storage_type(PST_ADDITIVE);
+#endif
+			if(m_variant == "colored") m_patches.colored_gauss_seidel_step(A, c, d, m_relax);
+			else if(m_variant == "additive") m_patches.additive_step(c, d, m_relax);
+			else m_patches.gauss_seidel_step(A, c, d, m_relax);
+		}
+
 	protected:
 #ifdef UG_PARALLEL
 		matrix_type m_A;
@@ -460,6 +569,15 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 		bool m_elim_off_diag;
 #endif
 
+	///	cached patch factorizations
+		FactorizedPatches<TAlgebra> m_patches;
+
+	///	flag if patch factorizations are cached
+		bool m_bCache;
+
+	///	traversal of the patches
+		std::string m_variant;
+
 };
 
 } // end namespace ug
@@ -41,6 +41,7 @@
 
 #include "common/util/smart_pointer.h"
 #include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/preconditioner/factorized_patches.h"
 
 #include "lib_algebra/algebra_common/core_smoothers.h"
 #include "lib_disc/function_spaces/dof_position_util.h"
@@ -866,6 +867,7 @@ class LineVanka : public IPreconditioner<TAlgebra>
 	//	Preprocess routine
 		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
 		{
+			m_patches.clear();
 #ifdef UG_PARALLEL
 			if(pcl::NumProcs() > 1)
 			{
@@ -916,92 +918,117 @@ class LineVanka : public IPreconditioner<TAlgebra>
 		matrix_type m_A;
 #endif
 
-	bool linevanka_step(const matrix_type &A, vector_type &x, const vector_type &b)
+	///	patches of the rows visited by the sweeps with cached factorizations
+		FactorizedPatches<TAlgebra> m_patches;
+
+	///	patch of each row (or -1 if no patch is centered at the row)
+		std::vector<size_t> m_vPatchOfRow;
+
+	///	buffer for the local defect and correction
+		std::vector<number> m_vWork;
+
+	//	extracts and factorizes the patches of all rows visited by the sweeps
+	void init_patches(const matrix_type &A)
+	{
+		const size_t n = A.num_rows();
+		std::vector<bool> vCenter(n, false);
+		if (m_nr_forwardx+m_nr_backwardx>0){
+			for(size_t i=0; i < n; i++)
+				if (A(i,i)==0) vCenter[i] = true;
+		}
+		if ((dim>1)&&(m_nr_forwardy+m_nr_backwardy>0)){
+			for (size_t sortedi=0;sortedi < m_ind_end && sortedi < indY.size(); sortedi++)
+				vCenter[indY[sortedi]] = true;
+		}
+		if ((dim>2)&&(m_nr_forwardz+m_nr_backwardz>0)){
+			for (size_t sortedi=0;sortedi < m_ind_end && sortedi < indZ.size(); sortedi++)
+				vCenter[indZ[sortedi]] = true;
+		}
+
+		// the patch of row i consists of all indices coupled to i
+		m_patches.clear();
+		m_vPatchOfRow.assign(n, (size_t)-1);
+		std::vector<size_t> vInd;
+		for(size_t i=0; i < n; i++){
+			if (!vCenter[i]) continue;
+			vInd.clear();
+			for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it)
+				vInd.push_back(it.index());
+			m_vPatchOfRow[i] = m_patches.num_patches();
+			m_patches.add_patch(vInd.begin(), vInd.end());
+		}
+		m_patches.factorize(A);
+		m_vWork.resize(m_patches.max_patch_size());
+	}
+
+	//	solves for the patch of row i, the patch values are overwritten
+	void vanka_patch_step(const matrix_type &A, vector_type &x, const vector_type &b, size_t i)
+	{
+		if (FactorizedPatches<TAlgebra>::supported())
+			m_patches.correct(m_vPatchOfRow[i], A, x, b, m_relax, &m_vWork[0], true);
+		else
+			uncached_vanka_patch_step(A, x, b, i);
+	}
+
+	//	extracts and solves the patch of row i for algebras without fixed block size
+	void uncached_vanka_patch_step(const matrix_type &A, vector_type &x, const vector_type &b, size_t i)
 	{
 		DenseVector< VariableArray1<number> > s;
 		DenseVector< VariableArray1<number> > localx;
 		DenseMatrix< VariableArray2<number> > mat;
-		
-		static const int MAXBLOCKSIZE = 19;
-		size_t blockind[MAXBLOCKSIZE];
-		size_t blocksize;
-		// gs LL has preconditioning matrix
-		// (D-L)^{-1}
+
+		std::vector<size_t> blockind;
+		for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
+			blockind.push_back(it.index());
+			x[it.index()] = 0;
+		};
+		const size_t blocksize = blockind.size();
+		mat.resize(blocksize,blocksize);
+		s.resize(blocksize);
+		localx.resize(blocksize);
+		for (size_t j=0;j<blocksize;j++){
+			// fill local block matrix
+			for (size_t k=0;k<blocksize;k++){
+				mat.subassign(j,k,A(blockind[j],blockind[k]));
+			};
+			// compute rhs
+			typename vector_type::value_type sj = b[blockind[j]];
+			for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
+				MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
+			};
+			s.subassign(j,sj);
+		};
+		// solve block
+		InverseMatMult(localx,1,mat,s);
+		for (size_t j=0;j<blocksize;j++){
+			x[blockind[j]] = m_relax*localx[j];
+		};
+	}
+
+	bool linevanka_step(const matrix_type &A, vector_type &x, const vector_type &b)
+	{
 		if (m_init==false) update(x.size());
+		if (FactorizedPatches<TAlgebra>::supported() && !m_patches.factorized())
+			init_patches(A);
 
 		size_t i;
-		size_t nrofelements=0;
-		
 		for(i=0; i < x.size(); i++)
 		{
 			x[i]=0;
-			if (A(i,i)==0) nrofelements++;
 		};
 		
 		// forward in x direction
 		for (size_t count=0;count<m_nr_forwardx;count++){
 			for(i=0; i < x.size(); i++){
 				if (A(i,i)!=0) continue;
-				blocksize=0;
-				for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-					blockind[blocksize] = it.index();
-					x[it.index()] = 0;
-					blocksize++;
-				};
-				mat.resize(blocksize,blocksize);
-				s.resize(blocksize);
-				localx.resize(blocksize);
-				for (size_t j=0;j<blocksize;j++){
-					// fill local block matrix
-					for (size_t k=0;k<blocksize;k++){
-						mat.subassign(j,k,A(blockind[j],blockind[k]));
-					};
-					// compute rhs
-					typename vector_type::value_type sj = b[blockind[j]];
-					for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
-						MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
-					};
-					s.subassign(j,sj);
-				};
-				// solve block
-				InverseMatMult(localx,1,mat,s);
-				for (size_t j=0;j<blocksize;j++){
-					x[blockind[j]] = m_relax*localx[j];
-				};
+				vanka_patch_step(A, x, b, i);
 			};
 		};
 		// backward in x direction
 		for (size_t count=0;count<m_nr_backwardx;count++){
 			for	(i=x.size()-1;(int)i>= 0; i--)
 			{
-				if (A(i,i)==0){ 
-				blocksize=0;
-				for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-					blockind[blocksize] = it.index();
-					x[it.index()] = 0;
-					blocksize++;
-				};
-				mat.resize(blocksize,blocksize);
-				s.resize(blocksize);
-				localx.resize(blocksize);
-				for (size_t j=0;j<blocksize;j++){
-					// fill local block matrix
-					for (size_t k=0;k<blocksize;k++){
-						mat.subassign(j,k,A(blockind[j],blockind[k]));
-					};
-					// compute rhs
-					typename vector_type::value_type sj = b[blockind[j]];
-					for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
-						MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
-					};
-					s.subassign(j,sj);
-				};
-				// solve block
-				InverseMatMult(localx,1,mat,s);
-				for (size_t j=0;j<blocksize;j++){
-					x[blockind[j]] = m_relax*localx[j];
-				};
-				};
+				if (A(i,i)==0) vanka_patch_step(A, x, b, i);
 				if (i==0) break;
 			};
 		};
@@ -1012,137 +1039,31 @@ class LineVanka : public IPreconditioner<TAlgebra>
 		
 		// forward in y direction
 		for (size_t count=0;count<m_nr_forwardy;count++){
-		for (size_t sortedi=0;sortedi < m_ind_end; sortedi++){
-			i = indY[sortedi];
-				blocksize=0;
-				for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-					blockind[blocksize] = it.index();
-					x[it.index()] = 0;
-					blocksize++;
-				};
-				mat.resize(blocksize,blocksize);
-				s.resize(blocksize);
-				localx.resize(blocksize);
-				for (size_t j=0;j<blocksize;j++){
-					// fill local block matrix
-					for (size_t k=0;k<blocksize;k++){
-						mat.subassign(j,k,A(blockind[j],blockind[k]));
-					};
-					// compute rhs
-					typename vector_type::value_type sj = b[blockind[j]];
-					for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
-						MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
-					};
-					s.subassign(j,sj);
-				};
-				// solve block
-				InverseMatMult(localx,1,mat,s);
-				for (size_t j=0;j<blocksize;j++){
-					x[blockind[j]] = m_relax*localx[j];
-				};
-		}
+			for (size_t sortedi=0;sortedi < m_ind_end; sortedi++)
+				vanka_patch_step(A, x, b, indY[sortedi]);
 		};
 
 		// backward in y direction
 		for (size_t count=0;count<m_nr_backwardy;count++){
-		for (size_t sortedi=m_ind_end-1;(int)sortedi >= 0; sortedi--){
-			i = indY[sortedi];
-				blocksize=0;
-				for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-					blockind[blocksize] = it.index();
-					x[it.index()] = 0;
-					blocksize++;
-				};
-				mat.resize(blocksize,blocksize);
-				s.resize(blocksize);
-				localx.resize(blocksize);
-				for (size_t j=0;j<blocksize;j++){
-					// fill local block matrix
-					for (size_t k=0;k<blocksize;k++){
-						mat.subassign(j,k,A(blockind[j],blockind[k]));
-					};
-					// compute rhs
-					typename vector_type::value_type sj = b[blockind[j]];
-					for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
-						MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
-					};
-					s.subassign(j,sj);
-				};
-				// solve block
-				InverseMatMult(localx,1,mat,s);
-				for (size_t j=0;j<blocksize;j++){
-					x[blockind[j]] = m_relax*localx[j];
-				};
-			if (sortedi==0) break;
-		}
+			for (size_t sortedi=m_ind_end-1;(int)sortedi >= 0; sortedi--){
+				vanka_patch_step(A, x, b, indY[sortedi]);
+				if (sortedi==0) break;
+			}
 		};
 		if (dim==2) return true;
 
 		// forward in z direction
 		for (size_t count=0;count<m_nr_forwardz;count++){
-		for (size_t sortedi=0;sortedi < m_ind_end; sortedi++){
-				i = indZ[sortedi];
-				blocksize=0;
-				for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-					blockind[blocksize] = it.index();
-					x[it.index()] = 0;
-					blocksize++;
-				};
-				mat.resize(blocksize,blocksize);
-				s.resize(blocksize);
-				localx.resize(blocksize);
-				for (size_t j=0;j<blocksize;j++){
-					// fill local block matrix
-					for (size_t k=0;k<blocksize;k++){
-						mat.subassign(j,k,A(blockind[j],blockind[k]));
-					};
-					// compute rhs
-					typename vector_type::value_type sj = b[blockind[j]];
-					for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
-						MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
-					};
-					s.subassign(j,sj);
-				};
-				// solve block
-				InverseMatMult(localx,1,mat,s);
-				for (size_t j=0;j<blocksize;j++){
-					x[blockind[j]] = m_relax*localx[j];
-				};
-		}
+			for (size_t sortedi=0;sortedi < m_ind_end; sortedi++)
+				vanka_patch_step(A, x, b, indZ[sortedi]);
 		}
 
 		// backward in z direction
 		for (size_t count=0;count<m_nr_backwardz;count++){
-		for (size_t sortedi=m_ind_end-1;(int)sortedi >= 0; sortedi--){
-			i = indZ[sortedi];
-				blocksize=0;
-				for(typename matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-					blockind[blocksize] = it.index();
-					x[it.index()] = 0;
-					blocksize++;
-				};
-				mat.resize(blocksize,blocksize);
-				s.resize(blocksize);
-				localx.resize(blocksize);
-				for (size_t j=0;j<blocksize;j++){
-					// fill local block matrix
-					for (size_t k=0;k<blocksize;k++){
-						mat.subassign(j,k,A(blockind[j],blockind[k]));
-					};
-					// compute rhs
-					typename vector_type::value_type sj = b[blockind[j]];
-					for(typename matrix_type::const_row_iterator it = A.begin_row(blockind[j]); it != A.end_row(blockind[j]) ; ++it){
-						MatMultAdd(sj, 1.0, sj, -1.0, it.value(), x[it.index()]);
-					};
-					s.subassign(j,sj);
-				};
-				// solve block
-				InverseMatMult(localx,1,mat,s);
-				for (size_t j=0;j<blocksize;j++){
-					x[blockind[j]] = m_relax*localx[j];
-				};
-			if (sortedi==0) break;
-		}
+			for (size_t sortedi=m_ind_end-1;(int)sortedi >= 0; sortedi--){
+				vanka_patch_step(A, x, b, indZ[sortedi]);
+				if (sortedi==0) break;
+			}
 		}
 		return true;
 	}
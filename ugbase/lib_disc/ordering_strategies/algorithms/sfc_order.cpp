@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+#include "common/common.h"
+#include "lib_disc/function_spaces/dof_position_util.h"
+#include "lib_disc/domain.h"
+
+#include "lib_disc/ordering_strategies/algorithms/sfc_order.h"
+
+namespace ug{
+
+template<int dim>
+void ComputeSpaceFillingCurveOrder(std::vector<size_t>& vNewIndex,
+                                   const std::vector<MathVector<dim> >& vPos,
+                                   SpaceFillingCurveType sfc)
+{
+	vNewIndex.resize(vPos.size());
+	if(vPos.empty())
+		return;
+
+//	the curve is laid through the bounding box of all positions
+	MathVector<dim> boxMin = vPos[0];
+	MathVector<dim> boxMax = vPos[0];
+	for(size_t i = 1; i < vPos.size(); ++i){
+		for(int d = 0; d < dim; ++d){
+			boxMin[d] = std::min(boxMin[d], vPos[i][d]);
+			boxMax[d] = std::max(boxMax[d], vPos[i][d]);
+		}
+	}
+
+//	sort indices based on their curve index
+	std::vector<std::pair<uint64, size_t> > vKey(vPos.size());
+	for(size_t i = 0; i < vPos.size(); ++i)
+		vKey[i] = std::make_pair(SpaceFillingCurveIndex(vPos[i], boxMin, boxMax, sfc), i);
+
+//	pairs are compared lexicographically, so that equal positions keep their order
+	std::sort(vKey.begin(), vKey.end());
+
+//	write mapping
+	for(size_t i = 0; i < vKey.size(); ++i)
+		vNewIndex[vKey[i].second] = i;
+}
+
+template <typename TDomain>
+void OrderSpaceFillingCurveForDofDist(SmartPtr<DoFDistribution> dd,
+                                      ConstSmartPtr<TDomain> domain,
+                                      SpaceFillingCurveType sfc)
+{
+	PROFILE_FUNC_GROUP("disc");
+
+//	get positions of indices
+	std::vector<MathVector<TDomain::dim> > vPositions;
+	ExtractPositions(domain, dd, vPositions);
+
+	UG_COND_THROW(vPositions.size() != dd->num_indices(),
+				  "OrderSpaceFillingCurve: Number of positions does not match"
+				  " number of indices.");
+
+//	get mapping: old -> new index
+	std::vector<size_t> vNewIndex;
+	ComputeSpaceFillingCurveOrder<TDomain::dim>(vNewIndex, vPositions, sfc);
+
+//	reorder indices
+	dd->permute_indices(vNewIndex);
+}
+
+template <typename TDomain>
+void OrderSpaceFillingCurve(ApproximationSpace<TDomain>& approxSpace, const char* curve)
+{
+	const SpaceFillingCurveType sfc = SpaceFillingCurveTypeFromString(curve);
+
+	std::vector<SmartPtr<DoFDistribution> > vDD = approxSpace.dof_distributions();
+	for(size_t i = 0; i < vDD.size(); ++i)
+		OrderSpaceFillingCurveForDofDist<TDomain>(vDD[i], approxSpace.domain(), sfc);
+}
+
+#ifdef UG_DIM_1
+template void ComputeSpaceFillingCurveOrder<1>(std::vector<size_t>& vNewIndex, const std::vector<MathVector<1> >& vPos, SpaceFillingCurveType);
+template void OrderSpaceFillingCurveForDofDist<Domain1d>(SmartPtr<DoFDistribution> dd, ConstSmartPtr<Domain1d> domain, SpaceFillingCurveType);
+template void OrderSpaceFillingCurve<Domain1d>(ApproximationSpace<Domain1d>& approxSpace, const char* curve);
+#endif
+#ifdef UG_DIM_2
+template void ComputeSpaceFillingCurveOrder<2>(std::vector<size_t>& vNewIndex, const std::vector<MathVector<2> >& vPos, SpaceFillingCurveType);
+template void OrderSpaceFillingCurveForDofDist<Domain2d>(SmartPtr<DoFDistribution> dd, ConstSmartPtr<Domain2d> domain, SpaceFillingCurveType);
+template void OrderSpaceFillingCurve<Domain2d>(ApproximationSpace<Domain2d>& approxSpace, const char* curve);
+#endif
+#ifdef UG_DIM_3
+template void ComputeSpaceFillingCurveOrder<3>(std::vector<size_t>& vNewIndex, const std::vector<MathVector<3> >& vPos, SpaceFillingCurveType);
+template void OrderSpaceFillingCurveForDofDist<Domain3d>(SmartPtr<DoFDistribution> dd, ConstSmartPtr<Domain3d> domain, SpaceFillingCurveType);
+template void OrderSpaceFillingCurve<Domain3d>(ApproximationSpace<Domain3d>& approxSpace, const char* curve);
+#endif
+
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cmath>
+
+#include "diffusion_sum_factorization_fe.h"
+#include "lib_disc/reference_element/reference_mapping.h"
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+//	Constructor
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename TDomain>
+DiffusionSumFactorizationFE<TDomain>::
+DiffusionSumFactorizationFE(const char* functions, const char* subsets)
+ :IElemDisc<TDomain>(functions, subsets),
+  m_diffusion(1.0), m_source(0.0), m_order(0)
+{
+	if(this->num_fct() != 1)
+		UG_THROW("DiffusionSumFactorizationFE: needs exactly 1 function, "
+				 "but got " << this->num_fct());
+
+	this->clear_add_fct();
+}
+
+template<typename TDomain>
+void DiffusionSumFactorizationFE<TDomain>::
+prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid)
+{
+//	check number
+	if(vLfeID.size() != 1)
+		UG_THROW("DiffusionSumFactorizationFE: needs exactly 1 function.");
+
+//	check that Lagrange of fixed order
+	if(vLfeID[0].type() != LFEID::LAGRANGE || vLfeID[0].order() < 1)
+		UG_THROW("DiffusionSumFactorizationFE: Only Lagrange of fixed order"
+				 " supported, but got " << vLfeID[0]);
+
+//	set order, the sum factorization is only rebuilt if changed
+	if(m_order != vLfeID[0].order() || m_spSumFact.invalid())
+	{
+		m_order = vLfeID[0].order();
+		m_spSumFact = make_sp(new sum_fact_type(m_order, 2*m_order+1));
+		m_spSumFact->init_work(m_work);
+		m_vTensor.resize(m_spSumFact->num_ip());
+		m_vDetJ.resize(m_spSumFact->num_ip());
+		m_vCoeff.resize(m_spSumFact->num_sh());
+		m_vRes.resize(m_spSumFact->num_sh());
+	}
+
+	register_all_funcs();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	assembling functions
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::
+prep_elem_loop(const ReferenceObjectID roid, const int si)
+{}
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::
+prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
+{
+	const sum_fact_type& sf = *m_spSumFact;
+	ReferenceMapping<ref_elem_type, dim> mapping(vCornerCoords);
+
+//	C_q = |det DF| DF^{-1} d DF^{-T}, where JTInv = DF^{-T}
+	MathMatrix<dim,dim> JTInv;
+	for(size_t q = 0; q < sf.num_ip(); ++q)
+	{
+		const number detJ = std::fabs(mapping.jacobian_transposed_inverse(JTInv, sf.ip(q)));
+		m_vDetJ[q] = detJ;
+
+		MathMatrix<dim,dim>& C = m_vTensor[q];
+		for(int i = 0; i < dim; ++i)
+			for(int j = 0; j < dim; ++j)
+			{
+				number sum = 0.0;
+				for(int k = 0; k < dim; ++k)
+					sum += JTInv(k, i) * JTInv(k, j);
+				C(i, j) = detJ * m_diffusion * sum;
+			}
+	}
+}
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::
+fsh_elem_loop()
+{}
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::
+add_jac_A_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[])
+{
+	const sum_fact_type& sf = *m_spSumFact;
+	const size_t numSh = sf.num_sh();
+
+//	column j of the element matrix is the operator applied to the j-th unit vector
+	for(size_t j = 0; j < numSh; ++j)
+	{
+		for(size_t i = 0; i < numSh; ++i) m_vCoeff[i] = 0.0;
+		m_vCoeff[j] = 1.0;
+
+		sf.apply_diffusion(&m_vRes[0], &m_vCoeff[0], &m_vTensor[0], m_work);
+
+		for(size_t i = 0; i < numSh; ++i)
+			J(_C_, i, _C_, j) += m_vRes[i];
+	}
+}
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::
+add_def_A_elem(LocalVector& d, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[])
+{
+	const sum_fact_type& sf = *m_spSumFact;
+	const size_t numSh = sf.num_sh();
+
+	for(size_t i = 0; i < numSh; ++i)
+		m_vCoeff[i] = u(_C_, i);
+
+	sf.apply_diffusion(&m_vRes[0], &m_vCoeff[0], &m_vTensor[0], m_work);
+
+	for(size_t i = 0; i < numSh; ++i)
+		d(_C_, i) += m_vRes[i];
+}
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::
+add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[])
+{
+	if(m_source == 0.0) return;
+
+	const sum_fact_type& sf = *m_spSumFact;
+
+//	the detJ array is not needed any more for this element, reuse it
+	for(size_t q = 0; q < sf.num_ip(); ++q)
+		m_vDetJ[q] *= m_source;
+
+	sf.integrate(&m_vRes[0], &m_vDetJ[0], m_work);
+
+	for(size_t i = 0; i < sf.num_sh(); ++i)
+		rhs(_C_, i) += m_vRes[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	register assemble functions
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename TDomain>
+void DiffusionSumFactorizationFE<TDomain>::register_all_funcs()
+{
+	register_func<elem_type>();
+}
+
+template<typename TDomain>
+template<typename TElem>
+void DiffusionSumFactorizationFE<TDomain>::register_func()
+{
+	ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+	typedef this_type T;
+
+	this->clear_add_fct(id);
+	this->set_prep_elem_loop_fct(id, &T::template prep_elem_loop<TElem>);
+	this->set_prep_elem_fct(	 id, &T::template prep_elem<TElem>);
+	this->set_fsh_elem_loop_fct( id, &T::template fsh_elem_loop<TElem>);
+
+	this->set_add_jac_A_elem_fct(id, &T::template add_jac_A_elem<TElem>);
+	this->set_add_jac_M_elem_fct(id, &T::template add_jac_M_elem<TElem>);
+	this->set_add_def_A_elem_fct(id, &T::template add_def_A_elem<TElem>);
+	this->set_add_def_M_elem_fct(id, &T::template add_def_M_elem<TElem>);
+	this->set_add_rhs_elem_fct(	 id, &T::template add_rhs_elem<TElem>);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	explicit template instantiations
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef UG_DIM_1
+template class DiffusionSumFactorizationFE<Domain1d>;
+#endif
+#ifdef UG_DIM_2
+template class DiffusionSumFactorizationFE<Domain2d>;
+#endif
+#ifdef UG_DIM_3
+template class DiffusionSumFactorizationFE<Domain3d>;
+#endif
+
+} // namespace ug
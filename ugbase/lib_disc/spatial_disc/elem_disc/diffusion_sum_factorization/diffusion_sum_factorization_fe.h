@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__DIFFUSION_SUM_FACTORIZATION__DIFFUSION_SUM_FACTORIZATION_FE__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__DIFFUSION_SUM_FACTORIZATION__DIFFUSION_SUM_FACTORIZATION_FE__
+
+#include <vector>
+
+// other ug4 modules
+#include "common/common.h"
+
+// library intern headers
+#include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
+#include "lib_disc/local_finite_element/lagrange/lagrange_sum_factorization.h"
+
+namespace ug{
+
+///	tensor product element type used by DiffusionSumFactorizationFE in a dimension
+template <int dim> struct TensorProductElement;
+template <> struct TensorProductElement<1>
+{typedef RegularEdge elem_type; typedef ReferenceEdge ref_elem_type;};
+template <> struct TensorProductElement<2>
+{typedef Quadrilateral elem_type; typedef ReferenceQuadrilateral ref_elem_type;};
+template <> struct TensorProductElement<3>
+{typedef Hexahedron elem_type; typedef ReferenceHexahedron ref_elem_type;};
+
+///	Lagrange finite element discretization of -div(d grad u) = f using sum factorization
+/**
+ * This element discretization assembles a scalar diffusion equation with
+ * constant diffusion coefficient d and constant source f for Lagrange shape
+ * functions of arbitrary order on tensor product elements (edges in 1d,
+ * quadrilaterals in 2d, hexahedra in 3d). The local stiffness matrix is never
+ * formed for the defect; instead, the element operator is applied by
+ * LagrangeSumFactorization at O(d p^{d+1}) cost per element. The Jacobian is
+ * assembled by applying the operator to the unit vectors.
+ *
+ * The results coincide with a standard Lagrange FE discretization using the
+ * Gauss tensor product quadrature of order 2p+1.
+ */
+template<typename TDomain>
+class DiffusionSumFactorizationFE
+	: public IElemDisc<TDomain>
+{
+	private:
+	///	Base class type
+		typedef IElemDisc<TDomain> base_type;
+
+	///	own type
+		typedef DiffusionSumFactorizationFE<TDomain> this_type;
+
+	public:
+	///	World dimension
+		static const int dim = base_type::dim;
+
+	///	element type and reference element type
+		typedef typename TensorProductElement<dim>::elem_type elem_type;
+		typedef typename TensorProductElement<dim>::ref_elem_type ref_elem_type;
+
+	///	sum factorization type
+		typedef LagrangeSumFactorization<ref_elem_type> sum_fact_type;
+
+	public:
+	///	constructor
+		DiffusionSumFactorizationFE(const char* functions, const char* subsets);
+
+	///	sets the (constant) diffusion coefficient
+		void set_diffusion(number diff) {m_diffusion = diff;}
+
+	///	sets the (constant) source
+		void set_source(number source) {m_source = source;}
+
+	public:
+	///	type of trial space for each function used
+		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid);
+
+	///	returns if hanging nodes are used
+		virtual bool use_hanging() const {return true;}
+
+	protected:
+	///	assembling functions
+	///	\{
+		template<typename TElem>
+		void prep_elem_loop(const ReferenceObjectID roid, const int si);
+		template<typename TElem>
+		void prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[]);
+		template<typename TElem>
+		void fsh_elem_loop();
+		template<typename TElem>
+		void add_jac_A_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]);
+		template<typename TElem>
+		void add_jac_M_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]) {}
+		template<typename TElem>
+		void add_def_A_elem(LocalVector& d, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]);
+		template<typename TElem>
+		void add_def_M_elem(LocalVector& d, const LocalVector& u, GridObject* elem, const MathVector<dim> vCornerCoords[]) {}
+		template<typename TElem>
+		void add_rhs_elem(LocalVector& rhs, GridObject* elem, const MathVector<dim> vCornerCoords[]);
+	/// \}
+
+		static const int _C_ = 0;
+
+	protected:
+		void register_all_funcs();
+		template<typename TElem> void register_func();
+
+	protected:
+	///	coefficients
+		number m_diffusion, m_source;
+
+	///	current order of disc scheme
+		int m_order;
+
+	///	sum factorization for the current order
+		SmartPtr<sum_fact_type> m_spSumFact;
+
+	///	temporary storage of the sum factorization
+		typename sum_fact_type::Work m_work;
+
+	///	diffusion tensors |det DF| DF^{-1} d DF^{-T} at the integration points
+		std::vector<MathMatrix<dim,dim> > m_vTensor;
+
+	///	|det DF| at the integration points
+		std::vector<number> m_vDetJ;
+
+	///	local coefficients and results
+		std::vector<number> m_vCoeff, m_vRes;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__DIFFUSION_SUM_FACTORIZATION__DIFFUSION_SUM_FACTORIZATION_FE__ */
@@ -122,11 +122,16 @@ int FindClosestVertexInPointSet(const vector_t* pointSet, const Vertex* p,
 
 ////////////////////////////////////////////////////////////////////////
 /**	This method uses Grid::mark
+ *
+ * Close triangles are found with a bounding volume hierarchy. Their
+ * intersections are computed by numThreads threads, while new vertices and
+ * edges are created serially in a fixed order, so that the result does not
+ * depend on the number of threads.
  */
 template <class TAPos>
 bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 							  TriangleIterator trisEnd, number snapThreshold,
-							  TAPos& aPos);
+							  TAPos& aPos, size_t numThreads = 1);
 
 }// end of namespace
 
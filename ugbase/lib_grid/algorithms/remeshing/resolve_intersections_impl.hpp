@@ -33,6 +33,7 @@
 #ifndef __H__UG__resolve_intersections_impl__
 #define __H__UG__resolve_intersections_impl__
 
+#include <algorithm>
 #include <map>
 #include <limits>
 #include "resolve_intersections.h"
@@ -42,6 +43,8 @@
 #include "lib_grid/algorithms/orientation_util.h"
 #include "lib_grid/algorithms/remove_duplicates_util.h"
 #include "lib_grid/algorithms/selection_util.h"
+#include "lib_grid/algorithms/geom_obj_util/vertex_util.h"
+#include "lib_grid/algorithms/space_partitioning/face_bvh.h"
 #include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
 #include "common/space_partitioning/ntree_traverser.h"
 
@@ -1346,17 +1349,160 @@ CalculateBoundingSphere(FaceVertices* face, TAAPos aaPos)
 	s.radius = sqrt(maxDistSq);
 	return s;
 }
+namespace impl{
+namespace ResolveTriangleIntersections{
+///	intersection of a pair of close triangles, found during the narrow phase
+	struct Record{
+		Face*	tri[2];
+		bool	coplanar;
+	///	end points of the intersection of non-coplanar triangles
+		vector3	ip[2];
+	///	whether (tri[0], tri[1]) and (tri[1], tri[0]) intersect if coplanar
+		bool	planarHit[2];
+	///	intersection edges of the coplanar pairs in the point buffer of a thread
+	/**	The edges of the i-th pair are stored in [planarBegin[i], planarBegin[i+1]).*/
+		size_t	planarBegin[3];
+	};
+
+	struct CompareAttachmentDataIndex{
+		CompareAttachmentDataIndex(Grid& g) : grid(g)	{}
+		bool operator()(Face* f1, Face* f2) const
+		{
+			return grid.get_attachment_data_index(f1)
+				   < grid.get_attachment_data_index(f2);
+		}
+		Grid& grid;
+	};
+
+///	performs the narrow phase for the triangles tris[begin] to tris[end-1]
+/**	Only reads the grid and may thus be executed concurrently. Thread t writes
+ * records and coplanar intersection points to vRecords[t] and vPoints[t], in
+ * the order of the first triangle and the attachment data index of the
+ * second one.*/
+	template <class TAAPos>
+	struct NarrowPhaseRange{
+		NarrowPhaseRange(Grid& g, const TAAPos& aaP, const FaceBVH& b,
+						 const std::vector<Face*>& t, number snap,
+						 std::vector<std::vector<Record> >& recs,
+						 std::vector<std::vector<vector3> >& pts)
+			: grid(g), aaPosShared(aaP), bvh(b), tris(t), snapThreshold(snap),
+			  vRecords(recs), vPoints(pts)
+		{}
+
+		void operator()(size_t begin, size_t end, size_t t) const
+		{
+			perform(begin, end, vRecords[t], vPoints[t]);
+		}
+
+		void perform(size_t begin, size_t end, std::vector<Record>& recordsOut,
+					 std::vector<vector3>& pointsOut) const
+		{
+		//	CalculateNormal takes a non-const accessor, hence each range uses a copy
+			TAAPos aaPos = aaPosShared;
+			std::vector<Face*> closeTris;
+			std::vector<vector3> planarIntersections;
+			const vector3 offset(snapThreshold, snapThreshold, snapThreshold);
+
+			for(size_t i_tri = begin; i_tri < end; ++i_tri){
+				Face* t1 = tris[i_tri];
+				vector3 boxMin = aaPos[t1->vertex(0)];
+				vector3 boxMax = boxMin;
+				for(size_t i = 1; i < t1->num_vertices(); ++i){
+					const vector3& p = aaPos[t1->vertex(i)];
+					for(int j = 0; j < 3; ++j){
+						boxMin[j] = std::min(boxMin[j], p[j]);
+						boxMax[j] = std::max(boxMax[j], p[j]);
+					}
+				}
+				boxMin -= offset;
+				boxMax += offset;
+
+			//	find close triangles. We want to make sure that each pair of
+			//	triangles is checked only once and that t1 is not intersected
+			//	with t1. Candidates are processed in the order of their
+			//	attachment data index, which does not depend on the hierarchy.
+				closeTris.clear();
+				bvh.faces_in_box(closeTris, boxMin, boxMax);
+				size_t numClose = 0;
+				const size_t ind1 = grid.get_attachment_data_index(t1);
+				for(size_t i = 0; i < closeTris.size(); ++i){
+					if(grid.get_attachment_data_index(closeTris[i]) > ind1)
+						closeTris[numClose++] = closeTris[i];
+				}
+				closeTris.resize(numClose);
+				std::sort(closeTris.begin(), closeTris.end(),
+						  CompareAttachmentDataIndex(grid));
+
+				for(size_t i_close = 0; i_close < closeTris.size(); ++i_close){
+					Face* t2 = closeTris[i_close];
+					Record rec;
+					rec.tri[0] = t1;
+					rec.tri[1] = t2;
+
+				//	perform normal comparision to handle coplanar triangles
+					vector3 n1, n2;
+					CalculateNormal(n1, t1, aaPos);
+					CalculateNormal(n2, t2, aaPos);
+					number d = VecDot(n1, n2);
+					if(fabs(d) > 1. - snapThreshold){
+					//	if the two triangles aren't in the same plane, there's nothing to do...
+						if(DistancePointToPlane(aaPos[t2->vertex(0)], aaPos[t1->vertex(0)], n1) > snapThreshold)
+							continue;
+					//	perform coplanar triangle intersection for (t1, t2) and (t2, t1)
+						rec.coplanar = true;
+						Face* t[2] = {t1, t2};
+						for(int i = 0; i < 2; ++i){
+							rec.planarBegin[i] = pointsOut.size();
+							rec.planarHit[i] = IntersectCoplanarTriangles(
+												planarIntersections, t[i], t[1-i], aaPos);
+							if(rec.planarHit[i]){
+								pointsOut.insert(pointsOut.end(), planarIntersections.begin(),
+												 planarIntersections.end());
+							}
+						}
+						rec.planarBegin[2] = pointsOut.size();
+						if(rec.planarHit[0] || rec.planarHit[1])
+							recordsOut.push_back(rec);
+						continue;
+					}
+
+				//	since the faces are not coplanar, we have to make sure
+				//	that t1 and t2 do not share an edge (two vertices)
+					if(NumSharedVertices(t1, t2) > 1)
+						continue;
+
+					if(TriangleTriangleIntersection(aaPos[t1->vertex(0)], aaPos[t1->vertex(1)],
+													aaPos[t1->vertex(2)], aaPos[t2->vertex(0)],
+													aaPos[t2->vertex(1)], aaPos[t2->vertex(2)],
+													&rec.ip[0], &rec.ip[1], SMALL) == 1)
+					{
+						rec.coplanar = false;
+						recordsOut.push_back(rec);
+					}
+				}
+			}
+		}
+
+		Grid& grid;
+		TAAPos aaPosShared;
+		const FaceBVH& bvh;
+		const std::vector<Face*>& tris;
+		number snapThreshold;
+		std::vector<std::vector<Record> >& vRecords;
+		std::vector<std::vector<vector3> >& vPoints;
+	};
+}}
+
 ////////////////////////////////////////////////////////////////////////
 /**	This method uses Grid::mark
  */
 template <class TAPos>
 bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 							  TriangleIterator trisEnd, number snapThreshold,
-							  TAPos& aPos)
+							  TAPos& aPos, size_t numThreads)
 {
 	using namespace std;
 	// number snapThresholdSq = sq(snapThreshold);
-//todo: add octree
 //	we use a selector to select elements that shall be merged and
 //	triangles that are to be processed and deleted.
 	Selector sel(grid);
@@ -1373,12 +1519,18 @@ bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 //	PERFORM AND RESOLVE TRIANGLE - TRIANGLE INTERSECTIONS
 	Grid::VertexAttachmentAccessor<TAPos> aaPos(grid, aPos);
 
-//	to speed things up we'll use an octree!
-	typedef lg_ntree<3, 3, Face> octree_t;
-	typedef octree_t::box_t	box_t;
+//	to speed things up we'll use a bounding volume hierarchy!
+	vector<Face*> tris;
+	tris.reserve(sel.num<Triangle>());
+	for(TriangleIterator iter = sel.begin<Triangle>();
+		iter != sel.end<Triangle>(); ++iter)
+	{
+		tris.push_back(*iter);
+	}
 
-	octree_t octree(grid, aPos);
-	octree.create_tree(trisBegin, trisEnd);
+	FaceBVH bvh;
+	bvh.set_num_threads(numThreads);
+	bvh.create(tris, aaPos);
 
 //	clear edges and vertices from the selector. faces have to stay, since we will
 //	operate on them now.
@@ -1400,68 +1552,35 @@ bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 	Grid::FaceAttachmentAccessor<AVrtVec> aaVrtVec(grid, aVrtVec);
 	Grid::FaceAttachmentAccessor<AEdgeDescVec> aaEdgeDescVec(grid, aEdgeDescVec);
 
-	std::vector<vector3> planarIntersections;
-
-//	this vector will be used to find close triangles
-	vector<Face*>	closeTris;
-	Grid::vertex_traits::secure_container vrts;
-
-//	iterate over all triangles and perform intersection with other triangles
-	size_t triCounter = 0;
-	for(TriangleIterator triIter1 = sel.begin<Triangle>();
-		triIter1 != sel.end<Triangle>(); ++triIter1, ++triCounter)
-	{
-		Face* t1 = *triIter1;
-
-		box_t bbox;
-		bbox.min = bbox.max = aaPos[t1->vertex(0)];
-		for(size_t i = 1; i < t1->num_vertices(); ++i)
-			bbox = box_t(bbox, aaPos[t1->vertex(i)]);
-		bbox.min -= vector3(snapThreshold, snapThreshold, snapThreshold);
-		bbox.max += vector3(snapThreshold, snapThreshold, snapThreshold);
-
-	//	find close triangles
-		FindElementsInIntersectingNodes(closeTris, octree, bbox);
-
-	//	iterate over the rest of the triangles
-		for(size_t i_close = 0; i_close < closeTris.size(); ++i_close){
-			Face* t2 = closeTris[i_close];
-			Face* t[2]; t[0] = t1; t[1] = t2;
-
-		//	the attachments have a fixed order throughout the whole iteration...
-		//	we want to make sure that each pair of triangles is checked only once.
-		//	at the same time we avoid that t1 is intersected with t1...
-			if(grid.get_attachment_data_index(t1) >= grid.get_attachment_data_index(t2))
-				continue;
-
-		//	check is obsolete, since only close elements are considered.
-			// Sphere<vector3> s1 = CalculateBoundingSphere(t1, aaPos);
-			// Sphere<vector3> s2 = CalculateBoundingSphere(t2, aaPos);
-			// if(VecDistance(s1.center, s2.center)
-			// 	> (s1.radius + s2.radius + snapThreshold + SMALL))
-			// {
-			// 	continue;
-			// }
-
-		//todo:	Move both triangles closer to the origin to minimize rounding issues...
-			
-		//	perform normal comparision to handle coplanar triangles
-			vector3 n1, n2;
-			CalculateNormal(n1, t1, aaPos);
-			CalculateNormal(n2, t2, aaPos);
-			number d = VecDot(n1, n2);
-			if(fabs(d) > 1. - snapThreshold){
-			//	if the two triangles aren't in the same plane, there's nothing to do...
-				if(DistancePointToPlane(aaPos[t2->vertex(0)], aaPos[t1->vertex(0)], n1) > snapThreshold)
-					continue;
-			//	perform coplanar triangle intersection for tri1 and tri2
+//	find the intersections of all pairs of close triangles. This doesn't alter
+//	the grid and is thus performed concurrently on contiguous ranges of triangles,
+//	using the threads of the hierarchy.
+	using impl::ResolveTriangleIntersections::Record;
+	typedef impl::ResolveTriangleIntersections::
+			NarrowPhaseRange<Grid::VertexAttachmentAccessor<TAPos> >	narrow_phase_t;
+
+	ThreadTeam& team = bvh.thread_team();
+	numThreads = team.num_threads();
+	vector<vector<Record> > vRecords(numThreads);
+	vector<vector<vector3> > vPoints(numThreads);
+	team.run_ranges(tris.size(), narrow_phase_t(grid, aaPos, bvh, tris, snapThreshold,
+												vRecords, vPoints));
+
+//	resolve the intersections in the order in which they were found. New
+//	vertices and edges are only created here.
+	for(size_t i_thread = 0; i_thread < numThreads; ++i_thread){
+		const vector<Record>& records = vRecords[i_thread];
+		const vector<vector3>& points = vPoints[i_thread];
+		for(size_t i_rec = 0; i_rec < records.size(); ++i_rec){
+			const Record& rec = records[i_rec];
+			Face* t[2]; t[0] = rec.tri[0]; t[1] = rec.tri[1];
+
+			if(rec.coplanar){
+				Face* t1 = t[0];
+				Face* t2 = t[1];
 			//	note that t1 and t2 are swapped twice - once at the end of each i_tri iteration.
 				for(int i_tri = 0; i_tri < 2; ++i_tri){
-					if(IntersectCoplanarTriangles(planarIntersections, t1, t2, aaPos)){
-						// if(triCounter == dbgTriInd){
-						// 	UG_LOG("<dbg> Coplanar Triangles Intersected\n");
-						// }
-
+					if(rec.planarHit[i_tri]){
 					//	we have to make sure that the corners of both triangles are
 					//	contained in aVrtVec if an intersection occurs.
 						for(int j_tri = 0; j_tri < 2; ++j_tri){
@@ -1474,18 +1593,18 @@ bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 
 						vector<Vertex*>& vrts = aaVrtVec[t1];
 
-						for(size_t i = 0; i < planarIntersections.size(); i+=2){
+						for(size_t i = rec.planarBegin[i_tri];
+							i < rec.planarBegin[i_tri + 1]; i+=2)
+						{
 							int inds[2];
 							for(int j = 0; j < 2; ++j){
-								inds[j] = FindCloseVertexInArray(vrts,
-																 planarIntersections[i+j],
+								inds[j] = FindCloseVertexInArray(vrts, points[i+j],
 															   	 aaPos, snapThreshold);
 								if(inds[j] == -1){
 								//	check if the vertex is contained in the other tri...
 									vector<Vertex*>& vrts2 = aaVrtVec[t2];
-									int ind = FindCloseVertexInArray(vrts2,
-														planarIntersections[i+j],
-														aaPos, snapThreshold);
+									int ind = FindCloseVertexInArray(vrts2, points[i+j],
+																	 aaPos, snapThreshold);
 									if(ind != -1){
 									//	insert the vertex into t1's list of vertices
 										inds[j] = (int)vrts.size();
@@ -1495,7 +1614,7 @@ bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 								if(inds[j] == -1){
 								//	we have to create a new vertex
 									Vertex* vrt = *grid.create<RegularVertex>();
-									aaPos[vrt] = planarIntersections[i+j];
+									aaPos[vrt] = points[i+j];
 									inds[j] = (int)vrts.size();
 									vrts.push_back(vrt);
 								}
@@ -1510,117 +1629,64 @@ bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 				continue;
 			}
 
-		//	since the faces are not coplanar, we have to make sure
-		//	that t1 and t2 do not share an edge (two vertices)
-			size_t numShared = NumSharedVertices(grid, t1, t2);
-			if(numShared > 1)
-				continue;
-
-			vector3 ip[2];
-			if(TriangleTriangleIntersection(aaPos[t1->vertex(0)], aaPos[t1->vertex(1)],
-											aaPos[t1->vertex(2)], aaPos[t2->vertex(0)],
-											aaPos[t2->vertex(1)], aaPos[t2->vertex(2)],
-											&ip[0], &ip[1], SMALL) == 1)
-			{
-				// if(triCounter == dbgTriInd){
-				// 	UG_LOG("<dbg> tri " << dbgTriInd << " Intersection points: " << ip[0] << ", " << ip[1] << endl);
-				// 	UG_LOG("involved triangles: " << ElementDebugInfo(grid, t1) << std::endl);
-				// 	UG_LOG("               and: " << ElementDebugInfo(grid, t2) << std::endl);
-				// }
-			//	add an edge between the two points
-			//	to avoid insertion of double points, we first check whether the point
-			//	already exists in the triangle. Do this for both triangles.
-
-			//	prepare both triangles.
-			//todo: think about performance optimizations.
-			//	insertion of corner points could be avoided by bloating the code a little.
-			//	this could increase performance.
-				for(size_t i_tri = 0; i_tri < 2; ++i_tri){
-				//	If it is encountered for the first time,
-				//	we'll add its corner-vertices to its list of vertices.
-					Face* tri = t[i_tri];
-					vector<Vertex*>& vrts = aaVrtVec[tri];
-					if(vrts.empty()){
-						for(size_t i = 0; i < tri->num_vertices(); ++i)
-							vrts.push_back(tri->vertex(i));
-					}
-
-				// (a)	this version only checks for close vertices in the list
-				//		of vertices of the currently processed triangle. This
-				//		version will introduce more (and possibly very close)
-				//		vertices, but should be more robust.
-				// todo: only create vertices for each point once, for both tris!
-
-					// int edgeInd[2] = {-1, -1};
-					// for(size_t i_point = 0; i_point < 2; ++i_point){
-					// 	const vector3& point = ip[i_point];
-					// 	int closeInd = FindCloseVertexInArray(aaVrtVec[tri], point,
-					// 								   		  aaPos, snapThreshold);
-							
-					// 	if(closeInd == -1){
-					// 		Vertex* vrt = *grid.create<RegularVertex>();
-					// 		aaPos[vrt] = point;
-					// 		closeInd = (int)aaVrtVec[tri].size();
-					// 		aaVrtVec[tri].push_back(vrt);
-					// 	}
-
-					// 	edgeInd[i_point] = closeInd;
-					// }
-
-					// if(edgeInd[0] != edgeInd[1])
-					// 	aaEdgeDescVec[tri].push_back(
-					// 			make_pair(edgeInd[0], edgeInd[1]));
+		//	add an edge between the two intersection points.
+		//	to avoid insertion of double points, we first check whether the point
+		//	already exists in the triangle. Do this for both triangles.
+		//	If a triangle is encountered for the first time,
+		//	we'll add its corner-vertices to its list of vertices.
+			for(size_t i_tri = 0; i_tri < 2; ++i_tri){
+				Face* tri = t[i_tri];
+				vector<Vertex*>& vrts = aaVrtVec[tri];
+				if(vrts.empty()){
+					for(size_t i = 0; i < tri->num_vertices(); ++i)
+						vrts.push_back(tri->vertex(i));
 				}
+			}
 
-			//	(b) the version below also checks for existing vertices in other tris.
-			//	however, this can lead to vertices which do not lie in the plane
-			//	of an intersecting triangle. This in turn may lead to problems
-			//	during triangulation.
-
-				int inds1[2];
-				int inds2[2];
-				for(size_t i = 0; i < 2; ++i){
-					int tind1 = FindCloseVertexInArray(aaVrtVec[t[0]], ip[i],
-													   aaPos, snapThreshold);
-					int tind2 = FindCloseVertexInArray(aaVrtVec[t[1]], ip[i],
-													   aaPos, snapThreshold);
-					if(tind1 == -1){
-						if(tind2 == -1){
-							// UG_LOG("<dbg> Creating a new vertex in tri intersection at " << ip[i] << std::endl);
-							// UG_LOG("involved triangles: " << ElementDebugInfo(grid, t[0]) << std::endl);
-							// UG_LOG("               and: " << ElementDebugInfo(grid, t[1]) << std::endl);
-						//	we have to create a new vertex
-							Vertex* vrt = *grid.create<RegularVertex>();
-							aaPos[vrt] = ip[i];
-							tind1 = (int)aaVrtVec[t[0]].size();
-							tind2 = (int)aaVrtVec[t[1]].size();
-							aaVrtVec[t[0]].push_back(vrt);
-							aaVrtVec[t[1]].push_back(vrt);
-						}
-						else{
-						//	the vertex already exists in t[1]
-							tind1 = (int)aaVrtVec[t[0]].size();
-							aaVrtVec[t[0]].push_back((aaVrtVec[t[1]])[tind2]);
-						}
-					}
-					else if(tind2 == -1){
-					//	the vertex already exists in t[0]
+		//	we also check for existing vertices in other tris.
+		//	however, this can lead to vertices which do not lie in the plane
+		//	of an intersecting triangle. This in turn may lead to problems
+		//	during triangulation.
+			int inds1[2];
+			int inds2[2];
+			for(size_t i = 0; i < 2; ++i){
+				int tind1 = FindCloseVertexInArray(aaVrtVec[t[0]], rec.ip[i],
+												   aaPos, snapThreshold);
+				int tind2 = FindCloseVertexInArray(aaVrtVec[t[1]], rec.ip[i],
+												   aaPos, snapThreshold);
+				if(tind1 == -1){
+					if(tind2 == -1){
+					//	we have to create a new vertex
+						Vertex* vrt = *grid.create<RegularVertex>();
+						aaPos[vrt] = rec.ip[i];
+						tind1 = (int)aaVrtVec[t[0]].size();
 						tind2 = (int)aaVrtVec[t[1]].size();
-						aaVrtVec[t[1]].push_back((aaVrtVec[t[0]])[tind1]);
+						aaVrtVec[t[0]].push_back(vrt);
+						aaVrtVec[t[1]].push_back(vrt);
+					}
+					else{
+					//	the vertex already exists in t[1]
+						tind1 = (int)aaVrtVec[t[0]].size();
+						aaVrtVec[t[0]].push_back((aaVrtVec[t[1]])[tind2]);
 					}
-
-				//	ind1 now contains the index into the vertex array of t[0], at
-				//	which a vertex with position ip[i] lies.
-					inds1[i] = tind1;
-					inds2[i] = tind2;
 				}
-			//	we found the indices of both endpoints and can now add an edge
-			//	connecting both to the edgeDesc arrays of t[0] and t[1].
-				if(inds1[0] != inds1[1])
-					aaEdgeDescVec[t[0]].push_back(make_pair(inds1[0], inds1[1]));
-				if(inds2[0] != inds2[1])
-					aaEdgeDescVec[t[1]].push_back(make_pair(inds2[0], inds2[1]));
+				else if(tind2 == -1){
+				//	the vertex already exists in t[0]
+					tind2 = (int)aaVrtVec[t[1]].size();
+					aaVrtVec[t[1]].push_back((aaVrtVec[t[0]])[tind1]);
+				}
+
+			//	ind1 now contains the index into the vertex array of t[0], at
+			//	which a vertex with position ip[i] lies.
+				inds1[i] = tind1;
+				inds2[i] = tind2;
 			}
+		//	we found the indices of both endpoints and can now add an edge
+		//	connecting both to the edgeDesc arrays of t[0] and t[1].
+			if(inds1[0] != inds1[1])
+				aaEdgeDescVec[t[0]].push_back(make_pair(inds1[0], inds1[1]));
+			if(inds2[0] != inds2[1])
+				aaEdgeDescVec[t[1]].push_back(make_pair(inds2[0], inds2[1]));
 		}
 	}
 
@@ -1646,7 +1712,7 @@ bool ResolveTriangleIntersections(Grid& grid, TriangleIterator trisBegin,
 	sel.enable_selection_inheritance(false);
 
 	std::vector<Vertex*> dblVrts;
-	triCounter = 0;
+	size_t triCounter = 0;
 	for(TriangleIterator triIter = sel.begin<Triangle>();
 		triIter != sel.end<Triangle>(); ++triIter, ++triCounter)
 	{
@@ -0,0 +1,639 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__jacobi_smoothing__
+#define __H__UG__jacobi_smoothing__
+
+#include <algorithm>
+#include <vector>
+#include "common/types.h"
+#include "common/util/thread_team.h"
+#include "lib_grid/algorithms/geom_obj_util/edge_util.h"
+#include "lib_grid/algorithms/geom_obj_util/face_util.h"
+#ifdef UG_PARALLEL
+	#include "lib_grid/parallelization/distributed_grid.h"
+	#include "lib_grid/parallelization/util/attachment_operations.hpp"
+#endif
+
+namespace ug{
+
+///	entries which are stored in a JacobiSmoothingGraph
+enum JacobiSmoothingGraphEntries{
+	JSGE_EDGES = 1,				///< vertices connected by an edge, weight 1
+	JSGE_OPPOSING_OBJECTS = 1 << 1,	///< corners of objects opposing the vertex in faces and volumes, weight 1 per object
+	JSGE_FACES = 1 << 2			///< corners of associated faces
+};
+
+///	adjacency of vertices in compressed row storage, used by the Jacobi smoothers
+/**	The first numSmoothVrts entries of vrts are the vertices which are smoothed.
+ * They are followed by fixed vertices which are adjacent to smoothed ones.
+ * The neighbors of the i-th smoothed vertex are given by the indices
+ * nbrs[nbrOffsets[i]], ..., nbrs[nbrOffsets[i+1] - 1] into vrts together with
+ * the weights nbrWeights. The corners of the faces associated with the i-th
+ * smoothed vertex are stored in faceCorners, 4 per face, starting at
+ * 4 * faceOffsets[i]. The fourth corner of a triangle is -1.
+ *
+ * In a distributed grid, horizontal slaves and ghosts are ignored, so that
+ * each element contributes on exactly one process.*/
+struct JacobiSmoothingGraph
+{
+	std::vector<Vertex*>	vrts;
+	size_t					numSmoothVrts;
+	std::vector<size_t>		nbrOffsets;
+	std::vector<int>		nbrs;
+	std::vector<number>		nbrWeights;
+	std::vector<size_t>		faceOffsets;
+	std::vector<int>		faceCorners;
+};
+
+
+namespace impl{
+namespace JacobiSmoothing{
+
+///	returns false for horizontal slaves and ghosts in distributed grids
+template <class TElem>
+inline bool ContributesLocally(Grid& grid, TElem* e)
+{
+#ifdef UG_PARALLEL
+	DistributedGridManager* dgm = grid.distributed_grid_manager();
+	if(dgm)
+		return !(dgm->is_ghost(e) || dgm->contains_status(e, ES_H_SLAVE));
+#endif
+	return true;
+}
+
+///	returns the index of v in graph.vrts. Fixed vertices are added on the fly.
+inline int GraphIndex(JacobiSmoothingGraph& graph,
+					  Grid::VertexAttachmentAccessor<AInt>& aaInd, Vertex* v)
+{
+	if(aaInd[v] == -1){
+		aaInd[v] = (int)graph.vrts.size();
+		graph.vrts.push_back(v);
+	}
+	return aaInd[v];
+}
+
+///	adds the corners of obj with a total weight of 1
+inline void AddCorners(JacobiSmoothingGraph& graph,
+					   Grid::VertexAttachmentAccessor<AInt>& aaInd,
+					   const IVertexGroup& obj)
+{
+	const size_t numVrts = obj.num_vertices();
+	for(size_t i = 0; i < numVrts; ++i){
+		graph.nbrs.push_back(GraphIndex(graph, aaInd, obj.vertex(i)));
+		graph.nbrWeights.push_back(1. / (number)numVrts);
+	}
+}
+
+///	adds the corners of the object opposing vrt in f with a total weight of 1
+inline void AddOpposingObject(JacobiSmoothingGraph& graph,
+							  Grid::VertexAttachmentAccessor<AInt>& aaInd,
+							  Vertex* vrt, Face* f)
+{
+	std::pair<GridBaseObjectId, int> id = f->get_opposing_object(vrt);
+	switch(id.first){
+		case VERTEX:
+			graph.nbrs.push_back(GraphIndex(graph, aaInd, f->vertex(id.second)));
+			graph.nbrWeights.push_back(1);
+			break;
+		case EDGE:
+			AddCorners(graph, aaInd, f->edge_desc(id.second));
+			break;
+		default:
+			UG_THROW("Unsupported geometric base object type returned by "
+					 "Face::get_opposing_object(vrt)");
+	}
+}
+
+///	adds the corners of the object opposing vrt in vol with a total weight of 1
+inline void AddOpposingObject(JacobiSmoothingGraph& graph,
+							  Grid::VertexAttachmentAccessor<AInt>& aaInd,
+							  Vertex* vrt, Volume* vol)
+{
+	std::pair<GridBaseObjectId, int> id = vol->get_opposing_object(vrt);
+	switch(id.first){
+		case VERTEX:
+			graph.nbrs.push_back(GraphIndex(graph, aaInd, vol->vertex(id.second)));
+			graph.nbrWeights.push_back(1);
+			break;
+		case EDGE:
+			AddCorners(graph, aaInd, vol->edge_desc(id.second));
+			break;
+		case FACE:
+			AddCorners(graph, aaInd, vol->face_desc(id.second));
+			break;
+		default:
+			UG_THROW("Unsupported geometric base object type returned by "
+					 "Volume::get_opposing_object(vrt)");
+	}
+}
+
+///	calls kernel.accumulate(i) or kernel.update(i) for all i in [begin, end)
+template <class TKernel>
+struct JacobiRange{
+	JacobiRange(TKernel& k, bool acc) :
+		kernel(k), accumulate(acc)
+	{}
+
+	void operator()(size_t begin, size_t end, size_t) const
+	{
+		if(accumulate){
+			for(size_t i = begin; i < end; ++i)
+				kernel.accumulate(i);
+		}
+		else{
+			for(size_t i = begin; i < end; ++i)
+				kernel.update(i);
+		}
+	}
+
+	TKernel&	kernel;
+	bool		accumulate;
+};
+
+///	sums values of smoothed vertices over all copies of horizontal interface vertices
+/**	Does nothing if the grid is not distributed.*/
+template <class TValue>
+class VertexInterfaceSum
+{
+	public:
+		VertexInterfaceSum(Grid& grid, const JacobiSmoothingGraph& graph,
+						   const TValue& zero) :
+			m_grid(grid), m_graph(graph), m_active(false)
+		{
+		#ifdef UG_PARALLEL
+			DistributedGridManager* dgm = grid.distributed_grid_manager();
+			if(!dgm)
+				return;
+			m_active = true;
+			for(size_t i = 0; i < graph.numSmoothVrts; ++i){
+				if(dgm->is_in_horizontal_interface(graph.vrts[i]))
+					m_vIfcInds.push_back(i);
+			}
+			grid.attach_to_vertices_dv(m_a, zero);
+			m_aa.access(grid, m_a);
+		#endif
+		}
+
+		~VertexInterfaceSum()
+		{
+			if(m_active)
+				m_grid.detach_from_vertices(m_a);
+		}
+
+		void sum(std::vector<TValue>& vals)
+		{
+		#ifdef UG_PARALLEL
+			if(!m_active)
+				return;
+			for(size_t i = 0; i < m_vIfcInds.size(); ++i)
+				m_aa[m_graph.vrts[m_vIfcInds[i]]] = vals[m_vIfcInds[i]];
+			AttachmentAllReduce<Vertex>(m_grid, m_a, PCL_RO_SUM);
+			for(size_t i = 0; i < m_vIfcInds.size(); ++i)
+				vals[m_vIfcInds[i]] = m_aa[m_graph.vrts[m_vIfcInds[i]]];
+		#endif
+		}
+
+	private:
+		Grid&								m_grid;
+		const JacobiSmoothingGraph&			m_graph;
+		bool								m_active;
+		std::vector<size_t>					m_vIfcInds;
+		Attachment<TValue>					m_a;
+		Grid::VertexAttachmentAccessor<Attachment<TValue> >	m_aa;
+};
+
+///	performs numIterations double buffered sweeps of the given kernel
+/**	kernel.pos has to hold the positions of all vertices in the graph.
+ * kernel.accumulate computes the sums over the local neighborhood of a vertex,
+ * kernel.sum_over_interfaces completes them in distributed grids and
+ * kernel.update writes the new position to kernel.newPos.
+ *
+ * The smoothed vertices are distributed in contiguous ranges to the threads of
+ * one ThreadTeam, which is used for all sweeps. Since sum_over_interfaces
+ * communicates, accumulate and update are performed in two separate runs.*/
+template <class TKernel>
+void PerformJacobiSweeps(TKernel& kernel, const JacobiSmoothingGraph& graph,
+						 int numIterations, size_t numThreads)
+{
+	const size_t num = graph.numSmoothVrts;
+	ThreadTeam team(std::max<size_t>(1, std::min(numThreads, num)));
+	kernel.newPos = kernel.pos;
+	for(int iteration = 0; iteration < numIterations; ++iteration){
+		team.run_ranges(num, JacobiRange<TKernel>(kernel, true));
+		kernel.sum_over_interfaces();
+		team.run_ranges(num, JacobiRange<TKernel>(kernel, false));
+		kernel.pos.swap(kernel.newPos);
+	}
+}
+
+template <class TAAPos>
+void ReadPositions(std::vector<typename TAAPos::ValueType>& posOut,
+				   const JacobiSmoothingGraph& graph, TAAPos& aaPos)
+{
+	posOut.resize(graph.vrts.size());
+	for(size_t i = 0; i < graph.vrts.size(); ++i)
+		posOut[i] = aaPos[graph.vrts[i]];
+}
+
+template <class TAAPos>
+void WritePositions(TAAPos& aaPos, const JacobiSmoothingGraph& graph,
+					const std::vector<typename TAAPos::ValueType>& pos)
+{
+	for(size_t i = 0; i < graph.numSmoothVrts; ++i)
+		aaPos[graph.vrts[i]] = pos[i];
+}
+
+
+template <class vector_t>
+struct LaplacianKernel{
+	LaplacianKernel(Grid& grid, const JacobiSmoothingGraph& g, number a) :
+		graph(g), alpha(a), sum(g.numSmoothVrts), weight(g.numSmoothVrts, 0),
+		sumIfc(grid, g, vector_t(0))
+	{
+		for(size_t i = 0; i < graph.numSmoothVrts; ++i){
+			for(size_t j = graph.nbrOffsets[i]; j < graph.nbrOffsets[i+1]; ++j)
+				weight[i] += graph.nbrWeights[j];
+		}
+		VertexInterfaceSum<number>(grid, g, 0).sum(weight);
+	}
+
+	void accumulate(size_t i)
+	{
+		vector_t v;
+		VecSet(v, 0);
+		for(size_t j = graph.nbrOffsets[i]; j < graph.nbrOffsets[i+1]; ++j)
+			VecScaleAdd(v, 1, v, graph.nbrWeights[j], pos[graph.nbrs[j]]);
+		sum[i] = v;
+	}
+
+	void sum_over_interfaces()	{sumIfc.sum(sum);}
+
+	void update(size_t i)
+	{
+		if(weight[i] > 0){
+			vector_t v;
+			VecScale(v, sum[i], 1. / weight[i]);
+			VecSubtract(v, v, pos[i]);
+			VecScale(v, v, alpha);
+			VecAdd(newPos[i], pos[i], v);
+		}
+		else
+			newPos[i] = pos[i];
+	}
+
+	const JacobiSmoothingGraph&	graph;
+	number						alpha;
+	std::vector<vector_t>		pos;
+	std::vector<vector_t>		newPos;
+	std::vector<vector_t>		sum;
+	std::vector<number>			weight;
+	VertexInterfaceSum<vector_t>	sumIfc;
+};
+
+
+template <class vector_t>
+struct WeightedEdgeKernel{
+	WeightedEdgeKernel(Grid& grid, const JacobiSmoothingGraph& g, number a,
+					   const std::vector<number>& w) :
+		graph(g), alpha(a), staticWeight(w), sum(g.numSmoothVrts),
+		weight(g.numSmoothVrts), sumIfc(grid, g, vector_t(0)),
+		weightIfc(grid, g, 0)
+	{}
+
+	void accumulate(size_t i)
+	{
+		const vector_t& vrtPos = pos[i];
+		vector_t avDir;
+		VecSet(avDir, 0);
+		number wSum = 0;
+		for(size_t j = graph.nbrOffsets[i]; j < graph.nbrOffsets[i+1]; ++j){
+			vector_t dir;
+			VecSubtract(dir, pos[graph.nbrs[j]], vrtPos);
+			number w = staticWeight[j] * VecLengthSq(dir);
+			dir *= w;
+			VecAdd(avDir, avDir, dir);
+			wSum += w;
+		}
+		sum[i] = avDir;
+		weight[i] = wSum;
+	}
+
+	void sum_over_interfaces()
+	{
+		sumIfc.sum(sum);
+		weightIfc.sum(weight);
+	}
+
+	void update(size_t i)
+	{
+		if(weight[i] > 0){
+			vector_t avDir = sum[i];
+			avDir *= alpha / weight[i];
+			VecAdd(newPos[i], pos[i], avDir);
+		}
+		else
+			newPos[i] = pos[i];
+	}
+
+	const JacobiSmoothingGraph&	graph;
+	number						alpha;
+	const std::vector<number>&	staticWeight;
+	std::vector<vector_t>		pos;
+	std::vector<vector_t>		newPos;
+	std::vector<vector_t>		sum;
+	std::vector<number>			weight;
+	VertexInterfaceSum<vector_t>	sumIfc;
+	VertexInterfaceSum<number>	weightIfc;
+};
+
+
+struct TangentialKernel{
+	TangentialKernel(Grid& grid, const JacobiSmoothingGraph& g, number a) :
+		graph(g), alpha(a), center(g.numSmoothVrts), normal(g.numSmoothVrts),
+		numNbrs(g.numSmoothVrts), centerIfc(grid, g, vector3(0, 0, 0)),
+		normalIfc(grid, g, vector3(0, 0, 0))
+	{
+		for(size_t i = 0; i < graph.numSmoothVrts; ++i)
+			numNbrs[i] = (number)(graph.nbrOffsets[i+1] - graph.nbrOffsets[i]);
+		VertexInterfaceSum<number>(grid, g, 0).sum(numNbrs);
+	}
+
+	void accumulate(size_t i)
+	{
+		vector3 c(0, 0, 0);
+		for(size_t j = graph.nbrOffsets[i]; j < graph.nbrOffsets[i+1]; ++j)
+			VecAdd(c, c, pos[graph.nbrs[j]]);
+		center[i] = c;
+
+		vector3 n(0, 0, 0);
+		for(size_t j = 4 * graph.faceOffsets[i]; j < 4 * graph.faceOffsets[i+1]; j += 4){
+			const int* corners = &graph.faceCorners[j];
+			vector3 tn;
+			if(corners[3] == -1){
+				CalculateTriangleNormal(tn, pos[corners[0]], pos[corners[1]],
+										pos[corners[2]]);
+			}
+			else{
+			//	same as CalculateNormal for quadrilaterals
+				vector3 n1, n2;
+				CalculateTriangleNormalNoNormalize(n1, pos[corners[0]],
+										pos[corners[1]], pos[corners[2]]);
+				CalculateTriangleNormalNoNormalize(n2, pos[corners[2]],
+										pos[corners[3]], pos[corners[0]]);
+				VecAdd(tn, n1, n2);
+				VecNormalize(tn, tn);
+			}
+			VecAdd(n, n, tn);
+		}
+		normal[i] = n;
+	}
+
+	void sum_over_interfaces()
+	{
+		centerIfc.sum(center);
+		normalIfc.sum(normal);
+	}
+
+	void update(size_t i)
+	{
+		if(numNbrs[i] == 0 || graph.faceOffsets[i] == graph.faceOffsets[i+1]){
+			newPos[i] = pos[i];
+			return;
+		}
+		vector3 c;
+		VecScale(c, center[i], 1. / numNbrs[i]);
+
+	//	project the center of connected vertices to the plane through the vertex
+		vector3 cp;
+		ProjectPointToPlane(cp, c, pos[i], normal[i]);
+		VecScaleAdd(newPos[i], (1. - alpha), pos[i], alpha, cp);
+	}
+
+	const JacobiSmoothingGraph&	graph;
+	number						alpha;
+	std::vector<vector3>		pos;
+	std::vector<vector3>		newPos;
+	std::vector<vector3>		center;
+	std::vector<vector3>		normal;
+	std::vector<number>			numNbrs;
+	VertexInterfaceSum<vector3>	centerIfc;
+	VertexInterfaceSum<vector3>	normalIfc;
+};
+
+}// end of namespace JacobiSmoothing
+}// end of namespace impl
+
+
+////////////////////////////////////////////////////////////////////////
+///	builds the adjacency graph of the given vertices for the Jacobi smoothers
+/**	entries is a combination of the constants in JacobiSmoothingGraphEntries.
+ * The vertices of the graph are indexed in the order of the iterator range,
+ * followed by adjacent fixed vertices.*/
+template <class TIterator>
+void BuildJacobiSmoothingGraph(JacobiSmoothingGraph& graphOut, Grid& grid,
+							   TIterator vrtsBegin, TIterator vrtsEnd,
+							   int entries)
+{
+	using namespace impl::JacobiSmoothing;
+	JacobiSmoothingGraph& graph = graphOut;
+	graph.vrts.clear();
+	graph.nbrOffsets.clear();
+	graph.nbrs.clear();
+	graph.nbrWeights.clear();
+	graph.faceOffsets.clear();
+	graph.faceCorners.clear();
+
+	AInt aInd;
+	grid.attach_to_vertices_dv(aInd, -1);
+	Grid::VertexAttachmentAccessor<AInt> aaInd(grid, aInd);
+
+	for(TIterator iter = vrtsBegin; iter != vrtsEnd; ++iter)
+		GraphIndex(graph, aaInd, *iter);
+	graph.numSmoothVrts = graph.vrts.size();
+
+	const bool gotFaces = grid.num<Face>() > 0;
+	const bool gotVols = grid.num<Volume>() > 0;
+
+	Grid::edge_traits::secure_container edges;
+	Grid::face_traits::secure_container faces;
+	Grid::volume_traits::secure_container vols;
+
+	for(size_t i_vrt = 0; i_vrt < graph.numSmoothVrts; ++i_vrt){
+		Vertex* vrt = graph.vrts[i_vrt];
+		graph.nbrOffsets.push_back(graph.nbrs.size());
+		graph.faceOffsets.push_back(graph.faceCorners.size() / 4);
+
+		if(entries & JSGE_EDGES){
+			grid.associated_elements(edges, vrt);
+			for(size_t i = 0; i < edges.size(); ++i){
+				if(!ContributesLocally(grid, edges[i]))
+					continue;
+				graph.nbrs.push_back(GraphIndex(graph, aaInd,
+									 GetConnectedVertex(edges[i], vrt)));
+				graph.nbrWeights.push_back(1);
+			}
+		}
+
+		if(gotFaces && (entries & (JSGE_OPPOSING_OBJECTS | JSGE_FACES))){
+			grid.associated_elements(faces, vrt);
+			for(size_t i = 0; i < faces.size(); ++i){
+				Face* f = faces[i];
+				if(!ContributesLocally(grid, f))
+					continue;
+				if(entries & JSGE_OPPOSING_OBJECTS)
+					AddOpposingObject(graph, aaInd, vrt, f);
+				if(entries & JSGE_FACES){
+					for(size_t j = 0; j < 4; ++j){
+						if(j < f->num_vertices())
+							graph.faceCorners.push_back(GraphIndex(graph, aaInd, f->vertex(j)));
+						else
+							graph.faceCorners.push_back(-1);
+					}
+				}
+			}
+		}
+
+		if(gotVols && (entries & JSGE_OPPOSING_OBJECTS)){
+			grid.associated_elements(vols, vrt);
+			for(size_t i = 0; i < vols.size(); ++i){
+				if(ContributesLocally(grid, vols[i]))
+					AddOpposingObject(graph, aaInd, vrt, vols[i]);
+			}
+		}
+	}
+
+	graph.nbrOffsets.push_back(graph.nbrs.size());
+	graph.faceOffsets.push_back(graph.faceCorners.size() / 4);
+	grid.detach_from_vertices(aInd);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///	Jacobi variant of LaplacianSmooth
+/**	New positions are computed from the positions of the previous iteration
+ * only, so that the result does not depend on the order of the vertices.
+ * The vertices are distributed in contiguous ranges to numThreads threads.
+ *
+ * In a distributed grid, the sums over the neighborhoods of interface vertices
+ * are exchanged in each iteration, so that all copies are moved consistently.
+ * Interface vertices thus have to be smoothed either on all or on none of the
+ * processes which hold a copy.*/
+template <class TIterator, class AAPosVRT>
+void LaplacianSmoothJacobi(Grid& grid, TIterator vrtsBegin,
+						   TIterator vrtsEnd, AAPosVRT& aaPos,
+						   number alpha, int numIterations,
+						   size_t numThreads = 1)
+{
+	using namespace impl::JacobiSmoothing;
+	typedef typename AAPosVRT::ValueType vector_t;
+
+	JacobiSmoothingGraph graph;
+	BuildJacobiSmoothingGraph(graph, grid, vrtsBegin, vrtsEnd,
+							  JSGE_EDGES | JSGE_OPPOSING_OBJECTS);
+
+	LaplacianKernel<vector_t> kernel(grid, graph, alpha);
+	ReadPositions(kernel.pos, graph, aaPos);
+	PerformJacobiSweeps(kernel, graph, numIterations, numThreads);
+	WritePositions(aaPos, graph, kernel.pos);
+}
+
+////////////////////////////////////////////////////////////////////////
+///	Jacobi variant of TangentialSmoothSimple
+/**	In contrast to TangentialSmoothSimple, the center is computed from the
+ * vertices connected by edges. For triangular surfaces both coincide.
+ * See LaplacianSmoothJacobi for threads and distributed grids.*/
+template <class TVrtIter, class TAAPos3>
+void TangentialSmoothSimpleJacobi(Grid& g, TVrtIter vrtsBegin, TVrtIter vrtsEnd,
+								  TAAPos3 aaPos, number alpha,
+								  size_t numIterations, size_t numThreads = 1)
+{
+	using namespace impl::JacobiSmoothing;
+
+	JacobiSmoothingGraph graph;
+	BuildJacobiSmoothingGraph(graph, g, vrtsBegin, vrtsEnd,
+							  JSGE_EDGES | JSGE_FACES);
+
+	TangentialKernel kernel(g, graph, alpha);
+	ReadPositions(kernel.pos, graph, aaPos);
+	PerformJacobiSweeps(kernel, graph, (int)numIterations, numThreads);
+	WritePositions(aaPos, graph, kernel.pos);
+}
+
+////////////////////////////////////////////////////////////////////////
+///	Jacobi variant of WeightedEdgeSmooth
+/**	cbSmoothVertex is only evaluated before the first iteration.
+ * See LaplacianSmoothJacobi for threads and distributed grids.*/
+template <class TIterator, class AAPosVRT>
+void WeightedEdgeSmoothJacobi(Grid& grid, TIterator vrtsBegin,
+							  TIterator vrtsEnd, AAPosVRT& aaPos,
+							  number alpha, int numIterations,
+							  Grid::vertex_traits::callback cbSmoothVertex,
+							  size_t numThreads = 1)
+{
+	using namespace impl::JacobiSmoothing;
+	typedef typename AAPosVRT::ValueType vector_t;
+
+	JacobiSmoothingGraph graph;
+	BuildJacobiSmoothingGraph(graph, grid, vrtsBegin, vrtsEnd, JSGE_EDGES);
+
+//	neighbors which are not smoothed share a weight of 1
+	std::vector<number> numNonSmooth(graph.numSmoothVrts, 0);
+	std::vector<bool> nonSmooth(graph.vrts.size());
+	for(size_t i = 0; i < graph.vrts.size(); ++i)
+		nonSmooth[i] = !cbSmoothVertex(graph.vrts[i]);
+
+	for(size_t i = 0; i < graph.numSmoothVrts; ++i){
+		for(size_t j = graph.nbrOffsets[i]; j < graph.nbrOffsets[i+1]; ++j){
+			if(nonSmooth[graph.nbrs[j]])
+				numNonSmooth[i] += 1;
+		}
+	}
+	VertexInterfaceSum<number>(grid, graph, 0).sum(numNonSmooth);
+
+	std::vector<number> staticWeight(graph.nbrs.size(), 1);
+	for(size_t i = 0; i < graph.numSmoothVrts; ++i){
+		number nonSmoothWeight = 1. / std::max<number>(1, numNonSmooth[i]);
+		for(size_t j = graph.nbrOffsets[i]; j < graph.nbrOffsets[i+1]; ++j){
+			if(nonSmooth[graph.nbrs[j]])
+				staticWeight[j] = nonSmoothWeight;
+		}
+	}
+
+	WeightedEdgeKernel<vector_t> kernel(grid, graph, alpha, staticWeight);
+	ReadPositions(kernel.pos, graph, aaPos);
+	PerformJacobiSweeps(kernel, graph, numIterations, numThreads);
+	WritePositions(aaPos, graph, kernel.pos);
+}
+
+}// end of namespace
+
+#endif
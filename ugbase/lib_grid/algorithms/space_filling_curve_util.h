@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL__
+#define __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL__
+
+#include <string>
+#include "common/types.h"
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+
+namespace ug{
+
+/**
+ * \brief Utilities to order grid elements along space filling curves.
+ *
+ * Elements which are close in space are stored close to each other in memory,
+ * if they are ordered along a space filling curve. Loops over the elements of
+ * a grid thus show a better cache behavior than with the default creation order,
+ * which can become close to random after several refinements and redistributions.
+ *
+ * \defgroup lib_grid_algorithms_space_filling_curve_util space filling curve util
+ * \ingroup lib_grid_algorithms
+ * \{
+ */
+
+///	The types of space filling curves supported by the methods below
+enum SpaceFillingCurveType{
+	SFC_MORTON,		///< Morton- or z-order curve
+	SFC_HILBERT		///< Hilbert curve
+};
+
+///	returns the curve type associated with the given name ("morton" or "hilbert").
+/**	Throws an instance of UGError if the name is not known.*/
+SpaceFillingCurveType SpaceFillingCurveTypeFromString(const std::string& name);
+
+///	returns the index of the given integer coordinates on a Morton curve
+/**	coords has to contain dim entries, each with at most bitsPerDim relevant bits.
+ * dim * bitsPerDim may not exceed 64.*/
+uint64 MortonIndex(const uint32* coords, int dim, int bitsPerDim);
+
+///	returns the index of the given integer coordinates on a Hilbert curve
+/**	coords has to contain dim entries, each with at most bitsPerDim relevant bits.
+ * dim * bitsPerDim may not exceed 64.
+ * The implementation follows J. Skilling, "Programming the Hilbert curve",
+ * AIP Conf. Proc. 707 (2004).*/
+uint64 HilbertIndex(const uint32* coords, int dim, int bitsPerDim);
+
+///	returns the index of a point on a space filling curve through the given box.
+/**	The box is discretized with the highest resolution that fits into 64 bits.
+ * Points outside of the box are projected onto the box.*/
+template <class TVector>
+uint64 SpaceFillingCurveIndex(const TVector& p, const TVector& boxMin,
+							  const TVector& boxMax, SpaceFillingCurveType sfc);
+
+///	Reorders elements of the given type along a space filling curve
+/**	The elements are sorted by level first and along the curve through their
+ * centers second. The new order is applied to the storage of the grid
+ * (including all attached data), to the element lists of each level and,
+ * if specified, to the lists of each subset and level of the given subset handler.
+ *
+ * TElem has to be a base object type (Vertex, Edge, Face or Volume).
+ * The element order is a purely local property and does not affect
+ * parallel interfaces.*/
+template <class TElem, class TAAPos>
+void ReorderElementsAlongSpaceFillingCurve(MultiGrid& mg, ISubsetHandler* sh,
+										   TAAPos aaPos, SpaceFillingCurveType sfc);
+
+///	Reorders all elements of the given grid along a space filling curve
+/**	Calls ReorderElementsAlongSpaceFillingCurve for vertices, edges, faces
+ * and volumes.*/
+template <class TAAPos>
+void ReorderGridAlongSpaceFillingCurve(MultiGrid& mg, ISubsetHandler* sh,
+									   TAAPos aaPos, SpaceFillingCurveType sfc);
+
+/**\}*/
+
+}//	end of namespace
+
+////////////////////////////////
+//	include implementation
+#include "space_filling_curve_util_impl.hpp"
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL_IMPL__
+#define __H__UG__LIB_GRID__SPACE_FILLING_CURVE_UTIL_IMPL__
+
+#include <algorithm>
+#include <vector>
+#include "common/profiler/profiler.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+namespace ug{
+
+template <class TVector>
+uint64 SpaceFillingCurveIndex(const TVector& p, const TVector& boxMin,
+							  const TVector& boxMax, SpaceFillingCurveType sfc)
+{
+	const int dim = (int)TVector::Size;
+	const int bitsPerDim = std::min<int>(32, 64 / dim);
+	const number maxCoord = (number)((((uint64)1) << bitsPerDim) - 1);
+
+	uint32 coords[TVector::Size];
+	for(int i = 0; i < dim; ++i){
+		const number width = boxMax[i] - boxMin[i];
+		number t = 0;
+		if(width > 0)
+			t = (p[i] - boxMin[i]) / width;
+		t = std::max<number>(0, std::min<number>(1, t));
+		coords[i] = (uint32)(t * maxCoord);
+	}
+
+	if(sfc == SFC_HILBERT)
+		return HilbertIndex(coords, dim, bitsPerDim);
+	return MortonIndex(coords, dim, bitsPerDim);
+}
+
+
+namespace sfc_detail{
+///	an element together with its level and its index on a space filling curve
+template <class TElem>
+struct SFCEntry{
+	SFCEntry()	{}
+	SFCEntry(TElem* e, int lvl, uint64 ind) : elem(e), level(lvl), index(ind)	{}
+
+	bool operator<(const SFCEntry& e) const
+	{
+		if(level != e.level)
+			return level < e.level;
+		return index < e.index;
+	}
+
+	TElem*	elem;
+	int		level;
+	uint64	index;
+};
+}//	end of namespace
+
+
+template <class TElem, class TAAPos>
+void ReorderElementsAlongSpaceFillingCurve(MultiGrid& mg, ISubsetHandler* sh,
+										   TAAPos aaPos, SpaceFillingCurveType sfc)
+{
+	PROFILE_FUNC_GROUP("grid");
+	typedef typename TAAPos::ValueType					vector_t;
+	typedef typename geometry_traits<TElem>::iterator	iter_t;
+	typedef sfc_detail::SFCEntry<TElem>					entry_t;
+
+	if(mg.num<TElem>() == 0)
+		return;
+
+//	the curve is laid through the bounding box of all element centers
+	std::vector<vector_t> centers;
+	centers.reserve(mg.num<TElem>());
+	for(iter_t iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter)
+		centers.push_back(CalculateCenter(*iter, aaPos));
+
+	vector_t boxMin = centers.front();
+	vector_t boxMax = centers.front();
+	for(size_t i = 1; i < centers.size(); ++i){
+		for(size_t d = 0; d < vector_t::Size; ++d){
+			boxMin[d] = std::min(boxMin[d], centers[i][d]);
+			boxMax[d] = std::max(boxMax[d], centers[i][d]);
+		}
+	}
+
+	std::vector<entry_t> entries;
+	entries.reserve(centers.size());
+	size_t counter = 0;
+	for(iter_t iter = mg.begin<TElem>(); iter != mg.end<TElem>(); ++iter, ++counter){
+		TElem* e = *iter;
+		entries.push_back(entry_t(e, mg.get_level(e),
+						  SpaceFillingCurveIndex(centers[counter], boxMin, boxMax, sfc)));
+	}
+
+//	stable_sort keeps the relative order of elements with the same index
+//	and thus results in a deterministic order.
+	std::stable_sort(entries.begin(), entries.end());
+
+	std::vector<TElem*> elems(entries.size());
+	for(size_t i = 0; i < entries.size(); ++i)
+		elems[i] = entries[i].elem;
+
+	mg.reorder_elements<TElem>(elems.begin(), elems.end());
+
+//	reassigning an element to its current subset moves it to the end of the
+//	associated list. Since elems is sorted, the lists of each level and each
+//	subset are sorted afterwards, too.
+	ISubsetHandler& hierarchy = mg.get_hierarchy_handler();
+	for(size_t i = 0; i < elems.size(); ++i)
+		hierarchy.assign_subset(elems[i], hierarchy.get_subset_index(elems[i]));
+
+	if(sh){
+		for(size_t i = 0; i < elems.size(); ++i){
+			const int si = sh->get_subset_index(elems[i]);
+			if(si != -1)
+				sh->assign_subset(elems[i], si);
+		}
+	}
+}
+
+
+template <class TAAPos>
+void ReorderGridAlongSpaceFillingCurve(MultiGrid& mg, ISubsetHandler* sh,
+									   TAAPos aaPos, SpaceFillingCurveType sfc)
+{
+	ReorderElementsAlongSpaceFillingCurve<Vertex>(mg, sh, aaPos, sfc);
+	ReorderElementsAlongSpaceFillingCurve<Edge>(mg, sh, aaPos, sfc);
+	ReorderElementsAlongSpaceFillingCurve<Face>(mg, sh, aaPos, sfc);
+	ReorderElementsAlongSpaceFillingCurve<Volume>(mg, sh, aaPos, sfc);
+}
+
+}//	end of namespace
+
+#endif
@@ -0,0 +1,727 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <limits>
+#include "face_bvh.h"
+#include "common/error.h"
+#include "common/math/misc/math_util.h"
+#include "common/profiler/profiler.h"
+
+using namespace std;
+
+namespace ug{
+
+///	a ray with precomputed inverse direction
+struct BVHRay{
+	BVHRay(const vector3& f, const vector3& d) : from(f), dir(d)
+	{
+		for(int i = 0; i < 3; ++i){
+			parallel[i] = (fabs(dir[i]) <= SMALL);
+			invDir[i] = parallel[i] ? 0 : 1. / dir[i];
+		}
+	}
+
+	vector3	from;
+	vector3	dir;
+	vector3	invDir;
+	bool	parallel[3];
+};
+
+///	slab test of a ray against a box which is enlarged by tol.
+/**	Returns false if the parameter interval of the intersection does not
+ * overlap [tMin, tMax]. Otherwise the interval is written to tNearOut, tFarOut.*/
+static inline bool
+RayBox(number& tNearOut, number& tFarOut, const BVHRay& ray,
+	   const vector3& boxMin, const vector3& boxMax, number tol,
+	   number tMin, number tMax)
+{
+	for(int i = 0; i < 3; ++i){
+		if(ray.parallel[i]){
+			if(ray.from[i] < boxMin[i] - tol || ray.from[i] > boxMax[i] + tol)
+				return false;
+			continue;
+		}
+		number t1 = (boxMin[i] - tol - ray.from[i]) * ray.invDir[i];
+		number t2 = (boxMax[i] + tol - ray.from[i]) * ray.invDir[i];
+		if(t1 > t2) swap(t1, t2);
+		tMin = max(tMin, t1);
+		tMax = min(tMax, t2);
+		if(tMin > tMax)
+			return false;
+	}
+	tNearOut = tMin;
+	tFarOut = tMax;
+	return true;
+}
+
+///	squared distance of a point to a box
+static inline number
+BoxDistanceSq(const vector3& p, const vector3& boxMin, const vector3& boxMax)
+{
+	number distSq = 0;
+	for(int i = 0; i < 3; ++i){
+		number d = 0;
+		if(p[i] < boxMin[i])		d = boxMin[i] - p[i];
+		else if(p[i] > boxMax[i])	d = p[i] - boxMax[i];
+		distSq += d * d;
+	}
+	return distSq;
+}
+
+///	returns true if the two boxes intersect
+static inline bool
+BoxesIntersect(const vector3& min1, const vector3& max1,
+			   const vector3& min2, const vector3& max2)
+{
+	for(int i = 0; i < 3; ++i){
+		if(min1[i] > max2[i] || max1[i] < min2[i])
+			return false;
+	}
+	return true;
+}
+
+///	surface area of a box
+static inline number
+BoxArea(const vector3& boxMin, const vector3& boxMax)
+{
+	const number x = boxMax.x() - boxMin.x();
+	const number y = boxMax.y() - boxMin.y();
+	const number z = boxMax.z() - boxMin.z();
+	return 2. * (x * y + y * z + z * x);
+}
+
+static inline void
+GrowBox(vector3& boxMin, vector3& boxMax, const vector3& bMin, const vector3& bMax)
+{
+	for(int i = 0; i < 3; ++i){
+		boxMin[i] = min(boxMin[i], bMin[i]);
+		boxMax[i] = max(boxMax[i], bMax[i]);
+	}
+}
+
+static inline void
+ResetBox(vector3& boxMin, vector3& boxMax)
+{
+	VecSet(boxMin, numeric_limits<number>::max());
+	VecSet(boxMax, -numeric_limits<number>::max());
+}
+
+///	returns true if the center of a face lies left of a binned split
+struct BVHSplitPredicate{
+	BVHSplitPredicate(const vector<vector3>& c, int a, number aMin, number s,
+				   size_t split, size_t nBins)
+		: center(c), axis(a), axisMin(aMin), scale(s), splitBin(split), numBins(nBins)
+	{}
+
+	bool operator()(size_t f) const
+	{
+		const size_t b = min(numBins - 1, (size_t)((center[f][axis] - axisMin) * scale));
+		return b < splitBin;
+	}
+
+	const vector<vector3>& center;
+	int axis;
+	number axisMin, scale;
+	size_t splitBin, numBins;
+};
+
+///	orders intersection records by their local ray coordinate
+struct BVHCompareSMin{
+	bool operator()(const FaceBVH::intersection_record_t& r1,
+					const FaceBVH::intersection_record_t& r2) const
+	{
+		return r1.smin < r2.smin;
+	}
+};
+
+
+struct FaceBVH::BuildData
+{
+	vector<vector_t>	boxMin;
+	vector<vector_t>	boxMax;
+	vector<vector_t>	center;
+	vector<size_t>		ind;
+};
+
+
+struct FaceBVH::BuildTask
+{
+	BuildTask(size_t b, size_t e) : begin(b), end(e)	{}
+	size_t			begin, end;
+	vector<Node>	nodes;
+};
+
+struct FaceBVH::TopNode
+{
+	Node	node;
+	size_t	left, right;
+///	index of the BuildTask of the subtree or -1 for split nodes
+	int		task;
+};
+
+struct FaceBVH::BuildTaskRange
+{
+	BuildTaskRange(const FaceBVH& b, vector<BuildTask>& t, BuildData& d)
+		: bvh(b), vTask(t), bd(d) {}
+
+	void operator()(size_t begin, size_t end, size_t) const
+	{
+		for(size_t i = begin; i < end; ++i)
+			bvh.build(vTask[i].nodes, bd, vTask[i].begin, vTask[i].end);
+	}
+
+	const FaceBVH& bvh;
+	vector<BuildTask>& vTask;
+	BuildData& bd;
+};
+
+
+FaceBVH::FaceBVH() :
+	m_maxLeafSize(4)
+{
+}
+
+void FaceBVH::set_num_threads(size_t numThreads)
+{
+	m_team.set_num_threads(numThreads);
+}
+
+void FaceBVH::set_max_leaf_size(size_t maxLeafSize)
+{
+	m_maxLeafSize = max<size_t>(maxLeafSize, 1);
+}
+
+void FaceBVH::clear()
+{
+	m_vNode.clear();
+	m_vFace.clear();
+	m_vCorner.clear();
+	m_vNumCorners.clear();
+}
+
+void FaceBVH::create(const std::vector<Face*>& faces,
+					 Grid::VertexAttachmentAccessor<AVector3> aaPos)
+{
+	PROFILE_FUNC_GROUP("grid");
+	clear();
+	if(faces.empty())
+		return;
+
+	const size_t numFaces = faces.size();
+	BuildData bd;
+	bd.boxMin.resize(numFaces);
+	bd.boxMax.resize(numFaces);
+	bd.center.resize(numFaces);
+	bd.ind.resize(numFaces);
+
+	for(size_t i = 0; i < numFaces; ++i){
+		Face* f = faces[i];
+		UG_COND_THROW(f->num_vertices() > 4,
+					  "FaceBVH: Only triangles and quadrilaterals are supported.");
+		ResetBox(bd.boxMin[i], bd.boxMax[i]);
+		for(size_t j = 0; j < f->num_vertices(); ++j){
+			const vector_t& p = aaPos[f->vertex(j)];
+			GrowBox(bd.boxMin[i], bd.boxMax[i], p, p);
+		}
+		VecAdd(bd.center[i], bd.boxMin[i], bd.boxMax[i]);
+		VecScale(bd.center[i], bd.center[i], 0.5);
+		bd.ind[i] = i;
+	}
+
+	m_vNode.reserve(2 * numFaces / m_maxLeafSize + 1);
+	const size_t numThreads = m_team.num_threads();
+	if(numThreads > 1 && numFaces > 4096){
+	//	the upper levels are split serially until there is about one subtree
+	//	per thread. The subtrees are then built concurrently and concatenated.
+		vector<TopNode> vTop;
+		vector<BuildTask> vTask;
+		build_top_levels(vTop, vTask, bd, 0, numFaces, numThreads);
+		m_team.run_ranges(vTask.size(), BuildTaskRange(*this, vTask, bd));
+		append_top_levels(m_vNode, vTop, vTask, 0);
+	}
+	else
+		build(m_vNode, bd, 0, numFaces);
+
+//	copy faces and corners in leaf order
+	m_vFace.resize(numFaces);
+	m_vCorner.resize(4 * numFaces);
+	m_vNumCorners.resize(numFaces);
+	for(size_t i = 0; i < numFaces; ++i){
+		Face* f = faces[bd.ind[i]];
+		m_vFace[i] = f;
+		m_vNumCorners[i] = (unsigned char)f->num_vertices();
+		for(size_t j = 0; j < f->num_vertices(); ++j)
+			m_vCorner[4*i + j] = aaPos[f->vertex(j)];
+	}
+}
+
+bool FaceBVH::split(Node& node, size_t& midOut, BuildData& bd, size_t begin,
+					size_t end) const
+{
+	const size_t numBins = 16;
+	const size_t num = end - begin;
+
+	vector_t cMin, cMax;
+	ResetBox(node.boxMin, node.boxMax);
+	ResetBox(cMin, cMax);
+	for(size_t i = begin; i < end; ++i){
+		const size_t f = bd.ind[i];
+		GrowBox(node.boxMin, node.boxMax, bd.boxMin[f], bd.boxMax[f]);
+		GrowBox(cMin, cMax, bd.center[f], bd.center[f]);
+	}
+
+	node.index = (uint32)begin;
+	node.numFaces = (uint32)num;
+
+	if(num <= m_maxLeafSize)
+		return false;
+
+//	find the split with the lowest cost according to the surface area heuristic,
+//	using a traversal cost of 1 and an intersection cost of 1 per face
+	const number nodeArea = BoxArea(node.boxMin, node.boxMax);
+	int bestAxis = -1;
+	size_t bestSplit = 0;
+	number bestCost = numeric_limits<number>::max();
+
+	for(int axis = 0; axis < 3; ++axis){
+		const number ext = cMax[axis] - cMin[axis];
+		if(ext <= 0)
+			continue;
+
+		size_t binCount[numBins];
+		vector_t binMin[numBins], binMax[numBins];
+		for(size_t b = 0; b < numBins; ++b){
+			binCount[b] = 0;
+			ResetBox(binMin[b], binMax[b]);
+		}
+
+		const number scale = numBins / ext;
+		for(size_t i = begin; i < end; ++i){
+			const size_t f = bd.ind[i];
+			const size_t b = min(numBins - 1,
+							(size_t)((bd.center[f][axis] - cMin[axis]) * scale));
+			++binCount[b];
+			GrowBox(binMin[b], binMax[b], bd.boxMin[f], bd.boxMax[f]);
+		}
+
+	//	sweep from the right to get the areas and counts of the right parts
+		number rightArea[numBins];
+		size_t rightCount[numBins];
+		vector_t accMin, accMax;
+		ResetBox(accMin, accMax);
+		size_t accCount = 0;
+		for(size_t b = numBins - 1; b > 0; --b){
+			GrowBox(accMin, accMax, binMin[b], binMax[b]);
+			accCount += binCount[b];
+			rightArea[b] = accCount ? BoxArea(accMin, accMax) : 0;
+			rightCount[b] = accCount;
+		}
+
+		ResetBox(accMin, accMax);
+		accCount = 0;
+		for(size_t s = 1; s < numBins; ++s){
+			GrowBox(accMin, accMax, binMin[s-1], binMax[s-1]);
+			accCount += binCount[s-1];
+			if(accCount == 0 || rightCount[s] == 0)
+				continue;
+			const number cost = 1 + (BoxArea(accMin, accMax) * accCount
+									 + rightArea[s] * rightCount[s]) / nodeArea;
+			if(cost < bestCost){
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = s;
+			}
+		}
+	}
+
+//	create a leaf if splitting does not pay off (but avoid large leaves)
+	if(bestCost >= num && num <= 4 * m_maxLeafSize)
+		return false;
+
+	size_t mid = begin;
+	if(bestAxis >= 0){
+		const number scale = numBins / (cMax[bestAxis] - cMin[bestAxis]);
+		const number axisMin = cMin[bestAxis];
+		const int axis = bestAxis;
+		std::vector<size_t>::iterator iterMid =
+			std::partition(bd.ind.begin() + begin, bd.ind.begin() + end,
+						   BVHSplitPredicate(bd.center, axis, axisMin, scale, bestSplit, numBins));
+		mid = iterMid - bd.ind.begin();
+	}
+
+//	all centers coincide or the binning failed: split in the middle
+	if(mid == begin || mid == end)
+		mid = begin + num / 2;
+
+	node.numFaces = 0;
+	midOut = mid;
+	return true;
+}
+
+void FaceBVH::build(std::vector<Node>& nodes, BuildData& bd, size_t begin,
+					size_t end) const
+{
+	Node node;
+	size_t mid;
+	const size_t nodeInd = nodes.size();
+	const bool bSplit = split(node, mid, bd, begin, end);
+	nodes.push_back(node);
+	if(!bSplit)
+		return;
+
+	build(nodes, bd, begin, mid);
+	nodes[nodeInd].index = (uint32)(nodes.size() - nodeInd);
+	build(nodes, bd, mid, end);
+}
+
+size_t FaceBVH::build_top_levels(std::vector<TopNode>& vTop, std::vector<BuildTask>& vTask,
+								 BuildData& bd, size_t begin, size_t end,
+								 size_t numThreads) const
+{
+	const size_t topInd = vTop.size();
+	vTop.push_back(TopNode());
+
+	Node node;
+	size_t mid;
+	if(numThreads <= 1 || end - begin <= 4096 || !split(node, mid, bd, begin, end)){
+		vTop[topInd].task = (int)vTask.size();
+		vTask.push_back(BuildTask(begin, end));
+		return topInd;
+	}
+
+	vTop[topInd].node = node;
+	vTop[topInd].task = -1;
+	const size_t left = build_top_levels(vTop, vTask, bd, begin, mid, numThreads / 2);
+	const size_t right = build_top_levels(vTop, vTask, bd, mid, end,
+										  numThreads - numThreads / 2);
+	vTop[topInd].left = left;
+	vTop[topInd].right = right;
+	return topInd;
+}
+
+void FaceBVH::append_top_levels(std::vector<Node>& nodes, const std::vector<TopNode>& vTop,
+								const std::vector<BuildTask>& vTask, size_t topInd) const
+{
+	const TopNode& top = vTop[topInd];
+	if(top.task >= 0){
+		const vector<Node>& subtree = vTask[top.task].nodes;
+		nodes.insert(nodes.end(), subtree.begin(), subtree.end());
+		return;
+	}
+
+	const size_t nodeInd = nodes.size();
+	nodes.push_back(top.node);
+	append_top_levels(nodes, vTop, vTask, top.left);
+	nodes[nodeInd].index = (uint32)(nodes.size() - nodeInd);
+	append_top_levels(nodes, vTop, vTask, top.right);
+}
+
+size_t FaceBVH::depth() const
+{
+	if(m_vNode.empty())
+		return 0;
+
+	size_t maxDepth = 0;
+	vector<pair<size_t, size_t> > stack(1, make_pair(0, 1));
+	while(!stack.empty()){
+		const size_t i = stack.back().first;
+		const size_t d = stack.back().second;
+		stack.pop_back();
+		maxDepth = max(maxDepth, d);
+		if(m_vNode[i].numFaces == 0){
+			stack.push_back(make_pair(i + 1, d + 1));
+			stack.push_back(make_pair(i + m_vNode[i].index, d + 1));
+		}
+	}
+	return maxDepth;
+}
+
+number FaceBVH::tolerance(number small) const
+{
+	if(m_vNode.empty())
+		return 0;
+	return small * max<number>(VecDistance(m_vNode[0].boxMin, m_vNode[0].boxMax), 1);
+}
+
+bool FaceBVH::intersect_face(number& sOut, size_t i, const vector_t& from,
+							 const vector_t& dir, number small) const
+{
+	const vector_t* c = &m_vCorner[4*i];
+	vector_t v;
+	number bc1, bc2;
+	for(size_t k = 0; k + 2 < m_vNumCorners[i]; ++k){
+		if(RayTriangleIntersection(v, bc1, bc2, sOut, c[0], c[k+1], c[k+2],
+								   from, dir, small))
+			return true;
+	}
+	return false;
+}
+
+bool FaceBVH::ray_intersections(std::vector<intersection_record_t>& intersectionsOut,
+								const vector_t& from, const vector_t& dir,
+								number small) const
+{
+	intersectionsOut.clear();
+	if(m_vNode.empty())
+		return false;
+
+	const BVHRay ray(from, dir);
+	const number tol = tolerance(small);
+	const number inf = numeric_limits<number>::max();
+
+	vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const size_t i = stack.back();
+		stack.pop_back();
+		const Node& node = m_vNode[i];
+
+		number tNear, tFar;
+		if(!RayBox(tNear, tFar, ray, node.boxMin, node.boxMax, tol, -inf, inf))
+			continue;
+
+		if(node.numFaces > 0){
+			for(size_t j = node.index; j < node.index + node.numFaces; ++j){
+				number s;
+				if(intersect_face(s, j, from, dir, small))
+					intersectionsOut.push_back(intersection_record_t(s, s, m_vFace[j]));
+			}
+		}
+		else{
+			stack.push_back(i + node.index);
+			stack.push_back(i + 1);
+		}
+	}
+
+	sort(intersectionsOut.begin(), intersectionsOut.end(), BVHCompareSMin());
+	return !intersectionsOut.empty();
+}
+
+bool FaceBVH::first_ray_intersection(intersection_record_t& intersectionOut,
+									 const vector_t& from, const vector_t& dir,
+									 number small) const
+{
+	if(m_vNode.empty())
+		return false;
+
+	const BVHRay ray(from, dir);
+	const number tol = tolerance(small);
+	number best = numeric_limits<number>::max();
+	bool found = false;
+
+	vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const size_t i = stack.back();
+		stack.pop_back();
+		const Node& node = m_vNode[i];
+
+		number tNear, tFar;
+		if(!RayBox(tNear, tFar, ray, node.boxMin, node.boxMax, tol, -tol, best))
+			continue;
+
+		if(node.numFaces > 0){
+			for(size_t j = node.index; j < node.index + node.numFaces; ++j){
+				number s;
+				if(intersect_face(s, j, from, dir, small) && s >= -small && s < best){
+					best = s;
+					intersectionOut = intersection_record_t(s, s, m_vFace[j]);
+					found = true;
+				}
+			}
+		}
+		else{
+		//	visit the nearer child first
+			const size_t c1 = i + 1, c2 = i + node.index;
+			number t1Near, t2Near, tmp;
+			const bool hit1 = RayBox(t1Near, tmp, ray, m_vNode[c1].boxMin,
+									 m_vNode[c1].boxMax, tol, -tol, best);
+			const bool hit2 = RayBox(t2Near, tmp, ray, m_vNode[c2].boxMin,
+									 m_vNode[c2].boxMax, tol, -tol, best);
+			if(hit1 && hit2){
+				if(t1Near <= t2Near){
+					stack.push_back(c2);
+					stack.push_back(c1);
+				}
+				else{
+					stack.push_back(c1);
+					stack.push_back(c2);
+				}
+			}
+			else if(hit1)	stack.push_back(c1);
+			else if(hit2)	stack.push_back(c2);
+		}
+	}
+
+	return found;
+}
+
+///	traces a range of rays of a stream
+struct FirstRayIntersectionRange
+{
+	typedef FaceBVH::vector_t				vector_t;
+	typedef FaceBVH::intersection_record_t	intersection_record_t;
+
+	FirstRayIntersectionRange(const FaceBVH& b, vector<intersection_record_t>& is,
+							  vector<char>& h, const vector<vector_t>& f,
+							  const vector<vector_t>& d, number s)
+		: bvh(b), intersections(is), hit(h), from(f), dir(d), small(s)
+	{}
+
+	void operator()(size_t begin, size_t end, size_t) const
+	{
+		for(size_t i = begin; i < end; ++i)
+			hit[i] = bvh.first_ray_intersection(intersections[i], from[i], dir[i], small);
+	}
+
+	const FaceBVH& bvh;
+	vector<intersection_record_t>& intersections;
+	vector<char>& hit;
+	const vector<vector_t>& from;
+	const vector<vector_t>& dir;
+	number small;
+};
+
+void FaceBVH::first_ray_intersections(std::vector<intersection_record_t>& intersectionsOut,
+									  std::vector<bool>& hitOut,
+									  const std::vector<vector_t>& vFrom,
+									  const std::vector<vector_t>& vDir,
+									  number small) const
+{
+	PROFILE_FUNC_GROUP("grid");
+	UG_COND_THROW(vFrom.size() != vDir.size(),
+				  "FaceBVH: Number of ray origins and directions differ.");
+
+	const size_t num = vFrom.size();
+	intersectionsOut.resize(num);
+//	vector<bool> may not be written concurrently
+	vector<char> hit(num, 0);
+
+	m_team.run_ranges(num, FirstRayIntersectionRange(*this, intersectionsOut, hit,
+													 vFrom, vDir, small));
+
+	hitOut.assign(hit.begin(), hit.end());
+}
+
+void FaceBVH::faces_in_box(std::vector<Face*>& facesOut,
+						   const vector_t& boxMin, const vector_t& boxMax) const
+{
+	if(m_vNode.empty())
+		return;
+
+	vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const size_t i = stack.back();
+		stack.pop_back();
+		const Node& node = m_vNode[i];
+
+		if(!BoxesIntersect(boxMin, boxMax, node.boxMin, node.boxMax))
+			continue;
+
+		if(node.numFaces > 0){
+			for(size_t j = node.index; j < node.index + node.numFaces; ++j){
+				const vector_t* c = &m_vCorner[4*j];
+				vector_t fMin = c[0], fMax = c[0];
+				for(size_t k = 1; k < m_vNumCorners[j]; ++k)
+					GrowBox(fMin, fMax, c[k], c[k]);
+				if(BoxesIntersect(boxMin, boxMax, fMin, fMax))
+					facesOut.push_back(m_vFace[j]);
+			}
+		}
+		else{
+			stack.push_back(i + node.index);
+			stack.push_back(i + 1);
+		}
+	}
+}
+
+bool FaceBVH::closest_point(vector_t& pointOut, Face*& faceOut, const vector_t& p) const
+{
+	if(m_vNode.empty())
+		return false;
+
+	number bestDistSq = numeric_limits<number>::max();
+
+	vector<size_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		const size_t i = stack.back();
+		stack.pop_back();
+		const Node& node = m_vNode[i];
+
+		if(BoxDistanceSq(p, node.boxMin, node.boxMax) >= bestDistSq)
+			continue;
+
+		if(node.numFaces > 0){
+			for(size_t j = node.index; j < node.index + node.numFaces; ++j){
+				const vector_t* c = &m_vCorner[4*j];
+				for(size_t k = 0; k + 2 < m_vNumCorners[j]; ++k){
+					vector_t n, d1, d2, v;
+					number bc1, bc2;
+					VecSubtract(d1, c[k+1], c[0]);
+					VecSubtract(d2, c[k+2], c[0]);
+					VecCross(n, d1, d2);
+					const number dist = DistancePointToTriangle(v, bc1, bc2, p,
+														c[0], c[k+1], c[k+2], n);
+					if(dist * dist < bestDistSq){
+						bestDistSq = dist * dist;
+						pointOut = v;
+						faceOut = m_vFace[j];
+					}
+				}
+			}
+		}
+		else{
+		//	visit the nearer child first
+			const size_t c1 = i + 1, c2 = i + node.index;
+			const number d1 = BoxDistanceSq(p, m_vNode[c1].boxMin, m_vNode[c1].boxMax);
+			const number d2 = BoxDistanceSq(p, m_vNode[c2].boxMin, m_vNode[c2].boxMax);
+			if(d1 <= d2){
+				if(d2 < bestDistSq) stack.push_back(c2);
+				if(d1 < bestDistSq) stack.push_back(c1);
+			}
+			else{
+				if(d1 < bestDistSq) stack.push_back(c1);
+				if(d2 < bestDistSq) stack.push_back(c2);
+			}
+		}
+	}
+
+	return bestDistSq < numeric_limits<number>::max();
+}
+
+}//	end of namespace
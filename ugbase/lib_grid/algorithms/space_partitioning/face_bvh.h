@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_GRID__FACE_BVH__
+#define __H__UG__LIB_GRID__FACE_BVH__
+
+#include <vector>
+#include "common/types.h"
+#include "common/util/thread_team.h"
+#include "common/math/ugmath_types.h"
+#include "common/space_partitioning/ntree_traverser.h"
+#include "lib_grid/common_attachments.h"
+#include "lib_grid/grid/grid.h"
+
+namespace ug{
+
+///	Bounding volume hierarchy for fast ray casts and closest point queries on faces in 3d
+/**
+ * The hierarchy is built with a binned surface area heuristic (SAH), which
+ * adapts well to elongated or strongly graded surfaces, for which the
+ * regular subdivision of lg_ntree creates deep trees with many overlapping
+ * boxes. Subtrees of large nodes are built concurrently if more than one
+ * thread is specified. The threads are kept in a ThreadTeam, which lives as
+ * long as the hierarchy.
+ *
+ * Nodes are stored in a flat array in depth-first order, the first child of
+ * an inner node directly follows its parent. The corners of the faces are
+ * copied into the hierarchy in leaf order, so that traversals don't access
+ * the grid. Triangles and quadrilaterals are supported. Quadrilaterals are
+ * intersected as two triangles, just as in RayElementIntersection.
+ *
+ * The hierarchy has to be recreated if the grid or the positions change.
+ * All queries are const and may be performed concurrently.
+ */
+class FaceBVH
+{
+	public:
+		typedef vector3								vector_t;
+		typedef RayElemIntersectionRecord<Face*>	intersection_record_t;
+
+	public:
+		FaceBVH();
+
+	///	sets the number of threads used during creation and in first_ray_intersections
+		void set_num_threads(size_t numThreads);
+
+	///	returns the number of threads
+		size_t num_threads() const						{return m_team.num_threads();}
+
+	///	threads used during creation and in first_ray_intersections
+	/**	May be used to process query results, but not concurrently with
+	 * create or first_ray_intersections.*/
+		ThreadTeam& thread_team() const					{return m_team;}
+
+	///	sets the maximal number of faces in a leaf (default 4)
+		void set_max_leaf_size(size_t maxLeafSize);
+
+	///	removes all faces
+		void clear();
+
+	///	creates the hierarchy for the faces in the given range
+		template <class TIterator>
+		void create(TIterator begin, TIterator end,
+					Grid::VertexAttachmentAccessor<AVector3> aaPos)
+		{
+			std::vector<Face*> faces;
+			for(TIterator iter = begin; iter != end; ++iter)
+				faces.push_back(*iter);
+			create(faces, aaPos);
+		}
+
+	///	creates the hierarchy for the given faces
+		void create(const std::vector<Face*>& faces,
+					Grid::VertexAttachmentAccessor<AVector3> aaPos);
+
+	///	number of faces in the hierarchy
+		size_t num_faces() const						{return m_vFace.size();}
+
+	///	number of nodes in the hierarchy
+		size_t num_nodes() const						{return m_vNode.size();}
+
+	///	depth of the hierarchy
+		size_t depth() const;
+
+	///	returns the i-th face in leaf order
+		Face* face(size_t i) const						{return m_vFace[i];}
+
+	///	all intersections of the line through 'from' in direction 'dir' with the faces
+	/**	Records are sorted by their local ray coordinate, which may be negative.
+	 * The semantics match those of the lg_ntree based RayElementIntersections.
+	 * \returns true if at least one intersection was found.*/
+		bool ray_intersections(std::vector<intersection_record_t>& intersectionsOut,
+							   const vector_t& from, const vector_t& dir,
+							   number small = SMALL) const;
+
+	///	the first intersection of the ray with a local coordinate >= 0
+	/**	\returns true if the ray hits a face.*/
+		bool first_ray_intersection(intersection_record_t& intersectionOut,
+									const vector_t& from, const vector_t& dir,
+									number small = SMALL) const;
+
+	///	first intersections for a stream of rays
+	/**	The rays are distributed in contiguous ranges to the threads. Rays
+	 * which are close to each other should thus be given consecutively.
+	 * hitOut[i] is true if the i-th ray hit a face. Then intersectionsOut[i]
+	 * contains the first intersection.*/
+		void first_ray_intersections(std::vector<intersection_record_t>& intersectionsOut,
+									 std::vector<bool>& hitOut,
+									 const std::vector<vector_t>& vFrom,
+									 const std::vector<vector_t>& vDir,
+									 number small = SMALL) const;
+
+	///	appends all faces whose bounding boxes intersect the given box to facesOut
+	/**	Faces are appended in leaf order.*/
+		void faces_in_box(std::vector<Face*>& facesOut, const vector_t& boxMin,
+						  const vector_t& boxMax) const;
+
+	///	finds the point on the faces which is closest to the given point
+	/**	\returns false if the hierarchy is empty.*/
+		bool closest_point(vector_t& pointOut, Face*& faceOut, const vector_t& p) const;
+
+	private:
+	///	a node of the hierarchy
+	/**	For inner nodes (numFaces == 0), the first child is stored directly
+	 * after the node and 'index' is the offset to the second child. Relative
+	 * offsets allow to concatenate concurrently built subtrees without
+	 * adjustment. For leaves, 'index' is the first face in leaf order.*/
+		struct Node{
+			vector_t	boxMin;
+			vector_t	boxMax;
+			uint32		index;
+			uint32		numFaces;
+		};
+
+	///	temporary data used during creation
+		struct BuildData;
+
+	///	a subtree which is built by one thread
+		struct BuildTask;
+
+	///	a node of the upper levels, which are split before the threads start
+		struct TopNode;
+
+	///	builds the subtrees of a range of BuildTasks
+		struct BuildTaskRange;
+
+	///	computes the node for [begin, end) and splits the range
+	/**	
+eturns false if the node is a leaf. Else midOut is the split index.*/
+		bool split(Node& node, size_t& midOut, BuildData& bd, size_t begin,
+				   size_t end) const;
+
+		void build(std::vector<Node>& nodes, BuildData& bd, size_t begin,
+				   size_t end) const;
+
+		size_t build_top_levels(std::vector<TopNode>& vTop, std::vector<BuildTask>& vTask,
+								BuildData& bd, size_t begin, size_t end,
+								size_t numThreads) const;
+
+		void append_top_levels(std::vector<Node>& nodes, const std::vector<TopNode>& vTop,
+							   const std::vector<BuildTask>& vTask, size_t topInd) const;
+
+		bool intersect_face(number& sOut, size_t i, const vector_t& from,
+							const vector_t& dir, number small) const;
+
+		number tolerance(number small) const;
+
+	private:
+		std::vector<Node>			m_vNode;
+		std::vector<Face*>			m_vFace;
+
+	///	corners of the faces, 4 per face (the 4th is unused for triangles)
+		std::vector<vector_t>		m_vCorner;
+		std::vector<unsigned char>	m_vNumCorners;
+
+	///	threads used in create and first_ray_intersections (mutable, since queries are const)
+		mutable ThreadTeam	m_team;
+		size_t				m_maxLeafSize;
+};
+
+
+///	all intersections of a ray with the faces of a FaceBVH
+/**	Overload of RayElementIntersections for lg_ntree, so that a FaceBVH can
+ * be used as a drop-in acceleration structure.*/
+inline bool RayElementIntersections(
+	std::vector<RayElemIntersectionRecord<Face*> >& intersectionsOut,
+	const FaceBVH& bvh,
+	const vector3& rayFrom,
+	const vector3& rayDir,
+	const number small = 1.e-12)
+{
+	return bvh.ray_intersections(intersectionsOut, rayFrom, rayDir, small);
+}
+
+}//	end of namespace
+
+#endif
@@ -390,6 +390,13 @@ class UG_API AttachmentPipe
 	/**	Aligns data with elements and removes unused data-memory.*/
 		void defragment();
 
+	///	Reorders the data such that the i-th data entry belongs to the i-th element.
+	/**	In contrast to defragment, data is also moved if the pipe is not
+	 * fragmented. Call this method after the order of the elements in the
+	 * associated element handler has changed, to let the data arrays follow
+	 * the new element order.*/
+		void align_data_with_elements();
+
 	/**\brief attaches a new data-array to the pipe.
 	 *
 	 * Attachs a new attachment and creates a container which holds the
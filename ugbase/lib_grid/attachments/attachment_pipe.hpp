@@ -292,6 +292,15 @@ defragment()
 	if(!is_fragmented())
 		return;
 
+	align_data_with_elements();
+	resize_attachment_containers(num_elements());
+}
+
+template <class TElem, class TElemHandler>
+void
+AttachmentPipe<TElem, TElemHandler>::
+align_data_with_elements()
+{
 //	if num_elements == 0, then simply resize all data-containers to 0.
 	if(num_elements() == 0)
 	{
@@ -303,35 +312,45 @@ defragment()
 		}
 		m_stackFreeEntries = UINTStack();
 		m_numDataEntries = 0;
+		m_containerSize = 0;
 	}
 	else
 	{
-	//	calculate the fragmentation array. It has to be of the same size as the fragmented data containers.
-		std::vector<uint> vNewIndices(num_data_entries(), INVALID_ATTACHMENT_INDEX);
+	//	calculate the fragmentation array. It has to be of the same size as the
+	//	data containers.
+		std::vector<size_t> vNewIndices(get_container_size(), INVALID_ATTACHMENT_INDEX);
+
+	//	iterate through the elements and calculate the new index of each.
+	//	Note that the element handler may itself store its element-links in this
+	//	pipe. Data indices thus may only be changed after all data has been moved.
+		std::vector<TElem> vElems;
+		vElems.reserve(num_elements());
 
-	//	iterate through the elements and calculate the new index of each
-		size_t counter = 0;
 		typename atraits::element_iterator iter = atraits::elements_begin(m_pHandler);
 		typename atraits::element_iterator end = atraits::elements_end(m_pHandler);
 
 		for(; iter != end; ++iter){
-			vNewIndices[atraits::get_data_index(m_pHandler, (*iter))] = counter;
-			atraits::set_data_index(m_pHandler, (*iter), counter);
-			++counter;
+			vNewIndices[atraits::get_data_index(m_pHandler, (*iter))] = vElems.size();
+			vElems.push_back(*iter);
 		}
 
-	//	after defragmentation there are no free indices.
-		m_stackFreeEntries = UINTStack();
-		m_numDataEntries = counter;
-
 	//	now iterate through the attached data-containers and defragment each one.
+	//	The size of the containers is restored afterwards, so that no reallocation
+	//	is triggered by the next registered elements.
+		const size_t containerSize = get_container_size();
+		for(AttachmentEntryIterator iter = m_attachmentEntryContainer.begin();
+					iter != m_attachmentEntryContainer.end(); iter++)
 		{
-			for(AttachmentEntryIterator iter = m_attachmentEntryContainer.begin();
-						iter != m_attachmentEntryContainer.end(); iter++)
-			{
-				(*iter).m_pContainer->defragment(&vNewIndices.front(), num_elements());
-			}
+			(*iter).m_pContainer->defragment(&vNewIndices.front(), vElems.size());
+			(*iter).m_pContainer->resize(containerSize);
 		}
+
+		for(size_t i = 0; i < vElems.size(); ++i)
+			atraits::set_data_index(m_pHandler, vElems[i], i);
+
+	//	after defragmentation there are no free indices.
+		m_stackFreeEntries = UINTStack();
+		m_numDataEntries = vElems.size();
 	}
 }
 
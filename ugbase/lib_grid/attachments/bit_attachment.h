@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__bit_attachment__
+#define __H__UG__bit_attachment__
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include "common/types.h"
+#include "attachment_pipe.h"
+
+namespace ug
+{
+
+///	returns the number of set bits in the given word
+inline size_t PopCount(uint64 w)
+{
+#ifdef __GNUC__
+	return (size_t)__builtin_popcountll(w);
+#else
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (size_t)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+///	returns the index of the lowest set bit in the given word. w must not be 0.
+inline size_t LowestSetBit(uint64 w)
+{
+#ifdef __GNUC__
+	return (size_t)__builtin_ctzll(w);
+#else
+	size_t i = 0;
+	while(!(w & 1)){
+		w >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+///	An attachment data container which stores one bit per entry.
+/**	The bits are packed into 64 bit words, so that operations on all entries
+ * (reset_all, count, unite, intersect, subtract, for_each_set_bit) process 64
+ * entries at once.
+ *
+ * Bits in the last word beyond size() are always zero.
+ *
+ * Note that the container does not feature get_elem and thus can't be used
+ * with AttachmentAccessors. Access the container directly instead (e.g. through
+ * Grid::get_attachment_data_container) and use the grid data index of an
+ * element as index.
+ */
+class UG_API BitAttachmentDataContainer : public IAttachmentDataContainer
+{
+	public:
+		typedef bool	ValueType;
+		typedef uint64	word_t;
+
+		enum{BITS_PER_WORD = 64};
+
+		BitAttachmentDataContainer() : m_size(0)	{}
+
+		virtual ~BitAttachmentDataContainer()		{}
+
+		virtual void resize(size_t iSize)
+			{
+				m_vWords.resize(num_words_for(iSize), 0);
+				m_size = iSize;
+				clear_unused_bits();
+			}
+
+		virtual size_t size()						{return m_size;}
+
+		virtual void copy_data(size_t indFrom, size_t indTo)	{set(indTo, test(indFrom));}
+
+		virtual void reset_entry(size_t index)		{reset(index);}
+
+		virtual void defragment(size_t* pNewIndices, size_t numValidElements)
+			{
+				std::vector<word_t> vWordsOld(num_words_for(numValidElements), 0);
+				vWordsOld.swap(m_vWords);
+				const size_t numOldElems = m_size;
+				m_size = numValidElements;
+				for(size_t i = 0; i < numOldElems; ++i){
+					const size_t nInd = pNewIndices[i];
+					if(nInd != INVALID_ATTACHMENT_INDEX
+					   && (vWordsOld[i / BITS_PER_WORD] & bit(i)))
+					{
+						set(nInd);
+					}
+				}
+			}
+
+		virtual void copy_to_container(IAttachmentDataContainer* pDestCon,
+									   int* indexMap, int num) const
+			{
+				BitAttachmentDataContainer* destCon =
+						dynamic_cast<BitAttachmentDataContainer*>(pDestCon);
+				assert(destCon && "Type of pDestBuf has to be the same as the"
+						"type of this buffer");
+
+				if(!destCon)
+					return;
+
+				for(int i = 0; i < num; ++i)
+					destCon->set(i, test(indexMap[i]));
+			}
+
+		virtual size_t occupied_memory()
+			{
+				return m_vWords.capacity() * sizeof(word_t);
+			}
+
+		inline bool test(size_t index) const
+			{
+				assert(index < m_size);
+				return (m_vWords[index / BITS_PER_WORD] & bit(index)) != 0;
+			}
+
+		inline void set(size_t index)
+			{
+				assert(index < m_size);
+				m_vWords[index / BITS_PER_WORD] |= bit(index);
+			}
+
+		inline void set(size_t index, bool value)
+			{
+				if(value)	set(index);
+				else		reset(index);
+			}
+
+		inline void reset(size_t index)
+			{
+				assert(index < m_size);
+				m_vWords[index / BITS_PER_WORD] &= ~bit(index);
+			}
+
+	///	sets all bits to zero
+		void reset_all()
+			{
+				std::fill(m_vWords.begin(), m_vWords.end(), 0);
+			}
+
+	///	returns the number of set bits
+		size_t count() const
+			{
+				size_t num = 0;
+				for(size_t i = 0; i < m_vWords.size(); ++i)
+					num += PopCount(m_vWords[i]);
+				return num;
+			}
+
+	///	sets all bits which are set in the given container
+	/**	Both containers have to belong to the same attachment pipe.*/
+		void unite(const BitAttachmentDataContainer& c)
+			{
+				assert(c.m_vWords.size() == m_vWords.size());
+				for(size_t i = 0; i < m_vWords.size(); ++i)
+					m_vWords[i] |= c.m_vWords[i];
+			}
+
+	///	resets all bits which are not set in the given container
+	/**	Both containers have to belong to the same attachment pipe.*/
+		void intersect(const BitAttachmentDataContainer& c)
+			{
+				assert(c.m_vWords.size() == m_vWords.size());
+				for(size_t i = 0; i < m_vWords.size(); ++i)
+					m_vWords[i] &= c.m_vWords[i];
+			}
+
+	///	resets all bits which are set in the given container
+	/**	Both containers have to belong to the same attachment pipe.*/
+		void subtract(const BitAttachmentDataContainer& c)
+			{
+				assert(c.m_vWords.size() == m_vWords.size());
+				for(size_t i = 0; i < m_vWords.size(); ++i)
+					m_vWords[i] &= ~c.m_vWords[i];
+			}
+
+	///	calls func(index) for each set bit in ascending order
+	/**	Zero words are skipped as a whole. Bits may be changed by func, changes
+	 * in the word of the current index are however not considered.*/
+		template <class TFunc>
+		void for_each_set_bit(TFunc func) const
+			{
+				for(size_t i = 0; i < m_vWords.size(); ++i){
+					word_t w = m_vWords[i];
+					while(w){
+						func(i * BITS_PER_WORD + LowestSetBit(w));
+						w &= w - 1;
+					}
+				}
+			}
+
+		inline size_t num_words() const				{return m_vWords.size();}
+		inline const word_t* words() const			{return m_vWords.empty() ? NULL : &m_vWords.front();}
+
+	///	swaps the buffer content of associated data
+		void swap(BitAttachmentDataContainer& container)
+			{
+				m_vWords.swap(container.m_vWords);
+				std::swap(m_size, container.m_size);
+			}
+
+	protected:
+		static inline size_t num_words_for(size_t numBits)
+			{return (numBits + BITS_PER_WORD - 1) / BITS_PER_WORD;}
+
+		static inline word_t bit(size_t index)
+			{return (word_t)1 << (index % BITS_PER_WORD);}
+
+		void clear_unused_bits()
+			{
+				if(m_size % BITS_PER_WORD)
+					m_vWords.back() &= bit(m_size) - 1;
+			}
+
+	protected:
+		std::vector<word_t>	m_vWords;
+		size_t				m_size;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+///	An attachment which stores one bit per element in a BitAttachmentDataContainer
+/**	Note that BitAttachment can't be used with AttachmentAccessors, see
+ * BitAttachmentDataContainer for more information.*/
+class UG_API BitAttachment : public IAttachment
+{
+	public:
+		typedef BitAttachmentDataContainer	ContainerType;
+		typedef bool						ValueType;
+
+		BitAttachment() : IAttachment()								{}
+		BitAttachment(const char* name) : IAttachment(name)		{}
+
+		virtual ~BitAttachment()	{}
+		virtual IAttachment* clone()							{IAttachment* pA = new BitAttachment; *pA = *this; return pA;}
+		virtual IAttachmentDataContainer* create_container()	{return new ContainerType;}
+		virtual bool default_pass_on_behaviour() const			{return false;}
+};
+
+}//	end of namespace
+
+#endif
@@ -0,0 +1,1557 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <list>
+#include <sstream>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include "common/common.h"
+#include "common/serialization.h"
+#include "common/boost_serialization_routines.h"
+#include "common/util/archivar.h"
+#include "common/util/factory.h"
+#include "lib_grid/refinement/projectors/projectors.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+#include "lib_grid/tools/selector_grid.h"
+#include "file_io_ugb.h"
+#include "file_io_ugx.h"
+
+using namespace std;
+
+namespace ug
+{
+
+static const char* const UGBMagic = "UG4GRDB";
+static const uint32_t UGBByteOrder = 0x01020304;
+static const uint64_t UGBAlignment = 64;
+
+///	returns the base object id of the given UGBElementType
+static int UGBBaseObjectId(uint32_t elemType)
+{
+	if(elemType <= UGB_CONSTRAINED_VERTEX)
+		return VERTEX;
+	if(elemType <= UGB_CONSTRAINED_EDGE)
+		return EDGE;
+	if(elemType <= UGB_CONSTRAINED_QUADRILATERAL)
+		return FACE;
+	return VOLUME;
+}
+
+///	subset handler and selector flags for each base object id
+static const uint UGBElementFlags[] = {SHE_VERTEX, SHE_EDGE, SHE_FACE, SHE_VOLUME};
+
+///	a serialized projector of a projection handler
+struct UGBProjectorEntry
+{
+	bool	isDefault;
+	int		subset;
+	string	type;
+	string	data;
+};
+
+static void WriteUGBProjector(ostream& out, RefinementProjector& proj,
+							  bool isDefault, int subset)
+{
+	static Factory<RefinementProjector, ProjectorTypes>	projFac;
+	static Archivar<boost::archive::text_oarchive, RefinementProjector, ProjectorTypes>	archivar;
+
+	stringstream ss;
+	boost::archive::text_oarchive ar(ss, boost::archive::no_header);
+	archivar.archive(ar, proj);
+
+	Serialize(out, isDefault);
+	Serialize(out, subset);
+	Serialize(out, projFac.class_name(proj));
+	Serialize(out, ss.str());
+}
+
+static SPRefinementProjector ReadUGBProjector(const UGBProjectorEntry& entry)
+{
+	static Factory<RefinementProjector, ProjectorTypes>	projFac;
+	static Archivar<boost::archive::text_iarchive, RefinementProjector, ProjectorTypes>	archivar;
+
+	try {
+		SPRefinementProjector proj = projFac.create(entry.type);
+		stringstream ss(entry.data, ios_base::in);
+		boost::archive::text_iarchive ar(ss, boost::archive::no_header);
+		archivar.archive(ar, *proj);
+		return proj;
+	}
+	catch(boost::archive::archive_exception& e){
+		UG_LOG("WARNING: Couldn't read projector of type '" << entry.type << "'." << endl);
+	}
+	return SPRefinementProjector();
+}
+
+///	reads the description of a projection handler. projsOut may be NULL.
+static void ReadUGBProjectionHandler(const string& blob, string& nameOut,
+									 size_t& shIndexOut,
+									 vector<UGBProjectorEntry>* projsOut)
+{
+	stringstream in(blob, ios_base::in);
+	Deserialize(in, nameOut);
+	Deserialize(in, shIndexOut);
+	if(!projsOut)
+		return;
+
+	size_t numProjs;
+	Deserialize(in, numProjs);
+	projsOut->resize(numProjs);
+	for(size_t i = 0; i < numProjs; ++i){
+		UGBProjectorEntry& e = (*projsOut)[i];
+		Deserialize(in, e.isDefault);
+		Deserialize(in, e.subset);
+		Deserialize(in, e.type);
+		Deserialize(in, e.data);
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh, const char* filename)
+{
+	if(grid.has_vertex_attachment(aPosition))
+		return SaveGridToUGB(grid, sh, filename, aPosition);
+	else if(grid.has_vertex_attachment(aPosition2))
+		return SaveGridToUGB(grid, sh, filename, aPosition2);
+	else if(grid.has_vertex_attachment(aPosition1))
+		return SaveGridToUGB(grid, sh, filename, aPosition1);
+
+	UG_LOG("ERROR in SaveGridToUGB: no standard attachment found.\n");
+	return false;
+}
+
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh, const char* filename)
+{
+	if(grid.has_vertex_attachment(aPosition))
+		return LoadGridFromUGB(grid, sh, filename, aPosition);
+	else if(grid.has_vertex_attachment(aPosition2))
+		return LoadGridFromUGB(grid, sh, filename, aPosition2);
+	else if(grid.has_vertex_attachment(aPosition1))
+		return LoadGridFromUGB(grid, sh, filename, aPosition1);
+
+//	no standard position attachments are available.
+//	Attach aPosition and use it.
+	grid.attach_to_vertices(aPosition);
+	return LoadGridFromUGB(grid, sh, filename, aPosition);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	converters
+namespace{
+///	gives access to the number of coordinates stored in a ugx file
+class UGXCoordinateReader : public GridReaderUGX
+{
+	public:
+		size_t num_coordinates(size_t gridIndex)
+		{
+			rapidxml::xml_node<>* vrtNode =
+					m_entries.at(gridIndex).node->first_node("vertices");
+			if(!vrtNode)
+				vrtNode = m_entries[gridIndex].node->first_node("constrained_vertices");
+			if(vrtNode){
+				rapidxml::xml_attribute<>* attrib = vrtNode->first_attribute("coords");
+				if(attrib)
+					return (size_t)max(1, atoi(attrib->value()));
+			}
+			return 3;
+		}
+};
+}
+
+template <class TAPos>
+static void ConvertUGXGrid(UGXCoordinateReader& ugxReader, GridWriterUGB& ugbWriter,
+						   size_t gridIndex, Grid& grid, TAPos& aPos,
+						   vector<SmartPtr<SubsetHandler> >& shsOut)
+{
+	ugxReader.grid(grid, gridIndex, aPos);
+	ugbWriter.add_grid(grid, ugxReader.get_grid_name(gridIndex), aPos);
+
+	for(size_t i = 0; i < ugxReader.num_subset_handlers(gridIndex); ++i){
+		SmartPtr<SubsetHandler> sh = make_sp(new SubsetHandler(grid));
+		ugxReader.subset_handler(*sh, i, gridIndex);
+		ugbWriter.add_subset_handler(*sh, ugxReader.get_subset_handler_name(gridIndex, i),
+									 gridIndex);
+		shsOut.push_back(sh);
+	}
+
+	for(size_t i = 0; i < ugxReader.num_selectors(gridIndex); ++i){
+		Selector sel(grid);
+		ugxReader.selector(sel, i, gridIndex);
+		ugbWriter.add_selector(sel, ugxReader.get_selector_name(gridIndex, i), gridIndex);
+	}
+
+	const size_t firstSH = shsOut.size() - ugxReader.num_subset_handlers(gridIndex);
+	for(size_t i = 0; i < ugxReader.num_projection_handlers(gridIndex); ++i){
+		size_t shIndex = ugxReader.get_projection_handler_subset_handler_index(i, gridIndex);
+		UG_COND_THROW(firstSH + shIndex >= shsOut.size(),
+					  "Bad subset handler index of projection handler " << i);
+		ProjectionHandler ph(shsOut[firstSH + shIndex].get());
+		ugxReader.projection_handler(ph, i, gridIndex);
+		ugbWriter.add_projection_handler(ph, ugxReader.get_projection_handler_name(gridIndex, i),
+										 gridIndex);
+	}
+}
+
+bool ConvertUGXToUGB(const char* ugxFilename, const char* ugbFilename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	UGXCoordinateReader ugxReader;
+	if(!ugxReader.parse_file(ugxFilename)){
+		UG_LOG("ERROR in ConvertUGXToUGB: File not found: " << ugxFilename << endl);
+		return false;
+	}
+
+//	grids and subset handlers have to exist until the writer is closed
+	vector<SmartPtr<Grid> > grids;
+	vector<SmartPtr<SubsetHandler> > shs;
+	GridWriterUGB ugbWriter(ugbFilename);
+
+	for(size_t i = 0; i < ugxReader.num_grids(); ++i){
+		grids.push_back(make_sp(new Grid));
+		Grid& grid = *grids.back();
+		switch(ugxReader.num_coordinates(i)){
+			case 1:	ConvertUGXGrid(ugxReader, ugbWriter, i, grid, aPosition1, shs); break;
+			case 2:	ConvertUGXGrid(ugxReader, ugbWriter, i, grid, aPosition2, shs); break;
+			default: ConvertUGXGrid(ugxReader, ugbWriter, i, grid, aPosition, shs); break;
+		}
+	}
+
+	ugbWriter.close();
+	return true;
+}
+
+template <class TAPos>
+static void ConvertUGBGrid(GridReaderUGB& ugbReader, GridWriterUGX& ugxWriter,
+						   size_t gridIndex, Grid& grid, TAPos& aPos,
+						   vector<SmartPtr<SubsetHandler> >& shsOut,
+						   list<string>& namesOut)
+{
+//	GridWriterUGX doesn't copy names
+	ugbReader.grid(grid, gridIndex, aPos);
+	namesOut.push_back(ugbReader.get_grid_name(gridIndex));
+	ugxWriter.add_grid(grid, namesOut.back().c_str(), aPos);
+
+	const size_t firstSH = shsOut.size();
+	for(size_t i = 0; i < ugbReader.num_subset_handlers(gridIndex); ++i){
+		SmartPtr<SubsetHandler> sh = make_sp(new SubsetHandler(grid));
+		ugbReader.subset_handler(*sh, i, gridIndex);
+		namesOut.push_back(ugbReader.get_subset_handler_name(gridIndex, i));
+		ugxWriter.add_subset_handler(*sh, namesOut.back().c_str(), gridIndex);
+		shsOut.push_back(sh);
+	}
+
+	for(size_t i = 0; i < ugbReader.num_selectors(gridIndex); ++i){
+		Selector sel(grid);
+		ugbReader.selector(sel, i, gridIndex);
+		namesOut.push_back(ugbReader.get_selector_name(gridIndex, i));
+		ugxWriter.add_selector(sel, namesOut.back().c_str(), gridIndex);
+	}
+
+	for(size_t i = 0; i < ugbReader.num_projection_handlers(gridIndex); ++i){
+		size_t shIndex = ugbReader.get_projection_handler_subset_handler_index(i, gridIndex);
+		UG_COND_THROW(firstSH + shIndex >= shsOut.size(),
+					  "Bad subset handler index of projection handler " << i);
+		ProjectionHandler ph(shsOut[firstSH + shIndex].get());
+		ugbReader.projection_handler(ph, i, gridIndex);
+		namesOut.push_back(ugbReader.get_projection_handler_name(gridIndex, i));
+		ugxWriter.add_projection_handler(ph, namesOut.back().c_str(), gridIndex);
+	}
+}
+
+bool ConvertUGBToUGX(const char* ugbFilename, const char* ugxFilename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	GridReaderUGB ugbReader(ugbFilename);
+
+//	grids, subset handlers and names have to exist until the writer is destroyed
+	vector<SmartPtr<Grid> > grids;
+	vector<SmartPtr<SubsetHandler> > shs;
+	list<string> names;
+	GridWriterUGX ugxWriter;
+
+	for(size_t i = 0; i < ugbReader.num_grids(); ++i){
+		grids.push_back(make_sp(new Grid));
+		Grid& grid = *grids.back();
+		switch(ugbReader.num_coordinates(i)){
+			case 1:	ConvertUGBGrid(ugbReader, ugxWriter, i, grid, aPosition1, shs, names); break;
+			case 2:	ConvertUGBGrid(ugbReader, ugxWriter, i, grid, aPosition2, shs, names); break;
+			default: ConvertUGBGrid(ugbReader, ugxWriter, i, grid, aPosition, shs, names); break;
+		}
+	}
+
+	return ugxWriter.write_to_file(ugxFilename);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	GridWriterUGB
+GridWriterUGB::GridWriterUGB() : m_pos(0)
+{
+}
+
+GridWriterUGB::GridWriterUGB(const char* filename) : m_pos(0)
+{
+	open(filename);
+}
+
+GridWriterUGB::~GridWriterUGB()
+{
+	try{
+		close();
+	}
+	catch(UGError& err){
+		UG_LOG("ERROR in GridWriterUGB: " << err.get_msg() << endl);
+	}
+}
+
+void GridWriterUGB::open(const char* filename)
+{
+	close();
+	m_out.open(filename, ios::out | ios::binary | ios::trunc);
+	UG_COND_THROW(!m_out, "GridWriterUGB: Couldn't open file '" << filename << "' for writing.");
+	m_filename = filename;
+
+//	the header is written on close, when the chunk table is known
+	UGBFileHeader header;
+	memset(&header, 0, sizeof(header));
+	m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	m_pos = sizeof(header);
+}
+
+void GridWriterUGB::close()
+{
+	if(m_out.is_open()){
+		char zeros[UGBAlignment] = {0};
+		uint64_t tableOffset = (m_pos + UGBAlignment - 1) / UGBAlignment * UGBAlignment;
+		m_out.write(zeros, tableOffset - m_pos);
+		if(!m_chunks.empty()){
+			m_out.write(reinterpret_cast<const char*>(&m_chunks.front()),
+						m_chunks.size() * sizeof(UGBChunk));
+		}
+
+		UGBFileHeader header;
+		memset(&header, 0, sizeof(header));
+		strcpy(header.magic, UGBMagic);
+		header.version = UGBFileVersion;
+		header.byteOrder = UGBByteOrder;
+		header.numChunks = m_chunks.size();
+		header.chunkTableOffset = tableOffset;
+		m_out.seekp(0);
+		m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		m_out.close();
+		UG_COND_THROW(!m_out, "GridWriterUGB: Couldn't write to file '" << m_filename << "'.");
+	}
+
+	for(size_t i = 0; i < m_entries.size(); ++i){
+		Grid& grid = *m_entries[i].grid;
+		grid.detach_from_vertices(m_aInt);
+		grid.detach_from_edges(m_aInt);
+		grid.detach_from_faces(m_aInt);
+		grid.detach_from_volumes(m_aInt);
+	}
+
+	m_entries.clear();
+	m_chunks.clear();
+	m_filename.clear();
+	m_pos = 0;
+}
+
+void GridWriterUGB::
+begin_chunk(UGBChunkType type, size_t gridIndex, size_t index,
+			size_t level, size_t elemType)
+{
+	char zeros[UGBAlignment] = {0};
+	uint64_t offset = (m_pos + UGBAlignment - 1) / UGBAlignment * UGBAlignment;
+	m_out.write(zeros, offset - m_pos);
+	m_pos = offset;
+
+	UGBChunk chunk;
+	memset(&chunk, 0, sizeof(chunk));
+	chunk.type = type;
+	chunk.grid = (uint32_t)gridIndex;
+	chunk.index = (uint32_t)index;
+	chunk.level = (uint32_t)level;
+	chunk.elemType = (uint32_t)elemType;
+	chunk.offset = offset;
+	m_chunks.push_back(chunk);
+}
+
+void GridWriterUGB::
+write_data(const void* data, size_t size)
+{
+	m_out.write(static_cast<const char*>(data), size);
+	m_pos += size;
+	m_chunks.back().size += size;
+}
+
+void GridWriterUGB::
+end_chunk(size_t num)
+{
+	m_chunks.back().num = num;
+	UG_COND_THROW(!m_out, "GridWriterUGB: Couldn't write to file '" << m_filename << "'.");
+}
+
+void GridWriterUGB::
+check_grid_index(size_t refGridIndex) const
+{
+	UG_COND_THROW(!m_out.is_open(), "GridWriterUGB: no file opened.");
+	UG_COND_THROW(refGridIndex >= m_entries.size(),
+				  "GridWriterUGB: Invalid refGridIndex: " << refGridIndex
+				  << ", but only " << m_entries.size() << " grids available.");
+}
+
+template <class TElem>
+void GridWriterUGB::
+collect_block(GridEntry& entry, UGBElementType type, size_t level,
+			  vector<typename TElem::grid_base_object*>& elemsInOut)
+{
+	typedef typename geometry_traits<TElem>::iterator iter_t;
+	Grid& grid = *entry.grid;
+	iter_t iter = entry.mg ? entry.mg->begin<TElem>(level) : grid.begin<TElem>();
+	iter_t iterEnd = entry.mg ? entry.mg->end<TElem>(level) : grid.end<TElem>();
+
+	Grid::AttachmentAccessor<typename TElem::grid_base_object, AInt> aaInd(grid, m_aInt);
+	const size_t first = elemsInOut.size();
+	for(; iter != iterEnd; ++iter){
+		aaInd[*iter] = (int)elemsInOut.size();
+		elemsInOut.push_back(*iter);
+	}
+
+	if(elemsInOut.size() > first)
+		entry.blocks.push_back(Block(type, level, first, elemsInOut.size() - first));
+}
+
+void GridWriterUGB::
+init_grid_entry(GridEntry& entry)
+{
+	Grid& grid = *entry.grid;
+	grid.attach_to_vertices(m_aInt);
+	grid.attach_to_edges(m_aInt);
+	grid.attach_to_faces(m_aInt);
+	grid.attach_to_volumes(m_aInt);
+	entry.aaIndVRT.access(grid, m_aInt);
+	entry.aaIndEDGE.access(grid, m_aInt);
+	entry.aaIndFACE.access(grid, m_aInt);
+	entry.aaIndVOL.access(grid, m_aInt);
+
+	entry.vertices.reserve(grid.num<Vertex>());
+	entry.edges.reserve(grid.num<Edge>());
+	entry.faces.reserve(grid.num<Face>());
+	entry.volumes.reserve(grid.num<Volume>());
+
+	if(entry.mg)
+		entry.numLevels = max<size_t>(1, entry.mg->num_levels());
+
+	for(size_t lvl = 0; lvl < entry.numLevels; ++lvl){
+		collect_block<RegularVertex>(entry, UGB_REGULAR_VERTEX, lvl, entry.vertices);
+		collect_block<ConstrainedVertex>(entry, UGB_CONSTRAINED_VERTEX, lvl, entry.vertices);
+		collect_block<RegularEdge>(entry, UGB_REGULAR_EDGE, lvl, entry.edges);
+		collect_block<ConstrainingEdge>(entry, UGB_CONSTRAINING_EDGE, lvl, entry.edges);
+		collect_block<ConstrainedEdge>(entry, UGB_CONSTRAINED_EDGE, lvl, entry.edges);
+		collect_block<Triangle>(entry, UGB_TRIANGLE, lvl, entry.faces);
+		collect_block<ConstrainingTriangle>(entry, UGB_CONSTRAINING_TRIANGLE, lvl, entry.faces);
+		collect_block<ConstrainedTriangle>(entry, UGB_CONSTRAINED_TRIANGLE, lvl, entry.faces);
+		collect_block<Quadrilateral>(entry, UGB_QUADRILATERAL, lvl, entry.faces);
+		collect_block<ConstrainingQuadrilateral>(entry, UGB_CONSTRAINING_QUADRILATERAL, lvl, entry.faces);
+		collect_block<ConstrainedQuadrilateral>(entry, UGB_CONSTRAINED_QUADRILATERAL, lvl, entry.faces);
+		collect_block<Tetrahedron>(entry, UGB_TETRAHEDRON, lvl, entry.volumes);
+		collect_block<Hexahedron>(entry, UGB_HEXAHEDRON, lvl, entry.volumes);
+		collect_block<Prism>(entry, UGB_PRISM, lvl, entry.volumes);
+		collect_block<Pyramid>(entry, UGB_PYRAMID, lvl, entry.volumes);
+		collect_block<Octahedron>(entry, UGB_OCTAHEDRON, lvl, entry.volumes);
+	}
+}
+
+GridObject* GridWriterUGB::
+element(const GridEntry& entry, const Block& block, size_t i) const
+{
+	switch(UGBBaseObjectId(block.type)){
+		case VERTEX:	return entry.vertices[block.first + i];
+		case EDGE:		return entry.edges[block.first + i];
+		case FACE:		return entry.faces[block.first + i];
+		default:		return entry.volumes[block.first + i];
+	}
+}
+
+int GridWriterUGB::
+index_of(const GridEntry& entry, GridObject* obj) const
+{
+	if(!obj)
+		return -1;
+	switch(obj->base_object_id()){
+		case VERTEX:	return entry.aaIndVRT[static_cast<Vertex*>(obj)];
+		case EDGE:		return entry.aaIndEDGE[static_cast<Edge*>(obj)];
+		case FACE:		return entry.aaIndFACE[static_cast<Face*>(obj)];
+		case VOLUME:	return entry.aaIndVOL[static_cast<Volume*>(obj)];
+		default:		return -1;
+	}
+}
+
+void GridWriterUGB::
+write_elements(const GridEntry& entry, size_t gridIndex, const Block& block)
+{
+	const size_t bufSize = 1 << 16;
+	vector<int32_t> buf;
+	buf.reserve(bufSize + 8);
+
+	begin_chunk(UGB_ELEMENTS, gridIndex, 0, block.level, block.type);
+	for(size_t i = 0; i < block.num; ++i){
+		IVertexGroup* vg;
+		switch(UGBBaseObjectId(block.type)){
+			case EDGE:	vg = entry.edges[block.first + i]; break;
+			case FACE:	vg = entry.faces[block.first + i]; break;
+			default:	vg = entry.volumes[block.first + i]; break;
+		}
+
+		Vertex* const* vrts = vg->vertices();
+		for(size_t j = 0; j < vg->num_vertices(); ++j)
+			buf.push_back(entry.aaIndVRT[vrts[j]]);
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(block.num);
+}
+
+void GridWriterUGB::
+write_parents(const GridEntry& entry, size_t gridIndex, const Block& block)
+{
+	const size_t bufSize = 1 << 16;
+	vector<UGBParent> buf;
+	buf.reserve(bufSize);
+
+	begin_chunk(UGB_PARENTS, gridIndex, 0, block.level, block.type);
+	for(size_t i = 0; i < block.num; ++i){
+		GridObject* p = entry.mg->get_parent(element(entry, block, i));
+		UGBParent parent;
+		parent.baseObjectId = p ? p->base_object_id() : -1;
+		parent.index = index_of(entry, p);
+		buf.push_back(parent);
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(block.num);
+}
+
+void GridWriterUGB::
+write_constraints(const GridEntry& entry, size_t gridIndex, const Block& block)
+{
+	const size_t bufSize = 1 << 16;
+	vector<UGBConstraint> buf;
+	buf.reserve(bufSize);
+
+	begin_chunk(UGB_CONSTRAINTS, gridIndex, 0, block.level, block.type);
+	for(size_t i = 0; i < block.num; ++i){
+		UGBConstraint c;
+		c.localCoord[0] = c.localCoord[1] = 0;
+		GridObject* co;
+		switch(block.type){
+			case UGB_CONSTRAINED_VERTEX:{
+				ConstrainedVertex* v = static_cast<ConstrainedVertex*>(entry.vertices[block.first + i]);
+				co = v->get_constraining_object();
+				c.baseObjectId = v->get_parent_base_object_id();
+				c.localCoord[0] = v->get_local_coordinate_1();
+				c.localCoord[1] = v->get_local_coordinate_2();
+			}break;
+			case UGB_CONSTRAINED_EDGE:{
+				ConstrainedEdge* e = static_cast<ConstrainedEdge*>(entry.edges[block.first + i]);
+				co = e->get_constraining_object();
+				c.baseObjectId = e->get_parent_base_object_id();
+			}break;
+			default:{
+				ConstrainedFace* f = static_cast<ConstrainedFace*>(entry.faces[block.first + i]);
+				co = f->get_constraining_object();
+				c.baseObjectId = f->get_parent_base_object_id();
+			}break;
+		}
+		c.index = index_of(entry, co);
+		buf.push_back(c);
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(block.num);
+}
+
+template <class TElem>
+void GridWriterUGB::
+write_subset_indices(const ISubsetHandler& sh, const vector<TElem*>& elems,
+					 size_t gridIndex, size_t shIndex)
+{
+	const size_t bufSize = 1 << 16;
+	vector<int32_t> buf;
+	buf.reserve(bufSize);
+
+	begin_chunk(UGB_SUBSET_INDICES, gridIndex, shIndex, 0, TElem::BASE_OBJECT_ID);
+	for(size_t i = 0; i < elems.size(); ++i){
+		buf.push_back(sh.get_subset_index(elems[i]));
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(elems.size());
+}
+
+template <class TElem>
+void GridWriterUGB::
+write_selection(const ISelector& sel, const vector<TElem*>& elems,
+				size_t gridIndex, size_t selIndex)
+{
+	const size_t bufSize = 1 << 16;
+	vector<byte> buf;
+	buf.reserve(bufSize);
+
+	begin_chunk(UGB_SELECTION, gridIndex, selIndex, 0, TElem::BASE_OBJECT_ID);
+	for(size_t i = 0; i < elems.size(); ++i){
+		buf.push_back(sel.get_selection_status(elems[i]));
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(elems.size());
+}
+
+template <class TElem>
+void GridWriterUGB::
+write_global_ids(Grid& grid, AGeomObjID& aID, const vector<TElem*>& elems,
+				 size_t gridIndex)
+{
+	if(!grid.has_attachment<TElem>(aID))
+		return;
+
+	const size_t bufSize = 1 << 16;
+	vector<UGBGlobalID> buf;
+	buf.reserve(bufSize);
+	Grid::AttachmentAccessor<TElem, AGeomObjID> aaID(grid, aID);
+
+	begin_chunk(UGB_GLOBAL_IDS, gridIndex, 0, 0, TElem::BASE_OBJECT_ID);
+	for(size_t i = 0; i < elems.size(); ++i){
+		const GeomObjID& id = aaID[elems[i]];
+		UGBGlobalID gid;
+		gid.procRank = id.first;
+		gid.reserved = 0;
+		gid.localID = id.second;
+		buf.push_back(gid);
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(elems.size());
+}
+
+template <class TElem>
+void GridWriterUGB::
+write_interfaces(const GridEntry& entry, GridLayoutMap& glm, size_t gridIndex)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Map		LayoutMap;
+	typedef typename GridLayoutMap::Types<TElem>::Layout	Layout;
+	typedef typename GridLayoutMap::Types<TElem>::Interface	Interface;
+
+	vector<UGBInterfaceEntry> buf;
+	for(typename LayoutMap::iterator iLayout = glm.layouts_begin<TElem>();
+		iLayout != glm.layouts_end<TElem>(); ++iLayout)
+	{
+		Layout& layout = iLayout->second;
+		for(size_t lvl = 0; lvl < layout.num_levels(); ++lvl){
+			for(typename Layout::iterator iIntfc = layout.begin(lvl);
+				iIntfc != layout.end(lvl); ++iIntfc)
+			{
+				Interface& intfc = layout.interface(iIntfc);
+				for(typename Interface::iterator iter = intfc.begin();
+					iter != intfc.end(); ++iter)
+				{
+					UGBInterfaceEntry e;
+					e.index = index_of(entry, intfc.get_element(iter));
+					e.proc = layout.proc_id(iIntfc);
+					e.interfaceType = iLayout->first;
+					e.level = (int32_t)lvl;
+					buf.push_back(e);
+				}
+			}
+		}
+	}
+
+	if(buf.empty())
+		return;
+
+	begin_chunk(UGB_INTERFACES, gridIndex, 0, 0, TElem::BASE_OBJECT_ID);
+	const size_t num = buf.size();
+	write_data(buf);
+	end_chunk(num);
+}
+
+void GridWriterUGB::
+add_global_ids(AGeomObjID& aID, size_t refGridIndex)
+{
+	check_grid_index(refGridIndex);
+	GridEntry& entry = m_entries[refGridIndex];
+	write_global_ids(*entry.grid, aID, entry.vertices, refGridIndex);
+	write_global_ids(*entry.grid, aID, entry.edges, refGridIndex);
+	write_global_ids(*entry.grid, aID, entry.faces, refGridIndex);
+	write_global_ids(*entry.grid, aID, entry.volumes, refGridIndex);
+}
+
+void GridWriterUGB::
+add_layouts(GridLayoutMap& glm, size_t refGridIndex)
+{
+	check_grid_index(refGridIndex);
+	GridEntry& entry = m_entries[refGridIndex];
+	write_interfaces<Vertex>(entry, glm, refGridIndex);
+	write_interfaces<Edge>(entry, glm, refGridIndex);
+	write_interfaces<Face>(entry, glm, refGridIndex);
+	write_interfaces<Volume>(entry, glm, refGridIndex);
+}
+
+void GridWriterUGB::
+add_subset_handler(ISubsetHandler& sh, const char* name, size_t refGridIndex)
+{
+	check_grid_index(refGridIndex);
+	GridEntry& entry = m_entries[refGridIndex];
+	UG_COND_THROW(sh.grid() != entry.grid, "GridWriterUGB::add_subset_handler: "
+				  "The subset handler '" << name << "' doesn't operate on grid " << refGridIndex);
+
+	const size_t shIndex = entry.subsetHandlers.size();
+	entry.subsetHandlers.push_back(&sh);
+
+	stringstream ss;
+	Serialize(ss, string(name));
+	Serialize(ss, sh.num_subsets());
+	for(int i = 0; i < sh.num_subsets(); ++i){
+		const SubsetInfo& si = sh.subset_info(i);
+		Serialize(ss, si.name);
+		for(size_t j = 0; j < 4; ++j)
+			Serialize(ss, (double)si.color[j]);
+		Serialize(ss, si.subsetState);
+	}
+
+	const string blob = ss.str();
+	begin_chunk(UGB_SUBSET_HANDLER, refGridIndex, shIndex);
+	write_data(blob.c_str(), blob.size());
+	end_chunk(sh.num_subsets());
+
+	if(sh.elements_are_supported(SHE_VERTEX))
+		write_subset_indices(sh, entry.vertices, refGridIndex, shIndex);
+	if(sh.elements_are_supported(SHE_EDGE))
+		write_subset_indices(sh, entry.edges, refGridIndex, shIndex);
+	if(sh.elements_are_supported(SHE_FACE))
+		write_subset_indices(sh, entry.faces, refGridIndex, shIndex);
+	if(sh.elements_are_supported(SHE_VOLUME))
+		write_subset_indices(sh, entry.volumes, refGridIndex, shIndex);
+}
+
+void GridWriterUGB::
+add_selector(ISelector& sel, const char* name, size_t refGridIndex)
+{
+	check_grid_index(refGridIndex);
+	GridEntry& entry = m_entries[refGridIndex];
+	UG_COND_THROW(sel.grid() != entry.grid, "GridWriterUGB::add_selector: "
+				  "The selector '" << name << "' doesn't operate on grid " << refGridIndex);
+
+	const size_t selIndex = entry.numSelectors++;
+
+	begin_chunk(UGB_SELECTOR, refGridIndex, selIndex);
+	write_data(name, strlen(name));
+	end_chunk(1);
+
+	if(sel.elements_are_supported(SHE_VERTEX))
+		write_selection(sel, entry.vertices, refGridIndex, selIndex);
+	if(sel.elements_are_supported(SHE_EDGE))
+		write_selection(sel, entry.edges, refGridIndex, selIndex);
+	if(sel.elements_are_supported(SHE_FACE))
+		write_selection(sel, entry.faces, refGridIndex, selIndex);
+	if(sel.elements_are_supported(SHE_VOLUME))
+		write_selection(sel, entry.volumes, refGridIndex, selIndex);
+}
+
+void GridWriterUGB::
+add_projection_handler(ProjectionHandler& ph, const char* name, size_t refGridIndex)
+{
+	check_grid_index(refGridIndex);
+	GridEntry& entry = m_entries[refGridIndex];
+
+//	find subset handler index in subset handler array
+	const vector<const ISubsetHandler*>& vSH = entry.subsetHandlers;
+	size_t shIndex = 0;
+	for(; shIndex < vSH.size(); ++shIndex)
+		if(vSH[shIndex] == ph.subset_handler())
+			break;
+
+	UG_COND_THROW(shIndex == vSH.size(), "ERROR in 'GridWriterUGB::add_projection_handler': "
+		"No matching SubsetHandler could be found.\n"
+		"Please make sure to add the associated SubsetHandler before adding a ProjectionHandler");
+
+	stringstream projs;
+	size_t numProjs = 0;
+	if(ph.default_projector().valid()){
+		WriteUGBProjector(projs, *ph.default_projector(), true, 0);
+		++numProjs;
+	}
+
+	for(int i = -1; i < (int)ph.num_projectors(); ++i){
+		if(!ph.projector(i).valid())
+			continue;
+		WriteUGBProjector(projs, *ph.projector(i), false, i);
+		++numProjs;
+	}
+
+	stringstream ss;
+	Serialize(ss, string(name));
+	Serialize(ss, shIndex);
+	Serialize(ss, numProjs);
+	const string blob = ss.str() + projs.str();
+
+	begin_chunk(UGB_PROJECTION_HANDLER, refGridIndex, entry.numProjectionHandlers++);
+	write_data(blob.c_str(), blob.size());
+	end_chunk(numProjs);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+//	GridReaderUGB
+GridReaderUGB::GridReaderUGB()
+{
+}
+
+GridReaderUGB::GridReaderUGB(const char* filename)
+{
+	open(filename);
+}
+
+GridReaderUGB::~GridReaderUGB()
+{
+}
+
+void GridReaderUGB::open(const char* filename)
+{
+	PROFILE_FUNC_GROUP("grid");
+	close();
+	m_file.open(filename);
+	m_filename = filename;
+
+	UG_COND_THROW(m_file.size() < sizeof(UGBFileHeader),
+				  "'" << filename << "' is not a ugb file.");
+
+	const UGBFileHeader& h = *reinterpret_cast<const UGBFileHeader*>(m_file.data());
+	UG_COND_THROW(strncmp(h.magic, UGBMagic, sizeof(h.magic)) != 0,
+				  "'" << filename << "' is not a ugb file.");
+	UG_COND_THROW(h.byteOrder != UGBByteOrder,
+				  "ugb file '" << filename << "' was written with a different byte order.");
+	UG_COND_THROW(h.version > UGBFileVersion,
+				  "ugb file '" << filename << "' has version " << h.version
+				  << ", but only versions up to " << UGBFileVersion << " are supported.");
+	UG_COND_THROW(h.chunkTableOffset > m_file.size()
+				  || h.numChunks > (m_file.size() - h.chunkTableOffset) / sizeof(UGBChunk),
+				  "ugb file '" << filename << "' is truncated or corrupt.");
+
+	const UGBChunk* chunks = reinterpret_cast<const UGBChunk*>
+									(m_file.data() + h.chunkTableOffset);
+
+	for(size_t i = 0; i < h.numChunks; ++i){
+		const UGBChunk& c = chunks[i];
+		data(c);
+		if(c.type == UGB_GRID){
+			UG_COND_THROW(c.grid != m_entries.size(),
+						  "Unexpected grid chunk in ugb file '" << filename << "'.");
+			m_entries.push_back(GridEntry(&c));
+			continue;
+		}
+
+		GridEntry& entry = grid_entry(c.grid);
+		switch(c.type){
+			case UGB_ELEMENTS:
+				UG_COND_THROW(c.elemType >= UGB_NUM_ELEMENT_TYPES,
+							  "Unknown element type in ugb file '" << filename << "'.");
+				entry.blocks.push_back(ElementBlock(&c));
+				break;
+
+			case UGB_PARENTS:
+			case UGB_CONSTRAINTS:{
+				UG_COND_THROW(entry.blocks.empty()
+							  || entry.blocks.back().elems->elemType != c.elemType
+							  || entry.blocks.back().elems->num != c.num,
+							  "Unexpected parent or constraint chunk in ugb file '"
+							  << filename << "'.");
+				if(c.type == UGB_PARENTS)
+					entry.blocks.back().parents = &c;
+				else
+					entry.blocks.back().constraints = &c;
+			}break;
+
+			case UGB_SUBSET_HANDLER:
+				UG_COND_THROW(c.index != entry.subsetHandlers.size(),
+							  "Unexpected subset handler chunk in ugb file '" << filename << "'.");
+				entry.subsetHandlers.push_back(&c);
+				entry.subsetIndices.push_back(vector<const UGBChunk*>(4, NULL));
+				break;
+
+			case UGB_SUBSET_INDICES:
+				UG_COND_THROW(c.index >= entry.subsetIndices.size() || c.elemType > VOLUME,
+							  "Unexpected subset index chunk in ugb file '" << filename << "'.");
+				entry.subsetIndices[c.index][c.elemType] = &c;
+				break;
+
+			case UGB_SELECTOR:
+				UG_COND_THROW(c.index != entry.selectors.size(),
+							  "Unexpected selector chunk in ugb file '" << filename << "'.");
+				entry.selectors.push_back(&c);
+				entry.selections.push_back(vector<const UGBChunk*>(4, NULL));
+				break;
+
+			case UGB_SELECTION:
+				UG_COND_THROW(c.index >= entry.selections.size() || c.elemType > VOLUME,
+							  "Unexpected selection chunk in ugb file '" << filename << "'.");
+				entry.selections[c.index][c.elemType] = &c;
+				break;
+
+			case UGB_PROJECTION_HANDLER:
+				entry.projectionHandlers.push_back(&c);
+				break;
+
+			case UGB_GLOBAL_IDS:
+			case UGB_INTERFACES:
+				UG_COND_THROW(c.elemType > VOLUME, "Unexpected global id or interface chunk"
+							  " in ugb file '" << filename << "'.");
+				if(c.type == UGB_GLOBAL_IDS)
+					entry.globalIDs[c.elemType] = &c;
+				else
+					entry.interfaces[c.elemType] = &c;
+				break;
+
+		//	chunks of unknown types are ignored
+			default:
+				break;
+		}
+	}
+}
+
+void GridReaderUGB::close()
+{
+	m_entries.clear();
+	m_file.close();
+	m_filename.clear();
+}
+
+const char* GridReaderUGB::data(const UGBChunk& chunk) const
+{
+	if(chunk.size == 0)
+		return NULL;
+	UG_COND_THROW(chunk.offset > m_file.size() || chunk.size > m_file.size() - chunk.offset,
+				  "ugb file '" << m_filename << "' is truncated or corrupt.");
+	return m_file.data() + chunk.offset;
+}
+
+const GridReaderUGB::GridEntry& GridReaderUGB::
+grid_entry(size_t refGridIndex) const
+{
+	UG_COND_THROW(refGridIndex >= m_entries.size(), "Bad refGridIndex: " << refGridIndex
+				  << ". The ugb file '" << m_filename << "' only contains "
+				  << m_entries.size() << " grids.");
+	return m_entries[refGridIndex];
+}
+
+GridReaderUGB::GridEntry& GridReaderUGB::
+grid_entry(size_t refGridIndex)
+{
+	UG_COND_THROW(refGridIndex >= m_entries.size(), "Bad refGridIndex: " << refGridIndex
+				  << ". The ugb file '" << m_filename << "' only contains "
+				  << m_entries.size() << " grids.");
+	return m_entries[refGridIndex];
+}
+
+string GridReaderUGB::get_grid_name(size_t index) const
+{
+	const UGBChunk& c = *grid_entry(index).chunk;
+	const char* name = data(c);
+	return name ? string(name, c.size) : string();
+}
+
+size_t GridReaderUGB::num_coordinates(size_t index) const
+{
+	return grid_entry(index).chunk->index;
+}
+
+size_t GridReaderUGB::num_levels(size_t index) const
+{
+	return grid_entry(index).chunk->level;
+}
+
+void GridReaderUGB::reserve(Grid& grid, GridEntry& entry)
+{
+	size_t num[4] = {0, 0, 0, 0};
+	for(size_t i = 0; i < entry.blocks.size(); ++i)
+		num[UGBBaseObjectId(entry.blocks[i].elems->elemType)] += entry.blocks[i].elems->num;
+
+	grid.reserve<Vertex>(grid.num<Vertex>() + num[VERTEX]);
+	grid.reserve<Edge>(grid.num<Edge>() + num[EDGE]);
+	grid.reserve<Face>(grid.num<Face>() + num[FACE]);
+	grid.reserve<Volume>(grid.num<Volume>() + num[VOLUME]);
+	entry.vertices.reserve(num[VERTEX]);
+	entry.edges.reserve(num[EDGE]);
+	entry.faces.reserve(num[FACE]);
+	entry.volumes.reserve(num[VOLUME]);
+}
+
+GridObject* GridReaderUGB::
+object(const GridEntry& entry, int baseObjectId, int index) const
+{
+	size_t num;
+	switch(baseObjectId){
+		case VERTEX:	num = entry.vertices.size(); break;
+		case EDGE:		num = entry.edges.size(); break;
+		case FACE:		num = entry.faces.size(); break;
+		case VOLUME:	num = entry.volumes.size(); break;
+		default:		num = 0; break;
+	}
+
+	UG_COND_THROW(index < 0 || (size_t)index >= num,
+				  "Bad object reference (" << baseObjectId << ", " << index
+				  << ") in ugb file '" << m_filename << "'.");
+
+	switch(baseObjectId){
+		case VERTEX:	return entry.vertices[index];
+		case EDGE:		return entry.edges[index];
+		case FACE:		return entry.faces[index];
+		default:		return entry.volumes[index];
+	}
+}
+
+const UGBParent* GridReaderUGB::
+parents(MultiGrid* mg, const ElementBlock& block) const
+{
+	if(!mg || !block.parents)
+		return NULL;
+	return data_array<UGBParent>(*block.parents, 1);
+}
+
+GridObject* GridReaderUGB::
+parent(const GridEntry& entry, const UGBParent* parents, size_t i) const
+{
+	if(!parents || parents[i].index < 0)
+		return NULL;
+	return object(entry, parents[i].baseObjectId, parents[i].index);
+}
+
+///	creates a vertex on the given level of mg or with the given parent
+template <class TVrt>
+static Vertex* CreateUGBVertex(Grid& grid, MultiGrid* mg, size_t level,
+							   GridObject* parent)
+{
+	if(mg && !parent && level > 0)
+		return *mg->create<TVrt>(level);
+	return *grid.create<TVrt>(parent);
+}
+
+void GridReaderUGB::
+create_vertices(Grid& grid, MultiGrid* mg, GridEntry& entry, ElementBlock& block)
+{
+	const size_t level = block.elems->level;
+	const UGBParent* pars = parents(mg, block);
+	block.first = entry.vertices.size();
+
+	for(size_t i = 0; i < block.elems->num; ++i){
+		GridObject* p = parent(entry, pars, i);
+		if(block.elems->elemType == UGB_REGULAR_VERTEX)
+			entry.vertices.push_back(CreateUGBVertex<RegularVertex>(grid, mg, level, p));
+		else
+			entry.vertices.push_back(CreateUGBVertex<ConstrainedVertex>(grid, mg, level, p));
+	}
+}
+
+static inline void InitUGBDescriptor(EdgeDescriptor& d, Vertex** v)
+{d = EdgeDescriptor(v[0], v[1]);}
+
+static inline void InitUGBDescriptor(TriangleDescriptor& d, Vertex** v)
+{d = TriangleDescriptor(v[0], v[1], v[2]);}
+
+static inline void InitUGBDescriptor(QuadrilateralDescriptor& d, Vertex** v)
+{d = QuadrilateralDescriptor(v[0], v[1], v[2], v[3]);}
+
+static inline void InitUGBDescriptor(TetrahedronDescriptor& d, Vertex** v)
+{d = TetrahedronDescriptor(v[0], v[1], v[2], v[3]);}
+
+static inline void InitUGBDescriptor(HexahedronDescriptor& d, Vertex** v)
+{d = HexahedronDescriptor(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);}
+
+static inline void InitUGBDescriptor(PrismDescriptor& d, Vertex** v)
+{d = PrismDescriptor(v[0], v[1], v[2], v[3], v[4], v[5]);}
+
+static inline void InitUGBDescriptor(PyramidDescriptor& d, Vertex** v)
+{d = PyramidDescriptor(v[0], v[1], v[2], v[3], v[4]);}
+
+static inline void InitUGBDescriptor(OctahedronDescriptor& d, Vertex** v)
+{d = OctahedronDescriptor(v[0], v[1], v[2], v[3], v[4], v[5]);}
+
+template <class TElem>
+void GridReaderUGB::
+create_element_block(Grid& grid, MultiGrid* mg, GridEntry& entry,
+					 ElementBlock& block, size_t numCorners,
+					 vector<typename TElem::grid_base_object*>& elemsInOut)
+{
+	const size_t level = block.elems->level;
+	const size_t numVrts = entry.vertices.size();
+	const int32_t* inds = data_array<int32_t>(*block.elems, numCorners);
+	const UGBParent* pars = parents(mg, block);
+	block.first = elemsInOut.size();
+
+	typename geometry_traits<TElem>::Descriptor desc;
+	Vertex* vrts[8];
+	for(size_t i = 0; i < block.elems->num; ++i){
+		for(size_t j = 0; j < numCorners; ++j){
+			int32_t ind = inds[i * numCorners + j];
+			UG_COND_THROW(ind < 0 || (size_t)ind >= numVrts,
+						  "Bad vertex index " << ind << " in ugb file '" << m_filename << "'.");
+			vrts[j] = entry.vertices[ind];
+		}
+		InitUGBDescriptor(desc, vrts);
+
+		GridObject* p = parent(entry, pars, i);
+		if(mg && !p && level > 0)
+			elemsInOut.push_back(*mg->create<TElem>(desc, level));
+		else
+			elemsInOut.push_back(*grid.create<TElem>(desc, p));
+	}
+}
+
+void GridReaderUGB::
+create_elements(Grid& grid, MultiGrid* mg, GridEntry& entry, ElementBlock& block)
+{
+	switch(block.elems->elemType){
+		case UGB_REGULAR_EDGE:
+			create_element_block<RegularEdge>(grid, mg, entry, block, 2, entry.edges); break;
+		case UGB_CONSTRAINING_EDGE:
+			create_element_block<ConstrainingEdge>(grid, mg, entry, block, 2, entry.edges); break;
+		case UGB_CONSTRAINED_EDGE:
+			create_element_block<ConstrainedEdge>(grid, mg, entry, block, 2, entry.edges); break;
+		case UGB_TRIANGLE:
+			create_element_block<Triangle>(grid, mg, entry, block, 3, entry.faces); break;
+		case UGB_CONSTRAINING_TRIANGLE:
+			create_element_block<ConstrainingTriangle>(grid, mg, entry, block, 3, entry.faces); break;
+		case UGB_CONSTRAINED_TRIANGLE:
+			create_element_block<ConstrainedTriangle>(grid, mg, entry, block, 3, entry.faces); break;
+		case UGB_QUADRILATERAL:
+			create_element_block<Quadrilateral>(grid, mg, entry, block, 4, entry.faces); break;
+		case UGB_CONSTRAINING_QUADRILATERAL:
+			create_element_block<ConstrainingQuadrilateral>(grid, mg, entry, block, 4, entry.faces); break;
+		case UGB_CONSTRAINED_QUADRILATERAL:
+			create_element_block<ConstrainedQuadrilateral>(grid, mg, entry, block, 4, entry.faces); break;
+		case UGB_TETRAHEDRON:
+			create_element_block<Tetrahedron>(grid, mg, entry, block, 4, entry.volumes); break;
+		case UGB_HEXAHEDRON:
+			create_element_block<Hexahedron>(grid, mg, entry, block, 8, entry.volumes); break;
+		case UGB_PRISM:
+			create_element_block<Prism>(grid, mg, entry, block, 6, entry.volumes); break;
+		case UGB_PYRAMID:
+			create_element_block<Pyramid>(grid, mg, entry, block, 5, entry.volumes); break;
+		case UGB_OCTAHEDRON:
+			create_element_block<Octahedron>(grid, mg, entry, block, 6, entry.volumes); break;
+		default:
+			UG_THROW("Unexpected element type " << block.elems->elemType
+					 << " in ugb file '" << m_filename << "'.");
+	}
+}
+
+void GridReaderUGB::
+resolve_constraints(GridEntry& entry)
+{
+	for(size_t i = 0; i < entry.blocks.size(); ++i){
+		const ElementBlock& block = entry.blocks[i];
+		if(!block.constraints)
+			continue;
+
+		const UGBConstraint* cons = data_array<UGBConstraint>(*block.constraints, 1);
+		for(size_t j = 0; j < block.elems->num; ++j){
+			const UGBConstraint& c = cons[j];
+			GridObject* co = NULL;
+			if(c.index >= 0)
+				co = object(entry, c.baseObjectId, c.index);
+
+			switch(block.elems->elemType){
+				case UGB_CONSTRAINED_VERTEX:{
+					ConstrainedVertex* v = static_cast<ConstrainedVertex*>
+												(entry.vertices[block.first + j]);
+					v->set_local_coordinates(c.localCoord[0], c.localCoord[1]);
+					if(ConstrainingEdge* e = dynamic_cast<ConstrainingEdge*>(co)){
+						v->set_constraining_object(e);
+						e->add_constrained_object(v);
+					}
+					else if(ConstrainingFace* f = dynamic_cast<ConstrainingFace*>(co)){
+						v->set_constraining_object(f);
+						f->add_constrained_object(v);
+					}
+					else if(c.baseObjectId >= 0)
+						v->set_parent_base_object_id(c.baseObjectId);
+				}break;
+
+				case UGB_CONSTRAINED_EDGE:{
+					ConstrainedEdge* ce = static_cast<ConstrainedEdge*>
+												(entry.edges[block.first + j]);
+					if(ConstrainingEdge* e = dynamic_cast<ConstrainingEdge*>(co)){
+						ce->set_constraining_object(e);
+						e->add_constrained_object(ce);
+					}
+					else if(ConstrainingFace* f = dynamic_cast<ConstrainingFace*>(co)){
+						ce->set_constraining_object(f);
+						f->add_constrained_object(ce);
+					}
+					else if(c.baseObjectId >= 0)
+						ce->set_parent_base_object_id(c.baseObjectId);
+				}break;
+
+				default:{
+					ConstrainedFace* cf = static_cast<ConstrainedFace*>
+												(entry.faces[block.first + j]);
+					if(ConstrainingFace* f = dynamic_cast<ConstrainingFace*>(co)){
+						cf->set_constraining_object(f);
+						f->add_constrained_object(cf);
+					}
+					else if(c.baseObjectId >= 0)
+						cf->set_parent_base_object_id(c.baseObjectId);
+				}break;
+			}
+
+			if(co && !dynamic_cast<ConstrainingEdge*>(co) && !dynamic_cast<ConstrainingFace*>(co)){
+				UG_LOG("WARNING in GridReaderUGB: Type-ID / type mismatch. Ignoring constraining object "
+						<< c.index << ".\n");
+			}
+		}
+	}
+}
+
+size_t GridReaderUGB::
+num_subset_handlers(size_t refGridIndex) const
+{
+	return grid_entry(refGridIndex).subsetHandlers.size();
+}
+
+string GridReaderUGB::
+get_subset_handler_name(size_t refGridIndex, size_t subsetHandlerIndex) const
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(subsetHandlerIndex >= entry.subsetHandlers.size(),
+				  "Bad subsetHandlerIndex: " << subsetHandlerIndex);
+
+	const UGBChunk& c = *entry.subsetHandlers[subsetHandlerIndex];
+	stringstream in(string(data(c), c.size), ios_base::in);
+	string name;
+	Deserialize(in, name);
+	return name;
+}
+
+void GridReaderUGB::
+subset_infos(ISubsetHandler& shOut, size_t subsetHandlerIndex, size_t refGridIndex)
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(subsetHandlerIndex >= entry.subsetHandlers.size(),
+				  "Bad subsetHandlerIndex: " << subsetHandlerIndex);
+
+	const UGBChunk& c = *entry.subsetHandlers[subsetHandlerIndex];
+	stringstream in(string(data(c), c.size), ios_base::in);
+	string name;
+	int numSubsets;
+	Deserialize(in, name);
+	Deserialize(in, numSubsets);
+	for(int i = 0; i < numSubsets; ++i){
+	//	retrieve an initial subset-info from shOut, so that initialised values are kept.
+		SubsetInfo si = shOut.subset_info(i);
+		Deserialize(in, si.name);
+		for(size_t j = 0; j < 4; ++j){
+			double val;
+			Deserialize(in, val);
+			si.color[j] = val;
+		}
+		Deserialize(in, si.subsetState);
+		shOut.set_subset_info(i, si);
+	}
+	UG_COND_THROW(!in, "Invalid subset handler in ugb file '" << m_filename << "'.");
+}
+
+bool GridReaderUGB::
+subset_handler(ISubsetHandler& shOut, size_t subsetHandlerIndex, size_t refGridIndex)
+{
+	subset_infos(shOut, subsetHandlerIndex, refGridIndex);
+
+//	subset indices
+	GridEntry& entry = grid_entry(refGridIndex);
+	const vector<const UGBChunk*>& inds = entry.subsetIndices[subsetHandlerIndex];
+	const size_t numElems[] = {entry.vertices.size(), entry.edges.size(),
+							   entry.faces.size(), entry.volumes.size()};
+	for(int baseId = VERTEX; baseId <= VOLUME; ++baseId){
+		if(!inds[baseId] || !shOut.elements_are_supported(UGBElementFlags[baseId]))
+			continue;
+
+		UG_COND_THROW(inds[baseId]->num != numElems[baseId],
+					  "Subset indices don't match the grid in ugb file '" << m_filename
+					  << "'. Make sure to create the grid first.");
+		const int32_t* si = data_array<int32_t>(*inds[baseId], 1);
+		for(size_t i = 0; i < numElems[baseId]; ++i){
+			if(si[i] < 0)
+				continue;
+			switch(baseId){
+				case VERTEX:	shOut.assign_subset(entry.vertices[i], si[i]); break;
+				case EDGE:		shOut.assign_subset(entry.edges[i], si[i]); break;
+				case FACE:		shOut.assign_subset(entry.faces[i], si[i]); break;
+				default:		shOut.assign_subset(entry.volumes[i], si[i]); break;
+			}
+		}
+	}
+
+	return true;
+}
+
+size_t GridReaderUGB::
+num_selectors(size_t refGridIndex) const
+{
+	return grid_entry(refGridIndex).selectors.size();
+}
+
+string GridReaderUGB::
+get_selector_name(size_t refGridIndex, size_t selectorIndex) const
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(selectorIndex >= entry.selectors.size(),
+				  "Bad selectorIndex: " << selectorIndex);
+	const UGBChunk& c = *entry.selectors[selectorIndex];
+	const char* name = data(c);
+	return name ? string(name, c.size) : string();
+}
+
+bool GridReaderUGB::
+selector(ISelector& selOut, size_t selectorIndex, size_t refGridIndex)
+{
+	GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(selectorIndex >= entry.selectors.size(),
+				  "Bad selectorIndex: " << selectorIndex);
+
+	const vector<const UGBChunk*>& states = entry.selections[selectorIndex];
+	const size_t numElems[] = {entry.vertices.size(), entry.edges.size(),
+							   entry.faces.size(), entry.volumes.size()};
+	for(int baseId = VERTEX; baseId <= VOLUME; ++baseId){
+		if(!states[baseId] || !selOut.elements_are_supported(UGBElementFlags[baseId]))
+			continue;
+
+		UG_COND_THROW(states[baseId]->num != numElems[baseId],
+					  "Selection doesn't match the grid in ugb file '" << m_filename
+					  << "'. Make sure to create the grid first.");
+		const byte* s = data_array<byte>(*states[baseId], 1);
+		for(size_t i = 0; i < numElems[baseId]; ++i){
+			if(s[i] == 0)
+				continue;
+			switch(baseId){
+				case VERTEX:	selOut.select(entry.vertices[i], s[i]); break;
+				case EDGE:		selOut.select(entry.edges[i], s[i]); break;
+				case FACE:		selOut.select(entry.faces[i], s[i]); break;
+				default:		selOut.select(entry.volumes[i], s[i]); break;
+			}
+		}
+	}
+
+	return true;
+}
+
+size_t GridReaderUGB::
+num_projection_handlers(size_t refGridIndex) const
+{
+	return grid_entry(refGridIndex).projectionHandlers.size();
+}
+
+string GridReaderUGB::
+get_projection_handler_name(size_t refGridIndex, size_t phIndex) const
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(phIndex >= entry.projectionHandlers.size(),
+				  "Bad projection-handler-index: " << phIndex);
+
+	const UGBChunk& c = *entry.projectionHandlers[phIndex];
+	string name;
+	size_t shIndex;
+	ReadUGBProjectionHandler(string(data(c), c.size), name, shIndex, NULL);
+	return name;
+}
+
+size_t GridReaderUGB::
+get_projection_handler_subset_handler_index(size_t phIndex, size_t refGridIndex) const
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(phIndex >= entry.projectionHandlers.size(),
+				  "Bad projection-handler-index: " << phIndex);
+
+	const UGBChunk& c = *entry.projectionHandlers[phIndex];
+	string name;
+	size_t shIndex;
+	ReadUGBProjectionHandler(string(data(c), c.size), name, shIndex, NULL);
+	return shIndex;
+}
+
+bool GridReaderUGB::
+projection_handler(ProjectionHandler& phOut, size_t phIndex, size_t refGridIndex)
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	UG_COND_THROW(phIndex >= entry.projectionHandlers.size(),
+				  "Bad projection-handler-index: " << phIndex);
+
+	const UGBChunk& c = *entry.projectionHandlers[phIndex];
+	string name;
+	size_t shIndex;
+	vector<UGBProjectorEntry> projs;
+	ReadUGBProjectionHandler(string(data(c), c.size), name, shIndex, &projs);
+
+	for(size_t i = 0; i < projs.size(); ++i){
+		SPRefinementProjector proj = ReadUGBProjector(projs[i]);
+		if(!proj.valid())
+			continue;
+		if(projs[i].isDefault)
+			phOut.set_default_projector(proj);
+		else
+			phOut.set_projector(projs[i].subset, proj);
+	}
+
+	return true;
+}
+
+bool GridReaderUGB::
+has_global_ids(size_t refGridIndex) const
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	for(int baseId = VERTEX; baseId <= VOLUME; ++baseId)
+		if(entry.globalIDs[baseId])
+			return true;
+	return false;
+}
+
+bool GridReaderUGB::
+global_ids(Grid& grid, AGeomObjID& aID, size_t refGridIndex)
+{
+	GridEntry& entry = grid_entry(refGridIndex);
+	const size_t numElems[] = {entry.vertices.size(), entry.edges.size(),
+							   entry.faces.size(), entry.volumes.size()};
+	bool gotOne = false;
+	for(int baseId = VERTEX; baseId <= VOLUME; ++baseId){
+		const UGBChunk* c = entry.globalIDs[baseId];
+		if(!c)
+			continue;
+
+		UG_COND_THROW(c->num != numElems[baseId],
+					  "Global ids don't match the grid in ugb file '" << m_filename
+					  << "'. Make sure to create the grid first.");
+		const UGBGlobalID* ids = data_array<UGBGlobalID>(*c, 1);
+		gotOne = true;
+		switch(baseId){
+			case VERTEX:{
+				if(!grid.has_vertex_attachment(aID))
+					grid.attach_to_vertices(aID);
+				Grid::VertexAttachmentAccessor<AGeomObjID> aaID(grid, aID);
+				for(size_t i = 0; i < numElems[baseId]; ++i)
+					aaID[entry.vertices[i]] = MakeGeomObjID(ids[i].procRank, ids[i].localID);
+			}break;
+			case EDGE:{
+				if(!grid.has_edge_attachment(aID))
+					grid.attach_to_edges(aID);
+				Grid::EdgeAttachmentAccessor<AGeomObjID> aaID(grid, aID);
+				for(size_t i = 0; i < numElems[baseId]; ++i)
+					aaID[entry.edges[i]] = MakeGeomObjID(ids[i].procRank, ids[i].localID);
+			}break;
+			case FACE:{
+				if(!grid.has_face_attachment(aID))
+					grid.attach_to_faces(aID);
+				Grid::FaceAttachmentAccessor<AGeomObjID> aaID(grid, aID);
+				for(size_t i = 0; i < numElems[baseId]; ++i)
+					aaID[entry.faces[i]] = MakeGeomObjID(ids[i].procRank, ids[i].localID);
+			}break;
+			default:{
+				if(!grid.has_volume_attachment(aID))
+					grid.attach_to_volumes(aID);
+				Grid::VolumeAttachmentAccessor<AGeomObjID> aaID(grid, aID);
+				for(size_t i = 0; i < numElems[baseId]; ++i)
+					aaID[entry.volumes[i]] = MakeGeomObjID(ids[i].procRank, ids[i].localID);
+			}break;
+		}
+	}
+
+	return gotOne;
+}
+
+bool GridReaderUGB::
+has_layouts(size_t refGridIndex) const
+{
+	const GridEntry& entry = grid_entry(refGridIndex);
+	for(int baseId = VERTEX; baseId <= VOLUME; ++baseId)
+		if(entry.interfaces[baseId])
+			return true;
+	return false;
+}
+
+bool GridReaderUGB::
+layouts(GridLayoutMap& glmOut, size_t refGridIndex)
+{
+	GridEntry& entry = grid_entry(refGridIndex);
+	bool gotOne = false;
+	for(int baseId = VERTEX; baseId <= VOLUME; ++baseId){
+		const UGBChunk* c = entry.interfaces[baseId];
+		if(!c)
+			continue;
+
+		const UGBInterfaceEntry* entries = data_array<UGBInterfaceEntry>(*c, 1);
+		gotOne = true;
+		for(size_t i = 0; i < c->num; ++i){
+			const UGBInterfaceEntry& e = entries[i];
+			UG_COND_THROW(e.level < 0 || e.proc < 0,
+						  "Bad interface entry in ugb file '" << m_filename << "'.");
+			GridObject* o = object(entry, baseId, e.index);
+			switch(baseId){
+				case VERTEX:
+					glmOut.get_layout<Vertex>(e.interfaceType).interface(e.proc, e.level)
+						.push_back(static_cast<Vertex*>(o));
+					break;
+				case EDGE:
+					glmOut.get_layout<Edge>(e.interfaceType).interface(e.proc, e.level)
+						.push_back(static_cast<Edge*>(o));
+					break;
+				case FACE:
+					glmOut.get_layout<Face>(e.interfaceType).interface(e.proc, e.level)
+						.push_back(static_cast<Face*>(o));
+					break;
+				default:
+					glmOut.get_layout<Volume>(e.interfaceType).interface(e.proc, e.level)
+						.push_back(static_cast<Volume*>(o));
+					break;
+			}
+		}
+	}
+
+	return gotOne;
+}
+
+}//	end of namespace
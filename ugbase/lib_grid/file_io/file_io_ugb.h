@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGB__
+#define __H__LIB_GRID__FILE_IO_UGB__
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/types.h"
+#include "common/util/mapped_file.h"
+#include "lib_grid/grid/grid.h"
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+#include "lib_grid/tools/selector_interface.h"
+#include "lib_grid/common_attachments.h"
+#include "lib_grid/grid_objects/grid_objects.h"
+#include "lib_grid/refinement/projectors/projection_handler.h"
+#include "lib_grid/parallelization/parallel_grid_layout.h"
+
+namespace ug
+{
+
+/**
+ * \brief Binary grid format (ugb)
+ *
+ * ugb files hold the same information as ugx files: one or more grids with
+ * their vertices and elements, subset handlers, selectors and projection
+ * handlers. In addition, the hierarchy of a MultiGrid (levels and parents)
+ * is stored. Attachments are not written.
+ *
+ * All data is stored in raw arrays, so that a file can be read through a
+ * memory mapping (see MappedFile) without any parsing. A file consists of
+ * - a UGBFileHeader,
+ * - the data blocks of all chunks, each 64 byte aligned,
+ * - a table of UGBChunk records which describe the data blocks.
+ *
+ * Elements are stored in blocks of equal type. Blocks are written level by
+ * level, on each level in the order of UGBElementType. The index of an element
+ * is its position among all elements of the same base type (vertex, edge,
+ * face or volume) in this order. Element blocks contain the vertex indices of
+ * each element (int32), vertex blocks the coordinates of each vertex (double).
+ * Blocks of levels > 0 are followed by a block with the UGBParent of each
+ * element, blocks of constrained objects by a block with their UGBConstraint.
+ *
+ * Subset indices (int32) and selection states (uint8) are stored for all
+ * elements of a base type in one block each.
+ *
+ * Optionally, global ids of all elements and the interface entries of a
+ * distributed grid can be stored. This allows to load each part of a
+ * distributed grid on its own process (see LoadPartitionedGrid).
+ *
+ * Files are written in the byte order of the writing machine. Reading a file
+ * with a different byte order is rejected.
+ */
+enum UGBElementType
+{
+	UGB_REGULAR_VERTEX = 0,
+	UGB_CONSTRAINED_VERTEX,
+	UGB_REGULAR_EDGE,
+	UGB_CONSTRAINING_EDGE,
+	UGB_CONSTRAINED_EDGE,
+	UGB_TRIANGLE,
+	UGB_CONSTRAINING_TRIANGLE,
+	UGB_CONSTRAINED_TRIANGLE,
+	UGB_QUADRILATERAL,
+	UGB_CONSTRAINING_QUADRILATERAL,
+	UGB_CONSTRAINED_QUADRILATERAL,
+	UGB_TETRAHEDRON,
+	UGB_HEXAHEDRON,
+	UGB_PRISM,
+	UGB_PYRAMID,
+	UGB_OCTAHEDRON,
+	UGB_NUM_ELEMENT_TYPES
+};
+
+///	types of the chunks of a ugb file
+enum UGBChunkType
+{
+	UGB_GRID = 1,			///< name of a grid
+	UGB_ELEMENTS,			///< coordinates of vertices or vertex indices of elements
+	UGB_PARENTS,			///< UGBParent of each element of the preceding element block
+	UGB_CONSTRAINTS,		///< UGBConstraint of each element of the preceding element block
+	UGB_SUBSET_HANDLER,		///< name and subset infos of a subset handler
+	UGB_SUBSET_INDICES,		///< subset index of each element of a base type
+	UGB_SELECTOR,			///< name of a selector
+	UGB_SELECTION,			///< selection state of each element of a base type
+	UGB_PROJECTION_HANDLER,	///< subset handler index and serialized projectors
+	UGB_GLOBAL_IDS,			///< UGBGlobalID of each element of a base type
+	UGB_INTERFACES			///< UGBInterfaceEntry of each interface entry of a base type
+};
+
+///	header at the beginning of each ugb file (64 bytes)
+struct UGBFileHeader
+{
+	char		magic[8];			///< "UG4GRDB" (zero terminated)
+	uint32_t	version;			///< format version, see UGBFileVersion
+	uint32_t	byteOrder;			///< 0x01020304 as written by the writing machine
+	uint64_t	numChunks;			///< number of entries in the chunk table
+	uint64_t	chunkTableOffset;	///< byte offset of the chunk table
+	uint64_t	reserved[4];
+};
+
+///	record describing one chunk of a ugb file (48 bytes)
+/**	The meaning of the fields depends on the chunk type:
+ * - UGB_GRID: index holds the number of coordinates per vertex, level the
+ *   number of levels. The data block holds the name.
+ * - UGB_ELEMENTS, UGB_PARENTS, UGB_CONSTRAINTS: elemType and level of the
+ *   elements, num the number of elements.
+ * - UGB_SUBSET_HANDLER, UGB_SELECTOR, UGB_PROJECTION_HANDLER: index of the
+ *   object in its grid. The data block holds its description.
+ * - UGB_SUBSET_INDICES, UGB_SELECTION: index of the subset handler or selector,
+ *   elemType holds the base object id, num the number of elements.
+ * - UGB_GLOBAL_IDS, UGB_INTERFACES: elemType holds the base object id, num
+ *   the number of entries.*/
+struct UGBChunk
+{
+	uint32_t	type;		///< a value of UGBChunkType
+	uint32_t	grid;		///< index of the grid to which the chunk belongs
+	uint32_t	index;
+	uint32_t	level;
+	uint32_t	elemType;
+	uint32_t	reserved;
+	uint64_t	num;		///< number of entries in the data block
+	uint64_t	offset;		///< absolute byte offset of the data block
+	uint64_t	size;		///< size of the data block in bytes
+};
+
+///	parent of an element in a MultiGrid hierarchy
+/**	baseObjectId and index are -1 if the element has no parent.*/
+struct UGBParent
+{
+	int32_t	baseObjectId;
+	int32_t	index;
+};
+
+///	constraining object and local coordinates of a constrained object
+/**	index is -1 if the constraining object is not known. baseObjectId may
+ * then still hold the base object id of the constraining object (see e.g.
+ * ConstrainedVertex::get_parent_base_object_id), or -1. Local coordinates
+ * are only used for constrained vertices.*/
+struct UGBConstraint
+{
+	int32_t	baseObjectId;
+	int32_t	index;
+	double	localCoord[2];
+};
+
+///	global id of an element, see GeomObjID
+struct UGBGlobalID
+{
+	int32_t		procRank;
+	int32_t		reserved;
+	uint64_t	localID;
+};
+
+///	an entry of an interface of a distributed grid
+/**	index is the index of the element among all elements of its base type,
+ * interfaceType a value of InterfaceNodeTypes. Entries are stored in the
+ * order in which they appear in the interface to the process proc.*/
+struct UGBInterfaceEntry
+{
+	int32_t	index;
+	int32_t	proc;
+	int32_t	interfaceType;
+	int32_t	level;
+};
+
+///	current version of the ugb format
+const uint32_t UGBFileVersion = 1;
+
+
+////////////////////////////////////////////////////////////////////////
+///	Writes a grid and a subset handler to a ugb file.
+/**	If the grid is a MultiGrid, its hierarchy is written, too.
+ * Since the type of the position attachment is a template parameter,
+ * MathVector attachments of any dimension are supported.*/
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh,
+				   const char* filename, TAPosition& aPos);
+
+///	Writes a grid to a ugb file, using the standard position attachment with the highest dimension.
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh,
+				   const char* filename);
+
+///	Reads the first grid and its first subset handler from a ugb file.
+/**	If grid is a MultiGrid, the hierarchy stored in the file is restored.
+ * Otherwise all levels are loaded into the flat grid.*/
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh,
+					 const char* filename, TAPosition& aPos);
+
+///	Reads a grid together with its projection handler and additional subset handlers.
+/**	Behaves like the corresponding version of LoadGridFromUGX.*/
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, SPProjectionHandler& ph, size_t& num_ph,
+					 ISubsetHandler& sh, std::vector<std::string> additionalSHNames,
+					 std::vector<SmartPtr<ISubsetHandler> > ash,
+					 const char* filename, TAPosition& aPos);
+
+///	Reads a grid from a ugb file, using the standard position attachment with the highest dimension.
+/**	If no standard position attachment is found, aPosition is attached and used.*/
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh,
+					 const char* filename);
+
+///	Converts a ugx file to a ugb file.
+/**	All grids with their subset handlers, selectors and projection handlers
+ * are converted. The number of coordinates of the vertices is preserved.*/
+bool ConvertUGXToUGB(const char* ugxFilename, const char* ugbFilename);
+
+///	Converts a ugb file to a ugx file.
+/**	All grids with their subset handlers, selectors and projection handlers
+ * are converted. Since ugx files can't hold a grid hierarchy, all levels
+ * are written to one flat grid.*/
+bool ConvertUGBToUGX(const char* ugbFilename, const char* ugxFilename);
+
+
+////////////////////////////////////////////////////////////////////////
+///	Grants write access to ugb files.
+/**	Data is written to the file as soon as it is added. The chunk table is
+ * written on close, which is also called by the destructor.
+ *
+ * Add a grid before its subset handlers, selectors and projection handlers.
+ * The grids have to exist until the writer is closed. The subset handler
+ * of a projection handler has to be added before the projection handler.
+ *
+ * An UGError is thrown if the file can't be written.*/
+class GridWriterUGB
+{
+	public:
+		GridWriterUGB();
+		GridWriterUGB(const char* filename);
+		~GridWriterUGB();
+
+		void open(const char* filename);
+
+	///	writes the chunk table and closes the file
+		void close();
+
+	/**	TPositionAttachments value type has to be compatible with MathVector.
+	 *	Make sure that aPos is attached to the vertices of the grid.*/
+		template <class TPositionAttachment>
+		void add_grid(Grid& grid, const char* name,
+					  TPositionAttachment& aPos);
+
+		void add_subset_handler(ISubsetHandler& sh, const char* name,
+								size_t refGridIndex);
+
+		void add_selector(ISelector& sel, const char* name,
+						  size_t refGridIndex);
+
+		void add_projection_handler(ProjectionHandler& ph, const char* name,
+									size_t refGridIndex);
+
+	///	writes the global ids of all elements for which aID is attached
+		void add_global_ids(AGeomObjID& aID, size_t refGridIndex);
+
+	///	writes the entries of the horizontal and vertical interfaces of the grid
+	/**	This allows to restore the layouts of a distributed grid on the process
+	 * which reads the grid, without any communication.*/
+		void add_layouts(GridLayoutMap& glm, size_t refGridIndex);
+
+	protected:
+	///	a block of elements of equal type on one level
+	/**	first is the index of the first element in the element list of its base type.*/
+		struct Block
+		{
+			Block(UGBElementType t, size_t l, size_t f, size_t n) :
+				type(t), level(l), first(f), num(n)	{}
+			UGBElementType	type;
+			size_t			level;
+			size_t			first;
+			size_t			num;
+		};
+
+		struct GridEntry
+		{
+			GridEntry(Grid* g) : grid(g), mg(dynamic_cast<MultiGrid*>(g)),
+				numLevels(1), numSelectors(0), numProjectionHandlers(0)	{}
+
+			Grid*		grid;
+			MultiGrid*	mg;
+			size_t		numLevels;
+			Grid::VertexAttachmentAccessor<AInt>	aaIndVRT;
+			Grid::EdgeAttachmentAccessor<AInt>		aaIndEDGE;
+			Grid::FaceAttachmentAccessor<AInt>		aaIndFACE;
+			Grid::VolumeAttachmentAccessor<AInt>	aaIndVOL;
+			std::vector<const ISubsetHandler*>	subsetHandlers;
+			size_t		numSelectors;
+			size_t		numProjectionHandlers;
+			std::vector<Block>	blocks;
+		//	elements of the grid in the order in which they are written
+			std::vector<Vertex*>	vertices;
+			std::vector<Edge*>		edges;
+			std::vector<Face*>		faces;
+			std::vector<Volume*>	volumes;
+		};
+
+	///	collects the elements of the grid in file order and assigns their indices
+		void init_grid_entry(GridEntry& entry);
+
+		template <class TElem>
+		void collect_block(GridEntry& entry, UGBElementType type, size_t level,
+						   std::vector<typename TElem::grid_base_object*>& elemsInOut);
+
+		template <class TAAPos>
+		void write_vertices(const GridEntry& entry, size_t gridIndex,
+							const Block& block, TAAPos& aaPos);
+
+	///	writes the vertex indices of the elements of a block
+		void write_elements(const GridEntry& entry, size_t gridIndex, const Block& block);
+
+		void write_parents(const GridEntry& entry, size_t gridIndex, const Block& block);
+
+		void write_constraints(const GridEntry& entry, size_t gridIndex, const Block& block);
+
+		template <class TElem>
+		void write_subset_indices(const ISubsetHandler& sh, const std::vector<TElem*>& elems,
+								  size_t gridIndex, size_t shIndex);
+
+		template <class TElem>
+		void write_global_ids(Grid& grid, AGeomObjID& aID,
+							  const std::vector<TElem*>& elems, size_t gridIndex);
+
+		template <class TElem>
+		void write_interfaces(const GridEntry& entry, GridLayoutMap& glm,
+							  size_t gridIndex);
+
+		template <class TElem>
+		void write_selection(const ISelector& sel, const std::vector<TElem*>& elems,
+							 size_t gridIndex, size_t selIndex);
+
+	///	returns the element with the given index in the block
+		GridObject* element(const GridEntry& entry, const Block& block, size_t i) const;
+
+	///	returns the index of the given object or -1 if obj == NULL
+		int index_of(const GridEntry& entry, GridObject* obj) const;
+
+	///	starts a new 64 byte aligned chunk
+		void begin_chunk(UGBChunkType type, size_t gridIndex, size_t index = 0,
+						 size_t level = 0, size_t elemType = 0);
+
+	///	appends data to the current chunk
+		void write_data(const void* data, size_t size);
+
+		template <class T>
+		void write_data(std::vector<T>& buf)
+		{
+			if(!buf.empty())
+				write_data(&buf.front(), buf.size() * sizeof(T));
+			buf.clear();
+		}
+
+	///	completes the current chunk. num is the number of entries.
+		void end_chunk(size_t num);
+
+		void check_grid_index(size_t refGridIndex) const;
+
+	protected:
+		std::ofstream			m_out;
+		std::string				m_filename;
+		uint64_t				m_pos;
+		std::vector<UGBChunk>	m_chunks;
+		std::vector<GridEntry>	m_entries;
+
+	///	attached to all elements of each grid during add_grid.
+		AInt	m_aInt;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+///	Grants read access to ugb files.
+/**	The file is memory mapped on open. Grid elements are created from the
+ * mapped arrays in bulk. An UGError is thrown if the file is not a valid
+ * ugb file.*/
+class GridReaderUGB
+{
+	public:
+		GridReaderUGB();
+		GridReaderUGB(const char* filename);
+		~GridReaderUGB();
+
+		void open(const char* filename);
+		void close();
+
+	///	returns the number of grids
+		size_t num_grids() const	{return m_entries.size();}
+
+	///	returns the name of the i-th grid
+		std::string get_grid_name(size_t index) const;
+
+	///	returns the number of coordinates per vertex which are stored for the given grid
+		size_t num_coordinates(size_t index) const;
+
+	///	returns the number of levels of the given grid
+		size_t num_levels(size_t index) const;
+
+	///	creates the i-th grid.
+	/**	TPositionAttachments value type has to be compatible with MathVector.
+	 * If gridOut is a MultiGrid, the stored hierarchy is restored.
+	 * Coordinates are truncated or filled up with 0's if the dimension of aPos
+	 * does not match the stored number of coordinates.*/
+		template <class TPositionAttachment>
+		bool grid(Grid& gridOut, size_t index, TPositionAttachment& aPos);
+
+	///	returns the number of subset handlers for the given grid
+		size_t num_subset_handlers(size_t refGridIndex) const;
+
+	///	returns the name of the given subset handler
+		std::string get_subset_handler_name(size_t refGridIndex,
+											size_t subsetHandlerIndex) const;
+
+	///	restores names, colors and states of all subsets, without assigning any elements
+		void subset_infos(ISubsetHandler& shOut, size_t subsetHandlerIndex,
+						  size_t refGridIndex);
+
+	///	fills the given subset-handler
+	/**	The grid has to be created first.*/
+		bool subset_handler(ISubsetHandler& shOut, size_t subsetHandlerIndex,
+							size_t refGridIndex);
+
+	///	returns the number of selectors for the given grid
+		size_t num_selectors(size_t refGridIndex) const;
+
+	///	returns the name of the given selector
+		std::string get_selector_name(size_t refGridIndex, size_t selectorIndex) const;
+
+	///	fills the given selector
+	/**	The grid has to be created first.*/
+		bool selector(ISelector& selOut, size_t selectorIndex, size_t refGridIndex);
+
+	///	returns the number of projection-handlers for the given grid
+		size_t num_projection_handlers(size_t refGridIndex) const;
+
+	///	returns the name of the given projection-handler
+		std::string get_projection_handler_name(size_t refGridIndex, size_t phIndex) const;
+
+	///	returns the subset handler index for a projection handler
+		size_t get_projection_handler_subset_handler_index(size_t phIndex, size_t refGridIndex) const;
+
+	///	fills the given projection-handler
+		bool projection_handler(ProjectionHandler& phOut, size_t phIndex, size_t refGridIndex);
+
+	///	returns true if global ids were stored for the given grid
+		bool has_global_ids(size_t refGridIndex) const;
+
+	///	attaches aID to all elements of the grid and fills it with the stored global ids
+	/**	The grid has to be created first.*/
+		bool global_ids(Grid& grid, AGeomObjID& aID, size_t refGridIndex);
+
+	///	returns true if interfaces were stored for the given grid
+		bool has_layouts(size_t refGridIndex) const;
+
+	///	adds the stored interface entries to the layouts of the given layout map
+	/**	The grid has to be created first.*/
+		bool layouts(GridLayoutMap& glmOut, size_t refGridIndex);
+
+	protected:
+	///	an element block together with the optional parent and constraint blocks
+	/**	first is the index of the first element of the block among all elements
+	 * of its base type. It is set when the elements are created.*/
+		struct ElementBlock
+		{
+			ElementBlock(const UGBChunk* e) :
+				elems(e), parents(NULL), constraints(NULL), first(0)	{}
+			const UGBChunk*	elems;
+			const UGBChunk*	parents;
+			const UGBChunk*	constraints;
+			size_t			first;
+		};
+
+		struct GridEntry
+		{
+			GridEntry(const UGBChunk* c) :
+				chunk(c), globalIDs(4, NULL), interfaces(4, NULL)	{}
+
+			const UGBChunk*					chunk;
+			std::vector<ElementBlock>		blocks;
+			std::vector<const UGBChunk*>	subsetHandlers;
+			std::vector<const UGBChunk*>	selectors;
+			std::vector<const UGBChunk*>	projectionHandlers;
+		//	subset index and selection blocks of each subset handler and selector,
+		//	indexed by base object id
+			std::vector<std::vector<const UGBChunk*> >	subsetIndices;
+			std::vector<std::vector<const UGBChunk*> >	selections;
+		//	global id and interface blocks indexed by base object id
+			std::vector<const UGBChunk*>	globalIDs;
+			std::vector<const UGBChunk*>	interfaces;
+			std::vector<Vertex*> 	vertices;
+			std::vector<Edge*> 		edges;
+			std::vector<Face*>		faces;
+			std::vector<Volume*>	volumes;
+		};
+
+	///	creates the vertices of the given block, without setting their coordinates
+		void create_vertices(Grid& grid, MultiGrid* mg, GridEntry& entry,
+							 ElementBlock& block);
+
+	///	creates the edges, faces or volumes of the given block
+		void create_elements(Grid& grid, MultiGrid* mg, GridEntry& entry,
+							 ElementBlock& block);
+
+		template <class TElem>
+		void create_element_block(Grid& grid, MultiGrid* mg, GridEntry& entry,
+								  ElementBlock& block, size_t numCorners,
+								  std::vector<typename TElem::grid_base_object*>& elemsInOut);
+
+	///	reserves memory in the grid for all objects stored for the grid entry
+		void reserve(Grid& grid, GridEntry& entry);
+
+	///	resolves the constraints of all blocks of the grid
+		void resolve_constraints(GridEntry& entry);
+
+	///	returns the parents of the block or NULL if none shall be restored
+		const UGBParent* parents(MultiGrid* mg, const ElementBlock& block) const;
+
+	///	returns the parent of the i-th element or NULL
+		GridObject* parent(const GridEntry& entry, const UGBParent* parents, size_t i) const;
+
+		GridObject* object(const GridEntry& entry, int baseObjectId, int index) const;
+
+		const GridEntry& grid_entry(size_t refGridIndex) const;
+		GridEntry& grid_entry(size_t refGridIndex);
+
+	///	returns a pointer to the data block of the chunk, after checking that it lies in the file
+		const char* data(const UGBChunk& chunk) const;
+
+		template <class T>
+		const T* data_array(const UGBChunk& chunk, size_t entriesPerElem) const;
+
+	protected:
+		MappedFile				m_file;
+		std::string				m_filename;
+		std::vector<GridEntry>	m_entries;
+};
+
+}//	end of namespace
+
+////////////////////////////////
+//	include implementation
+#include "file_io_ugb_impl.hpp"
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGB_IMPL__
+#define __H__LIB_GRID__FILE_IO_UGB_IMPL__
+
+#include <algorithm>
+#include <cstring>
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh, const char* filename,
+				   TAPosition& aPos)
+{
+	GridWriterUGB ugbWriter(filename);
+	ugbWriter.add_grid(grid, "defGrid", aPos);
+	ugbWriter.add_subset_handler(sh, "defSH", 0);
+	ugbWriter.close();
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, SPProjectionHandler& ph, size_t& num_ph,
+					 ISubsetHandler& sh, std::vector<std::string> additionalSHNames,
+					 std::vector<SmartPtr<ISubsetHandler> > ash,
+					 const char* filename, TAPosition& aPos)
+{
+	GridReaderUGB ugbReader(filename);
+
+	if(ugbReader.num_grids() < 1){
+		UG_LOG("ERROR in LoadGridFromUGB: File contains no grid.\n");
+		return false;
+	}
+
+	if(!ugbReader.grid(grid, 0, aPos))
+		return false;
+
+	if(ugbReader.num_subset_handlers(0) > 0)
+		ugbReader.subset_handler(sh, 0, 0);
+
+	for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name){
+		for(size_t i_sh = 0; i_sh < ugbReader.num_subset_handlers(0); ++i_sh){
+			if(additionalSHNames[i_name] == ugbReader.get_subset_handler_name(0, i_sh))
+				ugbReader.subset_handler(*ash[i_name], i_sh, 0);
+		}
+	}
+
+	if(ugbReader.num_projection_handlers(0) > 0){
+		ugbReader.projection_handler(*ph, 0, 0);
+		size_t shIndex = ugbReader.get_projection_handler_subset_handler_index(0, 0);
+		if(shIndex > 0){
+			std::string shName = ugbReader.get_subset_handler_name(0, shIndex);
+			for(size_t i_name = 0; i_name < additionalSHNames.size(); ++i_name){
+				if(shName == additionalSHNames[i_name]){
+					try {ph->set_subset_handler(ash[i_name]);}
+					UG_CATCH_THROW("Additional subset handler '"<< shName << "' has not been added to the domain.\n"
+									"Do so by using Domain::create_additional_subset_handler(std::string name).");
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh, const char* filename,
+					 TAPosition& aPos)
+{
+	GridReaderUGB ugbReader(filename);
+
+	if(ugbReader.num_grids() < 1){
+		UG_LOG("ERROR in LoadGridFromUGB: File contains no grid.\n");
+		return false;
+	}
+
+	if(!ugbReader.grid(grid, 0, aPos))
+		return false;
+
+	if(ugbReader.num_subset_handlers(0) > 0)
+		ugbReader.subset_handler(sh, 0, 0);
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	GridWriterUGB
+template <class TPositionAttachment>
+void GridWriterUGB::
+add_grid(Grid& grid, const char* name, TPositionAttachment& aPos)
+{
+	UG_COND_THROW(!m_out.is_open(), "GridWriterUGB::add_grid: no file opened.");
+	UG_COND_THROW(!grid.has_vertex_attachment(aPos),
+				  "GridWriterUGB::add_grid: position attachment missing in grid " << name);
+
+	Grid::VertexAttachmentAccessor<TPositionAttachment> aaPos(grid, aPos);
+	const size_t numCoords = TPositionAttachment::ValueType::Size;
+
+	m_entries.push_back(GridEntry(&grid));
+	GridEntry& entry = m_entries.back();
+	const size_t gridIndex = m_entries.size() - 1;
+	init_grid_entry(entry);
+
+	begin_chunk(UGB_GRID, gridIndex, numCoords, entry.numLevels);
+	write_data(name, strlen(name));
+	end_chunk(1);
+
+	for(size_t i = 0; i < entry.blocks.size(); ++i){
+		const Block& block = entry.blocks[i];
+		if(block.type <= UGB_CONSTRAINED_VERTEX)
+			write_vertices(entry, gridIndex, block, aaPos);
+		else
+			write_elements(entry, gridIndex, block);
+
+		if(entry.mg && block.level > 0)
+			write_parents(entry, gridIndex, block);
+
+		switch(block.type){
+			case UGB_CONSTRAINED_VERTEX:
+			case UGB_CONSTRAINED_EDGE:
+			case UGB_CONSTRAINED_TRIANGLE:
+			case UGB_CONSTRAINED_QUADRILATERAL:
+				write_constraints(entry, gridIndex, block);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+template <class TAAPos>
+void GridWriterUGB::
+write_vertices(const GridEntry& entry, size_t gridIndex, const Block& block,
+			   TAAPos& aaPos)
+{
+	const size_t numCoords = TAAPos::ValueType::Size;
+	const size_t bufSize = 3 << 16;
+	std::vector<double> buf;
+	buf.reserve(bufSize + numCoords);
+
+	begin_chunk(UGB_ELEMENTS, gridIndex, 0, block.level, block.type);
+	for(size_t i = block.first; i < block.first + block.num; ++i){
+		const typename TAAPos::ValueType& v = aaPos[entry.vertices[i]];
+		for(size_t j = 0; j < numCoords; ++j)
+			buf.push_back(v[j]);
+		if(buf.size() >= bufSize)
+			write_data(buf);
+	}
+	write_data(buf);
+	end_chunk(block.num);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	GridReaderUGB
+template <class TPositionAttachment>
+bool GridReaderUGB::
+grid(Grid& gridOut, size_t index, TPositionAttachment& aPos)
+{
+	GridEntry& entry = grid_entry(index);
+	Grid& grid = gridOut;
+	MultiGrid* mg = dynamic_cast<MultiGrid*>(&grid);
+
+	UG_COND_THROW(!entry.vertices.empty(), "GridReaderUGB::grid: Grid "
+				  << index << " of '" << m_filename << "' has already been created.");
+
+//	all elements are created in the order in which they are stored. Grid options
+//	are disabled meanwhile, so that no further elements are created automatically.
+	uint gridopts = grid.get_options();
+	grid.set_options(GRIDOPT_NONE);
+
+	if(!grid.has_vertex_attachment(aPos))
+		grid.attach_to_vertices(aPos);
+	Grid::VertexAttachmentAccessor<TPositionAttachment> aaPos(grid, aPos);
+
+	const size_t numSrcCoords = num_coordinates(index);
+	const size_t numDestCoords = TPositionAttachment::ValueType::Size;
+	const size_t minNumCoords = std::min(numSrcCoords, numDestCoords);
+
+	reserve(grid, entry);
+
+	try{
+		for(size_t i = 0; i < entry.blocks.size(); ++i){
+			ElementBlock& block = entry.blocks[i];
+			if(block.elems->elemType > UGB_CONSTRAINED_VERTEX){
+				create_elements(grid, mg, entry, block);
+				continue;
+			}
+
+			create_vertices(grid, mg, entry, block);
+			const double* coords = data_array<double>(*block.elems, numSrcCoords);
+			for(size_t j = 0; j < block.elems->num; ++j){
+				typename TPositionAttachment::ValueType& v
+							= aaPos[entry.vertices[block.first + j]];
+				const double* c = coords + j * numSrcCoords;
+				for(size_t k = 0; k < minNumCoords; ++k)
+					v[k] = c[k];
+				for(size_t k = minNumCoords; k < numDestCoords; ++k)
+					v[k] = 0;
+			}
+		}
+
+		resolve_constraints(entry);
+	}
+	catch(...){
+		grid.set_options(gridopts);
+		throw;
+	}
+
+	grid.set_options(gridopts);
+	return true;
+}
+
+template <class T>
+const T* GridReaderUGB::
+data_array(const UGBChunk& chunk, size_t entriesPerElem) const
+{
+	UG_COND_THROW(chunk.size != chunk.num * entriesPerElem * sizeof(T),
+				  "Chunk of invalid size in ugb file '" << m_filename << "'.");
+	return reinterpret_cast<const T*>(data(chunk));
+}
+
+}//	end of namespace
+
+#endif
@@ -993,29 +993,7 @@ subset_handler(ISubsetHandler& shOut,
 	while(subsetNode)
 	{
 	//	set subset info
-	//	retrieve an initial subset-info from shOut, so that initialised values are kept.
-		SubsetInfo si = shOut.subset_info(subsetInd);
-
-		xml_attribute<>* attrib = subsetNode->first_attribute("name");
-		if(attrib)
-			si.name = attrib->value();
-
-		attrib = subsetNode->first_attribute("color");
-		if(attrib){
-			stringstream ss(attrib->value(), ios_base::in);
-			for(size_t i = 0; i < 4; ++i)
-				ss >> si.color[i];
-		}
-
-		attrib = subsetNode->first_attribute("state");
-		if(attrib){
-			stringstream ss(attrib->value(), ios_base::in);
-			size_t state;
-			ss >> state;
-			si.subsetState = (uint)state;
-		}
-
-		shOut.set_subset_info(subsetInd, si);
+		read_subset_info(shOut, subsetInd, subsetNode);
 
 	//	read elements of this subset
 		if(shOut.elements_are_supported(SHE_VERTEX))
@@ -1042,6 +1020,35 @@ subset_handler(ISubsetHandler& shOut,
 	return true;
 }
 
+void GridReaderUGX::
+read_subset_info(ISubsetHandler& shOut, int subsetInd,
+				 rapidxml::xml_node<>* subsetNode)
+{
+//	retrieve an initial subset-info from shOut, so that initialised values are kept.
+	SubsetInfo si = shOut.subset_info(subsetInd);
+
+	xml_attribute<>* attrib = subsetNode->first_attribute("name");
+	if(attrib)
+		si.name = attrib->value();
+
+	attrib = subsetNode->first_attribute("color");
+	if(attrib){
+		stringstream ss(attrib->value(), ios_base::in);
+		for(size_t i = 0; i < 4; ++i)
+			ss >> si.color[i];
+	}
+
+	attrib = subsetNode->first_attribute("state");
+	if(attrib){
+		stringstream ss(attrib->value(), ios_base::in);
+		size_t state;
+		ss >> state;
+		si.subsetState = (uint)state;
+	}
+
+	shOut.set_subset_info(subsetInd, si);
+}
+
 template <class TGeomObj>
 bool GridReaderUGX::
 read_subset_handler_elements(ISubsetHandler& shOut,
@@ -1368,6 +1375,214 @@ new_document_parsed()
 	return true;
 }
 
+void GridReaderUGX::
+resolve_constraining_objects(Grid& grid,
+							 std::vector<Edge*>& edges,
+							 std::vector<Face*>& faces,
+							 std::vector<std::pair<int, int> >& constrainingObjsVRT,
+							 std::vector<std::pair<int, int> >& constrainingObjsEDGE,
+							 std::vector<std::pair<int, int> >& constrainingObjsTRI,
+							 std::vector<std::pair<int, int> >& constrainingObjsQUAD)
+{
+	if(!constrainingObjsVRT.empty()){
+		//UG_LOG("num-edges: " << edges.size() << std::endl);
+	//	iterate over the pairs.
+	//	at the same time we'll iterate over the constrained vertices since
+	//	they are synchronized.
+		ConstrainedVertexIterator hvIter = grid.begin<ConstrainedVertex>();
+		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsVRT.begin();
+			iter != constrainingObjsVRT.end(); ++iter, ++hvIter)
+		{
+			ConstrainedVertex* hv = *hvIter;
+			
+			switch(iter->first){
+				case 1:	// constraining object is an edge
+				{
+				//	make sure that the index is valid
+					if(iter->second >= 0 && iter->second < (int)edges.size()){
+					//	get the edge
+						ConstrainingEdge* edge = dynamic_cast<ConstrainingEdge*>(edges[iter->second]);
+						if(edge){
+							hv->set_constraining_object(edge);
+							edge->add_constrained_object(hv);
+						}
+						else{
+							UG_LOG("WARNING: Type-ID / type mismatch. Ignoring edge " << iter->second << ".\n");
+						}
+					}
+					else{
+						UG_LOG("ERROR in GridReaderUGX: Bad edge index in constrained vertex: " << iter->second << "\n");
+					}
+				}break;
+				
+				case 2:	// constraining object is an face
+				{
+				//	make sure that the index is valid
+					if(iter->second >= 0 && iter->second < (int)faces.size()){
+					//	get the edge
+						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
+						if(face){
+							hv->set_constraining_object(face);
+							face->add_constrained_object(hv);
+						}
+						else{
+							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
+						}
+					}
+					else{
+						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained vertex: " << iter->second << "\n");
+					}
+				}break;
+				
+				default:
+				{
+//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining vertex"
+//							<< " at " << GetGridObjectCenter(grid, hv) << "\n");
+					break;
+				}
+			}
+		}
+	}
+
+	if(!constrainingObjsEDGE.empty()){
+	//	iterate over the pairs.
+	//	at the same time we'll iterate over the constrained vertices since
+	//	they are synchronized.
+		ConstrainedEdgeIterator ceIter = grid.begin<ConstrainedEdge>();
+		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsEDGE.begin();
+			iter != constrainingObjsEDGE.end(); ++iter, ++ceIter)
+		{
+			ConstrainedEdge* ce = *ceIter;
+			
+			switch(iter->first){
+				case 1:	// constraining object is an edge
+				{
+				//	make sure that the index is valid
+					if(iter->second >= 0 && iter->second < (int)edges.size()){
+					//	get the edge
+						ConstrainingEdge* edge = dynamic_cast<ConstrainingEdge*>(edges[iter->second]);
+						if(edge){
+							ce->set_constraining_object(edge);
+							edge->add_constrained_object(ce);
+						}
+						else{
+							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring edge " << iter->second << ".\n");
+						}
+					}
+					else{
+						UG_LOG("ERROR in GridReaderUGX: Bad edge index in constrained edge.\n");
+					}
+				}break;
+				case 2:	// constraining object is an face
+				{
+				//	make sure that the index is valid
+					if(iter->second >= 0 && iter->second < (int)faces.size()){
+					//	get the edge
+						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
+						if(face){
+							ce->set_constraining_object(face);
+							face->add_constrained_object(ce);
+						}
+						else{
+							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
+						}
+					}
+					else{
+						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained edge: " << iter->second << "\n");
+					}
+				}break;
+				
+				default:
+				{
+//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining edge"
+//							<< " at " << GetGridObjectCenter(grid, ce) << "\n");
+					break;
+				}
+			}
+		}
+	}
+
+	if(!constrainingObjsTRI.empty()){
+	//	iterate over the pairs.
+	//	at the same time we'll iterate over the constrained vertices since
+	//	they are synchronized.
+		ConstrainedTriangleIterator cfIter = grid.begin<ConstrainedTriangle>();
+		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsTRI.begin();
+			iter != constrainingObjsTRI.end(); ++iter, ++cfIter)
+		{
+			ConstrainedFace* cdf = *cfIter;
+			
+			switch(iter->first){
+				case 2:	// constraining object is an face
+				{
+				//	make sure that the index is valid
+					if(iter->second >= 0 && iter->second < (int)faces.size()){
+					//	get the edge
+						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
+						if(face){
+							cdf->set_constraining_object(face);
+							face->add_constrained_object(cdf);
+						}
+						else{
+							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
+						}
+					}
+					else{
+						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained face: " << iter->second << "\n");
+					}
+				}break;
+				
+				default:
+				{
+//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining triangle"
+//							<< " at " << GetGridObjectCenter(grid, cdf) << "\n");
+					break;
+				}
+			}
+		}
+	}
+
+	if(!constrainingObjsQUAD.empty()){
+	//	iterate over the pairs.
+	//	at the same time we'll iterate over the constrained vertices since
+	//	they are synchronized.
+		ConstrainedQuadrilateralIterator cfIter = grid.begin<ConstrainedQuadrilateral>();
+		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsQUAD.begin();
+			iter != constrainingObjsQUAD.end(); ++iter, ++cfIter)
+		{
+			ConstrainedFace* cdf = *cfIter;
+			
+			switch(iter->first){
+				case 2:	// constraining object is an face
+				{
+				//	make sure that the index is valid
+					if(iter->second >= 0 && iter->second < (int)faces.size()){
+					//	get the edge
+						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
+						if(face){
+							cdf->set_constraining_object(face);
+							face->add_constrained_object(cdf);
+						}
+						else{
+							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
+						}
+					}
+					else{
+						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained face: " << iter->second << "\n");
+					}
+				}break;
+				
+				default:
+				{
+//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining quadrilateral"
+//							<< " at " << GetGridObjectCenter(grid, cdf) << "\n");
+					break;
+				}
+			}
+		}
+	}
+}
+
 bool GridReaderUGX::
 create_edges(std::vector<Edge*>& edgesOut,
 			Grid& grid, rapidxml::xml_node<>* node,
@@ -37,6 +37,7 @@
 #include <errno.h>
 #include <cstdlib>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <utility>
 #include "common/parser/rapidxml/rapidxml.hpp"
@@ -48,6 +49,7 @@
 #include "lib_grid/grid_objects/grid_objects.h"
 #include "lib_grid/refinement/projectors/refinement_projector.h"
 #include "common/math/misc/shapes.h"	// AABox
+#include "common/util/thread_team.h"
 
 namespace ug
 {
@@ -466,6 +468,10 @@ class GridReaderUGX
 								Grid& grid, rapidxml::xml_node<>* node,
 								std::vector<Vertex*>& vrts);
 
+	///	sets name, color and state of the given subset from the attributes of subsetNode
+		void read_subset_info(ISubsetHandler& shOut, int subsetInd,
+							  rapidxml::xml_node<>* subsetNode);
+
 		template <class TGeomObj>
 		bool read_subset_handler_elements(ISubsetHandler& shOut,
 										 const char* elemNodeName,
@@ -482,6 +488,18 @@ class GridReaderUGX
 		template <class TElem>
 		bool read_attachment(Grid& grid, rapidxml::xml_node<>* node);
 
+	///	connects constrained objects with their constraining objects
+	/**	The pair vectors hold type and index of the constraining object of
+	 *	each constrained vertex, edge, triangle and quadrilateral, in the
+	 *	order in which those were created in grid.*/
+		void resolve_constraining_objects(Grid& grid,
+							std::vector<Edge*>& edges,
+							std::vector<Face*>& faces,
+							std::vector<std::pair<int, int> >& constrainingObjsVRT,
+							std::vector<std::pair<int, int> >& constrainingObjsEDGE,
+							std::vector<std::pair<int, int> >& constrainingObjsTRI,
+							std::vector<std::pair<int, int> >& constrainingObjsQUAD);
+
 		SPRefinementProjector
 		read_projector(rapidxml::xml_node<>* projNode);
 
@@ -494,6 +512,162 @@ class GridReaderUGX
 };
 
 
+////////////////////////////////////////////////////////////////////////
+///	Reads ugx files in a single streaming pass
+/**	In contrast to GridReaderUGX, the file is not loaded and parsed into a
+ *	DOM first. It is read in blocks of fixed size instead and the vertices and
+ *	elements are created while the file is read. Numbers are parsed in place,
+ *	without intermediate strings or streams. Large blocks of numbers can be
+ *	parsed by several threads (see set_num_threads), while all elements are
+ *	created by the calling thread. The threads are kept alive for all blocks. Peak memory thus mainly consists of the
+ *	created grid, the read buffer and one pointer per element.
+ *
+ *	Only the first grid in a file is read. Selectors, projection handlers and
+ *	attachments are comparably small and are read through a small DOM each.
+ *	Subset handlers are read while streaming. Their element indices are
+ *	stored until subset_handler is called.
+ *
+ *	Apart from parse_file, the interface equals the one of GridReaderUGX.
+ */
+class GridReaderUGXStream : protected GridReaderUGX
+{
+	public:
+		GridReaderUGXStream();
+		virtual ~GridReaderUGXStream();
+
+	///	sets the number of threads which are used to parse numbers
+		void set_num_threads(size_t numThreads);
+
+	///	returns the number of threads which are used to parse numbers
+		size_t num_threads() const						{return m_team.num_threads();}
+
+	///	sets the number of threads which new readers use (initially 1)
+		static void set_default_num_threads(size_t numThreads);
+
+	///	sets the size of the read buffer in bytes (default 16MB)
+		void set_buffer_size(size_t bufSize);
+
+	///	reads the file and creates the elements of its first grid in gridOut
+	/**	TPositionAttachments value type has to be compatible with MathVector.
+	 *	The position attachment is attached to gridOut if necessary.*/
+		template <class TPositionAttachment>
+		bool parse_file(const char* filename, Grid& gridOut,
+						TPositionAttachment& aPos);
+
+		using GridReaderUGX::num_grids;
+		using GridReaderUGX::get_grid_name;
+		using GridReaderUGX::num_subset_handlers;
+		using GridReaderUGX::get_subset_handler_name;
+		using GridReaderUGX::num_selectors;
+		using GridReaderUGX::get_selector_name;
+		using GridReaderUGX::selector;
+		using GridReaderUGX::num_projection_handlers;
+		using GridReaderUGX::get_projection_handler_name;
+		using GridReaderUGX::get_projection_handler_subset_handler_index;
+		using GridReaderUGX::projection_handler;
+
+	///	fills the given subset-handler
+		bool subset_handler(ISubsetHandler& shOut,
+							size_t subsetHandlerIndex,
+							size_t refGridIndex);
+
+	protected:
+	///	assigns parsed coordinates to vertices
+		class IPositionWriter
+		{
+			public:
+				virtual ~IPositionWriter()	{}
+				virtual void set(Vertex* vrt, const double* coords,
+								 int numCoords) = 0;
+		};
+
+		template <class TAAPos>
+		class PositionWriter : public IPositionWriter
+		{
+			public:
+				PositionWriter(TAAPos aaPos) : m_aaPos(aaPos)	{}
+				virtual void set(Vertex* vrt, const double* coords,
+								 int numCoords);
+			private:
+				TAAPos	m_aaPos;
+		};
+
+	///	reads the file in blocks and splits it into markup and text
+		class Tokenizer;
+
+	///	create vertices and elements from parsed numbers
+		class VertexCreator;
+		class ElementCreator;
+
+	///	element indices of one subset, separated by base object type
+		struct SubsetElements
+		{
+			std::vector<int>	inds[4];
+		};
+
+	///	element types of the element blocks in a grid node
+		enum ElementBlockType
+		{
+			EBT_EDGE,
+			EBT_CONSTRAINING_EDGE,
+			EBT_CONSTRAINED_EDGE,
+			EBT_TRIANGLE,
+			EBT_CONSTRAINING_TRIANGLE,
+			EBT_CONSTRAINED_TRIANGLE,
+			EBT_QUADRILATERAL,
+			EBT_CONSTRAINING_QUADRILATERAL,
+			EBT_CONSTRAINED_QUADRILATERAL,
+			EBT_TETRAHEDRON,
+			EBT_HEXAHEDRON,
+			EBT_PRISM,
+			EBT_PYRAMID,
+			EBT_OCTAHEDRON,
+			EBT_NONE
+		};
+
+	protected:
+	///	non-template part of parse_file
+		bool parse_stream(const char* filename, Grid& grid,
+						  IPositionWriter& posWriter);
+
+		bool read_grid(Tokenizer& tok, Grid& grid, IPositionWriter& posWriter,
+					   rapidxml::xml_node<>* gridNode);
+
+		bool read_vertices(Tokenizer& tok, Grid& grid,
+						   IPositionWriter& posWriter, int numSrcCoords,
+						   bool constrained, std::vector<Vertex*>& vrtsOut,
+						   std::vector<std::pair<int, int> >& constrainingObjsOut);
+
+		bool read_elements(Tokenizer& tok, Grid& grid, ElementBlockType type,
+						   GridEntry& gridEntry,
+						   std::vector<std::pair<int, int> >* constrainingObjs);
+
+		bool read_subset_handler(Tokenizer& tok, rapidxml::xml_node<>* shNode);
+
+	///	parses the numbers in the text of the current node and passes them to consumer
+	/**	consumer(const TValue* vals, size_t num) is called for consecutive
+	 *	parts of the numbers in the order of the file.*/
+		template <class TValue, class TConsumer>
+		bool read_numbers(Tokenizer& tok, TConsumer& consumer);
+
+	///	creates a node in m_doc from a start- or empty-element tag, without children
+		rapidxml::xml_node<>* tag_to_node(const std::string& tag);
+
+	///	parses the given xml string and creates a copy of its first node in m_doc
+		rapidxml::xml_node<>* string_to_node(const std::string& str);
+
+	protected:
+	///	threads used to parse numbers
+		ThreadTeam	m_team;
+		size_t		m_bufSize;
+
+	///	element indices for each subset handler and subset
+		std::vector<std::vector<SubsetElements> >	m_subsetElems;
+
+		static size_t	s_defaultNumThreads;
+};
+
+
 class UGXFileInfo{
 	public:
 		UGXFileInfo();
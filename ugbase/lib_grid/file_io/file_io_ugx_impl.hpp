@@ -33,6 +33,7 @@
 #ifndef __H__LIB_GRID__FILE_IO_UGX_IMPL__
 #define __H__LIB_GRID__FILE_IO_UGX_IMPL__
 
+#include <algorithm>
 #include <sstream>
 #include <cstring>
 #include "lib_grid/algorithms/debug_util.h"
@@ -59,9 +60,9 @@ template <class TAPosition>
 bool LoadGridFromUGX(Grid& grid, SPProjectionHandler& ph, size_t& num_ph, ISubsetHandler& sh, std::vector<std::string> additionalSHNames,
 						std::vector<SmartPtr<ISubsetHandler>> ash, const char* filename, TAPosition& aPos)
 {
-	GridReaderUGX ugxReader;
-	if(!ugxReader.parse_file(filename)){
-		UG_LOG("ERROR in LoadGridFromUGX: File not found: " << filename << std::endl);
+	GridReaderUGXStream ugxReader;
+	if(!ugxReader.parse_file(filename, grid, aPos)){
+		UG_LOG("ERROR in LoadGridFromUGX: Couldn't read file: " << filename << std::endl);
 		return false;
 	}
 	
@@ -70,8 +71,6 @@ bool LoadGridFromUGX(Grid& grid, SPProjectionHandler& ph, size_t& num_ph, ISubse
 		return false;
 	}
 
-	ugxReader.grid(grid, 0, aPos);
-
 	if(ugxReader.num_subset_handlers(0) > 0)
 		ugxReader.subset_handler(sh, 0, 0);
 	
@@ -109,9 +108,9 @@ template <class TAPosition>
 bool LoadGridFromUGX(Grid& grid, ISubsetHandler& sh, const char* filename,
 					 TAPosition& aPos)
 {
-	GridReaderUGX ugxReader;
-	if(!ugxReader.parse_file(filename)){
-		UG_LOG("ERROR in LoadGridFromUGX: File not found: " << filename << std::endl);
+	GridReaderUGXStream ugxReader;
+	if(!ugxReader.parse_file(filename, grid, aPos)){
+		UG_LOG("ERROR in LoadGridFromUGX: Couldn't read file: " << filename << std::endl);
 		return false;
 	}
 
@@ -120,8 +119,6 @@ bool LoadGridFromUGX(Grid& grid, ISubsetHandler& sh, const char* filename,
 		return false;
 	}
 
-	ugxReader.grid(grid, 0, aPos);
-
 	if(ugxReader.num_subset_handlers(0) > 0)
 		ugxReader.subset_handler(sh, 0, 0);
 
@@ -528,203 +525,9 @@ grid(Grid& gridOut, size_t index,
 	}
 	
 //	resolve constrained object relations
-	if(!constrainingObjsVRT.empty()){
-		//UG_LOG("num-edges: " << edges.size() << std::endl);
-	//	iterate over the pairs.
-	//	at the same time we'll iterate over the constrained vertices since
-	//	they are synchronized.
-		ConstrainedVertexIterator hvIter = grid.begin<ConstrainedVertex>();
-		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsVRT.begin();
-			iter != constrainingObjsVRT.end(); ++iter, ++hvIter)
-		{
-			ConstrainedVertex* hv = *hvIter;
-			
-			switch(iter->first){
-				case 1:	// constraining object is an edge
-				{
-				//	make sure that the index is valid
-					if(iter->second >= 0 && iter->second < (int)edges.size()){
-					//	get the edge
-						ConstrainingEdge* edge = dynamic_cast<ConstrainingEdge*>(edges[iter->second]);
-						if(edge){
-							hv->set_constraining_object(edge);
-							edge->add_constrained_object(hv);
-						}
-						else{
-							UG_LOG("WARNING: Type-ID / type mismatch. Ignoring edge " << iter->second << ".\n");
-						}
-					}
-					else{
-						UG_LOG("ERROR in GridReaderUGX: Bad edge index in constrained vertex: " << iter->second << "\n");
-					}
-				}break;
-				
-				case 2:	// constraining object is an face
-				{
-				//	make sure that the index is valid
-					if(iter->second >= 0 && iter->second < (int)faces.size()){
-					//	get the edge
-						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
-						if(face){
-							hv->set_constraining_object(face);
-							face->add_constrained_object(hv);
-						}
-						else{
-							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
-						}
-					}
-					else{
-						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained vertex: " << iter->second << "\n");
-					}
-				}break;
-				
-				default:
-				{
-//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining vertex"
-//							<< " at " << GetGridObjectCenter(grid, hv) << "\n");
-					break;
-				}
-			}
-		}
-	}
-
-	if(!constrainingObjsEDGE.empty()){
-	//	iterate over the pairs.
-	//	at the same time we'll iterate over the constrained vertices since
-	//	they are synchronized.
-		ConstrainedEdgeIterator ceIter = grid.begin<ConstrainedEdge>();
-		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsEDGE.begin();
-			iter != constrainingObjsEDGE.end(); ++iter, ++ceIter)
-		{
-			ConstrainedEdge* ce = *ceIter;
-			
-			switch(iter->first){
-				case 1:	// constraining object is an edge
-				{
-				//	make sure that the index is valid
-					if(iter->second >= 0 && iter->second < (int)edges.size()){
-					//	get the edge
-						ConstrainingEdge* edge = dynamic_cast<ConstrainingEdge*>(edges[iter->second]);
-						if(edge){
-							ce->set_constraining_object(edge);
-							edge->add_constrained_object(ce);
-						}
-						else{
-							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring edge " << iter->second << ".\n");
-						}
-					}
-					else{
-						UG_LOG("ERROR in GridReaderUGX: Bad edge index in constrained edge.\n");
-					}
-				}break;
-				case 2:	// constraining object is an face
-				{
-				//	make sure that the index is valid
-					if(iter->second >= 0 && iter->second < (int)faces.size()){
-					//	get the edge
-						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
-						if(face){
-							ce->set_constraining_object(face);
-							face->add_constrained_object(ce);
-						}
-						else{
-							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
-						}
-					}
-					else{
-						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained edge: " << iter->second << "\n");
-					}
-				}break;
-				
-				default:
-				{
-//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining edge"
-//							<< " at " << GetGridObjectCenter(grid, ce) << "\n");
-					break;
-				}
-			}
-		}
-	}
-
-	if(!constrainingObjsTRI.empty()){
-	//	iterate over the pairs.
-	//	at the same time we'll iterate over the constrained vertices since
-	//	they are synchronized.
-		ConstrainedTriangleIterator cfIter = grid.begin<ConstrainedTriangle>();
-		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsTRI.begin();
-			iter != constrainingObjsTRI.end(); ++iter, ++cfIter)
-		{
-			ConstrainedFace* cdf = *cfIter;
-			
-			switch(iter->first){
-				case 2:	// constraining object is an face
-				{
-				//	make sure that the index is valid
-					if(iter->second >= 0 && iter->second < (int)faces.size()){
-					//	get the edge
-						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
-						if(face){
-							cdf->set_constraining_object(face);
-							face->add_constrained_object(cdf);
-						}
-						else{
-							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
-						}
-					}
-					else{
-						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained face: " << iter->second << "\n");
-					}
-				}break;
-				
-				default:
-				{
-//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining triangle"
-//							<< " at " << GetGridObjectCenter(grid, cdf) << "\n");
-					break;
-				}
-			}
-		}
-	}
-
-	if(!constrainingObjsQUAD.empty()){
-	//	iterate over the pairs.
-	//	at the same time we'll iterate over the constrained vertices since
-	//	they are synchronized.
-		ConstrainedQuadrilateralIterator cfIter = grid.begin<ConstrainedQuadrilateral>();
-		for(std::vector<std::pair<int, int> >::iterator iter = constrainingObjsQUAD.begin();
-			iter != constrainingObjsQUAD.end(); ++iter, ++cfIter)
-		{
-			ConstrainedFace* cdf = *cfIter;
-			
-			switch(iter->first){
-				case 2:	// constraining object is an face
-				{
-				//	make sure that the index is valid
-					if(iter->second >= 0 && iter->second < (int)faces.size()){
-					//	get the edge
-						ConstrainingFace* face = dynamic_cast<ConstrainingFace*>(faces[iter->second]);
-						if(face){
-							cdf->set_constraining_object(face);
-							face->add_constrained_object(cdf);
-						}
-						else{
-							UG_LOG("WARNING in GridReaderUGX: Type-ID / type mismatch. Ignoring face " << iter->second << ".\n");
-						}
-					}
-					else{
-						UG_LOG("ERROR in GridReaderUGX: Bad face index in constrained face: " << iter->second << "\n");
-					}
-				}break;
-				
-				default:
-				{
-//					UG_LOG("WARNING in GridReaderUGX: unsupported type-id of constraining quadrilateral"
-//							<< " at " << GetGridObjectCenter(grid, cdf) << "\n");
-					break;
-				}
-			}
-		}
-	}
+	resolve_constraining_objects(grid, edges, faces, constrainingObjsVRT,
+								 constrainingObjsEDGE, constrainingObjsTRI,
+								 constrainingObjsQUAD);
 
 //	reenable the grids options.
 	grid.set_options(gridopts);
@@ -907,6 +710,45 @@ create_constrained_vertices(std::vector<Vertex*>& vrtsOut,
 }
 
 
+template <class TPositionAttachment>
+bool GridReaderUGXStream::
+parse_file(const char* filename, Grid& gridOut, TPositionAttachment& aPos)
+{
+	typedef Grid::VertexAttachmentAccessor<TPositionAttachment>	TAAPos;
+
+//	Since we have to create all elements in the correct order and
+//	since we have to make sure that no elements are created in between,
+//	we'll first disable all grid-options and reenable them later on
+	uint gridopts = gridOut.get_options();
+	gridOut.set_options(GRIDOPT_NONE);
+
+	if(!gridOut.has_vertex_attachment(aPos))
+		gridOut.attach_to_vertices(aPos);
+
+	PositionWriter<TAAPos> posWriter(TAAPos(gridOut, aPos));
+	bool bSuccess = parse_stream(filename, gridOut, posWriter);
+
+//	reenable the grids options.
+	gridOut.set_options(gridopts);
+	return bSuccess;
+}
+
+template <class TAAPos>
+void GridReaderUGXStream::PositionWriter<TAAPos>::
+set(Vertex* vrt, const double* coords, int numCoords)
+{
+	typename TAAPos::ValueType& v = m_aaPos[vrt];
+	const int numDestCoords = (int)TAAPos::ValueType::Size;
+	const int minNumCoords = std::min(numCoords, numDestCoords);
+
+//	if numDestCoords < numCoords we'll ignore some coords,
+//	in the other case we'll add some 0's.
+	for(int i = 0; i < minNumCoords; ++i)
+		v[i] = coords[i];
+	for(int i = minNumCoords; i < numDestCoords; ++i)
+		v[i] = 0;
+}
+
 template <class TElem>
 bool GridReaderUGX::
 read_attachment(Grid& grid, rapidxml::xml_node<>* node)
@@ -0,0 +1,1233 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include "common/common.h"
+#include "file_io_ugx.h"
+
+using namespace std;
+using namespace rapidxml;
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+//	number parsing
+namespace
+{
+
+inline bool IsSpace(char c)
+{
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+const double g_pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+						  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+						  1e18, 1e19, 1e20, 1e21, 1e22};
+
+///	parses the number at p and returns the position behind it, or NULL on failure
+/**	Mantissas of up to 53 bits with decimal exponents in [-22, 22] are
+ *	converted by a single, correctly rounded multiplication or division.
+ *	All other numbers (and inf or nan) are passed to strtod.*/
+const char* ParseNumber(const char* p, const char* end, double& valOut)
+{
+	const char* start = p;
+	bool negative = false;
+	if(*p == '-'){
+		negative = true;
+		++p;
+	}
+	else if(*p == '+')
+		++p;
+
+	uint64 mantissa = 0;
+	int numDigits = 0;
+	int exp10 = 0;
+	bool truncated = false;
+	bool gotDigit = false;
+
+	for(; p < end && IsDigit(*p); ++p){
+		gotDigit = true;
+		if(numDigits < 19){
+			mantissa = mantissa * 10 + (*p - '0');
+			if(mantissa)
+				++numDigits;
+		}
+		else{
+			++exp10;
+			if(*p != '0')
+				truncated = true;
+		}
+	}
+
+	if(p < end && *p == '.'){
+		++p;
+		for(; p < end && IsDigit(*p); ++p){
+			gotDigit = true;
+			if(numDigits < 19){
+				mantissa = mantissa * 10 + (*p - '0');
+				if(mantissa)
+					++numDigits;
+				--exp10;
+			}
+			else if(*p != '0')
+				truncated = true;
+		}
+	}
+
+	if(gotDigit && p < end && (*p == 'e' || *p == 'E')){
+		const char* q = p + 1;
+		bool negativeExp = false;
+		if(q < end && (*q == '-' || *q == '+')){
+			negativeExp = (*q == '-');
+			++q;
+		}
+		if(q < end && IsDigit(*q)){
+			int e = 0;
+			for(; q < end && IsDigit(*q); ++q){
+				if(e < 10000)
+					e = e * 10 + (*q - '0');
+			}
+			exp10 += negativeExp ? -e : e;
+			p = q;
+		}
+	}
+
+	if(gotDigit && !truncated && (p == end || IsSpace(*p))
+	   && mantissa <= ((uint64)1 << 53) && exp10 >= -22 && exp10 <= 22)
+	{
+		double val = (double)mantissa;
+		if(exp10 < 0)
+			val /= g_pow10[-exp10];
+		else
+			val *= g_pow10[exp10];
+		valOut = negative ? -val : val;
+		return p;
+	}
+
+//	slow path
+	const char* tokenEnd = p;
+	while(tokenEnd < end && !IsSpace(*tokenEnd))
+		++tokenEnd;
+
+	size_t len = tokenEnd - start;
+	char buf[64];
+	string str;
+	const char* token = buf;
+	if(len < sizeof(buf)){
+		memcpy(buf, start, len);
+		buf[len] = 0;
+	}
+	else{
+		str.assign(start, len);
+		token = str.c_str();
+	}
+
+	char* parseEnd;
+	valOut = strtod(token, &parseEnd);
+	if(parseEnd != token + len)
+		return NULL;
+	return tokenEnd;
+}
+
+const char* ParseNumber(const char* p, const char* end, int& valOut)
+{
+	bool negative = false;
+	if(*p == '-'){
+		negative = true;
+		++p;
+	}
+	else if(*p == '+')
+		++p;
+
+	if(p == end || !IsDigit(*p))
+		return NULL;
+
+	long long val = 0;
+	for(; p < end && IsDigit(*p); ++p){
+		val = val * 10 + (*p - '0');
+		if(val > (long long)INT_MAX + 1)
+			return NULL;
+	}
+
+	if(p < end && !IsSpace(*p))
+		return NULL;
+
+	valOut = (int)(negative ? -val : val);
+	return p;
+}
+
+///	parses all whitespace separated numbers in [p, end) into valsOut
+template <class TValue>
+bool ParseNumbers(const char* p, const char* end, vector<TValue>& valsOut)
+{
+	valsOut.clear();
+	for(;;){
+		while(p < end && IsSpace(*p))
+			++p;
+		if(p == end)
+			return true;
+
+		TValue val;
+		p = ParseNumber(p, end, val);
+		if(!p)
+			return false;
+		valsOut.push_back(val);
+	}
+}
+
+///	parses the text ranges [bounds[i], bounds[i+1]) into vvals[i]
+template <class TValue>
+struct ParseNumbersRanges
+{
+	ParseNumbersRanges(const vector<const char*>& b, vector<vector<TValue> >& v,
+					   vector<char>& s)
+		: bounds(b), vvals(v), success(s)	{}
+
+	void operator()(size_t begin, size_t end, size_t) const
+	{
+		for(size_t i = begin; i < end; ++i)
+			success[i] = ParseNumbers(bounds[i], bounds[i + 1], vvals[i]);
+	}
+
+	const vector<const char*>&	bounds;
+	vector<vector<TValue> >&	vvals;
+	vector<char>&				success;
+};
+
+///	parses [begin, end) in up to vvals.size() contiguous ranges on the threads of team
+/**	Ranges are split at whitespace. The numbers of range i are written to
+ *	vvals[i], so that the concatenation of all vvals is in input order.*/
+template <class TValue>
+bool ParseNumbersParallel(ThreadTeam& team, const char* begin, const char* end,
+						  vector<vector<TValue> >& vvals)
+{
+	const size_t minRangeSize = 1 << 16;
+	size_t numRanges = min<size_t>(vvals.size(), (end - begin) / minRangeSize);
+	if(numRanges <= 1){
+		for(size_t i = 1; i < vvals.size(); ++i)
+			vvals[i].clear();
+		return ParseNumbers(begin, end, vvals[0]);
+	}
+
+	vector<const char*> bounds(numRanges + 1);
+	bounds[0] = begin;
+	bounds[numRanges] = end;
+	for(size_t i = 1; i < numRanges; ++i){
+		const char* p = max(bounds[i - 1], begin + i * (end - begin) / numRanges);
+		while(p < end && !IsSpace(*p))
+			++p;
+		bounds[i] = p;
+	}
+
+	vector<char> success(numRanges, 0);
+	team.run_ranges(numRanges, ParseNumbersRanges<TValue>(bounds, vvals, success));
+
+	for(size_t i = numRanges; i < vvals.size(); ++i)
+		vvals[i].clear();
+
+	for(size_t i = 0; i < numRanges; ++i){
+		if(!success[i])
+			return false;
+	}
+	return true;
+}
+
+///	returns the name of the element in a start-, end- or empty-element tag
+string TagName(const string& tag)
+{
+	size_t begin = (tag.size() > 1 && tag[1] == '/') ? 2 : 1;
+	size_t end = begin;
+	while(end < tag.size() && !IsSpace(tag[end]) && tag[end] != '/'
+		  && tag[end] != '>')
+	{
+		++end;
+	}
+	return tag.substr(begin, end - begin);
+}
+
+}//	end of anonymous namespace
+
+
+////////////////////////////////////////////////////////////////////////
+class GridReaderUGXStream::Tokenizer
+{
+	public:
+		enum MarkupType
+		{
+			MT_START,
+			MT_END,
+			MT_EMPTY,
+			MT_OTHER,
+			MT_EOF
+		};
+
+		Tokenizer(size_t bufSize) :
+			m_buf(max<size_t>(bufSize, 1024)),
+			m_pos(0),
+			m_end(0),
+			m_eof(false)
+		{}
+
+		bool open(const char* filename)
+		{
+			m_in.open(filename, ios::binary);
+			return (bool)m_in;
+		}
+
+	///	reads the next markup (tag, comment, processing instruction, ...) into markup
+	/**	The text in front of the markup is skipped. If raw is specified,
+	 *	the skipped text and the markup are appended to it.*/
+		MarkupType next_markup(string& markup, string* raw = NULL)
+		{
+		//	skip text
+			for(;;){
+				if(m_pos == m_end && !refill())
+					return MT_EOF;
+				const char* b = &m_buf.front() + m_pos;
+				const char* lt = (const char*)memchr(b, '<', m_end - m_pos);
+				size_t num = lt ? lt - b : m_end - m_pos;
+				if(raw)
+					raw->append(b, num);
+				m_pos += num;
+				if(lt)
+					break;
+			}
+
+			markup.clear();
+			markup.push_back(get());
+
+			int c = get();
+			if(c < 0)
+				return MT_EOF;
+			markup.push_back((char)c);
+
+			MarkupType type;
+			bool complete;
+			if(c == '!'){
+			//	comment, CDATA section or document type declaration
+				while(markup.size() < 4 && (c = get()) >= 0)
+					markup.push_back((char)c);
+
+				if(markup == "<!--")
+					complete = read_until(markup, "-->");
+				else if(markup.compare(0, 3, "<![") == 0)
+					complete = read_until(markup, "]]>");
+				else
+					complete = read_until(markup, ">");
+				type = MT_OTHER;
+			}
+			else if(c == '?'){
+				complete = read_until(markup, "?>");
+				type = MT_OTHER;
+			}
+			else{
+			//	read the tag. '>' may only be contained in quoted attribute values.
+				char quote = 0;
+				complete = false;
+				while((c = get()) >= 0){
+					markup.push_back((char)c);
+					if(quote){
+						if(c == quote)
+							quote = 0;
+					}
+					else if(c == '"' || c == '\'')
+						quote = (char)c;
+					else if(c == '>'){
+						complete = true;
+						break;
+					}
+				}
+
+				if(markup[1] == '/')
+					type = MT_END;
+				else if(markup.size() > 2 && markup[markup.size() - 2] == '/')
+					type = MT_EMPTY;
+				else
+					type = MT_START;
+			}
+
+			if(!complete)
+				return MT_EOF;
+
+			if(raw)
+				raw->append(markup);
+			return type;
+		}
+
+	///	returns the next start-, end- or empty-element tag. Other markup is skipped.
+		MarkupType next_tag(string& tag)
+		{
+			MarkupType type;
+			do{
+				type = next_markup(tag);
+			}while(type == MT_OTHER);
+			return type;
+		}
+
+	///	skips the remainder of the current element, including its end tag
+	/**	If raw is specified, everything is appended to it.*/
+		bool skip_element(string* raw = NULL)
+		{
+			string markup;
+			int depth = 1;
+			for(;;){
+				switch(next_markup(markup, raw)){
+					case MT_START:	++depth; break;
+					case MT_END:	if(--depth == 0) return true; break;
+					case MT_EOF:	return false;
+					default:		break;
+				}
+			}
+		}
+
+	///	returns the next part of the text in front of the next markup
+	/**	The returned range is only valid until the next call to the tokenizer.
+	 *	Parts end at whitespace, so that no number is split. Returns false if
+	 *	the next markup or the end of the file is reached.*/
+		bool next_text(const char*& beginOut, const char*& endOut)
+		{
+			if(m_end - m_pos < m_buf.size() / 2)
+				refill();
+
+			for(;;){
+				if(m_pos == m_end)
+					return false;
+
+				const char* b = &m_buf.front() + m_pos;
+				const char* e = &m_buf.front() + m_end;
+				const char* lt = (const char*)memchr(b, '<', e - b);
+				if(lt){
+					if(lt == b)
+						return false;
+					e = lt;
+				}
+				else if(!m_eof){
+				//	the last token may continue in the part of the file
+				//	which wasn't read yet.
+					while(e > b && !IsSpace(e[-1]))
+						--e;
+					if(e == b){
+						refill();
+						continue;
+					}
+				}
+
+				beginOut = b;
+				endOut = e;
+				m_pos += e - b;
+				return true;
+			}
+		}
+
+	private:
+		int get()
+		{
+			if(m_pos == m_end && !refill())
+				return -1;
+			return (unsigned char)m_buf[m_pos++];
+		}
+
+	///	appends characters to str until it ends with term
+		bool read_until(string& str, const char* term)
+		{
+			size_t termLen = strlen(term);
+			for(;;){
+				if(str.size() >= termLen
+				   && str.compare(str.size() - termLen, termLen, term) == 0)
+				{
+					return true;
+				}
+
+				int c = get();
+				if(c < 0)
+					return false;
+				str.push_back((char)c);
+			}
+		}
+
+	///	moves unread data to the front of the buffer and fills the remainder from the file
+	/**	The buffer is enlarged if it is completely filled with unread data.
+	 *	Returns true if unread data is available.*/
+		bool refill()
+		{
+			if(m_eof)
+				return m_pos < m_end;
+
+			size_t numRemaining = m_end - m_pos;
+			if(m_pos > 0){
+				memmove(&m_buf.front(), &m_buf.front() + m_pos, numRemaining);
+				m_pos = 0;
+				m_end = numRemaining;
+			}
+
+			if(m_end == m_buf.size())
+				m_buf.resize(2 * m_buf.size());
+
+			m_in.read(&m_buf.front() + m_end, m_buf.size() - m_end);
+			m_end += m_in.gcount();
+			if(!m_in)
+				m_eof = true;
+
+			return m_pos < m_end;
+		}
+
+		ifstream		m_in;
+		vector<char>	m_buf;
+		size_t			m_pos;
+		size_t			m_end;
+		bool			m_eof;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//	consumers of parsed numbers
+namespace
+{
+
+template <class TValue>
+struct AppendNumbers
+{
+	AppendNumbers(vector<TValue>& v) : vals(v)	{}
+
+	bool operator()(const TValue* v, size_t num)
+	{
+		vals.insert(vals.end(), v, v + num);
+		return true;
+	}
+
+	vector<TValue>& vals;
+};
+
+}//	end of anonymous namespace
+
+
+////////////////////////////////////////////////////////////////////////
+//	implementation of GridReaderUGXStream
+size_t GridReaderUGXStream::s_defaultNumThreads = 1;
+
+GridReaderUGXStream::GridReaderUGXStream() :
+	m_team(s_defaultNumThreads),
+	m_bufSize(1 << 24)
+{
+}
+
+GridReaderUGXStream::~GridReaderUGXStream()
+{
+}
+
+void GridReaderUGXStream::set_num_threads(size_t numThreads)
+{
+	m_team.set_num_threads(numThreads);
+}
+
+void GridReaderUGXStream::set_default_num_threads(size_t numThreads)
+{
+	s_defaultNumThreads = max<size_t>(numThreads, 1);
+}
+
+void GridReaderUGXStream::set_buffer_size(size_t bufSize)
+{
+	m_bufSize = bufSize;
+}
+
+template <class TValue, class TConsumer>
+bool GridReaderUGXStream::
+read_numbers(Tokenizer& tok, TConsumer& consumer)
+{
+	vector<vector<TValue> > vvals(m_team.num_threads());
+	string markup;
+	const char* begin;
+	const char* end;
+
+	for(;;){
+		while(tok.next_text(begin, end)){
+			if(!ParseNumbersParallel(m_team, begin, end, vvals)){
+				UG_LOG("ERROR in GridReaderUGXStream: Invalid number in '"
+						<< string(begin, min<size_t>(end - begin, 64))
+						<< "...'\n");
+				return false;
+			}
+
+			for(size_t i = 0; i < vvals.size(); ++i){
+				if(!vvals[i].empty()
+				   && !consumer(&vvals[i].front(), vvals[i].size()))
+				{
+					return false;
+				}
+			}
+		}
+
+		switch(tok.next_markup(markup)){
+			case Tokenizer::MT_END:
+				return true;
+			case Tokenizer::MT_OTHER:
+				break;
+			case Tokenizer::MT_EOF:
+				UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+				return false;
+			default:
+				UG_LOG("ERROR in GridReaderUGXStream: Unexpected element '"
+						<< TagName(markup) << "' in list of numbers.\n");
+				return false;
+		}
+	}
+}
+
+xml_node<>* GridReaderUGXStream::
+tag_to_node(const string& tag)
+{
+//	parse the tag as an empty element into a temporary document and
+//	clone the result into m_doc. The string is allocated in m_doc, so
+//	that names and values stay valid.
+	string emptyTag = tag;
+	if(emptyTag.size() < 2 || emptyTag[emptyTag.size() - 2] != '/')
+		emptyTag.insert(emptyTag.size() - 1, "/");
+	return string_to_node(emptyTag);
+}
+
+xml_node<>* GridReaderUGXStream::
+string_to_node(const string& str)
+{
+	char* buf = m_doc.allocate_string(str.c_str(), str.size() + 1);
+	try{
+		xml_document<> doc;
+		doc.parse<0>(buf);
+		if(xml_node<>* node = doc.first_node())
+			return m_doc.clone_node(node);
+	}
+	catch(rapidxml::parse_error& e){
+		UG_LOG("ERROR in GridReaderUGXStream: " << e.what() << "\n");
+	}
+	return NULL;
+}
+
+bool GridReaderUGXStream::
+parse_stream(const char* filename, Grid& grid, IPositionWriter& posWriter)
+{
+	m_doc.clear();
+	m_entries.clear();
+	m_subsetElems.clear();
+
+	Tokenizer tok(m_bufSize);
+	if(!tok.open(filename))
+		return false;
+
+	string tag;
+	for(;;){
+		Tokenizer::MarkupType type = tok.next_tag(tag);
+		if(type == Tokenizer::MT_EOF)
+			break;
+
+		if(type == Tokenizer::MT_END)
+			continue;
+
+		if(m_entries.empty() && TagName(tag) == "grid"){
+			xml_node<>* gridNode = tag_to_node(tag);
+			if(!gridNode)
+				return false;
+			m_doc.append_node(gridNode);
+			m_entries.push_back(GridEntry(gridNode));
+			m_entries.back().grid = &grid;
+
+			if(type == Tokenizer::MT_START
+			   && !read_grid(tok, grid, posWriter, gridNode))
+			{
+				return false;
+			}
+		}
+		else if(type == Tokenizer::MT_START && !tok.skip_element()){
+			UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GridReaderUGXStream::
+read_grid(Tokenizer& tok, Grid& grid, IPositionWriter& posWriter,
+		  xml_node<>* gridNode)
+{
+	GridEntry& gridEntry = m_entries.back();
+
+//	we'll record constraining objects for constrained-vertices and constrained-edges
+	vector<pair<int, int> > constrainingObjsVRT;
+	vector<pair<int, int> > constrainingObjsEDGE;
+	vector<pair<int, int> > constrainingObjsTRI;
+	vector<pair<int, int> > constrainingObjsQUAD;
+
+	static const char* elemBlockNames[] = {
+		"edges", "constraining_edges", "constrained_edges",
+		"triangles", "constraining_triangles", "constrained_triangles",
+		"quadrilaterals", "constraining_quadrilaterals",
+		"constrained_quadrilaterals", "tetrahedrons", "hexahedrons",
+		"prisms", "pyramids", "octahedrons"};
+
+	string tag;
+	for(;;){
+		Tokenizer::MarkupType type = tok.next_tag(tag);
+		if(type == Tokenizer::MT_EOF){
+			UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+			return false;
+		}
+
+		if(type == Tokenizer::MT_END)
+			break;
+
+		const bool empty = (type == Tokenizer::MT_EMPTY);
+		const string name = TagName(tag);
+
+		ElementBlockType blockType = EBT_NONE;
+		for(int i = 0; i < EBT_NONE; ++i){
+			if(name == elemBlockNames[i]){
+				blockType = (ElementBlockType)i;
+				break;
+			}
+		}
+
+		bool bSuccess = true;
+		if(name == "vertices" || name == "constrained_vertices"){
+			xml_node<>* vrtNode = tag_to_node(tag);
+			int numSrcCoords = -1;
+			if(vrtNode){
+				if(xml_attribute<>* attrib = vrtNode->first_attribute("coords"))
+					numSrcCoords = atoi(attrib->value());
+			}
+
+			if(numSrcCoords < 1){
+				UG_LOG("ERROR in GridReaderUGXStream: Invalid number of coordinates"
+						" in vertex node.\n");
+				return false;
+			}
+
+			if(!empty){
+				bSuccess = read_vertices(tok, grid, posWriter, numSrcCoords,
+										 name == "constrained_vertices",
+										 gridEntry.vertices,
+										 constrainingObjsVRT);
+			}
+		}
+		else if(blockType != EBT_NONE){
+			vector<pair<int, int> >* constrainingObjs = NULL;
+			switch(blockType){
+				case EBT_CONSTRAINED_EDGE:
+					constrainingObjs = &constrainingObjsEDGE; break;
+				case EBT_CONSTRAINED_TRIANGLE:
+					constrainingObjs = &constrainingObjsTRI; break;
+				case EBT_CONSTRAINED_QUADRILATERAL:
+					constrainingObjs = &constrainingObjsQUAD; break;
+				default:
+					break;
+			}
+
+			if(!empty)
+				bSuccess = read_elements(tok, grid, blockType, gridEntry,
+										 constrainingObjs);
+		}
+		else if(name == "subset_handler"){
+			xml_node<>* shNode = tag_to_node(tag);
+			if(!shNode)
+				return false;
+			gridNode->append_node(shNode);
+			gridEntry.subsetHandlerEntries.push_back(SubsetHandlerEntry(shNode));
+			m_subsetElems.push_back(vector<SubsetElements>());
+
+			if(!empty)
+				bSuccess = read_subset_handler(tok, shNode);
+		}
+		else if(name == "selector" || name == "projection_handler"){
+			string raw = tag;
+			if(!empty && !tok.skip_element(&raw)){
+				UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+				return false;
+			}
+
+			xml_node<>* node = string_to_node(raw);
+			if(!node)
+				return false;
+			gridNode->append_node(node);
+
+			if(name == "selector")
+				gridEntry.selectorEntries.push_back(SelectorEntry(node));
+			else
+				gridEntry.projectionHandlerEntries.push_back(node);
+		}
+		else if(name == "vertex_attachment" || name == "edge_attachment"
+				|| name == "face_attachment" || name == "volume_attachment")
+		{
+		//	attachments are parsed through a temporary document, which is
+		//	released right after the values were read.
+			string raw = tag;
+			if(!empty && !tok.skip_element(&raw)){
+				UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+				return false;
+			}
+
+			raw.push_back(0);
+			xml_document<> doc;
+			try{
+				doc.parse<0>(&raw[0]);
+			}
+			catch(rapidxml::parse_error& e){
+				UG_LOG("ERROR in GridReaderUGXStream: " << e.what() << "\n");
+				return false;
+			}
+
+			xml_node<>* node = doc.first_node();
+			if(name == "vertex_attachment")
+				bSuccess = read_attachment<Vertex>(grid, node);
+			else if(name == "edge_attachment")
+				bSuccess = read_attachment<Edge>(grid, node);
+			else if(name == "face_attachment")
+				bSuccess = read_attachment<Face>(grid, node);
+			else
+				bSuccess = read_attachment<Volume>(grid, node);
+		}
+		else if(!empty && !tok.skip_element()){
+			UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+			return false;
+		}
+
+		if(!bSuccess)
+			return false;
+	}
+
+//	resolve constrained object relations
+	resolve_constraining_objects(grid, gridEntry.edges, gridEntry.faces,
+								 constrainingObjsVRT, constrainingObjsEDGE,
+								 constrainingObjsTRI, constrainingObjsQUAD);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///	creates regular or constrained vertices from a stream of numbers
+class GridReaderUGXStream::VertexCreator
+{
+	public:
+		VertexCreator(Grid& grid, IPositionWriter& posWriter,
+					  int numSrcCoords, bool constrained,
+					  vector<Vertex*>& vrtsOut,
+					  vector<pair<int, int> >& constrainingObjsOut) :
+			m_grid(grid), m_posWriter(posWriter), m_numSrcCoords(numSrcCoords),
+			m_constrained(constrained), m_vrts(vrtsOut),
+			m_constrainingObjs(constrainingObjsOut)
+		{}
+
+		bool operator()(const double* vals, size_t num)
+		{
+			size_t i = 0;
+			if(!m_constrained){
+			//	complete the tuple of the last call
+				for(; i < num && !m_tuple.empty(); ++i){
+					m_tuple.push_back(vals[i]);
+					if((int)m_tuple.size() == m_numSrcCoords){
+						create_vertex(&m_tuple.front());
+						m_tuple.clear();
+					}
+				}
+
+				for(; i + m_numSrcCoords <= num; i += m_numSrcCoords)
+					create_vertex(vals + i);
+			}
+			else{
+			//	the number of values per vertex depends on the type of the
+			//	constraining object: coords, type, [index], [local coords]
+				for(; i < num; ++i){
+					m_tuple.push_back(vals[i]);
+					const int nc = m_numSrcCoords;
+					if((int)m_tuple.size() <= nc)
+						continue;
+
+					int conObjType = (int)m_tuple[nc];
+					size_t tupleSize = nc + 1;
+					if(conObjType != -1)
+						++tupleSize;
+					if(conObjType == 1)
+						tupleSize += 1;
+					else if(conObjType == 2)
+						tupleSize += 2;
+
+					if(m_tuple.size() == tupleSize){
+						ConstrainedVertex* vrt = *m_grid.create<ConstrainedVertex>();
+						m_vrts.push_back(vrt);
+						m_posWriter.set(vrt, &m_tuple.front(), nc);
+
+						int conObjIndex = -1;
+						number localCoords[2] = {0, 0};
+						if(conObjType != -1)
+							conObjIndex = (int)m_tuple[nc + 1];
+						if(conObjType == 1 || conObjType == 2)
+							localCoords[0] = m_tuple[nc + 2];
+						if(conObjType == 2)
+							localCoords[1] = m_tuple[nc + 3];
+
+						vrt->set_local_coordinates(localCoords[0], localCoords[1]);
+						m_constrainingObjs.push_back(make_pair(conObjType, conObjIndex));
+						m_tuple.clear();
+					}
+				}
+			}
+
+			m_tuple.insert(m_tuple.end(), vals + i, vals + num);
+			return true;
+		}
+
+	private:
+		void create_vertex(const double* coords)
+		{
+			RegularVertex* vrt = *m_grid.create<RegularVertex>();
+			m_vrts.push_back(vrt);
+			m_posWriter.set(vrt, coords, m_numSrcCoords);
+		}
+
+		Grid&									m_grid;
+		IPositionWriter&	m_posWriter;
+		int										m_numSrcCoords;
+		bool									m_constrained;
+		vector<Vertex*>&						m_vrts;
+		vector<pair<int, int> >&				m_constrainingObjs;
+		vector<double>							m_tuple;
+};
+
+bool GridReaderUGXStream::
+read_vertices(Tokenizer& tok, Grid& grid, IPositionWriter& posWriter,
+			  int numSrcCoords, bool constrained, vector<Vertex*>& vrtsOut,
+			  vector<pair<int, int> >& constrainingObjsOut)
+{
+	VertexCreator creator(grid, posWriter, numSrcCoords, constrained, vrtsOut,
+						  constrainingObjsOut);
+	return read_numbers<double>(tok, creator);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///	creates elements of one type from a stream of vertex indices
+class GridReaderUGXStream::ElementCreator
+{
+	public:
+		ElementCreator(Grid& grid, int type, int numVrts, bool constrained,
+					   vector<Vertex*>& vrts, vector<Edge*>& edges,
+					   vector<Face*>& faces, vector<Volume*>& vols,
+					   vector<pair<int, int> >* constrainingObjs) :
+			m_grid(grid), m_type(type), m_numVrts(numVrts),
+			m_constrained(constrained), m_vrts(vrts), m_edges(edges),
+			m_faces(faces), m_vols(vols), m_constrainingObjs(constrainingObjs),
+			m_tupleSize(0)
+		{}
+
+		bool operator()(const int* vals, size_t num)
+		{
+			for(size_t i = 0; i < num; ++i){
+				m_tuple[m_tupleSize++] = vals[i];
+				if(m_tupleSize < m_numVrts)
+					continue;
+
+				if(m_constrained){
+				//	vertex indices, type of constraining object and its index,
+				//	if the type is not -1.
+					if(m_tupleSize == m_numVrts
+					   || (m_tupleSize == m_numVrts + 1 && m_tuple[m_numVrts] != -1))
+					{
+						continue;
+					}
+				}
+
+				if(!create_element())
+					return false;
+				m_tupleSize = 0;
+			}
+			return true;
+		}
+
+	private:
+		bool create_element()
+		{
+			Vertex* v[8];
+			const int maxInd = (int)m_vrts.size() - 1;
+			for(int i = 0; i < m_numVrts; ++i){
+				if(m_tuple[i] < 0 || m_tuple[i] > maxInd){
+					UG_LOG("ERROR in GridReaderUGXStream: Invalid vertex index: "
+							<< m_tuple[i] << "\n");
+					return false;
+				}
+				v[i] = m_vrts[m_tuple[i]];
+			}
+
+			switch(m_type){
+				case EBT_EDGE:
+					m_edges.push_back(*m_grid.create<RegularEdge>(
+											EdgeDescriptor(v[0], v[1])));
+					break;
+				case EBT_CONSTRAINING_EDGE:
+					m_edges.push_back(*m_grid.create<ConstrainingEdge>(
+											EdgeDescriptor(v[0], v[1])));
+					break;
+				case EBT_CONSTRAINED_EDGE:
+					m_edges.push_back(*m_grid.create<ConstrainedEdge>(
+											EdgeDescriptor(v[0], v[1])));
+					break;
+				case EBT_TRIANGLE:
+					m_faces.push_back(*m_grid.create<Triangle>(
+											TriangleDescriptor(v[0], v[1], v[2])));
+					break;
+				case EBT_CONSTRAINING_TRIANGLE:
+					m_faces.push_back(*m_grid.create<ConstrainingTriangle>(
+											TriangleDescriptor(v[0], v[1], v[2])));
+					break;
+				case EBT_CONSTRAINED_TRIANGLE:
+					m_faces.push_back(*m_grid.create<ConstrainedTriangle>(
+											TriangleDescriptor(v[0], v[1], v[2])));
+					break;
+				case EBT_QUADRILATERAL:
+					m_faces.push_back(*m_grid.create<Quadrilateral>(
+								QuadrilateralDescriptor(v[0], v[1], v[2], v[3])));
+					break;
+				case EBT_CONSTRAINING_QUADRILATERAL:
+					m_faces.push_back(*m_grid.create<ConstrainingQuadrilateral>(
+								QuadrilateralDescriptor(v[0], v[1], v[2], v[3])));
+					break;
+				case EBT_CONSTRAINED_QUADRILATERAL:
+					m_faces.push_back(*m_grid.create<ConstrainedQuadrilateral>(
+								QuadrilateralDescriptor(v[0], v[1], v[2], v[3])));
+					break;
+				case EBT_TETRAHEDRON:
+					m_vols.push_back(*m_grid.create<Tetrahedron>(
+								TetrahedronDescriptor(v[0], v[1], v[2], v[3])));
+					break;
+				case EBT_HEXAHEDRON:
+					m_vols.push_back(*m_grid.create<Hexahedron>(
+								HexahedronDescriptor(v[0], v[1], v[2], v[3],
+													 v[4], v[5], v[6], v[7])));
+					break;
+				case EBT_PRISM:
+					m_vols.push_back(*m_grid.create<Prism>(
+								PrismDescriptor(v[0], v[1], v[2], v[3], v[4], v[5])));
+					break;
+				case EBT_PYRAMID:
+					m_vols.push_back(*m_grid.create<Pyramid>(
+								PyramidDescriptor(v[0], v[1], v[2], v[3], v[4])));
+					break;
+				case EBT_OCTAHEDRON:
+					m_vols.push_back(*m_grid.create<Octahedron>(
+								OctahedronDescriptor(v[0], v[1], v[2], v[3],
+													 v[4], v[5])));
+					break;
+				default:
+					return false;
+			}
+
+			if(m_constrained){
+				int conObjType = m_tuple[m_numVrts];
+				int conObjIndex = (conObjType != -1) ? m_tuple[m_numVrts + 1] : -1;
+				m_constrainingObjs->push_back(make_pair(conObjType, conObjIndex));
+			}
+			return true;
+		}
+
+		Grid&						m_grid;
+		int							m_type;
+		int							m_numVrts;
+		bool						m_constrained;
+		vector<Vertex*>&			m_vrts;
+		vector<Edge*>&				m_edges;
+		vector<Face*>&				m_faces;
+		vector<Volume*>&			m_vols;
+		vector<pair<int, int> >*	m_constrainingObjs;
+		int							m_tuple[10];
+		int							m_tupleSize;
+};
+
+bool GridReaderUGXStream::
+read_elements(Tokenizer& tok, Grid& grid, ElementBlockType type,
+			  GridEntry& gridEntry, vector<pair<int, int> >* constrainingObjs)
+{
+	static const int numVrts[] = {2, 2, 2, 3, 3, 3, 4, 4, 4, 4, 8, 6, 5, 6};
+
+	ElementCreator creator(grid, type, numVrts[type], constrainingObjs != NULL,
+						   gridEntry.vertices, gridEntry.edges, gridEntry.faces,
+						   gridEntry.volumes, constrainingObjs);
+	return read_numbers<int>(tok, creator);
+}
+
+bool GridReaderUGXStream::
+read_subset_handler(Tokenizer& tok, xml_node<>* shNode)
+{
+	static const char* elemNodeNames[] = {"vertices", "edges", "faces", "volumes"};
+
+	vector<SubsetElements>& subsets = m_subsetElems.back();
+	string tag;
+	for(;;){
+		Tokenizer::MarkupType type = tok.next_tag(tag);
+		if(type == Tokenizer::MT_EOF){
+			UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+			return false;
+		}
+
+		if(type == Tokenizer::MT_END)
+			return true;
+
+		if(TagName(tag) != "subset"){
+			if(type == Tokenizer::MT_START && !tok.skip_element())
+				return false;
+			continue;
+		}
+
+		xml_node<>* subsetNode = tag_to_node(tag);
+		if(!subsetNode)
+			return false;
+		shNode->append_node(subsetNode);
+		subsets.push_back(SubsetElements());
+
+		if(type == Tokenizer::MT_EMPTY)
+			continue;
+
+	//	read the element indices of the subset
+		for(;;){
+			type = tok.next_tag(tag);
+			if(type == Tokenizer::MT_EOF){
+				UG_LOG("ERROR in GridReaderUGXStream: Unexpected end of file.\n");
+				return false;
+			}
+
+			if(type == Tokenizer::MT_END)
+				break;
+
+			if(type == Tokenizer::MT_EMPTY)
+				continue;
+
+			const string name = TagName(tag);
+			int baseType = -1;
+			for(int i = 0; i < 4; ++i){
+				if(name == elemNodeNames[i])
+					baseType = i;
+			}
+
+			if(baseType >= 0){
+				AppendNumbers<int> append(subsets.back().inds[baseType]);
+				if(!read_numbers<int>(tok, append))
+					return false;
+			}
+			else if(!tok.skip_element())
+				return false;
+		}
+	}
+}
+
+
+namespace
+{
+
+template <class TElem>
+bool AssignSubsetElements(ISubsetHandler& shOut, int subsetIndex,
+						  const vector<int>& inds, vector<TElem*>& vElems)
+{
+	for(size_t i = 0; i < inds.size(); ++i){
+		if(inds[i] < 0 || inds[i] >= (int)vElems.size()){
+			UG_LOG("Bad element index in subset-node: " << inds[i]
+					<< ". Ignoring element.\n");
+			return false;
+		}
+		shOut.assign_subset(vElems[inds[i]], subsetIndex);
+	}
+	return true;
+}
+
+}//	end of anonymous namespace
+
+bool GridReaderUGXStream::
+subset_handler(ISubsetHandler& shOut, size_t subsetHandlerIndex,
+			   size_t refGridIndex)
+{
+//	access the referred grid-entry
+	if(refGridIndex >= m_entries.size()){
+		UG_LOG("GridReaderUGXStream::subset_handler: bad refGridIndex. Aborting.\n");
+		return false;
+	}
+
+	GridEntry& gridEntry = m_entries[refGridIndex];
+
+//	get the referenced subset-handler entry
+	if(subsetHandlerIndex >= gridEntry.subsetHandlerEntries.size()){
+		UG_LOG("GridReaderUGXStream::subset_handler: bad subsetHandlerIndex. Aborting.\n");
+		return false;
+	}
+
+	SubsetHandlerEntry& shEntry = gridEntry.subsetHandlerEntries[subsetHandlerIndex];
+	shEntry.sh = &shOut;
+
+	vector<SubsetElements>& subsets = m_subsetElems[subsetHandlerIndex];
+
+	xml_node<>* subsetNode = shEntry.node->first_node("subset");
+	for(int subsetInd = 0; subsetNode;
+		subsetNode = subsetNode->next_sibling("subset"), ++subsetInd)
+	{
+		read_subset_info(shOut, subsetInd, subsetNode);
+
+		SubsetElements& elems = subsets[subsetInd];
+		if(shOut.elements_are_supported(SHE_VERTEX)
+		   && !AssignSubsetElements(shOut, subsetInd, elems.inds[0],
+									gridEntry.vertices))
+		{
+			return false;
+		}
+		if(shOut.elements_are_supported(SHE_EDGE)
+		   && !AssignSubsetElements(shOut, subsetInd, elems.inds[1],
+									gridEntry.edges))
+		{
+			return false;
+		}
+		if(shOut.elements_are_supported(SHE_FACE)
+		   && !AssignSubsetElements(shOut, subsetInd, elems.inds[2],
+									gridEntry.faces))
+		{
+			return false;
+		}
+		if(shOut.elements_are_supported(SHE_VOLUME)
+		   && !AssignSubsetElements(shOut, subsetInd, elems.inds[3],
+									gridEntry.volumes))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}//	end of namespace
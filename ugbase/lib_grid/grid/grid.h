@@ -433,6 +433,25 @@ class UG_API Grid
 		template <class TGeomObj>
 		void clear();
 
+	////////////////////////////////////////////////
+	//	element order
+	///	Changes the order in which elements are stored in the grid.
+	/**	All elements in the range [iterBegin, iterEnd) are moved to the end of
+	 * their section in the element storage, in the order in which they appear
+	 * in the range. If the range contains all elements of the given base type,
+	 * the storage order equals the order of the range afterwards.
+	 * Attached data is reordered accordingly, so that data of consecutively
+	 * stored elements lies consecutively in memory.
+	 *
+	 * Note that only the storage of the grid itself is affected. The orders
+	 * of elements in subset handlers, selectors or in the levels of a MultiGrid
+	 * are not changed.
+	 *
+	 * TElem has to be a base object type (Vertex, Edge, Face or Volume) and each
+	 * element may only appear once in the range.*/
+		template <class TElem, class TIterator>
+		void reorder_elements(TIterator iterBegin, TIterator iterEnd);
+
 	////////////////////////////////////////////////
 	//	replace
 	///	Replace vrtOld with vrtNew.
@@ -157,6 +157,24 @@ void Grid::clear()
 		erase(*begin<TGeomObj>());
 }
 
+template <class TElem, class TIterator>
+void Grid::reorder_elements(TIterator iterBegin, TIterator iterEnd)
+{
+	STATIC_ASSERT(geometry_traits<TElem>::CONTAINER_SECTION == -1,
+				  reorder_elements_requires_base_object_type);
+
+	typename traits<TElem>::ElementStorage& storage = element_storage<TElem>();
+
+//	erasing and reinserting an element moves it to the end of its section
+	for(TIterator iter = iterBegin; iter != iterEnd; ++iter){
+		TElem* e = *iter;
+		storage.m_sectionContainer.erase(get_iterator(e), e->container_section());
+		storage.m_sectionContainer.insert(e, e->container_section());
+	}
+
+	storage.m_attachmentPipe.align_data_with_elements();
+}
+
 ////////////////////////////////////////////////////////////////////////
 //	Iterators
 template <class TGeomObj>
@@ -32,6 +32,7 @@
 
 #include <sstream>
 #include "common/static_assert.h"
+#include "common/util/buffer_compression.h"
 #include "common/util/table.h"
 #include "distribution.h"
 #include "distributed_grid.h"
@@ -43,6 +44,7 @@
 #include "parallelization_util.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/global_attachments.h"
+#include "pcl/pcl_buffer_exchange.h"
 
 //#define LG_DISTRIBUTION_DEBUG
 //#define LG_DISTRIBUTION_Z_OUTPUT_TRANSFORM 40
@@ -1804,7 +1806,8 @@ bool DistributeGrid(MultiGrid& mg,
 					GridDataSerializationHandler& serializer,
 					bool createVerticalInterfaces,
 					const std::vector<int>* processMap,
-					const pcl::ProcessCommunicator& procComm)
+					const pcl::ProcessCommunicator& procComm,
+					bool compressData)
 {
 	GDIST_PROFILE_FUNC();
 	PCL_DEBUG_BARRIER(procComm);
@@ -1949,9 +1952,18 @@ bool DistributeGrid(MultiGrid& mg,
 	mg.attach_to_all(aLocalInd);
 	MultiElementAttachmentAccessor<AInt> aaInt(mg, aLocalInd);
 
-//	outBufs will be used to serialize and distribute the grid.
-//	don't resize outBufs later on! Would be expensive!
-	std::vector<BinaryBuffer> outBufs(sendToRanks.size());
+//	Each buffer is sent as soon as it is serialized, so that the transfer
+//	overlaps with the serialization of the remaining partitions. Receives are
+//	posted right away, so that incoming data arrives during serialization.
+	pcl::BufferExchange bufferExchange(procComm);
+	{
+		vector<int> recvFromRemoteRanks;
+		for(size_t i = 0; i < recvFromRanks.size(); ++i){
+			if(recvFromRanks[i] != pcl::ProcRank())
+				recvFromRemoteRanks.push_back(recvFromRanks[i]);
+		}
+		bufferExchange.post_receives(recvFromRemoteRanks);
+	}
 
 //	the magic number is used for debugging to make sure that the stream is read correctly
 	int magicNumber1 = 75234587;
@@ -1976,7 +1988,11 @@ bool DistributeGrid(MultiGrid& mg,
 	//	don't serialize the local partition since we'll keep it here on the local
 	//	process anyways.
 		if(!localPartition){
-			BinaryBuffer& out = outBufs[i_to];
+			BinaryBuffer out;
+
+		//	the first byte tells whether the remaining data is compressed
+			char compressed = 0;
+			out.write(&compressed, 1);
 
 		//	write a magic number for debugging purposes
 			out.write((char*)&magicNumber1, sizeof(int));
@@ -2000,29 +2016,21 @@ bool DistributeGrid(MultiGrid& mg,
 
 		//	write a magic number for debugging purposes
 			out.write((char*)&magicNumber2, sizeof(int));
-		}
-	}
-	PCL_DEBUG_BARRIER(procComm);
-	GDIST_PROFILE_END();
-
-
 
-////////////////////////////////
-//	COMMUNICATE SERIALIZED DATA
-	GDIST_PROFILE(gdist_CommunicateSerializedData);
-	UG_DLOG(LG_DIST, 2, "dist-DistributeGrid: Distribute data\n");
-//	now distribute the packs between involved processes
-	std::vector<BinaryBuffer> inBufs(recvFromRanks.size());
-
-	procComm.distribute_data(GetDataPtr(inBufs), GetDataPtr(recvFromRanks),
-							(int)recvFromRanks.size(),
-							GetDataPtr(outBufs), GetDataPtr(sendToRanks),
-							(int)sendToRanks.size());
-
-//	clear out-buffers, since they are no longer needed
-	for(size_t i = 0; i < outBufs.size(); ++i)
-		outBufs[i] = BinaryBuffer();
+			if(compressData){
+				GDIST_PROFILE(gdist_Compression);
+				BinaryBuffer compressedOut;
+				compressed = 1;
+				compressedOut.write(&compressed, 1);
+				out.set_read_pos(1);
+				CompressBinaryBuffer(compressedOut, out);
+				out.swap(compressedOut);
+				GDIST_PROFILE_END();
+			}
 
+			bufferExchange.send(sendToRanks[i_to], out);
+		}
+	}
 	PCL_DEBUG_BARRIER(procComm);
 	GDIST_PROFILE_END();
 
@@ -2224,12 +2232,29 @@ bool DistributeGrid(MultiGrid& mg,
 	vector<Face*> faces;
 	vector<Volume*> vols;
 
+//	buffers are deserialized in the order of recvFromRanks, so that the order
+//	of the created elements does not depend on the timing of the communication.
+//	The remaining buffers are received meanwhile.
+	BinaryBuffer in;
+	size_t recvInd = 0;
 	for(size_t i = 0; i < recvFromRanks.size(); ++i){
 	//	there is nothing to serialize from the local rank
 		if(recvFromRanks[i] == pcl::ProcRank())
 			continue;
 
-		BinaryBuffer& in = inBufs[i];
+		GDIST_PROFILE(gdist_ReceiveData);
+		bufferExchange.receive(in, recvInd++);
+		GDIST_PROFILE_END();
+
+		char compressed = 0;
+		in.read(&compressed, 1);
+		if(compressed){
+			GDIST_PROFILE(gdist_Decompression);
+			BinaryBuffer decompressedIn;
+			DecompressBinaryBuffer(decompressedIn, in);
+			in.swap(decompressedIn);
+			GDIST_PROFILE_END();
+		}
 
 		UG_DLOG(LG_DIST, 2, "Deserializing from rank " << recvFromRanks[i] << "\n");
 
@@ -2271,11 +2296,12 @@ bool DistributeGrid(MultiGrid& mg,
 		}
 
 		UG_DLOG(LG_DIST, 2, "Deserialization from rank " << recvFromRanks[i] << " done\n");
+
+	//	release the memory of the processed buffer
+		in = BinaryBuffer();
 	}
 
-	//	clear in-buffers, since they are no longer needed
-	for(size_t i = 0; i < inBufs.size(); ++i)
-		inBufs[i] = BinaryBuffer();
+	bufferExchange.wait_for_sends();
 
 	PCL_DEBUG_BARRIER(procComm);
 	GDIST_PROFILE_END();
@@ -77,6 +77,14 @@ enum InterfaceStates{
  * 			shPartition.num_subsets(). All values in the array have to be
  * 			in the range [0, pcl:NumProcs()[.
  * 			The procMap associates a process rank with each subset index.
+ *
+ * The data of each target process is sent as soon as it is serialized and
+ * received data is deserialized while the remaining data is still being
+ * transferred.
+ *
+ * \param	compressData	If true, the serialized data is compressed before it
+ * 			is sent (see CompressBinaryBuffer). This reduces the size of the
+ * 			communicated buffers at the cost of some computation time.
  */
 bool DistributeGrid(MultiGrid& mg,
 					SubsetHandler& shPartition,
@@ -84,7 +92,8 @@ bool DistributeGrid(MultiGrid& mg,
 					bool createVerticalInterfaces,
 					const std::vector<int>* processMap = NULL,
 					const pcl::ProcessCommunicator& procComm =
-												pcl::ProcessCommunicator());
+												pcl::ProcessCommunicator(),
+					bool compressData = false);
 
 }// end of namespace
 
@@ -31,12 +31,16 @@
  */
 
 #include <algorithm>
+#include <map>
 #include "load_balancer.h"
 #include "load_balancer_util.h"
 #include "distribution.h"
 #include "distributed_grid.h"
 #include "lib_grid/parallelization/parallelization_util.h"
+#include "lib_grid/parallelization/util/compol_copy_attachment.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
 #include "common/util/table.h"
+#include "pcl/pcl_interface_communicator.h"
 
 #ifdef UG_PARMETIS
 #include "partitioner_parmetis.h"
@@ -254,7 +258,12 @@ LoadBalancer() :
 	m_mg(NULL),
 	m_balanceThreshold(0.9),
 	m_elementThreshold(1),
-	m_createVerticalInterfaces(true)
+	m_createVerticalInterfaces(true),
+	m_compressData(false),
+	m_diffusiveBalancing(false),
+	m_maxDiffusionRounds(3),
+	m_estimatedMigrationBytes(0),
+	m_numDistributedHLevels(0)
 {
 	m_processHierarchy = ProcessHierarchy::create();
 	m_balanceWeights = make_sp(new StdBalanceWeights());
@@ -277,6 +286,18 @@ enable_vertical_interface_creation(bool enable)
 	m_createVerticalInterfaces = enable;
 }
 
+void LoadBalancer::
+enable_data_compression(bool enable)
+{
+	m_compressData = enable;
+}
+
+void LoadBalancer::
+enable_diffusive_balancing(bool enable)
+{
+	m_diffusiveBalancing = enable;
+}
+
 void LoadBalancer::
 set_partitioner(SmartPtr<IPartitioner> partitioner)
 {
@@ -329,19 +350,23 @@ problems_occurred()
 	return false;
 }
 
+///	returns the globally highest element type of the given grid
+static int HighestElementType(MultiGrid& mg)
+{
+	int highestElem = VERTEX;
+	if(mg.num<Volume>() > 0)		highestElem = VOLUME;
+	else if(mg.num<Face>() > 0)		highestElem = FACE;
+	else if(mg.num<Edge>() > 0)		highestElem = EDGE;
+
+	pcl::ProcessCommunicator procCom;
+	return procCom.allreduce(highestElem, PCL_RO_MAX);
+}
+
 number LoadBalancer::
 estimate_distribution_quality(std::vector<number>* pLvlQualitiesOut)
 {
 	if(m_mg){
-		int highestElem = VERTEX;
-		if(m_mg->num<Volume>() > 0)		highestElem = VOLUME;
-		else if(m_mg->num<Face>() > 0)	highestElem = FACE;
-		else if(m_mg->num<Edge>() > 0)	highestElem = EDGE;
-
-		pcl::ProcessCommunicator procCom;
-		highestElem = procCom.allreduce(highestElem, PCL_RO_MAX);
-
-		switch(highestElem){
+		switch(HighestElementType(*m_mg)){
 		case VERTEX:
 			return estimate_distribution_quality_impl<Vertex>(pLvlQualitiesOut);
 		case EDGE:
@@ -479,10 +504,14 @@ rebalance()
 	m_balanceWeights->refresh_weights(0);
 	//m_connectionWeights->refresh_weights(0);
 
+//	diffusive balancing can only be applied if the grid is already distributed
+//	with the current process hierarchy
+	const bool diffusive = m_diffusiveBalancing && diffusive_balancing_applicable();
+
 //	distribution quality is only interesting if repartitioning is supported.
 //	If it is not we'll set it to -1, thus calling partition anyways
 	number distQuality = -1;
-	if(m_partitioner->supports_repartitioning()){
+	if(m_partitioner->supports_repartitioning() || diffusive){
 		distQuality = estimate_distribution_quality();
 		if(!m_partitioner->verbose()){
 			UG_LOG("Current estimated distribution quality: " << distQuality << "\n");
@@ -491,6 +520,17 @@ rebalance()
 
 	if(m_balanceThreshold > distQuality)
 	{
+		if(diffusive){
+			UG_DLOG(LIB_GRID, 1, "LoadBalancer-rebalance: diffusive rebalancing...\n");
+			if(diffusive_rebalance()){
+				UG_LOG("Diffusive redistribution done\n");
+				UG_DLOG(LIB_GRID, 1, "LoadBalancer-stop rebalance\n");
+				return true;
+			}
+			UG_LOG("Balance threshold couldn't be reached through diffusive "
+				   "redistribution. Repartitioning...\n");
+		}
+
 		UG_DLOG(LIB_GRID, 1, "LoadBalancer-rebalance: partitioning...\n");
 		if(m_partitioner->partition(0, m_elementThreshold)){
 			UG_LOG("Redistributing...\n");
@@ -503,10 +543,12 @@ rebalance()
 			const std::vector<int>* procMap = m_partitioner->get_process_map();
 
 			UG_DLOG(LIB_GRID, 1, "LoadBalancer-rebalance: distributing...\n");
-			if(!DistributeGrid(*m_mg, sh, m_serializer, m_createVerticalInterfaces, procMap))
+			if(!DistributeGrid(*m_mg, sh, m_serializer, m_createVerticalInterfaces,
+							   procMap, pcl::ProcessCommunicator(), m_compressData))
 			{
 				UG_THROW("DistributeGrid failed!");
 			}
+			distribution_done();
 
 			UG_LOG("Redistribution done\n");
 			UG_DLOG(LIB_GRID, 1, "LoadBalancer-stop rebalance\n");
@@ -523,6 +565,424 @@ rebalance()
 	return false;
 }
 
+size_t LoadBalancer::
+num_active_hierarchy_levels() const
+{
+	pcl::ProcessCommunicator globCom;
+	size_t numLevels = globCom.allreduce(m_mg->num_levels(), PCL_RO_MAX);
+
+	size_t numActive = 0;
+	for(size_t i = 0; i < m_processHierarchy->num_hierarchy_levels(); ++i){
+		if(m_processHierarchy->grid_base_level(i) < numLevels)
+			++numActive;
+	}
+	return numActive;
+}
+
+bool LoadBalancer::
+diffusive_balancing_applicable() const
+{
+	return m_mg && m_distributedProcessHierarchy.valid()
+		   && (m_distributedProcessHierarchy.get() == m_processHierarchy.get())
+		   && (m_numDistributedHLevels == num_active_hierarchy_levels());
+}
+
+void LoadBalancer::
+distribution_done()
+{
+	m_distributedProcessHierarchy = m_processHierarchy;
+	m_numDistributedHLevels = num_active_hierarchy_levels();
+}
+
+bool LoadBalancer::
+diffusive_rebalance()
+{
+	GDIST_PROFILE_FUNC();
+	m_estimatedMigrationBytes = 0;
+
+	for(int round = 0; round < m_maxDiffusionRounds; ++round){
+		bool redistributed = false;
+		switch(HighestElementType(*m_mg)){
+			case EDGE:		redistributed = diffusive_redistribution_impl<Edge>(); break;
+			case FACE:		redistributed = diffusive_redistribution_impl<Face>(); break;
+			case VOLUME:	redistributed = diffusive_redistribution_impl<Volume>(); break;
+			default:		break;
+		}
+
+		if(!redistributed)
+			return false;
+
+		distribution_done();
+
+		if(estimate_distribution_quality() >= m_balanceThreshold)
+			return true;
+	}
+	return false;
+}
+
+
+template <class TElem>
+number LoadBalancer::
+average_serialized_data_size()
+{
+//	the serializers are applied to a few sample elements only
+	const size_t maxNumSamples = 16;
+	BinaryBuffer buf;
+	size_t numSamples = 0;
+	for(typename Grid::traits<TElem>::iterator iter = m_mg->begin<TElem>();
+		(iter != m_mg->end<TElem>()) && (numSamples < maxNumSamples);
+		++iter, ++numSamples)
+	{
+		m_serializer.serialize(buf, *iter);
+	}
+
+	if(numSamples == 0)
+		return 0;
+	return (number)buf.write_pos() / (number)numSamples;
+}
+
+
+namespace{
+///	sorts elements by their migration cost per balance weight
+template <class TElem>
+class CompareMigrationCostPerWeight{
+	public:
+		typedef Grid::AttachmentAccessor<TElem, ANumber>	accessor_t;
+		CompareMigrationCostPerWeight(accessor_t aaCost, accessor_t aaWeight) :
+			m_aaCost(aaCost), m_aaWeight(aaWeight)	{}
+
+		bool operator()(TElem* e1, TElem* e2)
+		{
+			return m_aaCost[e1] * m_aaWeight[e2] < m_aaCost[e2] * m_aaWeight[e1];
+		}
+
+	private:
+		accessor_t	m_aaCost;
+		accessor_t	m_aaWeight;
+};
+}
+
+
+template <class TElem>
+bool LoadBalancer::
+diffusive_redistribution_impl()
+{
+	GDIST_PROFILE_FUNC();
+	typedef TElem elem_t;
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+	typedef GridLayoutMap::Types<Vertex>::Layout::LevelLayout			vrt_layout_t;
+
+//	the maximal number of element layers around the process boundary
+//	which are considered for migration
+	const int maxNumLayers = 32;
+//	the maximal number of iterations of the diffusion scheme
+	const int maxNumDiffusionIterations = 1000;
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	DistributedGridManager& dgm = *mg.distributed_grid_manager();
+	GridLayoutMap& glm = dgm.grid_layout_map();
+	IBalanceWeights& bw = *m_balanceWeights;
+	const int localProc = pcl::ProcRank();
+
+	const size_t numActiveHLvls = num_active_hierarchy_levels();
+	if(numActiveHLvls == 0)
+		return false;
+
+//	elements are only moved on the base level of the highest active hierarchy level.
+	const size_t hlvl = numActiveHLvls - 1;
+	const int baseLvl = (int)m_processHierarchy->grid_base_level(hlvl);
+	const int topLvl = (int)mg.num_levels() - 1;
+	pcl::ProcessCommunicator com = m_processHierarchy->global_proc_com(hlvl);
+
+//	the new partition map. By default all elements stay on the local process.
+	SubsetHandler sh(mg);
+	sh.assign_subset(mg.begin<elem_t>(), mg.end<elem_t>(), localProc);
+
+	number movedWeight = 0;
+	number movedBytes = 0;
+	pcl::InterfaceCommunicator<layout_t> intfcCom;
+
+	if(!com.empty() && (com.size() > 1) && (baseLvl <= topLvl)){
+	//	accumulate balance weights and migration costs of all descendants
+		ANumber aWeight, aCost;
+		mg.attach_to<elem_t>(aWeight);
+		mg.attach_to<elem_t>(aCost);
+		Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+		Grid::AttachmentAccessor<elem_t, ANumber> aaCost(mg, aCost);
+		ComPol_CopyAttachment<layout_t, ANumber> compolCopyWeight(mg, aWeight);
+		ComPol_CopyAttachment<layout_t, ANumber> compolCopyCost(mg, aCost);
+
+	//	the grid-structure of an element is serialized as a type-id and its
+	//	vertex-indices. Vertices are counted for each element, which overestimates
+	//	the costs, since vertices are shared between elements.
+		const number vrtBytes = 2. * sizeof(int) + average_serialized_data_size<Vertex>();
+		const number elemBytes = average_serialized_data_size<elem_t>();
+
+		for(int lvl = topLvl; lvl >= baseLvl; --lvl){
+			if(lvl < topLvl){
+			//	copy from v-slaves to v-masters, since the parents of v-slaves
+			//	reside on other processes
+				if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+					layout_t& layout = glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl + 1);
+					intfcCom.send_data(layout, compolCopyWeight);
+					intfcCom.send_data(layout, compolCopyCost);
+				}
+				if(glm.has_layout<elem_t>(INT_V_MASTER)){
+					layout_t& layout = glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl + 1);
+					intfcCom.receive_data(layout, compolCopyWeight);
+					intfcCom.receive_data(layout, compolCopyCost);
+				}
+				intfcCom.communicate();
+			}
+
+			for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter){
+				elem_t* e = *iter;
+				number weight = 0;
+				number cost = 0;
+				if(!dgm.is_ghost(e)){
+					const size_t numVrts = e->num_vertices();
+					weight = bw.get_weight(e);
+					cost = elemBytes + (number)((2 + numVrts) * sizeof(int))
+						   + (number)numVrts * vrtBytes;
+				}
+
+				const size_t numChildren = mg.num_children<elem_t>(e);
+				for(size_t i = 0; i < numChildren; ++i){
+					elem_t* child = mg.get_child<elem_t>(e, i);
+					weight += aaWeight[child];
+					cost += aaCost[child];
+				}
+				aaWeight[e] = weight;
+				aaCost[e] = cost;
+			}
+		}
+
+		number localLoad = 0;
+		for(ElemIter iter = mg.begin<elem_t>(baseLvl); iter != mg.end<elem_t>(baseLvl); ++iter){
+			if(!dgm.is_ghost(*iter))
+				localLoad += aaWeight[*iter];
+		}
+
+	//	neighbor processes are those which share vertices on the base level
+		const int hInterfaceTypes[] = {INT_H_MASTER, INT_H_SLAVE};
+		vector<int> localGraph(1, localProc);
+		for(size_t iType = 0; iType < 2; ++iType){
+			if(!glm.has_layout<Vertex>(hInterfaceTypes[iType]))
+				continue;
+			vrt_layout_t& layout = glm.get_layout<Vertex>(hInterfaceTypes[iType])
+										.layout_on_level(baseLvl);
+			for(vrt_layout_t::iterator iiter = layout.begin(); iiter != layout.end(); ++iiter){
+				if(!layout.interface(iiter).empty())
+					localGraph.push_back(layout.proc_id(iiter));
+			}
+		}
+		sort(localGraph.begin() + 1, localGraph.end());
+		localGraph.erase(unique(localGraph.begin() + 1, localGraph.end()), localGraph.end());
+
+	//	gather the process graph and the loads of all processes
+		vector<int> graph, graphSizes, graphOffsets;
+		com.allgatherv(graph, localGraph, &graphSizes, &graphOffsets);
+		vector<number> localLoads(1, localLoad), loads;
+		com.allgatherv(loads, localLoads);
+
+		const size_t numProcs = graphSizes.size();
+		map<int, size_t> procIndex;
+		for(size_t i = 0; i < numProcs; ++i)
+			procIndex[graph[graphOffsets[i]]] = i;
+
+		vector<pair<size_t, size_t> > edges;
+		vector<size_t> degree(numProcs, 0);
+		for(size_t i = 0; i < numProcs; ++i){
+			for(int j = 1; j < graphSizes[i]; ++j){
+				map<int, size_t>::iterator ind = procIndex.find(graph[graphOffsets[i] + j]);
+				if((ind != procIndex.end()) && (ind->second != i)){
+					edges.push_back(make_pair(min(i, ind->second), max(i, ind->second)));
+				}
+			}
+		}
+		sort(edges.begin(), edges.end());
+		edges.erase(unique(edges.begin(), edges.end()), edges.end());
+		for(size_t i = 0; i < edges.size(); ++i){
+			++degree[edges[i].first];
+			++degree[edges[i].second];
+		}
+
+	//	first order diffusion scheme on the process graph. The accumulated
+	//	flow on each edge is the weight which has to be moved between the
+	//	associated processes.
+		number avgLoad = 0;
+		for(size_t i = 0; i < numProcs; ++i)
+			avgLoad += loads[i];
+		avgLoad /= (number)numProcs;
+
+		vector<number> flow(edges.size(), 0);
+		vector<number> delta(numProcs);
+		for(int iteration = 0; iteration < maxNumDiffusionIterations; ++iteration){
+			number maxDeviation = 0;
+			for(size_t i = 0; i < numProcs; ++i)
+				maxDeviation = max(maxDeviation, fabs(loads[i] - avgLoad));
+			if(maxDeviation <= 0.01 * avgLoad)
+				break;
+
+			fill(delta.begin(), delta.end(), 0);
+			for(size_t i = 0; i < edges.size(); ++i){
+				const size_t p = edges[i].first;
+				const size_t q = edges[i].second;
+				const number alpha = 1. / (number)(1 + max(degree[p], degree[q]));
+				const number f = alpha * (loads[p] - loads[q]);
+				flow[i] += f;
+				delta[p] -= f;
+				delta[q] += f;
+			}
+
+			for(size_t i = 0; i < numProcs; ++i)
+				loads[i] += delta[i];
+		}
+
+	//	outgoing flows of the local process
+		const size_t localIndex = procIndex[localProc];
+		vector<pair<int, number> > outFlows;
+		for(size_t i = 0; i < edges.size(); ++i){
+			if((edges[i].first == localIndex) && (flow[i] > 0))
+				outFlows.push_back(make_pair(graph[graphOffsets[edges[i].second]], flow[i]));
+			else if((edges[i].second == localIndex) && (flow[i] < 0))
+				outFlows.push_back(make_pair(graph[graphOffsets[edges[i].first]], -flow[i]));
+		}
+
+	//	select elements for each outgoing flow, starting at the process boundary
+		typename Grid::traits<elem_t>::secure_container	assElems;
+		Grid::vertex_traits::secure_container			vrts;
+		vector<elem_t*>	layer, nextLayer;
+		CompareMigrationCostPerWeight<elem_t> cmp(aaCost, aaWeight);
+
+		for(size_t iFlow = 0; iFlow < outFlows.size(); ++iFlow){
+			const int targetProc = outFlows[iFlow].first;
+			const number targetFlow = outFlows[iFlow].second;
+
+			mg.begin_marking();
+			layer.clear();
+			for(size_t iType = 0; iType < 2; ++iType){
+				if(!glm.has_layout<Vertex>(hInterfaceTypes[iType]))
+					continue;
+				vrt_layout_t& layout = glm.get_layout<Vertex>(hInterfaceTypes[iType])
+											.layout_on_level(baseLvl);
+				for(vrt_layout_t::iterator iiter = layout.begin(); iiter != layout.end(); ++iiter){
+					if(layout.proc_id(iiter) != targetProc)
+						continue;
+					vrt_layout_t::Interface& intfc = layout.interface(iiter);
+					for(vrt_layout_t::Interface::iterator iter = intfc.begin();
+						iter != intfc.end(); ++iter)
+					{
+						mg.associated_elements(assElems, intfc.get_element(iter));
+						for(size_t i = 0; i < assElems.size(); ++i){
+							elem_t* e = assElems[i];
+							if(!mg.is_marked(e) && !dgm.is_ghost(e)
+							   && (sh.get_subset_index(e) == localProc))
+							{
+								mg.mark(e);
+								layer.push_back(e);
+							}
+						}
+					}
+				}
+			}
+
+			number moved = 0;
+			for(int iLayer = 0; (iLayer < maxNumLayers) && !layer.empty()
+								&& (moved < targetFlow); ++iLayer)
+			{
+				sort(layer.begin(), layer.end(), cmp);
+				nextLayer.clear();
+				for(size_t iElem = 0; iElem < layer.size(); ++iElem){
+					elem_t* e = layer[iElem];
+					const number weight = aaWeight[e];
+				//	only move the element if this reduces the deviation from the target flow
+					if((weight <= 0) || (moved + 0.5 * weight > targetFlow))
+						continue;
+
+					sh.assign_subset(e, targetProc);
+					moved += weight;
+					movedBytes += aaCost[e];
+
+					mg.associated_elements(vrts, e);
+					for(size_t iVrt = 0; iVrt < vrts.size(); ++iVrt){
+						mg.associated_elements(assElems, vrts[iVrt]);
+						for(size_t i = 0; i < assElems.size(); ++i){
+							elem_t* nbr = assElems[i];
+							if(!mg.is_marked(nbr) && !dgm.is_ghost(nbr)
+							   && (sh.get_subset_index(nbr) == localProc))
+							{
+								mg.mark(nbr);
+								nextLayer.push_back(nbr);
+							}
+						}
+					}
+				}
+				layer.swap(nextLayer);
+			}
+			mg.end_marking();
+
+			movedWeight += moved;
+		}
+
+		mg.detach_from<elem_t>(aWeight);
+		mg.detach_from<elem_t>(aCost);
+	}
+
+	pcl::ProcessCommunicator globCom;
+	const number totalMovedWeight = globCom.allreduce(movedWeight, PCL_RO_SUM);
+	const number totalMovedBytes = globCom.allreduce(movedBytes, PCL_RO_SUM);
+	if(totalMovedWeight <= 0)
+		return false;
+
+	m_estimatedMigrationBytes += totalMovedBytes;
+	UG_LOG("Diffusive redistribution: moving balance weight " << totalMovedWeight
+		   << " (estimated migration volume: " << totalMovedBytes << " bytes)\n");
+
+	if(baseLvl <= topLvl){
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+	//	copy target processes from v-slaves to v-masters on the base level,
+	//	since only v-slaves were considered above
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(baseLvl),
+							   compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(baseLvl),
+								  compolSHCopy);
+		intfcCom.communicate();
+
+	//	children are sent to the same process as their parents
+		for(int lvl = baseLvl; lvl < topLvl; ++lvl){
+			for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter){
+				const size_t numChildren = mg.num_children<elem_t>(*iter);
+				const int si = sh.get_subset_index(*iter);
+				for(size_t i = 0; i < numChildren; ++i)
+					sh.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+			}
+
+			if(glm.has_layout<elem_t>(INT_V_MASTER))
+				intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl + 1),
+								   compolSHCopy);
+			if(glm.has_layout<elem_t>(INT_V_SLAVE))
+				intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl + 1),
+									  compolSHCopy);
+			intfcCom.communicate();
+		}
+	}
+
+	if(!DistributeGrid(mg, sh, m_serializer, m_createVerticalInterfaces, NULL,
+					   pcl::ProcessCommunicator(), m_compressData))
+	{
+		UG_THROW("DistributeGrid failed!");
+	}
+
+	return true;
+}
+
 void LoadBalancer::
 create_quality_record(const char* label)
 {
@@ -58,6 +58,11 @@ class LoadBalancer{
 
 		virtual void enable_vertical_interface_creation(bool enable);
 
+	///	If enabled, the serialized grid data is compressed before it is communicated.
+	/**	Disabled by default. Compression reduces communication volume during
+	 * redistribution at the cost of additional computation.*/
+		virtual void enable_data_compression(bool enable);
+
 	///	Sets the partitioner which is used to partition the grid into balanced parts.
 		virtual void set_partitioner(SPPartitioner partitioner);
 
@@ -116,6 +121,39 @@ class LoadBalancer{
 		virtual bool rebalance();
 
 
+	///	enables diffusive rebalancing for grids which are already distributed
+	/**	If enabled and if the grid was already distributed with the current
+	 * process hierarchy, rebalance won't call the partitioner. Instead elements
+	 * of the base level of the highest active hierarchy level (together with all
+	 * of their descendants) are shifted between neighbored processes only.
+	 * The amount of weight exchanged between two neighbors is obtained from a
+	 * diffusion scheme on the process graph. Elements at the shared process
+	 * boundary are moved first, preferring those with a low migration cost.
+	 * The migration cost of an element is estimated from the size of its
+	 * serialized grid-structure and from the size of the data written by the
+	 * registered serializers (see add_serializer).
+	 *
+	 * Diffusion rounds are repeated until the distribution quality reaches the
+	 * balance threshold or until the maximum number of rounds is reached.
+	 * If the threshold couldn't be reached, the partitioner is used to
+	 * repartition the grid from scratch.
+	 *
+	 * Note that distribution levels which are reached for the first time (e.g.
+	 * due to refinement) are always handled by the partitioner.
+	 *
+	 * Disabled by default.*/
+		virtual void enable_diffusive_balancing(bool enable);
+		bool diffusive_balancing_enabled() const				{return m_diffusiveBalancing;}
+
+	///	sets the maximum number of diffusive redistributions performed by a single call to rebalance
+	/**	Set to 3 by default.*/
+		void set_max_diffusion_rounds(int num)					{m_maxDiffusionRounds = num;}
+		int max_diffusion_rounds() const						{return m_maxDiffusionRounds;}
+
+	///	returns the estimated number of bytes migrated during the last diffusive rebalancing.
+	/**	The value is the same on all processes which took part in the rebalancing.*/
+		number estimated_migration_bytes() const				{return m_estimatedMigrationBytes;}
+
 	/** The returned distribution quality represents the global quality of the elements
 	 * of highest dimension and is the same on all processes.
 	 * You may optionally specify a pointer to a std::vector which will be filled
@@ -155,6 +193,27 @@ class LoadBalancer{
 		template <class TElem>
 		number estimate_distribution_quality_impl(std::vector<number>* pLvlQualitiesOut);
 
+	///	returns the number of hierarchy levels whose base level exists in the grid
+		size_t num_active_hierarchy_levels() const;
+
+	///	returns true if the grid was already distributed with the current process hierarchy
+		bool diffusive_balancing_applicable() const;
+
+	///	remembers the process hierarchy with which the grid was distributed
+		void distribution_done();
+
+	///	performs diffusion rounds until the balance threshold is met.
+	/**	Returns false if the balance threshold couldn't be reached.*/
+		bool diffusive_rebalance();
+
+	///	performs a single diffusive redistribution. Returns false if no element was moved.
+		template <class TElem>
+		bool diffusive_redistribution_impl();
+
+	///	average number of bytes written by the serializers for elements of the given type
+		template <class TElem>
+		number average_serialized_data_size();
+
 		MultiGrid*			m_mg;
 		number				m_balanceThreshold;
 		size_t				m_elementThreshold;
@@ -165,6 +224,14 @@ class LoadBalancer{
 		GridDataSerializationHandler	m_serializer;
 		StringStreamTable	m_qualityRecords;
 		bool m_createVerticalInterfaces;
+		bool m_compressData;
+
+		bool	m_diffusiveBalancing;
+		int		m_maxDiffusionRounds;
+		number	m_estimatedMigrationBytes;
+	///	the process hierarchy and the number of active hierarchy levels of the last distribution
+		ConstSPProcessHierarchy	m_distributedProcessHierarchy;
+		size_t					m_numDistributedHLevels;
 };
 
 ///	\}
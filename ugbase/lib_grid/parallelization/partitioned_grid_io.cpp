@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include "partitioned_grid_io.h"
+#include "common/util/file_util.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/file_io/file_io_ugb.h"
+#include "lib_grid/lib_grid_messages.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+#include "parallel_grid_layout.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+	#include "pcl/pcl_process_communicator.h"
+	#include "lib_grid/global_attachments.h"
+	#include "distributed_grid.h"
+#endif
+
+using namespace std;
+
+namespace ug{
+
+///	the processes on which a copy of an element will reside
+typedef Attachment<vector<int> >	AProcList;
+
+static inline void AddTargetProc(vector<int>& procs, int proc)
+{
+	if(find(procs.begin(), procs.end(), proc) == procs.end())
+		procs.push_back(proc);
+}
+
+template <class TSide, class TElem>
+static void AddTargetProcToSides(Grid& grid, MultiElementAttachmentAccessor<AProcList>& aaProcs,
+								 TElem* e, int proc)
+{
+	typename Grid::traits<TSide>::secure_container	sides;
+	grid.associated_elements(sides, e);
+	for(size_t i = 0; i < sides.size(); ++i)
+		AddTargetProc(aaProcs[sides[i]], proc);
+}
+
+///	adds the target process of each element to the element and to its sides
+template <class TElem>
+static void AssignTargetProcs(Grid& grid, PartitionMap& pm,
+							  MultiElementAttachmentAccessor<AProcList>& aaProcs)
+{
+	SubsetHandler& shPart = *pm.get_partition_handler();
+	const bool useTargetProcs = (pm.num_target_procs() > 0);
+
+	typedef typename Grid::traits<TElem>::iterator	iter_t;
+	for(iter_t iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		int si = shPart.get_subset_index(e);
+		if(si < 0)
+			continue;
+
+		int proc = useTargetProcs ? pm.get_target_proc(si) : si;
+		UG_COND_THROW(proc < 0, "Bad target process " << proc << " for partition " << si);
+		AddTargetProc(aaProcs[e], proc);
+		if(TElem::dim > 0)
+			AddTargetProcToSides<Vertex>(grid, aaProcs, e, proc);
+		if(TElem::dim > 1)
+			AddTargetProcToSides<Edge>(grid, aaProcs, e, proc);
+		if(TElem::dim > 2)
+			AddTargetProcToSides<Face>(grid, aaProcs, e, proc);
+	}
+}
+
+template <class TElem>
+static size_t NumUnassigned(Grid& grid, MultiElementAttachmentAccessor<AProcList>& aaProcs)
+{
+	size_t num = 0;
+	typedef typename Grid::traits<TElem>::iterator	iter_t;
+	for(iter_t iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter){
+		if(aaProcs[*iter].empty())
+			++num;
+	}
+	return num;
+}
+
+///	assigns consecutive global ids in the order of iteration
+template <class TElem>
+static void AssignGlobalIDs(Grid& grid, AGeomObjID& aGID)
+{
+	Grid::AttachmentAccessor<TElem, AGeomObjID> aaGID(grid, aGID);
+	size_t counter = 0;
+	typedef typename Grid::traits<TElem>::iterator	iter_t;
+	for(iter_t iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter)
+		aaGID[*iter] = MakeGeomObjID(0, counter++);
+}
+
+static inline Vertex* CreatePartitionCopy(Grid& gp, Vertex* v, Grid::VertexAttachmentAccessor<AVertex>& aaNewVrt)
+{
+	aaNewVrt[v] = *gp.create_by_cloning(v);
+	return aaNewVrt[v];
+}
+
+static inline Edge* CreatePartitionCopy(Grid& gp, Edge* e, Grid::VertexAttachmentAccessor<AVertex>& aaNewVrt)
+{
+	return *gp.create_by_cloning(e, EdgeDescriptor(aaNewVrt[e->vertex(0)],
+												   aaNewVrt[e->vertex(1)]));
+}
+
+static inline Face* CreatePartitionCopy(Grid& gp, Face* f, Grid::VertexAttachmentAccessor<AVertex>& aaNewVrt)
+{
+	FaceDescriptor fd(f->num_vertices());
+	for(size_t i = 0; i < f->num_vertices(); ++i)
+		fd.set_vertex(i, aaNewVrt[f->vertex(i)]);
+	return *gp.create_by_cloning(f, fd);
+}
+
+static inline Volume* CreatePartitionCopy(Grid& gp, Volume* v, Grid::VertexAttachmentAccessor<AVertex>& aaNewVrt)
+{
+	VolumeDescriptor vd(v->num_vertices());
+	for(size_t i = 0; i < v->num_vertices(); ++i)
+		vd.set_vertex(i, aaNewVrt[v->vertex(i)]);
+	return *gp.create_by_cloning(v, vd);
+}
+
+///	copies all elements of type TElem which reside on proc to gp and creates their interface entries
+/**	Since elements are processed in the order of their global ids on all
+ * sections, the entries of corresponding interfaces are created in the same order.*/
+template <class TElem>
+static void CopyPartitionElements(Grid& grid, ISubsetHandler& sh, Grid& gp,
+								  ISubsetHandler& shp, GridLayoutMap& glm, int proc,
+								  MultiElementAttachmentAccessor<AProcList>& aaProcs,
+								  AGeomObjID& aGID,
+								  Grid::VertexAttachmentAccessor<AVertex>& aaNewVrt)
+{
+	Grid::AttachmentAccessor<TElem, AGeomObjID> aaGID(grid, aGID);
+	Grid::AttachmentAccessor<TElem, AGeomObjID> aaGIDp(gp, aGID);
+
+	typedef typename Grid::traits<TElem>::iterator	iter_t;
+	for(iter_t iter = grid.begin<TElem>(); iter != grid.end<TElem>(); ++iter){
+		TElem* e = *iter;
+		const vector<int>& procs = aaProcs[e];
+		if(find(procs.begin(), procs.end(), proc) == procs.end())
+			continue;
+
+		TElem* ne = CreatePartitionCopy(gp, e, aaNewVrt);
+		aaGIDp[ne] = aaGID[e];
+		shp.assign_subset(ne, sh.get_subset_index(e));
+
+		if(procs.size() < 2)
+			continue;
+
+		int minProc = *min_element(procs.begin(), procs.end());
+		if(proc == minProc){
+			for(size_t i = 0; i < procs.size(); ++i){
+				if(procs[i] != proc)
+					glm.get_layout<TElem>(INT_H_MASTER).interface(procs[i], 0).push_back(ne);
+			}
+		}
+		else
+			glm.get_layout<TElem>(INT_H_SLAVE).interface(minProc, 0).push_back(ne);
+	}
+}
+
+template <class TAPos>
+bool SavePartitionedGrid(Grid& grid, ISubsetHandler& sh, PartitionMap& pm,
+						 const char* filename, TAPos& aPos,
+						 ProjectionHandler* ph)
+{
+	PROFILE_FUNC_GROUP("grid");
+	UG_COND_THROW(pm.get_partition_handler()->grid() != &grid,
+				  "SavePartitionedGrid: The partition map has to operate on the given grid.");
+	MultiGrid* mg = dynamic_cast<MultiGrid*>(&grid);
+	UG_COND_THROW(mg && mg->num_levels() > 1,
+				  "SavePartitionedGrid: Only flat grids are supported, but the given "
+				  "multigrid has " << mg->num_levels() << " levels.");
+
+	AProcList aProcs;
+	grid.attach_to_all(aProcs);
+	MultiElementAttachmentAccessor<AProcList> aaProcs(grid, aProcs);
+	AssignTargetProcs<Volume>(grid, pm, aaProcs);
+	AssignTargetProcs<Face>(grid, pm, aaProcs);
+	AssignTargetProcs<Edge>(grid, pm, aaProcs);
+	AssignTargetProcs<Vertex>(grid, pm, aaProcs);
+
+	if(NumUnassigned<Vertex>(grid, aaProcs) + NumUnassigned<Edge>(grid, aaProcs)
+	   + NumUnassigned<Face>(grid, aaProcs) + NumUnassigned<Volume>(grid, aaProcs) > 0)
+	{
+		UG_LOG("WARNING in SavePartitionedGrid: Some elements are not assigned to any "
+			   "partition. They will not be written.\n");
+	}
+
+	int numSections = pm.get_partition_handler()->num_subsets();
+	if(pm.num_target_procs() > 0){
+		numSections = 0;
+		for(size_t i = 0; i < pm.num_target_procs(); ++i)
+			numSections = max(numSections, pm.get_target_proc(i) + 1);
+	}
+
+	AGeomObjID aGID("SavePartitionedGrid_GID", false);
+	grid.attach_to_all(aGID);
+	AssignGlobalIDs<Vertex>(grid, aGID);
+	AssignGlobalIDs<Edge>(grid, aGID);
+	AssignGlobalIDs<Face>(grid, aGID);
+	AssignGlobalIDs<Volume>(grid, aGID);
+
+	AVertex aNewVrt;
+	grid.attach_to_vertices(aNewVrt);
+	Grid::VertexAttachmentAccessor<AVertex> aaNewVrt(grid, aNewVrt);
+	Grid::VertexAttachmentAccessor<TAPos> aaPos(grid, aPos);
+
+//	the grids of all sections have to exist until the writer is closed
+	vector<SmartPtr<Grid> > grids;
+	GridWriterUGB writer(filename);
+	for(int proc = 0; proc < numSections; ++proc){
+		grids.push_back(make_sp(new Grid(GRIDOPT_NONE)));
+		Grid& gp = *grids.back();
+		gp.attach_to_vertices(aPos);
+		gp.attach_to_all(aGID);
+		SubsetHandler shp(gp);
+		for(int i = 0; i < sh.num_subsets(); ++i)
+			shp.set_subset_info(i, sh.subset_info(i));
+
+		GridLayoutMap glm;
+		CopyPartitionElements<Vertex>(grid, sh, gp, shp, glm, proc, aaProcs, aGID, aaNewVrt);
+		CopyPartitionElements<Edge>(grid, sh, gp, shp, glm, proc, aaProcs, aGID, aaNewVrt);
+		CopyPartitionElements<Face>(grid, sh, gp, shp, glm, proc, aaProcs, aGID, aaNewVrt);
+		CopyPartitionElements<Volume>(grid, sh, gp, shp, glm, proc, aaProcs, aGID, aaNewVrt);
+
+		Grid::VertexAttachmentAccessor<TAPos> aaPosP(gp, aPos);
+		for(VertexIterator iter = grid.begin<Vertex>(); iter != grid.end<Vertex>(); ++iter){
+			const vector<int>& procs = aaProcs[*iter];
+			if(find(procs.begin(), procs.end(), proc) != procs.end())
+				aaPosP[aaNewVrt[*iter]] = aaPos[*iter];
+		}
+
+		writer.add_grid(gp, "defGrid", aPos);
+		writer.add_subset_handler(shp, "defSH", proc);
+		if(ph){
+			ProjectionHandler php(&shp);
+			php.set_default_projector(ph->default_projector());
+			for(int i = -1; i < (int)ph->num_projectors(); ++i){
+				if(ph->projector(i).valid())
+					php.set_projector(i, ph->projector(i));
+			}
+			writer.add_projection_handler(php, "defPH", proc);
+		}
+		writer.add_global_ids(aGID, proc);
+		writer.add_layouts(glm, proc);
+	}
+	writer.close();
+
+	grid.detach_from_vertices(aNewVrt);
+	grid.detach_from_all(aGID);
+	grid.detach_from_all(aProcs);
+	return true;
+}
+
+///	sets the "dim" property of each subset to the highest dimension of its elements in the global grid
+/**	The subset infos of processes without elements are read from the file,
+ * the dimensions are only known to processes which contain elements of a
+ * subset. They are therefore reduced over all processes.*/
+static void UpdateGlobalSubsetDims(ISubsetHandler& sh)
+{
+	int numSubsets = sh.num_subsets();
+	#ifdef UG_PARALLEL
+		pcl::ProcessCommunicator procCom;
+		numSubsets = procCom.allreduce(numSubsets, PCL_RO_MAX);
+		if(numSubsets > 0)
+			sh.subset_required(numSubsets - 1);
+	#endif
+
+	vector<int> dims(numSubsets, -1);
+	for(int i = 0; i < numSubsets; ++i){
+		if(sh.contains_volumes(i))			dims[i] = 3;
+		else if(sh.contains_faces(i))		dims[i] = 2;
+		else if(sh.contains_edges(i))		dims[i] = 1;
+		else if(sh.contains_vertices(i))	dims[i] = 0;
+	}
+
+	#ifdef UG_PARALLEL
+		if(numSubsets > 0){
+			vector<int> globDims(numSubsets);
+			procCom.allreduce(&dims.front(), &globDims.front(), numSubsets,
+							  PCL_DT_INT, PCL_RO_MAX);
+			dims.swap(globDims);
+		}
+	#endif
+
+	for(int i = 0; i < numSubsets; ++i)
+		sh.subset_info(i).set_property("dim", dims[i]);
+}
+
+template <class TAPos>
+bool LoadPartitionedGrid(MultiGrid& mg, ISubsetHandler& sh,
+						 const char* filename, TAPos& aPos,
+						 ProjectionHandler* ph)
+{
+	PROFILE_FUNC_GROUP("grid");
+	string tfile = FindFileInStandardPaths(filename);
+	UG_COND_THROW(tfile.empty(), "LoadPartitionedGrid: File not found: " << filename);
+	UG_COND_THROW(mg.num<Vertex>() > 0, "LoadPartitionedGrid: The given grid has to be empty.");
+
+	#ifdef UG_PARALLEL
+		const int localProc = pcl::ProcRank();
+		const int numProcs = pcl::NumProcs();
+	#else
+		const int localProc = 0;
+		const int numProcs = 1;
+	#endif
+
+	GridReaderUGB reader(tfile.c_str());
+	const int numSections = (int)reader.num_grids();
+	UG_COND_THROW(numSections == 0, "LoadPartitionedGrid: No grid found in " << filename);
+	UG_COND_THROW(numSections > numProcs,
+				  "LoadPartitionedGrid: " << filename << " contains " << numSections
+				  << " partitions, but only " << numProcs << " processes are available.");
+	UG_COND_THROW(!reader.has_global_ids(0) && numSections > 1,
+				  "LoadPartitionedGrid: " << filename << " is not a partitioned grid.");
+
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STARTS));
+
+	if(localProc < numSections){
+		reader.grid(mg, localProc, aPos);
+		if(reader.has_global_ids(localProc))
+			reader.global_ids(mg, aGeomObjID, localProc);
+		if(reader.num_subset_handlers(localProc) > 0)
+			reader.subset_handler(sh, 0, localProc);
+		if(ph && reader.num_projection_handlers(localProc) > 0)
+			reader.projection_handler(*ph, 0, localProc);
+	}
+	else{
+	//	the local process stays empty. Subset infos and projectors are
+	//	still required, e.g. for a later redistribution.
+		if(reader.num_subset_handlers(0) > 0)
+			reader.subset_infos(sh, 0, 0);
+		if(ph && reader.num_projection_handlers(0) > 0)
+			reader.projection_handler(*ph, 0, 0);
+	}
+
+	#ifdef UG_PARALLEL
+		DistributedGridManager* dgm = mg.distributed_grid_manager();
+		UG_COND_THROW(!dgm, "LoadPartitionedGrid: A parallel multigrid is required.");
+		GridLayoutMap& glm = dgm->grid_layout_map();
+		glm.clear();
+		if(localProc < numSections){
+			reader.layouts(glm, localProc);
+			glm.remove_empty_interfaces();
+		}
+		dgm->enable_interface_management(true);
+		dgm->grid_layouts_changed(false);
+
+		GlobalAttachments::SynchronizeDeclaredGlobalAttachments(mg, -1);
+	#endif
+
+//	listeners (e.g. the domain) expect the subset dimensions at the end of
+//	the creation. Since every process loaded its own part, there is no root
+//	process from which they could be broadcast.
+	UpdateGlobalSubsetDims(sh);
+	mg.message_hub()->post_message(GridMessage_Creation(GMCT_CREATION_STOPS));
+	return true;
+}
+
+
+template bool SavePartitionedGrid(Grid&, ISubsetHandler&, PartitionMap&, const char*, APosition1&, ProjectionHandler*);
+template bool SavePartitionedGrid(Grid&, ISubsetHandler&, PartitionMap&, const char*, APosition2&, ProjectionHandler*);
+template bool SavePartitionedGrid(Grid&, ISubsetHandler&, PartitionMap&, const char*, APosition&, ProjectionHandler*);
+
+template bool LoadPartitionedGrid(MultiGrid&, ISubsetHandler&, const char*, APosition1&, ProjectionHandler*);
+template bool LoadPartitionedGrid(MultiGrid&, ISubsetHandler&, const char*, APosition2&, ProjectionHandler*);
+template bool LoadPartitionedGrid(MultiGrid&, ISubsetHandler&, const char*, APosition&, ProjectionHandler*);
+
+}//	end of namespace
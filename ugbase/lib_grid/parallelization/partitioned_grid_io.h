@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__partitioned_grid_io
+#define __H__UG__partitioned_grid_io
+
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+#include "lib_grid/tools/partition_map.h"
+#include "lib_grid/refinement/projectors/projection_handler.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization
+///	@{
+
+///	Writes each part of a partitioned grid to its own section of a ugb file.
+/**	Section p contains all elements which are assigned to process p through
+ * the given partition map, together with their sides, the subset indices of
+ * sh, global ids and the interfaces to the sections of all other processes.
+ * Interfaces are built in the same way as through DistributeGrid without
+ * vertical interfaces, i.e. the copy on the lowest process is the h-master.
+ *
+ * The partition map has to operate on the given grid. If the partition map
+ * has no target processes, partition i is written to section i.
+ * Only flat grids (one level, no hanging nodes) are supported.
+ *
+ * Since this method is meant as a preprocessing step, it should be called on
+ * one process only. Use LoadPartitionedGrid to read the file.*/
+template <class TAPos>
+bool SavePartitionedGrid(Grid& grid, ISubsetHandler& sh, PartitionMap& pm,
+						 const char* filename, TAPos& aPos,
+						 ProjectionHandler* ph = NULL);
+
+///	Loads the section of the local process from a partitioned ugb file
+/**	Each process maps the file written by SavePartitionedGrid and creates
+ * only the elements of its own section. The layouts of the
+ * DistributedGridManager are restored from the stored interfaces, which were
+ * already ordered by global id when the file was written. Hence, no root
+ * process and no communication apart from one reduction of the subset
+ * dimensions are involved, so that the cost of loading does not grow with
+ * the number of processes.
+ *
+ * The stored global ids are attached to the grid objects through aGeomObjID,
+ * e.g. for a later checkpoint or a comparison with the serial grid. The
+ * "dim" property of each subset info is set to the highest dimension of the
+ * elements of the subset in the global grid.
+ *
+ * If the file contains fewer sections than there are processes, the
+ * remaining processes stay empty (the subset infos are still restored).
+ * They may be filled by a subsequent redistribution.
+ *
+ * If ph is specified, the stored projectors are loaded into ph.
+ * mg has to be empty.*/
+template <class TAPos>
+bool LoadPartitionedGrid(MultiGrid& mg, ISubsetHandler& sh,
+						 const char* filename, TAPos& aPos,
+						 ProjectionHandler* ph = NULL);
+
+///	@}
+}//	end of namespace
+
+#endif	//__H__UG__partitioned_grid_io
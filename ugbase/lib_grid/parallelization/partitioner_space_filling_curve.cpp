@@ -0,0 +1,679 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "partitioner_space_filling_curve.h"
+#include "distributed_grid.h"
+#include "lib_grid/parallelization/util/compol_copy_attachment.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/parallelization_util.h"
+#include "lib_grid/algorithms/geom_obj_util/misc_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_SpaceFillingCurve<TElem, dim>::
+Partitioner_SpaceFillingCurve() :
+	m_mg(NULL),
+	m_curve(SFC_HILBERT),
+	m_imbalanceTolerance(0.05),
+	m_numSplitIterations(20),
+	m_expectedMigrationVolume(0),
+	m_totalWeight(0)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_SpaceFillingCurve<TElem, dim>::
+~Partitioner_SpaceFillingCurve()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+	m_aPos = aPos;
+	m_aaPos.access(*m_mg, m_aPos);
+	m_curveSetups.clear();
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_curve(const std::string& curve)
+{
+	SpaceFillingCurveType sfc = SpaceFillingCurveTypeFromString(curve);
+	if(sfc != m_curve){
+		m_curve = sfc;
+		m_curveSetups.clear();
+	}
+}
+
+template <class TElem, int dim>
+number Partitioner_SpaceFillingCurve<TElem, dim>::
+expected_migration_ratio() const
+{
+	if(m_totalWeight > 0)
+		return m_expectedMigrationVolume / m_totalWeight;
+	return 0;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_partition_pre_processor(SPPartitionPreProcessor ppp)
+{
+	m_partitionPreProcessor = ppp;
+}
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+set_partition_post_processor(SPPartitionPostProcessor ppp)
+{
+	m_partitionPostProcessor = ppp;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SpaceFillingCurve<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SpaceFillingCurve<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_SpaceFillingCurve<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_SpaceFillingCurve<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_SpaceFillingCurve<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_SpaceFillingCurve. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+	ANumber aWeight;
+	mg.attach_to<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_starts(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->init_post_processing(m_mg, m_sh.get());
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+	m_expectedMigrationVolume = 0;
+	m_totalWeight = 0;
+
+	if(m_curveSetups.size() < procH->num_hierarchy_levels())
+		m_curveSetups.resize(procH->num_hierarchy_levels());
+
+//	iterate over procHierarchy levels and perform rebalancing for all
+//	hierarchy-sections which contain levels higher than baseLvl
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(m_balanceWeights->has_level_offsets()){
+			if(mg.top_level() < procH->grid_base_level(hlevel)){
+				if((hlevel == 0) ||
+					((int)procH->num_global_procs_involved(hlevel - 1) != numProcs))
+				{
+					UG_LOG("Partitioner_SpaceFillingCurve: Ignoring hierarchy level "
+						<< hlevel << " since it doesn't contain any elements yet\n");
+					m_problemsOccurred = true;
+				}
+				continue;
+			}
+		}
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com = procH->global_proc_com(hlevel);
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+
+		partition_level(hlevel, numProcs, minLvl, maxLvl, partitionLvl, aWeight, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	mg.detach_from<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_done(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->partitioning_done();
+
+	UG_DLOG(LIB_GRID, 1, "Partitioner_SpaceFillingCurve: expected migration volume: "
+			<< m_expectedMigrationVolume << " (ratio: " << expected_migration_ratio()
+			<< ")\n");
+
+	PCL_DEBUG_BARRIER_ALL();
+	return true;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+partition_level(size_t hlevel, int numPartitions, int minLvl, int maxLvl,
+				int partitionLvl, ANumber aWeight, pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					 mg.end<elem_t>(partitionLvl), -1);
+
+	gather_weights(partitionLvl, minLvl, maxLvl, aWeight);
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+
+//	collect the elements which shall be partitioned together with their centers
+	vector<vector_t> centers;
+	centers.reserve(mg.num<elem_t>(partitionLvl));
+	m_entries.clear();
+	m_entries.reserve(mg.num<elem_t>(partitionLvl));
+
+	vector_t locMin, locMax;
+	for(int i = 0; i < dim; ++i){
+		locMin[i] = numeric_limits<number>::max();
+		locMax[i] = -numeric_limits<number>::max();
+	}
+
+	for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+		eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+	{
+		elem_t* elem = *eiter;
+		if(pdgm && pdgm->is_ghost(elem))
+			continue;
+
+		vector_t c = CalculateCenter(elem, m_aaPos);
+		for(int i = 0; i < dim; ++i){
+			locMin[i] = min(locMin[i], c[i]);
+			locMax[i] = max(locMax[i], c[i]);
+		}
+		centers.push_back(c);
+		m_entries.push_back(Entry(elem, 0, aaWeight[elem]));
+	}
+
+	if(!com.empty()){
+		vector_t boxMin, boxMax;
+		com.allreduce(&locMin[0], &boxMin[0], dim, PCL_RO_MIN);
+		com.allreduce(&locMax[0], &boxMax[0], dim, PCL_RO_MAX);
+
+	//	the split keys of the last run can only be reused if the keys of
+	//	all elements are computed with respect to the same bounding box.
+		CurveSetup& setup = m_curveSetups[hlevel];
+		bool reuseSetup = (setup.numPartitions == numPartitions);
+		for(int i = 0; reuseSetup && (i < dim); ++i){
+			if((boxMin[i] < setup.boxMin[i]) || (boxMax[i] > setup.boxMax[i]))
+				reuseSetup = false;
+		}
+
+		if(!reuseSetup){
+			setup.numPartitions = numPartitions;
+			setup.boxMin = boxMin;
+			setup.boxMax = boxMax;
+			setup.splits.clear();
+		}
+
+		for(size_t i = 0; i < m_entries.size(); ++i){
+			m_entries[i].key = SpaceFillingCurveIndex(centers[i], setup.boxMin,
+													  setup.boxMax, m_curve);
+		}
+
+		sort(m_entries.begin(), m_entries.end());
+
+		m_prefixWeights.resize(m_entries.size() + 1);
+		m_prefixWeights[0] = 0;
+		for(size_t i = 0; i < m_entries.size(); ++i)
+			m_prefixWeights[i + 1] = m_prefixWeights[i] + m_entries[i].weight;
+
+		number totalWeight = com.allreduce(m_prefixWeights.back(), PCL_RO_SUM);
+
+		uint64 locMaxKey = 0, maxKey = 0;
+		if(!m_entries.empty())
+			locMaxKey = m_entries.back().key;
+		com.allreduce(&locMaxKey, &maxKey, 1, PCL_DT_UNSIGNED_LONG_LONG, PCL_RO_MAX);
+
+	//	check whether the old splits still lead to a sufficiently balanced distribution
+		bool keepSplits = false;
+		if(!setup.splits.empty() && (m_imbalanceTolerance >= 0)){
+			vector<number> locLoads(numPartitions, 0), loads;
+			for(size_t i = 0; i < m_entries.size(); ++i){
+				size_t p = upper_bound(setup.splits.begin(), setup.splits.end(),
+									   m_entries[i].key) - setup.splits.begin();
+				locLoads[p] += m_entries[i].weight;
+			}
+			com.allreduce(locLoads, loads, PCL_RO_SUM);
+
+			number maxLoad = *max_element(loads.begin(), loads.end());
+			number avgLoad = totalWeight / (number)numPartitions;
+			keepSplits = (maxLoad <= (1. + m_imbalanceTolerance) * avgLoad);
+		}
+
+		if(!keepSplits)
+			find_splits(setup.splits, numPartitions, maxKey, com);
+
+	//	assign the target processes and sum up the weight which has to be migrated
+		const vector<uint64>& splits = setup.splits;
+		const int localProc = pcl::ProcRank();
+		number migrationVolume = 0;
+		for(size_t i = 0; i < m_entries.size(); ++i){
+			int p = (int)(upper_bound(splits.begin(), splits.end(), m_entries[i].key)
+						  - splits.begin());
+			sh.assign_subset(m_entries[i].elem, p);
+			if(p != localProc)
+				migrationVolume += m_entries[i].weight;
+		}
+
+		m_expectedMigrationVolume += com.allreduce(migrationVolume, PCL_RO_SUM);
+		m_totalWeight += totalWeight;
+	}
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->post_process(partitionLvl);
+
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		for(int i = partitionLvl; i < minLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else if(pdgm){
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+gather_weights(int baseLvl, int minLvl, int maxLvl, ANumber aWeight)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+	ComPol_CopyAttachment<layout_t, ANumber> compolCopy(mg, aWeight);
+
+	const bool levelOffsets = bw.has_level_offsets();
+
+	for(int lvl = maxLvl; lvl >= baseLvl; --lvl){
+		if((lvl < maxLvl) && pdgm){
+		//	copy accumulated weights from v-slaves to v-masters, since the
+		//	parents of v-slaves reside on other processes
+			GridLayoutMap& glm = pdgm->grid_layout_map();
+			if(glm.has_layout<elem_t>(INT_V_SLAVE))
+				m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl + 1),
+									 compolCopy);
+			if(glm.has_layout<elem_t>(INT_V_MASTER))
+				m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl + 1),
+										compolCopy);
+			m_intfcCom.communicate();
+		}
+
+		for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+		{
+			elem_t* e = *iter;
+			size_t numChildren = mg.num_children<elem_t>(e);
+
+			number w = 0;
+			if(lvl < maxLvl){
+				for(size_t i = 0; i < numChildren; ++i)
+					w += aaWeight[mg.get_child<elem_t>(e, i)];
+			}
+
+			if((lvl >= minLvl) && !(pdgm && pdgm->is_ghost(e))){
+				if(levelOffsets && (numChildren == 0) && bw.consider_in_level_above(e))
+					w += bw.get_refined_weight(e);
+				else
+					w += bw.get_weight(e);
+			}
+
+			aaWeight[e] = w;
+		}
+	}
+}
+
+
+template <class TElem, int dim>
+number Partitioner_SpaceFillingCurve<TElem, dim>::
+local_weight_below(uint64 key) const
+{
+	size_t first = 0;
+	size_t count = m_entries.size();
+	while(count > 0){
+		size_t step = count / 2;
+		if(m_entries[first + step].key < key){
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+			count = step;
+	}
+	return m_prefixWeights[first];
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+find_splits(std::vector<uint64>& splitsOut, int numPartitions, uint64 maxKey,
+			pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+//	each split is searched in a key interval [lo, hi], which is subdivided into
+//	numBuckets parts in each iteration. The global weights below the resulting
+//	candidate keys are then obtained by a single allreduce for all splits.
+	const uint64 numBuckets = 16;
+	const int numSplits = numPartitions - 1;
+
+	splitsOut.resize(max(numSplits, 0));
+	if(numSplits <= 0)
+		return;
+
+	const number totalWeight = com.allreduce(m_prefixWeights.back(), PCL_RO_SUM);
+	const number avgWeight = totalWeight / (number)numPartitions;
+//	splits are accepted as soon as they deviate from their target by less than
+//	1% of the average partition weight
+	const number tol = 0.01 * avgWeight;
+
+	vector<uint64> lo(numSplits, 0);
+	vector<uint64> hi(numSplits, maxKey);
+	vector<number> bestDeviation(numSplits, numeric_limits<number>::max());
+	vector<char> done(numSplits, 0);
+	for(int i = 0; i < numSplits; ++i)
+		splitsOut[i] = 0;
+
+	vector<int>		activeSplits;
+	vector<uint64>	candidates;
+	vector<number>	locWeights, weights;
+
+	for(int iteration = 0; iteration < m_numSplitIterations; ++iteration){
+		activeSplits.clear();
+		candidates.clear();
+		for(int i = 0; i < numSplits; ++i){
+			if(done[i])
+				continue;
+			activeSplits.push_back(i);
+			const uint64 d = hi[i] - lo[i];
+			const uint64 q = d / numBuckets;
+			const uint64 r = d % numBuckets;
+			for(uint64 k = 0; k <= numBuckets; ++k)
+				candidates.push_back(lo[i] + q * k + (r * k) / numBuckets);
+		}
+
+		if(activeSplits.empty())
+			break;
+
+		locWeights.resize(candidates.size());
+		for(size_t i = 0; i < candidates.size(); ++i)
+			locWeights[i] = local_weight_below(candidates[i]);
+		com.allreduce(locWeights, weights, PCL_RO_SUM);
+
+		for(size_t iActive = 0; iActive < activeSplits.size(); ++iActive){
+			const int i = activeSplits[iActive];
+			const size_t offset = iActive * (numBuckets + 1);
+			const number target = (number)(i + 1) * avgWeight;
+
+		//	find the last candidate whose weight doesn't exceed the target
+			size_t k = 0;
+			while((k < numBuckets) && (weights[offset + k + 1] <= target))
+				++k;
+
+			for(size_t j = k; j <= min<size_t>(k + 1, numBuckets); ++j){
+				number dev = fabs(weights[offset + j] - target);
+				if(dev < bestDeviation[i]){
+					bestDeviation[i] = dev;
+					splitsOut[i] = candidates[offset + j];
+				}
+			}
+
+			if((k == numBuckets) || (bestDeviation[i] <= tol)
+				|| (candidates[offset + k + 1] - candidates[offset + k] <= 1))
+			{
+				done[i] = 1;
+			}
+			else{
+				lo[i] = candidates[offset + k];
+				hi[i] = candidates[offset + k + 1];
+			}
+		}
+	}
+
+//	splits have to be ascending
+	for(int i = 1; i < numSplits; ++i)
+		splitsOut[i] = max(splitsOut[i], splitsOut[i - 1]);
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SpaceFillingCurve<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+template class Partitioner_SpaceFillingCurve<Edge, 1>;
+template class Partitioner_SpaceFillingCurve<Edge, 2>;
+template class Partitioner_SpaceFillingCurve<Face, 2>;
+template class Partitioner_SpaceFillingCurve<Edge, 3>;
+template class Partitioner_SpaceFillingCurve<Face, 3>;
+template class Partitioner_SpaceFillingCurve<Volume, 3>;
+
+}// end of namespace
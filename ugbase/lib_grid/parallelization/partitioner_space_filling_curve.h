@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__partitioner_space_filling_curve__
+#define __H__UG__partitioner_space_filling_curve__
+
+#include <vector>
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "lib_grid/algorithms/space_filling_curve_util.h"
+#include "pcl/pcl_interface_communicator.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Parallel partitioner which splits a space filling curve into parts of equal weight
+/**	All elements of the partitioned level are sorted along a Hilbert (or Morton)
+ * curve through the bounding box of their centers. The curve is then cut into
+ * as many consecutive pieces as there are target processes, so that each piece
+ * carries roughly the same balance weight. The weight of an element on the
+ * partitioned level is the accumulated weight of all of its descendants, as
+ * provided by the balance weights (see set_balance_weights).
+ *
+ * The split keys are found through global prefix sums of the weights along the
+ * curve. Those are evaluated on an iteratively refined set of candidate keys,
+ * so that only the local element weights have to be summed up on each process
+ * and a few small allreduce operations suffice to locate all splits.
+ *
+ * Since each process receives a connected piece of the curve, a small change of
+ * the element weights only shifts the split keys slightly and only elements in
+ * the vicinity of the old splits change their process. This makes the
+ * partitioner well suited for repeated repartitioning of adaptive grids. If the
+ * split keys of the last run still yield a distribution whose imbalance is
+ * below the given tolerance (see set_imbalance_tolerance), they are reused
+ * without changes.
+ *
+ * The balance weight which is expected to migrate due to the latest partitioning
+ * is available through expected_migration_volume().
+ *
+ * The partitioner can be used inside a LoadBalancer or separately. It can
+ * operate on serial and parallel multigrids.
+ */
+template <class TElem, int dim>
+class Partitioner_SpaceFillingCurve : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef MathVector<dim>							vector_t;
+		typedef Attachment<vector_t>					apos_t;
+		typedef Grid::VertexAttachmentAccessor<apos_t>	aapos_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+		Partitioner_SpaceFillingCurve();
+		virtual ~Partitioner_SpaceFillingCurve();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	sets the type of the space filling curve ('hilbert' (default) or 'morton')
+		void set_curve(const std::string& curve);
+
+	///	the maximal accepted ratio between the heaviest and the average partition minus one.
+	/**	If the split keys of the previous partitioning lead to an imbalance below
+	 * this tolerance, they are reused and no element changes its process.
+	 * A negative value forces a recomputation of the splits on each call.
+	 * 0.05 by default.*/
+		void set_imbalance_tolerance(number tol)	{m_imbalanceTolerance = tol;}
+		number imbalance_tolerance() const			{return m_imbalanceTolerance;}
+
+	///	the maximum number of refinement iterations performed to find the split keys
+		int num_split_iterations() const			{return m_numSplitIterations;}
+		void set_num_split_iterations(int num)		{m_numSplitIterations = num;}
+
+	///	forgets the split keys of previous partitionings
+		void reset_splits()							{m_curveSetups.clear();}
+
+	///	returns the total balance weight of all elements which change their process
+	/**	The value refers to the latest call to partition and is the same on all
+	 * processes which took part in the partitioning.*/
+		number expected_migration_volume() const	{return m_expectedMigrationVolume;}
+
+	///	returns the ratio between the expected migration volume and the total weight
+		number expected_migration_ratio() const;
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+
+		virtual void set_partition_pre_processor(SPPartitionPreProcessor ppp);
+		virtual void set_partition_post_processor(SPPartitionPostProcessor ppp);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const			{return true;}
+		virtual bool supports_connection_weights() const		{return false;}
+		virtual bool supports_repartitioning() const			{return true;}
+
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	private:
+		struct Entry{
+			Entry(elem_t* e, uint64 k, number w) : elem(e), key(k), weight(w)	{}
+			bool operator<(const Entry& e) const	{return key < e.key;}
+			elem_t*	elem;
+			uint64	key;
+			number	weight;
+		};
+
+	///	bounding box and split keys which were used to partition a hierarchy level
+		struct CurveSetup{
+			CurveSetup() : numPartitions(0)	{}
+			int					numPartitions;
+			vector_t			boxMin;
+			vector_t			boxMax;
+			std::vector<uint64>	splits;
+		};
+
+		void partition_level(size_t hlevel, int numPartitions, int minLvl,
+							 int maxLvl, int partitionLvl, ANumber aWeight,
+							 pcl::ProcessCommunicator com);
+
+	///	accumulates the weights of all descendants in minLvl..maxLvl in the elements of baseLvl
+		void gather_weights(int baseLvl, int minLvl, int maxLvl, ANumber aWeight);
+
+	///	finds split keys so that the weight between consecutive splits is balanced
+	/**	m_entries have to be sorted by key and m_prefixWeights have to be valid.*/
+		void find_splits(std::vector<uint64>& splitsOut, int numPartitions,
+						 uint64 maxKey, pcl::ProcessCommunicator& com);
+
+	///	returns the sum of the weights of all local entries whose key is smaller than the given one
+		number local_weight_below(uint64 key) const;
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+		MultiGrid*								m_mg;
+		apos_t									m_aPos;
+		aapos_t									m_aaPos;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+
+		SPBalanceWeights						m_balanceWeights;
+		SPPartitionPreProcessor					m_partitionPreProcessor;
+		SPPartitionPostProcessor				m_partitionPostProcessor;
+
+		SpaceFillingCurveType					m_curve;
+		number									m_imbalanceTolerance;
+		int										m_numSplitIterations;
+
+		std::vector<Entry>						m_entries;
+		std::vector<number>						m_prefixWeights;
+		std::vector<CurveSetup>					m_curveSetups;
+
+		number									m_expectedMigrationVolume;
+		number									m_totalWeight;
+};
+
+///	\}
+
+}// end of namespace
+
+#endif
@@ -879,7 +879,6 @@ template <class TElem>
 void GlobalFracturedMediaRefiner::
 mark_sides_of_marked_top_level_elements()
 {
-	typedef typename MultiGrid::traits<TElem>::iterator	ElemIter;
 	typedef typename TElem::side	Side;
 	if(!m_pMG)
 		UG_THROW("No grid assigned!");
@@ -889,21 +888,21 @@ mark_sides_of_marked_top_level_elements()
 
 	MultiGrid& mg = *m_pMG;
 
-//	iterate over all elements in the top level and adjust their marks
+//	mark the sides of all marked elements in the top level
 	int topLvl = mg.num_levels() - 1;
 
 //	collect sides in this container
 	vector<Side*> sides;
 
-	for(ElemIter iter = mg.begin<TElem>(topLvl);
-		iter != mg.end<TElem>(topLvl); ++iter)
-	{
-		TElem* e = *iter;
-		if(m_marker.is_marked(e)){
-			CollectAssociated(sides, mg, e);
-			for(size_t i = 0; i < sides.size(); ++i){
-				m_marker.mark(sides[i]);
-			}
+	vector<TElem*> elems;
+	m_marker.collect_marked(elems);
+	for(size_t i_elem = 0; i_elem < elems.size(); ++i_elem){
+		TElem* e = elems[i_elem];
+		if(mg.get_level(e) != topLvl)
+			continue;
+		CollectAssociated(sides, mg, e);
+		for(size_t i = 0; i < sides.size(); ++i){
+			m_marker.mark(sides[i]);
 		}
 	}
 
@@ -30,8 +30,10 @@
  * GNU Lesser General Public License for more details.
  */
 
+#include <algorithm>
 #include <cassert>
 #include "common/profiler/profiler.h"
+#include "common/util/thread_team.h"
 #include "global_multi_grid_refiner.h"
 #include "lib_grid/algorithms/algorithms.h"
 #include "lib_grid/file_io/file_io.h"
@@ -57,13 +59,15 @@ namespace ug
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(SPRefinementProjector projector) :
 	IRefiner(projector),
-	m_pMG(NULL)
+	m_pMG(NULL),
+	m_numThreads(1)
 {
 }
 
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(MultiGrid& mg, SPRefinementProjector projector) :
-	IRefiner(projector)
+	IRefiner(projector),
+	m_numThreads(1)
 {
 	m_pMG = NULL;
 	assign_grid(mg);
@@ -75,6 +79,11 @@ GlobalMultiGridRefiner::~GlobalMultiGridRefiner()
 		m_pMG->unregister_observer(this);
 }
 
+void GlobalMultiGridRefiner::set_num_threads(size_t numThreads)
+{
+	m_numThreads = max<size_t>(numThreads, 1);
+}
+
 void GlobalMultiGridRefiner::grid_to_be_destroyed(Grid* grid)
 {
 	m_pMG = NULL;
@@ -132,6 +141,191 @@ num_marked_elems(std::vector<int>& numMarkedElemsOut)
 }
 
 ////////////////////////////////////////////////////////////////////////
+namespace{
+///	creates the children of a range of faces or volumes without registering them
+/**	The children of the elements in [begin, end) are written to 'children' in
+ *	the order of their parents. numChildren[i] is set to -1 if elems[i] could
+ *	not be refined.
+ *
+ *	Only reads the old level of the multi-grid, which is not altered while
+ *	children are created. Each thread uses its own instance, which is reused
+ *	for all blocks of elements.*/
+template <class TElem>
+struct RefineElemRange
+{
+	RefineElemRange(MultiGrid& g, IGeometry3d* geo, const vector<TElem*>& e,
+					vector<Vertex*>& nv, vector<int>& nc)
+		: mg(g), geom(geo), elems(e), newVrts(nv), numChildren(nc),
+		  begin(0), end(0)
+	{}
+
+	void set_range(size_t bg, size_t en)	{begin = bg; end = en;}
+
+	void operator()()
+	{
+		children.clear();
+		vector<TElem*> vNewElems;
+		for(size_t i = begin; i < end; ++i){
+			Vertex* newVrt = NULL;
+			if(refine(vNewElems, &newVrt, elems[i])){
+				newVrts[i] = newVrt;
+				numChildren[i] = (int)vNewElems.size();
+				children.insert(children.end(), vNewElems.begin(), vNewElems.end());
+			}
+			else{
+				newVrts[i] = NULL;
+				numChildren[i] = -1;
+			}
+		}
+	}
+
+	bool refine(vector<Face*>& vFacesOut, Vertex** pNewVrt, Face* f)
+	{
+	//	collect child-vertices
+		vVrts.clear();
+		for(uint j = 0; j < f->num_vertices(); ++j)
+			vVrts.push_back(mg.get_child_vertex(f->vertex(j)));
+
+	//	collect the associated edges
+		vEdgeVrts.clear();
+		for(uint j = 0; j < f->num_edges(); ++j)
+			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(f, j)));
+
+		return f->refine(vFacesOut, pNewVrt, &vEdgeVrts.front(), NULL, &vVrts.front());
+	}
+
+	bool refine(vector<Volume*>& vVolsOut, Vertex** pNewVrt, Volume* v)
+	{
+	//	collect child-vertices
+		vVrts.clear();
+		for(uint j = 0; j < v->num_vertices(); ++j)
+			vVrts.push_back(mg.get_child_vertex(v->vertex(j)));
+
+	//	collect the associated edges
+		vEdgeVrts.clear();
+		for(uint j = 0; j < v->num_edges(); ++j)
+			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(v, j)));
+
+	//	collect associated face-vertices
+		vFaceVrts.clear();
+		for(uint j = 0; j < v->num_faces(); ++j)
+			vFaceVrts.push_back(mg.get_child_vertex(mg.get_face(v, j)));
+
+	//	if we're performing tetrahedral or octahedral refinement, we have to collect
+	//	the corner coordinates, so that the refinement algorithm may choose
+	//	the best interior diagonal.
+		vector3* pCorners = NULL;
+		if(geom && ((v->num_vertices() == 4)
+					|| (v->reference_object_id() == ROID_OCTAHEDRON)))
+		{
+			for(size_t i = 0; i < v->num_vertices(); ++i)
+				corners[i] = geom->pos(v->vertex(i));
+			pCorners = corners;
+		}
+
+		return v->refine(vVolsOut, pNewVrt, &vEdgeVrts.front(), &vFaceVrts.front(),
+						 NULL, RegularVertex(), &vVrts.front(), pCorners);
+	}
+
+	MultiGrid& mg;
+	IGeometry3d* geom;
+	const vector<TElem*>& elems;
+	vector<Vertex*>& newVrts;
+	vector<int>& numChildren;
+	vector<TElem*> children;
+	size_t begin, end;
+
+	vector<Vertex*> vVrts;
+	vector<Vertex*> vEdgeVrts;
+	vector<Vertex*> vFaceVrts;
+	vector3 corners[6];
+};
+
+///	calls the worker of each thread of a ThreadTeam
+template <class TWorker>
+struct RunWorkers
+{
+	RunWorkers(vector<TWorker>& w) : workers(w)	{}
+	void operator()(size_t t) const				{workers[t]();}
+	vector<TWorker>& workers;
+};
+
+const char* ElemName(Face*)		{return "face";}
+const char* ElemName(Volume*)	{return "volume";}
+}//	end of anonymous namespace
+
+
+template <class TElem>
+void GlobalMultiGridRefiner::refine_elements(int lvl)
+{
+	typedef typename geometry_traits<TElem>::iterator	iter_t;
+
+//	elements are processed in blocks, so that the buffers holding created
+//	but not yet registered children stay small. The same threads are used
+//	for all blocks.
+	ThreadTeam team(m_numThreads);
+	const size_t numThreads = team.num_threads();
+	const size_t blockSize = max<size_t>(4096, 1024 * numThreads);
+
+	MultiGrid& mg = *m_pMG;
+	IGeometry3d* geom = NULL;
+	if(m_projector.valid())
+		geom = m_projector->geometry().get();
+
+	vector<TElem*> vElems;
+	vector<Vertex*> vNewVrts;
+	vector<int> vNumChildren;
+	vector<RefineElemRange<TElem> > vWorkers;
+	vWorkers.reserve(numThreads);
+	for(size_t t = 0; t < numThreads; ++t)
+		vWorkers.push_back(RefineElemRange<TElem>(mg, geom, vElems, vNewVrts, vNumChildren));
+
+	iter_t iter = mg.begin<TElem>(lvl);
+	iter_t iterEnd = mg.end<TElem>(lvl);
+	while(iter != iterEnd){
+		vElems.clear();
+		for(; iter != iterEnd && vElems.size() < blockSize; ++iter){
+			if(refinement_is_allowed(*iter))
+				vElems.push_back(*iter);
+		}
+
+		const size_t num = vElems.size();
+		vNewVrts.resize(num);
+		vNumChildren.resize(num);
+
+	//	create the children. Thread t handles the range [t*num/n, (t+1)*num/n).
+		for(size_t t = 0; t < numThreads; ++t)
+			vWorkers[t].set_range(t * num / numThreads, (t+1) * num / numThreads);
+		team.run(RunWorkers<RefineElemRange<TElem> >(vWorkers));
+
+	//	register new vertices and children in the order of their parents
+		for(size_t t = 0; t < numThreads; ++t){
+			const vector<TElem*>& vChildren = vWorkers[t].children;
+			size_t curChild = 0;
+			for(size_t i = vWorkers[t].begin; i < vWorkers[t].end; ++i){
+				TElem* e = vElems[i];
+				if(vNumChildren[i] < 0){
+					LOG("  WARNING in Refine: could not refine " << ElemName(e) << ".\n");
+					continue;
+				}
+
+			//	if a new vertex was generated, we have to register it
+				if(vNewVrts[i]){
+					mg.register_element(vNewVrts[i], e);
+				//	allow refCallback to calculate a new position
+					if(m_projector.valid())
+						m_projector->new_vertex(vNewVrts[i], e);
+				}
+
+			//	register the new elements
+				for(int j = 0; j < vNumChildren[i]; ++j, ++curChild)
+					mg.register_element(vChildren[curChild], e);
+			}
+		}
+	}
+}
+
+
 void GlobalMultiGridRefiner::perform_refinement()
 {
 	UG_DLOG(LIB_GRID, 1, "GlobalMultiGridRefiner\n");
@@ -232,17 +426,7 @@ void GlobalMultiGridRefiner::perform_refinement()
 
 
 //	some buffers
-	vector<Vertex*> vVrts;
-	vector<Vertex*> vEdgeVrts;
-	vector<Vertex*> vFaceVrts;
 	vector<Edge*>	vEdges;
-	vector<Face*>		vFaces;
-	vector<Volume*>		vVols;
-	
-//	some repeatedly used objects
-	EdgeDescriptor ed;
-	FaceDescriptor fd;
-	VolumeDescriptor vd;
 
 	UG_DLOG(LIB_GRID, 1, "  creating new vertices\n");
 
@@ -328,124 +512,10 @@ void GlobalMultiGridRefiner::perform_refinement()
 
 
 	UG_DLOG(LIB_GRID, 1, "  creating new faces\n");
-
-//	create new vertices and faces from marked faces
-	for(FaceIterator iter = mg.begin<Face>(oldTopLevel);
-		iter != mg.end<Face>(oldTopLevel); ++iter)
-	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-			
-		Face* f = *iter;
-	//	collect child-vertices
-		vVrts.clear();
-		for(uint j = 0; j < f->num_vertices(); ++j)
-			vVrts.push_back(mg.get_child_vertex(f->vertex(j)));
-
-	//	collect the associated edges
-		vEdgeVrts.clear();
-		//bool bIrregular = false;
-		for(uint j = 0; j < f->num_edges(); ++j)
-			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(f, j)));
-
-		//GMGR_PROFILE(GMGR_Refine_CreatingFaces);
-		Vertex* newVrt;
-		if(f->refine(vFaces, &newVrt, &vEdgeVrts.front(), NULL, &vVrts.front())){
-		//	if a new vertex was generated, we have to register it
-			if(newVrt){
-				//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
-				mg.register_element(newVrt, f);
-			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
-					m_projector->new_vertex(newVrt, f);
-				//GMGR_PROFILE_END();
-			}
-
-		//	register the new faces and assign status
-			for(size_t j = 0; j < vFaces.size(); ++j)
-				mg.register_element(vFaces[j], f);
-		}
-		else{
-			LOG("  WARNING in Refine: could not refine face.\n");
-		}
-		//GMGR_PROFILE_END();
-	}
-
+	refine_elements<Face>(oldTopLevel);
 
 	UG_DLOG(LIB_GRID, 1, "  creating new volumes\n");
-
-//	only used for tetrahedron or octahedron refinement
-	vector<vector3> corners(6, vector3(0, 0, 0));
-
-//	create new vertices and volumes from marked volumes
-	for(VolumeIterator iter = mg.begin<Volume>(oldTopLevel);
-		iter != mg.end<Volume>(oldTopLevel); ++iter)
-	{
-		if(!refinement_is_allowed(*iter))
-			continue;
-
-		Volume* v = *iter;
-		//GMGR_PROFILE(GMGR_Refining_Volume);
-
-	//	collect child-vertices
-		//GMGR_PROFILE(GMGR_CollectingVolumeVertices);
-		vVrts.clear();
-		for(uint j = 0; j < v->num_vertices(); ++j)
-			vVrts.push_back(mg.get_child_vertex(v->vertex(j)));
-		//GMGR_PROFILE_END();
-
-	//	collect the associated edges
-		vEdgeVrts.clear();
-		//GMGR_PROFILE(GMGR_CollectingVolumeEdgeVertices);
-		//bool bIrregular = false;
-		for(uint j = 0; j < v->num_edges(); ++j)
-			vEdgeVrts.push_back(mg.get_child_vertex(mg.get_edge(v, j)));
-		//GMGR_PROFILE_END();
-
-	//	collect associated face-vertices
-		vFaceVrts.clear();
-		//GMGR_PROFILE(GMGR_CollectingVolumeFaceVertices);
-		for(uint j = 0; j < v->num_faces(); ++j)
-			vFaceVrts.push_back(mg.get_child_vertex(mg.get_face(v, j)));
-		//GMGR_PROFILE_END();
-
-	//	if we're performing tetrahedral or octahedral refinement, we have to collect
-	//	the corner coordinates, so that the refinement algorithm may choose
-	//	the best interior diagonal.
-		vector3* pCorners = NULL;
-		if((v->num_vertices() == 4) && m_projector.valid()){
-			for(size_t i = 0; i < 4; ++i){
-				corners[i] = m_projector->geometry()->pos(v->vertex(i));
-			}
-			pCorners = &corners.front();
-		}
-		if((v->reference_object_id() == ROID_OCTAHEDRON) && m_projector.valid()){
-			for(size_t i = 0; i < 6; ++i){
-				corners[i] = m_projector->geometry()->pos(v->vertex(i));
-			}
-			pCorners = &corners.front();
-		}
-
-		Vertex* newVrt;
-		if(v->refine(vVols, &newVrt, &vEdgeVrts.front(), &vFaceVrts.front(),
-					NULL, RegularVertex(), &vVrts.front(), pCorners)){
-		//	if a new vertex was generated, we have to register it
-			if(newVrt){
-				mg.register_element(newVrt, v);
-			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
-					m_projector->new_vertex(newVrt, v);
-			}
-
-		//	register the new faces and assign status
-			for(size_t j = 0; j < vVols.size(); ++j)
-				mg.register_element(vVols[j], v);
-		}
-		else{
-			LOG("  WARNING in Refine: could not refine volume.\n");
-		}
-		//GMGR_PROFILE_END();
-	}
+	refine_elements<Volume>(oldTopLevel);
 
 //	done - clean up
 	if(!bHierarchicalInsertionWasEnabled)
@@ -67,6 +67,15 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 
 		virtual bool save_marks_to_file(const char* filename);
 
+	///	sets the number of threads which create the children of faces and volumes
+	/**	The children are created by several threads but registered at the grid
+	 *	in the order of their parents, so that the resulting hierarchy is the
+	 *	same for any number of threads. Default is 1.*/
+		void set_num_threads(size_t numThreads);
+
+	///	returns the number of threads used during refinement
+		size_t num_threads() const					{return m_numThreads;}
+
 	protected:
 	///	returns the number of (globally) marked edges on this level of the hierarchy
 		virtual void num_marked_edges_local(std::vector<int>& numMarkedEdgesOut);
@@ -82,6 +91,12 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 	///	performs refinement on the marked elements.
 		virtual void perform_refinement();
 
+	///	refines all faces or volumes of the given level
+	/**	Elements are processed in blocks. The children of the elements of a
+	 *	block are created concurrently and then registered in element order.*/
+		template <class TElem>
+		void refine_elements(int lvl);
+
 	///	a callback that allows to deny refinement of special vertices
 		virtual bool refinement_is_allowed(Vertex* elem)	{return true;}
 	///	a callback that allows to deny refinement of special edges
@@ -107,6 +122,7 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 		
 	protected:
 		MultiGrid*	m_pMG;
+		size_t		m_numThreads;
 };
 
 /// @}
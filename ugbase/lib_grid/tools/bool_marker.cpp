@@ -40,6 +40,10 @@ BoolMarker::BoolMarker() :
 	m_markInheritanceEnabled(true),
 	m_strictInheritanceEnabled(false)
 {
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i){
+		m_vBits[i] = NULL;
+		m_vElems[i] = NULL;
+	}
 }
 
 BoolMarker::BoolMarker(Grid& g) :
@@ -48,6 +52,10 @@ BoolMarker::BoolMarker(Grid& g) :
 	m_markInheritanceEnabled(true),
 	m_strictInheritanceEnabled(false)
 {
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i){
+		m_vBits[i] = NULL;
+		m_vElems[i] = NULL;
+	}
 	assign_grid(&g);
 }
 
@@ -62,26 +70,68 @@ void BoolMarker::assign_grid(Grid* g)
 		return;
 
 	if(m_pGrid){
-		m_pGrid->detach_from_all(m_aBool);
+		release_element_maps();
+		m_pGrid->detach_from_all(m_aBits);
 		m_pGrid->unregister_observer(this);
-		m_aaMarkVRT.invalidate();
-		m_aaMarkEDGE.invalidate();
-		m_aaMarkFACE.invalidate();
-		m_aaMarkVOL.invalidate();
+		for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+			m_vBits[i] = NULL;
 	}
 
 	m_pGrid = g;
 	if(g){
 		g->register_observer(this, OT_GRID_OBSERVER | OT_VERTEX_OBSERVER | OT_EDGE_OBSERVER |
 									OT_FACE_OBSERVER | OT_VOLUME_OBSERVER);
-		g->attach_to_all(m_aBool);
-		m_aaMarkVRT.access(*g, m_aBool);
-		m_aaMarkEDGE.access(*g, m_aBool);
-		m_aaMarkFACE.access(*g, m_aBool);
-		m_aaMarkVOL.access(*g, m_aBool);
+		g->attach_to_all(m_aBits);
+		register_elements<Vertex>();
+		register_elements<Edge>();
+		register_elements<Face>();
+		register_elements<Volume>();
 	}
 }
 
+template <class TElem>
+void BoolMarker::register_elements()
+{
+	const int id = geometry_traits<TElem>::BASE_OBJECT_ID;
+	m_vBits[id] = m_pGrid->get_attachment_data_container<TElem>(m_aBits);
+}
+
+void BoolMarker::attach_element_map(int baseObjectId) const
+{
+	assert(m_pGrid);
+	switch(baseObjectId){
+		case VERTEX: attach_element_map<Vertex>(); break;
+		case EDGE: attach_element_map<Edge>(); break;
+		case FACE: attach_element_map<Face>(); break;
+		case VOLUME: attach_element_map<Volume>(); break;
+	}
+}
+
+template <class TElem>
+void BoolMarker::attach_element_map() const
+{
+	const int id = geometry_traits<TElem>::BASE_OBJECT_ID;
+	m_pGrid->attach_to<TElem>(m_aElem, false);
+	m_vElems[id] = m_pGrid->get_attachment_data_container<TElem>(m_aElem);
+
+	ElemContainer& elems = *m_vElems[id];
+	typedef typename geometry_traits<TElem>::iterator TIter;
+	for(TIter iter = m_pGrid->begin<TElem>(); iter != m_pGrid->end<TElem>(); ++iter)
+		elems[(*iter)->grid_data_index()] = *iter;
+}
+
+void BoolMarker::release_element_maps()
+{
+	if(!m_pGrid)
+		return;
+	if(m_vElems[VERTEX])	m_pGrid->detach_from<Vertex>(m_aElem);
+	if(m_vElems[EDGE])		m_pGrid->detach_from<Edge>(m_aElem);
+	if(m_vElems[FACE])		m_pGrid->detach_from<Face>(m_aElem);
+	if(m_vElems[VOLUME])	m_pGrid->detach_from<Volume>(m_aElem);
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+		m_vElems[i] = NULL;
+}
+
 
 bool BoolMarker::is_marked(GridObject* e) const
 {
@@ -105,10 +155,38 @@ void BoolMarker::grid_to_be_destroyed(Grid* grid)
 void BoolMarker::clear()
 {
 	assert(m_pGrid);
-	unmark(m_pGrid->begin<Vertex>(), m_pGrid->end<Vertex>());
-	unmark(m_pGrid->begin<Edge>(), m_pGrid->end<Edge>());
-	unmark(m_pGrid->begin<Face>(), m_pGrid->end<Face>());
-	unmark(m_pGrid->begin<Volume>(), m_pGrid->end<Volume>());
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+		m_vBits[i]->reset_all();
+}
+
+size_t BoolMarker::num_marked() const
+{
+	assert(m_pGrid);
+	size_t num = 0;
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+		num += m_vBits[i]->count();
+	return num;
+}
+
+void BoolMarker::unite(const BoolMarker& marker)
+{
+	assert(m_pGrid && (m_pGrid == marker.m_pGrid));
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+		m_vBits[i]->unite(*marker.m_vBits[i]);
+}
+
+void BoolMarker::intersect(const BoolMarker& marker)
+{
+	assert(m_pGrid && (m_pGrid == marker.m_pGrid));
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+		m_vBits[i]->intersect(*marker.m_vBits[i]);
+}
+
+void BoolMarker::subtract(const BoolMarker& marker)
+{
+	assert(m_pGrid && (m_pGrid == marker.m_pGrid));
+	for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+		m_vBits[i]->subtract(*marker.m_vBits[i]);
 }
 
 
@@ -116,6 +194,8 @@ void BoolMarker::
 vertex_created(Grid* grid, Vertex* vrt, GridObject* pParent,
 				bool replacesParent)
 {
+	add_to_element_map(vrt);
+
 	if(!pParent){
 		mark(vrt, default_mark());
 		return;
@@ -136,6 +216,8 @@ void BoolMarker::
 edge_created(Grid* grid, Edge* e, GridObject* pParent,
 			 bool replacesParent)
 {
+	add_to_element_map(e);
+
 	if(!pParent){
 		mark(e, default_mark());
 		return;
@@ -156,6 +238,8 @@ void BoolMarker::
 face_created(Grid* grid, Face* f, GridObject* pParent,
 			 bool replacesParent)
 {
+	add_to_element_map(f);
+
 	if(!pParent){
 		mark(f, default_mark());
 		return;
@@ -176,6 +260,8 @@ void BoolMarker::
 volume_created(Grid* grid, Volume* vol, GridObject* pParent,
 			   bool replacesParent)
 {
+	add_to_element_map(vol);
+
 	if(!pParent){
 		mark(vol, default_mark());
 		return;
@@ -192,6 +278,30 @@ volume_created(Grid* grid, Volume* vol, GridObject* pParent,
 	mark(vol, default_mark());
 }
 
+void BoolMarker::
+vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy)
+{
+	mark(vrt, false);
+}
+
+void BoolMarker::
+edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy)
+{
+	mark(e, false);
+}
+
+void BoolMarker::
+face_to_be_erased(Grid* grid, Face* f, Face* replacedBy)
+{
+	mark(f, false);
+}
+
+void BoolMarker::
+volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy)
+{
+	mark(vol, false);
+}
+
 void BoolMarker::
 vertices_to_be_merged(Grid* grid, Vertex* target,
 					  Vertex* elem1, Vertex* elem2)
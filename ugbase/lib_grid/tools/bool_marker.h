@@ -33,8 +33,10 @@
 #ifndef __H__UG__bool_marker__
 #define __H__UG__bool_marker__
 
+#include <vector>
 #include "lib_grid/grid/grid.h"
 #include "lib_grid/common_attachments.h"
+#include "lib_grid/attachments/bit_attachment.h"
 
 namespace ug
 {
@@ -44,10 +46,14 @@ namespace ug
 
 ///	Allows to mark elements.
 /** This class allows to mark elements of a grid.
- * The BoolMarker associates a bool with each element.
- * Note that clearing the marks has a runtime complexity of O(n). If you need
- * marks for repeatedly called local algorithms you may want to use Grid::mark
- * instead, which has a clear_marks method with runtime complexity of O(1).
+ * The BoolMarker associates a bit with each element. The bits are stored in
+ * a BitAttachment, indexed by the grid data index of the elements. Operations
+ * on all marks of an element type (clear, num_marked, unite, intersect,
+ * subtract, for_each_marked) thus process 64 elements at once.
+ * Note that clearing the marks still has a runtime complexity of O(n/64). If
+ * you need marks for repeatedly called local algorithms you may want to use
+ * Grid::mark instead, which has a clear_marks method with runtime complexity
+ * of O(1).
  *
  * Note that methods like mark, unmark, is_marked, clear, ... may only be invoked,
  * if a grid was assigned through either assign_grid or through the constructor.
@@ -101,15 +107,15 @@ class BoolMarker : public GridObserver
 
 
 		bool is_marked(GridObject* e) const;
-		bool is_marked(Vertex* e) const			{assert(m_pGrid); return m_aaMarkVRT[e];}
-		bool is_marked(Edge* e)	const			{assert(m_pGrid); return m_aaMarkEDGE[e];}
-		bool is_marked(Face* e)	const				{assert(m_pGrid); return m_aaMarkFACE[e];}
-		bool is_marked(Volume* e) const				{assert(m_pGrid); return m_aaMarkVOL[e];}
+		bool is_marked(Vertex* e) const			{return bits<Vertex>().test(e->grid_data_index());}
+		bool is_marked(Edge* e)	const			{return bits<Edge>().test(e->grid_data_index());}
+		bool is_marked(Face* e)	const				{return bits<Face>().test(e->grid_data_index());}
+		bool is_marked(Volume* e) const				{return bits<Volume>().test(e->grid_data_index());}
 
-		void mark(Vertex* e, bool mark = true)	{assert(m_pGrid); m_aaMarkVRT[e] = mark;}
-		void mark(Edge* e, bool mark = true)	{assert(m_pGrid); m_aaMarkEDGE[e] = mark;}
-		void mark(Face* e, bool mark = true)		{assert(m_pGrid); m_aaMarkFACE[e] = mark;}
-		void mark(Volume* e, bool mark = true)		{assert(m_pGrid); m_aaMarkVOL[e] = mark;}
+		void mark(Vertex* e, bool mark = true)	{bits<Vertex>().set(e->grid_data_index(), mark);}
+		void mark(Edge* e, bool mark = true)	{bits<Edge>().set(e->grid_data_index(), mark);}
+		void mark(Face* e, bool mark = true)		{bits<Face>().set(e->grid_data_index(), mark);}
+		void mark(Volume* e, bool mark = true)		{bits<Volume>().set(e->grid_data_index(), mark);}
 
 		template <class TIter>
 		void mark(TIter begin, TIter end, bool mark = true)
@@ -125,9 +131,69 @@ class BoolMarker : public GridObserver
 		template <class TIter>
 		void unmark(TIter begin, TIter end)			{mark(begin, end, false);}
 
-	///	Sets all marks to false. O(n).
+	///	Sets all marks to false. O(n/64).
 		void clear();
 
+	///	Sets the marks of all elements of type TElem to false. O(n/64).
+	/**	TElem has to be one of Vertex, Edge, Face or Volume.*/
+		template <class TElem>
+		void clear()								{bits<TElem>().reset_all();}
+
+	///	returns the number of marked elements of type TElem. O(n/64).
+	/**	TElem has to be one of Vertex, Edge, Face or Volume.*/
+		template <class TElem>
+		size_t num_marked() const					{return bits<TElem>().count();}
+
+	///	returns the number of marked elements of all types. O(n/64).
+		size_t num_marked() const;
+
+	///	Marks all elements which are marked in the given marker. O(n/64).
+	/**	Both markers have to operate on the same grid.*/
+		void unite(const BoolMarker& marker);
+
+	///	Unmarks all elements which are not marked in the given marker. O(n/64).
+	/**	Both markers have to operate on the same grid.*/
+		void intersect(const BoolMarker& marker);
+
+	///	Unmarks all elements which are marked in the given marker. O(n/64).
+	/**	Both markers have to operate on the same grid.*/
+		void subtract(const BoolMarker& marker);
+
+	///	calls func(TElem*) for each marked element of type TElem
+	/**	Only the words which contain set bits are visited, so that the runtime
+	 * is O(n/64 + m), where m is the number of marked elements. Elements are
+	 * visited in the order of their grid data indices. func must not create
+	 * or erase elements.
+	 *
+	 * To map a set bit back to its element, the marker attaches an element
+	 * map to the base type of TElem on the first call. Filling it is O(n),
+	 * afterwards it is kept up to date on element creation. It costs one
+	 * pointer per element and can be released through release_element_maps.*/
+		template <class TElem, class TFunc>
+		void for_each_marked(TFunc func) const
+		{
+			assert(m_pGrid);
+			typedef typename TElem::grid_base_object TBaseElem;
+			const int id = geometry_traits<TBaseElem>::BASE_OBJECT_ID;
+			if(!m_vElems[id])
+				attach_element_map(id);
+			m_vBits[id]->for_each_set_bit(ElemFunc<TElem, TFunc>(*m_vElems[id], func));
+		}
+
+	///	collects all marked elements of type TElem in elemsOut. O(n/64 + m).
+	/**	elemsOut is cleared before the elements are added.
+	 * See for_each_marked for more information.*/
+		template <class TElem>
+		void collect_marked(std::vector<TElem*>& elemsOut) const
+		{
+			elemsOut.clear();
+			elemsOut.reserve(num_marked<typename TElem::grid_base_object>());
+			for_each_marked<TElem>(PushBack<TElem>(elemsOut));
+		}
+
+	///	releases the element maps which were attached by for_each_marked
+		void release_element_maps();
+
 	///	derived from GridObserver
 		virtual void grid_to_be_destroyed(Grid* grid);
 
@@ -148,6 +214,18 @@ class BoolMarker : public GridObserver
 									GridObject* pParent = NULL,
 									bool replacesParent = false);
 
+		virtual void vertex_to_be_erased(Grid* grid, Vertex* vrt,
+										 Vertex* replacedBy = NULL);
+
+		virtual void edge_to_be_erased(Grid* grid, Edge* e,
+										 Edge* replacedBy = NULL);
+
+		virtual void face_to_be_erased(Grid* grid, Face* f,
+										 Face* replacedBy = NULL);
+
+		virtual void volume_to_be_erased(Grid* grid, Volume* vol,
+										 Volume* replacedBy = NULL);
+
 		virtual void vertices_to_be_merged(Grid* grid, Vertex* target,
 										 Vertex* elem1, Vertex* elem2);
 
@@ -161,15 +239,76 @@ class BoolMarker : public GridObserver
 										 Volume* elem1, Volume* elem2);
 
 	protected:
-		Grid*	m_pGrid;
-		ABool	m_aBool;
+		typedef Attachment<GridObject*>				AGridObject;
+		typedef AGridObject::ContainerType			ElemContainer;
+
+		template <class TElem>
+		BitAttachmentDataContainer& bits()
+		{
+			assert(m_pGrid);
+			return *m_vBits[geometry_traits<TElem>::BASE_OBJECT_ID];
+		}
+
+		template <class TElem>
+		const BitAttachmentDataContainer& bits() const
+		{
+			assert(m_pGrid);
+			return *m_vBits[geometry_traits<TElem>::BASE_OBJECT_ID];
+		}
+
+		template <class TElem>
+		void register_elements();
+
+	///	attaches the element map for the given base object id and fills it
+		void attach_element_map(int baseObjectId) const;
+
+		template <class TElem>
+		void attach_element_map() const;
+
+	///	stores e at its data index in the element map of its base type, if it exists
+		template <class TElem>
+		void add_to_element_map(TElem* e)
+		{
+			ElemContainer* elems = m_vElems[geometry_traits<TElem>::BASE_OBJECT_ID];
+			if(elems)
+				(*elems)[e->grid_data_index()] = e;
+		}
+
+	///	maps the indices of set bits to elements for for_each_marked
+	/**	If TElem is not a base object type, elements of other types in the
+	 * same base type are skipped.*/
+		template <class TElem, class TFunc>
+		struct ElemFunc{
+			ElemFunc(const ElemContainer& elems, TFunc& func) :
+				m_elems(elems), m_func(func)	{}
+			void operator()(size_t index)
+			{
+				GridObject* o = m_elems[index];
+				const int section = geometry_traits<TElem>::CONTAINER_SECTION;
+				if(section == -1 || o->container_section() == section)
+					m_func(static_cast<TElem*>(o));
+			}
+			const ElemContainer&	m_elems;
+			TFunc&					m_func;
+		};
+
+		template <class TElem>
+		struct PushBack{
+			PushBack(std::vector<TElem*>& vec) : m_vec(vec)	{}
+			void operator()(TElem* e)		{m_vec.push_back(e);}
+			std::vector<TElem*>&	m_vec;
+		};
+
+	protected:
+		Grid*			m_pGrid;
+		BitAttachment	m_aBits;
 		bool	m_defaultMark;
 		bool	m_markInheritanceEnabled;
 		bool	m_strictInheritanceEnabled;
-		Grid::AttachmentAccessor<Vertex, ABool>	m_aaMarkVRT;
-		Grid::AttachmentAccessor<Edge, ABool>	m_aaMarkEDGE;
-		Grid::AttachmentAccessor<Face, ABool>		m_aaMarkFACE;
-		Grid::AttachmentAccessor<Volume, ABool>		m_aaMarkVOL;
+		BitAttachmentDataContainer*	m_vBits[NUM_GEOMETRIC_BASE_OBJECTS];
+	///	each element is stored at its grid data index. Only attached on demand.
+		mutable AGridObject			m_aElem;
+		mutable ElemContainer*		m_vElems[NUM_GEOMETRIC_BASE_OBJECTS];
 };
 
 /** \} */
@@ -141,6 +141,9 @@ refresh_surface_states()
 		case VERTEX: refresh_surface_states<Vertex>(); break;
 		default: break;
 	}
+
+	if(m_bSurfElemLists)
+		enable_surface_element_lists(true);
 }
 
 template <class TElem>
@@ -195,6 +198,106 @@ refresh_surface_states()
 	adjust_parallel_surface_states<Volume>();
 }
 
+void SurfaceView::
+enable_surface_element_lists(bool enable)
+{
+	m_bSurfElemLists = enable;
+	if(enable){
+		SPMessageHub msgHub = m_pMG->message_hub();
+		if(!m_spAdaptionCallbackID.valid()){
+			m_spAdaptionCallbackID = msgHub->register_class_callback(
+								this, &SurfaceView::grid_adaption_callback);
+		}
+		if(!m_spDistributionCallbackID.valid()){
+			m_spDistributionCallbackID = msgHub->register_class_callback(
+								this, &SurfaceView::grid_distribution_callback);
+		}
+
+		build_surface_element_list<Vertex>();
+		build_surface_element_list<Edge>();
+		build_surface_element_list<Face>();
+		build_surface_element_list<Volume>();
+		m_surfElemListNumSubsets = m_spMGSH->num_subsets();
+		m_surfElemListNumLevels = (int)m_spMGSH->num_levels();
+		m_bSurfElemListsValid = true;
+	}
+	else{
+		m_bSurfElemListsValid = false;
+		m_spAdaptionCallbackID = SPNULL;
+		m_spDistributionCallbackID = SPNULL;
+		for(int i = 0; i < 4; ++i){
+			std::vector<GridObject*>().swap(m_vSurfElemList[i].elems);
+			std::vector<size_t>().swap(m_vSurfElemList[i].offsets);
+		}
+	}
+}
+
+///	number of container sections of the base object types
+static int NumContainerSections(Vertex*)	{return CSVRT_CONSTRAINED_VERTEX + 1;}
+static int NumContainerSections(Edge*)		{return CSEDGE_CONSTRAINING_EDGE + 1;}
+static int NumContainerSections(Face*)		{return CSFACE_USER;}
+static int NumContainerSections(Volume*)	{return CSVOL_OCTAHEDRON + 1;}
+
+template <class TElem>
+void SurfaceView::
+build_surface_element_list()
+{
+	typedef typename geometry_traits<TElem>::const_iterator	ElemIter;
+
+	const MGSubsetHandler& sh = *m_spMGSH;
+	const int numSubsets = sh.num_subsets();
+	const int numLevels = (int)sh.num_levels();
+	const int topLvl = numLevels - 1;
+
+	SurfaceElementList& list = m_vSurfElemList[TElem::BASE_OBJECT_ID];
+	const int numSecs = NumContainerSections((TElem*)NULL);
+	list.numSections = numSecs;
+	list.elems.clear();
+	list.elems.reserve(m_pMG->num<TElem>());
+	list.offsets.clear();
+	list.offsets.reserve(numSubsets * numLevels * numSecs + 1);
+
+//	Elements of a subset and level are stored section by section. Pure
+//	shadows and ghosts below the top level are never part of the surface of
+//	the top level and are thus not stored.
+	for(int si = 0; si < numSubsets; ++si){
+		for(int lvl = 0; lvl < numLevels; ++lvl){
+			const size_t firstOffset = list.offsets.size();
+			for(ElemIter iter = sh.begin<TElem>(si, lvl);
+				iter != sh.end<TElem>(si, lvl); ++iter)
+			{
+				TElem* e = *iter;
+				const int sec = min(e->container_section(), numSecs - 1);
+				while((int)(list.offsets.size() - firstOffset) <= sec)
+					list.offsets.push_back(list.elems.size());
+
+				if((lvl == topLvl)
+					|| !(is_ghost(e) || (surface_state(e) == MG_SHADOW_PURE)))
+				{
+					list.elems.push_back(e);
+				}
+			}
+			while((int)(list.offsets.size() - firstOffset) < numSecs)
+				list.offsets.push_back(list.elems.size());
+		}
+	}
+	list.offsets.push_back(list.elems.size());
+}
+
+void SurfaceView::
+grid_adaption_callback(const GridMessage_Adaption& msg)
+{
+	if(!(msg.adaption_ends() || msg.step_ends()))
+		m_bSurfElemListsValid = false;
+}
+
+void SurfaceView::
+grid_distribution_callback(const GridMessage_Distribution& msg)
+{
+	if(msg.msg() == GMDT_DISTRIBUTION_STARTS)
+		m_bSurfElemListsValid = false;
+}
+
 template <class TElem, class TSide>
 void SurfaceView::
 mark_sides_as_surface_or_shadow(TElem* elem, byte surfaceState)
@@ -319,7 +422,11 @@ SurfaceView::SurfaceView(SmartPtr<MGSubsetHandler> spMGSH,
 	m_spMGSH(spMGSH),
 	m_adaptiveMG(adaptiveMG),
 	m_pMG(m_spMGSH->multi_grid()),
-	m_distGridMgr(m_spMGSH->multi_grid()->distributed_grid_manager())
+	m_distGridMgr(m_spMGSH->multi_grid()->distributed_grid_manager()),
+	m_bSurfElemLists(false),
+	m_bSurfElemListsValid(false),
+	m_surfElemListNumSubsets(0),
+	m_surfElemListNumLevels(0)
 {
 	UG_ASSERT(m_pMG, "A MultiGrid has to be assigned to the given subset handler");
 
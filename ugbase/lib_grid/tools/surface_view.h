@@ -37,6 +37,7 @@
 	#include "lib_grid/parallelization/distributed_grid.h"
 #endif
 
+#include <vector>
 #include "lib_grid/multi_grid.h"
 #include "lib_grid/tools/grid_level.h"
 #include "subset_handler_multi_grid.h"
@@ -152,6 +153,35 @@ class SurfaceView
 	///	refresh_surface_states must be called after a grid change
 		void refresh_surface_states();
 
+	///	enables contiguous lists of surface elements, built in refresh_surface_states
+	/**	If enabled, refresh_surface_states stores all elements which may be
+	 * part of the surface of the top level in one array per base object type,
+	 * ordered by subset, level and container section. Iterators over the
+	 * surface of the top level then run over these arrays instead of visiting
+	 * all elements of all levels. The iteration order does not change.
+	 *
+	 * The lists are invalidated as soon as a grid adaption or redistribution
+	 * begins and are rebuilt by the next call to refresh_surface_states. In
+	 * between, all iterators use level-wise iteration. Disabled by default.*/
+		void enable_surface_element_lists(bool enable);
+
+	///	returns whether surface element lists are enabled
+		bool surface_element_lists_enabled() const	{return m_bSurfElemLists;}
+
+	///	returns the range of candidate surface elements of a subset and level
+	/**	The range contains all elements of type TElem in the given subset and
+	 * level which may be contained in the surface of the top level with the
+	 * given states. Elements still have to be checked with is_contained.
+	 * Since the range is a plain array, it may be split for threaded loops.
+	 *
+	 * \returns false if no valid list exists for the given grid level and
+	 *			states. The range is not set in this case.*/
+		template <class TElem>
+		bool surface_element_range(GridObject* const*& beginOut,
+								   GridObject* const*& endOut,
+								   int si, int lvl, const GridLevel& gl,
+								   SurfaceState validStates) const;
+
 	///	returns an or combination of current surface states
 	/**	Please use the methods is_surface_element, is_shadowed and is_shadowing
 	 * instead of this method.
@@ -218,6 +248,12 @@ class SurfaceView
 			///	dereference
 				inline TValue dereference() const;
 
+			///	sets the element range of the current subset and level
+				inline void set_section();
+
+			///	returns true if the current section has been traversed
+				inline bool section_end_reached() const;
+
 			private:
 				SurfaceView* m_pSurfView;
 				GridLevel m_gl;
@@ -229,6 +265,10 @@ class SurfaceView
 				int m_lvl;
 				typename geometry_traits<TElem>::iterator m_elemIter;
 				typename geometry_traits<TElem>::iterator m_iterEndSection;
+			//	used instead of m_elemIter if a surface element list is iterated
+				bool m_bList;
+				GridObject* const* m_listIter;
+				GridObject* const* m_listEndSection;
 		};
 
 	///	Const iterator to traverse the surface of a multi-grid hierarchy
@@ -280,6 +320,12 @@ class SurfaceView
 			///	dereference
 				inline TValue dereference() const;
 
+			///	sets the element range of the current subset and level
+				inline void set_section();
+
+			///	returns true if the current section has been traversed
+				inline bool section_end_reached() const;
+
 			private:
 				const SurfaceView* m_pSurfView;
 				GridLevel m_gl;
@@ -291,6 +337,10 @@ class SurfaceView
 				int m_lvl;
 				typename geometry_traits<TElem>::const_iterator m_elemIter;
 				typename geometry_traits<TElem>::const_iterator m_iterEndSection;
+			//	used instead of m_elemIter if a surface element list is iterated
+				bool m_bList;
+				GridObject* const* m_listIter;
+				GridObject* const* m_listEndSection;
 			};
 
 	public:
@@ -369,6 +419,30 @@ class SurfaceView
 		template <class TElem>
 		bool is_vmaster(TElem* elem) const;
 
+	///	candidate surface elements of one base object type
+		struct SurfaceElementList{
+			std::vector<GridObject*>	elems;
+		///	first entry of each (subset, level, section) block, followed by elems.size()
+			std::vector<size_t>			offsets;
+			int							numSections;
+		};
+
+	///	fills the surface element list of the given base object type
+		template <class TElem>
+		void build_surface_element_list();
+
+	///	returns the range of the surface element list for the given subset and level
+		template <class TElem>
+		void surface_element_list_range(GridObject* const*& beginOut,
+										GridObject* const*& endOut,
+										int si, int lvl) const;
+
+	///	invalidates the surface element lists if a grid adaption begins
+		void grid_adaption_callback(const GridMessage_Adaption& msg);
+
+	///	invalidates the surface element lists if a redistribution begins
+		void grid_distribution_callback(const GridMessage_Distribution& msg);
+
 	private:
 		SmartPtr<MGSubsetHandler> 		m_spMGSH;
 		bool							m_adaptiveMG;
@@ -376,6 +450,14 @@ class SurfaceView
 		DistributedGridManager*			m_distGridMgr;
 		ASurfaceState									m_aSurfState;
 		MultiElementAttachmentAccessor<ASurfaceState>	m_aaSurfState;
+
+		bool						m_bSurfElemLists;
+		bool						m_bSurfElemListsValid;
+		int							m_surfElemListNumSubsets;
+		int							m_surfElemListNumLevels;
+		SurfaceElementList			m_vSurfElemList[4];
+		MessageHub::SPCallbackId	m_spAdaptionCallbackID;
+		MessageHub::SPCallbackId	m_spDistributionCallbackID;
 };
 
 /** \} */
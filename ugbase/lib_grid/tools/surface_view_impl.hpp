@@ -59,8 +59,11 @@ SurfaceViewElementIterator(bool start,
 
 	m_elemIter(start ? sv->subset_handler()->begin<TElem>(m_si, m_lvl)
 					 : sv->subset_handler()->end<TElem>(m_toSI, m_topLvl)),
-	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl))
+	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl)),
 
+	m_bList(false),
+	m_listIter(NULL),
+	m_listEndSection(NULL)
 {
 	UG_ASSERT(m_topLvl >= 0 && m_topLvl < (int)sv->subset_handler()->num_levels(),
 	          "Invalid level: "<<m_topLvl<<" [min: 0, max: "<<sv->subset_handler()->num_levels()<<"]");
@@ -71,13 +74,22 @@ SurfaceViewElementIterator(bool start,
 	UG_ASSERT(m_toSI >= 0 && m_toSI < sv->subset_handler()->num_subsets(),
 	          "Invalid subset: "<<m_toSI<<" [min: 0, max: "<<sv->subset_handler()->num_subsets()<<"]");
 
+//	iterate the surface element list instead of the levels, if available
+	GridObject* const* listBegin;
+	GridObject* const* listEnd;
+	if(sv->surface_element_range<TElem>(listBegin, listEnd, m_si, m_lvl, gl, validStates)){
+		m_bList = true;
+		m_listIter = start ? listBegin : listEnd;
+		m_listEndSection = listEnd;
+	}
+
 //	if at end of section -> increase until next non-empty section
-	if(m_elemIter == m_iterEndSection)
+	if(section_end_reached())
 		if(!increment_section())
 			return;
 
 //	m_elemIter has to point to a valid surface view element
-	if(!is_contained(*m_elemIter)){increment(); return;}
+	if(!is_contained(dereference())){increment(); return;}
 }
 
 template <class TElem>
@@ -92,13 +104,18 @@ SurfaceViewElementIterator() :
 	m_topLvl(0),
 	m_lvl(0),
 	m_elemIter(),
-	m_iterEndSection()
+	m_iterEndSection(),
+	m_bList(false),
+	m_listIter(NULL),
+	m_listEndSection(NULL)
 {}
 
 template <class TElem>
 bool SurfaceView::SurfaceViewElementIterator<TElem>::
 equal(SurfaceView::SurfaceViewElementIterator<TElem> const& other) const
 {
+	if(m_bList)
+		return (m_listIter == other.m_listIter);
 	return (m_elemIter == other.m_elemIter);
 }
 
@@ -114,8 +131,7 @@ increment_section()
 		{
 		//	increase subset, set new section iterators
 			++m_si;
-			m_elemIter = m_pSurfView->subset_handler()->begin<TElem>(m_si, m_lvl);
-			m_iterEndSection = m_pSurfView->subset_handler()->end<TElem>(m_si, m_lvl);
+			set_section();
 		}
 	//	b) if still levels left to be looped
 		else if(m_lvl < m_topLvl)
@@ -123,15 +139,14 @@ increment_section()
 		//	increase level, reset subset to fromSubset, set new section iterators
 			++m_lvl;
 			m_si = m_fromSI;
-			m_elemIter = m_pSurfView->subset_handler()->begin<TElem>(m_si, m_lvl);
-			m_iterEndSection = m_pSurfView->subset_handler()->end<TElem>(m_si, m_lvl);
+			set_section();
 		}
 	//	c) no section left, we're done (m_elemIter is end iterator now)
 		else {
 			return false;
 		}
 	}
-	while(m_elemIter == m_iterEndSection);
+	while(section_end_reached());
 	return true;
 }
 
@@ -143,15 +158,16 @@ increment()
 	do
 	{
 	//	increase iterator
-		++m_elemIter;
+		if(m_bList) ++m_listIter;
+		else ++m_elemIter;
 
 	//	check if end of section reached
-		if(m_elemIter == m_iterEndSection){
+		if(section_end_reached()){
 			if(!increment_section())
 				return;
 		}
 
-	}while(!is_contained(*m_elemIter));
+	}while(!is_contained(dereference()));
 }
 
 template <class TElem>
@@ -159,9 +175,33 @@ typename SurfaceView::SurfaceViewElementIterator<TElem>::TValue
 SurfaceView::SurfaceViewElementIterator<TElem>::
 dereference() const
 {
+	if(m_bList)
+		return static_cast<TValue>(*m_listIter);
 	return *m_elemIter;
 }
 
+template <class TElem>
+void SurfaceView::SurfaceViewElementIterator<TElem>::
+set_section()
+{
+	if(m_bList)
+		m_pSurfView->surface_element_list_range<TElem>(m_listIter, m_listEndSection,
+													   m_si, m_lvl);
+	else{
+		m_elemIter = m_pSurfView->subset_handler()->begin<TElem>(m_si, m_lvl);
+		m_iterEndSection = m_pSurfView->subset_handler()->end<TElem>(m_si, m_lvl);
+	}
+}
+
+template <class TElem>
+bool SurfaceView::SurfaceViewElementIterator<TElem>::
+section_end_reached() const
+{
+	if(m_bList)
+		return m_listIter == m_listEndSection;
+	return m_elemIter == m_iterEndSection;
+}
+
 template <class TElem>
 template <class TGeomObj>
 bool SurfaceView::SurfaceViewElementIterator<TElem>::
@@ -205,6 +245,9 @@ ConstSurfaceViewElementIterator(const SurfaceView::SurfaceViewElementIterator<TE
 	m_lvl = iter.m_lvl;
 	m_elemIter = iter.m_elemIter;
 	m_iterEndSection = iter.m_iterEndSection;
+	m_bList = iter.m_bList;
+	m_listIter = iter.m_listIter;
+	m_listEndSection = iter.m_listEndSection;
 }
 
 template <class TElem>
@@ -219,7 +262,10 @@ ConstSurfaceViewElementIterator() :
 	m_topLvl(0),
 	m_lvl(0),
 	m_elemIter(),
-	m_iterEndSection()
+	m_iterEndSection(),
+	m_bList(false),
+	m_listIter(NULL),
+	m_listEndSection(NULL)
 {}
 
 template <class TElem>
@@ -242,8 +288,11 @@ ConstSurfaceViewElementIterator(bool start,
 
 	m_elemIter(start ? sv->subset_handler()->begin<TElem>(m_si, m_lvl)
 					 : sv->subset_handler()->end<TElem>(m_toSI, m_topLvl)),
-	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl))
+	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl)),
 
+	m_bList(false),
+	m_listIter(NULL),
+	m_listEndSection(NULL)
 {
 	UG_ASSERT(m_topLvl >= 0 && m_topLvl < (int)sv->subset_handler()->num_levels(),
 			  "Invalid level: "<<m_topLvl<<" [min: 0, max: "<<sv->subset_handler()->num_levels()<<"]");
@@ -254,19 +303,30 @@ ConstSurfaceViewElementIterator(bool start,
 	UG_ASSERT(m_toSI >= 0 && m_toSI < sv->subset_handler()->num_subsets(),
 			  "Invalid subset: "<<m_toSI<<" [min: 0, max: "<<sv->subset_handler()->num_subsets()<<"]");
 
+//	iterate the surface element list instead of the levels, if available
+	GridObject* const* listBegin;
+	GridObject* const* listEnd;
+	if(sv->surface_element_range<TElem>(listBegin, listEnd, m_si, m_lvl, gl, validStates)){
+		m_bList = true;
+		m_listIter = start ? listBegin : listEnd;
+		m_listEndSection = listEnd;
+	}
+
 //	if at end of section -> increase until next non-empty section
-	if(m_elemIter == m_iterEndSection)
+	if(section_end_reached())
 		if(!increment_section())
 			return;
 
 //	m_elemIter has to point to a valid surface view element
-	if(!is_contained(*m_elemIter)){increment(); return;}
+	if(!is_contained(dereference())){increment(); return;}
 }
 
 template <class TElem>
 bool SurfaceView::ConstSurfaceViewElementIterator<TElem>::
 equal(SurfaceView::ConstSurfaceViewElementIterator<TElem> const& other) const
 {
+	if(m_bList)
+		return (m_listIter == other.m_listIter);
 	return (m_elemIter == other.m_elemIter);
 }
 
@@ -282,8 +342,7 @@ increment_section()
 		{
 		//	increase subset, set new section iterators
 			++m_si;
-			m_elemIter = m_pSurfView->subset_handler()->begin<TElem>(m_si, m_lvl);
-			m_iterEndSection = m_pSurfView->subset_handler()->end<TElem>(m_si, m_lvl);
+			set_section();
 		}
 	//	b) if still levels left to be looped
 		else if(m_lvl < m_topLvl)
@@ -291,15 +350,14 @@ increment_section()
 		//	increase level, reset subset to fromSubset, set new section iterators
 			++m_lvl;
 			m_si = m_fromSI;
-			m_elemIter = m_pSurfView->subset_handler()->begin<TElem>(m_si, m_lvl);
-			m_iterEndSection = m_pSurfView->subset_handler()->end<TElem>(m_si, m_lvl);
+			set_section();
 		}
 	//	c) no section left, we're done (m_elemIter is end iterator now)
 		else {
 			return false;
 		}
 	}
-	while(m_elemIter == m_iterEndSection);
+	while(section_end_reached());
 	return true;
 }
 
@@ -313,14 +371,15 @@ increment()
 	do
 	{
 	//	increase iterator
-		++m_elemIter;
+		if(m_bList) ++m_listIter;
+		else ++m_elemIter;
 
 	//	check if end of section reached
-		if(m_elemIter == m_iterEndSection){
+		if(section_end_reached()){
 			if(!increment_section())
 				return;
 		}
-	}while(!is_contained(*m_elemIter));
+	}while(!is_contained(dereference()));
 }
 
 template <class TElem>
@@ -328,9 +387,33 @@ typename SurfaceView::ConstSurfaceViewElementIterator<TElem>::TValue
 SurfaceView::ConstSurfaceViewElementIterator<TElem>::
 dereference() const
 {
+	if(m_bList)
+		return static_cast<TValue>(*m_listIter);
 	return *m_elemIter;
 }
 
+template <class TElem>
+void SurfaceView::ConstSurfaceViewElementIterator<TElem>::
+set_section()
+{
+	if(m_bList)
+		m_pSurfView->surface_element_list_range<TElem>(m_listIter, m_listEndSection,
+													   m_si, m_lvl);
+	else{
+		m_elemIter = m_pSurfView->subset_handler()->begin<TElem>(m_si, m_lvl);
+		m_iterEndSection = m_pSurfView->subset_handler()->end<TElem>(m_si, m_lvl);
+	}
+}
+
+template <class TElem>
+bool SurfaceView::ConstSurfaceViewElementIterator<TElem>::
+section_end_reached() const
+{
+	if(m_bList)
+		return m_listIter == m_listEndSection;
+	return m_elemIter == m_iterEndSection;
+}
+
 template <class TElem>
 template <class TGeomObj>
 bool SurfaceView::ConstSurfaceViewElementIterator<TElem>::
@@ -527,6 +610,49 @@ bool SurfaceView::is_vmaster(TElem* elem) const
 	#endif
 }
 
+template <class TElem>
+bool SurfaceView::
+surface_element_range(GridObject* const*& beginOut, GridObject* const*& endOut,
+					  int si, int lvl, const GridLevel& gl,
+					  SurfaceState validStates) const
+{
+//	lists only contain candidates for the surface of the top level. Pure
+//	shadows below the top level are not contained in them.
+	if(!(m_bSurfElemListsValid && gl.is_surface() && gl.top())
+		|| validStates.partially_contains(MG_SHADOW_PURE)
+		|| (m_surfElemListNumSubsets != m_spMGSH->num_subsets())
+		|| (m_surfElemListNumLevels != (int)m_spMGSH->num_levels()))
+	{
+		return false;
+	}
+
+	surface_element_list_range<TElem>(beginOut, endOut, si, lvl);
+	return true;
+}
+
+template <class TElem>
+void SurfaceView::
+surface_element_list_range(GridObject* const*& beginOut, GridObject* const*& endOut,
+						   int si, int lvl) const
+{
+	const SurfaceElementList& list =
+		m_vSurfElemList[geometry_traits<TElem>::grid_base_object::BASE_OBJECT_ID];
+	const int sec = geometry_traits<TElem>::CONTAINER_SECTION;
+	const size_t block = (si * m_surfElemListNumLevels + lvl) * list.numSections;
+	GridObject* const* elems = list.elems.empty() ? NULL : &list.elems.front();
+
+	if(sec < 0){
+		beginOut = elems + list.offsets[block];
+		endOut = elems + list.offsets[block + list.numSections];
+	}
+	else if(sec < list.numSections){
+		beginOut = elems + list.offsets[block + sec];
+		endOut = elems + list.offsets[block + sec + 1];
+	}
+	else
+		beginOut = endOut = elems + list.offsets[block + list.numSections];
+}
+
 template <typename TElem, typename TBaseElem>
 void SurfaceView::
 collect_associated(std::vector<TBaseElem*>& vAssElem,
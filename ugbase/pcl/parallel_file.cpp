@@ -30,10 +30,12 @@
  * GNU Lesser General Public License for more details.
  */
 
+#include "parallel_file.h"
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
 #include "common/log.h"
 #include <map>
+#include <algorithm>
 #include <string>
 #include <mpi.h>
 
@@ -136,4 +138,81 @@ void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename,
 	//	UG_LOG("File read.\n");
 }
 
+
+SharedFileWriter::SharedFileWriter(std::string strFilename, pcl::ProcessCommunicator pc) :
+	m_bOpen(false)
+{
+	char filename[1024];
+	strcpy(filename, strFilename.c_str());
+
+	if(MPI_File_open(pc.get_mpi_communicator(), filename, MPI_MODE_CREATE | MPI_MODE_WRONLY,
+					 MPI_INFO_NULL, &m_fh))
+		UG_THROW("could not open "<<filename);
+	m_bOpen = true;
+
+	MPI_File_set_size(m_fh, 0);
+}
+
+SharedFileWriter::~SharedFileWriter()
+{
+	close();
+}
+
+void SharedFileWriter::write_at(long long offset, const void* data, size_t size)
+{
+	UG_COND_THROW(!m_bOpen, "SharedFileWriter: file is not open.");
+
+//	MPI counts are ints, so large blocks are written in chunks
+	const size_t maxChunk = 1 << 30;
+	const char* p = static_cast<const char*>(data);
+	while(size > 0){
+		int chunk = (int)std::min(size, maxChunk);
+		MPI_Status status;
+		if(MPI_File_write_at(m_fh, offset, const_cast<char*>(p), chunk, MPI_BYTE, &status))
+			UG_THROW("SharedFileWriter: writing " << chunk << " bytes at offset "
+					 << offset << " failed.");
+		p += chunk;
+		offset += chunk;
+		size -= chunk;
+	}
+}
+
+void SharedFileWriter::iwrite_at(long long offset, const void* data, size_t size)
+{
+	UG_COND_THROW(!m_bOpen, "SharedFileWriter: file is not open.");
+
+	const size_t maxChunk = 1 << 30;
+	const char* p = static_cast<const char*>(data);
+	while(size > 0){
+		int chunk = (int)std::min(size, maxChunk);
+		MPI_Request req;
+		if(MPI_File_iwrite_at(m_fh, offset, const_cast<char*>(p), chunk, MPI_BYTE, &req))
+			UG_THROW("SharedFileWriter: starting to write " << chunk
+					 << " bytes at offset " << offset << " failed.");
+		m_requests.push_back(req);
+		p += chunk;
+		offset += chunk;
+		size -= chunk;
+	}
+}
+
+void SharedFileWriter::wait()
+{
+	if(m_requests.empty())
+		return;
+	std::vector<MPI_Status> status(m_requests.size());
+	int err = ::MPI_Waitall((int)m_requests.size(), &m_requests.front(), &status.front());
+	m_requests.clear();
+	UG_COND_THROW(err, "SharedFileWriter: writing to file failed.");
+}
+
+void SharedFileWriter::close()
+{
+	if(m_bOpen){
+		wait();
+		MPI_File_close(&m_fh);
+		m_bOpen = false;
+	}
+}
+
 }
@@ -35,6 +35,7 @@
 
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
+#include <vector>
 
 namespace pcl{
 
@@ -89,5 +90,45 @@ void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename
  */
 void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
 
+
+/**
+ * A file which is written by all processes of a communicator.
+ *
+ * Each process writes blocks of raw data at explicit offsets, so that the
+ * layout of the file is defined by the caller (e.g. a header written by the
+ * first process followed by one section per process). Opening and closing the
+ * file are collective operations, writing is not.
+ * An existing file with the same name is truncated.
+ */
+class SharedFileWriter
+{
+	public:
+		SharedFileWriter(std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+		~SharedFileWriter();
+
+	///	writes size bytes at the given offset of the file
+		void write_at(long long offset, const void* data, size_t size);
+
+	///	starts writing size bytes at the given offset and returns immediately
+	/**	The data has to stay valid and unchanged until wait() or close()
+	 * was called.*/
+		void iwrite_at(long long offset, const void* data, size_t size);
+
+	///	blocks until all writes started through iwrite_at are completed
+		void wait();
+
+	///	closes the file (collective). Called by the destructor if necessary.
+	/**	Pending writes started through iwrite_at are completed first.*/
+		void close();
+
+	private:
+		SharedFileWriter(const SharedFileWriter&);
+		SharedFileWriter& operator=(const SharedFileWriter&);
+
+		MPI_File	m_fh;
+		bool		m_bOpen;
+		std::vector<MPI_Request>	m_requests;
+};
+
 }
 #endif /* PARALLEL_ARCHIVE_H_ */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "pcl_buffer_exchange.h"
+#include "pcl_profiling.h"
+
+using namespace std;
+using namespace ug;
+
+namespace pcl
+{
+
+///	buffers are sent in messages of at most this size
+static const unsigned long long MAX_MESSAGE_SIZE = 1 << 30;
+
+static size_t NumMessages(unsigned long long size)
+{
+	return (size_t)((size + MAX_MESSAGE_SIZE - 1) / MAX_MESSAGE_SIZE);
+}
+
+
+BufferExchange::
+BufferExchange(const ProcessCommunicator& procComm, int tag) :
+	m_procComm(procComm),
+	m_tag(tag)
+{
+}
+
+BufferExchange::
+~BufferExchange()
+{
+	wait_for_sends();
+}
+
+void BufferExchange::
+post_receives(const std::vector<int>& recvFromRanks)
+{
+	PCL_PROFILE(pcl_BufferExchange_post_receives);
+	UG_COND_THROW(!m_recvs.empty(), "BufferExchange: receives were already posted.");
+
+//	m_recvs must not be resized later on, since MPI writes to its entries
+	m_recvs.resize(recvFromRanks.size());
+	for(size_t i = 0; i < m_recvs.size(); ++i){
+		RecvData& rd = m_recvs[i];
+		rd.rank = recvFromRanks[i];
+		rd.size = 0;
+		rd.dataPosted = false;
+		MPI_Irecv(&rd.size, 1, MPI_UNSIGNED_LONG_LONG, rd.rank, m_tag,
+				  m_procComm.get_mpi_communicator(), &rd.sizeRequest);
+	}
+}
+
+void BufferExchange::
+send(int toRank, ug::BinaryBuffer& buf)
+{
+	PCL_PROFILE(pcl_BufferExchange_send);
+	release_completed_sends();
+
+	m_sends.push_back(SendData());
+	SendData& sd = m_sends.back();
+	sd.buf.swap(buf);
+	sd.size = sd.buf.write_pos() - sd.buf.read_pos();
+
+	MPI_Comm comm = m_procComm.get_mpi_communicator();
+	const size_t numMsgs = NumMessages(sd.size);
+	sd.requests.resize(numMsgs + 1);
+	MPI_Isend(&sd.size, 1, MPI_UNSIGNED_LONG_LONG, toRank, m_tag, comm,
+			  &sd.requests[0]);
+
+	char* data = sd.buf.buffer() + sd.buf.read_pos();
+	for(size_t i = 0; i < numMsgs; ++i){
+		const unsigned long long offset = i * MAX_MESSAGE_SIZE;
+		const int count = (int)min(MAX_MESSAGE_SIZE, sd.size - offset);
+		MPI_Isend(data + offset, count, MPI_UNSIGNED_CHAR, toRank, m_tag, comm,
+				  &sd.requests[i + 1]);
+	}
+
+//	receives whose sizes arrived meanwhile can already be started
+	post_arrived_data_receives();
+}
+
+void BufferExchange::
+receive(ug::BinaryBuffer& bufOut, size_t i)
+{
+	PCL_PROFILE(pcl_BufferExchange_receive);
+	UG_COND_THROW(i >= m_recvs.size(), "BufferExchange: invalid receive index " << i);
+	RecvData& rd = m_recvs[i];
+
+//	start the transfer of other buffers, so that they arrive while the
+//	current one is being processed.
+	post_arrived_data_receives();
+
+	if(!rd.dataPosted){
+		pcl::MPI_Wait(&rd.sizeRequest);
+		post_data_receive(rd);
+	}
+
+	if(!rd.requests.empty())
+		Waitall(rd.requests);
+	rd.requests.clear();
+	rd.buf.set_write_pos(rd.size);
+
+	bufOut.swap(rd.buf);
+	rd.buf = BinaryBuffer();
+}
+
+void BufferExchange::
+wait_for_sends()
+{
+	PCL_PROFILE(pcl_BufferExchange_wait_for_sends);
+	for(list<SendData>::iterator iter = m_sends.begin(); iter != m_sends.end(); ++iter)
+		Waitall(iter->requests);
+	m_sends.clear();
+}
+
+void BufferExchange::
+post_arrived_data_receives()
+{
+	for(size_t i = 0; i < m_recvs.size(); ++i){
+		RecvData& rd = m_recvs[i];
+		if(rd.dataPosted)
+			continue;
+		int flag = 0;
+		MPI_Test(&rd.sizeRequest, &flag, MPI_STATUS_IGNORE);
+		if(flag)
+			post_data_receive(rd);
+	}
+}
+
+void BufferExchange::
+post_data_receive(RecvData& rd)
+{
+	rd.dataPosted = true;
+	rd.buf.clear();
+	rd.buf.reserve(rd.size);
+
+	MPI_Comm comm = m_procComm.get_mpi_communicator();
+	const size_t numMsgs = NumMessages(rd.size);
+	rd.requests.resize(numMsgs);
+	char* data = rd.buf.buffer();
+	for(size_t i = 0; i < numMsgs; ++i){
+		const unsigned long long offset = i * MAX_MESSAGE_SIZE;
+		const int count = (int)min(MAX_MESSAGE_SIZE, rd.size - offset);
+		MPI_Irecv(data + offset, count, MPI_UNSIGNED_CHAR, rd.rank, m_tag, comm,
+				  &rd.requests[i]);
+	}
+}
+
+void BufferExchange::
+release_completed_sends()
+{
+	list<SendData>::iterator iter = m_sends.begin();
+	while(iter != m_sends.end()){
+		int flag = 0;
+		MPI_Testall((int)iter->requests.size(), &iter->requests.front(), &flag,
+					MPI_STATUSES_IGNORE);
+		if(flag)
+			iter = m_sends.erase(iter);
+		else
+			++iter;
+	}
+}
+
+}//	end of namespace
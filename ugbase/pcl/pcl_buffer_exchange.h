@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__PCL__PCL_BUFFER_EXCHANGE__
+#define __H__PCL__PCL_BUFFER_EXCHANGE__
+
+#include <list>
+#include <vector>
+#include "pcl_process_communicator.h"
+
+namespace pcl
+{
+
+/// \addtogroup pcl
+/// \{
+
+///	non-blocking exchange of binary buffers between pairs of processes
+/**	In contrast to ProcessCommunicator::distribute_data, a buffer is sent as
+ * soon as it is passed to send, and each received buffer can be processed
+ * while the remaining ones are still being transferred. This allows to
+ * overlap the creation and the processing of buffers with communication.
+ *
+ * The size of a buffer is sent first. Large buffers are split into several
+ * messages, so that buffers may exceed the range of an int.
+ *
+ * At most one buffer may be sent from one process to another. The tag must
+ * not be used by other communication during the lifetime of the exchange.
+ * The ranks are interpreted as in ProcessCommunicator::distribute_data.
+ */
+class BufferExchange
+{
+	public:
+		BufferExchange(const ProcessCommunicator& procComm = ProcessCommunicator(),
+					   int tag = 2);
+
+	///	waits until all sends are completed
+		~BufferExchange();
+
+	///	posts receives for buffers from the given ranks
+	/**	Must be called at most once, before the first call to receive.*/
+		void post_receives(const std::vector<int>& recvFromRanks);
+
+	///	starts sending the buffer to the given rank
+	/**	The unread bytes of buf are sent. buf is swapped into the exchange
+	 * and is empty afterwards. Its memory is released, as soon as the
+	 * send is completed.*/
+		void send(int toRank, ug::BinaryBuffer& buf);
+
+	///	waits for the buffer from recvFromRanks[i] and swaps it into bufOut
+		void receive(ug::BinaryBuffer& bufOut, size_t i);
+
+	///	waits until all sends are completed and releases their buffers
+		void wait_for_sends();
+
+	private:
+		struct SendData{
+			ug::BinaryBuffer			buf;
+			unsigned long long			size;
+			std::vector<MPI_Request>	requests;
+		};
+
+		struct RecvData{
+			int							rank;
+			unsigned long long			size;
+			MPI_Request					sizeRequest;
+			bool						dataPosted;
+			ug::BinaryBuffer			buf;
+			std::vector<MPI_Request>	requests;
+		};
+
+	///	posts the data receives of all buffers whose sizes arrived
+		void post_arrived_data_receives();
+		void post_data_receive(RecvData& rd);
+
+	///	releases the buffers of completed sends
+		void release_completed_sends();
+
+	private:
+		ProcessCommunicator		m_procComm;
+		int						m_tag;
+		std::list<SendData>		m_sends;
+		std::vector<RecvData>	m_recvs;
+};
+
+/// \}
+
+}//	end of namespace
+
+#endif
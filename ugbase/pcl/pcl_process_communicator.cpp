@@ -466,6 +466,26 @@ alltoall(const void* sendBuf, int sendCount, DataType sendType,
 	MPI_Alltoall(const_cast<void*>(sendBuf), sendCount, sendType, recBuf, recCount, recType, m_comm->m_mpiComm);
 }
 
+void
+ProcessCommunicator::
+alltoallv(const void* sendBuf, int* sendCounts, int* sendDispls,
+		  DataType sendType, void* recBuf, int* recCounts,
+		  int* recDispls, DataType recType) const
+{
+	PCL_PROFILE(pcl_ProcCom_alltoallv);
+	if(is_local()){
+		memcpy((char*)recBuf + recDispls[0] * GetSize(recType),
+			   (const char*)sendBuf + sendDispls[0] * GetSize(sendType),
+			   recCounts[0] * GetSize(recType));
+		return;
+	}
+
+	UG_COND_THROW(empty(), "ERROR in ProcessCommunicator::alltoallv: empty communicator.");
+
+	MPI_Alltoallv(const_cast<void*>(sendBuf), sendCounts, sendDispls, sendType,
+				  recBuf, recCounts, recDispls, recType, m_comm->m_mpiComm);
+}
+
 void
 ProcessCommunicator::
 send_data(void* pBuffer, int bufferSize, int destProc, int tag) const
@@ -229,6 +229,23 @@ class ProcessCommunicator
 		void alltoall(const void* sendBuf, int sendCount, DataType sendType,
 		    		  void* recBuf, int recCount, DataType recType);
 
+	///	performs MPI_Alltoallv on the processes of the communicator.
+	/** Each process sends a variable amount of data to each process.
+	 *  Counts and displacements are given in numbers of elements and
+	 *  have to contain one entry for each process of the communicator.
+	 *  The receive buffer needs to have the appropriate size.
+	 * \param sendBuf    starting address of send buffer (choice)
+	 * \param sendCounts number of elements to send to each process
+	 * \param sendDispls displacement of the data for each process in sendBuf
+	 * \param sendType   data type of send buffer elements (handle)
+	 * \param recBuf     starting address of receive buffer (choice)
+	 * \param recCounts  number of elements to receive from each process
+	 * \param recDispls  displacement of the data from each process in recBuf
+	 * \param recType    data type of receive buffer elements (handle) */
+		void alltoallv(const void* sendBuf, int* sendCounts, int* sendDispls,
+					   DataType sendType, void* recBuf, int* recCounts,
+					   int* recDispls, DataType recType) const;
+
 	///	gathers variable arrays on all processes.
 	/**	The arrays specified in sendBuf will be copied to all processes
 	 * in the ProcessCommunicator. The order of the arrays in recBufOut